@@ -104,6 +104,9 @@ AC_DEFUN([AX_EWFTOOLS_CHECK_LOCAL],
   dnl Headers included in ewftools/ewfmount.c
   AC_CHECK_HEADERS([errno.h])
 
+  dnl Headers included in ewftools/mount_nbd.c
+  AC_CHECK_HEADERS([sys/socket.h sys/un.h])
+
   AC_HEADER_TIME
 
   dnl Functions included in ewftools/mount_file_system.c and ewftools/mount_file_entry.c
@@ -65,13 +65,20 @@ public enum class LIBEWF_COMPRESSION_LEVELS : int
  * bit 2							set to 1 for pattern fill compression
  *              this implies empty block compression using the pattern fill method
  *              used internally only
- * bit 3-8							not used
+ * bit 3							set to 1 for the entropy test
+ *              skips compression of chunks that are estimated to be incompressible
+ * bit 4							set to 1 for adaptive compression
+ *              stops compression after a run of incompressible chunks and periodically
+ *              probes if compression has become useful again
+ * bit 5-8							not used
  */
 [System::Flags]
 public enum class LIBEWF_COMPRESSION_FLAGS
 {
   LIBEWF_COMPRESS_FLAG_NONE                         = (uint8_t) 0x00,
 	LIBEWF_COMPRESS_FLAG_USE_EMPTY_BLOCK_COMPRESSION	= (uint8_t) 0x01,
+	LIBEWF_COMPRESS_FLAG_USE_ENTROPY_TEST			= (uint8_t) 0x02,
+	LIBEWF_COMPRESS_FLAG_USE_ADAPTIVE_COMPRESSION		= (uint8_t) 0x04,
 	LIBEWF_COMPRESS_FLAG_USE_PATTERN_FILL_COMPRESSION	= (uint8_t) 0x10,
 };
 
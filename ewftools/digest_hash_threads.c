@@ -0,0 +1,961 @@
+/*
+ * Digest hash threads
+ *
+ * Copyright (C) 2006-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "digest_hash_threads.h"
+#include "ewftools_libcerror.h"
+#include "ewftools_libcnotify.h"
+#include "ewftools_libcthreads.h"
+#include "ewftools_libhmac.h"
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Creates a digest hash buffer
+ * Make sure the value buffer is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int digest_hash_buffer_initialize(
+     digest_hash_buffer_t **buffer,
+     libcerror_error_t **error )
+{
+	static char *function = "digest_hash_buffer_initialize";
+
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( *buffer != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid buffer value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*buffer = memory_allocate_structure(
+	           digest_hash_buffer_t );
+
+	if( *buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buffer.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *buffer,
+	     0,
+	     sizeof( digest_hash_buffer_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear buffer.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *buffer != NULL )
+	{
+		memory_free(
+		 *buffer );
+
+		*buffer = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a digest hash buffer
+ * Returns 1 if successful or -1 on error
+ */
+int digest_hash_buffer_free(
+     digest_hash_buffer_t **buffer,
+     libcerror_error_t **error )
+{
+	static char *function = "digest_hash_buffer_free";
+
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( *buffer != NULL )
+	{
+		if( ( *buffer )->data != NULL )
+		{
+			memory_free(
+			 ( *buffer )->data );
+		}
+		memory_free(
+		 *buffer );
+
+		*buffer = NULL;
+	}
+	return( 1 );
+}
+
+/* Creates digest hash threads
+ * A thread is created for every digest hash context that is not NULL
+ * The digest hash contexts are not managed by the digest hash threads
+ * Make sure the value digest_hash_threads is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int digest_hash_threads_initialize(
+     digest_hash_threads_t **digest_hash_threads,
+     libhmac_md5_context_t *md5_context,
+     libhmac_sha1_context_t *sha1_context,
+     libhmac_sha256_context_t *sha256_context,
+     libcerror_error_t **error )
+{
+	digest_hash_buffer_t *buffer = NULL;
+	static char *function        = "digest_hash_threads_initialize";
+	int buffer_index             = 0;
+
+	if( digest_hash_threads == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest hash threads.",
+		 function );
+
+		return( -1 );
+	}
+	if( *digest_hash_threads != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid digest hash threads value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*digest_hash_threads = memory_allocate_structure(
+	                        digest_hash_threads_t );
+
+	if( *digest_hash_threads == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create digest hash threads.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *digest_hash_threads,
+	     0,
+	     sizeof( digest_hash_threads_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear digest hash threads.",
+		 function );
+
+		memory_free(
+		 *digest_hash_threads );
+
+		*digest_hash_threads = NULL;
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_initialize(
+	     &( ( *digest_hash_threads )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_queue_initialize(
+	     &( ( *digest_hash_threads )->buffer_queue ),
+	     DIGEST_HASH_THREADS_NUMBER_OF_BUFFERS,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create buffer queue.",
+		 function );
+
+		goto on_error;
+	}
+	for( buffer_index = 0;
+	     buffer_index < DIGEST_HASH_THREADS_NUMBER_OF_BUFFERS;
+	     buffer_index++ )
+	{
+		if( digest_hash_buffer_initialize(
+		     &buffer,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create buffer.",
+			 function );
+
+			goto on_error;
+		}
+		if( libcthreads_queue_push(
+		     ( *digest_hash_threads )->buffer_queue,
+		     (intptr_t *) buffer,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push buffer onto queue.",
+			 function );
+
+			goto on_error;
+		}
+		buffer = NULL;
+	}
+	/* Each digest hash has a single thread so that the buffers are processed in order
+	 */
+	if( md5_context != NULL )
+	{
+		if( libcthreads_thread_pool_create(
+		     &( ( *digest_hash_threads )->md5_thread_pool ),
+		     NULL,
+		     1,
+		     DIGEST_HASH_THREADS_NUMBER_OF_BUFFERS,
+		     (int (*)(intptr_t *, void *)) &digest_hash_threads_md5_callback,
+		     (void *) *digest_hash_threads,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create MD5 thread pool.",
+			 function );
+
+			goto on_error;
+		}
+		( *digest_hash_threads )->md5_context             = md5_context;
+		( *digest_hash_threads )->number_of_thread_pools += 1;
+	}
+	if( sha1_context != NULL )
+	{
+		if( libcthreads_thread_pool_create(
+		     &( ( *digest_hash_threads )->sha1_thread_pool ),
+		     NULL,
+		     1,
+		     DIGEST_HASH_THREADS_NUMBER_OF_BUFFERS,
+		     (int (*)(intptr_t *, void *)) &digest_hash_threads_sha1_callback,
+		     (void *) *digest_hash_threads,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create SHA1 thread pool.",
+			 function );
+
+			goto on_error;
+		}
+		( *digest_hash_threads )->sha1_context            = sha1_context;
+		( *digest_hash_threads )->number_of_thread_pools += 1;
+	}
+	if( sha256_context != NULL )
+	{
+		if( libcthreads_thread_pool_create(
+		     &( ( *digest_hash_threads )->sha256_thread_pool ),
+		     NULL,
+		     1,
+		     DIGEST_HASH_THREADS_NUMBER_OF_BUFFERS,
+		     (int (*)(intptr_t *, void *)) &digest_hash_threads_sha256_callback,
+		     (void *) *digest_hash_threads,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create SHA256 thread pool.",
+			 function );
+
+			goto on_error;
+		}
+		( *digest_hash_threads )->sha256_context          = sha256_context;
+		( *digest_hash_threads )->number_of_thread_pools += 1;
+	}
+	return( 1 );
+
+on_error:
+	if( buffer != NULL )
+	{
+		digest_hash_buffer_free(
+		 &buffer,
+		 NULL );
+	}
+	if( *digest_hash_threads != NULL )
+	{
+		digest_hash_threads_free(
+		 digest_hash_threads,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Frees digest hash threads
+ * This function waits for the digest hash threads to process all buffers
+ * Returns 1 if successful or -1 on error
+ */
+int digest_hash_threads_free(
+     digest_hash_threads_t **digest_hash_threads,
+     libcerror_error_t **error )
+{
+	static char *function = "digest_hash_threads_free";
+	int result            = 1;
+
+	if( digest_hash_threads == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest hash threads.",
+		 function );
+
+		return( -1 );
+	}
+	if( *digest_hash_threads != NULL )
+	{
+		if( ( *digest_hash_threads )->md5_thread_pool != NULL )
+		{
+			if( libcthreads_thread_pool_join(
+			     &( ( *digest_hash_threads )->md5_thread_pool ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to join MD5 thread pool.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *digest_hash_threads )->sha1_thread_pool != NULL )
+		{
+			if( libcthreads_thread_pool_join(
+			     &( ( *digest_hash_threads )->sha1_thread_pool ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to join SHA1 thread pool.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *digest_hash_threads )->sha256_thread_pool != NULL )
+		{
+			if( libcthreads_thread_pool_join(
+			     &( ( *digest_hash_threads )->sha256_thread_pool ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to join SHA256 thread pool.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( result == 1 )
+		 && ( ( *digest_hash_threads )->update_failed != 0 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to update digest hash.",
+			 function );
+
+			result = -1;
+		}
+		if( ( *digest_hash_threads )->buffer_queue != NULL )
+		{
+			if( libcthreads_queue_free(
+			     &( ( *digest_hash_threads )->buffer_queue ),
+			     (int (*)(intptr_t **, libcerror_error_t **)) &digest_hash_buffer_free,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free buffer queue.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *digest_hash_threads )->mutex != NULL )
+		{
+			if( libcthreads_mutex_free(
+			     &( ( *digest_hash_threads )->mutex ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free mutex.",
+				 function );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 *digest_hash_threads );
+
+		*digest_hash_threads = NULL;
+	}
+	return( result );
+}
+
+/* Updates the MD5 digest hash
+ * Callback function for the MD5 thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int digest_hash_threads_md5_callback(
+     digest_hash_buffer_t *buffer,
+     digest_hash_threads_t *digest_hash_threads )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "digest_hash_threads_md5_callback";
+	int result               = 1;
+
+	if( libhmac_md5_update(
+	     digest_hash_threads->md5_context,
+	     buffer->data,
+	     buffer->data_size,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update MD5 digest hash.",
+		 function );
+
+		digest_hash_threads->update_failed = 1;
+
+		result = -1;
+	}
+	if( digest_hash_threads_release_buffer(
+	     digest_hash_threads,
+	     buffer,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release buffer.",
+		 function );
+
+		result = -1;
+	}
+	if( error != NULL )
+	{
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	return( result );
+}
+
+/* Updates the SHA1 digest hash
+ * Callback function for the SHA1 thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int digest_hash_threads_sha1_callback(
+     digest_hash_buffer_t *buffer,
+     digest_hash_threads_t *digest_hash_threads )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "digest_hash_threads_sha1_callback";
+	int result               = 1;
+
+	if( libhmac_sha1_update(
+	     digest_hash_threads->sha1_context,
+	     buffer->data,
+	     buffer->data_size,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update SHA1 digest hash.",
+		 function );
+
+		digest_hash_threads->update_failed = 1;
+
+		result = -1;
+	}
+	if( digest_hash_threads_release_buffer(
+	     digest_hash_threads,
+	     buffer,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release buffer.",
+		 function );
+
+		result = -1;
+	}
+	if( error != NULL )
+	{
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	return( result );
+}
+
+/* Updates the SHA256 digest hash
+ * Callback function for the SHA256 thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int digest_hash_threads_sha256_callback(
+     digest_hash_buffer_t *buffer,
+     digest_hash_threads_t *digest_hash_threads )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "digest_hash_threads_sha256_callback";
+	int result               = 1;
+
+	if( libhmac_sha256_update(
+	     digest_hash_threads->sha256_context,
+	     buffer->data,
+	     buffer->data_size,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update SHA256 digest hash.",
+		 function );
+
+		digest_hash_threads->update_failed = 1;
+
+		result = -1;
+	}
+	if( digest_hash_threads_release_buffer(
+	     digest_hash_threads,
+	     buffer,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release buffer.",
+		 function );
+
+		result = -1;
+	}
+	if( error != NULL )
+	{
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	return( result );
+}
+
+/* Releases a reference to a buffer
+ * The buffer is pushed back onto the queue of unused buffers when it is no longer referenced
+ * Returns 1 if successful or -1 on error
+ */
+int digest_hash_threads_release_buffer(
+     digest_hash_threads_t *digest_hash_threads,
+     digest_hash_buffer_t *buffer,
+     libcerror_error_t **error )
+{
+	static char *function    = "digest_hash_threads_release_buffer";
+	int number_of_references = 0;
+
+	if( digest_hash_threads == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest hash threads.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     digest_hash_threads->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	buffer->number_of_references -= 1;
+
+	number_of_references = buffer->number_of_references;
+
+	if( libcthreads_mutex_release(
+	     digest_hash_threads->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_references == 0 )
+	{
+		if( libcthreads_queue_push(
+		     digest_hash_threads->buffer_queue,
+		     (intptr_t *) buffer,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push buffer onto queue.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Updates the digest hashes with the data in the buffer
+ * The data is copied so that the buffer can be reused as soon as this function returns
+ * This function blocks when all the digest hash buffers are in flight
+ * Returns 1 if successful or -1 on error
+ */
+int digest_hash_threads_update(
+     digest_hash_threads_t *digest_hash_threads,
+     const uint8_t *buffer,
+     size_t buffer_size,
+     libcerror_error_t **error )
+{
+	digest_hash_buffer_t *digest_hash_buffer = NULL;
+	static char *function                    = "digest_hash_threads_update";
+	int number_of_pushed_references          = 0;
+
+	if( digest_hash_threads == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest hash threads.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( buffer_size == 0 )
+	 || ( buffer_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid buffer size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( digest_hash_threads->update_failed != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to update digest hash.",
+		 function );
+
+		return( -1 );
+	}
+	if( digest_hash_threads->number_of_thread_pools == 0 )
+	{
+		return( 1 );
+	}
+	if( libcthreads_queue_pop(
+	     digest_hash_threads->buffer_queue,
+	     (intptr_t **) &digest_hash_buffer,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+		 "%s: unable to pop buffer from queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( digest_hash_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > digest_hash_buffer->allocated_data_size )
+	{
+		if( digest_hash_buffer->data != NULL )
+		{
+			memory_free(
+			 digest_hash_buffer->data );
+
+			digest_hash_buffer->allocated_data_size = 0;
+		}
+		digest_hash_buffer->data = (uint8_t *) memory_allocate(
+		                                        sizeof( uint8_t ) * buffer_size );
+
+		if( digest_hash_buffer->data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create buffer data.",
+			 function );
+
+			goto on_error;
+		}
+		digest_hash_buffer->allocated_data_size = buffer_size;
+	}
+	if( memory_copy(
+	     digest_hash_buffer->data,
+	     buffer,
+	     buffer_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy buffer data.",
+		 function );
+
+		goto on_error;
+	}
+	digest_hash_buffer->data_size            = buffer_size;
+	digest_hash_buffer->number_of_references = digest_hash_threads->number_of_thread_pools;
+
+	if( digest_hash_threads->md5_thread_pool != NULL )
+	{
+		if( libcthreads_thread_pool_push(
+		     digest_hash_threads->md5_thread_pool,
+		     (intptr_t *) digest_hash_buffer,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push buffer onto MD5 thread pool queue.",
+			 function );
+
+			goto on_error;
+		}
+		number_of_pushed_references++;
+	}
+	if( digest_hash_threads->sha1_thread_pool != NULL )
+	{
+		if( libcthreads_thread_pool_push(
+		     digest_hash_threads->sha1_thread_pool,
+		     (intptr_t *) digest_hash_buffer,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push buffer onto SHA1 thread pool queue.",
+			 function );
+
+			goto on_error;
+		}
+		number_of_pushed_references++;
+	}
+	if( digest_hash_threads->sha256_thread_pool != NULL )
+	{
+		if( libcthreads_thread_pool_push(
+		     digest_hash_threads->sha256_thread_pool,
+		     (intptr_t *) digest_hash_buffer,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push buffer onto SHA256 thread pool queue.",
+			 function );
+
+			goto on_error;
+		}
+		number_of_pushed_references++;
+	}
+	return( 1 );
+
+on_error:
+	/* Drop the references of the digest hash threads the buffer was not pushed onto
+	 */
+	if( number_of_pushed_references == 0 )
+	{
+		libcthreads_queue_push(
+		 digest_hash_threads->buffer_queue,
+		 (intptr_t *) digest_hash_buffer,
+		 NULL );
+	}
+	else
+	{
+		while( number_of_pushed_references < digest_hash_threads->number_of_thread_pools )
+		{
+			digest_hash_threads_release_buffer(
+			 digest_hash_threads,
+			 digest_hash_buffer,
+			 NULL );
+
+			number_of_pushed_references++;
+		}
+	}
+	digest_hash_threads->update_failed = 1;
+
+	return( -1 );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
@@ -0,0 +1,162 @@
+/*
+ * Digest hash threads
+ *
+ * Copyright (C) 2006-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _DIGEST_HASH_THREADS_H )
+#define _DIGEST_HASH_THREADS_H
+
+#include <common.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libcthreads.h"
+#include "ewftools_libhmac.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* The number of digest hash buffers that can be in flight
+ */
+#define DIGEST_HASH_THREADS_NUMBER_OF_BUFFERS	16
+
+typedef struct digest_hash_buffer digest_hash_buffer_t;
+
+struct digest_hash_buffer
+{
+	/* The data
+	 */
+	uint8_t *data;
+
+	/* The data size
+	 */
+	size_t data_size;
+
+	/* The allocated size of the data
+	 */
+	size_t allocated_data_size;
+
+	/* The number of digest hash threads that still need to process the data
+	 */
+	int number_of_references;
+};
+
+typedef struct digest_hash_threads digest_hash_threads_t;
+
+/* The digest hash threads calculate each digest hash on a separate thread.
+ * Every digest hash thread processes the same buffers in the order they were
+ * provided, hence the digest hashes are pipelined instead of calculated one
+ * after the other.
+ */
+struct digest_hash_threads
+{
+	/* The MD5 context
+	 */
+	libhmac_md5_context_t *md5_context;
+
+	/* The MD5 thread pool
+	 */
+	libcthreads_thread_pool_t *md5_thread_pool;
+
+	/* The SHA1 context
+	 */
+	libhmac_sha1_context_t *sha1_context;
+
+	/* The SHA1 thread pool
+	 */
+	libcthreads_thread_pool_t *sha1_thread_pool;
+
+	/* The SHA256 context
+	 */
+	libhmac_sha256_context_t *sha256_context;
+
+	/* The SHA256 thread pool
+	 */
+	libcthreads_thread_pool_t *sha256_thread_pool;
+
+	/* The number of thread pools
+	 */
+	int number_of_thread_pools;
+
+	/* The queue of unused buffers
+	 */
+	libcthreads_queue_t *buffer_queue;
+
+	/* The mutex that protects the buffer references
+	 */
+	libcthreads_mutex_t *mutex;
+
+	/* Value to indicate a digest hash failed to update
+	 */
+	uint8_t update_failed;
+};
+
+int digest_hash_buffer_initialize(
+     digest_hash_buffer_t **buffer,
+     libcerror_error_t **error );
+
+int digest_hash_buffer_free(
+     digest_hash_buffer_t **buffer,
+     libcerror_error_t **error );
+
+int digest_hash_threads_initialize(
+     digest_hash_threads_t **digest_hash_threads,
+     libhmac_md5_context_t *md5_context,
+     libhmac_sha1_context_t *sha1_context,
+     libhmac_sha256_context_t *sha256_context,
+     libcerror_error_t **error );
+
+int digest_hash_threads_free(
+     digest_hash_threads_t **digest_hash_threads,
+     libcerror_error_t **error );
+
+int digest_hash_threads_md5_callback(
+     digest_hash_buffer_t *buffer,
+     digest_hash_threads_t *digest_hash_threads );
+
+int digest_hash_threads_sha1_callback(
+     digest_hash_buffer_t *buffer,
+     digest_hash_threads_t *digest_hash_threads );
+
+int digest_hash_threads_sha256_callback(
+     digest_hash_buffer_t *buffer,
+     digest_hash_threads_t *digest_hash_threads );
+
+int digest_hash_threads_release_buffer(
+     digest_hash_threads_t *digest_hash_threads,
+     digest_hash_buffer_t *buffer,
+     libcerror_error_t **error );
+
+int digest_hash_threads_update(
+     digest_hash_threads_t *digest_hash_threads,
+     const uint8_t *buffer,
+     size_t buffer_size,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _DIGEST_HASH_THREADS_H ) */
+
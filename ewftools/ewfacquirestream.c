@@ -59,6 +59,7 @@
 #include "process_status.h"
 #include "storage_media_buffer.h"
 #include "storage_media_buffer_queue.h"
+#include "storage_media_buffer_ring.h"
 
 imaging_handle_t *ewfacquirestream_imaging_handle = NULL;
 int ewfacquirestream_abort                        = 0;
@@ -751,6 +752,20 @@ int ewfacquirestream_read_input(
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 		if( imaging_handle->number_of_threads > 0 )
 		{
+			if( storage_media_buffer_ring_set_sequence_number(
+			     imaging_handle->output_ring,
+			     storage_media_buffer,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set storage media buffer sequence number.",
+				 function );
+
+				goto on_error;
+			}
 			if( libcthreads_thread_pool_push(
 			     imaging_handle->process_thread_pool,
 			     (intptr_t *) storage_media_buffer,
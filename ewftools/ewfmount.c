@@ -56,10 +56,15 @@
 #include "mount_dokan.h"
 #include "mount_fuse.h"
 #include "mount_handle.h"
+#include "mount_nbd.h"
 
 mount_handle_t *ewfmount_mount_handle = NULL;
 int ewfmount_abort                    = 0;
 
+#if defined( HAVE_SYS_SOCKET_H ) && defined( HAVE_SYS_UN_H )
+mount_nbd_server_t *ewfmount_nbd_server = NULL;
+#endif
+
 /* Prints usage information
  */
 void usage_fprint(
@@ -71,7 +76,12 @@ void usage_fprint(
 	}
 	fprintf( stream, "Use ewfmount to mount an Expert Witness Compression Format (EWF) image file\n\n" );
 
-	fprintf( stream, "Usage: ewfmount [ -f format ] [ -X extended_options ] [ -hvV ] image mount_point\n\n" );
+	fprintf( stream, "Usage: ewfmount [ -f format ] [ -j jobs ] [ -X extended_options ] [ -hvV ] image\n"
+	                 "                mount_point\n" );
+#if defined( HAVE_SYS_SOCKET_H ) && defined( HAVE_SYS_UN_H )
+	fprintf( stream, "       ewfmount -n socket [ -j jobs ] [ -hvV ] image\n" );
+#endif
+	fprintf( stream, "\n" );
 
 	fprintf( stream, "\timage:       an Expert Witness Compression Format (EWF) image file\n\n" );
 	fprintf( stream, "\tmount_point: the directory to serve as mount point\n\n" );
@@ -79,6 +89,14 @@ void usage_fprint(
 	fprintf( stream, "\t-f:          specify the input format, options: raw (default), files (restricted to\n"
 	                 "\t             logical volume files)\n" );
 	fprintf( stream, "\t-h:          shows this help\n" );
+	fprintf( stream, "\t-j:          the number of concurrent jobs (threads) that serve reads of the\n"
+	                 "\t             mounted image, where a number of 0 represents single-threaded\n"
+	                 "\t             mode (default is 4 if multi-threaded mode is supported)\n" );
+#if defined( HAVE_SYS_SOCKET_H ) && defined( HAVE_SYS_UN_H )
+	fprintf( stream, "\t-n:          instead of mounting, export the media data read-only as a network\n"
+	                 "\t             block device (NBD) on the Unix domain socket with the specified\n"
+	                 "\t             path, ewfmount will remain running in the foreground\n" );
+#endif
 	fprintf( stream, "\t-v:          verbose output to stderr, while ewfmount will remain running in the\n"
 	                 "\t             foreground\n" );
 	fprintf( stream, "\t-V:          print version\n" );
@@ -97,6 +115,24 @@ void ewfmount_signal_handler(
 
 	ewfmount_abort = 1;
 
+#if defined( HAVE_SYS_SOCKET_H ) && defined( HAVE_SYS_UN_H )
+	if( ewfmount_nbd_server != NULL )
+	{
+		if( mount_nbd_server_signal_abort(
+		     ewfmount_nbd_server,
+		     &error ) != 1 )
+		{
+			libcnotify_printf(
+			 "%s: unable to signal NBD server to abort.\n",
+			 function );
+
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif
 	if( ewfmount_mount_handle != NULL )
 	{
 		if( mount_handle_signal_abort(
@@ -146,6 +182,8 @@ int main( int argc, char * const argv[] )
 	system_character_t *mount_point             = NULL;
 	system_character_t *option_extended_options = NULL;
 	system_character_t *option_format           = NULL;
+	system_character_t *option_nbd_socket_path  = NULL;
+	system_character_t *option_number_of_jobs   = NULL;
 	const system_character_t *path_prefix       = NULL;
 	char *program                               = _SYSTEM_STRING( "ewfmount" );
 	system_integer_t option                     = 0;
@@ -158,6 +196,10 @@ int main( int argc, char * const argv[] )
 	ewftools_glob_t *glob                       = NULL;
 #endif
 
+#if defined( HAVE_SYS_SOCKET_H ) && defined( HAVE_SYS_UN_H )
+	libewf_handle_t *ewf_handle                 = NULL;
+#endif
+
 #if defined( HAVE_LIBFUSE ) || defined( HAVE_LIBOSXFUSE )
 	struct fuse_operations ewfmount_fuse_operations;
 
@@ -203,7 +245,7 @@ int main( int argc, char * const argv[] )
 	while( ( option = ewftools_getopt(
 	                   argc,
 	                   argv,
-	                   _SYSTEM_STRING( "f:hvVX:" ) ) ) != (system_integer_t) -1 )
+	                   _SYSTEM_STRING( "f:hj:n:vVX:" ) ) ) != (system_integer_t) -1 )
 	{
 		switch( option )
 		{
@@ -230,6 +272,16 @@ int main( int argc, char * const argv[] )
 
 				return( EXIT_SUCCESS );
 
+			case (system_integer_t) 'j':
+				option_number_of_jobs = optarg;
+
+				break;
+
+			case (system_integer_t) 'n':
+				option_nbd_socket_path = optarg;
+
+				break;
+
 			case (system_integer_t) 'v':
 				verbose = 1;
 
@@ -258,18 +310,30 @@ int main( int argc, char * const argv[] )
 
 		return( EXIT_FAILURE );
 	}
-	if( ( optind + 1 ) == argc )
+#if defined( HAVE_SYS_SOCKET_H ) && defined( HAVE_SYS_UN_H )
+	/* An NBD export has no mount point, all remaining arguments are sources
+	 */
+	if( option_nbd_socket_path != NULL )
 	{
-		fprintf(
-		 stderr,
-		 "Missing mount point.\n" );
+		number_of_sources = argc - optind;
+	}
+	else
+#endif
+	{
+		if( ( optind + 1 ) == argc )
+		{
+			fprintf(
+			 stderr,
+			 "Missing mount point.\n" );
 
-		usage_fprint(
-		 stdout );
+			usage_fprint(
+			 stdout );
 
-		return( EXIT_FAILURE );
+			return( EXIT_FAILURE );
+		}
+		mount_point       = argv[ argc - 1 ];
+		number_of_sources = argc - optind - 1;
 	}
-	mount_point = argv[ argc - 1 ];
 
 	libcnotify_verbose_set(
 	 verbose );
@@ -293,7 +357,7 @@ int main( int argc, char * const argv[] )
 	if( ewftools_glob_resolve(
 	     glob,
 	     &( argv[ optind ] ),
-	     argc - optind - 1,
+	     number_of_sources,
 	     &error ) != 1 )
 	{
 		fprintf(
@@ -315,8 +379,7 @@ int main( int argc, char * const argv[] )
 		goto on_error;
 	}
 #else
-	sources           = &( argv[ optind ] );
-	number_of_sources = argc - optind - 1;
+	sources = &( argv[ optind ] );
 #endif
 
 	if( mount_handle_initialize(
@@ -351,6 +414,40 @@ int main( int argc, char * const argv[] )
 			 "Unsupported input format defaulting to: raw.\n" );
 		}
 	}
+	if( option_number_of_jobs != NULL )
+	{
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		result = mount_handle_set_number_of_threads(
+			  ewfmount_mount_handle,
+			  option_number_of_jobs,
+			  &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set number of jobs (threads).\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			ewfmount_mount_handle->number_of_threads = 4;
+
+			fprintf(
+			 stderr,
+			 "Unsupported number of jobs (threads) defaulting to: %d.\n",
+			 ewfmount_mount_handle->number_of_threads );
+		}
+#else
+		ewfmount_mount_handle->number_of_threads = 0;
+
+		fprintf(
+		 stderr,
+		 "Unsupported number of jobs (threads) defaulting to: %d.\n",
+		 ewfmount_mount_handle->number_of_threads );
+#endif
+	}
 #if defined( HAVE_GETRLIMIT )
 	if( getrlimit(
 	     RLIMIT_NOFILE,
@@ -425,21 +522,157 @@ int main( int argc, char * const argv[] )
 		goto on_error;
 	}
 #endif
-#if defined( HAVE_LIBFUSE ) || defined( HAVE_LIBOSXFUSE )
-	if( option_extended_options != NULL )
+#if defined( HAVE_SYS_SOCKET_H ) && defined( HAVE_SYS_UN_H )
+	if( option_nbd_socket_path != NULL )
 	{
-		/* This argument is required but ignored
-		 */
-		if( fuse_opt_add_arg(
-		     &ewfmount_fuse_arguments,
-		     "" ) != 0 )
+		if( ewfmount_mount_handle->input_format != MOUNT_HANDLE_INPUT_FORMAT_RAW )
 		{
 			fprintf(
 			 stderr,
-			 "Unable add fuse arguments.\n" );
+			 "Unsupported input format for NBD export only raw is supported.\n" );
+
+			goto on_error;
+		}
+		if( mount_file_system_get_handle_by_index(
+		     ewfmount_mount_handle->file_system,
+		     0,
+		     &ewf_handle,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to retrieve EWF handle.\n" );
+
+			goto on_error;
+		}
+		if( mount_nbd_server_initialize(
+		     &ewfmount_nbd_server,
+		     ewf_handle,
+		     ewfmount_mount_handle->number_of_threads,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to initialize NBD server.\n" );
+
+			goto on_error;
+		}
+		if( mount_nbd_server_open(
+		     ewfmount_nbd_server,
+		     option_nbd_socket_path,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to open NBD server.\n" );
+
+			goto on_error;
+		}
+		if( ewftools_signal_attach(
+		     ewfmount_signal_handler,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to attach signal handler.\n" );
+
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+		}
+		fprintf(
+		 stdout,
+		 "Serving NBD export on: %s\n",
+		 option_nbd_socket_path );
+
+		result = mount_nbd_server_run(
+		          ewfmount_nbd_server,
+		          &error );
+
+		if( result != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to run NBD server.\n" );
 
 			goto on_error;
 		}
+		if( ewftools_signal_detach(
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to detach signal handler.\n" );
+
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+		}
+		if( mount_nbd_server_free(
+		     &ewfmount_nbd_server,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to free NBD server.\n" );
+
+			goto on_error;
+		}
+		if( mount_handle_free(
+		     &ewfmount_mount_handle,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to free mount handle.\n" );
+
+			goto on_error;
+		}
+		return( EXIT_SUCCESS );
+	}
+#endif /* defined( HAVE_SYS_SOCKET_H ) && defined( HAVE_SYS_UN_H ) */
+
+#if defined( HAVE_LIBFUSE ) || defined( HAVE_LIBOSXFUSE )
+	/* This argument is required but ignored
+	 */
+	if( fuse_opt_add_arg(
+	     &ewfmount_fuse_arguments,
+	     "" ) != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable add fuse arguments.\n" );
+
+		goto on_error;
+	}
+	/* Allow the kernel to request large reads, it will limit the size
+	 * of the reads to the maximum it supports. The extended options
+	 * are added afterwards so they can override these values.
+	 */
+	if( fuse_opt_add_arg(
+	     &ewfmount_fuse_arguments,
+	     "-o" ) != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable add fuse arguments.\n" );
+
+		goto on_error;
+	}
+	if( fuse_opt_add_arg(
+	     &ewfmount_fuse_arguments,
+	     MOUNT_FUSE_READ_OPTIONS ) != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable add fuse arguments.\n" );
+
+		goto on_error;
+	}
+	if( option_extended_options != NULL )
+	{
 		if( fuse_opt_add_arg(
 		     &ewfmount_fuse_arguments,
 		     "-o" ) != 0 )
@@ -520,16 +753,37 @@ int main( int argc, char * const argv[] )
 			goto on_error;
 		}
 	}
-	result = fuse_loop(
-	          ewfmount_fuse_handle );
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( ewfmount_mount_handle->number_of_threads > 0 )
+	{
+		result = mount_fuse_loop_with_threads(
+		          ewfmount_fuse_handle,
+		          ewfmount_mount_handle->number_of_threads,
+		          &error );
+
+		if( result != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to run fuse loop with threads.\n" );
 
-	if( result != 0 )
+			goto on_error;
+		}
+	}
+	else
+#endif
 	{
-		fprintf(
-		 stderr,
-		 "Unable to run fuse loop.\n" );
+		result = fuse_loop(
+		          ewfmount_fuse_handle );
 
-		goto on_error;
+		if( result != 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to run fuse loop.\n" );
+
+			goto on_error;
+		}
 	}
 	fuse_destroy(
 	 ewfmount_fuse_handle );
@@ -714,6 +968,14 @@ on_error:
 	}
 	fuse_opt_free_args(
 	 &ewfmount_fuse_arguments );
+#endif
+#if defined( HAVE_SYS_SOCKET_H ) && defined( HAVE_SYS_UN_H )
+	if( ewfmount_nbd_server != NULL )
+	{
+		mount_nbd_server_free(
+		 &ewfmount_nbd_server,
+		 NULL );
+	}
 #endif
 	if( ewfmount_mount_handle != NULL )
 	{
@@ -43,6 +43,7 @@
 
 #include "byte_size_string.h"
 #include "digest_hash.h"
+#include "digest_hash_threads.h"
 #include "ewfcommon.h"
 #include "ewfinput.h"
 #include "ewftools_libcerror.h"
@@ -59,6 +60,7 @@
 #include "process_status.h"
 #include "storage_media_buffer.h"
 #include "storage_media_buffer_queue.h"
+#include "storage_media_buffer_ring.h"
 
 #define EXPORT_HANDLE_BUFFER_SIZE			8192
 #define EXPORT_HANDLE_INPUT_BUFFER_SIZE			64
@@ -312,6 +314,24 @@ int export_handle_free(
 				result = -1;
 			}
 		}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( ( *export_handle )->digest_hash_threads != NULL )
+		{
+			if( digest_hash_threads_free(
+			     &( ( *export_handle )->digest_hash_threads ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free digest hash threads.",
+				 function );
+
+				result = -1;
+			}
+		}
+#endif
 		if( ( *export_handle )->md5_context != NULL )
 		{
 			if( libhmac_md5_free(
@@ -1388,9 +1408,36 @@ int export_handle_initialize_integrity_hash(
 		}
 		export_handle->sha256_context_initialized = 1;
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( export_handle->number_of_threads != 0 )
+	{
+		if( digest_hash_threads_initialize(
+		     &( export_handle->digest_hash_threads ),
+		     export_handle->md5_context,
+		     export_handle->sha1_context,
+		     export_handle->sha256_context,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create digest hash threads.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif
 	return( 1 );
 
 on_error:
+	if( export_handle->sha256_context != NULL )
+	{
+		libhmac_sha256_free(
+		 &( export_handle->sha256_context ),
+		 NULL );
+	}
 	if( export_handle->sha1_context != NULL )
 	{
 		libhmac_sha1_free(
@@ -1451,6 +1498,27 @@ int export_handle_update_integrity_hash(
 
 		return( -1 );
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( export_handle->digest_hash_threads != NULL )
+	{
+		if( digest_hash_threads_update(
+		     export_handle->digest_hash_threads,
+		     buffer,
+		     buffer_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update digest hashes.",
+			 function );
+
+			return( -1 );
+		}
+		return( 1 );
+	}
+#endif
 	if( export_handle->calculate_md5 != 0 )
 	{
 		if( libhmac_md5_update(
@@ -1532,6 +1600,26 @@ int export_handle_finalize_integrity_hash(
 
 		return( -1 );
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( export_handle->digest_hash_threads != NULL )
+	{
+		/* Wait for the digest hash threads to process the remaining buffers
+		 */
+		if( digest_hash_threads_free(
+		     &( export_handle->digest_hash_threads ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free digest hash threads.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#endif
 	if( export_handle->calculate_md5 != 0 )
 	{
 		if( export_handle->calculated_md5_hash_string == NULL )
@@ -4577,8 +4665,6 @@ int export_handle_output_storage_media_buffer_callback(
      storage_media_buffer_t *storage_media_buffer,
      export_handle_t *export_handle )
 {
-	libcdata_list_element_t *element                    = NULL;
-	libcdata_list_element_t *next_element               = NULL;
         libcerror_error_t *error                            = NULL;
 	storage_media_buffer_t *output_storage_media_buffer = NULL;
 	uint8_t *data                                       = NULL;
@@ -4613,72 +4699,41 @@ int export_handle_output_storage_media_buffer_callback(
 	{
 		return( 1 );
 	}
-	if( libcdata_list_insert_value(
-	     export_handle->output_list,
-	     (intptr_t *) storage_media_buffer,
-	     (int (*)(intptr_t *, intptr_t *, libcerror_error_t **)) &storage_media_buffer_compare,
-	     LIBCDATA_INSERT_FLAG_UNIQUE_ENTRIES,
+	if( storage_media_buffer_ring_insert_buffer(
+	     export_handle->output_ring,
+	     storage_media_buffer,
 	     &error ) != 1 )
 	{
 		libcerror_error_set(
 		 &error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-		 "%s: unable to insert storage media buffer into output list.",
+		 "%s: unable to insert storage media buffer into output ring.",
 		 function );
 
 		goto on_error;
 	}
 	storage_media_buffer = NULL;
 
-	if( libcdata_list_get_first_element(
-	     export_handle->output_list,
-	     &element,
-	     &error ) != 1 )
+	while( export_handle->abort == 0 )
 	{
-		libcerror_error_set(
-		 &error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve first element.",
-		 function );
+		result = storage_media_buffer_ring_remove_next_buffer(
+		          export_handle->output_ring,
+		          &storage_media_buffer,
+		          &error );
 
-		goto on_error;
-	}
-	while( element != NULL )
-	{
-		if( export_handle->abort != 0 )
-		{
-			break;
-		}
-		if( libcdata_list_element_get_value(
-		     element,
-		     (intptr_t **) &storage_media_buffer,
-		     &error ) != 1 )
+		if( result == -1 )
 		{
 			libcerror_error_set(
 			 &error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve value from list element.",
+			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+			 "%s: unable to remove storage media buffer from output ring.",
 			 function );
 
-			storage_media_buffer = NULL;
-
 			goto on_error;
 		}
-		if( storage_media_buffer == NULL )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing storage media buffer.",
-			 function );
-
-			return( -1 );
-		}
-		if( storage_media_buffer->storage_media_offset != export_handle->last_offset_hashed )
+		else if( result == 0 )
 		{
 			break;
 		}
@@ -4695,8 +4750,6 @@ int export_handle_output_storage_media_buffer_callback(
 			 "%s: unable to determine if storage media buffer is corrupted.",
 			 function );
 
-			storage_media_buffer = NULL;
-
 			goto on_error;
 		}
 		else if( result != 0 )
@@ -4716,8 +4769,6 @@ int export_handle_output_storage_media_buffer_callback(
 				 "%s: unable to append read error.",
 				 function );
 
-				storage_media_buffer = NULL;
-
 				goto on_error;
 			}
 		}
@@ -4734,8 +4785,6 @@ int export_handle_output_storage_media_buffer_callback(
 			 "%s: unable to determine storage media buffer data.",
 			 function );
 
-			storage_media_buffer = NULL;
-
 			goto on_error;
 		}
 		/* Swap byte pairs
@@ -4755,8 +4804,6 @@ int export_handle_output_storage_media_buffer_callback(
 				 "%s: unable to swap byte pairs.",
 				 function );
 
-				storage_media_buffer = NULL;
-
 				goto on_error;
 			}
 		}
@@ -4775,8 +4822,6 @@ int export_handle_output_storage_media_buffer_callback(
 			 "%s: unable to update integrity hash(es).",
 			 function );
 
-			storage_media_buffer = NULL;
-
 			goto on_error;
 		}
 		export_handle->last_offset_hashed = storage_media_buffer->storage_media_offset + storage_media_buffer->processed_size;
@@ -4797,8 +4842,6 @@ int export_handle_output_storage_media_buffer_callback(
 				 "%s: unable to create output storage media buffer.",
 				 function );
 
-				storage_media_buffer = NULL;
-
 				goto on_error;
 			}
 		}
@@ -4818,56 +4861,6 @@ int export_handle_output_storage_media_buffer_callback(
 			 "%s: unable to write to export handle.",
 			 function );
 
-			storage_media_buffer = NULL;
-
-			goto on_error;
-		}
-		if( libcdata_list_element_get_next_element(
-		     element,
-		     &next_element,
-		     &error ) != 1 )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve next list element.",
-			 function );
-
-			storage_media_buffer = NULL;
-
-			goto on_error;
-		}
-		if( libcdata_list_remove_element(
-		     export_handle->output_list,
-		     element,
-		     &error ) != 1 )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
-			 "%s: unable to remove list element from output list.",
-			 function );
-
-			storage_media_buffer = NULL;
-
-			goto on_error;
-		}
-		/* The output list no longer manages the list element and the storage media buffer it contains
-		 */
-		if( libcdata_list_element_free(
-		     &element,
-		     NULL,
-		     &error ) != 1 )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free list element.",
-			 function );
-
 			goto on_error;
 		}
 /* TODO: if storage media buffer can be passed on do not release it */
@@ -4904,8 +4897,6 @@ int export_handle_output_storage_media_buffer_callback(
 				goto on_error;
 			}
 		}
-		element = next_element;
-
 		if( process_status_update(
 		     export_handle->process_status,
 		     export_handle->last_offset_hashed,
@@ -4972,17 +4963,16 @@ on_error:
 	return( -1 );
 }
 
-/* Empties the output list
+/* Empties the output ring
  * Returns 1 if successful or -1 on error
  */
-int export_handle_empty_output_list(
+int export_handle_empty_output_ring(
      export_handle_t *export_handle,
      libcerror_error_t **error )
 {
-	libcdata_list_element_t *element             = NULL;
-	libcdata_list_element_t *next_element        = NULL;
 	storage_media_buffer_t *storage_media_buffer = NULL;
-        static char *function                        = "export_handle_empty_output_list";
+        static char *function                        = "export_handle_empty_output_ring";
+	int result                                   = 0;
 
 	if( export_handle == NULL )
 	{
@@ -4995,109 +4985,45 @@ int export_handle_empty_output_list(
 
 		return( -1 );
 	}
-	if( libcdata_list_get_first_element(
-	     export_handle->output_list,
-	     &element,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve first element.",
-		 function );
-
-		return( -1 );
-	}
-	while( element != NULL )
+	do
 	{
-		if( libcdata_list_element_get_value(
-		     element,
-		     (intptr_t **) &storage_media_buffer,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve value from list element.",
-			 function );
-
-			return( -1 );
-		}
-		if( storage_media_buffer == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing storage media buffer.",
-			 function );
-
-			return( -1 );
-		}
-		if( storage_media_buffer_queue_release_buffer(
-		     export_handle->storage_media_buffer_queue,
-		     storage_media_buffer,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to release storage media buffer onto queue.",
-			 function );
-
-			return( -1 );
-		}
-		storage_media_buffer = NULL;
-
-		if( libcdata_list_element_get_next_element(
-		     element,
-		     &next_element,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve next list element.",
-			 function );
+		result = storage_media_buffer_ring_remove_any_buffer(
+		          export_handle->output_ring,
+		          &storage_media_buffer,
+		          error );
 
-			return( -1 );
-		}
-		if( libcdata_list_remove_element(
-		     export_handle->output_list,
-		     element,
-		     error ) != 1 )
+		if( result == -1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
-			 "%s: unable to remove list element from output list.",
+			 "%s: unable to remove storage media buffer from output ring.",
 			 function );
 
 			return( -1 );
 		}
-		/* The output list no longer manages the list element and the storage media buffer it contains
-		 */
-		if( libcdata_list_element_free(
-		     &element,
-		     NULL,
-		     error ) != 1 )
+		else if( result != 0 )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free list element.",
-			 function );
+			if( storage_media_buffer_queue_release_buffer(
+			     export_handle->storage_media_buffer_queue,
+			     storage_media_buffer,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to release storage media buffer onto queue.",
+				 function );
 
-			return( -1 );
+				return( -1 );
+			}
+			storage_media_buffer = NULL;
 		}
-		element = next_element;
 	}
+	while( result != 0 );
+
 	return( 1 );
 }
 
@@ -5302,15 +5228,16 @@ int export_handle_export_input(
 
 			goto on_error;
 		}
-		if( libcdata_list_initialize(
-		     &( export_handle->output_list ),
+		if( storage_media_buffer_ring_initialize(
+		     &( export_handle->output_ring ),
+		     maximum_number_of_queued_items,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create output list.",
+			 "%s: unable to create output ring.",
 			 function );
 
 			goto on_error;
@@ -5481,6 +5408,20 @@ int export_handle_export_input(
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 		if( export_handle->number_of_threads != 0 )
 		{
+			if( storage_media_buffer_ring_set_sequence_number(
+			     export_handle->output_ring,
+			     input_storage_media_buffer,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set storage media buffer sequence number.",
+				 function );
+
+				goto on_error;
+			}
 			if( libcthreads_thread_pool_push(
 			     export_handle->input_process_thread_pool,
 			     (intptr_t *) input_storage_media_buffer,
@@ -5728,9 +5669,9 @@ int export_handle_export_input(
 			goto on_error;
 		}
 	}
-	if( export_handle->output_list != NULL )
+	if( export_handle->output_ring != NULL )
 	{
-		if( export_handle_empty_output_list(
+		if( export_handle_empty_output_ring(
 		     export_handle,
 		     error ) != 1 )
 		{
@@ -5738,21 +5679,20 @@ int export_handle_export_input(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to empty output list.",
+			 "%s: unable to empty output ring.",
 			 function );
 
 			goto on_error;
 		}
-		if( libcdata_list_free(
-		     &( export_handle->output_list ),
-		     NULL,
+		if( storage_media_buffer_ring_free(
+		     &( export_handle->output_ring ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free output list.",
+			 "%s: unable to free output ring.",
 			 function );
 
 			goto on_error;
@@ -5938,14 +5878,13 @@ on_error:
 		 &( export_handle->output_thread_pool ),
 		 NULL );
 	}
-	if( export_handle->output_list != NULL )
+	if( export_handle->output_ring != NULL )
 	{
-		export_handle_empty_output_list(
+		export_handle_empty_output_ring(
 		 export_handle,
 		 NULL );
-		libcdata_list_free(
-		 &( export_handle->output_list ),
-		 NULL,
+		storage_media_buffer_ring_free(
+		 &( export_handle->output_ring ),
 		 NULL );
 	}
 	if( export_handle->storage_media_buffer_queue != NULL )
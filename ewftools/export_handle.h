@@ -26,6 +26,7 @@
 #include <types.h>
 
 #include "digest_hash.h"
+#include "digest_hash_threads.h"
 #include "ewftools_libcdata.h"
 #include "ewftools_libcerror.h"
 #include "ewftools_libcthreads.h"
@@ -35,6 +36,7 @@
 #include "log_handle.h"
 #include "process_status.h"
 #include "storage_media_buffer.h"
+#include "storage_media_buffer_ring.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -177,14 +179,18 @@ struct export_handle
 	 */
 	libcthreads_thread_pool_t *output_thread_pool;
 
-	/* The output list
+	/* The output ring
 	 */
-	libcdata_list_t *output_list;
+	storage_media_buffer_ring_t *output_ring;
 
 	/* The storage media buffer queue
 	 */
 	libcthreads_queue_t *storage_media_buffer_queue;
 
+	/* The digest hash threads
+	 */
+	digest_hash_threads_t *digest_hash_threads;
+
 #endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
 
 	/* The libewf input handle
@@ -486,7 +492,7 @@ int export_handle_output_storage_media_buffer_callback(
      storage_media_buffer_t *storage_media_buffer,
      export_handle_t *export_handle );
 
-int export_handle_empty_output_list(
+int export_handle_empty_output_ring(
      export_handle_t *export_handle,
      libcerror_error_t **error );
 
@@ -35,6 +35,7 @@
 
 #include "byte_size_string.h"
 #include "digest_hash.h"
+#include "digest_hash_threads.h"
 #include "ewfcommon.h"
 #include "ewfinput.h"
 #include "ewftools_libcerror.h"
@@ -50,6 +51,7 @@
 #include "process_status.h"
 #include "storage_media_buffer.h"
 #include "storage_media_buffer_queue.h"
+#include "storage_media_buffer_ring.h"
 
 #define IMAGING_HANDLE_INPUT_BUFFER_SIZE		64
 #define IMAGING_HANDLE_STRING_SIZE			1024
@@ -294,6 +296,24 @@ int imaging_handle_free(
 			memory_free(
 			 ( *imaging_handle )->notes );
 		}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( ( *imaging_handle )->digest_hash_threads != NULL )
+		{
+			if( digest_hash_threads_free(
+			     &( ( *imaging_handle )->digest_hash_threads ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free digest hash threads.",
+				 function );
+
+				result = -1;
+			}
+		}
+#endif
 		if( ( *imaging_handle )->md5_context != NULL )
 		{
 			if( libhmac_md5_free(
@@ -1356,9 +1376,36 @@ int imaging_handle_initialize_integrity_hash(
 		}
 		imaging_handle->sha256_context_initialized = 1;
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( imaging_handle->number_of_threads != 0 )
+	{
+		if( digest_hash_threads_initialize(
+		     &( imaging_handle->digest_hash_threads ),
+		     imaging_handle->md5_context,
+		     imaging_handle->sha1_context,
+		     imaging_handle->sha256_context,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create digest hash threads.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif
 	return( 1 );
 
 on_error:
+	if( imaging_handle->sha256_context != NULL )
+	{
+		libhmac_sha256_free(
+		 &( imaging_handle->sha256_context ),
+		 NULL );
+	}
 	if( imaging_handle->sha1_context != NULL )
 	{
 		libhmac_sha1_free(
@@ -1419,6 +1466,27 @@ int imaging_handle_update_integrity_hash(
 
 		return( -1 );
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( imaging_handle->digest_hash_threads != NULL )
+	{
+		if( digest_hash_threads_update(
+		     imaging_handle->digest_hash_threads,
+		     buffer,
+		     buffer_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update digest hashes.",
+			 function );
+
+			return( -1 );
+		}
+		return( 1 );
+	}
+#endif
 	if( imaging_handle->calculate_md5 != 0 )
 	{
 		if( libhmac_md5_update(
@@ -1500,6 +1568,26 @@ int imaging_handle_finalize_integrity_hash(
 
 		return( -1 );
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( imaging_handle->digest_hash_threads != NULL )
+	{
+		/* Wait for the digest hash threads to process the remaining buffers
+		 */
+		if( digest_hash_threads_free(
+		     &( imaging_handle->digest_hash_threads ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free digest hash threads.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#endif
 	if( imaging_handle->calculate_md5 != 0 )
 	{
 		if( imaging_handle->calculated_md5_hash_string == NULL )
@@ -1701,15 +1789,16 @@ int imaging_handle_threads_start(
 
 		goto on_error;
 	}
-	if( libcdata_list_initialize(
-	     &( imaging_handle->output_list ),
+	if( storage_media_buffer_ring_initialize(
+	     &( imaging_handle->output_ring ),
+	     maximum_number_of_queued_items,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create output list.",
+		 "%s: unable to create output ring.",
 		 function );
 
 		goto on_error;
@@ -1746,14 +1835,13 @@ on_error:
 		 &( imaging_handle->output_thread_pool ),
 		 NULL );
 	}
-	if( imaging_handle->output_list != NULL )
+	if( imaging_handle->output_ring != NULL )
 	{
-		imaging_handle_empty_output_list(
+		imaging_handle_empty_output_ring(
 		 imaging_handle,
 		 NULL );
-		libcdata_list_free(
-		 &( imaging_handle->output_list ),
-		 NULL,
+		storage_media_buffer_ring_free(
+		 &( imaging_handle->output_ring ),
 		 NULL );
 	}
 	if( imaging_handle->storage_media_buffer_queue != NULL )
@@ -1818,9 +1906,9 @@ int imaging_handle_threads_stop(
 			result = -1;
 		}
 	}
-	if( imaging_handle->output_list != NULL )
+	if( imaging_handle->output_ring != NULL )
 	{
-		if( imaging_handle_empty_output_list(
+		if( imaging_handle_empty_output_ring(
 		     imaging_handle,
 		     error ) != 1 )
 		{
@@ -1828,21 +1916,20 @@ int imaging_handle_threads_stop(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to empty output list.",
+			 "%s: unable to empty output ring.",
 			 function );
 
 			result = -1;
 		}
-		if( libcdata_list_free(
-		     &( imaging_handle->output_list ),
-		     NULL,
+		if( storage_media_buffer_ring_free(
+		     &( imaging_handle->output_ring ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free output list.",
+			 "%s: unable to free output ring.",
 			 function );
 
 			result = -1;
@@ -1976,12 +2063,10 @@ int imaging_handle_output_storage_media_buffer_callback(
      storage_media_buffer_t *storage_media_buffer,
      imaging_handle_t *imaging_handle )
 {
-	libcdata_list_element_t *element      = NULL;
-	libcdata_list_element_t *next_element = NULL;
-        libcerror_error_t *error              = NULL;
-        static char *function                 = "imaging_handle_output_storage_media_buffer_callback";
-	ssize_t write_count                   = 0;
-	int result                            = 0;
+        libcerror_error_t *error = NULL;
+        static char *function    = "imaging_handle_output_storage_media_buffer_callback";
+	ssize_t write_count      = 0;
+	int result               = 0;
 
 	if( imaging_handle == NULL )
 	{
@@ -2009,72 +2094,41 @@ int imaging_handle_output_storage_media_buffer_callback(
 	{
 		return( 1 );
 	}
-	if( libcdata_list_insert_value(
-	     imaging_handle->output_list,
-	     (intptr_t *) storage_media_buffer,
-	     (int (*)(intptr_t *, intptr_t *, libcerror_error_t **)) &storage_media_buffer_compare,
-	     LIBCDATA_INSERT_FLAG_UNIQUE_ENTRIES,
+	if( storage_media_buffer_ring_insert_buffer(
+	     imaging_handle->output_ring,
+	     storage_media_buffer,
 	     &error ) != 1 )
 	{
 		libcerror_error_set(
 		 &error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-		 "%s: unable to insert storage media buffer into output list.",
+		 "%s: unable to insert storage media buffer into output ring.",
 		 function );
 
 		goto on_error;
 	}
 	storage_media_buffer = NULL;
 
-	if( libcdata_list_get_first_element(
-	     imaging_handle->output_list,
-	     &element,
-	     &error ) != 1 )
+	while( imaging_handle->abort == 0 )
 	{
-		libcerror_error_set(
-		 &error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve first element.",
-		 function );
+		result = storage_media_buffer_ring_remove_next_buffer(
+		          imaging_handle->output_ring,
+		          &storage_media_buffer,
+		          &error );
 
-		goto on_error;
-	}
-	while( element != NULL )
-	{
-		if( imaging_handle->abort != 0 )
-		{
-			break;
-		}
-		if( libcdata_list_element_get_value(
-		     element,
-		     (intptr_t **) &storage_media_buffer,
-		     &error ) != 1 )
+		if( result == -1 )
 		{
 			libcerror_error_set(
 			 &error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve value from list element.",
+			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+			 "%s: unable to remove storage media buffer from output ring.",
 			 function );
 
-			storage_media_buffer = NULL;
-
 			goto on_error;
 		}
-		if( storage_media_buffer == NULL )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing storage media buffer.",
-			 function );
-
-			return( -1 );
-		}
-		if( storage_media_buffer->storage_media_offset != imaging_handle->last_offset_written )
+		else if( result == 0 )
 		{
 			break;
 		}
@@ -2093,62 +2147,10 @@ int imaging_handle_output_storage_media_buffer_callback(
 			 "%s: unable to write storage media buffer.",
 			 function );
 
-			storage_media_buffer = NULL;
-
 			goto on_error;
 		}
 		imaging_handle->last_offset_written = storage_media_buffer->storage_media_offset + storage_media_buffer->processed_size;
 
-		if( libcdata_list_element_get_next_element(
-		     element,
-		     &next_element,
-		     &error ) != 1 )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve next list element.",
-			 function );
-
-			storage_media_buffer = NULL;
-
-			goto on_error;
-		}
-		if( libcdata_list_remove_element(
-		     imaging_handle->output_list,
-		     element,
-		     &error ) != 1 )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
-			 "%s: unable to remove list element from output list.",
-			 function );
-
-			storage_media_buffer = NULL;
-
-			goto on_error;
-		}
-		/* The output list no longer manages the list element and the storage media buffer it contains
-		 */
-		if( libcdata_list_element_free(
-		     &element,
-		     NULL,
-		     &error ) != 1 )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free list element.",
-			 function );
-
-			goto on_error;
-		}
-		element = next_element;
-
 		if( storage_media_buffer_queue_release_buffer(
 		     imaging_handle->storage_media_buffer_queue,
 		     storage_media_buffer,
@@ -2235,17 +2237,16 @@ on_error:
 	return( -1 );
 }
 
-/* Empties the output list
+/* Empties the output ring
  * Returns 1 if successful or -1 on error
  */
-int imaging_handle_empty_output_list(
+int imaging_handle_empty_output_ring(
      imaging_handle_t *imaging_handle,
      libcerror_error_t **error )
 {
-	libcdata_list_element_t *element             = NULL;
-	libcdata_list_element_t *next_element        = NULL;
 	storage_media_buffer_t *storage_media_buffer = NULL;
-        static char *function                        = "imaging_handle_empty_output_list";
+        static char *function                        = "imaging_handle_empty_output_ring";
+	int result                                   = 0;
 
 	if( imaging_handle == NULL )
 	{
@@ -2258,109 +2259,45 @@ int imaging_handle_empty_output_list(
 
 		return( -1 );
 	}
-	if( libcdata_list_get_first_element(
-	     imaging_handle->output_list,
-	     &element,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve first element.",
-		 function );
-
-		return( -1 );
-	}
-	while( element != NULL )
+	do
 	{
-		if( libcdata_list_element_get_value(
-		     element,
-		     (intptr_t **) &storage_media_buffer,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve value from list element.",
-			 function );
-
-			return( -1 );
-		}
-		if( storage_media_buffer == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing storage media buffer.",
-			 function );
-
-			return( -1 );
-		}
-		if( storage_media_buffer_queue_release_buffer(
-		     imaging_handle->storage_media_buffer_queue,
-		     storage_media_buffer,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to release storage media buffer onto queue.",
-			 function );
-
-			return( -1 );
-		}
-		storage_media_buffer = NULL;
-
-		if( libcdata_list_element_get_next_element(
-		     element,
-		     &next_element,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve next list element.",
-			 function );
+		result = storage_media_buffer_ring_remove_any_buffer(
+		          imaging_handle->output_ring,
+		          &storage_media_buffer,
+		          error );
 
-			return( -1 );
-		}
-		if( libcdata_list_remove_element(
-		     imaging_handle->output_list,
-		     element,
-		     error ) != 1 )
+		if( result == -1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
-			 "%s: unable to remove list element from output list.",
+			 "%s: unable to remove storage media buffer from output ring.",
 			 function );
 
 			return( -1 );
 		}
-		/* The output list no longer manages the list element and the storage media buffer it contains
-		 */
-		if( libcdata_list_element_free(
-		     &element,
-		     NULL,
-		     error ) != 1 )
+		else if( result != 0 )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free list element.",
-			 function );
+			if( storage_media_buffer_queue_release_buffer(
+			     imaging_handle->storage_media_buffer_queue,
+			     storage_media_buffer,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to release storage media buffer onto queue.",
+				 function );
 
-			return( -1 );
+				return( -1 );
+			}
+			storage_media_buffer = NULL;
 		}
-		element = next_element;
 	}
+	while( result != 0 );
+
 	return( 1 );
 }
 
@@ -26,6 +26,7 @@
 #include <file_stream.h>
 #include <types.h>
 
+#include "digest_hash_threads.h"
 #include "ewftools_libcdata.h"
 #include "ewftools_libcerror.h"
 #include "ewftools_libcthreads.h"
@@ -33,6 +34,7 @@
 #include "ewftools_libhmac.h"
 #include "process_status.h"
 #include "storage_media_buffer.h"
+#include "storage_media_buffer_ring.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -224,14 +226,18 @@ struct imaging_handle
 	 */
 	libcthreads_thread_pool_t *output_thread_pool;
 
-	/* The output list
+	/* The output ring
 	 */
-	libcdata_list_t *output_list;
+	storage_media_buffer_ring_t *output_ring;
 
 	/* The storage media buffer queue
 	 */
 	libcthreads_queue_t *storage_media_buffer_queue;
 
+	/* The digest hash threads
+	 */
+	digest_hash_threads_t *digest_hash_threads;
+
 #endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
 
 	/* The libewf output handle
@@ -360,7 +366,7 @@ int imaging_handle_output_storage_media_buffer_callback(
      storage_media_buffer_t *storage_media_buffer,
      imaging_handle_t *imaging_handle );
 
-int imaging_handle_empty_output_list(
+int imaging_handle_empty_output_ring(
      imaging_handle_t *imaging_handle,
      libcerror_error_t **error );
 
@@ -20,6 +20,7 @@
  */
 
 #include <common.h>
+#include <memory.h>
 #include <narrow_string.h>
 #include <types.h>
 
@@ -37,6 +38,7 @@
 
 #include "ewftools_libcerror.h"
 #include "ewftools_libcnotify.h"
+#include "ewftools_libcthreads.h"
 #include "ewftools_libewf.h"
 #include "ewftools_unused.h"
 #include "mount_fuse.h"
@@ -363,6 +365,11 @@ int mount_fuse_open(
 
 		goto on_error;
 	}
+	/* The image is immutable, hence the page cache of the file
+	 * does not need to be flushed when the file is opened
+	 */
+	file_info->keep_cache = 1;
+
 	return( 0 );
 
 on_error:
@@ -1314,5 +1321,269 @@ on_error:
 	return;
 }
 
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Callback function of a fuse worker thread
+ * The worker thread receives and processes requests until the fuse session exits
+ * Returns 1 if successful or -1 on error
+ */
+int mount_fuse_worker_thread_callback(
+     struct fuse_session *fuse_session )
+{
+	struct fuse_chan *fuse_channel         = NULL;
+	struct fuse_chan *request_fuse_channel = NULL;
+	libcerror_error_t *error               = NULL;
+	char *buffer                           = NULL;
+	static char *function                  = "mount_fuse_worker_thread_callback";
+	size_t buffer_size                     = 0;
+	int read_count                         = 0;
+
+	if( fuse_session == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid fuse session.",
+		 function );
+
+		goto on_error;
+	}
+	fuse_channel = fuse_session_next_chan(
+	                fuse_session,
+	                NULL );
+
+	if( fuse_channel == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid fuse session - missing channel.",
+		 function );
+
+		goto on_error;
+	}
+	buffer_size = fuse_chan_bufsize(
+	               fuse_channel );
+
+	buffer = (char *) memory_allocate(
+	                   sizeof( char ) * buffer_size );
+
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buffer.",
+		 function );
+
+		goto on_error;
+	}
+	while( fuse_session_exited(
+	        fuse_session ) == 0 )
+	{
+		request_fuse_channel = fuse_channel;
+
+		read_count = fuse_chan_recv(
+		              &request_fuse_channel,
+		              buffer,
+		              buffer_size );
+
+		if( read_count == -EINTR )
+		{
+			continue;
+		}
+		/* A read count of 0 indicates the file system was unmounted
+		 */
+		if( read_count <= 0 )
+		{
+			break;
+		}
+		fuse_session_process(
+		 fuse_session,
+		 buffer,
+		 (size_t) read_count,
+		 request_fuse_channel );
+	}
+	/* Have the other worker threads stop after their current request
+	 */
+	fuse_session_exit(
+	 fuse_session );
+
+	memory_free(
+	 buffer );
+
+	if( read_count < 0 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to receive request from fuse channel with error: %d.",
+		 function,
+		 -read_count );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	return( -1 );
+}
+
+/* Runs the fuse event loop using multiple worker threads
+ * Unlike fuse_loop_mt the number of worker threads is fixed, which allows to control
+ * how many reads of the mounted image are processed concurrently
+ * Returns 1 if successful or -1 on error
+ */
+int mount_fuse_loop_with_threads(
+     struct fuse *fuse_handle,
+     int number_of_threads,
+     libcerror_error_t **error )
+{
+	libcthreads_thread_t **worker_threads = NULL;
+	struct fuse_session *fuse_session     = NULL;
+	static char *function                 = "mount_fuse_loop_with_threads";
+	int number_of_worker_threads          = 0;
+	int result                            = 1;
+	int thread_index                      = 0;
+
+	if( fuse_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid fuse handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_threads <= 0 )
+	 || ( number_of_threads > 32 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	fuse_session = fuse_get_session(
+	                fuse_handle );
+
+	if( fuse_session == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid fuse handle - missing session.",
+		 function );
+
+		return( -1 );
+	}
+	worker_threads = (libcthreads_thread_t **) memory_allocate(
+	                                            sizeof( libcthreads_thread_t * ) * number_of_threads );
+
+	if( worker_threads == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create worker threads.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     worker_threads,
+	     0,
+	     sizeof( libcthreads_thread_t * ) * number_of_threads ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear worker threads.",
+		 function );
+
+		memory_free(
+		 worker_threads );
+
+		return( -1 );
+	}
+	for( thread_index = 0;
+	     thread_index < number_of_threads;
+	     thread_index++ )
+	{
+		if( libcthreads_thread_create(
+		     &( worker_threads[ thread_index ] ),
+		     NULL,
+		     (int (*)(void *)) &mount_fuse_worker_thread_callback,
+		     (void *) fuse_session,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create worker thread: %d.",
+			 function,
+			 thread_index );
+
+			result = -1;
+
+			break;
+		}
+		number_of_worker_threads++;
+	}
+	/* The worker threads that were created keep serving requests
+	 * until the file system is unmounted
+	 */
+	for( thread_index = 0;
+	     thread_index < number_of_worker_threads;
+	     thread_index++ )
+	{
+		if( libcthreads_thread_join(
+		     &( worker_threads[ thread_index ] ),
+		     ( result == 1 ) ? error : NULL ) != 1 )
+		{
+			if( result == 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to join worker thread: %d.",
+				 function,
+				 thread_index );
+			}
+			result = -1;
+		}
+	}
+	memory_free(
+	 worker_threads );
+
+	fuse_session_reset(
+	 fuse_session );
+
+	return( result );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
 #endif /* defined( HAVE_LIBFUSE ) || defined( HAVE_LIBOSXFUSE ) */
 
@@ -30,11 +30,17 @@
 
 #if defined( HAVE_LIBFUSE )
 #include <fuse.h>
+#include <fuse_lowlevel.h>
 
 #elif defined( HAVE_LIBOSXFUSE )
 #include <osxfuse/fuse.h>
+#include <osxfuse/fuse/fuse_lowlevel.h>
 #endif
 
+/* The fuse mount options that control the size of the reads
+ */
+#define MOUNT_FUSE_READ_OPTIONS	"max_read=1048576,max_readahead=1048576"
+
 #endif /* defined( HAVE_LIBFUSE ) || defined( HAVE_LIBOSXFUSE ) */
 
 #include "ewftools_libcerror.h"
@@ -102,6 +108,18 @@ int mount_fuse_getattr(
 void mount_fuse_destroy(
       void *private_data );
 
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+int mount_fuse_worker_thread_callback(
+     struct fuse_session *fuse_session );
+
+int mount_fuse_loop_with_threads(
+     struct fuse *fuse_handle,
+     int number_of_threads,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
 #endif /* defined( HAVE_LIBFUSE ) || defined( HAVE_LIBOSXFUSE ) */
 
 #if defined( __cplusplus )
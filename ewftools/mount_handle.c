@@ -29,6 +29,7 @@
 #include "ewftools_libcerror.h"
 #include "ewftools_libcpath.h"
 #include "ewftools_libewf.h"
+#include "ewftools_system_string.h"
 #include "mount_file_entry.h"
 #include "mount_file_system.h"
 #include "mount_handle.h"
@@ -108,6 +109,10 @@ int mount_handle_initialize(
 	}
 	( *mount_handle )->input_format = MOUNT_HANDLE_INPUT_FORMAT_RAW;
 
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	( *mount_handle )->number_of_threads = 4;
+#endif
+
 	return( 1 );
 
 on_error:
@@ -278,6 +283,64 @@ int mount_handle_set_maximum_number_of_open_handles(
 	return( 1 );
 }
 
+/* Sets the number of threads
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int mount_handle_set_number_of_threads(
+     mount_handle_t *mount_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function      = "mount_handle_set_number_of_threads";
+	size_t string_length       = 0;
+	uint64_t number_of_threads = 0;
+	int result                 = 0;
+
+	if( mount_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mount handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( string[ 0 ] != (system_character_t) '-' )
+	{
+		string_length = system_string_length(
+				 string );
+
+		if( ewftools_system_string_decimal_copy_to_64_bit(
+		     string,
+		     string_length + 1,
+		     &number_of_threads,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine number of threads.",
+			 function );
+
+			return( -1 );
+		}
+		result = 1;
+
+		if( number_of_threads > 32 )
+		{
+			result = 0;
+		}
+		else
+		{
+			mount_handle->number_of_threads = (int) number_of_threads;
+		}
+	}
+	return( result );
+}
+
 /* Sets the path prefix
  * Returns 1 if successful or -1 on error
  */
@@ -57,6 +57,10 @@ struct mount_handle
 	 */
 	int maximum_number_of_open_handles;
 
+	/* The number of threads that serve requests from the sub system
+	 */
+	int number_of_threads;
+
 	/* The notification output stream
 	 */
 	FILE *notify_stream;
@@ -84,6 +88,11 @@ int mount_handle_set_maximum_number_of_open_handles(
      int maximum_number_of_open_handles,
      libcerror_error_t **error );
 
+int mount_handle_set_number_of_threads(
+     mount_handle_t *mount_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
 int mount_handle_set_path_prefix(
      mount_handle_t *mount_handle,
      const system_character_t *path_prefix,
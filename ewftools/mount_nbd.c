@@ -0,0 +1,2300 @@
+/*
+ * Mount tool network block device (NBD) functions
+ *
+ * Copyright (C) 2006-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <types.h>
+
+#if defined( HAVE_ERRNO_H )
+#include <errno.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#if defined( HAVE_SYS_SOCKET_H )
+#include <sys/socket.h>
+#endif
+
+#if defined( HAVE_SYS_UN_H )
+#include <sys/un.h>
+#endif
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libcnotify.h"
+#include "ewftools_libcthreads.h"
+#include "ewftools_libewf.h"
+#include "mount_nbd.h"
+
+#if defined( HAVE_SYS_SOCKET_H ) && defined( HAVE_SYS_UN_H )
+
+/* Prevent a write to a connection closed by the client from raising SIGPIPE
+ */
+#if defined( MSG_NOSIGNAL )
+#define MOUNT_NBD_SEND_FLAGS	MSG_NOSIGNAL
+#else
+#define MOUNT_NBD_SEND_FLAGS	0
+#endif
+
+/* Creates a NBD server
+ * Make sure the value nbd_server is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int mount_nbd_server_initialize(
+     mount_nbd_server_t **nbd_server,
+     libewf_handle_t *ewf_handle,
+     int number_of_threads,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_nbd_server_initialize";
+
+	if( nbd_server == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD server.",
+		 function );
+
+		return( -1 );
+	}
+	if( *nbd_server != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid NBD server value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ewf_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid EWF handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( ( number_of_threads < 0 )
+	 || ( number_of_threads > 32 ) )
+#else
+	if( number_of_threads != 0 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*nbd_server = memory_allocate_structure(
+	               mount_nbd_server_t );
+
+	if( *nbd_server == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create NBD server.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *nbd_server,
+	     0,
+	     sizeof( mount_nbd_server_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear NBD server.",
+		 function );
+
+		memory_free(
+		 *nbd_server );
+
+		*nbd_server = NULL;
+
+		return( -1 );
+	}
+	if( libewf_handle_get_media_size(
+	     ewf_handle,
+	     &( ( *nbd_server )->media_size ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve media size.",
+		 function );
+
+		goto on_error;
+	}
+	( *nbd_server )->ewf_handle                   = ewf_handle;
+	( *nbd_server )->number_of_threads            = number_of_threads;
+	( *nbd_server )->socket_descriptor            = -1;
+	( *nbd_server )->connection_socket_descriptor = -1;
+
+	return( 1 );
+
+on_error:
+	if( *nbd_server != NULL )
+	{
+		memory_free(
+		 *nbd_server );
+
+		*nbd_server = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a NBD server
+ * Returns 1 if successful or -1 on error
+ */
+int mount_nbd_server_free(
+     mount_nbd_server_t **nbd_server,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_nbd_server_free";
+	int result            = 1;
+
+	if( nbd_server == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD server.",
+		 function );
+
+		return( -1 );
+	}
+	if( *nbd_server != NULL )
+	{
+		if( ( *nbd_server )->socket_descriptor != -1 )
+		{
+			if( mount_nbd_server_close(
+			     *nbd_server,
+			     error ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close NBD server.",
+				 function );
+
+				result = -1;
+			}
+		}
+		/* The ewf_handle reference is freed elsewhere
+		 */
+		memory_free(
+		 *nbd_server );
+
+		*nbd_server = NULL;
+	}
+	return( result );
+}
+
+/* Signals the NBD server to abort
+ * This function only uses functions that are safe to call from a signal handler
+ * Returns 1 if successful or -1 on error
+ */
+int mount_nbd_server_signal_abort(
+     mount_nbd_server_t *nbd_server,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_nbd_server_signal_abort";
+
+	if( nbd_server == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD server.",
+		 function );
+
+		return( -1 );
+	}
+	nbd_server->abort = 1;
+
+	/* Shutting down the sockets wakes up a thread that is blocked
+	 * in accept or receive
+	 */
+	if( nbd_server->connection_socket_descriptor != -1 )
+	{
+		shutdown(
+		 nbd_server->connection_socket_descriptor,
+		 SHUT_RDWR );
+	}
+	if( nbd_server->socket_descriptor != -1 )
+	{
+		shutdown(
+		 nbd_server->socket_descriptor,
+		 SHUT_RDWR );
+	}
+	return( 1 );
+}
+
+/* Opens the NBD server listening on an Unix domain socket
+ * Returns 1 if successful or -1 on error
+ */
+int mount_nbd_server_open(
+     mount_nbd_server_t *nbd_server,
+     const char *socket_path,
+     libcerror_error_t **error )
+{
+	struct sockaddr_un socket_address;
+
+	static char *function   = "mount_nbd_server_open";
+	size_t socket_path_size = 0;
+
+	if( nbd_server == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD server.",
+		 function );
+
+		return( -1 );
+	}
+	if( nbd_server->socket_descriptor != -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid NBD server - socket descriptor value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( socket_path == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid socket path.",
+		 function );
+
+		return( -1 );
+	}
+	socket_path_size = narrow_string_length(
+	                    socket_path ) + 1;
+
+	if( ( socket_path_size <= 1 )
+	 || ( socket_path_size > sizeof( socket_address.sun_path ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid socket path length value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     &socket_address,
+	     0,
+	     sizeof( struct sockaddr_un ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear socket address.",
+		 function );
+
+		return( -1 );
+	}
+	socket_address.sun_family = AF_UNIX;
+
+	if( memory_copy(
+	     socket_address.sun_path,
+	     socket_path,
+	     socket_path_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy socket path.",
+		 function );
+
+		return( -1 );
+	}
+	nbd_server->socket_path = narrow_string_allocate(
+	                           socket_path_size );
+
+	if( nbd_server->socket_path == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create socket path.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_copy(
+	     nbd_server->socket_path,
+	     socket_path,
+	     socket_path_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy socket path.",
+		 function );
+
+		goto on_error;
+	}
+	nbd_server->socket_descriptor = socket(
+	                                 AF_UNIX,
+	                                 SOCK_STREAM,
+	                                 0 );
+
+	if( nbd_server->socket_descriptor == -1 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 errno,
+		 "%s: unable to create socket.",
+		 function );
+
+		goto on_error;
+	}
+	/* An existing file is not removed, bind fails instead
+	 */
+	if( bind(
+	     nbd_server->socket_descriptor,
+	     (struct sockaddr *) &socket_address,
+	     sizeof( struct sockaddr_un ) ) != 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 errno,
+		 "%s: unable to bind socket to: %s.",
+		 function,
+		 socket_path );
+
+		goto on_error;
+	}
+	if( listen(
+	     nbd_server->socket_descriptor,
+	     4 ) != 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 errno,
+		 "%s: unable to listen on socket.",
+		 function );
+
+		unlink(
+		 nbd_server->socket_path );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( nbd_server->socket_descriptor != -1 )
+	{
+		close(
+		 nbd_server->socket_descriptor );
+
+		nbd_server->socket_descriptor = -1;
+	}
+	if( nbd_server->socket_path != NULL )
+	{
+		memory_free(
+		 nbd_server->socket_path );
+
+		nbd_server->socket_path = NULL;
+	}
+	return( -1 );
+}
+
+/* Closes the NBD server and removes its socket
+ * Returns the 0 if succesful or -1 on error
+ */
+int mount_nbd_server_close(
+     mount_nbd_server_t *nbd_server,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_nbd_server_close";
+	int result            = 0;
+
+	if( nbd_server == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD server.",
+		 function );
+
+		return( -1 );
+	}
+	if( nbd_server->socket_descriptor != -1 )
+	{
+		if( close(
+		     nbd_server->socket_descriptor ) != 0 )
+		{
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 errno,
+			 "%s: unable to close socket.",
+			 function );
+
+			result = -1;
+		}
+		nbd_server->socket_descriptor = -1;
+	}
+	if( nbd_server->socket_path != NULL )
+	{
+		if( unlink(
+		     nbd_server->socket_path ) != 0 )
+		{
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_UNLINK_FAILED,
+			 errno,
+			 "%s: unable to remove socket: %s.",
+			 function,
+			 nbd_server->socket_path );
+
+			result = -1;
+		}
+		memory_free(
+		 nbd_server->socket_path );
+
+		nbd_server->socket_path = NULL;
+	}
+	return( result );
+}
+
+/* Runs the NBD server
+ * The connections are accepted and served one after the other until the server is signalled to abort
+ * Returns 1 if successful or -1 on error
+ */
+int mount_nbd_server_run(
+     mount_nbd_server_t *nbd_server,
+     libcerror_error_t **error )
+{
+	libcerror_error_t *connection_error = NULL;
+	static char *function               = "mount_nbd_server_run";
+	int socket_descriptor               = -1;
+
+	if( nbd_server == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD server.",
+		 function );
+
+		return( -1 );
+	}
+	if( nbd_server->socket_descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid NBD server - missing socket descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	while( nbd_server->abort == 0 )
+	{
+		socket_descriptor = accept(
+		                     nbd_server->socket_descriptor,
+		                     NULL,
+		                     NULL );
+
+		if( socket_descriptor == -1 )
+		{
+			if( errno == EINTR )
+			{
+				continue;
+			}
+			/* The socket was shut down to signal abort
+			 */
+			if( nbd_server->abort != 0 )
+			{
+				break;
+			}
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 errno,
+			 "%s: unable to accept connection.",
+			 function );
+
+			return( -1 );
+		}
+		nbd_server->connection_socket_descriptor = socket_descriptor;
+
+		/* A connection that fails does not stop the server
+		 */
+		if( nbd_server->abort == 0 )
+		{
+			if( mount_nbd_server_serve_connection(
+			     nbd_server,
+			     socket_descriptor,
+			     &connection_error ) != 1 )
+			{
+				libcnotify_print_error_backtrace(
+				 connection_error );
+				libcerror_error_free(
+				 &connection_error );
+			}
+		}
+		nbd_server->connection_socket_descriptor = -1;
+
+		close(
+		 socket_descriptor );
+	}
+	return( 1 );
+}
+
+/* Serves a single connection
+ * Returns 1 if successful or -1 on error
+ */
+int mount_nbd_server_serve_connection(
+     mount_nbd_server_t *nbd_server,
+     int socket_descriptor,
+     libcerror_error_t **error )
+{
+	mount_nbd_connection_t nbd_connection;
+
+	static char *function = "mount_nbd_server_serve_connection";
+	int result            = 0;
+
+	if( nbd_server == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD server.",
+		 function );
+
+		return( -1 );
+	}
+	if( socket_descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid socket descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     &nbd_connection,
+	     0,
+	     sizeof( mount_nbd_connection_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear NBD connection.",
+		 function );
+
+		return( -1 );
+	}
+	nbd_connection.server            = nbd_server;
+	nbd_connection.socket_descriptor = socket_descriptor;
+
+	result = mount_nbd_connection_handshake(
+	          &nbd_connection,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to negotiate connection.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		if( mount_nbd_connection_transmission(
+		     &nbd_connection,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to serve requests.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Reads data from a socket
+ * Returns 1 if successful, 0 if the connection was closed before any data was read or -1 on error
+ */
+int mount_nbd_read_data(
+     int socket_descriptor,
+     uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_nbd_read_data";
+	size_t data_offset    = 0;
+	ssize_t read_count    = 0;
+
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	while( data_offset < data_size )
+	{
+		read_count = recv(
+		              socket_descriptor,
+		              &( data[ data_offset ] ),
+		              data_size - data_offset,
+		              0 );
+
+		if( read_count == -1 )
+		{
+			if( errno == EINTR )
+			{
+				continue;
+			}
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 errno,
+			 "%s: unable to read data.",
+			 function );
+
+			return( -1 );
+		}
+		if( read_count == 0 )
+		{
+			if( data_offset == 0 )
+			{
+				return( 0 );
+			}
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: connection closed after: %" PRIzd " of %" PRIzd " bytes.",
+			 function,
+			 data_offset,
+			 data_size );
+
+			return( -1 );
+		}
+		data_offset += (size_t) read_count;
+	}
+	return( 1 );
+}
+
+/* Writes data to a socket
+ * Returns 1 if successful or -1 on error
+ */
+int mount_nbd_write_data(
+     int socket_descriptor,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_nbd_write_data";
+	size_t data_offset    = 0;
+	ssize_t write_count   = 0;
+
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	while( data_offset < data_size )
+	{
+		write_count = send(
+		               socket_descriptor,
+		               &( data[ data_offset ] ),
+		               data_size - data_offset,
+		               MOUNT_NBD_SEND_FLAGS );
+
+		if( write_count == -1 )
+		{
+			if( errno == EINTR )
+			{
+				continue;
+			}
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 errno,
+			 "%s: unable to write data.",
+			 function );
+
+			return( -1 );
+		}
+		data_offset += (size_t) write_count;
+	}
+	return( 1 );
+}
+
+/* Reads and discards data from the connection
+ * Returns 1 if successful or -1 on error
+ */
+int mount_nbd_connection_discard_data(
+     mount_nbd_connection_t *nbd_connection,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	uint8_t data[ 4096 ];
+
+	static char *function = "mount_nbd_connection_discard_data";
+	size_t read_size      = 0;
+
+	if( nbd_connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD connection.",
+		 function );
+
+		return( -1 );
+	}
+	while( data_size > 0 )
+	{
+		read_size = data_size;
+
+		if( read_size > sizeof( data ) )
+		{
+			read_size = sizeof( data );
+		}
+		if( mount_nbd_read_data(
+		     nbd_connection->socket_descriptor,
+		     data,
+		     read_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read data.",
+			 function );
+
+			return( -1 );
+		}
+		data_size -= read_size;
+	}
+	return( 1 );
+}
+
+/* Writes an option reply during the handshake
+ * Returns 1 if successful or -1 on error
+ */
+int mount_nbd_connection_write_option_reply(
+     mount_nbd_connection_t *nbd_connection,
+     uint32_t option,
+     uint32_t reply_type,
+     const uint8_t *data,
+     uint32_t data_size,
+     libcerror_error_t **error )
+{
+	uint8_t reply_header[ 20 ];
+
+	static char *function = "mount_nbd_connection_write_option_reply";
+
+	if( nbd_connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD connection.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data == NULL )
+	 && ( data_size != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint64_big_endian(
+	 &( reply_header[ 0 ] ),
+	 MOUNT_NBD_OPTION_REPLY_MAGIC );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( reply_header[ 8 ] ),
+	 option );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( reply_header[ 12 ] ),
+	 reply_type );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( reply_header[ 16 ] ),
+	 data_size );
+
+	if( mount_nbd_write_data(
+	     nbd_connection->socket_descriptor,
+	     reply_header,
+	     20,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write option reply header.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > 0 )
+	{
+		if( mount_nbd_write_data(
+		     nbd_connection->socket_descriptor,
+		     data,
+		     (size_t) data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write option reply data.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Negotiates the export using the fixed newstyle handshake
+ * Only a single export is provided, hence the export name is ignored
+ * Returns 1 if the transmission phase was entered, 0 if the client ended the connection or -1 on error
+ */
+int mount_nbd_connection_handshake(
+     mount_nbd_connection_t *nbd_connection,
+     libcerror_error_t **error )
+{
+	uint8_t export_data[ 12 + 124 ];
+	uint8_t handshake_data[ 18 ];
+	uint8_t option_data[ MOUNT_NBD_MAXIMUM_OPTION_SIZE ];
+	uint8_t option_header[ 16 ];
+	uint8_t block_size_data[ 14 ];
+
+	static char *function             = "mount_nbd_connection_handshake";
+	uint64_t magic                    = 0;
+	uint32_t client_flags             = 0;
+	uint32_t export_name_size         = 0;
+	uint32_t option                   = 0;
+	uint32_t option_size              = 0;
+	uint16_t info_request             = 0;
+	uint16_t number_of_info_requests  = 0;
+	uint16_t request_index            = 0;
+	uint16_t transmission_flags       = 0;
+	size_t export_data_size           = 0;
+	uint8_t block_size_requested      = 0;
+	int result                        = 0;
+
+	if( nbd_connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD connection.",
+		 function );
+
+		return( -1 );
+	}
+	if( nbd_connection->server == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid NBD connection - missing server.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint64_big_endian(
+	 &( handshake_data[ 0 ] ),
+	 MOUNT_NBD_MAGIC );
+
+	byte_stream_copy_from_uint64_big_endian(
+	 &( handshake_data[ 8 ] ),
+	 MOUNT_NBD_OPTION_MAGIC );
+
+	byte_stream_copy_from_uint16_big_endian(
+	 &( handshake_data[ 16 ] ),
+	 MOUNT_NBD_HANDSHAKE_FLAG_FIXED_NEWSTYLE | MOUNT_NBD_HANDSHAKE_FLAG_NO_ZEROES );
+
+	if( mount_nbd_write_data(
+	     nbd_connection->socket_descriptor,
+	     handshake_data,
+	     18,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write handshake.",
+		 function );
+
+		return( -1 );
+	}
+	result = mount_nbd_read_data(
+	          nbd_connection->socket_descriptor,
+	          handshake_data,
+	          4,
+	          error );
+
+	if( result != 1 )
+	{
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read client flags.",
+			 function );
+		}
+		return( result );
+	}
+	byte_stream_copy_to_uint32_big_endian(
+	 handshake_data,
+	 client_flags );
+
+	if( ( client_flags & MOUNT_NBD_CLIENT_FLAG_FIXED_NEWSTYLE ) == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported client flags: 0x%08" PRIx32 " - fixed newstyle handshake required.",
+		 function,
+		 client_flags );
+
+		return( -1 );
+	}
+	while( nbd_connection->server->abort == 0 )
+	{
+		result = mount_nbd_read_data(
+		          nbd_connection->socket_descriptor,
+		          option_header,
+		          16,
+		          error );
+
+		if( result != 1 )
+		{
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read option header.",
+				 function );
+			}
+			return( result );
+		}
+		byte_stream_copy_to_uint64_big_endian(
+		 &( option_header[ 0 ] ),
+		 magic );
+
+		byte_stream_copy_to_uint32_big_endian(
+		 &( option_header[ 8 ] ),
+		 option );
+
+		byte_stream_copy_to_uint32_big_endian(
+		 &( option_header[ 12 ] ),
+		 option_size );
+
+		if( magic != MOUNT_NBD_OPTION_MAGIC )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported option magic: 0x%08" PRIx64 ".",
+			 function,
+			 magic );
+
+			return( -1 );
+		}
+		/* The connection is dropped on an oversized option since its data
+		 * is not worth receiving
+		 */
+		if( option_size > MOUNT_NBD_MAXIMUM_OPTION_SIZE )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid option: %" PRIu32 " size value out of bounds.",
+			 function,
+			 option );
+
+			return( -1 );
+		}
+		if( option_size > 0 )
+		{
+			if( mount_nbd_read_data(
+			     nbd_connection->socket_descriptor,
+			     option_data,
+			     (size_t) option_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read option: %" PRIu32 " data.",
+				 function,
+				 option );
+
+				return( -1 );
+			}
+		}
+		transmission_flags = MOUNT_NBD_TRANSMISSION_FLAG_HAS_FLAGS
+		                   | MOUNT_NBD_TRANSMISSION_FLAG_READ_ONLY;
+
+		/* Every read is answered with a single chunk
+		 */
+		if( nbd_connection->structured_replies != 0 )
+		{
+			transmission_flags |= MOUNT_NBD_TRANSMISSION_FLAG_SEND_DF;
+		}
+		switch( option )
+		{
+			case MOUNT_NBD_OPTION_EXPORT_NAME:
+				byte_stream_copy_from_uint64_big_endian(
+				 &( export_data[ 0 ] ),
+				 nbd_connection->server->media_size );
+
+				byte_stream_copy_from_uint16_big_endian(
+				 &( export_data[ 8 ] ),
+				 transmission_flags );
+
+				export_data_size = 10;
+
+				if( ( client_flags & MOUNT_NBD_CLIENT_FLAG_NO_ZEROES ) == 0 )
+				{
+					if( memory_set(
+					     &( export_data[ 10 ] ),
+					     0,
+					     124 ) == NULL )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_MEMORY,
+						 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+						 "%s: unable to clear export data.",
+						 function );
+
+						return( -1 );
+					}
+					export_data_size += 124;
+				}
+				if( mount_nbd_write_data(
+				     nbd_connection->socket_descriptor,
+				     export_data,
+				     export_data_size,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_WRITE_FAILED,
+					 "%s: unable to write export data.",
+					 function );
+
+					return( -1 );
+				}
+				return( 1 );
+
+			case MOUNT_NBD_OPTION_ABORT:
+				if( mount_nbd_connection_write_option_reply(
+				     nbd_connection,
+				     option,
+				     MOUNT_NBD_OPTION_REPLY_ACK,
+				     NULL,
+				     0,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_WRITE_FAILED,
+					 "%s: unable to write abort option reply.",
+					 function );
+
+					return( -1 );
+				}
+				return( 0 );
+
+			case MOUNT_NBD_OPTION_LIST:
+				if( option_size != 0 )
+				{
+					result = mount_nbd_connection_write_option_reply(
+					          nbd_connection,
+					          option,
+					          MOUNT_NBD_OPTION_REPLY_ERROR_INVALID,
+					          NULL,
+					          0,
+					          error );
+				}
+				else
+				{
+					/* The single export has an empty name
+					 */
+					byte_stream_copy_from_uint32_big_endian(
+					 &( export_data[ 0 ] ),
+					 0 );
+
+					result = mount_nbd_connection_write_option_reply(
+					          nbd_connection,
+					          option,
+					          MOUNT_NBD_OPTION_REPLY_SERVER,
+					          export_data,
+					          4,
+					          error );
+
+					if( result == 1 )
+					{
+						result = mount_nbd_connection_write_option_reply(
+						          nbd_connection,
+						          option,
+						          MOUNT_NBD_OPTION_REPLY_ACK,
+						          NULL,
+						          0,
+						          error );
+					}
+				}
+				break;
+
+			case MOUNT_NBD_OPTION_STRUCTURED_REPLY:
+				if( option_size != 0 )
+				{
+					result = mount_nbd_connection_write_option_reply(
+					          nbd_connection,
+					          option,
+					          MOUNT_NBD_OPTION_REPLY_ERROR_INVALID,
+					          NULL,
+					          0,
+					          error );
+				}
+				else
+				{
+					nbd_connection->structured_replies = 1;
+
+					result = mount_nbd_connection_write_option_reply(
+					          nbd_connection,
+					          option,
+					          MOUNT_NBD_OPTION_REPLY_ACK,
+					          NULL,
+					          0,
+					          error );
+				}
+				break;
+
+			case MOUNT_NBD_OPTION_INFO:
+			case MOUNT_NBD_OPTION_GO:
+				/* The option data consists of:
+				 * export name size (4), export name, number of info requests (2) and info requests (2 each)
+				 */
+				number_of_info_requests = 0;
+				block_size_requested    = 0;
+
+				if( option_size >= 6 )
+				{
+					byte_stream_copy_to_uint32_big_endian(
+					 &( option_data[ 0 ] ),
+					 export_name_size );
+
+					if( export_name_size <= ( option_size - 6 ) )
+					{
+						byte_stream_copy_to_uint16_big_endian(
+						 &( option_data[ 4 + export_name_size ] ),
+						 number_of_info_requests );
+					}
+				}
+				if( ( option_size < 6 )
+				 || ( export_name_size > ( option_size - 6 ) )
+				 || ( option_size != ( 6 + export_name_size + ( 2 * (uint32_t) number_of_info_requests ) ) ) )
+				{
+					result = mount_nbd_connection_write_option_reply(
+					          nbd_connection,
+					          option,
+					          MOUNT_NBD_OPTION_REPLY_ERROR_INVALID,
+					          NULL,
+					          0,
+					          error );
+
+					break;
+				}
+				for( request_index = 0;
+				     request_index < number_of_info_requests;
+				     request_index++ )
+				{
+					byte_stream_copy_to_uint16_big_endian(
+					 &( option_data[ 6 + export_name_size + ( 2 * request_index ) ] ),
+					 info_request );
+
+					if( info_request == MOUNT_NBD_INFO_BLOCK_SIZE )
+					{
+						block_size_requested = 1;
+					}
+				}
+				byte_stream_copy_from_uint16_big_endian(
+				 &( export_data[ 0 ] ),
+				 MOUNT_NBD_INFO_EXPORT );
+
+				byte_stream_copy_from_uint64_big_endian(
+				 &( export_data[ 2 ] ),
+				 nbd_connection->server->media_size );
+
+				byte_stream_copy_from_uint16_big_endian(
+				 &( export_data[ 10 ] ),
+				 transmission_flags );
+
+				result = mount_nbd_connection_write_option_reply(
+				          nbd_connection,
+				          option,
+				          MOUNT_NBD_OPTION_REPLY_INFO,
+				          export_data,
+				          12,
+				          error );
+
+				/* The block size info is only sent when requested, since a client
+				 * that receives it is expected to honour the constraints
+				 */
+				if( ( result == 1 )
+				 && ( block_size_requested != 0 ) )
+				{
+					byte_stream_copy_from_uint16_big_endian(
+					 &( block_size_data[ 0 ] ),
+					 MOUNT_NBD_INFO_BLOCK_SIZE );
+
+					byte_stream_copy_from_uint32_big_endian(
+					 &( block_size_data[ 2 ] ),
+					 1 );
+
+					byte_stream_copy_from_uint32_big_endian(
+					 &( block_size_data[ 6 ] ),
+					 MOUNT_NBD_PREFERRED_REQUEST_SIZE );
+
+					byte_stream_copy_from_uint32_big_endian(
+					 &( block_size_data[ 10 ] ),
+					 MOUNT_NBD_MAXIMUM_REQUEST_SIZE );
+
+					result = mount_nbd_connection_write_option_reply(
+					          nbd_connection,
+					          option,
+					          MOUNT_NBD_OPTION_REPLY_INFO,
+					          block_size_data,
+					          14,
+					          error );
+				}
+				if( result == 1 )
+				{
+					result = mount_nbd_connection_write_option_reply(
+					          nbd_connection,
+					          option,
+					          MOUNT_NBD_OPTION_REPLY_ACK,
+					          NULL,
+					          0,
+					          error );
+				}
+				if( ( result == 1 )
+				 && ( option == MOUNT_NBD_OPTION_GO ) )
+				{
+					return( 1 );
+				}
+				break;
+
+			default:
+				result = mount_nbd_connection_write_option_reply(
+				          nbd_connection,
+				          option,
+				          MOUNT_NBD_OPTION_REPLY_ERROR_UNSUPPORTED,
+				          NULL,
+				          0,
+				          error );
+				break;
+		}
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write option: %" PRIu32 " reply.",
+			 function,
+			 option );
+
+			return( -1 );
+		}
+	}
+	return( 0 );
+}
+
+/* Writes a reply during the transmission phase
+ * The reply data contains both the reply header and the payload
+ * Returns 1 if successful or -1 on error
+ */
+int mount_nbd_connection_write_reply(
+     mount_nbd_connection_t *nbd_connection,
+     uint8_t *reply_data,
+     size_t reply_data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_nbd_connection_write_reply";
+	int result            = 1;
+
+	if( nbd_connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD connection.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( nbd_connection->write_mutex != NULL )
+	{
+		if( libcthreads_mutex_grab(
+		     nbd_connection->write_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab write mutex.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#endif
+	/* Once a write failed the stream is out of sync, hence no further replies are written
+	 */
+	if( nbd_connection->write_failed != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write reply after a previous write failed.",
+		 function );
+
+		result = -1;
+	}
+	else if( mount_nbd_write_data(
+	          nbd_connection->socket_descriptor,
+	          reply_data,
+	          reply_data_size,
+	          error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write reply.",
+		 function );
+
+		nbd_connection->write_failed = 1;
+
+		result = -1;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( nbd_connection->write_mutex != NULL )
+	{
+		if( libcthreads_mutex_release(
+		     nbd_connection->write_mutex,
+		     ( result == 1 ) ? error : NULL ) != 1 )
+		{
+			if( result == 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to release write mutex.",
+				 function );
+			}
+			result = -1;
+		}
+	}
+#endif
+	return( result );
+}
+
+/* Writes an error reply
+ * Returns 1 if successful or -1 on error
+ */
+int mount_nbd_connection_write_error_reply(
+     mount_nbd_connection_t *nbd_connection,
+     uint64_t cookie,
+     uint32_t error_value,
+     libcerror_error_t **error )
+{
+	uint8_t reply_data[ MOUNT_NBD_STRUCTURED_REPLY_HEADER_SIZE + 6 ];
+
+	static char *function  = "mount_nbd_connection_write_error_reply";
+	size_t reply_data_size = 0;
+
+	if( nbd_connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD connection.",
+		 function );
+
+		return( -1 );
+	}
+	if( nbd_connection->structured_replies != 0 )
+	{
+		byte_stream_copy_from_uint32_big_endian(
+		 &( reply_data[ 0 ] ),
+		 MOUNT_NBD_STRUCTURED_REPLY_MAGIC );
+
+		byte_stream_copy_from_uint16_big_endian(
+		 &( reply_data[ 4 ] ),
+		 MOUNT_NBD_REPLY_FLAG_DONE );
+
+		byte_stream_copy_from_uint16_big_endian(
+		 &( reply_data[ 6 ] ),
+		 MOUNT_NBD_REPLY_TYPE_ERROR );
+
+		byte_stream_copy_from_uint64_big_endian(
+		 &( reply_data[ 8 ] ),
+		 cookie );
+
+		byte_stream_copy_from_uint32_big_endian(
+		 &( reply_data[ 16 ] ),
+		 6 );
+
+		/* The error payload consists of the error value and an empty message
+		 */
+		byte_stream_copy_from_uint32_big_endian(
+		 &( reply_data[ 20 ] ),
+		 error_value );
+
+		byte_stream_copy_from_uint16_big_endian(
+		 &( reply_data[ 24 ] ),
+		 0 );
+
+		reply_data_size = MOUNT_NBD_STRUCTURED_REPLY_HEADER_SIZE + 6;
+	}
+	else
+	{
+		byte_stream_copy_from_uint32_big_endian(
+		 &( reply_data[ 0 ] ),
+		 MOUNT_NBD_SIMPLE_REPLY_MAGIC );
+
+		byte_stream_copy_from_uint32_big_endian(
+		 &( reply_data[ 4 ] ),
+		 error_value );
+
+		byte_stream_copy_from_uint64_big_endian(
+		 &( reply_data[ 8 ] ),
+		 cookie );
+
+		reply_data_size = MOUNT_NBD_SIMPLE_REPLY_HEADER_SIZE;
+	}
+	if( mount_nbd_connection_write_reply(
+	     nbd_connection,
+	     reply_data,
+	     reply_data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write error reply.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Writes a reply without payload that indicates success
+ * Returns 1 if successful or -1 on error
+ */
+int mount_nbd_connection_write_empty_reply(
+     mount_nbd_connection_t *nbd_connection,
+     uint64_t cookie,
+     libcerror_error_t **error )
+{
+	uint8_t reply_data[ MOUNT_NBD_STRUCTURED_REPLY_HEADER_SIZE ];
+
+	static char *function  = "mount_nbd_connection_write_empty_reply";
+	size_t reply_data_size = 0;
+
+	if( nbd_connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD connection.",
+		 function );
+
+		return( -1 );
+	}
+	if( nbd_connection->structured_replies != 0 )
+	{
+		byte_stream_copy_from_uint32_big_endian(
+		 &( reply_data[ 0 ] ),
+		 MOUNT_NBD_STRUCTURED_REPLY_MAGIC );
+
+		byte_stream_copy_from_uint16_big_endian(
+		 &( reply_data[ 4 ] ),
+		 MOUNT_NBD_REPLY_FLAG_DONE );
+
+		byte_stream_copy_from_uint16_big_endian(
+		 &( reply_data[ 6 ] ),
+		 MOUNT_NBD_REPLY_TYPE_NONE );
+
+		byte_stream_copy_from_uint64_big_endian(
+		 &( reply_data[ 8 ] ),
+		 cookie );
+
+		byte_stream_copy_from_uint32_big_endian(
+		 &( reply_data[ 16 ] ),
+		 0 );
+
+		reply_data_size = MOUNT_NBD_STRUCTURED_REPLY_HEADER_SIZE;
+	}
+	else
+	{
+		byte_stream_copy_from_uint32_big_endian(
+		 &( reply_data[ 0 ] ),
+		 MOUNT_NBD_SIMPLE_REPLY_MAGIC );
+
+		byte_stream_copy_from_uint32_big_endian(
+		 &( reply_data[ 4 ] ),
+		 0 );
+
+		byte_stream_copy_from_uint64_big_endian(
+		 &( reply_data[ 8 ] ),
+		 cookie );
+
+		reply_data_size = MOUNT_NBD_SIMPLE_REPLY_HEADER_SIZE;
+	}
+	if( mount_nbd_connection_write_reply(
+	     nbd_connection,
+	     reply_data,
+	     reply_data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write empty reply.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Reads the data of a read request from the EWF handle and writes the reply
+ * The reply header and data are written with a single write to keep replies
+ * of concurrent requests from interleaving
+ * Returns 1 if successful or -1 on error
+ */
+int mount_nbd_connection_read(
+     mount_nbd_connection_t *nbd_connection,
+     mount_nbd_request_t *request,
+     libcerror_error_t **error )
+{
+	libcerror_error_t *read_error = NULL;
+	uint8_t *reply_data           = NULL;
+	static char *function         = "mount_nbd_connection_read";
+	size_t reply_data_size        = 0;
+	size_t reply_header_size      = 0;
+	ssize_t read_count            = 0;
+	uint32_t error_value          = 0;
+
+	if( nbd_connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD connection.",
+		 function );
+
+		return( -1 );
+	}
+	if( nbd_connection->server == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid NBD connection - missing server.",
+		 function );
+
+		return( -1 );
+	}
+	if( request == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid request.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( request->size == 0 )
+	 || ( request->size > MOUNT_NBD_MAXIMUM_REQUEST_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid request - size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( nbd_connection->structured_replies != 0 )
+	{
+		reply_header_size = MOUNT_NBD_STRUCTURED_REPLY_HEADER_SIZE + 8;
+	}
+	else
+	{
+		reply_header_size = MOUNT_NBD_SIMPLE_REPLY_HEADER_SIZE;
+	}
+	reply_data_size = reply_header_size + (size_t) request->size;
+
+	reply_data = (uint8_t *) memory_allocate(
+	                          sizeof( uint8_t ) * reply_data_size );
+
+	if( reply_data == NULL )
+	{
+		error_value = MOUNT_NBD_ERROR_ENOMEM;
+	}
+	else
+	{
+		read_count = libewf_handle_read_buffer_at_offset(
+		              nbd_connection->server->ewf_handle,
+		              &( reply_data[ reply_header_size ] ),
+		              (size_t) request->size,
+		              (off64_t) request->offset,
+		              &read_error );
+
+		if( read_count != (ssize_t) request->size )
+		{
+			libcnotify_print_error_backtrace(
+			 read_error );
+			libcerror_error_free(
+			 &read_error );
+
+			error_value = MOUNT_NBD_ERROR_EIO;
+		}
+	}
+	if( error_value != 0 )
+	{
+		if( reply_data != NULL )
+		{
+			memory_free(
+			 reply_data );
+		}
+		if( mount_nbd_connection_write_error_reply(
+		     nbd_connection,
+		     request->cookie,
+		     error_value,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write error reply.",
+			 function );
+
+			return( -1 );
+		}
+		return( 1 );
+	}
+	if( nbd_connection->structured_replies != 0 )
+	{
+		byte_stream_copy_from_uint32_big_endian(
+		 &( reply_data[ 0 ] ),
+		 MOUNT_NBD_STRUCTURED_REPLY_MAGIC );
+
+		byte_stream_copy_from_uint16_big_endian(
+		 &( reply_data[ 4 ] ),
+		 MOUNT_NBD_REPLY_FLAG_DONE );
+
+		byte_stream_copy_from_uint16_big_endian(
+		 &( reply_data[ 6 ] ),
+		 MOUNT_NBD_REPLY_TYPE_OFFSET_DATA );
+
+		byte_stream_copy_from_uint64_big_endian(
+		 &( reply_data[ 8 ] ),
+		 request->cookie );
+
+		byte_stream_copy_from_uint32_big_endian(
+		 &( reply_data[ 16 ] ),
+		 8 + request->size );
+
+		byte_stream_copy_from_uint64_big_endian(
+		 &( reply_data[ 20 ] ),
+		 request->offset );
+	}
+	else
+	{
+		byte_stream_copy_from_uint32_big_endian(
+		 &( reply_data[ 0 ] ),
+		 MOUNT_NBD_SIMPLE_REPLY_MAGIC );
+
+		byte_stream_copy_from_uint32_big_endian(
+		 &( reply_data[ 4 ] ),
+		 0 );
+
+		byte_stream_copy_from_uint64_big_endian(
+		 &( reply_data[ 8 ] ),
+		 request->cookie );
+	}
+	if( mount_nbd_connection_write_reply(
+	     nbd_connection,
+	     reply_data,
+	     reply_data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write read reply.",
+		 function );
+
+		memory_free(
+		 reply_data );
+
+		return( -1 );
+	}
+	memory_free(
+	 reply_data );
+
+	return( 1 );
+}
+
+/* Callback function to process a read request
+ * The request is freed after it has been processed
+ * Returns 1 if successful or -1 on error
+ */
+int mount_nbd_connection_request_callback(
+     mount_nbd_request_t *request,
+     mount_nbd_connection_t *nbd_connection )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 1;
+
+	if( request == NULL )
+	{
+		return( -1 );
+	}
+	if( mount_nbd_connection_read(
+	     nbd_connection,
+	     request,
+	     &error ) != 1 )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+
+		result = -1;
+	}
+	memory_free(
+	 request );
+
+	return( result );
+}
+
+/* Serves the requests of the transmission phase until the client disconnects
+ * Returns 1 if successful or -1 on error
+ */
+int mount_nbd_connection_transmission(
+     mount_nbd_connection_t *nbd_connection,
+     libcerror_error_t **error )
+{
+	uint8_t request_header[ MOUNT_NBD_REQUEST_HEADER_SIZE ];
+
+	mount_nbd_request_t *request = NULL;
+	static char *function        = "mount_nbd_connection_transmission";
+	uint64_t cookie              = 0;
+	uint64_t offset              = 0;
+	uint32_t magic               = 0;
+	uint32_t size                = 0;
+	uint16_t command             = 0;
+	int result                   = 1;
+	int read_result              = 0;
+
+	if( nbd_connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD connection.",
+		 function );
+
+		return( -1 );
+	}
+	if( nbd_connection->server == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid NBD connection - missing server.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( nbd_connection->server->number_of_threads > 0 )
+	{
+		if( libcthreads_mutex_initialize(
+		     &( nbd_connection->write_mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create write mutex.",
+			 function );
+
+			goto on_error;
+		}
+		/* Pushing onto a full queue blocks, which stops the receiving
+		 * of requests until the worker threads catch up
+		 */
+		if( libcthreads_thread_pool_create(
+		     &( nbd_connection->request_thread_pool ),
+		     NULL,
+		     nbd_connection->server->number_of_threads,
+		     MOUNT_NBD_MAXIMUM_NUMBER_OF_QUEUED_REQUESTS,
+		     (int (*)(intptr_t *, void *)) &mount_nbd_connection_request_callback,
+		     (void *) nbd_connection,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create request thread pool.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif
+	while( nbd_connection->server->abort == 0 )
+	{
+		if( nbd_connection->write_failed != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write reply.",
+			 function );
+
+			result = -1;
+
+			break;
+		}
+		read_result = mount_nbd_read_data(
+		               nbd_connection->socket_descriptor,
+		               request_header,
+		               MOUNT_NBD_REQUEST_HEADER_SIZE,
+		               error );
+
+		if( read_result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read request header.",
+			 function );
+
+			result = -1;
+
+			break;
+		}
+		/* The client closed the connection without a disconnect request
+		 */
+		else if( read_result == 0 )
+		{
+			break;
+		}
+		byte_stream_copy_to_uint32_big_endian(
+		 &( request_header[ 0 ] ),
+		 magic );
+
+		byte_stream_copy_to_uint16_big_endian(
+		 &( request_header[ 6 ] ),
+		 command );
+
+		byte_stream_copy_to_uint64_big_endian(
+		 &( request_header[ 8 ] ),
+		 cookie );
+
+		byte_stream_copy_to_uint64_big_endian(
+		 &( request_header[ 16 ] ),
+		 offset );
+
+		byte_stream_copy_to_uint32_big_endian(
+		 &( request_header[ 24 ] ),
+		 size );
+
+		if( magic != MOUNT_NBD_REQUEST_MAGIC )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported request magic: 0x%08" PRIx32 ".",
+			 function,
+			 magic );
+
+			result = -1;
+
+			break;
+		}
+		if( command == MOUNT_NBD_COMMAND_DISCONNECT )
+		{
+			break;
+		}
+		switch( command )
+		{
+			case MOUNT_NBD_COMMAND_READ:
+				if( ( size == 0 )
+				 || ( size > MOUNT_NBD_MAXIMUM_REQUEST_SIZE )
+				 || ( offset > nbd_connection->server->media_size )
+				 || ( (size64_t) size > ( nbd_connection->server->media_size - offset ) ) )
+				{
+					result = mount_nbd_connection_write_error_reply(
+					          nbd_connection,
+					          cookie,
+					          MOUNT_NBD_ERROR_EINVAL,
+					          error );
+
+					break;
+				}
+				request = memory_allocate_structure(
+				           mount_nbd_request_t );
+
+				if( request == NULL )
+				{
+					result = mount_nbd_connection_write_error_reply(
+					          nbd_connection,
+					          cookie,
+					          MOUNT_NBD_ERROR_ENOMEM,
+					          error );
+
+					break;
+				}
+				request->cookie = cookie;
+				request->offset = offset;
+				request->size   = size;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+				if( nbd_connection->request_thread_pool != NULL )
+				{
+					/* The request is freed by the callback
+					 */
+					result = libcthreads_thread_pool_push(
+					          nbd_connection->request_thread_pool,
+					          (intptr_t *) request,
+					          error );
+
+					if( result != 1 )
+					{
+						memory_free(
+						 request );
+					}
+					request = NULL;
+
+					break;
+				}
+#endif
+				result = mount_nbd_connection_read(
+				          nbd_connection,
+				          request,
+				          error );
+
+				memory_free(
+				 request );
+
+				request = NULL;
+
+				break;
+
+			case MOUNT_NBD_COMMAND_WRITE:
+				/* The export is read-only, the payload is discarded to keep
+				 * the stream in sync, unless it is too large to be valid
+				 */
+				if( size > MOUNT_NBD_MAXIMUM_REQUEST_SIZE )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+					 "%s: invalid write request size value out of bounds.",
+					 function );
+
+					result = -1;
+
+					break;
+				}
+				result = mount_nbd_connection_discard_data(
+				          nbd_connection,
+				          (size_t) size,
+				          error );
+
+				if( result == 1 )
+				{
+					result = mount_nbd_connection_write_error_reply(
+					          nbd_connection,
+					          cookie,
+					          MOUNT_NBD_ERROR_EPERM,
+					          error );
+				}
+				break;
+
+			case MOUNT_NBD_COMMAND_FLUSH:
+				result = mount_nbd_connection_write_empty_reply(
+				          nbd_connection,
+				          cookie,
+				          error );
+				break;
+
+			default:
+				result = mount_nbd_connection_write_error_reply(
+				          nbd_connection,
+				          cookie,
+				          MOUNT_NBD_ERROR_EINVAL,
+				          error );
+				break;
+		}
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to process request: %" PRIu16 ".",
+			 function,
+			 command );
+
+			result = -1;
+
+			break;
+		}
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* Joining the thread pool waits for the queued requests to be answered
+	 */
+	if( nbd_connection->request_thread_pool != NULL )
+	{
+		if( libcthreads_thread_pool_join(
+		     &( nbd_connection->request_thread_pool ),
+		     ( result == 1 ) ? error : NULL ) != 1 )
+		{
+			if( result == 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to join request thread pool.",
+				 function );
+			}
+			result = -1;
+		}
+	}
+	if( nbd_connection->write_mutex != NULL )
+	{
+		if( libcthreads_mutex_free(
+		     &( nbd_connection->write_mutex ),
+		     ( result == 1 ) ? error : NULL ) != 1 )
+		{
+			if( result == 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free write mutex.",
+				 function );
+			}
+			result = -1;
+		}
+	}
+#endif
+	return( result );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+on_error:
+	if( nbd_connection->request_thread_pool != NULL )
+	{
+		libcthreads_thread_pool_join(
+		 &( nbd_connection->request_thread_pool ),
+		 NULL );
+	}
+	if( nbd_connection->write_mutex != NULL )
+	{
+		libcthreads_mutex_free(
+		 &( nbd_connection->write_mutex ),
+		 NULL );
+	}
+	return( -1 );
+#endif
+}
+
+#endif /* defined( HAVE_SYS_SOCKET_H ) && defined( HAVE_SYS_UN_H ) */
+
@@ -0,0 +1,304 @@
+/*
+ * Mount tool network block device (NBD) functions
+ *
+ * Copyright (C) 2006-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _MOUNT_NBD_H )
+#define _MOUNT_NBD_H
+
+#include <common.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libcthreads.h"
+#include "ewftools_libewf.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if defined( HAVE_SYS_SOCKET_H ) && defined( HAVE_SYS_UN_H )
+
+/* The NBD fixed newstyle handshake values
+ */
+#define MOUNT_NBD_MAGIC						0x4e42444d41474943ULL
+#define MOUNT_NBD_OPTION_MAGIC					0x49484156454f5054ULL
+#define MOUNT_NBD_OPTION_REPLY_MAGIC				0x0003e889045565a9ULL
+
+#define MOUNT_NBD_HANDSHAKE_FLAG_FIXED_NEWSTYLE			0x0001
+#define MOUNT_NBD_HANDSHAKE_FLAG_NO_ZEROES			0x0002
+
+#define MOUNT_NBD_CLIENT_FLAG_FIXED_NEWSTYLE			0x00000001UL
+#define MOUNT_NBD_CLIENT_FLAG_NO_ZEROES				0x00000002UL
+
+#define MOUNT_NBD_OPTION_EXPORT_NAME				1
+#define MOUNT_NBD_OPTION_ABORT					2
+#define MOUNT_NBD_OPTION_LIST					3
+#define MOUNT_NBD_OPTION_INFO					6
+#define MOUNT_NBD_OPTION_GO					7
+#define MOUNT_NBD_OPTION_STRUCTURED_REPLY			8
+
+#define MOUNT_NBD_OPTION_REPLY_ACK				1
+#define MOUNT_NBD_OPTION_REPLY_SERVER				2
+#define MOUNT_NBD_OPTION_REPLY_INFO				3
+#define MOUNT_NBD_OPTION_REPLY_ERROR_UNSUPPORTED		0x80000001UL
+#define MOUNT_NBD_OPTION_REPLY_ERROR_INVALID			0x80000003UL
+
+#define MOUNT_NBD_INFO_EXPORT					0
+#define MOUNT_NBD_INFO_BLOCK_SIZE				3
+
+/* The NBD transmission values
+ */
+#define MOUNT_NBD_TRANSMISSION_FLAG_HAS_FLAGS			0x0001
+#define MOUNT_NBD_TRANSMISSION_FLAG_READ_ONLY			0x0002
+#define MOUNT_NBD_TRANSMISSION_FLAG_SEND_FLUSH			0x0004
+#define MOUNT_NBD_TRANSMISSION_FLAG_SEND_DF			0x0080
+#define MOUNT_NBD_TRANSMISSION_FLAG_CAN_MULTI_CONN		0x0100
+
+#define MOUNT_NBD_REQUEST_MAGIC					0x25609513UL
+#define MOUNT_NBD_SIMPLE_REPLY_MAGIC				0x67446698UL
+#define MOUNT_NBD_STRUCTURED_REPLY_MAGIC			0x668e33efUL
+
+#define MOUNT_NBD_COMMAND_READ					0
+#define MOUNT_NBD_COMMAND_WRITE					1
+#define MOUNT_NBD_COMMAND_DISCONNECT				2
+#define MOUNT_NBD_COMMAND_FLUSH					3
+
+#define MOUNT_NBD_REPLY_FLAG_DONE				0x0001
+
+#define MOUNT_NBD_REPLY_TYPE_NONE				0
+#define MOUNT_NBD_REPLY_TYPE_OFFSET_DATA			1
+#define MOUNT_NBD_REPLY_TYPE_ERROR				0x8001
+
+#define MOUNT_NBD_ERROR_EPERM					1
+#define MOUNT_NBD_ERROR_EIO					5
+#define MOUNT_NBD_ERROR_ENOMEM					12
+#define MOUNT_NBD_ERROR_EINVAL					22
+
+/* The size of the request header
+ */
+#define MOUNT_NBD_REQUEST_HEADER_SIZE				28
+
+/* The size of the simple reply header
+ */
+#define MOUNT_NBD_SIMPLE_REPLY_HEADER_SIZE			16
+
+/* The size of the structured reply header
+ */
+#define MOUNT_NBD_STRUCTURED_REPLY_HEADER_SIZE			20
+
+/* The maximum size of an option or a read request
+ */
+#define MOUNT_NBD_MAXIMUM_OPTION_SIZE				4096
+#define MOUNT_NBD_MAXIMUM_REQUEST_SIZE				( 32 * 1024 * 1024 )
+
+/* The preferred size of a read request
+ */
+#define MOUNT_NBD_PREFERRED_REQUEST_SIZE			( 1024 * 1024 )
+
+/* The maximum number of read requests that can be queued per connection
+ */
+#define MOUNT_NBD_MAXIMUM_NUMBER_OF_QUEUED_REQUESTS		64
+
+typedef struct mount_nbd_request mount_nbd_request_t;
+
+struct mount_nbd_request
+{
+	/* The cookie (or handle) that identifies the request
+	 */
+	uint64_t cookie;
+
+	/* The offset
+	 */
+	uint64_t offset;
+
+	/* The size
+	 */
+	uint32_t size;
+};
+
+typedef struct mount_nbd_server mount_nbd_server_t;
+
+struct mount_nbd_server
+{
+	/* The libewf input handle
+	 */
+	libewf_handle_t *ewf_handle;
+
+	/* The media size
+	 */
+	size64_t media_size;
+
+	/* The number of threads that serve read requests, where 0 represents
+	 * the requests are served by the thread that receives them
+	 */
+	int number_of_threads;
+
+	/* The listening socket descriptor
+	 */
+	int socket_descriptor;
+
+	/* The socket path
+	 */
+	char *socket_path;
+
+	/* The socket descriptor of the current connection
+	 */
+	int connection_socket_descriptor;
+
+	/* Value to indicate the server should abort
+	 */
+	int abort;
+};
+
+typedef struct mount_nbd_connection mount_nbd_connection_t;
+
+/* A connection receives the requests on a single thread and, in
+ * multi-threaded mode, hands the read requests to a thread pool. The
+ * replies are sent when a read request completes, hence they can be
+ * sent out of order.
+ */
+struct mount_nbd_connection
+{
+	/* The server
+	 */
+	mount_nbd_server_t *server;
+
+	/* The socket descriptor
+	 */
+	int socket_descriptor;
+
+	/* Value to indicate structured replies were negotiated
+	 */
+	uint8_t structured_replies;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The mutex that serializes writing the replies
+	 */
+	libcthreads_mutex_t *write_mutex;
+
+	/* The read request thread pool
+	 */
+	libcthreads_thread_pool_t *request_thread_pool;
+#endif
+
+	/* Value to indicate writing a reply failed
+	 */
+	int write_failed;
+};
+
+int mount_nbd_server_initialize(
+     mount_nbd_server_t **nbd_server,
+     libewf_handle_t *ewf_handle,
+     int number_of_threads,
+     libcerror_error_t **error );
+
+int mount_nbd_server_free(
+     mount_nbd_server_t **nbd_server,
+     libcerror_error_t **error );
+
+int mount_nbd_server_signal_abort(
+     mount_nbd_server_t *nbd_server,
+     libcerror_error_t **error );
+
+int mount_nbd_server_open(
+     mount_nbd_server_t *nbd_server,
+     const char *socket_path,
+     libcerror_error_t **error );
+
+int mount_nbd_server_close(
+     mount_nbd_server_t *nbd_server,
+     libcerror_error_t **error );
+
+int mount_nbd_server_run(
+     mount_nbd_server_t *nbd_server,
+     libcerror_error_t **error );
+
+int mount_nbd_server_serve_connection(
+     mount_nbd_server_t *nbd_server,
+     int socket_descriptor,
+     libcerror_error_t **error );
+
+int mount_nbd_read_data(
+     int socket_descriptor,
+     uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int mount_nbd_write_data(
+     int socket_descriptor,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int mount_nbd_connection_discard_data(
+     mount_nbd_connection_t *nbd_connection,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int mount_nbd_connection_write_option_reply(
+     mount_nbd_connection_t *nbd_connection,
+     uint32_t option,
+     uint32_t reply_type,
+     const uint8_t *data,
+     uint32_t data_size,
+     libcerror_error_t **error );
+
+int mount_nbd_connection_handshake(
+     mount_nbd_connection_t *nbd_connection,
+     libcerror_error_t **error );
+
+int mount_nbd_connection_write_reply(
+     mount_nbd_connection_t *nbd_connection,
+     uint8_t *reply_data,
+     size_t reply_data_size,
+     libcerror_error_t **error );
+
+int mount_nbd_connection_write_error_reply(
+     mount_nbd_connection_t *nbd_connection,
+     uint64_t cookie,
+     uint32_t error_value,
+     libcerror_error_t **error );
+
+int mount_nbd_connection_write_empty_reply(
+     mount_nbd_connection_t *nbd_connection,
+     uint64_t cookie,
+     libcerror_error_t **error );
+
+int mount_nbd_connection_read(
+     mount_nbd_connection_t *nbd_connection,
+     mount_nbd_request_t *request,
+     libcerror_error_t **error );
+
+int mount_nbd_connection_request_callback(
+     mount_nbd_request_t *request,
+     mount_nbd_connection_t *nbd_connection );
+
+int mount_nbd_connection_transmission(
+     mount_nbd_connection_t *nbd_connection,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_SYS_SOCKET_H ) && defined( HAVE_SYS_UN_H ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _MOUNT_NBD_H ) */
+
@@ -50,6 +50,10 @@ struct storage_media_buffer
 	 */
 	off64_t storage_media_offset;
 
+	/* The sequence number
+	 */
+	uint64_t sequence_number;
+
 	/* The raw buffer
 	 */
 	uint8_t *raw_buffer;
@@ -0,0 +1,410 @@
+/*
+ * Storage media buffer ring
+ *
+ * Copyright (C) 2006-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "storage_media_buffer.h"
+#include "storage_media_buffer_ring.h"
+
+/* Creates a storage media buffer ring
+ * Make sure the value ring is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int storage_media_buffer_ring_initialize(
+     storage_media_buffer_ring_t **ring,
+     int number_of_buffers,
+     libcerror_error_t **error )
+{
+	static char *function = "storage_media_buffer_ring_initialize";
+	size_t buffers_size   = 0;
+
+	if( ring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid ring.",
+		 function );
+
+		return( -1 );
+	}
+	if( *ring != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid ring value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_buffers <= 0 )
+	 || ( (size_t) number_of_buffers > (size_t) ( MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( storage_media_buffer_t * ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of buffers value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*ring = memory_allocate_structure(
+	         storage_media_buffer_ring_t );
+
+	if( *ring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create ring.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *ring,
+	     0,
+	     sizeof( storage_media_buffer_ring_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear ring.",
+		 function );
+
+		memory_free(
+		 *ring );
+
+		*ring = NULL;
+
+		return( -1 );
+	}
+	buffers_size = sizeof( storage_media_buffer_t * ) * number_of_buffers;
+
+	( *ring )->buffers = (storage_media_buffer_t **) memory_allocate(
+	                                                  buffers_size );
+
+	if( ( *ring )->buffers == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buffers.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *ring )->buffers,
+	     0,
+	     buffers_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear buffers.",
+		 function );
+
+		goto on_error;
+	}
+	( *ring )->number_of_buffers = number_of_buffers;
+
+	return( 1 );
+
+on_error:
+	if( *ring != NULL )
+	{
+		if( ( *ring )->buffers != NULL )
+		{
+			memory_free(
+			 ( *ring )->buffers );
+		}
+		memory_free(
+		 *ring );
+
+		*ring = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a storage media buffer ring
+ * The storage media buffers in the ring are not freed
+ * Returns 1 if successful or -1 on error
+ */
+int storage_media_buffer_ring_free(
+     storage_media_buffer_ring_t **ring,
+     libcerror_error_t **error )
+{
+	static char *function = "storage_media_buffer_ring_free";
+
+	if( ring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid ring.",
+		 function );
+
+		return( -1 );
+	}
+	if( *ring != NULL )
+	{
+		memory_free(
+		 ( *ring )->buffers );
+
+		memory_free(
+		 *ring );
+
+		*ring = NULL;
+	}
+	return( 1 );
+}
+
+/* Sets the sequence number of a storage media buffer
+ * This function must be called in the order in which the storage media buffers are to be removed
+ * Returns 1 if successful or -1 on error
+ */
+int storage_media_buffer_ring_set_sequence_number(
+     storage_media_buffer_ring_t *ring,
+     storage_media_buffer_t *buffer,
+     libcerror_error_t **error )
+{
+	static char *function = "storage_media_buffer_ring_set_sequence_number";
+
+	if( ring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid ring.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	buffer->sequence_number = ring->next_sequence_number;
+
+	ring->next_sequence_number += 1;
+
+	return( 1 );
+}
+
+/* Inserts a storage media buffer into the slot of its sequence number
+ * Returns 1 if successful or -1 on error
+ */
+int storage_media_buffer_ring_insert_buffer(
+     storage_media_buffer_ring_t *ring,
+     storage_media_buffer_t *buffer,
+     libcerror_error_t **error )
+{
+	static char *function = "storage_media_buffer_ring_insert_buffer";
+	int buffer_index      = 0;
+
+	if( ring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid ring.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( buffer->sequence_number < ring->output_sequence_number )
+	 || ( ( buffer->sequence_number - ring->output_sequence_number ) >= (uint64_t) ring->number_of_buffers ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid buffer - sequence number value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	buffer_index = (int) ( buffer->sequence_number % (uint64_t) ring->number_of_buffers );
+
+	if( ring->buffers[ buffer_index ] != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid ring - buffer: %d value already set.",
+		 function,
+		 buffer_index );
+
+		return( -1 );
+	}
+	ring->buffers[ buffer_index ] = buffer;
+
+	ring->number_of_values += 1;
+
+	return( 1 );
+}
+
+/* Removes the storage media buffer with the next sequence number in order
+ * Returns 1 if successful, 0 if the buffer is not available yet or -1 on error
+ */
+int storage_media_buffer_ring_remove_next_buffer(
+     storage_media_buffer_ring_t *ring,
+     storage_media_buffer_t **buffer,
+     libcerror_error_t **error )
+{
+	static char *function = "storage_media_buffer_ring_remove_next_buffer";
+	int buffer_index      = 0;
+
+	if( ring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid ring.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	buffer_index = (int) ( ring->output_sequence_number % (uint64_t) ring->number_of_buffers );
+
+	if( ring->buffers[ buffer_index ] == NULL )
+	{
+		return( 0 );
+	}
+	*buffer = ring->buffers[ buffer_index ];
+
+	ring->buffers[ buffer_index ] = NULL;
+
+	ring->number_of_values       -= 1;
+	ring->output_sequence_number += 1;
+
+	return( 1 );
+}
+
+/* Removes any storage media buffer regardless of its sequence number
+ * This function is intended to empty the ring on abort
+ * Returns 1 if successful, 0 if the ring is empty or -1 on error
+ */
+int storage_media_buffer_ring_remove_any_buffer(
+     storage_media_buffer_ring_t *ring,
+     storage_media_buffer_t **buffer,
+     libcerror_error_t **error )
+{
+	static char *function = "storage_media_buffer_ring_remove_any_buffer";
+	int buffer_index      = 0;
+
+	if( ring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid ring.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( ring->number_of_values == 0 )
+	{
+		return( 0 );
+	}
+	for( buffer_index = 0;
+	     buffer_index < ring->number_of_buffers;
+	     buffer_index++ )
+	{
+		if( ring->buffers[ buffer_index ] != NULL )
+		{
+			*buffer = ring->buffers[ buffer_index ];
+
+			ring->buffers[ buffer_index ] = NULL;
+
+			ring->number_of_values -= 1;
+
+			return( 1 );
+		}
+	}
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+	 "%s: invalid ring - missing buffer.",
+	 function );
+
+	return( -1 );
+}
+
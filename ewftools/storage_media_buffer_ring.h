@@ -0,0 +1,99 @@
+/*
+ * Storage media buffer ring
+ *
+ * Copyright (C) 2006-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _STORAGE_MEDIA_BUFFER_RING_H )
+#define _STORAGE_MEDIA_BUFFER_RING_H
+
+#include <common.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "storage_media_buffer.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct storage_media_buffer_ring storage_media_buffer_ring_t;
+
+/* The storage media buffer ring restores the order of storage media buffers
+ * that were processed out of order. The buffers are stored in the slot of
+ * their sequence number, which requires the number of slots to be at least
+ * the number of storage media buffers that can be in flight.
+ */
+struct storage_media_buffer_ring
+{
+	/* The storage media buffers
+	 */
+	storage_media_buffer_t **buffers;
+
+	/* The number of storage media buffers slots
+	 */
+	int number_of_buffers;
+
+	/* The number of storage media buffers in the ring
+	 */
+	int number_of_values;
+
+	/* The sequence number assigned to the next storage media buffer
+	 */
+	uint64_t next_sequence_number;
+
+	/* The sequence number of the next storage media buffer to be removed
+	 */
+	uint64_t output_sequence_number;
+};
+
+int storage_media_buffer_ring_initialize(
+     storage_media_buffer_ring_t **ring,
+     int number_of_buffers,
+     libcerror_error_t **error );
+
+int storage_media_buffer_ring_free(
+     storage_media_buffer_ring_t **ring,
+     libcerror_error_t **error );
+
+int storage_media_buffer_ring_set_sequence_number(
+     storage_media_buffer_ring_t *ring,
+     storage_media_buffer_t *buffer,
+     libcerror_error_t **error );
+
+int storage_media_buffer_ring_insert_buffer(
+     storage_media_buffer_ring_t *ring,
+     storage_media_buffer_t *buffer,
+     libcerror_error_t **error );
+
+int storage_media_buffer_ring_remove_next_buffer(
+     storage_media_buffer_ring_t *ring,
+     storage_media_buffer_t **buffer,
+     libcerror_error_t **error );
+
+int storage_media_buffer_ring_remove_any_buffer(
+     storage_media_buffer_ring_t *ring,
+     storage_media_buffer_t **buffer,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _STORAGE_MEDIA_BUFFER_RING_H ) */
+
@@ -28,6 +28,7 @@
 
 #include "byte_size_string.h"
 #include "digest_hash.h"
+#include "digest_hash_threads.h"
 #include "ewfcommon.h"
 #include "ewfinput.h"
 #include "ewftools_libcdata.h"
@@ -43,6 +44,7 @@
 #include "process_status.h"
 #include "storage_media_buffer.h"
 #include "storage_media_buffer_queue.h"
+#include "storage_media_buffer_ring.h"
 #include "verification_handle.h"
 
 #define VERIFICATION_HANDLE_VALUE_SIZE				64
@@ -292,6 +294,24 @@ int verification_handle_free(
 
 			result = -1;
 		}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( ( *verification_handle )->digest_hash_threads != NULL )
+		{
+			if( digest_hash_threads_free(
+			     &( ( *verification_handle )->digest_hash_threads ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free digest hash threads.",
+				 function );
+
+				result = -1;
+			}
+		}
+#endif
 		if( ( *verification_handle )->md5_context != NULL )
 		{
 			if( libhmac_md5_free(
@@ -760,9 +780,36 @@ int verification_handle_initialize_integrity_hash(
 		}
 		verification_handle->sha256_context_initialized = 1;
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( verification_handle->number_of_threads != 0 )
+	{
+		if( digest_hash_threads_initialize(
+		     &( verification_handle->digest_hash_threads ),
+		     verification_handle->md5_context,
+		     verification_handle->sha1_context,
+		     verification_handle->sha256_context,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create digest hash threads.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif
 	return( 1 );
 
 on_error:
+	if( verification_handle->sha256_context != NULL )
+	{
+		libhmac_sha256_free(
+		 &( verification_handle->sha256_context ),
+		 NULL );
+	}
 	if( verification_handle->sha1_context != NULL )
 	{
 		libhmac_sha1_free(
@@ -823,6 +870,27 @@ int verification_handle_update_integrity_hash(
 
 		return( -1 );
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( verification_handle->digest_hash_threads != NULL )
+	{
+		if( digest_hash_threads_update(
+		     verification_handle->digest_hash_threads,
+		     buffer,
+		     buffer_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update digest hashes.",
+			 function );
+
+			return( -1 );
+		}
+		return( 1 );
+	}
+#endif
 	if( verification_handle->calculate_md5 != 0 )
 	{
 		if( libhmac_md5_update(
@@ -904,6 +972,26 @@ int verification_handle_finalize_integrity_hash(
 
 		return( -1 );
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( verification_handle->digest_hash_threads != NULL )
+	{
+		/* Wait for the digest hash threads to process the remaining buffers
+		 */
+		if( digest_hash_threads_free(
+		     &( verification_handle->digest_hash_threads ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free digest hash threads.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#endif
 	if( verification_handle->calculate_md5 != 0 )
 	{
 		if( verification_handle->calculated_md5_hash_string == NULL )
@@ -1198,13 +1286,11 @@ int verification_handle_output_storage_media_buffer_callback(
      storage_media_buffer_t *storage_media_buffer,
      verification_handle_t *verification_handle )
 {
-	libcdata_list_element_t *element      = NULL;
-	libcdata_list_element_t *next_element = NULL;
-        libcerror_error_t *error              = NULL;
-	uint8_t *data                         = NULL;
-        static char *function                 = "verification_handle_process_storage_media_buffer_callback";
-	size_t data_size                      = 0;
-	int result                            = 0;
+        libcerror_error_t *error = NULL;
+	uint8_t *data            = NULL;
+        static char *function    = "verification_handle_process_storage_media_buffer_callback";
+	size_t data_size         = 0;
+	int result               = 0;
 
 	if( verification_handle == NULL )
 	{
@@ -1232,72 +1318,41 @@ int verification_handle_output_storage_media_buffer_callback(
 	{
 		return( 1 );
 	}
-	if( libcdata_list_insert_value(
-	     verification_handle->output_list,
-	     (intptr_t *) storage_media_buffer,
-	     (int (*)(intptr_t *, intptr_t *, libcerror_error_t **)) &storage_media_buffer_compare,
-	     LIBCDATA_INSERT_FLAG_UNIQUE_ENTRIES,
+	if( storage_media_buffer_ring_insert_buffer(
+	     verification_handle->output_ring,
+	     storage_media_buffer,
 	     &error ) != 1 )
 	{
 		libcerror_error_set(
 		 &error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-		 "%s: unable to insert storage media buffer into output list.",
+		 "%s: unable to insert storage media buffer into output ring.",
 		 function );
 
 		goto on_error;
 	}
 	storage_media_buffer = NULL;
 
-	if( libcdata_list_get_first_element(
-	     verification_handle->output_list,
-	     &element,
-	     &error ) != 1 )
-	{
-		libcerror_error_set(
-		 &error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve first element.",
-		 function );
-
-		goto on_error;
-	}
-	while( element != NULL )
+	while( verification_handle->abort == 0 )
 	{
-		if( verification_handle->abort != 0 )
-		{
-			break;
-		}
-		if( libcdata_list_element_get_value(
-		     element,
-		     (intptr_t **) &storage_media_buffer,
-		     &error ) != 1 )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve value from list element.",
-			 function );
-
-			storage_media_buffer = NULL;
+		result = storage_media_buffer_ring_remove_next_buffer(
+		          verification_handle->output_ring,
+		          &storage_media_buffer,
+		          &error );
 
-			goto on_error;
-		}
-		if( storage_media_buffer == NULL )
+		if( result == -1 )
 		{
 			libcerror_error_set(
 			 &error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing storage media buffer.",
+			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+			 "%s: unable to remove storage media buffer from output ring.",
 			 function );
 
 			goto on_error;
 		}
-		if( storage_media_buffer->storage_media_offset != verification_handle->last_offset_hashed )
+		else if( result == 0 )
 		{
 			break;
 		}
@@ -1314,8 +1369,6 @@ int verification_handle_output_storage_media_buffer_callback(
 			 "%s: unable to determine if storage media buffer is corrupted.",
 			 function );
 
-			storage_media_buffer = NULL;
-
 			goto on_error;
 		}
 		else if( result != 0 )
@@ -1335,8 +1388,6 @@ int verification_handle_output_storage_media_buffer_callback(
 				 "%s: unable to append read error.",
 				 function );
 
-				storage_media_buffer = NULL;
-
 				goto on_error;
 			}
 		}
@@ -1353,8 +1404,6 @@ int verification_handle_output_storage_media_buffer_callback(
 			 "%s: unable to determine storage media buffer data.",
 			 function );
 
-			storage_media_buffer = NULL;
-
 			goto on_error;
 		}
 		if( verification_handle_update_integrity_hash(
@@ -1370,62 +1419,10 @@ int verification_handle_output_storage_media_buffer_callback(
 			 "%s: unable to update integrity hash(es).",
 			 function );
 
-			storage_media_buffer = NULL;
-
 			goto on_error;
 		}
 		verification_handle->last_offset_hashed = storage_media_buffer->storage_media_offset + storage_media_buffer->processed_size;
 
-		if( libcdata_list_element_get_next_element(
-		     element,
-		     &next_element,
-		     &error ) != 1 )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve next list element.",
-			 function );
-
-			storage_media_buffer = NULL;
-
-			goto on_error;
-		}
-		if( libcdata_list_remove_element(
-		     verification_handle->output_list,
-		     element,
-		     &error ) != 1 )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
-			 "%s: unable to remove list element from output list.",
-			 function );
-
-			storage_media_buffer = NULL;
-
-			goto on_error;
-		}
-		/* The output list no longer manages the list element and the storage media buffer it contains
-		 */
-		if( libcdata_list_element_free(
-		     &element,
-		     NULL,
-		     &error ) != 1 )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free list element.",
-			 function );
-
-			goto on_error;
-		}
-		element = next_element;
-
 		if( storage_media_buffer_queue_release_buffer(
 		     verification_handle->storage_media_buffer_queue,
 		     storage_media_buffer,
@@ -1501,17 +1498,16 @@ on_error:
 	return( -1 );
 }
 
-/* Empties the output list
+/* Empties the output ring
  * Returns 1 if successful or -1 on error
  */
-int verification_handle_empty_output_list(
+int verification_handle_empty_output_ring(
      verification_handle_t *verification_handle,
      libcerror_error_t **error )
 {
-	libcdata_list_element_t *element             = NULL;
-	libcdata_list_element_t *next_element        = NULL;
 	storage_media_buffer_t *storage_media_buffer = NULL;
-        static char *function                        = "verification_handle_empty_output_list";
+        static char *function                        = "verification_handle_empty_output_ring";
+	int result                                   = 0;
 
 	if( verification_handle == NULL )
 	{
@@ -1524,109 +1520,45 @@ int verification_handle_empty_output_list(
 
 		return( -1 );
 	}
-	if( libcdata_list_get_first_element(
-	     verification_handle->output_list,
-	     &element,
-	     error ) != 1 )
+	do
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve first element.",
-		 function );
-
-		return( -1 );
-	}
-	while( element != NULL )
-	{
-		if( libcdata_list_element_get_value(
-		     element,
-		     (intptr_t **) &storage_media_buffer,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve value from list element.",
-			 function );
-
-			return( -1 );
-		}
-		if( storage_media_buffer == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing storage media buffer.",
-			 function );
-
-			return( -1 );
-		}
-		if( storage_media_buffer_queue_release_buffer(
-		     verification_handle->storage_media_buffer_queue,
-		     storage_media_buffer,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to release storage media buffer onto queue.",
-			 function );
-
-			return( -1 );
-		}
-		storage_media_buffer = NULL;
-
-		if( libcdata_list_element_get_next_element(
-		     element,
-		     &next_element,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve next list element.",
-			 function );
+		result = storage_media_buffer_ring_remove_any_buffer(
+		          verification_handle->output_ring,
+		          &storage_media_buffer,
+		          error );
 
-			return( -1 );
-		}
-		if( libcdata_list_remove_element(
-		     verification_handle->output_list,
-		     element,
-		     error ) != 1 )
+		if( result == -1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
-			 "%s: unable to remove list element from output list.",
+			 "%s: unable to remove storage media buffer from output ring.",
 			 function );
 
 			return( -1 );
 		}
-		/* The output list no longer manages the list element and the storage media buffer it contains
-		 */
-		if( libcdata_list_element_free(
-		     &element,
-		     NULL,
-		     error ) != 1 )
+		else if( result != 0 )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free list element.",
-			 function );
+			if( storage_media_buffer_queue_release_buffer(
+			     verification_handle->storage_media_buffer_queue,
+			     storage_media_buffer,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to release storage media buffer onto queue.",
+				 function );
 
-			return( -1 );
+				return( -1 );
+			}
+			storage_media_buffer = NULL;
 		}
-		element = next_element;
 	}
+	while( result != 0 );
+
 	return( 1 );
 }
 
@@ -1790,15 +1722,16 @@ int verification_handle_verify_input(
 
 			goto on_error;
 		}
-		if( libcdata_list_initialize(
-		     &( verification_handle->output_list ),
+		if( storage_media_buffer_ring_initialize(
+		     &( verification_handle->output_ring ),
+		     maximum_number_of_queued_items,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create output list.",
+			 "%s: unable to create output ring.",
 			 function );
 
 			goto on_error;
@@ -1967,6 +1900,20 @@ int verification_handle_verify_input(
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 		if( verification_handle->number_of_threads != 0 )
 		{
+			if( storage_media_buffer_ring_set_sequence_number(
+			     verification_handle->output_ring,
+			     storage_media_buffer,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set storage media buffer sequence number.",
+				 function );
+
+				goto on_error;
+			}
 			if( libcthreads_thread_pool_push(
 			     verification_handle->process_thread_pool,
 			     (intptr_t *) storage_media_buffer,
@@ -2140,9 +2087,9 @@ int verification_handle_verify_input(
 			goto on_error;
 		}
 	}
-	if( verification_handle->output_list != NULL )
+	if( verification_handle->output_ring != NULL )
 	{
-		if( verification_handle_empty_output_list(
+		if( verification_handle_empty_output_ring(
 		     verification_handle,
 		     error ) != 1 )
 		{
@@ -2150,21 +2097,20 @@ int verification_handle_verify_input(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to empty output list.",
+			 "%s: unable to empty output ring.",
 			 function );
 
 			goto on_error;
 		}
-		if( libcdata_list_free(
-		     &( verification_handle->output_list ),
-		     NULL,
+		if( storage_media_buffer_ring_free(
+		     &( verification_handle->output_ring ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free output list.",
+			 "%s: unable to free output ring.",
 			 function );
 
 			goto on_error;
@@ -2441,14 +2387,13 @@ on_error:
 		 &( verification_handle->output_thread_pool ),
 		 NULL );
 	}
-	if( verification_handle->output_list != NULL )
+	if( verification_handle->output_ring != NULL )
 	{
-		verification_handle_empty_output_list(
+		verification_handle_empty_output_ring(
 		 verification_handle,
 		 NULL );
-		libcdata_list_free(
-		 &( verification_handle->output_list ),
-		 NULL,
+		storage_media_buffer_ring_free(
+		 &( verification_handle->output_ring ),
 		 NULL );
 	}
 	if( verification_handle->storage_media_buffer_queue != NULL )
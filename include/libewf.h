@@ -101,6 +101,57 @@ typedef int (*file_seek_ptr)(void*, int64_t);
 typedef int (*file_write_ptr)(void*, const uint8_t*, int32_t, int32_t*);
 typedef int (*file_get_size_ptr)(void*, int64_t*);
 
+/* A range of a vectored read, read_count is set by the callback
+ */
+#if !defined( HAVE_FILE_READ_RANGE_T )
+#define HAVE_FILE_READ_RANGE_T
+
+typedef struct file_read_range
+{
+  int64_t offset;
+  uint8_t* buffer;
+  int32_t size;
+  int32_t read_count;
+} file_read_range_t;
+
+#endif
+
+typedef int (*file_read_vector_ptr)(void*, file_read_range_t*, int32_t);
+typedef int (*file_read_submit_ptr)(void*, file_read_range_t*, int32_t, void**);
+typedef int (*file_read_complete_ptr)(void*, void*);
+typedef int (*file_read64_ptr)(void*, int64_t, uint8_t*, int64_t, int64_t*);
+typedef int (*file_write64_ptr)(void*, const uint8_t*, int64_t, int64_t*);
+
+/* An IO backend that can be bound to a handle with libewf_handle_set_io_backend
+ * The user data is passed as the first argument of every callback,
+ * the second argument is the handle created by file_create_handle
+ * The vectored and asynchronous read callbacks are optional,
+ * reads larger than a non-zero maximum read size are split into multiple callbacks
+ * The optional file_read64 and file_write64 callbacks are used instead of file_read and file_write when set
+ */
+#if !defined( HAVE_FILE_IO_BACKEND_T )
+#define HAVE_FILE_IO_BACKEND_T
+
+typedef struct file_io_backend
+{
+  void* user_data;
+  int (*file_create_handle)(void*, const char*, uint32_t, uint32_t, uint32_t, void**);
+  int (*file_create_handle_wide)(void*, const wchar_t*, uint32_t, uint32_t, uint32_t, void**);
+  int (*file_close_handle)(void*, void*);
+  int (*file_read)(void*, void*, int64_t, uint8_t*, int32_t, int32_t*);
+  int (*file_seek)(void*, void*, int64_t);
+  int (*file_write)(void*, void*, const uint8_t*, int32_t, int32_t*);
+  int (*file_get_size)(void*, void*, int64_t*);
+  int (*file_read_vector)(void*, void*, file_read_range_t*, int32_t);
+  int (*file_read_submit)(void*, void*, file_read_range_t*, int32_t, void**);
+  int (*file_read_complete)(void*, void*, void*);
+  int32_t maximum_read_size;
+  int (*file_read64)(void*, void*, int64_t, uint8_t*, int64_t, int64_t*);
+  int (*file_write64)(void*, void*, const uint8_t*, int64_t, int64_t*);
+} file_io_backend_t;
+
+#endif
+
 LIBEWF_EXTERN \
 int libewf_set_io_backend(
   file_exists_ptr file_exists,
@@ -113,6 +164,28 @@ int libewf_set_io_backend(
   file_write_ptr file_write,
   file_get_size_ptr file_get_size);
 
+/* Sets the optional vectored and asynchronous read callbacks of the IO backend
+ * The vectored read callback reads multiple ranges with a single call
+ * The submit and complete callbacks start the read of multiple ranges and wait for it to finish,
+ * they are only used when both are set
+ * Returns 1 if successful or -1 on error
+ */
+LIBEWF_EXTERN \
+int libewf_set_io_backend_vectored(
+  file_read_vector_ptr file_read_vector,
+  file_read_submit_ptr file_read_submit,
+  file_read_complete_ptr file_read_complete);
+
+/* Sets the optional read and write callbacks with 64-bit sizes of the IO backend
+ * When set they are used instead of the read and write callbacks set with libewf_set_io_backend,
+ * so that transfers larger than 2 GiB are passed to the IO backend with a single call
+ * Returns 1 if successful or -1 on error
+ */
+LIBEWF_EXTERN \
+int libewf_set_io_backend_64(
+  file_read64_ptr file_read64,
+  file_write64_ptr file_write64);
+
 /* Determines if a file contains an EWF file signature
  * Returns 1 if true, 0 if not or -1 on error
  */
@@ -479,6 +552,122 @@ int libewf_handle_set_maximum_number_of_open_handles(
      int maximum_number_of_open_handles,
      libewf_error_t **error );
 
+/* Sets the IO backend of the segment files
+ * The IO backend is used instead of the one set with libewf_set_io_backend
+ * by the segment files opened or created after it is set
+ * The IO backend is not copied and must remain valid while the handle is open
+ * A NULL IO backend resets the handle to the process-wide IO backend
+ * Returns 1 if successful or -1 on error
+ */
+LIBEWF_EXTERN \
+int libewf_handle_set_io_backend(
+     libewf_handle_t *handle,
+     const file_io_backend_t *io_backend,
+     libewf_error_t **error );
+
+/* Sets the filename of the index file
+ * The index file contains the sections and chunk groups of the segment files
+ * so they do not need to be scanned again when the segment files are reopened
+ * Returns 1 if successful or -1 on error
+ */
+LIBEWF_EXTERN \
+int libewf_handle_set_index_filename(
+     libewf_handle_t *handle,
+     const char *filename,
+     size_t filename_length,
+     libewf_error_t **error );
+
+#if defined( LIBEWF_HAVE_WIDE_CHARACTER_TYPE )
+
+/* Sets the filename of the index file
+ * Returns 1 if successful or -1 on error
+ */
+LIBEWF_EXTERN \
+int libewf_handle_set_index_filename_wide(
+     libewf_handle_t *handle,
+     const wchar_t *filename,
+     size_t filename_length,
+     libewf_error_t **error );
+
+#endif /* defined( LIBEWF_HAVE_WIDE_CHARACTER_TYPE ) */
+
+/* Sets the number of decompression threads
+ * Reads that span multiple chunks are unpacked concurrently by the decompression threads
+ * A value of 0 disables the decompression threads
+ * Returns 1 if successful or -1 on error
+ */
+LIBEWF_EXTERN \
+int libewf_handle_set_number_of_decompression_threads(
+     libewf_handle_t *handle,
+     int number_of_threads,
+     libewf_error_t **error );
+
+/* Sets the number of compression threads
+ * Chunks written by write buffer are packed concurrently by the compression threads
+ * and written in order, errors of packing or writing a chunk can be returned by a subsequent call
+ * Adaptive compression is not supported with compression threads, the entropy test is
+ * A value of 0 disables the compression threads
+ * Returns 1 if successful or -1 on error
+ */
+LIBEWF_EXTERN \
+int libewf_handle_set_number_of_compression_threads(
+     libewf_handle_t *handle,
+     int number_of_threads,
+     libewf_error_t **error );
+
+/* Sets the number of open threads
+ * The segment files are read concurrently by the open threads when the handle is opened
+ * A value of 0 disables the open threads
+ * Returns 1 if successful or -1 on error
+ */
+LIBEWF_EXTERN \
+int libewf_handle_set_number_of_open_threads(
+     libewf_handle_t *handle,
+     int number_of_threads,
+     libewf_error_t **error );
+
+/* Sets the prefetch depth
+ * When a sequential access pattern is detected, up to prefetch depth chunks
+ * following the read are read and unpacked into the chunk cache by a background thread
+ * A value of 0 disables prefetching
+ * Returns 1 if successful or -1 on error
+ */
+LIBEWF_EXTERN \
+int libewf_handle_set_prefetch_depth(
+     libewf_handle_t *handle,
+     int prefetch_depth,
+     libewf_error_t **error );
+
+/* Retrieves the number of prefetched chunks that were read and that were evicted without being read
+ * Returns 1 if successful or -1 on error
+ */
+LIBEWF_EXTERN \
+int libewf_handle_get_prefetch_statistics(
+     libewf_handle_t *handle,
+     uint64_t *number_of_hits,
+     uint64_t *number_of_wasted,
+     libewf_error_t **error );
+
+/* Sets the maximum size of the chunk cache
+ * The cache holds unpacked chunk data, a value of 0 disables caching
+ * Returns 1 if successful or -1 on error
+ */
+LIBEWF_EXTERN \
+int libewf_handle_set_maximum_cache_size(
+     libewf_handle_t *handle,
+     size64_t maximum_cache_size,
+     libewf_error_t **error );
+
+/* Retrieves the number of chunk cache hits and misses
+ * Returns 1 if successful or -1 on error
+ */
+LIBEWF_EXTERN \
+int libewf_handle_get_cache_statistics(
+     libewf_handle_t *handle,
+     uint64_t *number_of_hits,
+     uint64_t *number_of_misses,
+     libewf_error_t **error );
+
 /* Retrieves the segment filename size
  * The filename size includes the end of string character
  * Returns 1 if successful, 0 if not set or -1 on error
@@ -566,6 +755,18 @@ int libewf_handle_set_maximum_segment_size(
      size64_t maximum_segment_size,
      libewf_error_t **error );
 
+/* Sets the write buffer size
+ * The segment files created for writing collect the data written in a write buffer
+ * of this size, which is written to the file in a single write when full
+ * A value of 0 disables the write buffer
+ * Returns 1 if successful or -1 on error
+ */
+LIBEWF_EXTERN \
+int libewf_handle_set_write_buffer_size(
+     libewf_handle_t *handle,
+     size_t write_buffer_size,
+     libewf_error_t **error );
+
 /* Determine if the segment files are corrupted
  * Returns 1 if corrupted, 0 if not or -1 on error
  */
@@ -746,6 +947,7 @@ int libewf_handle_get_compression_values(
      libewf_error_t **error );
 
 /* Sets the compression values
+ * Adaptive compression cannot be set when compression threads are used
  * Returns 1 if successful or -1 on error
  */
 LIBEWF_EXTERN \
@@ -755,6 +957,16 @@ int libewf_handle_set_compression_values(
      uint8_t compression_flags,
      libewf_error_t **error );
 
+/* Retrieves the number of chunks for which compression was skipped by the entropy test and by adaptive compression
+ * Returns 1 if successful or -1 on error
+ */
+LIBEWF_EXTERN \
+int libewf_handle_get_compression_skip_statistics(
+     libewf_handle_t *handle,
+     uint64_t *number_of_entropy_skips,
+     uint64_t *number_of_adaptive_skips,
+     libewf_error_t **error );
+
 /* Retrieves the size of the contained (media) data
  * This function will compensate for a media_size that is not a multitude of bytes_per_sector
  * Returns 1 if successful or -1 on error
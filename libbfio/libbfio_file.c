@@ -102,6 +102,42 @@ int libbfio_file_initialize(
 
 		goto on_error;
 	}
+	if( libbfio_handle_set_read_vector_function(
+	     *handle,
+	     (ssize_t (*)(intptr_t *, libbfio_read_range_t *, int, libcerror_error_t **)) libbfio_file_io_handle_read_vector,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set read vector function.",
+		 function );
+
+		libbfio_handle_free(
+		 handle,
+		 NULL );
+
+		return( -1 );
+	}
+	if( libbfio_handle_set_read_buffer_at_offset_function(
+	     *handle,
+	     (ssize_t (*)(intptr_t *, uint8_t *, size_t, off64_t, libcerror_error_t **)) libbfio_file_io_handle_read_buffer_at_offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set read buffer at offset function.",
+		 function );
+
+		libbfio_handle_free(
+		 handle,
+		 NULL );
+
+		return( -1 );
+	}
 	return( 1 );
 
 on_error:
@@ -442,3 +478,45 @@ on_error:
 
 #endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
 
+/* Sets the IO backend of the file
+ * The IO backend is not copied and must remain valid while the handle is in use
+ * A NULL IO backend resets the file to the process-wide IO backend
+ * Returns 1 if successful or -1 on error
+ */
+int libbfio_file_set_io_backend(
+     libbfio_handle_t *handle,
+     const file_io_backend_t *io_backend,
+     libcerror_error_t **error )
+{
+	libbfio_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libbfio_file_set_io_backend";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libbfio_internal_handle_t *) handle;
+
+	if( libbfio_file_io_handle_set_io_backend(
+	     (libbfio_file_io_handle_t *) internal_handle->io_handle,
+	     io_backend,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set IO backend.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
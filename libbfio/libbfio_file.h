@@ -27,6 +27,7 @@
 
 #include "libbfio_extern.h"
 #include "libbfio_libcerror.h"
+#include "libbfio_libcfile.h"
 #include "libbfio_types.h"
 
 #if defined( __cplusplus )
@@ -82,6 +83,12 @@ int libbfio_file_set_name_wide(
 
 #endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
 
+LIBBFIO_EXTERN \
+int libbfio_file_set_io_backend(
+     libbfio_handle_t *handle,
+     const file_io_backend_t *io_backend,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
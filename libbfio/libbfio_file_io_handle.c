@@ -288,6 +288,23 @@ int libbfio_file_io_handle_clone(
 
 		( *destination_file_io_handle )->name_size = source_file_io_handle->name_size;
 	}
+	if( source_file_io_handle->io_backend != NULL )
+	{
+		if( libbfio_file_io_handle_set_io_backend(
+		     *destination_file_io_handle,
+		     source_file_io_handle->io_backend,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set IO backend.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	return( 1 );
 
 on_error:
@@ -768,6 +785,47 @@ on_error:
 
 #endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
 
+/* Sets the IO backend of the file IO handle
+ * The IO backend is not copied and must remain valid while the file IO handle is in use
+ * Returns 1 if succesful or -1 on error
+ */
+int libbfio_file_io_handle_set_io_backend(
+     libbfio_file_io_handle_t *file_io_handle,
+     const file_io_backend_t *io_backend,
+     libcerror_error_t **error )
+{
+	static char *function = "libbfio_file_io_handle_set_io_backend";
+
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcfile_file_set_io_backend(
+	     file_io_handle->file,
+	     io_backend,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set IO backend of file.",
+		 function );
+
+		return( -1 );
+	}
+	file_io_handle->io_backend = io_backend;
+
+	return( 1 );
+}
+
 /* Opens the file handle
  * Returns 1 if successful or -1 on error
  */
@@ -936,6 +994,198 @@ ssize_t libbfio_file_io_handle_read_buffer(
 	return( read_count );
 }
 
+/* Reads a buffer from the file handle at a specific offset
+ * The current offset of the file handle is not changed
+ * Returns the number of bytes read if successful, or -1 on error
+ */
+ssize_t libbfio_file_io_handle_read_buffer_at_offset(
+         libbfio_file_io_handle_t *file_io_handle,
+         uint8_t *buffer,
+         size_t size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	static char *function = "libbfio_file_io_handle_read_buffer_at_offset";
+	ssize_t read_count    = 0;
+
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle->name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file IO handle - missing name.",
+		 function );
+
+		return( -1 );
+	}
+	read_count = libcfile_file_read_buffer_at_offset(
+	              file_io_handle->file,
+	              buffer,
+	              size,
+	              offset,
+	              error );
+
+	if( read_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read from file: %" PRIs_SYSTEM " at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 file_io_handle->name,
+		 offset,
+		 offset );
+
+		return( -1 );
+	}
+	return( read_count );
+}
+
+/* Reads multiple ranges from the file handle
+ * Returns the total number of bytes read if successful, or -1 on error
+ */
+ssize_t libbfio_file_io_handle_read_vector(
+         libbfio_file_io_handle_t *file_io_handle,
+         libbfio_read_range_t *ranges,
+         int number_of_ranges,
+         libcerror_error_t **error )
+{
+	file_read_range_t *file_ranges = NULL;
+	static char *function          = "libbfio_file_io_handle_read_vector";
+	ssize_t read_count             = 0;
+	int range_index                = 0;
+
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle->name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file IO handle - missing name.",
+		 function );
+
+		return( -1 );
+	}
+	if( ranges == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid ranges.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_ranges <= 0 )
+	 || ( (size_t) number_of_ranges > ( MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( file_read_range_t ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of ranges value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	file_ranges = (file_read_range_t *) memory_allocate(
+	                                     sizeof( file_read_range_t ) * number_of_ranges );
+
+	if( file_ranges == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create file ranges.",
+		 function );
+
+		goto on_error;
+	}
+	for( range_index = 0;
+	     range_index < number_of_ranges;
+	     range_index++ )
+	{
+		if( ranges[ range_index ].size > (size_t) INT32_MAX )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid range: %d size value exceeds maximum.",
+			 function,
+			 range_index );
+
+			goto on_error;
+		}
+		file_ranges[ range_index ].offset     = (int64_t) ranges[ range_index ].offset;
+		file_ranges[ range_index ].buffer     = ranges[ range_index ].buffer;
+		file_ranges[ range_index ].size       = (int32_t) ranges[ range_index ].size;
+		file_ranges[ range_index ].read_count = 0;
+	}
+	read_count = libcfile_file_read_vector(
+	              file_io_handle->file,
+	              file_ranges,
+	              number_of_ranges,
+	              error );
+
+	if( read_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read ranges from file: %" PRIs_SYSTEM ".",
+		 function,
+		 file_io_handle->name );
+
+		goto on_error;
+	}
+	for( range_index = 0;
+	     range_index < number_of_ranges;
+	     range_index++ )
+	{
+		ranges[ range_index ].read_count = (ssize_t) file_ranges[ range_index ].read_count;
+	}
+	memory_free(
+	 file_ranges );
+
+	return( read_count );
+
+on_error:
+	if( file_ranges != NULL )
+	{
+		memory_free(
+		 file_ranges );
+	}
+	return( -1 );
+}
+
 /* Writes a buffer to the file handle
  * Returns the number of bytes written if successful, or -1 on error
  */
@@ -25,6 +25,7 @@
 #include <common.h>
 #include <types.h>
 
+#include "libbfio_handle.h"
 #include "libbfio_libcerror.h"
 #include "libbfio_libcfile.h"
 
@@ -51,6 +52,10 @@ struct libbfio_file_io_handle
 	/* The access flags
 	 */
 	int access_flags;
+
+	/* The IO backend
+	 */
+	const file_io_backend_t *io_backend;
 };
 
 int libbfio_file_io_handle_initialize(
@@ -104,6 +109,11 @@ int libbfio_file_io_handle_set_name_wide(
 
 #endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
 
+int libbfio_file_io_handle_set_io_backend(
+     libbfio_file_io_handle_t *file_io_handle,
+     const file_io_backend_t *io_backend,
+     libcerror_error_t **error );
+
 int libbfio_file_io_handle_open(
      libbfio_file_io_handle_t *file_io_handle,
      int access_flags,
@@ -119,6 +129,19 @@ ssize_t libbfio_file_io_handle_read_buffer(
          size_t size,
          libcerror_error_t **error );
 
+ssize_t libbfio_file_io_handle_read_buffer_at_offset(
+         libbfio_file_io_handle_t *file_io_handle,
+         uint8_t *buffer,
+         size_t size,
+         off64_t offset,
+         libcerror_error_t **error );
+
+ssize_t libbfio_file_io_handle_read_vector(
+         libbfio_file_io_handle_t *file_io_handle,
+         libbfio_read_range_t *ranges,
+         int number_of_ranges,
+         libcerror_error_t **error );
+
 ssize_t libbfio_file_io_handle_write_buffer(
          libbfio_file_io_handle_t *file_io_handle,
          const uint8_t *buffer,
@@ -449,6 +449,9 @@ int libbfio_handle_clone(
 	}
 	destination_io_handle = NULL;
 
+	( (libbfio_internal_handle_t *) *destination_handle )->read_vector = internal_source_handle->read_vector;
+	( (libbfio_internal_handle_t *) *destination_handle )->read_buffer_at_offset = internal_source_handle->read_buffer_at_offset;
+
 	if( internal_source_handle->access_flags != 0 )
 	{
 		if( libbfio_handle_open(
@@ -1274,14 +1277,549 @@ ssize_t libbfio_handle_read_buffer(
 
 		return( -1 );
 	}
-#endif
+#endif
+	return( read_count );
+}
+
+/* Reads data at a specific offset into the buffer
+ * Returns the number of bytes read if successful, or -1 on error
+ */
+ssize_t libbfio_handle_read_buffer_at_offset(
+         libbfio_handle_t *handle,
+         uint8_t *buffer,
+         size_t size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	libbfio_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libbfio_handle_read_buffer_at_offset";
+	ssize_t read_count                         = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libbfio_internal_handle_t *) handle;
+
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFIO )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libbfio_internal_handle_seek_offset(
+	     internal_handle,
+	     offset,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset: %" PRIi64 " (0x%08" PRIx64 ") in handle.",
+		 function,
+		 offset,
+		 offset );
+
+		read_count = -1;
+	}
+	else
+	{
+		read_count = libbfio_internal_handle_read_buffer(
+		              internal_handle,
+		              buffer,
+		              size,
+		              error );
+
+		if( read_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read buffer.",
+			 function );
+
+			read_count = -1;
+		}
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFIO )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( read_count );
+}
+
+/* Reads data of multiple ranges into their buffers
+ * The ranges are read at their own offset and the current offset is not changed
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns the total number of bytes read if successful, or -1 on error
+ */
+ssize_t libbfio_internal_handle_read_vector(
+         libbfio_internal_handle_t *internal_handle,
+         libbfio_read_range_t *ranges,
+         int number_of_ranges,
+         libcerror_error_t **error )
+{
+	static char *function    = "libbfio_internal_handle_read_vector";
+	off64_t current_offset   = 0;
+	ssize_t read_count       = 0;
+	ssize_t total_read_count = 0;
+	int range_index          = 0;
+	int result               = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ranges == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid ranges.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_ranges <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of ranges value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	for( range_index = 0;
+	     range_index < number_of_ranges;
+	     range_index++ )
+	{
+		if( ( ranges[ range_index ].offset < 0 )
+		 || ( ranges[ range_index ].buffer == NULL )
+		 || ( ranges[ range_index ].size > (size_t) SSIZE_MAX ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid range: %d.",
+			 function,
+			 range_index );
+
+			return( -1 );
+		}
+		ranges[ range_index ].read_count = 0;
+	}
+	/* Handles that are opened on demand or that do not support
+	 * reading multiple ranges at once read the ranges one by one
+	 */
+	if( ( internal_handle->read_vector != NULL )
+	 && ( internal_handle->open_on_demand == 0 ) )
+	{
+		total_read_count = internal_handle->read_vector(
+		                    internal_handle->io_handle,
+		                    ranges,
+		                    number_of_ranges,
+		                    error );
+
+		if( total_read_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read ranges from handle.",
+			 function );
+
+			return( -1 );
+		}
+		if( internal_handle->track_offsets_read != 0 )
+		{
+			for( range_index = 0;
+			     range_index < number_of_ranges;
+			     range_index++ )
+			{
+				if( ranges[ range_index ].read_count <= 0 )
+				{
+					continue;
+				}
+				result = libcdata_range_list_insert_range(
+				          internal_handle->offsets_read,
+				          (uint64_t) ranges[ range_index ].offset,
+				          (uint64_t) ranges[ range_index ].read_count,
+				          NULL,
+				          NULL,
+				          NULL,
+				          error );
+
+				if( result == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+					 "%s: unable to insert offset range to offsets read table.",
+					 function );
+
+					return( -1 );
+				}
+			}
+		}
+		return( total_read_count );
+	}
+	current_offset = internal_handle->current_offset;
+
+	for( range_index = 0;
+	     range_index < number_of_ranges;
+	     range_index++ )
+	{
+		if( libbfio_internal_handle_seek_offset(
+		     internal_handle,
+		     ranges[ range_index ].offset,
+		     SEEK_SET,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_SEEK_FAILED,
+			 "%s: unable to seek offset: %" PRIi64 " (0x%08" PRIx64 ") in handle.",
+			 function,
+			 ranges[ range_index ].offset,
+			 ranges[ range_index ].offset );
+
+			return( -1 );
+		}
+		read_count = libbfio_internal_handle_read_buffer(
+		              internal_handle,
+		              ranges[ range_index ].buffer,
+		              ranges[ range_index ].size,
+		              error );
+
+		if( read_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read range: %d.",
+			 function,
+			 range_index );
+
+			return( -1 );
+		}
+		ranges[ range_index ].read_count = read_count;
+
+		total_read_count += read_count;
+	}
+	if( libbfio_internal_handle_seek_offset(
+	     internal_handle,
+	     current_offset,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset: %" PRIi64 " (0x%08" PRIx64 ") in handle.",
+		 function,
+		 current_offset,
+		 current_offset );
+
+		return( -1 );
+	}
+	return( total_read_count );
+}
+
+/* Reads data of multiple ranges into their buffers
+ * The ranges are read at their own offset and the current offset is not changed
+ * Returns the total number of bytes read if successful, or -1 on error
+ */
+ssize_t libbfio_handle_read_vector(
+         libbfio_handle_t *handle,
+         libbfio_read_range_t *ranges,
+         int number_of_ranges,
+         libcerror_error_t **error )
+{
+	libbfio_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libbfio_handle_read_vector";
+	ssize_t read_count                         = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libbfio_internal_handle_t *) handle;
+
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFIO )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	read_count = libbfio_internal_handle_read_vector(
+	              internal_handle,
+	              ranges,
+	              number_of_ranges,
+	              error );
+
+	if( read_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read vector.",
+		 function );
+
+		read_count = -1;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFIO )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( read_count );
+}
+
+/* Reads data at a specific offset into the buffer
+ * The current offset is not changed
+ * This function is not multi-thread safe acquire write lock before call
+ * unless the handle reads without a seek, see libbfio_handle_pread_buffer
+ * Returns the number of bytes read if successful, or -1 on error
+ */
+ssize_t libbfio_internal_handle_pread_buffer(
+         libbfio_internal_handle_t *internal_handle,
+         uint8_t *buffer,
+         size_t size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	libbfio_read_range_t range;
+
+	static char *function = "libbfio_internal_handle_pread_buffer";
+	ssize_t read_count    = 0;
+	int result            = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	/* Handles that are opened on demand or that do not support
+	 * reading at a specific offset fall back to a seek and read
+	 */
+	if( ( internal_handle->read_buffer_at_offset == NULL )
+	 || ( internal_handle->open_on_demand != 0 ) )
+	{
+		range.offset     = offset;
+		range.buffer     = buffer;
+		range.size       = size;
+		range.read_count = 0;
+
+		read_count = libbfio_internal_handle_read_vector(
+		              internal_handle,
+		              &range,
+		              1,
+		              error );
+
+		if( read_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read from handle at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 offset,
+			 offset );
+
+			return( -1 );
+		}
+		return( read_count );
+	}
+	read_count = internal_handle->read_buffer_at_offset(
+	              internal_handle->io_handle,
+	              buffer,
+	              size,
+	              offset,
+	              error );
+
+	if( read_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read from handle at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 offset,
+		 offset );
+
+		return( -1 );
+	}
+	if( ( internal_handle->track_offsets_read != 0 )
+	 && ( read_count > 0 ) )
+	{
+		result = libcdata_range_list_insert_range(
+		          internal_handle->offsets_read,
+		          (uint64_t) offset,
+		          (uint64_t) read_count,
+		          NULL,
+		          NULL,
+		          NULL,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to insert offset range to offsets read table.",
+			 function );
+
+			return( -1 );
+		}
+	}
 	return( read_count );
 }
 
 /* Reads data at a specific offset into the buffer
+ * The current offset is not changed
+ * If the handle can read at a specific offset and does not need to track
+ * the offsets read, only a read lock is held and multiple threads can read
+ * from the handle at the same time
  * Returns the number of bytes read if successful, or -1 on error
  */
-ssize_t libbfio_handle_read_buffer_at_offset(
+ssize_t libbfio_handle_pread_buffer(
          libbfio_handle_t *handle,
          uint8_t *buffer,
          size_t size,
@@ -1289,9 +1827,14 @@ ssize_t libbfio_handle_read_buffer_at_offset(
          libcerror_error_t **error )
 {
 	libbfio_internal_handle_t *internal_handle = NULL;
-	static char *function                      = "libbfio_handle_read_buffer_at_offset";
+	static char *function                      = "libbfio_handle_pread_buffer";
 	ssize_t read_count                         = 0;
 
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFIO )
+	uint8_t is_shared_read                     = 0;
+	int result                                 = 0;
+#endif
+
 	if( handle == NULL )
 	{
 		libcerror_error_set(
@@ -1317,67 +1860,74 @@ ssize_t libbfio_handle_read_buffer_at_offset(
 		return( -1 );
 	}
 #if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFIO )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
+	if( ( internal_handle->read_buffer_at_offset != NULL )
+	 && ( internal_handle->open_on_demand == 0 )
+	 && ( internal_handle->track_offsets_read == 0 ) )
+	{
+		is_shared_read = 1;
+	}
+	if( is_shared_read != 0 )
+	{
+		result = libcthreads_read_write_lock_grab_for_read(
+		          internal_handle->read_write_lock,
+		          error );
+	}
+	else
+	{
+		result = libcthreads_read_write_lock_grab_for_write(
+		          internal_handle->read_write_lock,
+		          error );
+	}
+	if( result != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 "%s: unable to grab read/write lock.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	if( libbfio_internal_handle_seek_offset(
-	     internal_handle,
-	     offset,
-	     SEEK_SET,
-	     error ) == -1 )
+	read_count = libbfio_internal_handle_pread_buffer(
+	              internal_handle,
+	              buffer,
+	              size,
+	              offset,
+	              error );
+
+	if( read_count < 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek offset: %" PRIi64 " (0x%08" PRIx64 ") in handle.",
-		 function,
-		 offset,
-		 offset );
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer at offset.",
+		 function );
 
 		read_count = -1;
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFIO )
+	if( is_shared_read != 0 )
+	{
+		result = libcthreads_read_write_lock_release_for_read(
+		          internal_handle->read_write_lock,
+		          error );
+	}
 	else
 	{
-		read_count = libbfio_internal_handle_read_buffer(
-		              internal_handle,
-		              buffer,
-		              size,
-		              error );
-
-		if( read_count < 0 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read buffer.",
-			 function );
-
-			read_count = -1;
-		}
+		result = libcthreads_read_write_lock_release_for_write(
+		          internal_handle->read_write_lock,
+		          error );
 	}
-#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFIO )
-	if( libcthreads_read_write_lock_release_for_write(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
+	if( result != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 "%s: unable to release read/write lock.",
 		 function );
 
 		return( -1 );
@@ -2023,6 +2573,71 @@ on_error:
 	return( -1 );
 }
 
+/* Determines if the handle supports shared reads
+ * A shared read is a read at a specific offset that does not change the state of the handle,
+ * hence multiple threads can read from the handle at the same time
+ * Returns 1 if the handle supports shared reads, 0 if not or -1 on error
+ */
+int libbfio_handle_supports_shared_read(
+     libbfio_handle_t *handle,
+     libcerror_error_t **error )
+{
+	libbfio_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libbfio_handle_supports_shared_read";
+	int result                                 = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libbfio_internal_handle_t *) handle;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFIO )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( ( internal_handle->read_buffer_at_offset != NULL )
+	 && ( internal_handle->open_on_demand == 0 )
+	 && ( internal_handle->track_offsets_read == 0 ) )
+	{
+		result = 1;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFIO )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
 /* Retrieves the IO handle
  * Returns 1 if successful or -1 on error
  */
@@ -2495,6 +3110,136 @@ int libbfio_handle_set_open_on_demand(
 	return( 1 );
 }
 
+/* Sets the read vector function
+ * The function is optional and used to read multiple ranges at once
+ * Returns 1 if successful or -1 on error
+ */
+int libbfio_handle_set_read_vector_function(
+     libbfio_handle_t *handle,
+     ssize_t (*read_vector)(
+                intptr_t *io_handle,
+                libbfio_read_range_t *ranges,
+                int number_of_ranges,
+                libcerror_error_t **error ),
+     libcerror_error_t **error )
+{
+	libbfio_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libbfio_handle_set_read_vector_function";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libbfio_internal_handle_t *) handle;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFIO )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	internal_handle->read_vector = read_vector;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFIO )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Sets the read buffer at offset function
+ * The function is optional and used to read at a specific offset
+ * without changing the current offset
+ * Returns 1 if successful or -1 on error
+ */
+int libbfio_handle_set_read_buffer_at_offset_function(
+     libbfio_handle_t *handle,
+     ssize_t (*read_buffer_at_offset)(
+                intptr_t *io_handle,
+                uint8_t *buffer,
+                size_t size,
+                off64_t offset,
+                libcerror_error_t **error ),
+     libcerror_error_t **error )
+{
+	libbfio_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libbfio_handle_set_read_buffer_at_offset_function";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libbfio_internal_handle_t *) handle;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFIO )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	internal_handle->read_buffer_at_offset = read_buffer_at_offset;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFIO )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
 /* Sets the value to have the library track the offsets read
  * 0 disables tracking any other value enables it
  * Returns 1 if successful or -1 on error
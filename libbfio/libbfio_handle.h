@@ -35,6 +35,27 @@
 extern "C" {
 #endif
 
+typedef struct libbfio_read_range libbfio_read_range_t;
+
+struct libbfio_read_range
+{
+	/* The offset
+	 */
+	off64_t offset;
+
+	/* The buffer
+	 */
+	uint8_t *buffer;
+
+	/* The size
+	 */
+	size_t size;
+
+	/* The number of bytes read
+	 */
+	ssize_t read_count;
+};
+
 typedef struct libbfio_internal_handle libbfio_internal_handle_t;
 
 struct libbfio_internal_handle
@@ -153,6 +174,23 @@ struct libbfio_internal_handle
 	       size64_t *size,
 	       libcerror_error_t **error );
 
+	/* The (optional) read vector function
+	 */
+	ssize_t (*read_vector)(
+	           intptr_t *io_handle,
+	           libbfio_read_range_t *ranges,
+	           int number_of_ranges,
+	           libcerror_error_t **error );
+
+	/* The (optional) read buffer at offset function
+	 */
+	ssize_t (*read_buffer_at_offset)(
+	           intptr_t *io_handle,
+	           uint8_t *buffer,
+	           size_t size,
+	           off64_t offset,
+	           libcerror_error_t **error );
+
 #if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFIO )
 	/* The read/write lock
 	 */
@@ -255,6 +293,34 @@ ssize_t libbfio_handle_read_buffer_at_offset(
          off64_t offset,
          libcerror_error_t **error );
 
+ssize_t libbfio_internal_handle_read_vector(
+         libbfio_internal_handle_t *internal_handle,
+         libbfio_read_range_t *ranges,
+         int number_of_ranges,
+         libcerror_error_t **error );
+
+LIBBFIO_EXTERN \
+ssize_t libbfio_handle_read_vector(
+         libbfio_handle_t *handle,
+         libbfio_read_range_t *ranges,
+         int number_of_ranges,
+         libcerror_error_t **error );
+
+ssize_t libbfio_internal_handle_pread_buffer(
+         libbfio_internal_handle_t *internal_handle,
+         uint8_t *buffer,
+         size_t size,
+         off64_t offset,
+         libcerror_error_t **error );
+
+LIBBFIO_EXTERN \
+ssize_t libbfio_handle_pread_buffer(
+         libbfio_handle_t *handle,
+         uint8_t *buffer,
+         size_t size,
+         off64_t offset,
+         libcerror_error_t **error );
+
 ssize_t libbfio_internal_handle_write_buffer(
          libbfio_internal_handle_t *internal_handle,
          const uint8_t *buffer,
@@ -299,6 +365,11 @@ int libbfio_handle_is_open(
      libbfio_handle_t *handle,
      libcerror_error_t **error );
 
+LIBBFIO_EXTERN \
+int libbfio_handle_supports_shared_read(
+     libbfio_handle_t *handle,
+     libcerror_error_t **error );
+
 LIBBFIO_EXTERN \
 int libbfio_handle_get_io_handle(
      libbfio_handle_t *handle,
@@ -335,6 +406,27 @@ int libbfio_handle_set_open_on_demand(
      uint8_t open_on_demand,
      libcerror_error_t **error );
 
+LIBBFIO_EXTERN \
+int libbfio_handle_set_read_vector_function(
+     libbfio_handle_t *handle,
+     ssize_t (*read_vector)(
+                intptr_t *io_handle,
+                libbfio_read_range_t *ranges,
+                int number_of_ranges,
+                libcerror_error_t **error ),
+     libcerror_error_t **error );
+
+LIBBFIO_EXTERN \
+int libbfio_handle_set_read_buffer_at_offset_function(
+     libbfio_handle_t *handle,
+     ssize_t (*read_buffer_at_offset)(
+                intptr_t *io_handle,
+                uint8_t *buffer,
+                size_t size,
+                off64_t offset,
+                libcerror_error_t **error ),
+     libcerror_error_t **error );
+
 LIBBFIO_EXTERN \
 int libbfio_handle_set_track_offsets_read(
      libbfio_handle_t *handle,
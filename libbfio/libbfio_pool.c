@@ -3006,6 +3006,430 @@ ssize_t libbfio_pool_read_buffer_at_offset(
 	return( read_count );
 }
 
+/* Reads data at a specific offset into the buffer
+ * The current offset of the handle and the current entry of the pool are not changed
+ * if the handle is open and the number of open handles is unlimited, in which case
+ * only a read lock is held and multiple threads can read from the pool at the same time
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libbfio_pool_pread_buffer(
+         libbfio_pool_t *pool,
+         int entry,
+         uint8_t *buffer,
+         size_t size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	libbfio_handle_t *handle               = NULL;
+	libbfio_internal_pool_t *internal_pool = NULL;
+	static char *function                  = "libbfio_pool_pread_buffer";
+	ssize_t read_count                     = 0;
+	int is_open                            = 0;
+
+	if( pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid pool.",
+		 function );
+
+		return( -1 );
+	}
+	internal_pool = (libbfio_internal_pool_t *) pool;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFIO )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_pool->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	/* The last used list is only maintained if the number of open handles is limited
+	 */
+	if( internal_pool->maximum_number_of_open_handles == LIBBFIO_POOL_UNLIMITED_NUMBER_OF_OPEN_HANDLES )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     internal_pool->handles_array,
+		     entry,
+		     (intptr_t **) &handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve handle: %d.",
+			 function,
+			 entry );
+
+			is_open = -1;
+		}
+		else
+		{
+			is_open = libbfio_handle_is_open(
+			           handle,
+			           error );
+
+			if( is_open == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to determine if entry: %d is open.",
+				 function,
+				 entry );
+			}
+		}
+		if( is_open == 1 )
+		{
+			read_count = libbfio_handle_pread_buffer(
+			              handle,
+			              buffer,
+			              size,
+			              offset,
+			              error );
+
+			if( read_count < 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read from entry: %d at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+				 function,
+				 entry,
+				 offset,
+				 offset );
+
+				read_count = -1;
+			}
+		}
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFIO )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_pool->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( is_open == -1 )
+	{
+		return( -1 );
+	}
+	else if( is_open == 1 )
+	{
+		return( read_count );
+	}
+	/* The handle needs to be opened or the last used list needs to be updated
+	 */
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFIO )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_pool->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libbfio_internal_pool_get_open_handle(
+	     internal_pool,
+	     entry,
+	     &handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve handle: %d.",
+		 function,
+		 entry );
+
+		read_count = -1;
+	}
+	else
+	{
+		read_count = libbfio_handle_pread_buffer(
+		              handle,
+		              buffer,
+		              size,
+		              offset,
+		              error );
+
+		if( read_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read from entry: %d at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 entry,
+			 offset,
+			 offset );
+
+			read_count = -1;
+		}
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFIO )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_pool->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( read_count );
+}
+
+/* Determines if the pool supports shared reads of a specific entry
+ * A shared read is a read at a specific offset that does not change the state of
+ * the pool or the handle, which requires that the number of open handles is unlimited
+ * and that the handle is open and supports shared reads
+ * Returns 1 if the entry supports shared reads, 0 if not or -1 on error
+ */
+int libbfio_pool_supports_shared_read(
+     libbfio_pool_t *pool,
+     int entry,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *handle               = NULL;
+	libbfio_internal_pool_t *internal_pool = NULL;
+	static char *function                  = "libbfio_pool_supports_shared_read";
+	int result                             = 0;
+
+	if( pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid pool.",
+		 function );
+
+		return( -1 );
+	}
+	internal_pool = (libbfio_internal_pool_t *) pool;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFIO )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_pool->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	/* The last used list is only maintained if the number of open handles is limited
+	 */
+	if( internal_pool->maximum_number_of_open_handles == LIBBFIO_POOL_UNLIMITED_NUMBER_OF_OPEN_HANDLES )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     internal_pool->handles_array,
+		     entry,
+		     (intptr_t **) &handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve handle: %d.",
+			 function,
+			 entry );
+
+			result = -1;
+		}
+		else if( handle != NULL )
+		{
+			result = libbfio_handle_is_open(
+			          handle,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to determine if entry: %d is open.",
+				 function,
+				 entry );
+			}
+			else if( result == 1 )
+			{
+				result = libbfio_handle_supports_shared_read(
+				          handle,
+				          error );
+
+				if( result == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to determine if entry: %d supports shared reads.",
+					 function,
+					 entry );
+				}
+			}
+		}
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFIO )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_pool->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Reads data of multiple ranges into their buffers
+ * The ranges are read at their own offset and the current offset is not changed
+ * Returns the total number of bytes read or -1 on error
+ */
+ssize_t libbfio_pool_read_vector(
+         libbfio_pool_t *pool,
+         int entry,
+         libbfio_read_range_t *ranges,
+         int number_of_ranges,
+         libcerror_error_t **error )
+{
+	libbfio_handle_t *handle               = NULL;
+	libbfio_internal_pool_t *internal_pool = NULL;
+	static char *function                  = "libbfio_pool_read_vector";
+	ssize_t read_count                     = 0;
+
+	if( pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid pool.",
+		 function );
+
+		return( -1 );
+	}
+	internal_pool = (libbfio_internal_pool_t *) pool;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFIO )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_pool->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libbfio_internal_pool_get_open_handle(
+	     internal_pool,
+	     entry,
+	     &handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve handle: %d.",
+		 function,
+		 entry );
+
+		read_count = -1;
+	}
+	else
+	{
+		read_count = libbfio_handle_read_vector(
+		              handle,
+		              ranges,
+		              number_of_ranges,
+		              error );
+
+		if( read_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read ranges from entry: %d.",
+			 function,
+			 entry );
+
+			read_count = -1;
+		}
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFIO )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_pool->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( read_count );
+}
+
 /* Writes data at the current offset from the buffer
  * Returns the number of bytes written or -1 on error
  */
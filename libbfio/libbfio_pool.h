@@ -26,6 +26,7 @@
 #include <types.h>
 
 #include "libbfio_extern.h"
+#include "libbfio_handle.h"
 #include "libbfio_libcdata.h"
 #include "libbfio_libcerror.h"
 #include "libbfio_libcthreads.h"
@@ -228,6 +229,29 @@ ssize_t libbfio_pool_read_buffer_at_offset(
          off64_t offset,
          libcerror_error_t **error );
 
+LIBBFIO_EXTERN \
+ssize_t libbfio_pool_pread_buffer(
+         libbfio_pool_t *pool,
+         int entry,
+         uint8_t *buffer,
+         size_t size,
+         off64_t offset,
+         libcerror_error_t **error );
+
+LIBBFIO_EXTERN \
+int libbfio_pool_supports_shared_read(
+     libbfio_pool_t *pool,
+     int entry,
+     libcerror_error_t **error );
+
+LIBBFIO_EXTERN \
+ssize_t libbfio_pool_read_vector(
+         libbfio_pool_t *pool,
+         int entry,
+         libbfio_read_range_t *ranges,
+         int number_of_ranges,
+         libcerror_error_t **error );
+
 LIBBFIO_EXTERN \
 ssize_t libbfio_pool_write_buffer(
          libbfio_pool_t *pool,
@@ -102,6 +102,8 @@ int libcfile_file_initialize(
   }
 
   internal_file->custom_handle = NULL;
+  internal_file->io_backend = &libcfile_global_io_backend;
+
   *file = (libcfile_file_t*)internal_file;
 
   return (1);
@@ -239,7 +241,7 @@ int libcfile_file_open_with_error_code(
     return (-1);
   }
 
-  if (custom_io_file_create_handle_ptr == NULL)
+  if (internal_file->io_backend->file_create_handle == NULL)
   {
     return -1;
   }
@@ -297,7 +299,8 @@ int libcfile_file_open_with_error_code(
   }
 
   *error_code = 0;
-  if (custom_io_file_create_handle_ptr(filename, file_io_access_flags, file_io_shared_flags, file_io_creation_flags,
+  if (internal_file->io_backend->file_create_handle(internal_file->io_backend->user_data, filename,
+                                                   file_io_access_flags, file_io_shared_flags, file_io_creation_flags,
                                        &(internal_file->custom_handle)) != 1)
   {
     return -1;
@@ -399,7 +402,7 @@ int libcfile_file_open_wide_with_error_code(
     return (-1);
   }
 
-  if (custom_io_file_create_handle_wide_ptr == NULL)
+  if (internal_file->io_backend->file_create_handle_wide == NULL)
   {
     return -1;
   }
@@ -457,7 +460,8 @@ int libcfile_file_open_wide_with_error_code(
   }
 
   *error_code = 0;
-  if (custom_io_file_create_handle_wide_ptr(filename, file_io_access_flags, file_io_shared_flags,
+  if (internal_file->io_backend->file_create_handle_wide(internal_file->io_backend->user_data, filename,
+                                                        file_io_access_flags, file_io_shared_flags,
                                             file_io_creation_flags, &internal_file->custom_handle) != 1)
   {
     return -1;
@@ -511,16 +515,16 @@ int libcfile_file_close(
     return (-1);
   }
 
-  if (custom_io_file_close_handle_ptr == NULL)
+  internal_file = (libcfile_internal_file_t*)file;
+
+  if (internal_file->io_backend->file_close_handle == NULL)
   {
     return -1;
   }
 
-  internal_file = (libcfile_internal_file_t*)file;
-
   if (internal_file->custom_handle != NULL)
   {
-    result = custom_io_file_close_handle_ptr(internal_file->custom_handle);
+    result = internal_file->io_backend->file_close_handle(internal_file->io_backend->user_data, internal_file->custom_handle);
     if (result == 0)
     {
       return (-1);
@@ -582,7 +586,10 @@ ssize_t libcfile_internal_file_read_buffer_at_offset_with_error_code(
   libcerror_error_t** error)
 {
   static char* function = "libcfile_internal_file_read_buffer_at_offset_with_error_code";
-  int read_count = 0;
+  size_t buffer_offset = 0;
+  int64_t read_count = 0;
+  int64_t read_size = 0;
+  int32_t read_count32 = 0;
 
   if (internal_file == NULL)
   {
@@ -617,11 +624,7 @@ ssize_t libcfile_internal_file_read_buffer_at_offset_with_error_code(
 
     return (-1);
   }
-#if ( UINT32_MAX < SSIZE_MAX )
-  if (size > (size_t)UINT32_MAX)
-#else
-	if( size > (size_t) SSIZE_MAX )
-#endif
+  if (size > (size_t)SSIZE_MAX)
   {
     libcerror_error_set(
       error,
@@ -644,18 +647,70 @@ ssize_t libcfile_internal_file_read_buffer_at_offset_with_error_code(
     return (-1);
   }
 
-  if (custom_io_file_read_ptr == NULL)
+  if ((internal_file->io_backend->file_read == NULL)
+   && (internal_file->io_backend->file_read64 == NULL))
   {
     return -1;
   }
 
   *error_code = 0;
-  if (custom_io_file_read_ptr(internal_file->custom_handle, current_offset, buffer, size, &read_count) != 1)
+
+  /* Reads larger than the maximum read size of the backend are split,
+   * as are reads of more than 2 GiB when the backend has no 64-bit read callback
+   */
+  while (buffer_offset < size)
   {
-    return -1;
-  }
+    read_size = (int64_t)(size - buffer_offset);
+
+    if ((internal_file->io_backend->maximum_read_size > 0)
+     && (read_size > internal_file->io_backend->maximum_read_size))
+    {
+      read_size = internal_file->io_backend->maximum_read_size;
+    }
+    if (internal_file->io_backend->file_read64 != NULL)
+    {
+      if (internal_file->io_backend->file_read64(internal_file->io_backend->user_data, internal_file->custom_handle,
+                                                 current_offset + (off64_t)buffer_offset, &(buffer[buffer_offset]),
+                                                 read_size, &read_count) != 1)
+      {
+        return -1;
+      }
+    }
+    else
+    {
+      if (read_size > (int64_t)INT32_MAX)
+      {
+        read_size = INT32_MAX;
+      }
+      if (internal_file->io_backend->file_read(internal_file->io_backend->user_data, internal_file->custom_handle,
+                                               current_offset + (off64_t)buffer_offset, &(buffer[buffer_offset]),
+                                               (int32_t)read_size, &read_count32) != 1)
+      {
+        return -1;
+      }
+      read_count = read_count32;
+    }
+    if ((read_count < 0)
+     || (read_count > read_size))
+    {
+      libcerror_error_set(
+        error,
+        LIBCERROR_ERROR_DOMAIN_IO,
+        LIBCERROR_IO_ERROR_READ_FAILED,
+        "%s: invalid read count: %" PRIi64 " returned.",
+        function,
+        read_count);
+
+      return (-1);
+    }
+    buffer_offset += (size_t)read_count;
 
-  return ((ssize_t)read_count);
+    if (read_count < read_size)
+    {
+      break;
+    }
+  }
+  return ((ssize_t)buffer_offset);
 }
 
 /* Reads a buffer from the file
@@ -712,11 +767,7 @@ ssize_t libcfile_file_read_buffer_with_error_code(
 
     return (-1);
   }
-#if ( UINT32_MAX < SSIZE_MAX )
-  if (size > (size_t)UINT32_MAX)
-#else
-	if( size > (size_t) SSIZE_MAX )
-#endif
+  if (size > (size_t)SSIZE_MAX)
   {
     libcerror_error_set(
       error,
@@ -799,6 +850,515 @@ ssize_t libcfile_file_read_buffer_with_error_code(
   return ((ssize_t)buffer_offset);
 }
 
+/* Reads a buffer from the file at a specific offset
+ * The current offset is not changed, hence the file can be read from multiple threads
+ * Returns the number of bytes read if successful, or -1 on error
+ */
+ssize_t libcfile_file_read_buffer_at_offset_with_error_code(
+  libcfile_file_t* file,
+  uint8_t* buffer,
+  size_t size,
+  off64_t offset,
+  uint32_t* error_code,
+  libcerror_error_t** error)
+{
+  libcfile_internal_file_t* internal_file = NULL;
+  static char* function = "libcfile_file_read_buffer_at_offset_with_error_code";
+  ssize_t read_count = 0;
+
+  if (file == NULL)
+  {
+    libcerror_error_set(
+      error,
+      LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+      LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+      "%s: invalid file.",
+      function);
+
+    return (-1);
+  }
+  internal_file = (libcfile_internal_file_t*)file;
+
+  if (internal_file->custom_handle == NULL)
+  {
+    libcerror_error_set(
+      error,
+      LIBCERROR_ERROR_DOMAIN_RUNTIME,
+      LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+      "%s: invalid file - missing handle.",
+      function);
+
+    return (-1);
+  }
+  if (buffer == NULL)
+  {
+    libcerror_error_set(
+      error,
+      LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+      LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+      "%s: invalid buffer.",
+      function);
+
+    return (-1);
+  }
+  if (size > (size_t)SSIZE_MAX)
+  {
+    libcerror_error_set(
+      error,
+      LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+      LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+      "%s: invalid size value exceeds maximum.",
+      function);
+
+    return (-1);
+  }
+  if (offset < 0)
+  {
+    libcerror_error_set(
+      error,
+      LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+      LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+      "%s: invalid offset value out of bounds.",
+      function);
+
+    return (-1);
+  }
+  if (error_code == NULL)
+  {
+    libcerror_error_set(
+      error,
+      LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+      LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+      "%s: invalid error code.",
+      function);
+
+    return (-1);
+  }
+  if ((size == 0)
+   || ((size64_t)offset >= internal_file->size))
+  {
+    return (0);
+  }
+  if (((size64_t)offset + size) > internal_file->size)
+  {
+    size = (size_t)(internal_file->size - offset);
+  }
+  read_count = libcfile_internal_file_read_buffer_at_offset_with_error_code(
+    internal_file,
+    offset,
+    buffer,
+    size,
+    error_code,
+    error);
+
+  if (read_count < 0)
+  {
+    libcerror_system_set_error(
+      error,
+      LIBCERROR_ERROR_DOMAIN_IO,
+      LIBCERROR_IO_ERROR_READ_FAILED,
+      *error_code,
+      "%s: unable to read from file at offset: %" PRIi64 ".",
+      function,
+      offset);
+
+    return (-1);
+  }
+  return (read_count);
+}
+
+/* Reads a buffer from the file at a specific offset
+ * The current offset is not changed
+ * Returns the number of bytes read if successful, or -1 on error
+ */
+ssize_t libcfile_file_read_buffer_at_offset(
+  libcfile_file_t* file,
+  uint8_t* buffer,
+  size_t size,
+  off64_t offset,
+  libcerror_error_t** error)
+{
+  static char* function = "libcfile_file_read_buffer_at_offset";
+  ssize_t read_count = 0;
+  uint32_t error_code = 0;
+
+  read_count = libcfile_file_read_buffer_at_offset_with_error_code(
+    file,
+    buffer,
+    size,
+    offset,
+    &error_code,
+    error);
+
+  if (read_count == -1)
+  {
+    libcerror_error_set(
+      error,
+      LIBCERROR_ERROR_DOMAIN_IO,
+      LIBCERROR_IO_ERROR_READ_FAILED,
+      "%s: unable to read from file.",
+      function);
+
+    return (-1);
+  }
+  return (read_count);
+}
+
+/* Submits a read of multiple ranges from the file
+ * The asynchronous read callbacks are preferred over the vectored read callback if asynchronous is set
+ * If neither is set the ranges are read one by one
+ * If the ranges are read before returning request is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libcfile_internal_file_read_vector_submit(
+  libcfile_internal_file_t* internal_file,
+  file_read_range_t* ranges,
+  int number_of_ranges,
+  uint8_t asynchronous,
+  void** request,
+  libcerror_error_t** error)
+{
+  static char* function = "libcfile_internal_file_read_vector_submit";
+  ssize_t read_count = 0;
+  uint32_t error_code = 0;
+  int range_index = 0;
+
+  if (internal_file == NULL)
+  {
+    libcerror_error_set(
+      error,
+      LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+      LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+      "%s: invalid file.",
+      function);
+
+    return (-1);
+  }
+  if (internal_file->custom_handle == NULL)
+  {
+    libcerror_error_set(
+      error,
+      LIBCERROR_ERROR_DOMAIN_RUNTIME,
+      LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+      "%s: invalid file - missing handle.",
+      function);
+
+    return (-1);
+  }
+  if (ranges == NULL)
+  {
+    libcerror_error_set(
+      error,
+      LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+      LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+      "%s: invalid ranges.",
+      function);
+
+    return (-1);
+  }
+  if (number_of_ranges <= 0)
+  {
+    libcerror_error_set(
+      error,
+      LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+      LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+      "%s: invalid number of ranges value out of bounds.",
+      function);
+
+    return (-1);
+  }
+  if (request == NULL)
+  {
+    libcerror_error_set(
+      error,
+      LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+      LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+      "%s: invalid request.",
+      function);
+
+    return (-1);
+  }
+  for (range_index = 0; range_index < number_of_ranges; range_index++)
+  {
+    if ((ranges[range_index].offset < 0)
+     || (ranges[range_index].buffer == NULL)
+     || (ranges[range_index].size < 0))
+    {
+      libcerror_error_set(
+        error,
+        LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+        LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+        "%s: invalid range: %d.",
+        function,
+        range_index);
+
+      return (-1);
+    }
+    ranges[range_index].read_count = 0;
+  }
+  *request = NULL;
+
+  if ((internal_file->io_backend->file_read_submit != NULL)
+   && ((asynchronous != 0)
+    || (internal_file->io_backend->file_read_vector == NULL)))
+  {
+    if (internal_file->io_backend->file_read_submit(internal_file->io_backend->user_data, internal_file->custom_handle,
+                                                    ranges, (int32_t)number_of_ranges, request) != 1)
+    {
+      libcerror_error_set(
+        error,
+        LIBCERROR_ERROR_DOMAIN_IO,
+        LIBCERROR_IO_ERROR_READ_FAILED,
+        "%s: unable to submit read to file.",
+        function);
+
+      return (-1);
+    }
+  }
+  else if (internal_file->io_backend->file_read_vector != NULL)
+  {
+    if (internal_file->io_backend->file_read_vector(internal_file->io_backend->user_data, internal_file->custom_handle,
+                                                    ranges, (int32_t)number_of_ranges) != 1)
+    {
+      libcerror_error_set(
+        error,
+        LIBCERROR_ERROR_DOMAIN_IO,
+        LIBCERROR_IO_ERROR_READ_FAILED,
+        "%s: unable to read vector from file.",
+        function);
+
+      return (-1);
+    }
+  }
+  else
+  {
+    /* The ranges are read one by one using the same read path as a positional read,
+     * so the 64-bit read callback and the maximum read size of the backend are honoured
+     */
+    for (range_index = 0; range_index < number_of_ranges; range_index++)
+    {
+      read_count = libcfile_internal_file_read_buffer_at_offset_with_error_code(
+                    internal_file,
+                    (off64_t) ranges[range_index].offset,
+                    ranges[range_index].buffer,
+                    (size_t) ranges[range_index].size,
+                    &error_code,
+                    error);
+
+      if (read_count == -1)
+      {
+        libcerror_error_set(
+          error,
+          LIBCERROR_ERROR_DOMAIN_IO,
+          LIBCERROR_IO_ERROR_READ_FAILED,
+          "%s: unable to read range: %d from file.",
+          function,
+          range_index);
+
+        return (-1);
+      }
+      ranges[range_index].read_count = (int32_t) read_count;
+    }
+  }
+  return (1);
+}
+
+/* Submits a read of multiple ranges from the file
+ * The ranges are read at their own offset and the current offset is not changed
+ * If no asynchronous read callbacks are set the ranges are read before returning
+ * and request is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libcfile_file_read_vector_submit(
+  libcfile_file_t* file,
+  file_read_range_t* ranges,
+  int number_of_ranges,
+  void** request,
+  libcerror_error_t** error)
+{
+  static char* function = "libcfile_file_read_vector_submit";
+
+  if (file == NULL)
+  {
+    libcerror_error_set(
+      error,
+      LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+      LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+      "%s: invalid file.",
+      function);
+
+    return (-1);
+  }
+  if (libcfile_internal_file_read_vector_submit(
+        (libcfile_internal_file_t*)file,
+        ranges,
+        number_of_ranges,
+        1,
+        request,
+        error) != 1)
+  {
+    libcerror_error_set(
+      error,
+      LIBCERROR_ERROR_DOMAIN_IO,
+      LIBCERROR_IO_ERROR_READ_FAILED,
+      "%s: unable to submit read of ranges.",
+      function);
+
+    return (-1);
+  }
+  return (1);
+}
+
+/* Waits for a read of multiple ranges submitted by libcfile_file_read_vector_submit to complete
+ * Returns the total number of bytes read if successful, or -1 on error
+ */
+ssize_t libcfile_file_read_vector_complete(
+  libcfile_file_t* file,
+  file_read_range_t* ranges,
+  int number_of_ranges,
+  void* request,
+  libcerror_error_t** error)
+{
+  libcfile_internal_file_t* internal_file = NULL;
+  static char* function = "libcfile_file_read_vector_complete";
+  ssize_t read_count = 0;
+  int range_index = 0;
+
+  if (file == NULL)
+  {
+    libcerror_error_set(
+      error,
+      LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+      LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+      "%s: invalid file.",
+      function);
+
+    return (-1);
+  }
+  internal_file = (libcfile_internal_file_t*)file;
+
+  if (ranges == NULL)
+  {
+    libcerror_error_set(
+      error,
+      LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+      LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+      "%s: invalid ranges.",
+      function);
+
+    return (-1);
+  }
+  if (request != NULL)
+  {
+    if (internal_file->io_backend->file_read_complete == NULL)
+    {
+      libcerror_error_set(
+        error,
+        LIBCERROR_ERROR_DOMAIN_RUNTIME,
+        LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+        "%s: file read complete callback is not set.",
+        function);
+
+      return (-1);
+    }
+    if (internal_file->io_backend->file_read_complete(internal_file->io_backend->user_data, internal_file->custom_handle,
+                                                      request) != 1)
+    {
+      libcerror_error_set(
+        error,
+        LIBCERROR_ERROR_DOMAIN_IO,
+        LIBCERROR_IO_ERROR_READ_FAILED,
+        "%s: unable to complete read from file.",
+        function);
+
+      return (-1);
+    }
+  }
+  for (range_index = 0; range_index < number_of_ranges; range_index++)
+  {
+    if ((ranges[range_index].read_count < 0)
+     || (ranges[range_index].read_count > ranges[range_index].size))
+    {
+      libcerror_error_set(
+        error,
+        LIBCERROR_ERROR_DOMAIN_IO,
+        LIBCERROR_IO_ERROR_READ_FAILED,
+        "%s: invalid range: %d read count value out of bounds.",
+        function,
+        range_index);
+
+      return (-1);
+    }
+    read_count += (ssize_t)ranges[range_index].read_count;
+  }
+  return (read_count);
+}
+
+/* Reads multiple ranges from the file
+ * The ranges are read at their own offset and the current offset is not changed
+ * The vectored read callback is used if set, otherwise the asynchronous read callbacks
+ * and otherwise the ranges are read one by one
+ * Returns the total number of bytes read if successful, or -1 on error
+ */
+ssize_t libcfile_file_read_vector(
+  libcfile_file_t* file,
+  file_read_range_t* ranges,
+  int number_of_ranges,
+  libcerror_error_t** error)
+{
+  static char* function = "libcfile_file_read_vector";
+  void* request = NULL;
+  ssize_t read_count = 0;
+
+  if (file == NULL)
+  {
+    libcerror_error_set(
+      error,
+      LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+      LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+      "%s: invalid file.",
+      function);
+
+    return (-1);
+  }
+  if (libcfile_internal_file_read_vector_submit(
+        (libcfile_internal_file_t*)file,
+        ranges,
+        number_of_ranges,
+        0,
+        &request,
+        error) != 1)
+  {
+    libcerror_error_set(
+      error,
+      LIBCERROR_ERROR_DOMAIN_IO,
+      LIBCERROR_IO_ERROR_READ_FAILED,
+      "%s: unable to submit read of ranges.",
+      function);
+
+    return (-1);
+  }
+  read_count = libcfile_file_read_vector_complete(
+                 file,
+                 ranges,
+                 number_of_ranges,
+                 request,
+                 error);
+
+  if (read_count < 0)
+  {
+    libcerror_error_set(
+      error,
+      LIBCERROR_ERROR_DOMAIN_IO,
+      LIBCERROR_IO_ERROR_READ_FAILED,
+      "%s: unable to complete read of ranges.",
+      function);
+
+    return (-1);
+  }
+  return (read_count);
+}
+
 /* Writes a buffer to the file
  * Returns the number of bytes written if successful, or -1 on error
  */
@@ -847,7 +1407,10 @@ ssize_t libcfile_file_write_buffer_with_error_code(
 {
   libcfile_internal_file_t* internal_file = NULL;
   static char* function = "libcfile_file_write_buffer_with_error_code";
-  int32_t write_count = 0;
+  size_t buffer_offset = 0;
+  int64_t write_count = 0;
+  int64_t write_size = 0;
+  int32_t write_count32 = 0;
 
   if (file == NULL)
   {
@@ -884,11 +1447,7 @@ ssize_t libcfile_file_write_buffer_with_error_code(
 
     return (-1);
   }
-#if ( UINT32_MAX < SSIZE_MAX )
-  if (size > (size_t)UINT32_MAX)
-#else
-	if( size > (size_t) SSIZE_MAX )
-#endif
+  if (size > (size_t)SSIZE_MAX)
   {
     libcerror_error_set(
       error,
@@ -910,32 +1469,64 @@ ssize_t libcfile_file_write_buffer_with_error_code(
 
     return (-1);
   }
-  if (custom_io_file_write_ptr == NULL)
+  if ((internal_file->io_backend->file_write == NULL)
+   && (internal_file->io_backend->file_write64 == NULL))
   {
     return -1;
   }
   
   *error_code = 0;
-  if (custom_io_file_write_ptr(internal_file->custom_handle, buffer, size, &write_count) != 1)
-  {
-    return -1;
-  }
-  
-  if (write_count < 0)
+
+  /* Writes of more than 2 GiB are split when the backend has no 64-bit write callback
+   */
+  while (buffer_offset < size)
   {
-    libcerror_error_set(
-      error,
-      LIBCERROR_ERROR_DOMAIN_IO,
-      LIBCERROR_IO_ERROR_WRITE_FAILED,
-      "%s: invalid write count: %" PRIzd " returned.",
-      function,
-      write_count);
+    write_size = (int64_t)(size - buffer_offset);
 
-    return (-1);
+    if (internal_file->io_backend->file_write64 != NULL)
+    {
+      if (internal_file->io_backend->file_write64(internal_file->io_backend->user_data, internal_file->custom_handle,
+                                                  &(buffer[buffer_offset]), write_size, &write_count) != 1)
+      {
+        return -1;
+      }
+    }
+    else
+    {
+      if (write_size > (int64_t)INT32_MAX)
+      {
+        write_size = INT32_MAX;
+      }
+      if (internal_file->io_backend->file_write(internal_file->io_backend->user_data, internal_file->custom_handle,
+                                                &(buffer[buffer_offset]), (int32_t)write_size, &write_count32) != 1)
+      {
+        return -1;
+      }
+      write_count = write_count32;
+    }
+    if ((write_count < 0)
+     || (write_count > write_size))
+    {
+      libcerror_error_set(
+        error,
+        LIBCERROR_ERROR_DOMAIN_IO,
+        LIBCERROR_IO_ERROR_WRITE_FAILED,
+        "%s: invalid write count: %" PRIi64 " returned.",
+        function,
+        write_count);
+
+      return (-1);
+    }
+    buffer_offset += (size_t)write_count;
+
+    if (write_count < write_size)
+    {
+      break;
+    }
   }
-  internal_file->current_offset += write_count;
+  internal_file->current_offset += (off64_t)buffer_offset;
 
-  return (write_count);
+  return ((ssize_t)buffer_offset);
 }
 
 /* Seeks a certain offset within the file
@@ -976,7 +1567,7 @@ off64_t libcfile_file_seek_offset(
 
     return (-1);
   }
-  if (custom_io_file_seek_ptr == NULL)
+  if (internal_file->io_backend->file_seek == NULL)
   {
     return -1;
   }
@@ -1015,7 +1606,7 @@ off64_t libcfile_file_seek_offset(
     offset += internal_file->size;
   }
     
-  if (custom_io_file_seek_ptr(internal_file->custom_handle, offset) != 1)
+  if (internal_file->io_backend->file_seek(internal_file->io_backend->user_data, internal_file->custom_handle, offset) != 1)
   {
     return -1;
   }
@@ -1054,6 +1645,66 @@ int libcfile_file_is_open(
   return (1);
 }
 
+/* Sets the IO backend of the file
+ * The IO backend is not copied and must remain valid while the file is in use
+ * A NULL IO backend resets the file to the backend set with libcfile_set_io_backend
+ * Returns 1 if successful or -1 on error
+ */
+int libcfile_file_set_io_backend(
+  libcfile_file_t* file,
+  const file_io_backend_t* io_backend,
+  libcerror_error_t** error)
+{
+  libcfile_internal_file_t* internal_file = NULL;
+  static char* function = "libcfile_file_set_io_backend";
+
+  if (file == NULL)
+  {
+    libcerror_error_set(
+      error,
+      LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+      LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+      "%s: invalid file.",
+      function);
+
+    return (-1);
+  }
+  internal_file = (libcfile_internal_file_t*)file;
+
+  if (internal_file->custom_handle != NULL)
+  {
+    libcerror_error_set(
+      error,
+      LIBCERROR_ERROR_DOMAIN_RUNTIME,
+      LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+      "%s: invalid file - handle value already set.",
+      function);
+
+    return (-1);
+  }
+  if ((io_backend != NULL)
+   && ((io_backend->file_read_submit == NULL) != (io_backend->file_read_complete == NULL)))
+  {
+    libcerror_error_set(
+      error,
+      LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+      LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+      "%s: invalid IO backend - file read submit and complete callbacks must be set together.",
+      function);
+
+    return (-1);
+  }
+  if (io_backend == NULL)
+  {
+    internal_file->io_backend = &libcfile_global_io_backend;
+  }
+  else
+  {
+    internal_file->io_backend = io_backend;
+  }
+  return (1);
+}
+
 /* Retrieves the current offset in the file
  * Returns 1 if successful or -1 on error
  */
@@ -1154,12 +1805,13 @@ int libcfile_internal_file_get_size(
     return (-1);
   }
 
-  if (custom_io_file_get_size_ptr == NULL)
+  if (internal_file->io_backend->file_get_size == NULL)
   {
     return -1;
   }
 
-  return custom_io_file_get_size_ptr(internal_file->custom_handle, size);
+  return internal_file->io_backend->file_get_size(internal_file->io_backend->user_data, internal_file->custom_handle,
+                                                  size);
 }
 
 /* Retrieves the size of the file
@@ -27,6 +27,7 @@
 
 #include "libcfile_extern.h"
 #include "libcfile_libcerror.h"
+#include "libcfile_support.h"
 #include "libcfile_types.h"
 
 #if defined( __cplusplus )
@@ -52,6 +53,10 @@ struct libcfile_internal_file
   /* The current offset
    */
   off64_t current_offset;
+
+  /* The IO backend
+   */
+  const file_io_backend_t* io_backend;
 };
 
 LIBCFILE_EXTERN
@@ -110,8 +115,6 @@ ssize_t libcfile_file_read_buffer(
   size_t size,
   libcerror_error_t** error);
 
-#if defined( WINAPI )
-
 ssize_t libcfile_internal_file_read_buffer_at_offset_with_error_code(
   libcfile_internal_file_t* internal_file,
   off64_t current_offset,
@@ -120,8 +123,6 @@ ssize_t libcfile_internal_file_read_buffer_at_offset_with_error_code(
   uint32_t* error_code,
   libcerror_error_t** error);
 
-#endif /* defined( WINAPI ) */
-
 LIBCFILE_EXTERN
 ssize_t libcfile_file_read_buffer_with_error_code(
   libcfile_file_t* file,
@@ -130,6 +131,54 @@ ssize_t libcfile_file_read_buffer_with_error_code(
   uint32_t* error_code,
   libcerror_error_t** error);
 
+LIBCFILE_EXTERN
+ssize_t libcfile_file_read_buffer_at_offset_with_error_code(
+  libcfile_file_t* file,
+  uint8_t* buffer,
+  size_t size,
+  off64_t offset,
+  uint32_t* error_code,
+  libcerror_error_t** error);
+
+LIBCFILE_EXTERN
+ssize_t libcfile_file_read_buffer_at_offset(
+  libcfile_file_t* file,
+  uint8_t* buffer,
+  size_t size,
+  off64_t offset,
+  libcerror_error_t** error);
+
+int libcfile_internal_file_read_vector_submit(
+  libcfile_internal_file_t* internal_file,
+  file_read_range_t* ranges,
+  int number_of_ranges,
+  uint8_t asynchronous,
+  void** request,
+  libcerror_error_t** error);
+
+LIBCFILE_EXTERN
+int libcfile_file_read_vector_submit(
+  libcfile_file_t* file,
+  file_read_range_t* ranges,
+  int number_of_ranges,
+  void** request,
+  libcerror_error_t** error);
+
+LIBCFILE_EXTERN
+ssize_t libcfile_file_read_vector_complete(
+  libcfile_file_t* file,
+  file_read_range_t* ranges,
+  int number_of_ranges,
+  void* request,
+  libcerror_error_t** error);
+
+LIBCFILE_EXTERN
+ssize_t libcfile_file_read_vector(
+  libcfile_file_t* file,
+  file_read_range_t* ranges,
+  int number_of_ranges,
+  libcerror_error_t** error);
+
 LIBCFILE_EXTERN
 ssize_t libcfile_file_write_buffer(
   libcfile_file_t* file,
@@ -157,6 +206,12 @@ int libcfile_file_is_open(
   libcfile_file_t* file,
   libcerror_error_t** error);
 
+LIBCFILE_EXTERN
+int libcfile_file_set_io_backend(
+  libcfile_file_t* file,
+  const file_io_backend_t* io_backend,
+  libcerror_error_t** error);
+
 LIBCFILE_EXTERN
 int libcfile_file_get_offset(
   libcfile_file_t* file,
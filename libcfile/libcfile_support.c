@@ -46,6 +46,86 @@ file_read_ptr custom_io_file_read_ptr = NULL;
 file_seek_ptr custom_io_file_seek_ptr = NULL;
 file_write_ptr custom_io_file_write_ptr = NULL;
 file_get_size_ptr custom_io_file_get_size_ptr = NULL;
+file_read_vector_ptr custom_io_file_read_vector_ptr = NULL;
+file_read_submit_ptr custom_io_file_read_submit_ptr = NULL;
+file_read_complete_ptr custom_io_file_read_complete_ptr = NULL;
+file_read64_ptr custom_io_file_read64_ptr = NULL;
+file_write64_ptr custom_io_file_write64_ptr = NULL;
+
+static int libcfile_global_file_create_handle(void* user_data, const char* filename, uint32_t access_flags,
+                                              uint32_t shared_flags, uint32_t creation_flags, void** handle)
+{
+  return custom_io_file_create_handle_ptr(filename, access_flags, shared_flags, creation_flags, handle);
+}
+
+static int libcfile_global_file_create_handle_wide(void* user_data, const wchar_t* filename, uint32_t access_flags,
+                                                   uint32_t shared_flags, uint32_t creation_flags, void** handle)
+{
+  return custom_io_file_create_handle_wide_ptr(filename, access_flags, shared_flags, creation_flags, handle);
+}
+
+static int libcfile_global_file_close_handle(void* user_data, void* handle)
+{
+  return custom_io_file_close_handle_ptr(handle);
+}
+
+static int libcfile_global_file_read(void* user_data, void* handle, int64_t offset, uint8_t* buffer, int32_t size,
+                                     int32_t* read_count)
+{
+  return custom_io_file_read_ptr(handle, offset, buffer, size, read_count);
+}
+
+static int libcfile_global_file_seek(void* user_data, void* handle, int64_t offset)
+{
+  return custom_io_file_seek_ptr(handle, offset);
+}
+
+static int libcfile_global_file_write(void* user_data, void* handle, const uint8_t* buffer, int32_t size,
+                                      int32_t* write_count)
+{
+  return custom_io_file_write_ptr(handle, buffer, size, write_count);
+}
+
+static int libcfile_global_file_get_size(void* user_data, void* handle, int64_t* size)
+{
+  return custom_io_file_get_size_ptr(handle, size);
+}
+
+static int libcfile_global_file_read_vector(void* user_data, void* handle, file_read_range_t* ranges,
+                                            int32_t number_of_ranges)
+{
+  return custom_io_file_read_vector_ptr(handle, ranges, number_of_ranges);
+}
+
+static int libcfile_global_file_read_submit(void* user_data, void* handle, file_read_range_t* ranges,
+                                            int32_t number_of_ranges, void** request)
+{
+  return custom_io_file_read_submit_ptr(handle, ranges, number_of_ranges, request);
+}
+
+static int libcfile_global_file_read_complete(void* user_data, void* handle, void* request)
+{
+  return custom_io_file_read_complete_ptr(handle, request);
+}
+
+static int libcfile_global_file_read64(void* user_data, void* handle, int64_t offset, uint8_t* buffer, int64_t size,
+                                       int64_t* read_count)
+{
+  return custom_io_file_read64_ptr(handle, offset, buffer, size, read_count);
+}
+
+static int libcfile_global_file_write64(void* user_data, void* handle, const uint8_t* buffer, int64_t size,
+                                        int64_t* write_count)
+{
+  return custom_io_file_write64_ptr(handle, buffer, size, write_count);
+}
+
+/* The callbacks of the global backend are only set when the corresponding
+ * custom_io_* callback is set, so that files without a backend of their own
+ * see the same optional callbacks as before
+ */
+file_io_backend_t libcfile_global_io_backend = {
+  NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, 0, NULL, NULL };
 
 #if !defined( HAVE_LOCAL_LIBCFILE )
 
@@ -131,6 +211,53 @@ int libcfile_set_io_backend(
   custom_io_file_seek_ptr = file_seek;
   custom_io_file_write_ptr = file_write;
   custom_io_file_get_size_ptr = file_get_size;
+
+  libcfile_global_io_backend.file_create_handle = (file_create_handle != NULL) ? libcfile_global_file_create_handle : NULL;
+  libcfile_global_io_backend.file_create_handle_wide = (file_create_handle_wide != NULL) ? libcfile_global_file_create_handle_wide : NULL;
+  libcfile_global_io_backend.file_close_handle = (file_close_handle != NULL) ? libcfile_global_file_close_handle : NULL;
+  libcfile_global_io_backend.file_read = (file_read != NULL) ? libcfile_global_file_read : NULL;
+  libcfile_global_io_backend.file_seek = (file_seek != NULL) ? libcfile_global_file_seek : NULL;
+  libcfile_global_io_backend.file_write = (file_write != NULL) ? libcfile_global_file_write : NULL;
+  libcfile_global_io_backend.file_get_size = (file_get_size != NULL) ? libcfile_global_file_get_size : NULL;
+  return 1;
+}
+
+/* Sets the optional vectored and asynchronous read callbacks
+ * The submit and complete callbacks are only used when both are set
+ * Returns 1 if successful or -1 on error
+ */
+int libcfile_set_io_backend_vectored(
+  file_read_vector_ptr file_read_vector,
+  file_read_submit_ptr file_read_submit,
+  file_read_complete_ptr file_read_complete )
+{
+  if ((file_read_submit == NULL) != (file_read_complete == NULL))
+  {
+    return -1;
+  }
+  custom_io_file_read_vector_ptr = file_read_vector;
+  custom_io_file_read_submit_ptr = file_read_submit;
+  custom_io_file_read_complete_ptr = file_read_complete;
+
+  libcfile_global_io_backend.file_read_vector = (file_read_vector != NULL) ? libcfile_global_file_read_vector : NULL;
+  libcfile_global_io_backend.file_read_submit = (file_read_submit != NULL) ? libcfile_global_file_read_submit : NULL;
+  libcfile_global_io_backend.file_read_complete = (file_read_complete != NULL) ? libcfile_global_file_read_complete : NULL;
+  return 1;
+}
+
+/* Sets the optional read and write callbacks with 64-bit sizes
+ * When set they are used instead of the read and write callbacks with 32-bit sizes
+ * Returns 1 if successful or -1 on error
+ */
+int libcfile_set_io_backend_64(
+  file_read64_ptr file_read64,
+  file_write64_ptr file_write64 )
+{
+  custom_io_file_read64_ptr = file_read64;
+  custom_io_file_write64_ptr = file_write64;
+
+  libcfile_global_io_backend.file_read64 = (file_read64 != NULL) ? libcfile_global_file_read64 : NULL;
+  libcfile_global_io_backend.file_write64 = (file_write64 != NULL) ? libcfile_global_file_write64 : NULL;
   return 1;
 }
 
@@ -60,6 +60,70 @@ typedef int (*file_seek_ptr)(void*, int64_t);
 typedef int (*file_write_ptr)(void*, const uint8_t*, int32_t, int32_t*);
 typedef int (*file_get_size_ptr)(void*, int64_t*);
 
+/* A range of a vectored read, read_count is set by the callback
+ */
+#if !defined( HAVE_FILE_READ_RANGE_T )
+#define HAVE_FILE_READ_RANGE_T
+
+typedef struct file_read_range
+{
+  int64_t offset;
+  uint8_t* buffer;
+  int32_t size;
+  int32_t read_count;
+} file_read_range_t;
+
+#endif
+
+/* Optional callbacks to read multiple ranges with a single call
+ * or to submit the read of multiple ranges and wait for it to complete
+ */
+typedef int (*file_read_vector_ptr)(void*, file_read_range_t*, int32_t);
+typedef int (*file_read_submit_ptr)(void*, file_read_range_t*, int32_t, void**);
+typedef int (*file_read_complete_ptr)(void*, void*);
+
+/* Optional callbacks to read or write more than 2 GiB with a single call
+ */
+typedef int (*file_read64_ptr)(void*, int64_t, uint8_t*, int64_t, int64_t*);
+typedef int (*file_write64_ptr)(void*, const uint8_t*, int64_t, int64_t*);
+
+/* An IO backend that can be bound to individual files
+ * The user data is passed as the first argument of every callback
+ */
+#if !defined( HAVE_FILE_IO_BACKEND_T )
+#define HAVE_FILE_IO_BACKEND_T
+
+typedef struct file_io_backend
+{
+  void* user_data;
+  int (*file_create_handle)(void*, const char*, uint32_t, uint32_t, uint32_t, void**);
+  int (*file_create_handle_wide)(void*, const wchar_t*, uint32_t, uint32_t, uint32_t, void**);
+  int (*file_close_handle)(void*, void*);
+  int (*file_read)(void*, void*, int64_t, uint8_t*, int32_t, int32_t*);
+  int (*file_seek)(void*, void*, int64_t);
+  int (*file_write)(void*, void*, const uint8_t*, int32_t, int32_t*);
+  int (*file_get_size)(void*, void*, int64_t*);
+  int (*file_read_vector)(void*, void*, file_read_range_t*, int32_t);
+  int (*file_read_submit)(void*, void*, file_read_range_t*, int32_t, void**);
+  int (*file_read_complete)(void*, void*, void*);
+
+  /* The maximum number of bytes passed to a single read callback, 0 represents no maximum
+   */
+  int32_t maximum_read_size;
+
+  /* Optional callbacks with 64-bit sizes, used instead of file_read and file_write when set
+   */
+  int (*file_read64)(void*, void*, int64_t, uint8_t*, int64_t, int64_t*);
+  int (*file_write64)(void*, void*, const uint8_t*, int64_t, int64_t*);
+} file_io_backend_t;
+
+#endif
+
+/* The backend that wraps the process-wide custom_io_* callbacks
+ * it is used by files that have no IO backend of their own
+ */
+extern file_io_backend_t libcfile_global_io_backend;
+
 LIBCFILE_EXTERN_VARIABLE file_exists_ptr custom_io_file_exists_ptr;
 LIBCFILE_EXTERN_VARIABLE file_exists_wide_ptr custom_io_file_exists_wide_ptr;
 LIBCFILE_EXTERN_VARIABLE file_create_handle_ptr custom_io_file_create_handle_ptr;
@@ -69,6 +133,11 @@ LIBCFILE_EXTERN_VARIABLE file_read_ptr custom_io_file_read_ptr;
 LIBCFILE_EXTERN_VARIABLE file_seek_ptr custom_io_file_seek_ptr;
 LIBCFILE_EXTERN_VARIABLE file_write_ptr custom_io_file_write_ptr;
 LIBCFILE_EXTERN_VARIABLE file_get_size_ptr custom_io_file_get_size_ptr;
+LIBCFILE_EXTERN_VARIABLE file_read_vector_ptr custom_io_file_read_vector_ptr;
+LIBCFILE_EXTERN_VARIABLE file_read_submit_ptr custom_io_file_read_submit_ptr;
+LIBCFILE_EXTERN_VARIABLE file_read_complete_ptr custom_io_file_read_complete_ptr;
+LIBCFILE_EXTERN_VARIABLE file_read64_ptr custom_io_file_read64_ptr;
+LIBCFILE_EXTERN_VARIABLE file_write64_ptr custom_io_file_write64_ptr;
 
 LIBCFILE_EXTERN \
 int libcfile_set_io_backend(
@@ -82,6 +151,17 @@ int libcfile_set_io_backend(
   file_write_ptr file_write,
   file_get_size_ptr file_get_size );
 
+LIBCFILE_EXTERN \
+int libcfile_set_io_backend_vectored(
+  file_read_vector_ptr file_read_vector,
+  file_read_submit_ptr file_read_submit,
+  file_read_complete_ptr file_read_complete );
+
+LIBCFILE_EXTERN \
+int libcfile_set_io_backend_64(
+  file_read64_ptr file_read64,
+  file_write64_ptr file_write64 );
+
 LIBCFILE_EXTERN \
 int libcfile_file_exists(
      const char *filename,
@@ -0,0 +1,222 @@
+/*
+ * EWF index file
+ *
+ * Copyright (C) 2006-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#if !defined( _EWF_INDEX_FILE_H )
+#define _EWF_INDEX_FILE_H
+
+#include <common.h>
+#include <types.h>
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct ewf_index_file_header ewf_index_file_header_t;
+
+struct ewf_index_file_header
+{
+	/* The signature
+	 * Consists of 8 bytes
+	 * Contains: EWFIDX 0x0d 0x0a
+	 */
+	uint8_t signature[ 8 ];
+
+	/* The format version
+	 * Consists of 4 bytes
+	 * Contains: 1
+	 */
+	uint8_t format_version[ 4 ];
+
+	/* The number of segment records
+	 * Consists of 4 bytes
+	 */
+	uint8_t number_of_records[ 4 ];
+
+	/* The size of the segment records data
+	 * Consists of 8 bytes
+	 */
+	uint8_t records_data_size[ 8 ];
+
+	/* The segment records data checksum
+	 * Consists of 4 bytes
+	 * Contains an Adler-32 of the segment records data
+	 */
+	uint8_t records_data_checksum[ 4 ];
+
+	/* The checksum
+	 * Consists of 4 bytes
+	 * Contains an Adler-32 of all the previous data within the header
+	 */
+	uint8_t checksum[ 4 ];
+};
+
+typedef struct ewf_index_file_segment ewf_index_file_segment_t;
+
+/* The segment record is followed by the section entries and the chunk group entries
+ */
+struct ewf_index_file_segment
+{
+	/* The record size
+	 * Consists of 4 bytes
+	 * Includes the size of the section and chunk group entries
+	 */
+	uint8_t record_size[ 4 ];
+
+	/* The segment number
+	 * Consists of 4 bytes
+	 */
+	uint8_t segment_number[ 4 ];
+
+	/* The segment file size
+	 * Consists of 8 bytes
+	 */
+	uint8_t segment_file_size[ 8 ];
+
+	/* The segment file type
+	 * Consists of 1 byte
+	 */
+	uint8_t segment_file_type;
+
+	/* The major version
+	 * Consists of 1 byte
+	 */
+	uint8_t major_version;
+
+	/* The minor version
+	 * Consists of 1 byte
+	 */
+	uint8_t minor_version;
+
+	/* The segment file flags
+	 * Consists of 1 byte
+	 */
+	uint8_t flags;
+
+	/* The compression method
+	 * Consists of 2 bytes
+	 */
+	uint8_t compression_method[ 2 ];
+
+	/* Padding
+	 * Consists of 2 bytes
+	 */
+	uint8_t padding1[ 2 ];
+
+	/* The segment set identifier
+	 * Consists of 16 bytes
+	 * Contains a GUID
+	 */
+	uint8_t set_identifier[ 16 ];
+
+	/* The last section offset
+	 * Consists of 8 bytes
+	 */
+	uint8_t last_section_offset[ 8 ];
+
+	/* The last section type
+	 * Consists of 4 bytes
+	 */
+	uint8_t last_section_type[ 4 ];
+
+	/* The device information section index
+	 * Consists of 4 bytes
+	 * Contains 0xffffffff if not set
+	 */
+	uint8_t device_information_section_index[ 4 ];
+
+	/* The storage media size
+	 * Consists of 8 bytes
+	 */
+	uint8_t storage_media_size[ 8 ];
+
+	/* The number of chunks
+	 * Consists of 8 bytes
+	 */
+	uint8_t number_of_chunks[ 8 ];
+
+	/* The last chunk filled
+	 * Consists of 8 bytes
+	 */
+	uint8_t last_chunk_filled[ 8 ];
+
+	/* The last chunk compared
+	 * Consists of 8 bytes
+	 */
+	uint8_t last_chunk_compared[ 8 ];
+
+	/* The number of sections
+	 * Consists of 4 bytes
+	 */
+	uint8_t number_of_sections[ 4 ];
+
+	/* The number of chunk groups
+	 * Consists of 4 bytes
+	 */
+	uint8_t number_of_chunk_groups[ 4 ];
+};
+
+typedef struct ewf_index_file_section_entry ewf_index_file_section_entry_t;
+
+struct ewf_index_file_section_entry
+{
+	/* The section descriptor offset
+	 * Consists of 8 bytes
+	 */
+	uint8_t offset[ 8 ];
+};
+
+typedef struct ewf_index_file_chunk_group_entry ewf_index_file_chunk_group_entry_t;
+
+struct ewf_index_file_chunk_group_entry
+{
+	/* The chunk group (table) data offset
+	 * Consists of 8 bytes
+	 */
+	uint8_t data_offset[ 8 ];
+
+	/* The chunk group (table) data size
+	 * Consists of 8 bytes
+	 */
+	uint8_t data_size[ 8 ];
+
+	/* The chunk group storage media size
+	 * Consists of 8 bytes
+	 */
+	uint8_t mapped_size[ 8 ];
+
+	/* The range flags
+	 * Consists of 4 bytes
+	 */
+	uint8_t range_flags[ 4 ];
+
+	/* Padding
+	 * Consists of 4 bytes
+	 */
+	uint8_t padding[ 4 ];
+};
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _EWF_INDEX_FILE_H ) */
+
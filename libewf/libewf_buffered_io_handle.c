@@ -0,0 +1,901 @@
+/*
+ * Buffered IO handle functions
+ *
+ * Copyright (C) 2006-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_buffered_io_handle.h"
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+
+/* Creates a buffered IO handle
+ * Make sure the value buffered_io_handle is referencing, is set to NULL
+ * The buffered IO handle takes over the management of the file IO handle if successful
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_buffered_io_handle_initialize(
+     libewf_buffered_io_handle_t **buffered_io_handle,
+     libbfio_handle_t *file_io_handle,
+     size_t buffer_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_buffered_io_handle_initialize";
+
+	if( buffered_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffered IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *buffered_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid buffered IO handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( buffer_size == 0 )
+	 || ( buffer_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid buffer size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*buffered_io_handle = memory_allocate_structure(
+	                       libewf_buffered_io_handle_t );
+
+	if( *buffered_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buffered IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *buffered_io_handle,
+	     0,
+	     sizeof( libewf_buffered_io_handle_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear buffered IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	( *buffered_io_handle )->file_io_handle = file_io_handle;
+	( *buffered_io_handle )->buffer_size    = buffer_size;
+
+	return( 1 );
+
+on_error:
+	if( *buffered_io_handle != NULL )
+	{
+		memory_free(
+		 *buffered_io_handle );
+
+		*buffered_io_handle = NULL;
+	}
+	return( -1 );
+}
+
+/* Creates a buffered file handle
+ * Make sure the value handle is referencing, is set to NULL
+ * The handle takes over the management of the file IO handle if successful
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_buffered_file_initialize(
+     libbfio_handle_t **handle,
+     libbfio_handle_t *file_io_handle,
+     size_t buffer_size,
+     libcerror_error_t **error )
+{
+	libewf_buffered_io_handle_t *buffered_io_handle = NULL;
+	static char *function                           = "libewf_buffered_file_initialize";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_buffered_io_handle_initialize(
+	     &buffered_io_handle,
+	     file_io_handle,
+	     buffer_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create buffered IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_initialize(
+	     handle,
+	     (intptr_t *) buffered_io_handle,
+	     (int (*)(intptr_t **, libcerror_error_t **)) libewf_buffered_io_handle_free,
+	     (int (*)(intptr_t **, intptr_t *, libcerror_error_t **)) libewf_buffered_io_handle_clone,
+	     (int (*)(intptr_t *, int, libcerror_error_t **)) libewf_buffered_io_handle_open,
+	     (int (*)(intptr_t *, libcerror_error_t **)) libewf_buffered_io_handle_close,
+	     (ssize_t (*)(intptr_t *, uint8_t *, size_t, libcerror_error_t **)) libewf_buffered_io_handle_read,
+	     (ssize_t (*)(intptr_t *, const uint8_t *, size_t, libcerror_error_t **)) libewf_buffered_io_handle_write,
+	     (off64_t (*)(intptr_t *, off64_t, int, libcerror_error_t **)) libewf_buffered_io_handle_seek_offset,
+	     (int (*)(intptr_t *, libcerror_error_t **)) libewf_buffered_io_handle_exists,
+	     (int (*)(intptr_t *, libcerror_error_t **)) libewf_buffered_io_handle_is_open,
+	     (int (*)(intptr_t *, size64_t *, libcerror_error_t **)) libewf_buffered_io_handle_get_size,
+	     LIBBFIO_FLAG_IO_HANDLE_MANAGED | LIBBFIO_FLAG_IO_HANDLE_CLONE_BY_FUNCTION,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create handle.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( buffered_io_handle != NULL )
+	{
+		/* The file IO handle remains managed by the caller on error
+		 */
+		buffered_io_handle->file_io_handle = NULL;
+
+		libewf_buffered_io_handle_free(
+		 &buffered_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Frees a buffered IO handle
+ * Data remaining in the write buffer is not written, use close to flush it
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_buffered_io_handle_free(
+     libewf_buffered_io_handle_t **buffered_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_buffered_io_handle_free";
+	int result            = 1;
+
+	if( buffered_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffered IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *buffered_io_handle != NULL )
+	{
+		if( ( *buffered_io_handle )->file_io_handle != NULL )
+		{
+			if( libbfio_handle_free(
+			     &( ( *buffered_io_handle )->file_io_handle ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free file IO handle.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *buffered_io_handle )->buffer != NULL )
+		{
+			memory_free(
+			 ( *buffered_io_handle )->buffer );
+		}
+		memory_free(
+		 *buffered_io_handle );
+
+		*buffered_io_handle = NULL;
+	}
+	return( result );
+}
+
+/* Clones (duplicates) the buffered IO handle
+ * The write buffer and its data are not cloned
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_buffered_io_handle_clone(
+     libewf_buffered_io_handle_t **destination_buffered_io_handle,
+     libewf_buffered_io_handle_t *source_buffered_io_handle,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *destination_file_io_handle = NULL;
+	static char *function                        = "libewf_buffered_io_handle_clone";
+
+	if( destination_buffered_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid destination buffered IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *destination_buffered_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: destination buffered IO handle already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( source_buffered_io_handle == NULL )
+	{
+		*destination_buffered_io_handle = NULL;
+
+		return( 1 );
+	}
+	if( libbfio_handle_clone(
+	     &destination_file_io_handle,
+	     source_buffered_io_handle->file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create destination file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_buffered_io_handle_initialize(
+	     destination_buffered_io_handle,
+	     destination_file_io_handle,
+	     source_buffered_io_handle->buffer_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create destination buffered IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( destination_file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &destination_file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Writes the data in the write buffer to the file IO handle
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_buffered_io_handle_flush(
+     libewf_buffered_io_handle_t *buffered_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_buffered_io_handle_flush";
+	size_t buffer_offset  = 0;
+	ssize_t write_count   = 0;
+
+	if( buffered_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffered IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	while( buffer_offset < buffered_io_handle->buffer_data_size )
+	{
+		write_count = libbfio_handle_write_buffer(
+		               buffered_io_handle->file_io_handle,
+		               &( buffered_io_handle->buffer[ buffer_offset ] ),
+		               buffered_io_handle->buffer_data_size - buffer_offset,
+		               error );
+
+		if( write_count <= 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write buffer data.",
+			 function );
+
+			/* The data cannot be written at its offset any more
+			 */
+			buffered_io_handle->buffer_data_size = 0;
+
+			return( -1 );
+		}
+		buffer_offset += (size_t) write_count;
+	}
+	buffered_io_handle->buffer_data_size = 0;
+
+	return( 1 );
+}
+
+/* Opens the buffered IO handle
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_buffered_io_handle_open(
+     libewf_buffered_io_handle_t *buffered_io_handle,
+     int access_flags,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_buffered_io_handle_open";
+
+	if( buffered_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffered IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( ( access_flags & LIBBFIO_ACCESS_FLAG_WRITE ) != 0 )
+	 && ( buffered_io_handle->buffer == NULL ) )
+	{
+		buffered_io_handle->buffer = (uint8_t *) memory_allocate(
+		                                          sizeof( uint8_t ) * buffered_io_handle->buffer_size );
+
+		if( buffered_io_handle->buffer == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create buffer.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( libbfio_handle_open(
+	     buffered_io_handle->file_io_handle,
+	     access_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	buffered_io_handle->buffer_data_size = 0;
+	buffered_io_handle->current_offset   = 0;
+
+	return( 1 );
+}
+
+/* Closes the buffered IO handle
+ * Returns 0 if successful or -1 on error
+ */
+int libewf_buffered_io_handle_close(
+     libewf_buffered_io_handle_t *buffered_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_buffered_io_handle_close";
+	int result            = 0;
+
+	if( buffered_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffered IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_buffered_io_handle_flush(
+	     buffered_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to flush buffered IO handle.",
+		 function );
+
+		result = -1;
+	}
+	if( libbfio_handle_close(
+	     buffered_io_handle->file_io_handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close file IO handle.",
+		 function );
+
+		result = -1;
+	}
+	return( result );
+}
+
+/* Reads a buffer from the buffered IO handle
+ * Returns the number of bytes read if successful, or -1 on error
+ */
+ssize_t libewf_buffered_io_handle_read(
+         libewf_buffered_io_handle_t *buffered_io_handle,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error )
+{
+	static char *function = "libewf_buffered_io_handle_read";
+	ssize_t read_count    = 0;
+
+	if( buffered_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffered IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_buffered_io_handle_flush(
+	     buffered_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to flush buffered IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	read_count = libbfio_handle_read_buffer(
+	              buffered_io_handle->file_io_handle,
+	              buffer,
+	              size,
+	              error );
+
+	if( read_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read from file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	buffered_io_handle->current_offset += (off64_t) read_count;
+
+	return( read_count );
+}
+
+/* Writes a buffer to the buffered IO handle
+ * The data is collected in the write buffer, which is written to the file IO handle when full
+ * Data that fills complete write buffers is written directly when the write buffer is empty
+ * Returns the number of bytes written if successful, or -1 on error
+ */
+ssize_t libewf_buffered_io_handle_write(
+         libewf_buffered_io_handle_t *buffered_io_handle,
+         const uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error )
+{
+	static char *function = "libewf_buffered_io_handle_write";
+	size_t buffer_offset  = 0;
+	size_t write_size     = 0;
+	ssize_t write_count   = 0;
+
+	if( buffered_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffered IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffered_io_handle->buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid buffered IO handle - missing buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	while( buffer_offset < size )
+	{
+		write_size = size - buffer_offset;
+
+		if( ( buffered_io_handle->buffer_data_size == 0 )
+		 && ( write_size >= buffered_io_handle->buffer_size ) )
+		{
+			write_size -= write_size % buffered_io_handle->buffer_size;
+
+			write_count = libbfio_handle_write_buffer(
+			               buffered_io_handle->file_io_handle,
+			               &( buffer[ buffer_offset ] ),
+			               write_size,
+			               error );
+
+			if( write_count != (ssize_t) write_size )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write to file IO handle.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		else
+		{
+			if( write_size > ( buffered_io_handle->buffer_size - buffered_io_handle->buffer_data_size ) )
+			{
+				write_size = buffered_io_handle->buffer_size - buffered_io_handle->buffer_data_size;
+			}
+			if( memory_copy(
+			     &( buffered_io_handle->buffer[ buffered_io_handle->buffer_data_size ] ),
+			     &( buffer[ buffer_offset ] ),
+			     write_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy data to buffer.",
+				 function );
+
+				return( -1 );
+			}
+			buffered_io_handle->buffer_data_size += write_size;
+
+			if( buffered_io_handle->buffer_data_size == buffered_io_handle->buffer_size )
+			{
+				if( libewf_buffered_io_handle_flush(
+				     buffered_io_handle,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_WRITE_FAILED,
+					 "%s: unable to flush buffered IO handle.",
+					 function );
+
+					return( -1 );
+				}
+			}
+		}
+		buffer_offset                      += write_size;
+		buffered_io_handle->current_offset += (off64_t) write_size;
+	}
+	return( (ssize_t) size );
+}
+
+/* Seeks a certain offset within the buffered IO handle
+ * The write buffer is only flushed when the offset changes
+ * Returns the offset if the seek is successful or -1 on error
+ */
+off64_t libewf_buffered_io_handle_seek_offset(
+         libewf_buffered_io_handle_t *buffered_io_handle,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error )
+{
+	static char *function = "libewf_buffered_io_handle_seek_offset";
+
+	if( buffered_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffered IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( whence == SEEK_CUR )
+	{
+		offset += buffered_io_handle->current_offset;
+		whence  = SEEK_SET;
+	}
+	if( ( whence == SEEK_SET )
+	 && ( offset == buffered_io_handle->current_offset ) )
+	{
+		return( offset );
+	}
+	if( libewf_buffered_io_handle_flush(
+	     buffered_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to flush buffered IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	offset = libbfio_handle_seek_offset(
+	          buffered_io_handle->file_io_handle,
+	          offset,
+	          whence,
+	          error );
+
+	if( offset == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset in file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	buffered_io_handle->current_offset = offset;
+
+	return( offset );
+}
+
+/* Function to determine if a file exists
+ * Returns 1 if file exists, 0 if not or -1 on error
+ */
+int libewf_buffered_io_handle_exists(
+     libewf_buffered_io_handle_t *buffered_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_buffered_io_handle_exists";
+	int result            = 0;
+
+	if( buffered_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffered IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	result = libbfio_handle_exists(
+	          buffered_io_handle->file_io_handle,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_GENERIC,
+		 "%s: unable to determine if file IO handle exists.",
+		 function );
+	}
+	return( result );
+}
+
+/* Check if the buffered IO handle is open
+ * Returns 1 if open, 0 if not or -1 on error
+ */
+int libewf_buffered_io_handle_is_open(
+     libewf_buffered_io_handle_t *buffered_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_buffered_io_handle_is_open";
+	int result            = 0;
+
+	if( buffered_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffered IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	result = libbfio_handle_is_open(
+	          buffered_io_handle->file_io_handle,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_GENERIC,
+		 "%s: unable to determine if file IO handle is open.",
+		 function );
+	}
+	return( result );
+}
+
+/* Retrieves the buffered IO handle size
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_buffered_io_handle_get_size(
+     libewf_buffered_io_handle_t *buffered_io_handle,
+     size64_t *size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_buffered_io_handle_get_size";
+
+	if( buffered_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffered IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_buffered_io_handle_flush(
+	     buffered_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to flush buffered IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_handle_get_size(
+	     buffered_io_handle->file_io_handle,
+	     size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve size of file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
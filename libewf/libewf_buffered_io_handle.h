@@ -0,0 +1,135 @@
+/*
+ * Buffered IO handle functions
+ *
+ * Copyright (C) 2006-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_BUFFERED_IO_HANDLE_H )
+#define _LIBEWF_BUFFERED_IO_HANDLE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libewf_buffered_io_handle libewf_buffered_io_handle_t;
+
+/* The buffered IO handle collects sequential writes in a write buffer
+ * and writes them to the underlying file IO handle in blocks of the buffer size
+ * The write buffer is flushed before the offset is changed, before reading,
+ * before the size is retrieved and on close
+ */
+struct libewf_buffered_io_handle
+{
+	/* The underlying file IO handle
+	 */
+	libbfio_handle_t *file_io_handle;
+
+	/* The write buffer
+	 */
+	uint8_t *buffer;
+
+	/* The write buffer size
+	 */
+	size_t buffer_size;
+
+	/* The size of the data in the write buffer
+	 */
+	size_t buffer_data_size;
+
+	/* The current offset
+	 */
+	off64_t current_offset;
+};
+
+int libewf_buffered_io_handle_initialize(
+     libewf_buffered_io_handle_t **buffered_io_handle,
+     libbfio_handle_t *file_io_handle,
+     size_t buffer_size,
+     libcerror_error_t **error );
+
+int libewf_buffered_file_initialize(
+     libbfio_handle_t **handle,
+     libbfio_handle_t *file_io_handle,
+     size_t buffer_size,
+     libcerror_error_t **error );
+
+int libewf_buffered_io_handle_free(
+     libewf_buffered_io_handle_t **buffered_io_handle,
+     libcerror_error_t **error );
+
+int libewf_buffered_io_handle_clone(
+     libewf_buffered_io_handle_t **destination_buffered_io_handle,
+     libewf_buffered_io_handle_t *source_buffered_io_handle,
+     libcerror_error_t **error );
+
+int libewf_buffered_io_handle_flush(
+     libewf_buffered_io_handle_t *buffered_io_handle,
+     libcerror_error_t **error );
+
+int libewf_buffered_io_handle_open(
+     libewf_buffered_io_handle_t *buffered_io_handle,
+     int access_flags,
+     libcerror_error_t **error );
+
+int libewf_buffered_io_handle_close(
+     libewf_buffered_io_handle_t *buffered_io_handle,
+     libcerror_error_t **error );
+
+ssize_t libewf_buffered_io_handle_read(
+         libewf_buffered_io_handle_t *buffered_io_handle,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error );
+
+ssize_t libewf_buffered_io_handle_write(
+         libewf_buffered_io_handle_t *buffered_io_handle,
+         const uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error );
+
+off64_t libewf_buffered_io_handle_seek_offset(
+         libewf_buffered_io_handle_t *buffered_io_handle,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error );
+
+int libewf_buffered_io_handle_exists(
+     libewf_buffered_io_handle_t *buffered_io_handle,
+     libcerror_error_t **error );
+
+int libewf_buffered_io_handle_is_open(
+     libewf_buffered_io_handle_t *buffered_io_handle,
+     libcerror_error_t **error );
+
+int libewf_buffered_io_handle_get_size(
+     libewf_buffered_io_handle_t *buffered_io_handle,
+     size64_t *size,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_BUFFERED_IO_HANDLE_H ) */
+
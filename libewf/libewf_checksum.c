@@ -28,10 +28,31 @@
 #endif
 
 #include "libewf_checksum.h"
+#include "libewf_cpu_features.h"
+#include "libewf_deflate.h"
 #include "libewf_libcerror.h"
 #include "libewf_types.h"
 
-#if defined( HAVE_ZLIB_ADLER32 ) && ( defined( HAVE_ZLIB ) || defined( ZLIB_DLL ) )
+#if defined( HAVE_LIBEWF_SSE2_SUPPORT ) || defined( HAVE_LIBEWF_AVX2_SUPPORT )
+#include <immintrin.h>
+#endif
+
+#if defined( HAVE_LIBEWF_NEON_SUPPORT )
+#if defined( _MSC_VER )
+#include <arm64_neon.h>
+#else
+#include <arm_neon.h>
+#endif
+#endif
+
+/* The largest prime smaller than 65536
+ */
+#define LIBEWF_CHECKSUM_ADLER32_BASE	65521
+
+/* The largest number of bytes that can be processed before the sums
+ * need to be reduced modulo the base to prevent 32-bit overflow
+ */
+#define LIBEWF_CHECKSUM_ADLER32_MAXIMUM_BLOCK_SIZE	5552
 
 /* Calculates the little-endian Adler-32 of a buffer
  * It uses the initial value to calculate a new Adler-32
@@ -45,6 +66,7 @@ int libewf_checksum_calculate_adler32(
      libcerror_error_t **error )
 {
 	static char *function = "libewf_checksum_calculate_adler32";
+	uint32_t cpu_features = 0;
 
 	if( checksum_value == NULL )
 	{
@@ -68,8 +90,54 @@ int libewf_checksum_calculate_adler32(
 
 		return( -1 );
 	}
-	if( ( size > (size_t) UINT_MAX )
-	 || ( size > (size_t) SSIZE_MAX ) )
+	if( size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	cpu_features = libewf_cpu_features_get_flags();
+
+#if defined( HAVE_LIBEWF_AVX2_SUPPORT )
+	if( ( cpu_features & LIBEWF_CPU_FEATURE_FLAG_AVX2 ) != 0 )
+	{
+		return( libewf_checksum_calculate_adler32_avx2(
+		         checksum_value,
+		         buffer,
+		         size,
+		         initial_value,
+		         error ) );
+	}
+#endif
+#if defined( HAVE_LIBEWF_SSE2_SUPPORT )
+	if( ( cpu_features & LIBEWF_CPU_FEATURE_FLAG_SSE2 ) != 0 )
+	{
+		return( libewf_checksum_calculate_adler32_sse2(
+		         checksum_value,
+		         buffer,
+		         size,
+		         initial_value,
+		         error ) );
+	}
+#endif
+#if defined( HAVE_LIBEWF_NEON_SUPPORT )
+	if( ( cpu_features & LIBEWF_CPU_FEATURE_FLAG_NEON ) != 0 )
+	{
+		return( libewf_checksum_calculate_adler32_neon(
+		         checksum_value,
+		         buffer,
+		         size,
+		         initial_value,
+		         error ) );
+	}
+#endif
+#if defined( HAVE_ZLIB_ADLER32 ) && ( defined( HAVE_ZLIB ) || defined( ZLIB_DLL ) )
+	if( size > (size_t) UINT_MAX )
 	{
 		libcerror_error_set(
 		 error,
@@ -85,8 +153,414 @@ int libewf_checksum_calculate_adler32(
 	                   (const Bytef *) buffer,
 	                   (uInt) size );
 
+	return( 1 );
+#else
+	return( libewf_deflate_calculate_adler32(
+	         checksum_value,
+	         buffer,
+	         size,
+	         initial_value,
+	         error ) );
+#endif
+}
+
+#if defined( HAVE_LIBEWF_SSE2_SUPPORT ) || defined( HAVE_LIBEWF_AVX2_SUPPORT ) || defined( HAVE_LIBEWF_NEON_SUPPORT )
+
+/* Calculates the Adler-32 of the bytes that remain after the vectorized blocks
+ * Returns the Adler-32
+ */
+static uint32_t libewf_checksum_calculate_adler32_remainder(
+                 uint32_t lower_word,
+                 uint32_t upper_word,
+                 const uint8_t *buffer,
+                 size_t size )
+{
+	while( size > 0 )
+	{
+		lower_word += *buffer;
+		upper_word += lower_word;
+
+		buffer++;
+		size--;
+	}
+	lower_word %= LIBEWF_CHECKSUM_ADLER32_BASE;
+	upper_word %= LIBEWF_CHECKSUM_ADLER32_BASE;
+
+	return( ( upper_word << 16 ) | lower_word );
+}
+
+#endif /* defined( HAVE_LIBEWF_SSE2_SUPPORT ) || defined( HAVE_LIBEWF_AVX2_SUPPORT ) || defined( HAVE_LIBEWF_NEON_SUPPORT ) */
+
+#if defined( HAVE_LIBEWF_SSE2_SUPPORT )
+
+/* Calculates the little-endian Adler-32 of a buffer using SSE2
+ * It uses the initial value to calculate a new Adler-32
+ * Returns 1 if successful or -1 on error
+ */
+LIBEWF_ATTRIBUTE_TARGET_SSE2
+int libewf_checksum_calculate_adler32_sse2(
+     uint32_t *checksum_value,
+     const uint8_t *buffer,
+     size_t size,
+     uint32_t initial_value,
+     libcerror_error_t **error )
+{
+	__m128i byte_values;
+	__m128i first_half_weights;
+	__m128i lower_sums;
+	__m128i previous_lower_sums;
+	__m128i second_half_weights;
+	__m128i upper_sums;
+	__m128i zero_values;
+
+	static char *function   = "libewf_checksum_calculate_adler32_sse2";
+	size_t number_of_blocks = 0;
+	uint32_t lower_word     = 0;
+	uint32_t upper_word     = 0;
+
+	if( checksum_value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid checksum value.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	lower_word = ( initial_value & 0xffff ) % LIBEWF_CHECKSUM_ADLER32_BASE;
+	upper_word = ( ( initial_value >> 16 ) & 0xffff ) % LIBEWF_CHECKSUM_ADLER32_BASE;
+
+	/* Byte i of a 16-byte block contributes ( 16 - i ) times to the upper word
+	 */
+	first_half_weights  = _mm_setr_epi16( 16, 15, 14, 13, 12, 11, 10, 9 );
+	second_half_weights = _mm_setr_epi16( 8, 7, 6, 5, 4, 3, 2, 1 );
+	zero_values         = _mm_setzero_si128();
+
+	while( size >= 16 )
+	{
+		number_of_blocks = size / 16;
+
+		if( number_of_blocks > ( LIBEWF_CHECKSUM_ADLER32_MAXIMUM_BLOCK_SIZE / 16 ) )
+		{
+			number_of_blocks = LIBEWF_CHECKSUM_ADLER32_MAXIMUM_BLOCK_SIZE / 16;
+		}
+		size -= number_of_blocks * 16;
+
+		/* Every block adds 16 times the lower word at the start of the block to the upper word
+		 */
+		previous_lower_sums = _mm_cvtsi32_si128( (int) ( lower_word * number_of_blocks ) );
+		lower_sums          = _mm_setzero_si128();
+		upper_sums          = _mm_cvtsi32_si128( (int) upper_word );
+
+		while( number_of_blocks > 0 )
+		{
+			byte_values = _mm_loadu_si128( (const __m128i *) buffer );
+
+			previous_lower_sums = _mm_add_epi32( previous_lower_sums, lower_sums );
+
+			lower_sums = _mm_add_epi32( lower_sums, _mm_sad_epu8( byte_values, zero_values ) );
+
+			upper_sums = _mm_add_epi32( upper_sums, _mm_madd_epi16( _mm_unpacklo_epi8( byte_values, zero_values ), first_half_weights ) );
+			upper_sums = _mm_add_epi32( upper_sums, _mm_madd_epi16( _mm_unpackhi_epi8( byte_values, zero_values ), second_half_weights ) );
+
+			buffer           += 16;
+			number_of_blocks -= 1;
+		}
+		upper_sums = _mm_add_epi32( upper_sums, _mm_slli_epi32( previous_lower_sums, 4 ) );
+
+		lower_sums = _mm_add_epi32( lower_sums, _mm_shuffle_epi32( lower_sums, 0x4e ) );
+		lower_sums = _mm_add_epi32( lower_sums, _mm_shuffle_epi32( lower_sums, 0xb1 ) );
+		upper_sums = _mm_add_epi32( upper_sums, _mm_shuffle_epi32( upper_sums, 0x4e ) );
+		upper_sums = _mm_add_epi32( upper_sums, _mm_shuffle_epi32( upper_sums, 0xb1 ) );
+
+		lower_word += (uint32_t) _mm_cvtsi128_si32( lower_sums );
+		upper_word  = (uint32_t) _mm_cvtsi128_si32( upper_sums );
+
+		lower_word %= LIBEWF_CHECKSUM_ADLER32_BASE;
+		upper_word %= LIBEWF_CHECKSUM_ADLER32_BASE;
+	}
+	*checksum_value = libewf_checksum_calculate_adler32_remainder(
+	                   lower_word,
+	                   upper_word,
+	                   buffer,
+	                   size );
+
+	return( 1 );
+}
+
+#endif /* defined( HAVE_LIBEWF_SSE2_SUPPORT ) */
+
+#if defined( HAVE_LIBEWF_AVX2_SUPPORT )
+
+/* Calculates the little-endian Adler-32 of a buffer using AVX2
+ * It uses the initial value to calculate a new Adler-32
+ * Returns 1 if successful or -1 on error
+ */
+LIBEWF_ATTRIBUTE_TARGET_AVX2
+int libewf_checksum_calculate_adler32_avx2(
+     uint32_t *checksum_value,
+     const uint8_t *buffer,
+     size_t size,
+     uint32_t initial_value,
+     libcerror_error_t **error )
+{
+	__m256i byte_values;
+	__m256i lower_sums;
+	__m256i one_values;
+	__m256i previous_lower_sums;
+	__m256i upper_sums;
+	__m256i weights;
+	__m256i zero_values;
+	__m128i lower_sums_128bit;
+	__m128i upper_sums_128bit;
+
+	static char *function   = "libewf_checksum_calculate_adler32_avx2";
+	size_t number_of_blocks = 0;
+	uint32_t lower_word     = 0;
+	uint32_t upper_word     = 0;
+
+	if( checksum_value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid checksum value.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	lower_word = ( initial_value & 0xffff ) % LIBEWF_CHECKSUM_ADLER32_BASE;
+	upper_word = ( ( initial_value >> 16 ) & 0xffff ) % LIBEWF_CHECKSUM_ADLER32_BASE;
+
+	/* Byte i of a 32-byte block contributes ( 32 - i ) times to the upper word
+	 */
+	weights = _mm256_setr_epi8(
+	           32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17,
+	           16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1 );
+
+	one_values  = _mm256_set1_epi16( 1 );
+	zero_values = _mm256_setzero_si256();
+
+	while( size >= 32 )
+	{
+		number_of_blocks = size / 32;
+
+		if( number_of_blocks > ( LIBEWF_CHECKSUM_ADLER32_MAXIMUM_BLOCK_SIZE / 32 ) )
+		{
+			number_of_blocks = LIBEWF_CHECKSUM_ADLER32_MAXIMUM_BLOCK_SIZE / 32;
+		}
+		size -= number_of_blocks * 32;
+
+		/* Every block adds 32 times the lower word at the start of the block to the upper word
+		 */
+		previous_lower_sums = _mm256_setr_epi32( (int) ( lower_word * number_of_blocks ), 0, 0, 0, 0, 0, 0, 0 );
+		lower_sums          = _mm256_setzero_si256();
+		upper_sums          = _mm256_setr_epi32( (int) upper_word, 0, 0, 0, 0, 0, 0, 0 );
+
+		while( number_of_blocks > 0 )
+		{
+			byte_values = _mm256_loadu_si256( (const __m256i *) buffer );
+
+			previous_lower_sums = _mm256_add_epi32( previous_lower_sums, lower_sums );
+
+			lower_sums = _mm256_add_epi32( lower_sums, _mm256_sad_epu8( byte_values, zero_values ) );
+			upper_sums = _mm256_add_epi32( upper_sums, _mm256_madd_epi16( _mm256_maddubs_epi16( byte_values, weights ), one_values ) );
+
+			buffer           += 32;
+			number_of_blocks -= 1;
+		}
+		upper_sums = _mm256_add_epi32( upper_sums, _mm256_slli_epi32( previous_lower_sums, 5 ) );
+
+		lower_sums_128bit = _mm_add_epi32( _mm256_castsi256_si128( lower_sums ), _mm256_extracti128_si256( lower_sums, 1 ) );
+		upper_sums_128bit = _mm_add_epi32( _mm256_castsi256_si128( upper_sums ), _mm256_extracti128_si256( upper_sums, 1 ) );
+
+		lower_sums_128bit = _mm_add_epi32( lower_sums_128bit, _mm_shuffle_epi32( lower_sums_128bit, 0x4e ) );
+		lower_sums_128bit = _mm_add_epi32( lower_sums_128bit, _mm_shuffle_epi32( lower_sums_128bit, 0xb1 ) );
+		upper_sums_128bit = _mm_add_epi32( upper_sums_128bit, _mm_shuffle_epi32( upper_sums_128bit, 0x4e ) );
+		upper_sums_128bit = _mm_add_epi32( upper_sums_128bit, _mm_shuffle_epi32( upper_sums_128bit, 0xb1 ) );
+
+		lower_word += (uint32_t) _mm_cvtsi128_si32( lower_sums_128bit );
+		upper_word  = (uint32_t) _mm_cvtsi128_si32( upper_sums_128bit );
+
+		lower_word %= LIBEWF_CHECKSUM_ADLER32_BASE;
+		upper_word %= LIBEWF_CHECKSUM_ADLER32_BASE;
+	}
+	*checksum_value = libewf_checksum_calculate_adler32_remainder(
+	                   lower_word,
+	                   upper_word,
+	                   buffer,
+	                   size );
+
+	return( 1 );
+}
+
+#endif /* defined( HAVE_LIBEWF_AVX2_SUPPORT ) */
+
+#if defined( HAVE_LIBEWF_NEON_SUPPORT )
+
+/* Calculates the little-endian Adler-32 of a buffer using NEON
+ * It uses the initial value to calculate a new Adler-32
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_checksum_calculate_adler32_neon(
+     uint32_t *checksum_value,
+     const uint8_t *buffer,
+     size_t size,
+     uint32_t initial_value,
+     libcerror_error_t **error )
+{
+	static const uint8_t weights[ 16 ] = {
+		16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1 };
+
+	uint32x4_t lower_sums;
+	uint32x4_t previous_lower_sums;
+	uint32x4_t upper_sums;
+	uint16x8_t weighted_values;
+	uint8x16_t byte_values;
+	uint8x8_t first_half_weights;
+	uint8x8_t second_half_weights;
+
+	static char *function   = "libewf_checksum_calculate_adler32_neon";
+	size_t number_of_blocks = 0;
+	uint32_t lower_word     = 0;
+	uint32_t upper_word     = 0;
+
+	if( checksum_value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid checksum value.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	lower_word = ( initial_value & 0xffff ) % LIBEWF_CHECKSUM_ADLER32_BASE;
+	upper_word = ( ( initial_value >> 16 ) & 0xffff ) % LIBEWF_CHECKSUM_ADLER32_BASE;
+
+	/* Byte i of a 16-byte block contributes ( 16 - i ) times to the upper word
+	 */
+	first_half_weights  = vld1_u8( &( weights[ 0 ] ) );
+	second_half_weights = vld1_u8( &( weights[ 8 ] ) );
+
+	while( size >= 16 )
+	{
+		number_of_blocks = size / 16;
+
+		if( number_of_blocks > ( LIBEWF_CHECKSUM_ADLER32_MAXIMUM_BLOCK_SIZE / 16 ) )
+		{
+			number_of_blocks = LIBEWF_CHECKSUM_ADLER32_MAXIMUM_BLOCK_SIZE / 16;
+		}
+		size -= number_of_blocks * 16;
+
+		/* Every block adds 16 times the lower word at the start of the block to the upper word
+		 */
+		previous_lower_sums = vsetq_lane_u32( (uint32_t) ( lower_word * number_of_blocks ), vdupq_n_u32( 0 ), 0 );
+		lower_sums          = vdupq_n_u32( 0 );
+		upper_sums          = vsetq_lane_u32( upper_word, vdupq_n_u32( 0 ), 0 );
+
+		while( number_of_blocks > 0 )
+		{
+			byte_values = vld1q_u8( buffer );
+
+			previous_lower_sums = vaddq_u32( previous_lower_sums, lower_sums );
+
+			lower_sums = vpadalq_u16( lower_sums, vpaddlq_u8( byte_values ) );
+
+			weighted_values = vmull_u8( vget_low_u8( byte_values ), first_half_weights );
+			weighted_values = vmlal_u8( weighted_values, vget_high_u8( byte_values ), second_half_weights );
+
+			upper_sums = vpadalq_u16( upper_sums, weighted_values );
+
+			buffer           += 16;
+			number_of_blocks -= 1;
+		}
+		upper_sums = vaddq_u32( upper_sums, vshlq_n_u32( previous_lower_sums, 4 ) );
+
+		lower_word += vaddvq_u32( lower_sums );
+		upper_word  = vaddvq_u32( upper_sums );
+
+		lower_word %= LIBEWF_CHECKSUM_ADLER32_BASE;
+		upper_word %= LIBEWF_CHECKSUM_ADLER32_BASE;
+	}
+	*checksum_value = libewf_checksum_calculate_adler32_remainder(
+	                   lower_word,
+	                   upper_word,
+	                   buffer,
+	                   size );
+
 	return( 1 );
 }
 
-#endif /* defined( HAVE_ZLIB_ADLER32 ) && ( defined( HAVE_ZLIB ) || defined( ZLIB_DLL ) ) */
+#endif /* defined( HAVE_LIBEWF_NEON_SUPPORT ) */
 
@@ -25,15 +25,13 @@
 #include <common.h>
 #include <types.h>
 
-#include "libewf_deflate.h"
+#include "libewf_cpu_features.h"
 #include "libewf_libcerror.h"
 
 #if defined( __cplusplus )
 extern "C" {
 #endif
 
-#if defined( HAVE_ZLIB_ADLER32 ) && ( defined( HAVE_ZLIB ) || defined( ZLIB_DLL ) )
-
 int libewf_checksum_calculate_adler32(
      uint32_t *checksum_value,
      const uint8_t *buffer,
@@ -41,11 +39,38 @@ int libewf_checksum_calculate_adler32(
      uint32_t initial_value,
      libcerror_error_t **error );
 
-#else
-#define libewf_checksum_calculate_adler32( checksum_value, buffer, size, initial_value, error ) \
-	libewf_deflate_calculate_adler32( checksum_value, buffer, size, initial_value, error )
+#if defined( HAVE_LIBEWF_SSE2_SUPPORT )
+
+int libewf_checksum_calculate_adler32_sse2(
+     uint32_t *checksum_value,
+     const uint8_t *buffer,
+     size_t size,
+     uint32_t initial_value,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_LIBEWF_SSE2_SUPPORT ) */
+
+#if defined( HAVE_LIBEWF_AVX2_SUPPORT )
+
+int libewf_checksum_calculate_adler32_avx2(
+     uint32_t *checksum_value,
+     const uint8_t *buffer,
+     size_t size,
+     uint32_t initial_value,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_LIBEWF_AVX2_SUPPORT ) */
+
+#if defined( HAVE_LIBEWF_NEON_SUPPORT )
+
+int libewf_checksum_calculate_adler32_neon(
+     uint32_t *checksum_value,
+     const uint8_t *buffer,
+     size_t size,
+     uint32_t initial_value,
+     libcerror_error_t **error );
 
-#endif /* defined( HAVE_ZLIB_ADLER32 ) && ( defined( HAVE_ZLIB ) || defined( ZLIB_DLL ) ) */
+#endif /* defined( HAVE_LIBEWF_NEON_SUPPORT ) */
 
 #if defined( __cplusplus )
 }
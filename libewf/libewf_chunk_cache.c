@@ -0,0 +1,1065 @@
+/*
+ * Chunk cache functions
+ *
+ * Copyright (C) 2006-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_chunk_cache.h"
+#include "libewf_chunk_cache_shard.h"
+#include "libewf_chunk_data.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+
+/* Creates a chunk cache
+ * Make sure the value chunk_cache is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_initialize(
+     libewf_chunk_cache_t **chunk_cache,
+     int number_of_shards,
+     size64_t maximum_cache_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_cache_initialize";
+	size_t shards_size    = 0;
+	int shard_index       = 0;
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk_cache != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid chunk cache value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_shards <= 0 )
+	 || ( number_of_shards > 1024 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of shards value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*chunk_cache = memory_allocate_structure(
+	                libewf_chunk_cache_t );
+
+	if( *chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create chunk cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *chunk_cache,
+	     0,
+	     sizeof( libewf_chunk_cache_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear chunk cache.",
+		 function );
+
+		memory_free(
+		 *chunk_cache );
+
+		*chunk_cache = NULL;
+
+		return( -1 );
+	}
+	shards_size = sizeof( libewf_chunk_cache_shard_t * ) * number_of_shards;
+
+	( *chunk_cache )->shards = (libewf_chunk_cache_shard_t **) memory_allocate(
+	                                                            shards_size );
+
+	if( ( *chunk_cache )->shards == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create shards.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *chunk_cache )->shards,
+	     0,
+	     shards_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear shards.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	shards_size = sizeof( libcthreads_mutex_t * ) * number_of_shards;
+
+	( *chunk_cache )->shard_mutexes = (libcthreads_mutex_t **) memory_allocate(
+	                                                            shards_size );
+
+	if( ( *chunk_cache )->shard_mutexes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create shard mutexes.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *chunk_cache )->shard_mutexes,
+	     0,
+	     shards_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear shard mutexes.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	( *chunk_cache )->maximum_cache_size = maximum_cache_size;
+	( *chunk_cache )->number_of_shards   = number_of_shards;
+
+	for( shard_index = 0;
+	     shard_index < number_of_shards;
+	     shard_index++ )
+	{
+		if( libewf_chunk_cache_shard_initialize(
+		     &( ( *chunk_cache )->shards[ shard_index ] ),
+		     maximum_cache_size / number_of_shards,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create shard: %d.",
+			 function,
+			 shard_index );
+
+			goto on_error;
+		}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_initialize(
+		     &( ( *chunk_cache )->shard_mutexes[ shard_index ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create shard: %d mutex.",
+			 function,
+			 shard_index );
+
+			goto on_error;
+		}
+#endif
+	}
+	return( 1 );
+
+on_error:
+	if( *chunk_cache != NULL )
+	{
+		libewf_chunk_cache_free(
+		 chunk_cache,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Frees a chunk cache
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_free(
+     libewf_chunk_cache_t **chunk_cache,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_cache_free";
+	int result            = 1;
+	int shard_index       = 0;
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk_cache != NULL )
+	{
+		for( shard_index = 0;
+		     shard_index < ( *chunk_cache )->number_of_shards;
+		     shard_index++ )
+		{
+			if( ( ( *chunk_cache )->shards != NULL )
+			 && ( ( *chunk_cache )->shards[ shard_index ] != NULL ) )
+			{
+				if( libewf_chunk_cache_shard_free(
+				     &( ( *chunk_cache )->shards[ shard_index ] ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free shard: %d.",
+					 function,
+					 shard_index );
+
+					result = -1;
+				}
+			}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+			if( ( ( *chunk_cache )->shard_mutexes != NULL )
+			 && ( ( *chunk_cache )->shard_mutexes[ shard_index ] != NULL ) )
+			{
+				if( libcthreads_mutex_free(
+				     &( ( *chunk_cache )->shard_mutexes[ shard_index ] ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free shard: %d mutex.",
+					 function,
+					 shard_index );
+
+					result = -1;
+				}
+			}
+#endif
+		}
+		if( ( *chunk_cache )->shards != NULL )
+		{
+			memory_free(
+			 ( *chunk_cache )->shards );
+		}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( ( *chunk_cache )->shard_mutexes != NULL )
+		{
+			memory_free(
+			 ( *chunk_cache )->shard_mutexes );
+		}
+#endif
+		memory_free(
+		 *chunk_cache );
+
+		*chunk_cache = NULL;
+	}
+	return( result );
+}
+
+/* Empties the chunk cache
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_empty(
+     libewf_chunk_cache_t *chunk_cache,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_cache_empty";
+	int result            = 1;
+	int shard_index       = 0;
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	for( shard_index = 0;
+	     shard_index < chunk_cache->number_of_shards;
+	     shard_index++ )
+	{
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_grab(
+		     chunk_cache->shard_mutexes[ shard_index ],
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab shard: %d mutex.",
+			 function,
+			 shard_index );
+
+			return( -1 );
+		}
+#endif
+		if( libewf_chunk_cache_shard_empty(
+		     chunk_cache->shards[ shard_index ],
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to empty shard: %d.",
+			 function,
+			 shard_index );
+
+			result = -1;
+		}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_release(
+		     chunk_cache->shard_mutexes[ shard_index ],
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release shard: %d mutex.",
+			 function,
+			 shard_index );
+
+			return( -1 );
+		}
+#endif
+	}
+	return( result );
+}
+
+/* Sets the maximum cache size
+ * Cached chunk data that no longer fits is evicted
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_set_maximum_size(
+     libewf_chunk_cache_t *chunk_cache,
+     size64_t maximum_cache_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_cache_set_maximum_size";
+	int result            = 1;
+	int shard_index       = 0;
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	chunk_cache->maximum_cache_size = maximum_cache_size;
+
+	for( shard_index = 0;
+	     shard_index < chunk_cache->number_of_shards;
+	     shard_index++ )
+	{
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_grab(
+		     chunk_cache->shard_mutexes[ shard_index ],
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab shard: %d mutex.",
+			 function,
+			 shard_index );
+
+			return( -1 );
+		}
+#endif
+		if( libewf_chunk_cache_shard_set_maximum_size(
+		     chunk_cache->shards[ shard_index ],
+		     maximum_cache_size / chunk_cache->number_of_shards,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set maximum size of shard: %d.",
+			 function,
+			 shard_index );
+
+			result = -1;
+		}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_release(
+		     chunk_cache->shard_mutexes[ shard_index ],
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release shard: %d mutex.",
+			 function,
+			 shard_index );
+
+			return( -1 );
+		}
+#endif
+	}
+	return( result );
+}
+
+/* Retrieves the number of cache hits and misses
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_get_statistics(
+     libewf_chunk_cache_t *chunk_cache,
+     uint64_t *number_of_hits,
+     uint64_t *number_of_misses,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_cache_get_statistics";
+	uint64_t safe_hits    = 0;
+	uint64_t safe_misses  = 0;
+	int shard_index       = 0;
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_hits == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of hits.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_misses == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of misses.",
+		 function );
+
+		return( -1 );
+	}
+	for( shard_index = 0;
+	     shard_index < chunk_cache->number_of_shards;
+	     shard_index++ )
+	{
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_grab(
+		     chunk_cache->shard_mutexes[ shard_index ],
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab shard: %d mutex.",
+			 function,
+			 shard_index );
+
+			return( -1 );
+		}
+#endif
+		safe_hits   += chunk_cache->shards[ shard_index ]->number_of_hits;
+		safe_misses += chunk_cache->shards[ shard_index ]->number_of_misses;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_release(
+		     chunk_cache->shard_mutexes[ shard_index ],
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release shard: %d mutex.",
+			 function,
+			 shard_index );
+
+			return( -1 );
+		}
+#endif
+	}
+	*number_of_hits   = safe_hits;
+	*number_of_misses = safe_misses;
+
+	return( 1 );
+}
+
+/* Retrieves the number of prefetched chunks that were read and that were evicted without being read
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_get_prefetch_statistics(
+     libewf_chunk_cache_t *chunk_cache,
+     uint64_t *number_of_hits,
+     uint64_t *number_of_wasted,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_cache_get_prefetch_statistics";
+	uint64_t safe_hits    = 0;
+	uint64_t safe_wasted  = 0;
+	int shard_index       = 0;
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_hits == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of hits.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_wasted == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of wasted.",
+		 function );
+
+		return( -1 );
+	}
+	for( shard_index = 0;
+	     shard_index < chunk_cache->number_of_shards;
+	     shard_index++ )
+	{
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_grab(
+		     chunk_cache->shard_mutexes[ shard_index ],
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab shard: %d mutex.",
+			 function,
+			 shard_index );
+
+			return( -1 );
+		}
+#endif
+		safe_hits   += chunk_cache->shards[ shard_index ]->number_of_prefetch_hits;
+		safe_wasted += chunk_cache->shards[ shard_index ]->number_of_wasted_prefetches;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_release(
+		     chunk_cache->shard_mutexes[ shard_index ],
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release shard: %d mutex.",
+			 function,
+			 shard_index );
+
+			return( -1 );
+		}
+#endif
+	}
+	*number_of_hits   = safe_hits;
+	*number_of_wasted = safe_wasted;
+
+	return( 1 );
+}
+
+/* Determines if the chunk data of a specific chunk is cached
+ * Returns 1 if cached, 0 if not or -1 on error
+ */
+int libewf_chunk_cache_has_chunk_data(
+     libewf_chunk_cache_t *chunk_cache,
+     uint64_t chunk_index,
+     libcerror_error_t **error )
+{
+	libewf_chunk_cache_entry_t *entry = NULL;
+	static char *function             = "libewf_chunk_cache_has_chunk_data";
+	int result                        = 0;
+	int shard_index                   = 0;
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	shard_index = (int) ( chunk_index % chunk_cache->number_of_shards );
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     chunk_cache->shard_mutexes[ shard_index ],
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab shard: %d mutex.",
+		 function,
+		 shard_index );
+
+		return( -1 );
+	}
+#endif
+	/* The entry is retrieved directly so that the cache statistics are not affected
+	 */
+	result = libewf_chunk_cache_shard_get_entry(
+	          chunk_cache->shards[ shard_index ],
+	          chunk_index,
+	          &entry,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve entry of chunk: %" PRIu64 " from shard: %d.",
+		 function,
+		 chunk_index,
+		 shard_index );
+	}
+	else if( ( result != 0 )
+	      && ( entry->chunk_data == NULL ) )
+	{
+		result = 0;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     chunk_cache->shard_mutexes[ shard_index ],
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release shard: %d mutex.",
+		 function,
+		 shard_index );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Copies the data of a cached chunk into a buffer
+ * Returns 1 if successful, 0 if the chunk is not cached or -1 on error
+ */
+int libewf_chunk_cache_copy_data(
+     libewf_chunk_cache_t *chunk_cache,
+     uint64_t chunk_index,
+     off64_t chunk_data_offset,
+     uint8_t *buffer,
+     size_t buffer_size,
+     size_t *read_size,
+     libcerror_error_t **error )
+{
+	libewf_chunk_data_t *chunk_data = NULL;
+	static char *function           = "libewf_chunk_cache_copy_data";
+	size_t safe_read_size           = 0;
+	int result                      = 0;
+	int shard_index                 = 0;
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_index > (uint64_t) INT64_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid chunk index value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid chunk data offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read size.",
+		 function );
+
+		return( -1 );
+	}
+	shard_index = (int) ( chunk_index % chunk_cache->number_of_shards );
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     chunk_cache->shard_mutexes[ shard_index ],
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab shard: %d mutex.",
+		 function,
+		 shard_index );
+
+		return( -1 );
+	}
+#endif
+	result = libewf_chunk_cache_shard_get_chunk_data(
+	          chunk_cache->shards[ shard_index ],
+	          chunk_index,
+	          &chunk_data,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk: %" PRIu64 " data from shard: %d.",
+		 function,
+		 chunk_index,
+		 shard_index );
+
+		goto on_error;
+	}
+	else if( result != 0 )
+	{
+		if( chunk_data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing chunk: %" PRIu64 " data.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+		if( (size64_t) chunk_data_offset > (size64_t) chunk_data->data_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: chunk: %" PRIu64 " offset exceeds data size.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+		safe_read_size = chunk_data->data_size - (size_t) chunk_data_offset;
+
+		if( safe_read_size > buffer_size )
+		{
+			safe_read_size = buffer_size;
+		}
+		if( safe_read_size > 0 )
+		{
+			if( memory_copy(
+			     buffer,
+			     &( ( chunk_data->data )[ chunk_data_offset ] ),
+			     safe_read_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy chunk: %" PRIu64 " data to buffer.",
+				 function,
+				 chunk_index );
+
+				goto on_error;
+			}
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     chunk_cache->shard_mutexes[ shard_index ],
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release shard: %d mutex.",
+		 function,
+		 shard_index );
+
+		return( -1 );
+	}
+#endif
+	*read_size = safe_read_size;
+
+	return( result );
+
+on_error:
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libcthreads_mutex_release(
+	 chunk_cache->shard_mutexes[ shard_index ],
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Sets the chunk data of a specific chunk in the cache
+ * The chunk cache takes over management of the chunk data, also on error
+ * If the chunk is already cached the chunk data is freed instead
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_set_chunk_data(
+     libewf_chunk_cache_t *chunk_cache,
+     uint64_t chunk_index,
+     libewf_chunk_data_t *chunk_data,
+     uint8_t is_prefetched,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_cache_set_chunk_data";
+	int result            = 0;
+	int shard_index       = 0;
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( chunk_index > (uint64_t) INT64_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid chunk index value exceeds maximum.",
+		 function );
+
+		goto on_error;
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	shard_index = (int) ( chunk_index % chunk_cache->number_of_shards );
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     chunk_cache->shard_mutexes[ shard_index ],
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab shard: %d mutex.",
+		 function,
+		 shard_index );
+
+		goto on_error;
+	}
+#endif
+	/* The shard frees the chunk data if another reader cached
+	 * the same chunk in the meantime
+	 */
+	result = libewf_chunk_cache_shard_set_chunk_data(
+	          chunk_cache->shards[ shard_index ],
+	          chunk_index,
+	          chunk_data,
+	          is_prefetched,
+	          error );
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set chunk: %" PRIu64 " data in shard: %d.",
+		 function,
+		 chunk_index,
+		 shard_index );
+
+		result = -1;
+	}
+	chunk_data = NULL;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     chunk_cache->shard_mutexes[ shard_index ],
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release shard: %d mutex.",
+		 function,
+		 shard_index );
+
+		result = -1;
+	}
+#endif
+	if( result == -1 )
+	{
+		return( -1 );
+	}
+	return( 1 );
+
+on_error:
+	if( chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 &chunk_data,
+		 NULL );
+	}
+	return( -1 );
+}
+
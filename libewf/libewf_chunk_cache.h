@@ -0,0 +1,123 @@
+/*
+ * Chunk cache functions
+ *
+ * Copyright (C) 2006-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_CHUNK_CACHE_H )
+#define _LIBEWF_CHUNK_CACHE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_chunk_cache_shard.h"
+#include "libewf_chunk_data.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libewf_chunk_cache libewf_chunk_cache_t;
+
+/* The chunk cache holds unpacked chunk data for concurrent readers
+ * The cache is split into shards by chunk index, each shard has its own lock
+ * so that readers of different chunks do not contend with each other
+ * The size of the cached chunk data is bounded by the maximum cache size
+ * which is divided evenly over the shards
+ */
+struct libewf_chunk_cache
+{
+	/* The maximum cache size
+	 */
+	size64_t maximum_cache_size;
+
+	/* The number of shards
+	 */
+	int number_of_shards;
+
+	/* The shards
+	 */
+	libewf_chunk_cache_shard_t **shards;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* The shard mutexes
+	 */
+	libcthreads_mutex_t **shard_mutexes;
+#endif
+};
+
+int libewf_chunk_cache_initialize(
+     libewf_chunk_cache_t **chunk_cache,
+     int number_of_shards,
+     size64_t maximum_cache_size,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_free(
+     libewf_chunk_cache_t **chunk_cache,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_empty(
+     libewf_chunk_cache_t *chunk_cache,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_set_maximum_size(
+     libewf_chunk_cache_t *chunk_cache,
+     size64_t maximum_cache_size,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_get_statistics(
+     libewf_chunk_cache_t *chunk_cache,
+     uint64_t *number_of_hits,
+     uint64_t *number_of_misses,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_get_prefetch_statistics(
+     libewf_chunk_cache_t *chunk_cache,
+     uint64_t *number_of_hits,
+     uint64_t *number_of_wasted,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_has_chunk_data(
+     libewf_chunk_cache_t *chunk_cache,
+     uint64_t chunk_index,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_copy_data(
+     libewf_chunk_cache_t *chunk_cache,
+     uint64_t chunk_index,
+     off64_t chunk_data_offset,
+     uint8_t *buffer,
+     size_t buffer_size,
+     size_t *read_size,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_set_chunk_data(
+     libewf_chunk_cache_t *chunk_cache,
+     uint64_t chunk_index,
+     libewf_chunk_data_t *chunk_data,
+     uint8_t is_prefetched,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_CHUNK_CACHE_H ) */
+
@@ -0,0 +1,1102 @@
+/*
+ * Chunk cache shard functions
+ *
+ * Copyright (C) 2006-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_chunk_cache_shard.h"
+#include "libewf_chunk_data.h"
+#include "libewf_definitions.h"
+#include "libewf_libcerror.h"
+
+/* Determines the hash bucket of a chunk index
+ * The chunk index is mixed since the shards are selected on its lower bits
+ */
+#define libewf_chunk_cache_shard_get_bucket_index( chunk_index, number_of_buckets ) \
+	(int) ( ( ( (uint32_t) ( ( chunk_index ) ^ ( ( chunk_index ) >> 32 ) ) * 2654435761UL ) \
+	        ^ ( ( (uint32_t) ( ( chunk_index ) ^ ( ( chunk_index ) >> 32 ) ) * 2654435761UL ) >> 16 ) ) \
+	      & (uint32_t) ( ( number_of_buckets ) - 1 ) )
+
+/* Removes an entry from a queue
+ */
+void libewf_chunk_cache_shard_remove_entry_from_queue(
+      libewf_chunk_cache_queue_t *queue,
+      libewf_chunk_cache_entry_t *entry )
+{
+	if( entry->previous_entry != NULL )
+	{
+		entry->previous_entry->next_entry = entry->next_entry;
+	}
+	else
+	{
+		queue->first_entry = entry->next_entry;
+	}
+	if( entry->next_entry != NULL )
+	{
+		entry->next_entry->previous_entry = entry->previous_entry;
+	}
+	else
+	{
+		queue->last_entry = entry->previous_entry;
+	}
+	entry->previous_entry = NULL;
+	entry->next_entry     = NULL;
+
+	queue->number_of_entries -= 1;
+	queue->size              -= entry->size;
+}
+
+/* Prepends an entry to a queue
+ */
+void libewf_chunk_cache_shard_prepend_entry_to_queue(
+      libewf_chunk_cache_queue_t *queue,
+      libewf_chunk_cache_entry_t *entry )
+{
+	entry->previous_entry = NULL;
+	entry->next_entry     = queue->first_entry;
+
+	if( queue->first_entry != NULL )
+	{
+		queue->first_entry->previous_entry = entry;
+	}
+	else
+	{
+		queue->last_entry = entry;
+	}
+	queue->first_entry = entry;
+
+	queue->number_of_entries += 1;
+	queue->size              += entry->size;
+}
+
+/* Retrieves the queue of a specific type
+ * Returns the queue or NULL if not available
+ */
+libewf_chunk_cache_queue_t *libewf_chunk_cache_shard_get_queue(
+                             libewf_chunk_cache_shard_t *chunk_cache_shard,
+                             uint8_t queue_type )
+{
+	switch( queue_type )
+	{
+		case LIBEWF_CHUNK_CACHE_QUEUE_TYPE_FIRST_IN:
+			return( &( chunk_cache_shard->first_in_queue ) );
+
+		case LIBEWF_CHUNK_CACHE_QUEUE_TYPE_MAIN:
+			return( &( chunk_cache_shard->main_queue ) );
+
+		case LIBEWF_CHUNK_CACHE_QUEUE_TYPE_GHOST:
+			return( &( chunk_cache_shard->ghost_queue ) );
+
+		default:
+			break;
+	}
+	return( NULL );
+}
+
+/* Creates a chunk cache shard
+ * Make sure the value chunk_cache_shard is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_shard_initialize(
+     libewf_chunk_cache_shard_t **chunk_cache_shard,
+     size64_t maximum_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_cache_shard_initialize";
+	size_t buckets_size   = 0;
+
+	if( chunk_cache_shard == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache shard.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk_cache_shard != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid chunk cache shard value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*chunk_cache_shard = memory_allocate_structure(
+	                      libewf_chunk_cache_shard_t );
+
+	if( *chunk_cache_shard == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create chunk cache shard.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *chunk_cache_shard,
+	     0,
+	     sizeof( libewf_chunk_cache_shard_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear chunk cache shard.",
+		 function );
+
+		memory_free(
+		 *chunk_cache_shard );
+
+		*chunk_cache_shard = NULL;
+
+		return( -1 );
+	}
+	buckets_size = sizeof( libewf_chunk_cache_entry_t * ) * LIBEWF_CHUNK_CACHE_SHARD_NUMBER_OF_BUCKETS;
+
+	( *chunk_cache_shard )->buckets = (libewf_chunk_cache_entry_t **) memory_allocate(
+	                                                                   buckets_size );
+
+	if( ( *chunk_cache_shard )->buckets == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buckets.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *chunk_cache_shard )->buckets,
+	     0,
+	     buckets_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear buckets.",
+		 function );
+
+		goto on_error;
+	}
+	( *chunk_cache_shard )->number_of_buckets = LIBEWF_CHUNK_CACHE_SHARD_NUMBER_OF_BUCKETS;
+	( *chunk_cache_shard )->maximum_size      = maximum_size;
+
+	return( 1 );
+
+on_error:
+	if( *chunk_cache_shard != NULL )
+	{
+		if( ( *chunk_cache_shard )->buckets != NULL )
+		{
+			memory_free(
+			 ( *chunk_cache_shard )->buckets );
+		}
+		memory_free(
+		 *chunk_cache_shard );
+
+		*chunk_cache_shard = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a chunk cache shard
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_shard_free(
+     libewf_chunk_cache_shard_t **chunk_cache_shard,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_cache_shard_free";
+	int result            = 1;
+
+	if( chunk_cache_shard == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache shard.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk_cache_shard != NULL )
+	{
+		if( libewf_chunk_cache_shard_empty(
+		     *chunk_cache_shard,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to empty chunk cache shard.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 ( *chunk_cache_shard )->buckets );
+
+		memory_free(
+		 *chunk_cache_shard );
+
+		*chunk_cache_shard = NULL;
+	}
+	return( result );
+}
+
+/* Empties a chunk cache shard
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_shard_empty(
+     libewf_chunk_cache_shard_t *chunk_cache_shard,
+     libcerror_error_t **error )
+{
+	libewf_chunk_cache_entry_t *entry      = NULL;
+	libewf_chunk_cache_entry_t *next_entry = NULL;
+	static char *function                  = "libewf_chunk_cache_shard_empty";
+	int bucket_index                       = 0;
+	int result                             = 1;
+
+	if( chunk_cache_shard == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache shard.",
+		 function );
+
+		return( -1 );
+	}
+	for( bucket_index = 0;
+	     bucket_index < chunk_cache_shard->number_of_buckets;
+	     bucket_index++ )
+	{
+		entry = chunk_cache_shard->buckets[ bucket_index ];
+
+		while( entry != NULL )
+		{
+			next_entry = entry->next_bucket_entry;
+
+			if( entry->chunk_data != NULL )
+			{
+				if( libewf_chunk_data_free(
+				     &( entry->chunk_data ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free chunk: %" PRIu64 " data.",
+					 function,
+					 entry->chunk_index );
+
+					result = -1;
+				}
+			}
+			memory_free(
+			 entry );
+
+			entry = next_entry;
+		}
+		chunk_cache_shard->buckets[ bucket_index ] = NULL;
+	}
+	chunk_cache_shard->number_of_entries = 0;
+
+	if( memory_set(
+	     &( chunk_cache_shard->first_in_queue ),
+	     0,
+	     sizeof( libewf_chunk_cache_queue_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear first-in queue.",
+		 function );
+
+		result = -1;
+	}
+	if( memory_set(
+	     &( chunk_cache_shard->main_queue ),
+	     0,
+	     sizeof( libewf_chunk_cache_queue_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear main queue.",
+		 function );
+
+		result = -1;
+	}
+	if( memory_set(
+	     &( chunk_cache_shard->ghost_queue ),
+	     0,
+	     sizeof( libewf_chunk_cache_queue_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear ghost queue.",
+		 function );
+
+		result = -1;
+	}
+	return( result );
+}
+
+/* Retrieves the entry of a specific chunk
+ * Returns 1 if successful, 0 if no such entry or -1 on error
+ */
+int libewf_chunk_cache_shard_get_entry(
+     libewf_chunk_cache_shard_t *chunk_cache_shard,
+     uint64_t chunk_index,
+     libewf_chunk_cache_entry_t **entry,
+     libcerror_error_t **error )
+{
+	libewf_chunk_cache_entry_t *safe_entry = NULL;
+	static char *function                  = "libewf_chunk_cache_shard_get_entry";
+	int bucket_index                       = 0;
+
+	if( chunk_cache_shard == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache shard.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry.",
+		 function );
+
+		return( -1 );
+	}
+	bucket_index = libewf_chunk_cache_shard_get_bucket_index(
+	                chunk_index,
+	                chunk_cache_shard->number_of_buckets );
+
+	safe_entry = chunk_cache_shard->buckets[ bucket_index ];
+
+	while( safe_entry != NULL )
+	{
+		if( safe_entry->chunk_index == chunk_index )
+		{
+			*entry = safe_entry;
+
+			return( 1 );
+		}
+		safe_entry = safe_entry->next_bucket_entry;
+	}
+	return( 0 );
+}
+
+/* Resizes the hash buckets
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_shard_resize_buckets(
+     libewf_chunk_cache_shard_t *chunk_cache_shard,
+     int number_of_buckets,
+     libcerror_error_t **error )
+{
+	libewf_chunk_cache_entry_t **buckets   = NULL;
+	libewf_chunk_cache_entry_t *entry      = NULL;
+	libewf_chunk_cache_entry_t *next_entry = NULL;
+	static char *function                  = "libewf_chunk_cache_shard_resize_buckets";
+	size_t buckets_size                    = 0;
+	int bucket_index                       = 0;
+	int new_bucket_index                   = 0;
+
+	if( chunk_cache_shard == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache shard.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_buckets <= 0 )
+	 || ( number_of_buckets > (int) ( MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( libewf_chunk_cache_entry_t * ) ) )
+	 || ( ( number_of_buckets & ( number_of_buckets - 1 ) ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of buckets value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	buckets_size = sizeof( libewf_chunk_cache_entry_t * ) * number_of_buckets;
+
+	buckets = (libewf_chunk_cache_entry_t **) memory_allocate(
+	                                           buckets_size );
+
+	if( buckets == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buckets.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     buckets,
+	     0,
+	     buckets_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear buckets.",
+		 function );
+
+		memory_free(
+		 buckets );
+
+		return( -1 );
+	}
+	for( bucket_index = 0;
+	     bucket_index < chunk_cache_shard->number_of_buckets;
+	     bucket_index++ )
+	{
+		entry = chunk_cache_shard->buckets[ bucket_index ];
+
+		while( entry != NULL )
+		{
+			next_entry = entry->next_bucket_entry;
+
+			new_bucket_index = libewf_chunk_cache_shard_get_bucket_index(
+			                    entry->chunk_index,
+			                    number_of_buckets );
+
+			entry->next_bucket_entry    = buckets[ new_bucket_index ];
+			buckets[ new_bucket_index ] = entry;
+
+			entry = next_entry;
+		}
+	}
+	memory_free(
+	 chunk_cache_shard->buckets );
+
+	chunk_cache_shard->buckets           = buckets;
+	chunk_cache_shard->number_of_buckets = number_of_buckets;
+
+	return( 1 );
+}
+
+/* Removes an entry from the shard and frees it
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_shard_remove_entry(
+     libewf_chunk_cache_shard_t *chunk_cache_shard,
+     libewf_chunk_cache_entry_t *entry,
+     libcerror_error_t **error )
+{
+	libewf_chunk_cache_entry_t **bucket_entry = NULL;
+	libewf_chunk_cache_queue_t *queue         = NULL;
+	static char *function                     = "libewf_chunk_cache_shard_remove_entry";
+	int bucket_index                          = 0;
+	int result                                = 1;
+
+	if( chunk_cache_shard == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache shard.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry.",
+		 function );
+
+		return( -1 );
+	}
+	queue = libewf_chunk_cache_shard_get_queue(
+	         chunk_cache_shard,
+	         entry->queue_type );
+
+	if( queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported entry queue type: %" PRIu8 ".",
+		 function,
+		 entry->queue_type );
+
+		return( -1 );
+	}
+	libewf_chunk_cache_shard_remove_entry_from_queue(
+	 queue,
+	 entry );
+
+	bucket_index = libewf_chunk_cache_shard_get_bucket_index(
+	                entry->chunk_index,
+	                chunk_cache_shard->number_of_buckets );
+
+	bucket_entry = &( chunk_cache_shard->buckets[ bucket_index ] );
+
+	while( *bucket_entry != NULL )
+	{
+		if( *bucket_entry == entry )
+		{
+			*bucket_entry = entry->next_bucket_entry;
+
+			break;
+		}
+		bucket_entry = &( ( *bucket_entry )->next_bucket_entry );
+	}
+	chunk_cache_shard->number_of_entries -= 1;
+
+	if( entry->chunk_data != NULL )
+	{
+		if( entry->is_prefetched != 0 )
+		{
+			chunk_cache_shard->number_of_wasted_prefetches += 1;
+		}
+		if( libewf_chunk_data_free(
+		     &( entry->chunk_data ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunk: %" PRIu64 " data.",
+			 function,
+			 entry->chunk_index );
+
+			result = -1;
+		}
+	}
+	memory_free(
+	 entry );
+
+	return( result );
+}
+
+/* Reclaims space by evicting entries until the cached chunk data fits the maximum size
+ * The most recently added entry is always kept so that a chunk that is larger
+ * than the maximum size can still be read in parts
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_shard_reclaim(
+     libewf_chunk_cache_shard_t *chunk_cache_shard,
+     libcerror_error_t **error )
+{
+	libewf_chunk_cache_entry_t *entry = NULL;
+	static char *function             = "libewf_chunk_cache_shard_reclaim";
+	size64_t first_in_maximum_size    = 0;
+	int maximum_number_of_ghosts      = 0;
+
+	if( chunk_cache_shard == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache shard.",
+		 function );
+
+		return( -1 );
+	}
+	first_in_maximum_size = chunk_cache_shard->maximum_size / LIBEWF_CHUNK_CACHE_FIRST_IN_QUEUE_DIVIDER;
+
+	while( ( chunk_cache_shard->first_in_queue.size + chunk_cache_shard->main_queue.size ) > chunk_cache_shard->maximum_size )
+	{
+		if( ( chunk_cache_shard->first_in_queue.number_of_entries + chunk_cache_shard->main_queue.number_of_entries ) <= 1 )
+		{
+			break;
+		}
+		if( ( chunk_cache_shard->main_queue.number_of_entries == 0 )
+		 || ( ( chunk_cache_shard->first_in_queue.number_of_entries > 0 )
+		  &&  ( chunk_cache_shard->first_in_queue.size > first_in_maximum_size ) ) )
+		{
+			/* Chunks evicted from the first-in queue are remembered in the ghost queue
+			 */
+			entry = chunk_cache_shard->first_in_queue.last_entry;
+
+			libewf_chunk_cache_shard_remove_entry_from_queue(
+			 &( chunk_cache_shard->first_in_queue ),
+			 entry );
+
+			if( libewf_chunk_data_free(
+			     &( entry->chunk_data ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free chunk: %" PRIu64 " data.",
+				 function,
+				 entry->chunk_index );
+
+				return( -1 );
+			}
+			if( entry->is_prefetched != 0 )
+			{
+				chunk_cache_shard->number_of_wasted_prefetches += 1;
+			}
+			entry->size          = 0;
+			entry->queue_type    = LIBEWF_CHUNK_CACHE_QUEUE_TYPE_GHOST;
+			entry->is_prefetched = 0;
+
+			libewf_chunk_cache_shard_prepend_entry_to_queue(
+			 &( chunk_cache_shard->ghost_queue ),
+			 entry );
+		}
+		else
+		{
+			if( libewf_chunk_cache_shard_remove_entry(
+			     chunk_cache_shard,
+			     chunk_cache_shard->main_queue.last_entry,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+				 "%s: unable to remove last entry of main queue.",
+				 function );
+
+				return( -1 );
+			}
+		}
+	}
+	/* The ghost queue remembers about half as many chunks as are cached
+	 */
+	maximum_number_of_ghosts = ( chunk_cache_shard->first_in_queue.number_of_entries + chunk_cache_shard->main_queue.number_of_entries ) / 2;
+
+	if( maximum_number_of_ghosts < 1 )
+	{
+		maximum_number_of_ghosts = 1;
+	}
+	while( chunk_cache_shard->ghost_queue.number_of_entries > maximum_number_of_ghosts )
+	{
+		if( libewf_chunk_cache_shard_remove_entry(
+		     chunk_cache_shard,
+		     chunk_cache_shard->ghost_queue.last_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+			 "%s: unable to remove last entry of ghost queue.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Sets the maximum size of the cached chunk data
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_shard_set_maximum_size(
+     libewf_chunk_cache_shard_t *chunk_cache_shard,
+     size64_t maximum_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_cache_shard_set_maximum_size";
+
+	if( chunk_cache_shard == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache shard.",
+		 function );
+
+		return( -1 );
+	}
+	chunk_cache_shard->maximum_size = maximum_size;
+
+	if( maximum_size == 0 )
+	{
+		if( libewf_chunk_cache_shard_empty(
+		     chunk_cache_shard,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to empty chunk cache shard.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	else if( libewf_chunk_cache_shard_reclaim(
+	          chunk_cache_shard,
+	          error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+		 "%s: unable to reclaim space in chunk cache shard.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the chunk data of a specific chunk
+ * Returns 1 if successful, 0 if the chunk is not cached or -1 on error
+ */
+int libewf_chunk_cache_shard_get_chunk_data(
+     libewf_chunk_cache_shard_t *chunk_cache_shard,
+     uint64_t chunk_index,
+     libewf_chunk_data_t **chunk_data,
+     libcerror_error_t **error )
+{
+	libewf_chunk_cache_entry_t *entry = NULL;
+	static char *function             = "libewf_chunk_cache_shard_get_chunk_data";
+	int result                        = 0;
+
+	if( chunk_cache_shard == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache shard.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	result = libewf_chunk_cache_shard_get_entry(
+	          chunk_cache_shard,
+	          chunk_index,
+	          &entry,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve entry of chunk: %" PRIu64 ".",
+		 function,
+		 chunk_index );
+
+		return( -1 );
+	}
+	if( ( result == 0 )
+	 || ( entry->chunk_data == NULL ) )
+	{
+		chunk_cache_shard->number_of_misses += 1;
+
+		return( 0 );
+	}
+	chunk_cache_shard->number_of_hits += 1;
+
+	if( entry->is_prefetched != 0 )
+	{
+		chunk_cache_shard->number_of_prefetch_hits += 1;
+
+		entry->is_prefetched = 0;
+	}
+
+	/* Chunks in the first-in queue keep their position so that
+	 * chunks that are read only during a short period do not get promoted
+	 */
+	if( entry->queue_type == LIBEWF_CHUNK_CACHE_QUEUE_TYPE_MAIN )
+	{
+		libewf_chunk_cache_shard_remove_entry_from_queue(
+		 &( chunk_cache_shard->main_queue ),
+		 entry );
+
+		libewf_chunk_cache_shard_prepend_entry_to_queue(
+		 &( chunk_cache_shard->main_queue ),
+		 entry );
+	}
+	*chunk_data = entry->chunk_data;
+
+	return( 1 );
+}
+
+/* Sets the chunk data of a specific chunk
+ * The chunk cache shard takes over management of the chunk data, also on error
+ * If the chunk is already cached the chunk data is freed instead
+ * Prefetched chunk data is not considered a repeated read of the chunk
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_shard_set_chunk_data(
+     libewf_chunk_cache_shard_t *chunk_cache_shard,
+     uint64_t chunk_index,
+     libewf_chunk_data_t *chunk_data,
+     uint8_t is_prefetched,
+     libcerror_error_t **error )
+{
+	libewf_chunk_cache_entry_t *entry = NULL;
+	static char *function             = "libewf_chunk_cache_shard_set_chunk_data";
+	size_t entry_size                 = 0;
+	int result                        = 0;
+
+	if( chunk_cache_shard == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache shard.",
+		 function );
+
+		goto on_error;
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	result = libewf_chunk_cache_shard_get_entry(
+	          chunk_cache_shard,
+	          chunk_index,
+	          &entry,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve entry of chunk: %" PRIu64 ".",
+		 function,
+		 chunk_index );
+
+		goto on_error;
+	}
+	if( ( chunk_cache_shard->maximum_size == 0 )
+	 || ( ( result != 0 )
+	  &&  ( entry->chunk_data != NULL ) ) )
+	{
+		if( libewf_chunk_data_free(
+		     &chunk_data,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunk: %" PRIu64 " data.",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+		return( 1 );
+	}
+	entry_size = sizeof( libewf_chunk_cache_entry_t ) + sizeof( libewf_chunk_data_t ) + chunk_data->allocated_data_size;
+
+	if( chunk_data->compressed_data != NULL )
+	{
+		entry_size += chunk_data->compressed_data_size;
+	}
+	if( result != 0 )
+	{
+		/* The chunk was recently evicted from the first-in queue
+		 * and is now considered frequently used
+		 */
+		libewf_chunk_cache_shard_remove_entry_from_queue(
+		 &( chunk_cache_shard->ghost_queue ),
+		 entry );
+	}
+	else
+	{
+		if( chunk_cache_shard->number_of_entries >= ( 2 * chunk_cache_shard->number_of_buckets ) )
+		{
+			if( libewf_chunk_cache_shard_resize_buckets(
+			     chunk_cache_shard,
+			     2 * chunk_cache_shard->number_of_buckets,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+				 "%s: unable to resize buckets.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		entry = memory_allocate_structure(
+		         libewf_chunk_cache_entry_t );
+
+		if( entry == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create entry.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_set(
+		     entry,
+		     0,
+		     sizeof( libewf_chunk_cache_entry_t ) ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear entry.",
+			 function );
+
+			memory_free(
+			 entry );
+
+			goto on_error;
+		}
+		entry->chunk_index = chunk_index;
+
+		result = libewf_chunk_cache_shard_get_bucket_index(
+		          chunk_index,
+		          chunk_cache_shard->number_of_buckets );
+
+		entry->next_bucket_entry              = chunk_cache_shard->buckets[ result ];
+		chunk_cache_shard->buckets[ result ] = entry;
+
+		chunk_cache_shard->number_of_entries += 1;
+
+		result = 0;
+	}
+	entry->chunk_data    = chunk_data;
+	entry->size          = entry_size;
+	entry->is_prefetched = is_prefetched;
+
+	if( ( result != 0 )
+	 && ( is_prefetched == 0 ) )
+	{
+		entry->queue_type = LIBEWF_CHUNK_CACHE_QUEUE_TYPE_MAIN;
+
+		libewf_chunk_cache_shard_prepend_entry_to_queue(
+		 &( chunk_cache_shard->main_queue ),
+		 entry );
+	}
+	else
+	{
+		entry->queue_type = LIBEWF_CHUNK_CACHE_QUEUE_TYPE_FIRST_IN;
+
+		libewf_chunk_cache_shard_prepend_entry_to_queue(
+		 &( chunk_cache_shard->first_in_queue ),
+		 entry );
+	}
+	if( libewf_chunk_cache_shard_reclaim(
+	     chunk_cache_shard,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+		 "%s: unable to reclaim space in chunk cache shard.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+
+on_error:
+	if( chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 &chunk_data,
+		 NULL );
+	}
+	return( -1 );
+}
+
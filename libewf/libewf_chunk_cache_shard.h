@@ -0,0 +1,218 @@
+/*
+ * Chunk cache shard functions
+ *
+ * Copyright (C) 2006-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_CHUNK_CACHE_SHARD_H )
+#define _LIBEWF_CHUNK_CACHE_SHARD_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_chunk_data.h"
+#include "libewf_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libewf_chunk_cache_entry libewf_chunk_cache_entry_t;
+
+struct libewf_chunk_cache_entry
+{
+	/* The chunk index
+	 */
+	uint64_t chunk_index;
+
+	/* The chunk data
+	 * NULL if the entry only records that the chunk was recently evicted
+	 */
+	libewf_chunk_data_t *chunk_data;
+
+	/* The size of the entry
+	 */
+	size_t size;
+
+	/* The queue type
+	 */
+	uint8_t queue_type;
+
+	/* Value to indicate the chunk data was prefetched and has not been read yet
+	 */
+	uint8_t is_prefetched;
+
+	/* The previous entry in the queue
+	 */
+	libewf_chunk_cache_entry_t *previous_entry;
+
+	/* The next entry in the queue
+	 */
+	libewf_chunk_cache_entry_t *next_entry;
+
+	/* The next entry in the hash bucket
+	 */
+	libewf_chunk_cache_entry_t *next_bucket_entry;
+};
+
+typedef struct libewf_chunk_cache_queue libewf_chunk_cache_queue_t;
+
+struct libewf_chunk_cache_queue
+{
+	/* The first (most recent) entry
+	 */
+	libewf_chunk_cache_entry_t *first_entry;
+
+	/* The last (least recent) entry
+	 */
+	libewf_chunk_cache_entry_t *last_entry;
+
+	/* The number of entries
+	 */
+	int number_of_entries;
+
+	/* The size of the entries
+	 */
+	size64_t size;
+};
+
+typedef struct libewf_chunk_cache_shard libewf_chunk_cache_shard_t;
+
+/* The chunk cache shard uses the 2Q replacement policy
+ * Chunks that are read for the first time are added to the first-in queue,
+ * when evicted from there their chunk index is remembered in the ghost queue.
+ * Only chunks that are read again while in the ghost queue are added to
+ * the main queue, which is managed as least recently used, so that a single
+ * large scan does not flush the chunks that are read repeatedly.
+ */
+struct libewf_chunk_cache_shard
+{
+	/* The maximum size of the cached chunk data
+	 */
+	size64_t maximum_size;
+
+	/* The hash buckets
+	 */
+	libewf_chunk_cache_entry_t **buckets;
+
+	/* The number of hash buckets
+	 */
+	int number_of_buckets;
+
+	/* The number of entries, including ghost entries
+	 */
+	int number_of_entries;
+
+	/* The first-in queue
+	 */
+	libewf_chunk_cache_queue_t first_in_queue;
+
+	/* The main queue
+	 */
+	libewf_chunk_cache_queue_t main_queue;
+
+	/* The ghost queue
+	 */
+	libewf_chunk_cache_queue_t ghost_queue;
+
+	/* The number of cache hits
+	 */
+	uint64_t number_of_hits;
+
+	/* The number of cache misses
+	 */
+	uint64_t number_of_misses;
+
+	/* The number of prefetched chunks that were read
+	 */
+	uint64_t number_of_prefetch_hits;
+
+	/* The number of prefetched chunks that were evicted without being read
+	 */
+	uint64_t number_of_wasted_prefetches;
+};
+
+void libewf_chunk_cache_shard_remove_entry_from_queue(
+      libewf_chunk_cache_queue_t *queue,
+      libewf_chunk_cache_entry_t *entry );
+
+void libewf_chunk_cache_shard_prepend_entry_to_queue(
+      libewf_chunk_cache_queue_t *queue,
+      libewf_chunk_cache_entry_t *entry );
+
+libewf_chunk_cache_queue_t *libewf_chunk_cache_shard_get_queue(
+                             libewf_chunk_cache_shard_t *chunk_cache_shard,
+                             uint8_t queue_type );
+
+int libewf_chunk_cache_shard_initialize(
+     libewf_chunk_cache_shard_t **chunk_cache_shard,
+     size64_t maximum_size,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_shard_free(
+     libewf_chunk_cache_shard_t **chunk_cache_shard,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_shard_empty(
+     libewf_chunk_cache_shard_t *chunk_cache_shard,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_shard_get_entry(
+     libewf_chunk_cache_shard_t *chunk_cache_shard,
+     uint64_t chunk_index,
+     libewf_chunk_cache_entry_t **entry,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_shard_resize_buckets(
+     libewf_chunk_cache_shard_t *chunk_cache_shard,
+     int number_of_buckets,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_shard_remove_entry(
+     libewf_chunk_cache_shard_t *chunk_cache_shard,
+     libewf_chunk_cache_entry_t *entry,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_shard_reclaim(
+     libewf_chunk_cache_shard_t *chunk_cache_shard,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_shard_set_maximum_size(
+     libewf_chunk_cache_shard_t *chunk_cache_shard,
+     size64_t maximum_size,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_shard_get_chunk_data(
+     libewf_chunk_cache_shard_t *chunk_cache_shard,
+     uint64_t chunk_index,
+     libewf_chunk_data_t **chunk_data,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_shard_set_chunk_data(
+     libewf_chunk_cache_shard_t *chunk_cache_shard,
+     uint64_t chunk_index,
+     libewf_chunk_data_t *chunk_data,
+     uint8_t is_prefetched,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_CHUNK_CACHE_SHARD_H ) */
+
@@ -27,6 +27,10 @@
 #include "libewf_checksum.h"
 #include "libewf_chunk_data.h"
 #include "libewf_compression.h"
+#include "libewf_compression_context.h"
+#include "libewf_compression_context_pool.h"
+#include "libewf_compression_estimator.h"
+#include "libewf_cpu_features.h"
 #include "libewf_definitions.h"
 #include "libewf_libbfio.h"
 #include "libewf_libcerror.h"
@@ -35,6 +39,18 @@
 #include "libewf_types.h"
 #include "libewf_unused.h"
 
+#if defined( HAVE_LIBEWF_SSE2_SUPPORT ) || defined( HAVE_LIBEWF_AVX2_SUPPORT )
+#include <immintrin.h>
+#endif
+
+#if defined( HAVE_LIBEWF_NEON_SUPPORT )
+#if defined( _MSC_VER )
+#include <arm64_neon.h>
+#else
+#include <arm_neon.h>
+#endif
+#endif
+
 #if !defined( LIBEWF_ATTRIBUTE_FALLTHROUGH )
 #if defined( __GNUC__ ) && __GNUC__ >= 7
 #define LIBEWF_ATTRIBUTE_FALLTHROUGH	__attribute__ ((fallthrough))
@@ -569,10 +585,11 @@ int libewf_chunk_data_pack_with_64_bit_pattern_fill(
 
 		return( -1 );
 	}
-	chunk_data->compressed_data_size = 8;
+	chunk_data->compressed_data_size           = 8;
+	chunk_data->allocated_compressed_data_size = 8;
 
 	chunk_data->compressed_data = (uint8_t *) memory_allocate(
-	                                           sizeof( uint8_t ) * chunk_data->compressed_data_size );
+	                                           sizeof( uint8_t ) * chunk_data->allocated_compressed_data_size );
 
 	if( chunk_data->compressed_data == NULL )
 	{
@@ -611,7 +628,8 @@ on_error:
 
 		chunk_data->compressed_data = NULL;
 	}
-	chunk_data->compressed_data_size = 0;
+	chunk_data->allocated_compressed_data_size = 0;
+	chunk_data->compressed_data_size           = 0;
 
 	return( -1 );
 }
@@ -678,8 +696,10 @@ int libewf_chunk_data_pack_with_empty_block_compression(
 	{
 		chunk_data->compressed_data_size += 16 - ( compressed_zero_byte_empty_block_size % 16 );
 	}
+	chunk_data->allocated_compressed_data_size = chunk_data->compressed_data_size;
+
 	chunk_data->compressed_data = (uint8_t *) memory_allocate(
-	                                           sizeof( uint8_t ) * chunk_data->compressed_data_size );
+	                                           sizeof( uint8_t ) * chunk_data->allocated_compressed_data_size );
 
 	if( chunk_data->compressed_data == NULL )
 	{
@@ -706,6 +726,25 @@ int libewf_chunk_data_pack_with_empty_block_compression(
 
 		goto on_error;
 	}
+	/* Clear the padding so the data written does not depend on previous allocations
+	 */
+	if( chunk_data->compressed_data_size > compressed_zero_byte_empty_block_size )
+	{
+		if( memory_set(
+		     &( chunk_data->compressed_data[ compressed_zero_byte_empty_block_size ] ),
+		     0,
+		     chunk_data->compressed_data_size - compressed_zero_byte_empty_block_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear compressed chunk data padding.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	byte_stream_copy_to_uint32_little_endian(
 	 &( compressed_zero_byte_empty_block[ compressed_zero_byte_empty_block_size - 4 ] ),
 	 chunk_data->checksum );
@@ -722,7 +761,8 @@ on_error:
 
 		chunk_data->compressed_data = NULL;
 	}
-	chunk_data->compressed_data_size = 0;
+	chunk_data->allocated_compressed_data_size = 0;
+	chunk_data->compressed_data_size           = 0;
 
 	return( -1 );
 }
@@ -735,10 +775,11 @@ int libewf_chunk_data_pack_with_compression(
      libewf_io_handle_t *io_handle,
      libcerror_error_t **error )
 {
-	static char *function            = "libewf_chunk_data_pack_with_compression";
-	size_t safe_compressed_data_size = 0;
-	int8_t compression_level         = 0;
-	int result                       = 0;
+	libewf_compression_context_t *compression_context = NULL;
+	static char *function                             = "libewf_chunk_data_pack_with_compression";
+	size_t safe_compressed_data_size                  = 0;
+	int8_t compression_level                          = 0;
+	int result                                        = 0;
 
 	if( chunk_data == NULL )
 	{
@@ -785,8 +826,6 @@ int libewf_chunk_data_pack_with_compression(
 
 		return( -1 );
 	}
-/* TODO add a light weight entropy test to assess if compression makes sense */
-
 	chunk_data->compressed_data_size = chunk_data->chunk_size;
 
 	/* EWF-S01 allows to have compressed chunks larger than the chunk size, a factor 2 should suffice
@@ -795,19 +834,52 @@ int libewf_chunk_data_pack_with_compression(
 	{
 		chunk_data->compressed_data_size *= 2;
 	}
-	chunk_data->compressed_data = (uint8_t *) memory_allocate(
-	                                           sizeof( uint8_t ) * chunk_data->compressed_data_size );
+	/* Allocate the compressed data the same way as the data, so that the buffers
+	 * are interchangeable and there is room for the alignment padding
+	 */
+	chunk_data->allocated_compressed_data_size = chunk_data->compressed_data_size + 4;
 
-	if( chunk_data->compressed_data == NULL )
+	if( ( chunk_data->allocated_compressed_data_size % 16 ) != 0 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-		 "%s: unable to create compressed data.",
-		 function );
+		chunk_data->allocated_compressed_data_size += 16;
+	}
+	chunk_data->allocated_compressed_data_size = ( chunk_data->allocated_compressed_data_size / 16 ) * 16;
 
-		goto on_error;
+	if( io_handle->compression_context_pool != NULL )
+	{
+		if( libewf_compression_context_pool_grab_buffer(
+		     io_handle->compression_context_pool,
+		     chunk_data->allocated_compressed_data_size,
+		     &( chunk_data->compressed_data ),
+		     &( chunk_data->allocated_compressed_data_size ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to grab compressed data buffer from pool.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	else
+	{
+		chunk_data->compressed_data = (uint8_t *) memory_allocate(
+		                                           sizeof( uint8_t ) * chunk_data->allocated_compressed_data_size );
+
+		if( chunk_data->compressed_data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create compressed data.",
+			 function );
+
+			goto on_error;
+		}
 	}
 	safe_compressed_data_size = chunk_data->compressed_data_size;
 
@@ -820,15 +892,58 @@ int libewf_chunk_data_pack_with_compression(
 	{
 		compression_level = LIBEWF_COMPRESSION_LEVEL_DEFAULT;
 	}
-	result = libewf_compress_data(
-		  chunk_data->compressed_data,
-		  &safe_compressed_data_size,
-		  io_handle->compression_method,
-		  compression_level,
-		  chunk_data->data,
-		  chunk_data->data_size,
-		  error );
+	if( io_handle->compression_context_pool != NULL )
+	{
+		if( libewf_compression_context_pool_grab_context(
+		     io_handle->compression_context_pool,
+		     &compression_context,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to grab compression context from pool.",
+			 function );
 
+			goto on_error;
+		}
+		result = libewf_compression_context_compress_data(
+		          compression_context,
+		          chunk_data->compressed_data,
+		          &safe_compressed_data_size,
+		          io_handle->compression_method,
+		          compression_level,
+		          chunk_data->data,
+		          chunk_data->data_size,
+		          error );
+
+		if( libewf_compression_context_pool_release_context(
+		     io_handle->compression_context_pool,
+		     &compression_context,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release compression context to pool.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	else
+	{
+		result = libewf_compress_data(
+			  chunk_data->compressed_data,
+			  &safe_compressed_data_size,
+			  io_handle->compression_method,
+			  compression_level,
+			  chunk_data->data,
+			  chunk_data->data_size,
+			  error );
+	}
 	if( result == -1 )
 	{
 		libcerror_error_set(
@@ -886,6 +1001,13 @@ int libewf_chunk_data_pack_with_compression(
 	return( result );
 
 on_error:
+	if( compression_context != NULL )
+	{
+		libewf_compression_context_pool_release_context(
+		 io_handle->compression_context_pool,
+		 &compression_context,
+		 NULL );
+	}
 	if( chunk_data->compressed_data != NULL )
 	{
 		memory_free(
@@ -893,7 +1015,8 @@ on_error:
 
 		chunk_data->compressed_data = NULL;
 	}
-	chunk_data->compressed_data_size = 0;
+	chunk_data->allocated_compressed_data_size = 0;
+	chunk_data->compressed_data_size           = 0;
 
 	return( -1 );
 }
@@ -1010,58 +1133,153 @@ int libewf_chunk_data_pack(
 		}
 		else
 		{
-			result = libewf_chunk_data_pack_with_compression(
-			          chunk_data,
-			          io_handle,
-			          error );
-
-			if( result == -1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
-				 LIBCERROR_COMPRESSION_ERROR_COMPRESS_FAILED,
-				 "%s: unable to compress chunk data using compression.",
-				 function );
+			result = 1;
 
-				goto on_error;
-			}
-			else if( result != 0 )
+			/* Compression cannot be skipped when it is forced
+			 */
+			if( ( ( pack_flags & LIBEWF_PACK_FLAG_FORCE_COMPRESSION ) == 0 )
+			 && ( io_handle->compression_estimator != NULL ) )
 			{
-				/* Use the compressed data if it is smaller than the uncompressed data or when compression is forced
-				 */
-				if( ( ( pack_flags & LIBEWF_PACK_FLAG_FORCE_COMPRESSION ) != 0 )
-				 || ( chunk_data->compressed_data_size < chunk_data->data_size ) )
+				result = libewf_compression_estimator_check_data(
+				          io_handle->compression_estimator,
+				          io_handle->compression_flags,
+				          chunk_data->data,
+				          chunk_data->data_size,
+				          error );
+
+				if( result == -1 )
 				{
-					chunk_data->range_flags = LIBEWF_RANGE_FLAG_IS_COMPRESSED;
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GENERIC,
+					 "%s: unable to determine if chunk data should be compressed.",
+					 function );
+
+					goto on_error;
 				}
 			}
-			else if( ( pack_flags & LIBEWF_PACK_FLAG_FORCE_COMPRESSION ) != 0 )
+			if( result != 0 )
 			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
-				 LIBCERROR_COMPRESSION_ERROR_COMPRESS_FAILED,
-				 "%s: unable to compress chunk data - compression was forced but compressed data is too small.",
-				 function );
+				result = libewf_chunk_data_pack_with_compression(
+				          chunk_data,
+				          io_handle,
+				          error );
 
-				goto on_error;
+				if( result == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+					 LIBCERROR_COMPRESSION_ERROR_COMPRESS_FAILED,
+					 "%s: unable to compress chunk data using compression.",
+					 function );
+
+					goto on_error;
+				}
+				else if( result != 0 )
+				{
+					/* Use the compressed data if it is smaller than the uncompressed data or when compression is forced
+					 */
+					if( ( ( pack_flags & LIBEWF_PACK_FLAG_FORCE_COMPRESSION ) != 0 )
+					 || ( chunk_data->compressed_data_size < chunk_data->data_size ) )
+					{
+						chunk_data->range_flags = LIBEWF_RANGE_FLAG_IS_COMPRESSED;
+					}
+				}
+				else if( ( pack_flags & LIBEWF_PACK_FLAG_FORCE_COMPRESSION ) != 0 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+					 LIBCERROR_COMPRESSION_ERROR_COMPRESS_FAILED,
+					 "%s: unable to compress chunk data - compression was forced but compressed data is too small.",
+					 function );
+
+					goto on_error;
+				}
+				if( ( ( pack_flags & LIBEWF_PACK_FLAG_FORCE_COMPRESSION ) == 0 )
+				 && ( io_handle->compression_estimator != NULL ) )
+				{
+					if( libewf_compression_estimator_update(
+					     io_handle->compression_estimator,
+					     io_handle->compression_flags,
+					     (uint8_t) ( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_COMPRESSED ) != 0 ),
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+						 "%s: unable to update compression estimator.",
+						 function );
+
+						goto on_error;
+					}
+				}
 			}
 		}
 	}
+	if( ( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_COMPRESSED ) == 0 )
+	 && ( chunk_data->compressed_data != NULL )
+	 && ( io_handle->compression_context_pool != NULL ) )
+	{
+		/* The compressed data is not used, hand its buffer to the next chunk
+		 */
+		if( libewf_compression_context_pool_release_buffer(
+		     io_handle->compression_context_pool,
+		     &( chunk_data->compressed_data ),
+		     chunk_data->allocated_compressed_data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release compressed data buffer to pool.",
+			 function );
+
+			goto on_error;
+		}
+		chunk_data->compressed_data_size           = 0;
+		chunk_data->allocated_compressed_data_size = 0;
+	}
 	if( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_COMPRESSED ) != 0 )
 	{
 		if( ( chunk_data->flags & LIBEWF_CHUNK_DATA_ITEM_FLAG_MANAGED_DATA ) != 0 )
 		{
-			memory_free(
-			 chunk_data->data );
+			if( io_handle->compression_context_pool != NULL )
+			{
+				if( libewf_compression_context_pool_release_buffer(
+				     io_handle->compression_context_pool,
+				     &( chunk_data->data ),
+				     chunk_data->allocated_data_size,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to release data buffer to pool.",
+					 function );
+
+					goto on_error;
+				}
+			}
+			else
+			{
+				memory_free(
+				 chunk_data->data );
+			}
 		}
-		chunk_data->data      = chunk_data->compressed_data;
-		chunk_data->data_size = chunk_data->compressed_data_size;
-		chunk_data->flags     = LIBEWF_CHUNK_DATA_ITEM_FLAG_MANAGED_DATA;
+		chunk_data->data                = chunk_data->compressed_data;
+		chunk_data->data_size           = chunk_data->compressed_data_size;
+		chunk_data->allocated_data_size = chunk_data->allocated_compressed_data_size;
+		chunk_data->flags               = LIBEWF_CHUNK_DATA_ITEM_FLAG_MANAGED_DATA;
 
-		chunk_data->compressed_data      = NULL;
-		chunk_data->compressed_data_size = 0;
+		chunk_data->compressed_data                = NULL;
+		chunk_data->compressed_data_size           = 0;
+		chunk_data->allocated_compressed_data_size = 0;
 	}
 	else if( ( pack_flags & LIBEWF_PACK_FLAG_CALCULATE_CHECKSUM ) != 0 )
 	{
@@ -1142,7 +1360,8 @@ on_error:
 
 		chunk_data->compressed_data = NULL;
 	}
-	chunk_data->compressed_data_size = 0;
+	chunk_data->allocated_compressed_data_size = 0;
+	chunk_data->compressed_data_size           = 0;
 
 	return( -1 );
 }
@@ -1156,9 +1375,12 @@ int libewf_chunk_data_unpack(
      libewf_io_handle_t *io_handle,
      libcerror_error_t **error )
 {
-	static char *function        = "libewf_chunk_data_unpack";
-	size_t remaining_chunk_size  = 0;
-	uint32_t calculated_checksum = 0;
+	libewf_compression_context_t *compression_context = NULL;
+	static char *function                             = "libewf_chunk_data_unpack";
+	size_t compressed_allocated_data_size             = 0;
+	size_t remaining_chunk_size                       = 0;
+	uint32_t calculated_checksum                      = 0;
+	int result                                        = 0;
 
 	if( chunk_data == NULL )
 	{
@@ -1222,6 +1444,8 @@ int libewf_chunk_data_unpack(
 
 			return( -1 );
 		}
+		compressed_allocated_data_size = chunk_data->allocated_data_size;
+
 		chunk_data->compressed_data      = chunk_data->data;
 		chunk_data->compressed_data_size = chunk_data->data_size;
 
@@ -1237,19 +1461,43 @@ int libewf_chunk_data_unpack(
 		}
 		chunk_data->allocated_data_size = ( chunk_data->allocated_data_size / 16 ) * 16;
 
-		chunk_data->data = (uint8_t *) memory_allocate(
-		                                sizeof( uint8_t ) * chunk_data->allocated_data_size );
+		if( io_handle->compression_context_pool != NULL )
+		{
+			chunk_data->data = NULL;
+
+			if( libewf_compression_context_pool_grab_buffer(
+			     io_handle->compression_context_pool,
+			     chunk_data->allocated_data_size,
+			     &( chunk_data->data ),
+			     &( chunk_data->allocated_data_size ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to grab data buffer from pool.",
+				 function );
 
-		if( chunk_data->data == NULL )
+				goto on_error;
+			}
+		}
+		else
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-			 "%s: unable to create data.",
-			 function );
+			chunk_data->data = (uint8_t *) memory_allocate(
+			                                sizeof( uint8_t ) * chunk_data->allocated_data_size );
 
-			goto on_error;
+			if( chunk_data->data == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to create data.",
+				 function );
+
+				goto on_error;
+			}
 		}
 		if( memory_set(
 		     chunk_data->data,
@@ -1327,13 +1575,57 @@ int libewf_chunk_data_unpack(
 		}
 		else
 		{
-			if( libewf_decompress_data(
-			     chunk_data->compressed_data,
-			     chunk_data->compressed_data_size,
-			     io_handle->compression_method,
-			     chunk_data->data,
-			     &( chunk_data->data_size ),
-			     error ) != 1 )
+			if( io_handle->compression_context_pool != NULL )
+			{
+				if( libewf_compression_context_pool_grab_context(
+				     io_handle->compression_context_pool,
+				     &compression_context,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to grab compression context from pool.",
+					 function );
+
+					goto on_error;
+				}
+				result = libewf_compression_context_decompress_data(
+				          compression_context,
+				          chunk_data->compressed_data,
+				          chunk_data->compressed_data_size,
+				          io_handle->compression_method,
+				          chunk_data->data,
+				          &( chunk_data->data_size ),
+				          error );
+
+				if( libewf_compression_context_pool_release_context(
+				     io_handle->compression_context_pool,
+				     &compression_context,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to release compression context to pool.",
+					 function );
+
+					goto on_error;
+				}
+			}
+			else
+			{
+				result = libewf_decompress_data(
+				          chunk_data->compressed_data,
+				          chunk_data->compressed_data_size,
+				          io_handle->compression_method,
+				          chunk_data->data,
+				          &( chunk_data->data_size ),
+				          error );
+			}
+			if( result != 1 )
 			{
 				libcerror_error_set(
 				 error,
@@ -1360,6 +1652,28 @@ int libewf_chunk_data_unpack(
 				chunk_data->range_flags |= LIBEWF_RANGE_FLAG_IS_CORRUPTED;
 			}
 		}
+		if( ( io_handle->compression_context_pool != NULL )
+		 && ( ( chunk_data->flags & LIBEWF_CHUNK_DATA_ITEM_FLAG_MANAGED_DATA ) != 0 ) )
+		{
+			/* The compressed data is no longer needed, hand its buffer to the next chunk
+			 */
+			if( libewf_compression_context_pool_release_buffer(
+			     io_handle->compression_context_pool,
+			     &( chunk_data->compressed_data ),
+			     compressed_allocated_data_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to release compressed data buffer to pool.",
+				 function );
+
+				goto on_error;
+			}
+			chunk_data->compressed_data_size = 0;
+		}
 	}
 	else if( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_HAS_CHECKSUM ) != 0 )
 	{
@@ -1451,6 +1765,13 @@ int libewf_chunk_data_unpack(
 	return( 1 );
 
 on_error:
+	if( compression_context != NULL )
+	{
+		libewf_compression_context_pool_release_context(
+		 io_handle->compression_context_pool,
+		 &compression_context,
+		 NULL );
+	}
 	if( chunk_data->compressed_data != NULL )
 	{
 		if( chunk_data->data != NULL )
@@ -1458,8 +1779,9 @@ on_error:
 			memory_free(
 			 chunk_data->data );
 		}
-		chunk_data->data      = chunk_data->compressed_data;
-		chunk_data->data_size = chunk_data->compressed_data_size;
+		chunk_data->data                = chunk_data->compressed_data;
+		chunk_data->data_size           = chunk_data->compressed_data_size;
+		chunk_data->allocated_data_size = compressed_allocated_data_size;
 
 		chunk_data->compressed_data      = NULL;
 		chunk_data->compressed_data_size = 0;
@@ -1476,6 +1798,7 @@ int libewf_chunk_data_check_for_empty_block(
      libcerror_error_t **error )
 {
 	static char *function = "libewf_chunk_data_check_for_empty_block";
+	uint64_t pattern      = 0;
 
 	if( data == NULL )
 	{
@@ -1507,14 +1830,14 @@ int libewf_chunk_data_check_for_empty_block(
 	{
 		return( 1 );
 	}
-	if( memory_compare(
-	     data,
-	     &( data[ 1 ] ),
-	     data_size - 1 ) != 0 )
-	{
-		return( 0 );
-	}
-	return( 1 );
+	/* Repeat the first byte in every byte of the pattern
+	 */
+	pattern = (uint64_t) data[ 0 ] * 0x0101010101010101ULL;
+
+	return( libewf_chunk_data_compare_with_64_bit_pattern(
+	         data,
+	         data_size,
+	         pattern ) );
 }
 
 /* Checks if a buffer containing the chunk data is filled with a 64-bit pattern
@@ -1526,11 +1849,8 @@ int libewf_chunk_data_check_for_64_bit_pattern_fill(
      uint64_t *pattern,
      libcerror_error_t **error )
 {
-	libewf_aligned_t *aligned_data_index = NULL;
-	libewf_aligned_t *aligned_data_start = NULL;
-	uint8_t *data_index                  = NULL;
-	uint8_t *data_start                  = NULL;
-	static char *function                = "libewf_chunk_data_check_for_64_bit_pattern_fill";
+	static char *function = "libewf_chunk_data_check_for_64_bit_pattern_fill";
+	uint64_t safe_pattern = 0;
 
 	if( data == NULL )
 	{
@@ -1570,71 +1890,288 @@ int libewf_chunk_data_check_for_64_bit_pattern_fill(
 	{
 		return( 0 );
 	}
-	data_start = (uint8_t *) data;
-	data_index = (uint8_t *) data + 8;
-	data_size -= 8;
+	byte_stream_copy_to_uint64_little_endian(
+	 data,
+	 safe_pattern );
+
+	if( libewf_chunk_data_compare_with_64_bit_pattern(
+	     &( data[ 8 ] ),
+	     data_size - 8,
+	     safe_pattern ) == 0 )
+	{
+		return( 0 );
+	}
+	*pattern = safe_pattern;
 
-	/* Only optimize for data larger than the alignment
+	return( 1 );
+}
+
+/* Compares a buffer with a repeating 64-bit pattern
+ * The first byte of the buffer is compared with the least significant byte of the pattern
+ * The comparison uses the SIMD instructions supported by the CPU
+ * Returns 1 if the buffer contains the pattern or 0 if not
+ */
+int libewf_chunk_data_compare_with_64_bit_pattern(
+     const uint8_t *data,
+     size_t data_size,
+     uint64_t pattern )
+{
+	uint32_t cpu_features = 0;
+
+	cpu_features = libewf_cpu_features_get_flags();
+
+#if defined( HAVE_LIBEWF_AVX2_SUPPORT )
+	if( ( cpu_features & LIBEWF_CPU_FEATURE_FLAG_AVX2 ) != 0 )
+	{
+		return( libewf_chunk_data_compare_with_64_bit_pattern_avx2(
+		         data,
+		         data_size,
+		         pattern ) );
+	}
+#endif
+#if defined( HAVE_LIBEWF_SSE2_SUPPORT )
+	if( ( cpu_features & LIBEWF_CPU_FEATURE_FLAG_SSE2 ) != 0 )
+	{
+		return( libewf_chunk_data_compare_with_64_bit_pattern_sse2(
+		         data,
+		         data_size,
+		         pattern ) );
+	}
+#endif
+#if defined( HAVE_LIBEWF_NEON_SUPPORT )
+	if( ( cpu_features & LIBEWF_CPU_FEATURE_FLAG_NEON ) != 0 )
+	{
+		return( libewf_chunk_data_compare_with_64_bit_pattern_neon(
+		         data,
+		         data_size,
+		         pattern ) );
+	}
+#endif
+	return( libewf_chunk_data_compare_with_64_bit_pattern_scalar(
+	         data,
+	         data_size,
+	         pattern ) );
+}
+
+/* Compares a buffer with a repeating 64-bit pattern without using SIMD instructions
+ * Returns 1 if the buffer contains the pattern or 0 if not
+ */
+int libewf_chunk_data_compare_with_64_bit_pattern_scalar(
+     const uint8_t *data,
+     size_t data_size,
+     uint64_t pattern )
+{
+	uint64_t value_64bit = 0;
+
+	while( data_size >= 8 )
+	{
+		byte_stream_copy_to_uint64_little_endian(
+		 data,
+		 value_64bit );
+
+		if( value_64bit != pattern )
+		{
+			return( 0 );
+		}
+		data      += 8;
+		data_size -= 8;
+	}
+	while( data_size > 0 )
+	{
+		if( *data != (uint8_t) ( pattern & 0xff ) )
+		{
+			return( 0 );
+		}
+		pattern >>= 8;
+
+		data      += 1;
+		data_size -= 1;
+	}
+	return( 1 );
+}
+
+#if defined( HAVE_LIBEWF_SSE2_SUPPORT )
+
+/* Compares a buffer with a repeating 64-bit pattern using SSE2
+ * Returns 1 if the buffer contains the pattern or 0 if not
+ */
+LIBEWF_ATTRIBUTE_TARGET_SSE2
+int libewf_chunk_data_compare_with_64_bit_pattern_sse2(
+     const uint8_t *data,
+     size_t data_size,
+     uint64_t pattern )
+{
+	__m128i difference_values;
+	__m128i pattern_values;
+	__m128i zero_values;
+
+	pattern_values = _mm_set_epi32(
+	                  (int) ( pattern >> 32 ),
+	                  (int) ( pattern & 0xffffffffUL ),
+	                  (int) ( pattern >> 32 ),
+	                  (int) ( pattern & 0xffffffffUL ) );
+
+	zero_values = _mm_setzero_si128();
+
+	/* Check 64 bytes per iteration to reduce the number of branches
 	 */
-	if( data_size > ( sizeof( libewf_aligned_t ) + sizeof( libewf_aligned_t ) ) )
+	while( data_size >= 64 )
 	{
-		/* Align the data start
-		 */
-		while( ( (intptr_t) data_start % sizeof( libewf_aligned_t ) ) != 0 )
+		difference_values = _mm_or_si128(
+		                     _mm_or_si128(
+		                      _mm_xor_si128( _mm_loadu_si128( (const __m128i *) data ), pattern_values ),
+		                      _mm_xor_si128( _mm_loadu_si128( (const __m128i *) &( data[ 16 ] ) ), pattern_values ) ),
+		                     _mm_or_si128(
+		                      _mm_xor_si128( _mm_loadu_si128( (const __m128i *) &( data[ 32 ] ) ), pattern_values ),
+		                      _mm_xor_si128( _mm_loadu_si128( (const __m128i *) &( data[ 48 ] ) ), pattern_values ) ) );
+
+		if( _mm_movemask_epi8( _mm_cmpeq_epi8( difference_values, zero_values ) ) != 0xffff )
 		{
-			if( *data_start != *data_index )
-			{
-				return( 0 );
-			}
-			data_start++;
-			data_index++;
-			data_size--;
+			return( 0 );
 		}
-		/* Align the data index
-		 */
-		while( ( (intptr_t) data_index % sizeof( libewf_aligned_t ) ) != 0 )
+		data      += 64;
+		data_size -= 64;
+	}
+	while( data_size >= 16 )
+	{
+		difference_values = _mm_xor_si128( _mm_loadu_si128( (const __m128i *) data ), pattern_values );
+
+		if( _mm_movemask_epi8( _mm_cmpeq_epi8( difference_values, zero_values ) ) != 0xffff )
 		{
-			if( *data_start != *data_index )
-			{
-				return( 0 );
-			}
-			data_index++;
-			data_size--;
+			return( 0 );
 		}
-		aligned_data_start = (libewf_aligned_t *) data_start;
-		aligned_data_index = (libewf_aligned_t *) data_index;
+		data      += 16;
+		data_size -= 16;
+	}
+	/* The pattern is still aligned with the data since 16 is a multiple of 8
+	 */
+	return( libewf_chunk_data_compare_with_64_bit_pattern_scalar(
+	         data,
+	         data_size,
+	         pattern ) );
+}
 
-		while( data_size > sizeof( libewf_aligned_t ) )
+#endif /* defined( HAVE_LIBEWF_SSE2_SUPPORT ) */
+
+#if defined( HAVE_LIBEWF_AVX2_SUPPORT )
+
+/* Compares a buffer with a repeating 64-bit pattern using AVX2
+ * Returns 1 if the buffer contains the pattern or 0 if not
+ */
+LIBEWF_ATTRIBUTE_TARGET_AVX2
+int libewf_chunk_data_compare_with_64_bit_pattern_avx2(
+     const uint8_t *data,
+     size_t data_size,
+     uint64_t pattern )
+{
+	__m256i difference_values;
+	__m256i pattern_values;
+
+	pattern_values = _mm256_set_epi32(
+	                  (int) ( pattern >> 32 ),
+	                  (int) ( pattern & 0xffffffffUL ),
+	                  (int) ( pattern >> 32 ),
+	                  (int) ( pattern & 0xffffffffUL ),
+	                  (int) ( pattern >> 32 ),
+	                  (int) ( pattern & 0xffffffffUL ),
+	                  (int) ( pattern >> 32 ),
+	                  (int) ( pattern & 0xffffffffUL ) );
+
+	/* Check 128 bytes per iteration to reduce the number of branches
+	 */
+	while( data_size >= 128 )
+	{
+		difference_values = _mm256_or_si256(
+		                     _mm256_or_si256(
+		                      _mm256_xor_si256( _mm256_loadu_si256( (const __m256i *) data ), pattern_values ),
+		                      _mm256_xor_si256( _mm256_loadu_si256( (const __m256i *) &( data[ 32 ] ) ), pattern_values ) ),
+		                     _mm256_or_si256(
+		                      _mm256_xor_si256( _mm256_loadu_si256( (const __m256i *) &( data[ 64 ] ) ), pattern_values ),
+		                      _mm256_xor_si256( _mm256_loadu_si256( (const __m256i *) &( data[ 96 ] ) ), pattern_values ) ) );
+
+		if( _mm256_testz_si256( difference_values, difference_values ) == 0 )
 		{
-			if( *aligned_data_start != *aligned_data_index )
-			{
-				return( 0 );
-			}
-			aligned_data_start++;
-			aligned_data_index++;
+			return( 0 );
+		}
+		data      += 128;
+		data_size -= 128;
+	}
+	while( data_size >= 32 )
+	{
+		difference_values = _mm256_xor_si256( _mm256_loadu_si256( (const __m256i *) data ), pattern_values );
 
-			data_size -= sizeof( libewf_aligned_t );
+		if( _mm256_testz_si256( difference_values, difference_values ) == 0 )
+		{
+			return( 0 );
 		}
-		data_start = (uint8_t *) aligned_data_start;
-		data_index = (uint8_t *) aligned_data_index;
+		data      += 32;
+		data_size -= 32;
 	}
-	while( data_size != 0 )
+	/* The pattern is still aligned with the data since 32 is a multiple of 8
+	 */
+	return( libewf_chunk_data_compare_with_64_bit_pattern_scalar(
+	         data,
+	         data_size,
+	         pattern ) );
+}
+
+#endif /* defined( HAVE_LIBEWF_AVX2_SUPPORT ) */
+
+#if defined( HAVE_LIBEWF_NEON_SUPPORT )
+
+/* Compares a buffer with a repeating 64-bit pattern using NEON
+ * Returns 1 if the buffer contains the pattern or 0 if not
+ */
+int libewf_chunk_data_compare_with_64_bit_pattern_neon(
+     const uint8_t *data,
+     size_t data_size,
+     uint64_t pattern )
+{
+	uint8x16_t difference_values;
+	uint8x16_t pattern_values;
+
+	pattern_values = vreinterpretq_u8_u64( vdupq_n_u64( pattern ) );
+
+	/* Check 64 bytes per iteration to reduce the number of branches
+	 */
+	while( data_size >= 64 )
 	{
-		if( *data_start != *data_index )
+		difference_values = vorrq_u8(
+		                     vorrq_u8(
+		                      veorq_u8( vld1q_u8( data ), pattern_values ),
+		                      veorq_u8( vld1q_u8( &( data[ 16 ] ) ), pattern_values ) ),
+		                     vorrq_u8(
+		                      veorq_u8( vld1q_u8( &( data[ 32 ] ) ), pattern_values ),
+		                      veorq_u8( vld1q_u8( &( data[ 48 ] ) ), pattern_values ) ) );
+
+		if( vmaxvq_u8( difference_values ) != 0 )
 		{
 			return( 0 );
 		}
-		data_start++;
-		data_index++;
-		data_size--;
+		data      += 64;
+		data_size -= 64;
 	}
-	byte_stream_copy_to_uint64_little_endian(
-	 data,
-	 *pattern );
+	while( data_size >= 16 )
+	{
+		difference_values = veorq_u8( vld1q_u8( data ), pattern_values );
 
-	return( 1 );
+		if( vmaxvq_u8( difference_values ) != 0 )
+		{
+			return( 0 );
+		}
+		data      += 16;
+		data_size -= 16;
+	}
+	/* The pattern is still aligned with the data since 16 is a multiple of 8
+	 */
+	return( libewf_chunk_data_compare_with_64_bit_pattern_scalar(
+	         data,
+	         data_size,
+	         pattern ) );
 }
 
+#endif /* defined( HAVE_LIBEWF_NEON_SUPPORT ) */
+
 /* Writes a chunk
  * Returns 1 if successful or -1 on error
  */
@@ -1969,7 +2506,11 @@ ssize_t libewf_chunk_data_read_from_file_io_pool(
 
 		return( -1 );
 	}
-	read_count = libbfio_pool_read_buffer_at_offset(
+	/* The chunk data is read without changing the current offset of
+	 * the file IO pool entry, hence no seek is needed and the same
+	 * segment file can be read from multiple threads
+	 */
+	read_count = libbfio_pool_pread_buffer(
 		      file_io_pool,
 		      file_io_pool_entry,
 		      chunk_data->data,
@@ -1999,6 +2540,161 @@ ssize_t libewf_chunk_data_read_from_file_io_pool(
 	return( read_count );
 }
 
+/* Reads the chunk data of multiple chunks stored in the same file IO pool entry
+ * The chunks are read using a single vectored read
+ * Returns the total number of bytes read or -1 on error
+ */
+ssize_t libewf_chunk_data_read_vector_from_file_io_pool(
+         libewf_chunk_data_t **chunks_data,
+         int number_of_chunks,
+         libbfio_pool_t *file_io_pool,
+         int file_io_pool_entry,
+         off64_t *chunks_data_offset,
+         size64_t *chunks_data_size,
+         uint32_t *chunks_data_flags,
+         libcerror_error_t **error )
+{
+	libbfio_read_range_t ranges[ LIBEWF_MAXIMUM_NUMBER_OF_CHUNKS_PER_READ_VECTOR ];
+
+	static char *function = "libewf_chunk_data_read_vector_from_file_io_pool";
+	ssize_t read_count    = 0;
+	int chunk_number      = 0;
+
+	if( chunks_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunks data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_chunks <= 0 )
+	 || ( number_of_chunks > LIBEWF_MAXIMUM_NUMBER_OF_CHUNKS_PER_READ_VECTOR ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of chunks value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunks_data_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunks data offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunks_data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunks data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunks_data_flags == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunks data flags.",
+		 function );
+
+		return( -1 );
+	}
+	for( chunk_number = 0;
+	     chunk_number < number_of_chunks;
+	     chunk_number++ )
+	{
+		if( chunks_data[ chunk_number ] == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+			 "%s: invalid chunk data: %d.",
+			 function,
+			 chunk_number );
+
+			return( -1 );
+		}
+		if( ( chunks_data_size[ chunk_number ] == (size64_t) 0 )
+		 || ( chunks_data_size[ chunk_number ] > (size64_t) chunks_data[ chunk_number ]->allocated_data_size ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid chunk data: %d size value out of bounds.",
+			 function,
+			 chunk_number );
+
+			return( -1 );
+		}
+		ranges[ chunk_number ].offset     = chunks_data_offset[ chunk_number ];
+		ranges[ chunk_number ].buffer     = chunks_data[ chunk_number ]->data;
+		ranges[ chunk_number ].size       = (size_t) chunks_data_size[ chunk_number ];
+		ranges[ chunk_number ].read_count = 0;
+	}
+	read_count = libbfio_pool_read_vector(
+	              file_io_pool,
+	              file_io_pool_entry,
+	              ranges,
+	              number_of_chunks,
+	              error );
+
+	if( read_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read chunks data in file IO pool entry: %d.",
+		 function,
+		 file_io_pool_entry );
+
+		return( -1 );
+	}
+	for( chunk_number = 0;
+	     chunk_number < number_of_chunks;
+	     chunk_number++ )
+	{
+		if( ranges[ chunk_number ].read_count != (ssize_t) chunks_data_size[ chunk_number ] )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read chunk data at offset: %" PRIi64 " (0x%08" PRIx64 ") in file IO pool entry: %d.",
+			 function,
+			 chunks_data_offset[ chunk_number ],
+			 chunks_data_offset[ chunk_number ],
+			 file_io_pool_entry );
+
+			return( -1 );
+		}
+		chunks_data[ chunk_number ]->data_size = (size_t) ranges[ chunk_number ].read_count;
+
+		chunks_data[ chunk_number ]->range_flags = ( chunks_data_flags[ chunk_number ] | LIBEWF_RANGE_FLAG_IS_PACKED )
+		                                         & ~( LIBEWF_RANGE_FLAG_IS_TAINTED | LIBEWF_RANGE_FLAG_IS_CORRUPTED );
+	}
+	return( read_count );
+}
+
 /* Reads chunk data
  * Callback function for the chunks list
  * Returns 1 if successful or -1 on error
@@ -25,6 +25,7 @@
 #include <common.h>
 #include <types.h>
 
+#include "libewf_cpu_features.h"
 #include "libewf_io_handle.h"
 #include "libewf_libbfio.h"
 #include "libewf_libcerror.h"
@@ -58,6 +59,10 @@ struct libewf_chunk_data
 	 */
 	size_t data_size;
 
+	/* The allocated compressed data size
+	 */
+	size_t allocated_compressed_data_size;
+
 	/* The compressed data
 	 */
 	uint8_t *compressed_data;
@@ -166,6 +171,43 @@ int libewf_chunk_data_check_for_64_bit_pattern_fill(
      uint64_t *pattern,
      libcerror_error_t **error );
 
+int libewf_chunk_data_compare_with_64_bit_pattern(
+     const uint8_t *data,
+     size_t data_size,
+     uint64_t pattern );
+
+int libewf_chunk_data_compare_with_64_bit_pattern_scalar(
+     const uint8_t *data,
+     size_t data_size,
+     uint64_t pattern );
+
+#if defined( HAVE_LIBEWF_SSE2_SUPPORT )
+
+int libewf_chunk_data_compare_with_64_bit_pattern_sse2(
+     const uint8_t *data,
+     size_t data_size,
+     uint64_t pattern );
+
+#endif /* defined( HAVE_LIBEWF_SSE2_SUPPORT ) */
+
+#if defined( HAVE_LIBEWF_AVX2_SUPPORT )
+
+int libewf_chunk_data_compare_with_64_bit_pattern_avx2(
+     const uint8_t *data,
+     size_t data_size,
+     uint64_t pattern );
+
+#endif /* defined( HAVE_LIBEWF_AVX2_SUPPORT ) */
+
+#if defined( HAVE_LIBEWF_NEON_SUPPORT )
+
+int libewf_chunk_data_compare_with_64_bit_pattern_neon(
+     const uint8_t *data,
+     size_t data_size,
+     uint64_t pattern );
+
+#endif /* defined( HAVE_LIBEWF_NEON_SUPPORT ) */
+
 ssize_t libewf_chunk_data_write(
          libewf_chunk_data_t *chunk_data,
          libbfio_pool_t *file_io_pool,
@@ -192,6 +234,16 @@ ssize_t libewf_chunk_data_read_from_file_io_pool(
          uint32_t chunk_data_flags,
          libcerror_error_t **error );
 
+ssize_t libewf_chunk_data_read_vector_from_file_io_pool(
+         libewf_chunk_data_t **chunks_data,
+         int number_of_chunks,
+         libbfio_pool_t *file_io_pool,
+         int file_io_pool_entry,
+         off64_t *chunks_data_offset,
+         size64_t *chunks_data_size,
+         uint32_t *chunks_data_flags,
+         libcerror_error_t **error );
+
 int libewf_chunk_data_read_element_data(
      libewf_io_handle_t *io_handle,
      libbfio_pool_t *file_io_pool,
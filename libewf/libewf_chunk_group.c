@@ -114,47 +114,591 @@ int libewf_chunk_group_initialize(
 
 		return( -1 );
 	}
-	if( libfdata_list_initialize(
-	     &( ( *chunk_group )->chunks_list ),
-	     (intptr_t *) io_handle,
-	     NULL,
-	     NULL,
-	     (int (*)(intptr_t *, intptr_t *, libfdata_list_element_t *, libfdata_cache_t *, int, off64_t, size64_t, uint32_t, uint8_t, libcerror_error_t **)) &libewf_chunk_data_read_element_data,
-	     NULL,
-	     LIBFDATA_DATA_HANDLE_FLAG_NON_MANAGED,
+	if( libfcache_date_time_get_timestamp(
+	     &( ( *chunk_group )->timestamp ),
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create chunks list.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve cache timestamp.",
+		 function );
+
+		goto on_error;
+	}
+	( *chunk_group )->io_handle          = io_handle;
+	( *chunk_group )->file_io_pool_entry = -1;
+
+	return( 1 );
+
+on_error:
+	if( *chunk_group != NULL )
+	{
+		memory_free(
+		 *chunk_group );
+
+		*chunk_group = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a chunk group
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_group_free(
+     libewf_chunk_group_t **chunk_group,
+     libcerror_error_t **error )
+{
+        static char *function = "libewf_chunk_group_free";
+
+	if( chunk_group == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk group.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk_group != NULL )
+	{
+		if( ( *chunk_group )->chunks_range_flags != NULL )
+		{
+			memory_free(
+			 ( *chunk_group )->chunks_range_flags );
+		}
+		if( ( *chunk_group )->chunks_data_sizes != NULL )
+		{
+			memory_free(
+			 ( *chunk_group )->chunks_data_sizes );
+		}
+		if( ( *chunk_group )->chunks_data_offsets != NULL )
+		{
+			memory_free(
+			 ( *chunk_group )->chunks_data_offsets );
+		}
+		memory_free(
+		 *chunk_group );
+
+		*chunk_group = NULL;
+	}
+	return( 1 );
+}
+
+/* Clones the chunk group
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_group_clone(
+     libewf_chunk_group_t **destination_chunk_group,
+     libewf_chunk_group_t *source_chunk_group,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_group_clone";
+
+	if( destination_chunk_group == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid destination chunk group.",
+		 function );
+
+		return( -1 );
+	}
+	if( *destination_chunk_group != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid destination chunk group already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( source_chunk_group == NULL )
+	{
+		*destination_chunk_group = NULL;
+
+		return( 1 );
+	}
+	*destination_chunk_group = memory_allocate_structure(
+		                    libewf_chunk_group_t );
+
+	if( *destination_chunk_group == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create destination chunk group.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_copy(
+	     *destination_chunk_group,
+	     source_chunk_group,
+	     sizeof( libewf_chunk_group_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy source to destination chunk group.",
+		 function );
+
+		memory_free(
+		 *destination_chunk_group );
+
+		*destination_chunk_group = NULL;
+
+		return( -1 );
+	}
+	( *destination_chunk_group )->chunks_data_offsets        = NULL;
+	( *destination_chunk_group )->chunks_data_sizes          = NULL;
+	( *destination_chunk_group )->chunks_range_flags         = NULL;
+	( *destination_chunk_group )->number_of_chunks           = 0;
+	( *destination_chunk_group )->number_of_allocated_chunks = 0;
+
+	if( source_chunk_group->number_of_chunks > 0 )
+	{
+		if( libewf_chunk_group_resize(
+		     *destination_chunk_group,
+		     source_chunk_group->number_of_chunks,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+			 "%s: unable to resize destination chunk group.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_copy(
+		     ( *destination_chunk_group )->chunks_data_offsets,
+		     source_chunk_group->chunks_data_offsets,
+		     sizeof( off64_t ) * source_chunk_group->number_of_chunks ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy chunks data offsets.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_copy(
+		     ( *destination_chunk_group )->chunks_data_sizes,
+		     source_chunk_group->chunks_data_sizes,
+		     sizeof( uint32_t ) * source_chunk_group->number_of_chunks ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy chunks data sizes.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_copy(
+		     ( *destination_chunk_group )->chunks_range_flags,
+		     source_chunk_group->chunks_range_flags,
+		     sizeof( uint16_t ) * source_chunk_group->number_of_chunks ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy chunks range flags.",
+			 function );
+
+			goto on_error;
+		}
+		( *destination_chunk_group )->number_of_chunks = source_chunk_group->number_of_chunks;
+	}
+	return( 1 );
+
+on_error:
+	if( *destination_chunk_group != NULL )
+	{
+		libewf_chunk_group_free(
+		 destination_chunk_group,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Empties a chunk group
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_group_empty(
+     libewf_chunk_group_t *chunk_group,
+     libcerror_error_t **error )
+{
+        static char *function = "libewf_chunk_group_empty";
+
+	if( chunk_group == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk group.",
+		 function );
+
+		return( -1 );
+	}
+	chunk_group->number_of_chunks   = 0;
+	chunk_group->file_io_pool_entry = -1;
+
+	return( 1 );
+}
+
+/* Resizes the chunk group to contain at least a specific number of chunks
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_group_resize(
+     libewf_chunk_group_t *chunk_group,
+     int number_of_chunks,
+     libcerror_error_t **error )
+{
+	void *reallocation    = NULL;
+	static char *function = "libewf_chunk_group_resize";
+
+	if( chunk_group == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk group.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_chunks <= 0 )
+	 || ( (size_t) number_of_chunks > ( MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( off64_t ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of chunks value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_chunks <= chunk_group->number_of_allocated_chunks )
+	{
+		return( 1 );
+	}
+	reallocation = memory_reallocate(
+	                chunk_group->chunks_data_offsets,
+	                sizeof( off64_t ) * number_of_chunks );
+
+	if( reallocation == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to resize chunks data offsets.",
+		 function );
+
+		return( -1 );
+	}
+	chunk_group->chunks_data_offsets = (off64_t *) reallocation;
+
+	reallocation = memory_reallocate(
+	                chunk_group->chunks_data_sizes,
+	                sizeof( uint32_t ) * number_of_chunks );
+
+	if( reallocation == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to resize chunks data sizes.",
+		 function );
+
+		return( -1 );
+	}
+	chunk_group->chunks_data_sizes = (uint32_t *) reallocation;
+
+	reallocation = memory_reallocate(
+	                chunk_group->chunks_range_flags,
+	                sizeof( uint16_t ) * number_of_chunks );
+
+	if( reallocation == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to resize chunks range flags.",
+		 function );
+
+		return( -1 );
+	}
+	chunk_group->chunks_range_flags = (uint16_t *) reallocation;
+
+	chunk_group->number_of_allocated_chunks = number_of_chunks;
+
+	return( 1 );
+}
+
+/* Retrieves the number of chunks
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_group_get_number_of_chunks(
+     libewf_chunk_group_t *chunk_group,
+     int *number_of_chunks,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_group_get_number_of_chunks";
+
+	if( chunk_group == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk group.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_chunks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of chunks.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_chunks = chunk_group->number_of_chunks;
+
+	return( 1 );
+}
+
+/* Retrieves the data range of a specific chunk
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_group_get_chunk_data_range(
+     libewf_chunk_group_t *chunk_group,
+     int chunk_group_index,
+     int *file_io_pool_entry,
+     off64_t *chunk_data_offset,
+     size64_t *chunk_data_size,
+     uint32_t *range_flags,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_group_get_chunk_data_range";
+
+	if( chunk_group == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk group.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( chunk_group_index < 0 )
+	 || ( chunk_group_index >= chunk_group->number_of_chunks ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk group index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_pool_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO pool entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_flags == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range flags.",
+		 function );
+
+		return( -1 );
+	}
+	*file_io_pool_entry = chunk_group->file_io_pool_entry;
+	*chunk_data_offset  = chunk_group->chunks_data_offsets[ chunk_group_index ];
+	*chunk_data_size    = (size64_t) chunk_group->chunks_data_sizes[ chunk_group_index ];
+	*range_flags        = (uint32_t) chunk_group->chunks_range_flags[ chunk_group_index ];
+
+	return( 1 );
+}
+
+/* Sets the data range of a specific chunk
+ * All the chunks in a chunk group are stored in the same file IO pool entry
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_group_set_chunk_data_range(
+     libewf_chunk_group_t *chunk_group,
+     int chunk_group_index,
+     int file_io_pool_entry,
+     off64_t chunk_data_offset,
+     size64_t chunk_data_size,
+     uint32_t range_flags,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_group_set_chunk_data_range";
+
+	if( chunk_group == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk group.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( chunk_group_index < 0 )
+	 || ( chunk_group_index >= chunk_group->number_of_chunks ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk group index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_pool_entry != chunk_group->file_io_pool_entry )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid file IO pool entry value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk data offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data_size > (size64_t) UINT32_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid chunk data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_flags > (uint32_t) UINT16_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported range flags.",
+		 function );
+
+		return( -1 );
+	}
+	/* Update the timestamp so that previously cached chunk data
+	 * of the chunk group is no longer used
+	 */
+	if( libfcache_date_time_get_timestamp(
+	     &( chunk_group->timestamp ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve cache timestamp.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	return( 1 );
-
-on_error:
-	if( *chunk_group != NULL )
-	{
-		memory_free(
-		 *chunk_group );
+	chunk_group->chunks_data_offsets[ chunk_group_index ] = chunk_data_offset;
+	chunk_group->chunks_data_sizes[ chunk_group_index ]   = (uint32_t) chunk_data_size;
+	chunk_group->chunks_range_flags[ chunk_group_index ]  = (uint16_t) range_flags;
 
-		*chunk_group = NULL;
-	}
-	return( -1 );
+	return( 1 );
 }
 
-/* Frees a chunk group
+/* Retrieves the mapped range of a specific chunk relative to the start of the chunk group
  * Returns 1 if successful or -1 on error
  */
-int libewf_chunk_group_free(
-     libewf_chunk_group_t **chunk_group,
+int libewf_chunk_group_get_chunk_mapped_range(
+     libewf_chunk_group_t *chunk_group,
+     int chunk_group_index,
+     off64_t *mapped_range_offset,
+     size64_t *mapped_range_size,
      libcerror_error_t **error )
 {
-        static char *function = "libewf_chunk_group_free";
-	int result            = 1;
+	static char *function = "libewf_chunk_group_get_chunk_mapped_range";
 
 	if( chunk_group == NULL )
 	{
@@ -167,154 +711,238 @@ int libewf_chunk_group_free(
 
 		return( -1 );
 	}
-	if( *chunk_group != NULL )
+	if( ( chunk_group_index < 0 )
+	 || ( chunk_group_index >= chunk_group->number_of_chunks ) )
 	{
-		if( libfdata_list_free(
-		     &( ( *chunk_group )->chunks_list ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free chunks list.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk group index value out of bounds.",
+		 function );
 
-			result = -1;
-		}
-		memory_free(
-		 *chunk_group );
+		return( -1 );
+	}
+	if( mapped_range_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mapped range offset.",
+		 function );
 
-		*chunk_group = NULL;
+		return( -1 );
+	}
+	if( mapped_range_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mapped range size.",
+		 function );
+
+		return( -1 );
 	}
-	return( result );
+	*mapped_range_offset = (off64_t) chunk_group_index * chunk_group->chunk_size;
+	*mapped_range_size   = (size64_t) chunk_group->chunk_size;
+
+	return( 1 );
 }
 
-/* Clones the chunk group
+/* Retrieves the chunk data of a specific chunk
+ * The chunk data is read if it is not available in the cache
+ * The chunk data is managed by the cache
  * Returns 1 if successful or -1 on error
  */
-int libewf_chunk_group_clone(
-     libewf_chunk_group_t **destination_chunk_group,
-     libewf_chunk_group_t *source_chunk_group,
+int libewf_chunk_group_get_chunk_data(
+     libewf_chunk_group_t *chunk_group,
+     libbfio_pool_t *file_io_pool,
+     libfcache_cache_t *chunk_data_cache,
+     int chunk_group_index,
+     libewf_chunk_data_t **chunk_data,
+     uint8_t read_flags,
      libcerror_error_t **error )
 {
-	static char *function = "libewf_chunk_group_clone";
+	libewf_chunk_data_t *safe_chunk_data = NULL;
+	libfcache_cache_value_t *cache_value = NULL;
+	static char *function                = "libewf_chunk_group_get_chunk_data";
+	off64_t chunk_data_offset            = 0;
+	ssize_t read_count                   = 0;
+	uint16_t range_flags                 = 0;
+	int result                           = 0;
 
-	if( destination_chunk_group == NULL )
+	if( chunk_group == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid destination chunk group.",
+		 "%s: invalid chunk group.",
 		 function );
 
 		return( -1 );
 	}
-	if( *destination_chunk_group != NULL )
+	if( chunk_group->io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid destination chunk group already set.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid chunk group - missing IO handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( source_chunk_group == NULL )
-	{
-		*destination_chunk_group = NULL;
-
-		return( 1 );
-	}
-	*destination_chunk_group = memory_allocate_structure(
-		                    libewf_chunk_group_t );
-
-	if( *destination_chunk_group == NULL )
+	if( ( chunk_group_index < 0 )
+	 || ( chunk_group_index >= chunk_group->number_of_chunks ) )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-		 "%s: unable to create destination chunk group.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk group index value out of bounds.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( memory_copy(
-	     *destination_chunk_group,
-	     source_chunk_group,
-	     sizeof( libewf_chunk_group_t ) ) == NULL )
+	if( chunk_data == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-		 "%s: unable to copy source to destination chunk group.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
 		 function );
 
-		memory_free(
-		 *destination_chunk_group );
-
-		*destination_chunk_group = NULL;
-
 		return( -1 );
 	}
-	( *destination_chunk_group )->chunks_list = NULL;
+	chunk_data_offset = chunk_group->chunks_data_offsets[ chunk_group_index ];
+	range_flags       = chunk_group->chunks_range_flags[ chunk_group_index ];
 
-/* TODO clone chunks_list */
+	if( ( read_flags & LIBFDATA_READ_FLAG_IGNORE_CACHE ) == 0 )
+	{
+		result = libfcache_cache_get_value_by_identifier(
+		          chunk_data_cache,
+		          chunk_group->file_io_pool_entry,
+		          chunk_data_offset,
+		          chunk_group->timestamp,
+		          &cache_value,
+		          error );
 
-	return( 1 );
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve value from cache.",
+			 function );
 
-on_error:
-	if( *destination_chunk_group != NULL )
+			goto on_error;
+		}
+	}
+	if( result != 0 )
 	{
-		memory_free(
-		 *destination_chunk_group );
+		if( libfcache_cache_value_get_value(
+		     cache_value,
+		     (intptr_t **) chunk_data,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve chunk data from cache value.",
+			 function );
 
-		*destination_chunk_group = NULL;
+			goto on_error;
+		}
+		return( 1 );
 	}
-	return( -1 );
-}
+	if( ( range_flags & LIBEWF_RANGE_FLAG_IS_SPARSE ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported chunk: %d range flags.",
+		 function,
+		 chunk_group_index );
 
-/* Empties a chunk group
- * Returns 1 if successful or -1 on error
- */
-int libewf_chunk_group_empty(
-     libewf_chunk_group_t *chunk_group,
-     libcerror_error_t **error )
-{
-        static char *function = "libewf_chunk_group_empty";
+		goto on_error;
+	}
+	if( libewf_chunk_data_initialize(
+	     &safe_chunk_data,
+	     chunk_group->io_handle->chunk_size,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create chunk data.",
+		 function );
 
-	if( chunk_group == NULL )
+		goto on_error;
+	}
+	read_count = libewf_chunk_data_read_from_file_io_pool(
+		      safe_chunk_data,
+		      file_io_pool,
+		      chunk_group->file_io_pool_entry,
+		      chunk_data_offset,
+		      (size64_t) chunk_group->chunks_data_sizes[ chunk_group_index ],
+		      (uint32_t) range_flags,
+		      error );
+
+	if( read_count < 0 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid chunk group.",
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read chunk data.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( libfdata_list_empty(
-	     chunk_group->chunks_list,
+	if( libfcache_cache_set_value_by_identifier(
+	     chunk_data_cache,
+	     chunk_group->file_io_pool_entry,
+	     chunk_data_offset,
+	     chunk_group->timestamp,
+	     (intptr_t *) safe_chunk_data,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_chunk_data_free,
+	     LIBFCACHE_CACHE_VALUE_FLAG_MANAGED,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
-		 "%s: unable to empty chunks list.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set chunk data in cache.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
+	*chunk_data = safe_chunk_data;
+
 	return( 1 );
+
+on_error:
+	if( safe_chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 &safe_chunk_data,
+		 NULL );
+	}
+	return( -1 );
 }
 
-/* Fills the chunks list from the EWF version 1 sector table entries
+
+/* Fills the chunk group from the EWF version 1 sector table entries
  * Returns 1 if successful or -1 on error
  */
 int libewf_chunk_group_fill_v1(
@@ -344,7 +972,6 @@ int libewf_chunk_group_fill_v1(
 	uint8_t corrupted              = 0;
 	uint8_t is_compressed          = 0;
 	uint8_t overflow               = 0;
-	int element_index              = 0;
 
 	if( chunk_group == NULL )
 	{
@@ -401,6 +1028,47 @@ int libewf_chunk_group_fill_v1(
 
 		return( -1 );
 	}
+	if( ( number_of_entries == 0 )
+	 || ( number_of_entries > (uint32_t) ( INT_MAX - chunk_group->number_of_chunks ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of entries value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( chunk_group->number_of_chunks > 0 )
+	 && ( chunk_group->file_io_pool_entry != file_io_pool_entry ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid file IO pool entry value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_chunk_group_resize(
+	     chunk_group,
+	     chunk_group->number_of_chunks + (int) number_of_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+		 "%s: unable to resize chunk group.",
+		 function );
+
+		return( -1 );
+	}
+	chunk_group->file_io_pool_entry = file_io_pool_entry;
+	chunk_group->chunk_size         = chunk_size;
+
 	byte_stream_copy_to_uint32_little_endian(
 	 &( table_entries_data[ data_offset ] ),
 	 stored_offset );
@@ -571,26 +1239,12 @@ int libewf_chunk_group_fill_v1(
 
 		chunk_index++;
 
-		if( libfdata_list_append_element_with_mapped_size(
-		     chunk_group->chunks_list,
-		     &element_index,
-		     file_io_pool_entry,
-		     base_offset + current_offset,
-		     (size64_t) chunk_data_size,
-		     range_flags,
-		     chunk_size,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-			 "%s: unable to append element: %" PRIu32 " with mapped size to chunks list.",
-			 function,
-			 table_entry_index );
+		chunk_group->chunks_data_offsets[ chunk_group->number_of_chunks ] = base_offset + current_offset;
+		chunk_group->chunks_data_sizes[ chunk_group->number_of_chunks ]   = chunk_data_size;
+		chunk_group->chunks_range_flags[ chunk_group->number_of_chunks ]  = (uint16_t) range_flags;
+
+		chunk_group->number_of_chunks += 1;
 
-			return( -1 );
-		}
 		/* This is to compensate for the crappy > 2 GiB segment file solution in EnCase 6.7
 		 */
 		if( ( overflow == 0 )
@@ -782,26 +1436,20 @@ int libewf_chunk_group_fill_v1(
 	}
 #endif /* defined( HAVE_DEBUG_OUTPUT ) */
 
-	if( libfdata_list_append_element_with_mapped_size(
-	     chunk_group->chunks_list,
-	     &element_index,
-	     file_io_pool_entry,
-	     last_chunk_data_offset,
-	     (size64_t) last_chunk_data_size,
-	     range_flags,
-	     chunk_size,
-	     error ) != 1 )
+	/* A corrupted last chunk with a size that does not fit in 32-bit is stored with size 0
+	 * which, like the size of the chunk data itself, is rejected when the chunk is read
+	 */
+	if( ( last_chunk_data_size <= 0 )
+	 || ( last_chunk_data_size > (off64_t) UINT32_MAX ) )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-		 "%s: unable to append element: %" PRIu32 " with mapped size to chunks list.",
-		 function,
-		 table_entry_index );
-
-		return( -1 );
+		last_chunk_data_size = 0;
 	}
+	chunk_group->chunks_data_offsets[ chunk_group->number_of_chunks ] = last_chunk_data_offset;
+	chunk_group->chunks_data_sizes[ chunk_group->number_of_chunks ]   = (uint32_t) last_chunk_data_size;
+	chunk_group->chunks_range_flags[ chunk_group->number_of_chunks ]  = (uint16_t) range_flags;
+
+	chunk_group->number_of_chunks += 1;
+
 #if defined( HAVE_DEBUG_OUTPUT )
 	if( libcnotify_verbose != 0 )
 	{
@@ -812,7 +1460,7 @@ int libewf_chunk_group_fill_v1(
 	return( 1 );
 }
 
-/* Fills the chunks list from the EWF version 2 sector table entries
+/* Fills the chunk group from the EWF version 2 sector table entries
  * Returns 1 if successful or -1 on error
  */
 int libewf_chunk_group_fill_v2(
@@ -834,7 +1482,6 @@ int libewf_chunk_group_fill_v2(
 	uint32_t chunk_data_size   = 0;
 	uint32_t range_flags       = 0;
 	uint32_t table_entry_index = 0;
-	int element_index          = 0;
 
 	if( chunk_group == NULL )
 	{
@@ -880,6 +1527,47 @@ int libewf_chunk_group_fill_v2(
 
 		return( -1 );
 	}
+	if( ( number_of_entries == 0 )
+	 || ( number_of_entries > (uint32_t) ( INT_MAX - chunk_group->number_of_chunks ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of entries value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( chunk_group->number_of_chunks > 0 )
+	 && ( chunk_group->file_io_pool_entry != file_io_pool_entry ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid file IO pool entry value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_chunk_group_resize(
+	     chunk_group,
+	     chunk_group->number_of_chunks + (int) number_of_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+		 "%s: unable to resize chunk group.",
+		 function );
+
+		return( -1 );
+	}
+	chunk_group->file_io_pool_entry = file_io_pool_entry;
+	chunk_group->chunk_size         = chunk_size;
+
 	for( table_entry_index = 0;
 	     table_entry_index < number_of_entries;
 	     table_entry_index++ )
@@ -1001,26 +1689,12 @@ int libewf_chunk_group_fill_v2(
 			chunk_data_offset = table_section->start_offset + sizeof( ewf_table_header_v2_t ) + data_offset - sizeof( ewf_table_entry_v2_t );
 			chunk_data_size   = 8;
 		}
-		if( libfdata_list_append_element_with_mapped_size(
-		     chunk_group->chunks_list,
-		     &element_index,
-		     file_io_pool_entry,
-		     chunk_data_offset,
-		     (size64_t) chunk_data_size,
-		     range_flags,
-		     chunk_size,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-			 "%s: unable to append element: %" PRIu32 " with mapped size to chunks list.",
-			 function,
-			 table_entry_index );
+		chunk_group->chunks_data_offsets[ chunk_group->number_of_chunks ] = (off64_t) chunk_data_offset;
+		chunk_group->chunks_data_sizes[ chunk_group->number_of_chunks ]   = chunk_data_size;
+		chunk_group->chunks_range_flags[ chunk_group->number_of_chunks ]  = (uint16_t) range_flags;
+
+		chunk_group->number_of_chunks += 1;
 
-			return( -1 );
-		}
 		chunk_index++;
 
 #if defined( HAVE_DEBUG_OUTPUT )
@@ -1034,7 +1708,7 @@ int libewf_chunk_group_fill_v2(
 	return( 1 );
 }
 
-/* Corrects the chunks list from the offsets
+/* Corrects the chunk group from the offsets
  * Returns 1 if successful or -1 on error
  */
 int libewf_chunk_group_correct_v1(
@@ -1283,9 +1957,9 @@ int libewf_chunk_group_correct_v1(
 		}
 #endif /* defined( HAVE_DEBUG_OUTPUT ) */
 
-		if( libfdata_list_get_element_by_index(
-		     chunk_group->chunks_list,
-		     table_entry_index,
+		if( libewf_chunk_group_get_chunk_data_range(
+		     chunk_group,
+		     (int) table_entry_index,
 		     &previous_file_io_pool_entry,
 		     &previous_chunk_data_offset,
 		     &previous_chunk_data_size,
@@ -1296,7 +1970,7 @@ int libewf_chunk_group_correct_v1(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve element: %" PRIu32 " from chunks list.",
+			 "%s: unable to retrieve element: %" PRIu32 " from chunk group.",
 			 function,
 			 table_entry_index );
 
@@ -1367,9 +2041,9 @@ int libewf_chunk_group_correct_v1(
 		}
 		if( update_data_range != 0 )
 		{
-			if( libfdata_list_set_element_by_index(
-			     chunk_group->chunks_list,
-			     table_entry_index,
+			if( libewf_chunk_group_set_chunk_data_range(
+			     chunk_group,
+			     (int) table_entry_index,
 			     file_io_pool_entry,
 			     base_offset + current_offset,
 			     (size64_t) chunk_data_size,
@@ -1380,7 +2054,7 @@ int libewf_chunk_group_correct_v1(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-				 "%s: unable to set element: %" PRIu32 " in chunks list.",
+				 "%s: unable to set element: %" PRIu32 " in chunk group.",
 				 function,
 				 table_entry_index );
 
@@ -1562,9 +2236,9 @@ int libewf_chunk_group_correct_v1(
 	}
 #endif /* defined( HAVE_DEBUG_OUTPUT ) */
 
-	if( libfdata_list_get_element_by_index(
-	     chunk_group->chunks_list,
-	     table_entry_index,
+	if( libewf_chunk_group_get_chunk_data_range(
+	     chunk_group,
+	     (int) table_entry_index,
 	     &previous_file_io_pool_entry,
 	     &previous_chunk_data_offset,
 	     &previous_chunk_data_size,
@@ -1575,7 +2249,7 @@ int libewf_chunk_group_correct_v1(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve element: %" PRIu32 " from chunks list.",
+		 "%s: unable to retrieve element: %" PRIu32 " from chunk group.",
 		 function,
 		 table_entry_index );
 
@@ -1646,9 +2320,9 @@ int libewf_chunk_group_correct_v1(
 	}
 	if( update_data_range != 0 )
 	{
-		if( libfdata_list_set_element_by_index(
-		     chunk_group->chunks_list,
-		     table_entry_index,
+		if( libewf_chunk_group_set_chunk_data_range(
+		     chunk_group,
+		     (int) table_entry_index,
 		     file_io_pool_entry,
 		     base_offset + current_offset,
 		     (size64_t) chunk_data_size,
@@ -1659,7 +2333,7 @@ int libewf_chunk_group_correct_v1(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set element: %" PRIu32 " in chunks list.",
+			 "%s: unable to set element: %" PRIu32 " in chunk group.",
 			 function,
 			 table_entry_index );
 
@@ -25,9 +25,11 @@
 #include <common.h>
 #include <types.h>
 
+#include "libewf_chunk_data.h"
 #include "libewf_io_handle.h"
+#include "libewf_libbfio.h"
 #include "libewf_libcerror.h"
-#include "libewf_libfdata.h"
+#include "libewf_libfcache.h"
 #include "libewf_section_descriptor.h"
 
 #if defined( __cplusplus )
@@ -36,11 +38,46 @@ extern "C" {
 
 typedef struct libewf_chunk_group libewf_chunk_group_t;
 
+/* The chunk group stores the chunk data ranges of a table section
+ * as packed arrays, instead of a list element per chunk
+ */
 struct libewf_chunk_group
 {
-	/* The chunks list
+	/* The IO handle
+	 */
+	libewf_io_handle_t *io_handle;
+
+	/* The chunks data offsets
+	 */
+	off64_t *chunks_data_offsets;
+
+	/* The chunks data sizes
+	 */
+	uint32_t *chunks_data_sizes;
+
+	/* The chunks range flags
+	 */
+	uint16_t *chunks_range_flags;
+
+	/* The number of chunks
 	 */
-	libfdata_list_t *chunks_list;
+	int number_of_chunks;
+
+	/* The number of allocated chunks
+	 */
+	int number_of_allocated_chunks;
+
+	/* The file IO pool entry of the chunks data
+	 */
+	int file_io_pool_entry;
+
+	/* The chunk size, which is the mapped size of every chunk
+	 */
+	size32_t chunk_size;
+
+	/* The timestamp, used to identify the chunks data in the cache
+	 */
+	int64_t timestamp;
 
 	/* The range start offset
 	 */
@@ -69,6 +106,50 @@ int libewf_chunk_group_empty(
      libewf_chunk_group_t *chunk_group,
      libcerror_error_t **error );
 
+int libewf_chunk_group_resize(
+     libewf_chunk_group_t *chunk_group,
+     int number_of_chunks,
+     libcerror_error_t **error );
+
+int libewf_chunk_group_get_number_of_chunks(
+     libewf_chunk_group_t *chunk_group,
+     int *number_of_chunks,
+     libcerror_error_t **error );
+
+int libewf_chunk_group_get_chunk_data_range(
+     libewf_chunk_group_t *chunk_group,
+     int chunk_group_index,
+     int *file_io_pool_entry,
+     off64_t *chunk_data_offset,
+     size64_t *chunk_data_size,
+     uint32_t *range_flags,
+     libcerror_error_t **error );
+
+int libewf_chunk_group_set_chunk_data_range(
+     libewf_chunk_group_t *chunk_group,
+     int chunk_group_index,
+     int file_io_pool_entry,
+     off64_t chunk_data_offset,
+     size64_t chunk_data_size,
+     uint32_t range_flags,
+     libcerror_error_t **error );
+
+int libewf_chunk_group_get_chunk_mapped_range(
+     libewf_chunk_group_t *chunk_group,
+     int chunk_group_index,
+     off64_t *mapped_range_offset,
+     size64_t *mapped_range_size,
+     libcerror_error_t **error );
+
+int libewf_chunk_group_get_chunk_data(
+     libewf_chunk_group_t *chunk_group,
+     libbfio_pool_t *file_io_pool,
+     libfcache_cache_t *chunk_data_cache,
+     int chunk_group_index,
+     libewf_chunk_data_t **chunk_data,
+     uint8_t read_flags,
+     libcerror_error_t **error );
+
 int libewf_chunk_group_fill_v1(
      libewf_chunk_group_t *chunk_group,
      uint64_t chunk_index,
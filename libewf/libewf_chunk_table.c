@@ -24,6 +24,7 @@
 #include <memory.h>
 #include <types.h>
 
+#include "libewf_chunk_cache.h"
 #include "libewf_chunk_data.h"
 #include "libewf_chunk_group.h"
 #include "libewf_chunk_table.h"
@@ -154,6 +155,21 @@ int libewf_chunk_table_initialize(
 
 		goto on_error;
 	}
+	if( libewf_chunk_cache_initialize(
+	     &( ( *chunk_table )->chunk_cache ),
+	     LIBEWF_CHUNK_CACHE_NUMBER_OF_SHARDS,
+	     LIBEWF_DEFAULT_MAXIMUM_CACHE_SIZE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create chunk cache.",
+		 function );
+
+		goto on_error;
+	}
 	( *chunk_table )->io_handle = io_handle;
 
 	return( 1 );
@@ -161,6 +177,12 @@ int libewf_chunk_table_initialize(
 on_error:
 	if( *chunk_table != NULL )
 	{
+		if( ( *chunk_table )->single_chunk_data_cache != NULL )
+		{
+			libfcache_cache_free(
+			 &( ( *chunk_table )->single_chunk_data_cache ),
+			 NULL );
+		}
 		if( ( *chunk_table )->chunk_data_cache != NULL )
 		{
 			libfcache_cache_free(
@@ -238,6 +260,19 @@ int libewf_chunk_table_free(
 
 			result = -1;
 		}
+		if( libewf_chunk_cache_free(
+		     &( ( *chunk_table )->chunk_cache ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunk cache.",
+			 function );
+
+			result = -1;
+		}
 		memory_free(
 		 *chunk_table );
 
@@ -322,6 +357,7 @@ int libewf_chunk_table_clone(
 	( *destination_chunk_table )->checksum_errors         = NULL;
 	( *destination_chunk_table )->chunk_data_cache        = NULL;
 	( *destination_chunk_table )->single_chunk_data_cache = NULL;
+	( *destination_chunk_table )->chunk_cache             = NULL;
 
 	if( libcdata_range_list_clone(
 	     &( ( *destination_chunk_table )->checksum_errors ),
@@ -367,11 +403,32 @@ int libewf_chunk_table_clone(
 
 		goto on_error;
 	}
+	if( libewf_chunk_cache_initialize(
+	     &( ( *destination_chunk_table )->chunk_cache ),
+	     LIBEWF_CHUNK_CACHE_NUMBER_OF_SHARDS,
+	     source_chunk_table->chunk_cache->maximum_cache_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create destination chunk cache.",
+		 function );
+
+		goto on_error;
+	}
 	return( 1 );
 
 on_error:
 	if( *destination_chunk_table != NULL )
 	{
+		if( ( *destination_chunk_table )->single_chunk_data_cache != NULL )
+		{
+			libfcache_cache_free(
+			 &( ( *destination_chunk_table )->single_chunk_data_cache ),
+			 NULL );
+		}
 		if( ( *destination_chunk_table )->chunk_data_cache != NULL )
 		{
 			libfcache_cache_free(
@@ -721,7 +778,7 @@ int libewf_chunk_table_get_segment_file_chunk_data_by_offset(
 	uint64_t chunk_index              = 0;
 	uint32_t segment_number           = 0;
 	int chunk_groups_list_index       = 0;
-	int chunks_list_index             = 0;
+	int chunk_group_index             = 0;
 	int result                        = 0;
 
 	if( chunk_table == NULL )
@@ -842,15 +899,15 @@ int libewf_chunk_table_get_segment_file_chunk_data_by_offset(
 				return( -1 );
 			}
 			chunk_index            = (uint64_t) offset / media_values->chunk_size;
-			chunks_list_index      = (int) ( chunk_group_data_offset / media_values->chunk_size );
-			safe_chunk_data_offset = chunk_group_data_offset - ( (off64_t) chunks_list_index * media_values->chunk_size );
-
-			if( libfdata_list_get_element_value_by_index(
-			     chunk_group->chunks_list,
-			     (intptr_t *) file_io_pool,
-			     (libfdata_cache_t *) chunk_data_cache,
-			     chunks_list_index,
-			     (intptr_t **) &( chunk_table->current_chunk_data ),
+			chunk_group_index      = (int) ( chunk_group_data_offset / media_values->chunk_size );
+			safe_chunk_data_offset = chunk_group_data_offset - ( (off64_t) chunk_group_index * media_values->chunk_size );
+
+			if( libewf_chunk_group_get_chunk_data(
+			     chunk_group,
+			     file_io_pool,
+			     chunk_data_cache,
+			     chunk_group_index,
+			     &( chunk_table->current_chunk_data ),
 			     read_flags,
 			     error ) != 1 )
 			{
@@ -882,9 +939,9 @@ int libewf_chunk_table_get_segment_file_chunk_data_by_offset(
 			}
 			chunk_table->current_chunk_data->chunk_index = chunk_index;
 
-			if( libfdata_list_get_element_mapped_range(
-			     chunk_group->chunks_list,
-			     chunks_list_index,
+			if( libewf_chunk_group_get_chunk_mapped_range(
+			     chunk_group,
+			     chunk_group_index,
 			     &( chunk_table->current_chunk_data->range_start_offset ),
 			     (size64_t *) &( chunk_table->current_chunk_data->range_end_offset ),
 			     error ) != 1 )
@@ -893,9 +950,9 @@ int libewf_chunk_table_get_segment_file_chunk_data_by_offset(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve list element: %d mapped range for chunk group: %d in segment file: %" PRIu32 ".",
+				 "%s: unable to retrieve chunk: %d mapped range from chunk group: %d in segment file: %" PRIu32 ".",
 				 function,
-				 chunks_list_index,
+				 chunk_group_index,
 				 chunk_groups_list_index,
 				 segment_number );
 
@@ -1117,6 +1174,11 @@ int libewf_chunk_table_get_chunk_data_by_offset_no_cache(
 
 		return( -1 );
 	}
+	/* Make sure the chunk data is read from file and not taken from
+	 * the current chunk data that is managed by the chunk data cache
+	 */
+	chunk_table->current_chunk_data = NULL;
+
 	result = libewf_chunk_table_get_segment_file_chunk_data_by_offset(
 		  chunk_table,
 		  io_handle,
@@ -1159,7 +1221,598 @@ int libewf_chunk_table_get_chunk_data_by_offset_no_cache(
 
 			return( -1 );
 		}
+		/* The chunk data is now managed by the caller
+		 */
+		chunk_table->current_chunk_data = NULL;
 	}
 	return( result );
 }
 
+/* Retrieves the chunk data of a chunk at a specific offset without reading it
+ * The chunk data is created with the mapped range of the chunk, the data itself
+ * is read by the caller from the file IO pool entry, offset, size and flags.
+ * This allows the chunk table to be locked while the chunk is looked up but not
+ * while the chunk data is read
+ * The chunk data is not cached and is managed by the caller
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libewf_chunk_table_get_chunk_data_range_by_offset(
+     libewf_chunk_table_t *chunk_table,
+     libewf_io_handle_t *io_handle,
+     libbfio_pool_t *file_io_pool,
+     libewf_media_values_t *media_values,
+     libewf_segment_table_t *segment_table,
+     off64_t offset,
+     libewf_chunk_data_t **chunk_data,
+     int *file_io_pool_entry,
+     off64_t *chunk_data_offset,
+     size64_t *chunk_data_size,
+     uint32_t *chunk_data_flags,
+     libcerror_error_t **error )
+{
+	libewf_chunk_data_t *safe_chunk_data = NULL;
+	libewf_chunk_group_t *chunk_group    = NULL;
+	static char *function                = "libewf_chunk_table_get_chunk_data_range_by_offset";
+	off64_t chunk_group_data_offset      = 0;
+	size64_t mapped_range_size           = 0;
+	uint64_t chunk_index                 = 0;
+	uint32_t segment_number              = 0;
+	int chunk_groups_list_index          = 0;
+	int chunk_group_index                = 0;
+	int result                           = 0;
+
+	if( chunk_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk table.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( media_values->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid media values - chunk size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_pool_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO pool entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data_flags == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data flags.",
+		 function );
+
+		return( -1 );
+	}
+	result = libewf_chunk_table_get_segment_file_chunk_group_by_offset(
+		  chunk_table,
+		  file_io_pool,
+		  segment_table,
+		  offset,
+		  &segment_number,
+		  &chunk_groups_list_index,
+		  &chunk_group_data_offset,
+		  &chunk_group,
+		  error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve segment file chunk group for offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 offset,
+		 offset );
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	if( chunk_group == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing chunk group: %d.",
+		 function,
+		 chunk_groups_list_index );
+
+		goto on_error;
+	}
+	chunk_index       = (uint64_t) offset / media_values->chunk_size;
+	chunk_group_index = (int) ( chunk_group_data_offset / media_values->chunk_size );
+
+	if( libewf_chunk_group_get_chunk_data_range(
+	     chunk_group,
+	     chunk_group_index,
+	     file_io_pool_entry,
+	     chunk_data_offset,
+	     chunk_data_size,
+	     chunk_data_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk: %" PRIu64 " data range from chunk group: %d in segment file: %" PRIu32 ".",
+		 function,
+		 chunk_index,
+		 chunk_groups_list_index,
+		 segment_number );
+
+		goto on_error;
+	}
+	if( ( *chunk_data_flags & LIBEWF_RANGE_FLAG_IS_SPARSE ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported chunk: %" PRIu64 " range flags.",
+		 function,
+		 chunk_index );
+
+		goto on_error;
+	}
+	if( libewf_chunk_data_initialize(
+	     &safe_chunk_data,
+	     io_handle->chunk_size,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create chunk: %" PRIu64 " data.",
+		 function,
+		 chunk_index );
+
+		goto on_error;
+	}
+	safe_chunk_data->chunk_index = chunk_index;
+
+	if( libewf_chunk_group_get_chunk_mapped_range(
+	     chunk_group,
+	     chunk_group_index,
+	     &( safe_chunk_data->range_start_offset ),
+	     &mapped_range_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk: %d mapped range from chunk group: %d in segment file: %" PRIu32 ".",
+		 function,
+		 chunk_group_index,
+		 chunk_groups_list_index,
+		 segment_number );
+
+		goto on_error;
+	}
+	safe_chunk_data->range_start_offset += chunk_group->range_start_offset;
+	safe_chunk_data->range_end_offset    = safe_chunk_data->range_start_offset + (off64_t) mapped_range_size;
+
+	if( (size64_t) safe_chunk_data->range_end_offset > media_values->media_size )
+	{
+		safe_chunk_data->range_end_offset = (off64_t) media_values->media_size;
+	}
+	*chunk_data = safe_chunk_data;
+
+	return( 1 );
+
+on_error:
+	if( safe_chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 &safe_chunk_data,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Retrieves the chunk data of consecutive chunks starting at a specific offset
+ * The chunks stored in the same segment file are read using a single vectored read
+ * The chunk data is not cached and is managed by the caller
+ * The number of chunks is 0 if the chunk at the offset cannot be read this way
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_table_get_chunks_data_by_offset_no_cache(
+     libewf_chunk_table_t *chunk_table,
+     libewf_io_handle_t *io_handle,
+     libbfio_pool_t *file_io_pool,
+     libewf_media_values_t *media_values,
+     libewf_segment_table_t *segment_table,
+     off64_t offset,
+     libewf_chunk_data_t **chunks_data,
+     int maximum_number_of_chunks,
+     int *number_of_chunks,
+     libcerror_error_t **error )
+{
+	off64_t chunks_data_offset[ LIBEWF_MAXIMUM_NUMBER_OF_CHUNKS_PER_READ_VECTOR ];
+	size64_t chunks_data_size[ LIBEWF_MAXIMUM_NUMBER_OF_CHUNKS_PER_READ_VECTOR ];
+	uint32_t chunks_data_flags[ LIBEWF_MAXIMUM_NUMBER_OF_CHUNKS_PER_READ_VECTOR ];
+
+	libewf_chunk_group_t *chunk_group = NULL;
+	static char *function             = "libewf_chunk_table_get_chunks_data_by_offset_no_cache";
+	off64_t chunk_group_data_offset   = 0;
+	off64_t chunk_offset              = 0;
+	size64_t mapped_range_size        = 0;
+	uint64_t chunk_index              = 0;
+	uint32_t segment_number           = 0;
+	int chunk_groups_list_index       = 0;
+	int chunk_number                  = 0;
+	int chunk_group_index             = 0;
+	int file_io_pool_entry            = 0;
+	int first_file_io_pool_entry      = -1;
+	int result                        = 0;
+
+	if( chunk_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk table.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( media_values->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid media values - chunk size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunks_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunks data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( maximum_number_of_chunks <= 0 )
+	 || ( maximum_number_of_chunks > LIBEWF_MAXIMUM_NUMBER_OF_CHUNKS_PER_READ_VECTOR ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum number of chunks value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_chunks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of chunks.",
+		 function );
+
+		return( -1 );
+	}
+	chunk_index  = (uint64_t) offset / media_values->chunk_size;
+	chunk_offset = offset;
+
+	for( chunk_number = 0;
+	     chunk_number < maximum_number_of_chunks;
+	     chunk_number++ )
+	{
+		if( (size64_t) chunk_offset >= media_values->media_size )
+		{
+			break;
+		}
+		result = libewf_chunk_table_get_segment_file_chunk_group_by_offset(
+			  chunk_table,
+			  file_io_pool,
+			  segment_table,
+			  chunk_offset,
+			  &segment_number,
+			  &chunk_groups_list_index,
+			  &chunk_group_data_offset,
+			  &chunk_group,
+			  error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment file chunk group for offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 chunk_offset,
+			 chunk_offset );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			break;
+		}
+		if( chunk_group == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing chunk group: %d.",
+			 function,
+			 chunk_groups_list_index );
+
+			goto on_error;
+		}
+		chunk_group_index = (int) ( chunk_group_data_offset / media_values->chunk_size );
+
+		if( libewf_chunk_group_get_chunk_data_range(
+		     chunk_group,
+		     chunk_group_index,
+		     &file_io_pool_entry,
+		     &( chunks_data_offset[ chunk_number ] ),
+		     &( chunks_data_size[ chunk_number ] ),
+		     &( chunks_data_flags[ chunk_number ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve chunk: %" PRIu64 " data range from chunk group: %d in segment file: %" PRIu32 ".",
+			 function,
+			 chunk_index,
+			 chunk_groups_list_index,
+			 segment_number );
+
+			goto on_error;
+		}
+		/* Sparse chunks and chunks that are stored in another segment file
+		 * than the first chunk are left to the next read
+		 */
+		if( ( chunks_data_flags[ chunk_number ] & LIBEWF_RANGE_FLAG_IS_SPARSE ) != 0 )
+		{
+			break;
+		}
+		if( ( first_file_io_pool_entry != -1 )
+		 && ( file_io_pool_entry != first_file_io_pool_entry ) )
+		{
+			break;
+		}
+		if( libewf_chunk_data_initialize(
+		     &( chunks_data[ chunk_number ] ),
+		     io_handle->chunk_size,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create chunk: %" PRIu64 " data.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+		if( ( chunks_data_size[ chunk_number ] == 0 )
+		 || ( chunks_data_size[ chunk_number ] > (size64_t) chunks_data[ chunk_number ]->allocated_data_size ) )
+		{
+			libewf_chunk_data_free(
+			 &( chunks_data[ chunk_number ] ),
+			 NULL );
+
+			break;
+		}
+		chunks_data[ chunk_number ]->chunk_index = chunk_index;
+
+		if( libewf_chunk_group_get_chunk_mapped_range(
+		     chunk_group,
+		     chunk_group_index,
+		     &( chunks_data[ chunk_number ]->range_start_offset ),
+		     &mapped_range_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve chunk: %d mapped range from chunk group: %d in segment file: %" PRIu32 ".",
+			 function,
+			 chunk_group_index,
+			 chunk_groups_list_index,
+			 segment_number );
+
+			chunk_number++;
+
+			goto on_error;
+		}
+		chunks_data[ chunk_number ]->range_start_offset += chunk_group->range_start_offset;
+		chunks_data[ chunk_number ]->range_end_offset    = chunks_data[ chunk_number ]->range_start_offset + (off64_t) mapped_range_size;
+
+		if( (size64_t) chunks_data[ chunk_number ]->range_end_offset > media_values->media_size )
+		{
+			chunks_data[ chunk_number ]->range_end_offset = (off64_t) media_values->media_size;
+		}
+		first_file_io_pool_entry = file_io_pool_entry;
+
+		chunk_index += 1;
+		chunk_offset = (off64_t) ( chunk_index * media_values->chunk_size );
+	}
+	if( chunk_number > 0 )
+	{
+		if( libewf_chunk_data_read_vector_from_file_io_pool(
+		     chunks_data,
+		     chunk_number,
+		     file_io_pool,
+		     first_file_io_pool_entry,
+		     chunks_data_offset,
+		     chunks_data_size,
+		     chunks_data_flags,
+		     error ) < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read chunks data.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	*number_of_chunks = chunk_number;
+
+	return( 1 );
+
+on_error:
+	while( chunk_number > 0 )
+	{
+		chunk_number--;
+
+		if( chunks_data[ chunk_number ] != NULL )
+		{
+			libewf_chunk_data_free(
+			 &( chunks_data[ chunk_number ] ),
+			 NULL );
+		}
+	}
+	return( -1 );
+}
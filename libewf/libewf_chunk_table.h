@@ -25,6 +25,7 @@
 #include <common.h>
 #include <types.h>
 
+#include "libewf_chunk_cache.h"
 #include "libewf_chunk_group.h"
 #include "libewf_io_handle.h"
 #include "libewf_libbfio.h"
@@ -81,6 +82,10 @@ struct libewf_chunk_table
 	/* The single chunk data cache
 	 */
 	libfcache_cache_t *single_chunk_data_cache;
+
+	/* The chunk cache used by concurrent readers
+	 */
+	libewf_chunk_cache_t *chunk_cache;
 };
 
 int libewf_chunk_table_initialize(
@@ -161,6 +166,32 @@ int libewf_chunk_table_get_chunk_data_by_offset_no_cache(
      libewf_chunk_data_t **chunk_data,
      libcerror_error_t **error );
 
+int libewf_chunk_table_get_chunk_data_range_by_offset(
+     libewf_chunk_table_t *chunk_table,
+     libewf_io_handle_t *io_handle,
+     libbfio_pool_t *file_io_pool,
+     libewf_media_values_t *media_values,
+     libewf_segment_table_t *segment_table,
+     off64_t offset,
+     libewf_chunk_data_t **chunk_data,
+     int *file_io_pool_entry,
+     off64_t *chunk_data_offset,
+     size64_t *chunk_data_size,
+     uint32_t *chunk_data_flags,
+     libcerror_error_t **error );
+
+int libewf_chunk_table_get_chunks_data_by_offset_no_cache(
+     libewf_chunk_table_t *chunk_table,
+     libewf_io_handle_t *io_handle,
+     libbfio_pool_t *file_io_pool,
+     libewf_media_values_t *media_values,
+     libewf_segment_table_t *segment_table,
+     off64_t offset,
+     libewf_chunk_data_t **chunks_data,
+     int maximum_number_of_chunks,
+     int *number_of_chunks,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
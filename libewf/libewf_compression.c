@@ -34,6 +34,10 @@
 #include <zlib.h>
 #endif
 
+#if defined( HAVE_LIBDEFLATE )
+#include <libdeflate.h>
+#endif
+
 #include "libewf_compression.h"
 #include "libewf_definitions.h"
 #include "libewf_deflate.h"
@@ -59,7 +63,10 @@ int libewf_compress_data(
 	unsigned int bzip2_compressed_data_size = 0;
 	int bzip2_compression_level             = 0;
 #endif
-#if ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_COMPRESS2 ) ) || defined( ZLIB_DLL )
+#if defined( HAVE_LIBDEFLATE )
+	struct libdeflate_compressor *compressor = NULL;
+	int libdeflate_compression_level        = 0;
+#elif ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_COMPRESS2 ) ) || defined( ZLIB_DLL )
 	uLongf zlib_compressed_data_size        = 0;
 	int zlib_compression_level              = 0;
 #endif
@@ -110,7 +117,58 @@ int libewf_compress_data(
 	}
 	if( compression_method == LIBEWF_COMPRESSION_METHOD_DEFLATE )
 	{
-#if ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_COMPRESS2 ) ) || defined( ZLIB_DLL )
+#if defined( HAVE_LIBDEFLATE )
+		if( libewf_compression_get_libdeflate_level(
+		     compression_level,
+		     &libdeflate_compression_level,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve libdeflate compression level.",
+			 function );
+
+			return( -1 );
+		}
+		compressor = libdeflate_alloc_compressor(
+		              libdeflate_compression_level );
+
+		if( compressor == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create libdeflate compressor.",
+			 function );
+
+			return( -1 );
+		}
+		result = libewf_compress_data_using_libdeflate(
+		          compressor,
+		          compressed_data,
+		          compressed_data_size,
+		          uncompressed_data,
+		          uncompressed_data_size,
+		          error );
+
+		libdeflate_free_compressor(
+		 compressor );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+			 LIBCERROR_COMPRESSION_ERROR_COMPRESS_FAILED,
+			 "%s: unable to compress data using libdeflate.",
+			 function );
+
+			return( -1 );
+		}
+#elif ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_COMPRESS2 ) ) || defined( ZLIB_DLL )
 		if( compression_level == LIBEWF_COMPRESSION_LEVEL_DEFAULT )
 		{
 			zlib_compression_level = Z_DEFAULT_COMPRESSION;
@@ -241,7 +299,7 @@ int libewf_compress_data(
 		 function );
 
 		return( -1 );
-#endif /* ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_COMPRESS2 ) ) || defined( ZLIB_DLL ) */
+#endif /* defined( HAVE_LIBDEFLATE ) */
 	}
 	else if( compression_method == LIBEWF_COMPRESSION_METHOD_BZIP2 )
 	{
@@ -384,14 +442,16 @@ int libewf_decompress_data(
      size_t *uncompressed_data_size,
      libcerror_error_t **error )
 {
-	static char *function                     = "libewf_decompress_data";
-	int result                                = 0;
+	static char *function                        = "libewf_decompress_data";
+	int result                                   = 0;
 
 #if defined( HAVE_LIBBZ2 ) || defined( BZIP2_DLL )
-	unsigned int bzip2_uncompressed_data_size = 0;
+	unsigned int bzip2_uncompressed_data_size    = 0;
 #endif
-#if ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_UNCOMPRESS ) ) || defined( ZLIB_DLL )
-	uLongf zlib_uncompressed_data_size        = 0;
+#if defined( HAVE_LIBDEFLATE )
+	struct libdeflate_decompressor *decompressor = NULL;
+#elif ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_UNCOMPRESS ) ) || defined( ZLIB_DLL )
+	uLongf zlib_uncompressed_data_size           = 0;
 #endif
 
 	if( compressed_data == NULL )
@@ -440,7 +500,34 @@ int libewf_decompress_data(
 	}
 	if( compression_method == LIBEWF_COMPRESSION_METHOD_DEFLATE )
 	{
-#if ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_UNCOMPRESS ) ) || defined( ZLIB_DLL )
+#if defined( HAVE_LIBDEFLATE )
+		decompressor = libdeflate_alloc_decompressor();
+
+		if( decompressor == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create libdeflate decompressor.",
+			 function );
+
+			return( -1 );
+		}
+		/* Note that libewf_decompress_data_using_libdeflate can return -1
+		 * without setting an error on a data error
+		 */
+		result = libewf_decompress_data_using_libdeflate(
+		          decompressor,
+		          compressed_data,
+		          compressed_data_size,
+		          uncompressed_data,
+		          uncompressed_data_size,
+		          error );
+
+		libdeflate_free_decompressor(
+		 decompressor );
+#elif ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_UNCOMPRESS ) ) || defined( ZLIB_DLL )
 #if ULONG_MAX < SSIZE_MAX
 		if( compressed_data_size > (size_t) ULONG_MAX )
 #else
@@ -561,7 +648,7 @@ int libewf_decompress_data(
 
 			return( -1 );
 		}
-#endif /* ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_UNCOMPRESS ) ) || defined( ZLIB_DLL ) */
+#endif /* defined( HAVE_LIBDEFLATE ) */
 	}
 	else if( compression_method == LIBEWF_COMPRESSION_METHOD_BZIP2 )
 	{
@@ -687,3 +774,311 @@ int libewf_decompress_data(
 	return( result );
 }
 
+#if defined( HAVE_LIBDEFLATE )
+
+/* Retrieves the libdeflate compression level for a compression level
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_compression_get_libdeflate_level(
+     int8_t compression_level,
+     int *libdeflate_compression_level,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_compression_get_libdeflate_level";
+
+	if( libdeflate_compression_level == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid libdeflate compression level.",
+		 function );
+
+		return( -1 );
+	}
+	/* The levels match those of zlib, libdeflate also supports the levels 10 to 12
+	 * but these are considerably slower than zlib level 9
+	 */
+	if( compression_level == LIBEWF_COMPRESSION_LEVEL_DEFAULT )
+	{
+		*libdeflate_compression_level = 6;
+	}
+	else if( compression_level == LIBEWF_COMPRESSION_LEVEL_FAST )
+	{
+		*libdeflate_compression_level = 1;
+	}
+	else if( compression_level == LIBEWF_COMPRESSION_LEVEL_BEST )
+	{
+		*libdeflate_compression_level = 9;
+	}
+	else if( compression_level == LIBEWF_COMPRESSION_LEVEL_NONE )
+	{
+		*libdeflate_compression_level = 0;
+	}
+	else
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported compression level.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Compresses data into a zlib stream using a libdeflate compressor
+ * Returns 1 on success, 0 if buffer is too small or -1 on error
+ */
+int libewf_compress_data_using_libdeflate(
+     struct libdeflate_compressor *compressor,
+     uint8_t *compressed_data,
+     size_t *compressed_data_size,
+     const uint8_t *uncompressed_data,
+     size_t uncompressed_data_size,
+     libcerror_error_t **error )
+{
+	static char *function       = "libewf_compress_data_using_libdeflate";
+	size_t safe_compressed_size = 0;
+
+	if( compressor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compressor.",
+		 function );
+
+		return( -1 );
+	}
+	if( compressed_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compressed data buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( compressed_data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compressed data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( *compressed_data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid compressed data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( uncompressed_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid uncompressed data buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( uncompressed_data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid uncompressed data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	/* libdeflate returns 0 if the compressed data does not fit in the buffer
+	 */
+	safe_compressed_size = libdeflate_zlib_compress(
+	                        compressor,
+	                        uncompressed_data,
+	                        uncompressed_data_size,
+	                        compressed_data,
+	                        *compressed_data_size );
+
+	if( safe_compressed_size == 0 )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: unable to write compressed data: target buffer too small.\n",
+			 function );
+		}
+#endif
+		*compressed_data_size = libdeflate_zlib_compress_bound(
+		                         compressor,
+		                         uncompressed_data_size );
+
+		return( 0 );
+	}
+	*compressed_data_size = safe_compressed_size;
+
+	return( 1 );
+}
+
+/* Decompresses a zlib stream using a libdeflate decompressor
+ * Returns 1 on success, 0 if buffer is too small or -1 on error
+ */
+int libewf_decompress_data_using_libdeflate(
+     struct libdeflate_decompressor *decompressor,
+     const uint8_t *compressed_data,
+     size_t compressed_data_size,
+     uint8_t *uncompressed_data,
+     size_t *uncompressed_data_size,
+     libcerror_error_t **error )
+{
+	static char *function         = "libewf_decompress_data_using_libdeflate";
+	size_t safe_uncompressed_size = 0;
+	enum libdeflate_result result = LIBDEFLATE_SUCCESS;
+
+	if( decompressor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid decompressor.",
+		 function );
+
+		return( -1 );
+	}
+	if( compressed_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compressed data buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( compressed_data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid compressed data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( uncompressed_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid uncompressed data buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( uncompressed_data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid uncompressed data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( *uncompressed_data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid uncompressed data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	result = libdeflate_zlib_decompress(
+	          decompressor,
+	          compressed_data,
+	          compressed_data_size,
+	          uncompressed_data,
+	          *uncompressed_data_size,
+	          &safe_uncompressed_size );
+
+	if( result == LIBDEFLATE_SUCCESS )
+	{
+		*uncompressed_data_size = safe_uncompressed_size;
+
+		return( 1 );
+	}
+	else if( result == LIBDEFLATE_INSUFFICIENT_SPACE )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			"%s: unable to read compressed data: target buffer too small.\n",
+			 function );
+		}
+#endif
+		/* Estimate that a factor 2 enlargement should suffice
+		 */
+		*uncompressed_data_size *= 2;
+
+		return( 0 );
+	}
+	else if( result == LIBDEFLATE_BAD_DATA )
+	{
+		/* Mimic uncompress which does not set an error on a data error
+		 */
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: unable to read compressed data: data error.\n",
+			 function );
+		}
+#endif
+		*uncompressed_data_size = 0;
+
+		return( -1 );
+	}
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+	 LIBCERROR_COMPRESSION_ERROR_DECOMPRESS_FAILED,
+	 "%s: libdeflate returned undefined error: %d.",
+	 function,
+	 result );
+
+	*uncompressed_data_size = 0;
+
+	return( -1 );
+}
+
+#endif /* defined( HAVE_LIBDEFLATE ) */
+
@@ -25,6 +25,10 @@
 #include <common.h>
 #include <types.h>
 
+#if defined( HAVE_LIBDEFLATE )
+#include <libdeflate.h>
+#endif
+
 #include "libewf_libcerror.h"
 
 #if defined( __cplusplus )
@@ -48,6 +52,31 @@ int libewf_decompress_data(
      size_t *uncompressed_data_size,
      libcerror_error_t **error );
 
+#if defined( HAVE_LIBDEFLATE )
+
+int libewf_compression_get_libdeflate_level(
+     int8_t compression_level,
+     int *libdeflate_compression_level,
+     libcerror_error_t **error );
+
+int libewf_compress_data_using_libdeflate(
+     struct libdeflate_compressor *compressor,
+     uint8_t *compressed_data,
+     size_t *compressed_data_size,
+     const uint8_t *uncompressed_data,
+     size_t uncompressed_data_size,
+     libcerror_error_t **error );
+
+int libewf_decompress_data_using_libdeflate(
+     struct libdeflate_decompressor *decompressor,
+     const uint8_t *compressed_data,
+     size_t compressed_data_size,
+     uint8_t *uncompressed_data,
+     size_t *uncompressed_data_size,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_LIBDEFLATE ) */
+
 #if defined( __cplusplus )
 }
 #endif
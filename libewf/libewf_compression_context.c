@@ -0,0 +1,665 @@
+/*
+ * Compression context functions
+ *
+ * Copyright (C) 2006-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_ZLIB ) || defined( ZLIB_DLL )
+#include <zlib.h>
+#endif
+
+#if defined( HAVE_LIBDEFLATE )
+#include <libdeflate.h>
+#endif
+
+#include "libewf_compression.h"
+#include "libewf_compression_context.h"
+#include "libewf_definitions.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcnotify.h"
+
+/* Creates a compression context
+ * Make sure the value compression_context is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_compression_context_initialize(
+     libewf_compression_context_t **compression_context,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_compression_context_initialize";
+
+	if( compression_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression context.",
+		 function );
+
+		return( -1 );
+	}
+	if( *compression_context != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid compression context value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*compression_context = memory_allocate_structure(
+	                        libewf_compression_context_t );
+
+	if( *compression_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create compression context.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *compression_context,
+	     0,
+	     sizeof( libewf_compression_context_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear compression context.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *compression_context != NULL )
+	{
+		memory_free(
+		 *compression_context );
+
+		*compression_context = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a compression context
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_compression_context_free(
+     libewf_compression_context_t **compression_context,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_compression_context_free";
+
+	if( compression_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression context.",
+		 function );
+
+		return( -1 );
+	}
+	if( *compression_context != NULL )
+	{
+#if defined( HAVE_LIBDEFLATE )
+		if( ( *compression_context )->compressor != NULL )
+		{
+			libdeflate_free_compressor(
+			 ( *compression_context )->compressor );
+		}
+		if( ( *compression_context )->decompressor != NULL )
+		{
+			libdeflate_free_decompressor(
+			 ( *compression_context )->decompressor );
+		}
+#elif ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_COMPRESS2 ) ) || defined( ZLIB_DLL )
+		if( ( *compression_context )->deflate_stream_is_initialized != 0 )
+		{
+			/* The stream state is released regardless of the return value
+			 */
+			deflateEnd(
+			 &( ( *compression_context )->deflate_stream ) );
+		}
+#endif
+#if !defined( HAVE_LIBDEFLATE ) && ( ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_UNCOMPRESS ) ) || defined( ZLIB_DLL ) )
+		if( ( *compression_context )->inflate_stream_is_initialized != 0 )
+		{
+			inflateEnd(
+			 &( ( *compression_context )->inflate_stream ) );
+		}
+#endif
+		memory_free(
+		 *compression_context );
+
+		*compression_context = NULL;
+	}
+	return( 1 );
+}
+
+/* Compresses data using the compression method
+ * Deflate compression reuses the libdeflate compressor or zlib stream of
+ * the context instead of setting up a new one for every call
+ * Returns 1 on success, 0 if buffer is too small or -1 on error
+ */
+int libewf_compression_context_compress_data(
+     libewf_compression_context_t *compression_context,
+     uint8_t *compressed_data,
+     size_t *compressed_data_size,
+     uint16_t compression_method,
+     int8_t compression_level,
+     const uint8_t *uncompressed_data,
+     size_t uncompressed_data_size,
+     libcerror_error_t **error )
+{
+	static char *function            = "libewf_compression_context_compress_data";
+	int result                       = 0;
+
+#if defined( HAVE_LIBDEFLATE )
+	int libdeflate_compression_level = 0;
+#elif ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_COMPRESS2 ) ) || defined( ZLIB_DLL )
+	int zlib_compression_level       = 0;
+#endif
+
+	if( compression_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression context.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBDEFLATE )
+	if( ( compression_method != LIBEWF_COMPRESSION_METHOD_DEFLATE )
+	 || ( compressed_data == NULL )
+	 || ( compressed_data_size == NULL )
+	 || ( uncompressed_data == NULL )
+	 || ( compressed_data == uncompressed_data ) )
+#elif ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_COMPRESS2 ) ) || defined( ZLIB_DLL )
+	/* The zlib stream uses 32-bit buffer sizes, larger buffers are handled by compress2
+	 */
+	if( ( compression_method != LIBEWF_COMPRESSION_METHOD_DEFLATE )
+	 || ( compressed_data == NULL )
+	 || ( compressed_data_size == NULL )
+	 || ( uncompressed_data == NULL )
+	 || ( compressed_data == uncompressed_data )
+	 || ( *compressed_data_size > (size_t) UINT_MAX )
+	 || ( uncompressed_data_size > (size_t) UINT_MAX ) )
+#endif
+	{
+		result = libewf_compress_data(
+		          compressed_data,
+		          compressed_data_size,
+		          compression_method,
+		          compression_level,
+		          uncompressed_data,
+		          uncompressed_data_size,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+			 LIBCERROR_COMPRESSION_ERROR_COMPRESS_FAILED,
+			 "%s: unable to compress data.",
+			 function );
+		}
+		return( result );
+	}
+#if defined( HAVE_LIBDEFLATE )
+	if( libewf_compression_get_libdeflate_level(
+	     compression_level,
+	     &libdeflate_compression_level,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve libdeflate compression level.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( compression_context->compressor != NULL )
+	 && ( compression_context->compressor_level != libdeflate_compression_level ) )
+	{
+		libdeflate_free_compressor(
+		 compression_context->compressor );
+
+		compression_context->compressor = NULL;
+	}
+	if( compression_context->compressor == NULL )
+	{
+		compression_context->compressor = libdeflate_alloc_compressor(
+		                                   libdeflate_compression_level );
+
+		if( compression_context->compressor == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create libdeflate compressor.",
+			 function );
+
+			return( -1 );
+		}
+		compression_context->compressor_level = libdeflate_compression_level;
+	}
+	result = libewf_compress_data_using_libdeflate(
+	          compression_context->compressor,
+	          compressed_data,
+	          compressed_data_size,
+	          uncompressed_data,
+	          uncompressed_data_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+		 LIBCERROR_COMPRESSION_ERROR_COMPRESS_FAILED,
+		 "%s: unable to compress data using libdeflate.",
+		 function );
+	}
+	return( result );
+
+#elif ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_COMPRESS2 ) ) || defined( ZLIB_DLL )
+	if( compression_level == LIBEWF_COMPRESSION_LEVEL_DEFAULT )
+	{
+		zlib_compression_level = Z_DEFAULT_COMPRESSION;
+	}
+	else if( compression_level == LIBEWF_COMPRESSION_LEVEL_FAST )
+	{
+		zlib_compression_level = Z_BEST_SPEED;
+	}
+	else if( compression_level == LIBEWF_COMPRESSION_LEVEL_BEST )
+	{
+		zlib_compression_level = Z_BEST_COMPRESSION;
+	}
+	else if( compression_level == LIBEWF_COMPRESSION_LEVEL_NONE )
+	{
+		zlib_compression_level = Z_NO_COMPRESSION;
+	}
+	else
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported compression level.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( compression_context->deflate_stream_is_initialized != 0 )
+	 && ( compression_context->deflate_stream_level != zlib_compression_level ) )
+	{
+		deflateEnd(
+		 &( compression_context->deflate_stream ) );
+
+		compression_context->deflate_stream_is_initialized = 0;
+	}
+	if( compression_context->deflate_stream_is_initialized == 0 )
+	{
+		if( memory_set(
+		     &( compression_context->deflate_stream ),
+		     0,
+		     sizeof( z_stream ) ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear deflate stream.",
+			 function );
+
+			return( -1 );
+		}
+		result = deflateInit(
+		          &( compression_context->deflate_stream ),
+		          zlib_compression_level );
+
+		if( result != Z_OK )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+			 LIBCERROR_COMPRESSION_ERROR_COMPRESS_FAILED,
+			 "%s: unable to initialize deflate stream with error: %d.",
+			 function,
+			 result );
+
+			return( -1 );
+		}
+		compression_context->deflate_stream_level          = zlib_compression_level;
+		compression_context->deflate_stream_is_initialized = 1;
+	}
+	else
+	{
+		result = deflateReset(
+		          &( compression_context->deflate_stream ) );
+
+		if( result != Z_OK )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+			 LIBCERROR_COMPRESSION_ERROR_COMPRESS_FAILED,
+			 "%s: unable to reset deflate stream with error: %d.",
+			 function,
+			 result );
+
+			return( -1 );
+		}
+	}
+	compression_context->deflate_stream.next_in   = (Bytef *) uncompressed_data;
+	compression_context->deflate_stream.avail_in  = (uInt) uncompressed_data_size;
+	compression_context->deflate_stream.next_out  = (Bytef *) compressed_data;
+	compression_context->deflate_stream.avail_out = (uInt) *compressed_data_size;
+
+	result = deflate(
+	          &( compression_context->deflate_stream ),
+	          Z_FINISH );
+
+	if( result == Z_STREAM_END )
+	{
+		*compressed_data_size = (size_t) compression_context->deflate_stream.total_out;
+
+		result = 1;
+	}
+	else if( ( result == Z_OK )
+	      || ( result == Z_BUF_ERROR ) )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: unable to write compressed data: target buffer too small.\n",
+			 function );
+		}
+#endif
+		*compressed_data_size = (size_t) deflateBound(
+		                                  &( compression_context->deflate_stream ),
+		                                  (uLong) uncompressed_data_size );
+
+		result = 0;
+	}
+	else
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+		 LIBCERROR_COMPRESSION_ERROR_COMPRESS_FAILED,
+		 "%s: zlib returned undefined error: %d.",
+		 function,
+		 result );
+
+		*compressed_data_size = 0;
+
+		result = -1;
+	}
+	return( result );
+#endif /* defined( HAVE_LIBDEFLATE ) */
+}
+
+/* Decompresses data using the compression method
+ * Deflate decompression reuses the libdeflate decompressor or zlib stream of
+ * the context instead of setting up a new one for every call
+ * Returns 1 on success, 0 if buffer is too small or -1 on error
+ */
+int libewf_compression_context_decompress_data(
+     libewf_compression_context_t *compression_context,
+     const uint8_t *compressed_data,
+     size_t compressed_data_size,
+     uint16_t compression_method,
+     uint8_t *uncompressed_data,
+     size_t *uncompressed_data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_compression_context_decompress_data";
+	int result            = 0;
+
+	if( compression_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression context.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBDEFLATE )
+	if( ( compression_method != LIBEWF_COMPRESSION_METHOD_DEFLATE )
+	 || ( compressed_data == NULL )
+	 || ( uncompressed_data == NULL )
+	 || ( uncompressed_data_size == NULL )
+	 || ( uncompressed_data == compressed_data ) )
+#elif ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_UNCOMPRESS ) ) || defined( ZLIB_DLL )
+	/* The zlib stream uses 32-bit buffer sizes, larger buffers are handled by uncompress
+	 */
+	if( ( compression_method != LIBEWF_COMPRESSION_METHOD_DEFLATE )
+	 || ( compressed_data == NULL )
+	 || ( uncompressed_data == NULL )
+	 || ( uncompressed_data_size == NULL )
+	 || ( uncompressed_data == compressed_data )
+	 || ( compressed_data_size > (size_t) UINT_MAX )
+	 || ( *uncompressed_data_size > (size_t) UINT_MAX ) )
+#endif
+	{
+		/* Note that libewf_decompress_data can return -1 without setting
+		 * an error on a data error
+		 */
+		return( libewf_decompress_data(
+		         compressed_data,
+		         compressed_data_size,
+		         compression_method,
+		         uncompressed_data,
+		         uncompressed_data_size,
+		         error ) );
+	}
+#if defined( HAVE_LIBDEFLATE )
+	if( compression_context->decompressor == NULL )
+	{
+		compression_context->decompressor = libdeflate_alloc_decompressor();
+
+		if( compression_context->decompressor == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create libdeflate decompressor.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	/* Note that libewf_decompress_data_using_libdeflate can return -1
+	 * without setting an error on a data error
+	 */
+	result = libewf_decompress_data_using_libdeflate(
+	          compression_context->decompressor,
+	          compressed_data,
+	          compressed_data_size,
+	          uncompressed_data,
+	          uncompressed_data_size,
+	          error );
+
+	return( result );
+
+#elif ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_UNCOMPRESS ) ) || defined( ZLIB_DLL )
+	if( compression_context->inflate_stream_is_initialized == 0 )
+	{
+		if( memory_set(
+		     &( compression_context->inflate_stream ),
+		     0,
+		     sizeof( z_stream ) ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear inflate stream.",
+			 function );
+
+			return( -1 );
+		}
+		result = inflateInit(
+		          &( compression_context->inflate_stream ) );
+
+		if( result != Z_OK )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+			 LIBCERROR_COMPRESSION_ERROR_DECOMPRESS_FAILED,
+			 "%s: unable to initialize inflate stream with error: %d.",
+			 function,
+			 result );
+
+			return( -1 );
+		}
+		compression_context->inflate_stream_is_initialized = 1;
+	}
+	else
+	{
+		result = inflateReset(
+		          &( compression_context->inflate_stream ) );
+
+		if( result != Z_OK )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+			 LIBCERROR_COMPRESSION_ERROR_DECOMPRESS_FAILED,
+			 "%s: unable to reset inflate stream with error: %d.",
+			 function,
+			 result );
+
+			return( -1 );
+		}
+	}
+	compression_context->inflate_stream.next_in   = (Bytef *) compressed_data;
+	compression_context->inflate_stream.avail_in  = (uInt) compressed_data_size;
+	compression_context->inflate_stream.next_out  = (Bytef *) uncompressed_data;
+	compression_context->inflate_stream.avail_out = (uInt) *uncompressed_data_size;
+
+	result = inflate(
+	          &( compression_context->inflate_stream ),
+	          Z_FINISH );
+
+	/* Map the inflate result onto the result of uncompress
+	 */
+	if( ( result == Z_NEED_DICT )
+	 || ( ( result == Z_BUF_ERROR )
+	  && ( compression_context->inflate_stream.avail_out != 0 ) ) )
+	{
+		result = Z_DATA_ERROR;
+	}
+	if( result == Z_STREAM_END )
+	{
+		*uncompressed_data_size = (size_t) compression_context->inflate_stream.total_out;
+
+		result = 1;
+	}
+	else if( result == Z_DATA_ERROR )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: unable to read compressed data: data error.\n",
+			 function );
+		}
+#endif
+		*uncompressed_data_size = 0;
+
+		result = -1;
+	}
+	else if( ( result == Z_OK )
+	      || ( result == Z_BUF_ERROR ) )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			"%s: unable to read compressed data: target buffer too small.\n",
+			 function );
+		}
+#endif
+		/* Estimate that a factor 2 enlargement should suffice
+		 */
+		*uncompressed_data_size *= 2;
+
+		result = 0;
+	}
+	else if( result == Z_MEM_ERROR )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to read compressed data: insufficient memory.",
+		 function );
+
+		*uncompressed_data_size = 0;
+
+		result = -1;
+	}
+	else
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+		 LIBCERROR_COMPRESSION_ERROR_DECOMPRESS_FAILED,
+		 "%s: zlib returned undefined error: %d.",
+		 function,
+		 result );
+
+		*uncompressed_data_size = 0;
+
+		result = -1;
+	}
+	return( result );
+#endif /* defined( HAVE_LIBDEFLATE ) */
+}
+
@@ -0,0 +1,118 @@
+/*
+ * Compression context functions
+ *
+ * Copyright (C) 2006-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_COMPRESSION_CONTEXT_H )
+#define _LIBEWF_COMPRESSION_CONTEXT_H
+
+#include <common.h>
+#include <types.h>
+
+#if defined( HAVE_ZLIB ) || defined( ZLIB_DLL )
+#include <zlib.h>
+#endif
+
+#if defined( HAVE_LIBDEFLATE )
+#include <libdeflate.h>
+#endif
+
+#include "libewf_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libewf_compression_context libewf_compression_context_t;
+
+struct libewf_compression_context
+{
+#if defined( HAVE_LIBDEFLATE )
+	/* The libdeflate compressor
+	 */
+	struct libdeflate_compressor *compressor;
+
+	/* The libdeflate compression level of the compressor
+	 */
+	int compressor_level;
+
+	/* The libdeflate decompressor
+	 */
+	struct libdeflate_decompressor *decompressor;
+
+#elif ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_COMPRESS2 ) ) || defined( ZLIB_DLL )
+	/* The zlib deflate stream
+	 */
+	z_stream deflate_stream;
+
+	/* The zlib compression level of the deflate stream
+	 */
+	int deflate_stream_level;
+
+	/* Value to indicate the deflate stream was initialized
+	 */
+	uint8_t deflate_stream_is_initialized;
+#endif
+#if !defined( HAVE_LIBDEFLATE ) && ( ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_UNCOMPRESS ) ) || defined( ZLIB_DLL ) )
+	/* The zlib inflate stream
+	 */
+	z_stream inflate_stream;
+
+	/* Value to indicate the inflate stream was initialized
+	 */
+	uint8_t inflate_stream_is_initialized;
+#endif
+	/* Dummy value to keep the structure non-empty
+	 */
+	uint8_t dummy;
+};
+
+int libewf_compression_context_initialize(
+     libewf_compression_context_t **compression_context,
+     libcerror_error_t **error );
+
+int libewf_compression_context_free(
+     libewf_compression_context_t **compression_context,
+     libcerror_error_t **error );
+
+int libewf_compression_context_compress_data(
+     libewf_compression_context_t *compression_context,
+     uint8_t *compressed_data,
+     size_t *compressed_data_size,
+     uint16_t compression_method,
+     int8_t compression_level,
+     const uint8_t *uncompressed_data,
+     size_t uncompressed_data_size,
+     libcerror_error_t **error );
+
+int libewf_compression_context_decompress_data(
+     libewf_compression_context_t *compression_context,
+     const uint8_t *compressed_data,
+     size_t compressed_data_size,
+     uint16_t compression_method,
+     uint8_t *uncompressed_data,
+     size_t *uncompressed_data_size,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_COMPRESSION_CONTEXT_H ) */
+
@@ -0,0 +1,707 @@
+/*
+ * Compression context pool functions
+ *
+ * Copyright (C) 2006-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_compression_context.h"
+#include "libewf_compression_context_pool.h"
+#include "libewf_definitions.h"
+#include "libewf_libcdata.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+
+/* Creates a compression context pool
+ * Make sure the value compression_context_pool is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_compression_context_pool_initialize(
+     libewf_compression_context_pool_t **compression_context_pool,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_compression_context_pool_initialize";
+
+	if( compression_context_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression context pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( *compression_context_pool != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid compression context pool value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*compression_context_pool = memory_allocate_structure(
+	                             libewf_compression_context_pool_t );
+
+	if( *compression_context_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create compression context pool.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *compression_context_pool,
+	     0,
+	     sizeof( libewf_compression_context_pool_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear compression context pool.",
+		 function );
+
+		memory_free(
+		 *compression_context_pool );
+
+		*compression_context_pool = NULL;
+
+		return( -1 );
+	}
+	if( libcdata_array_initialize(
+	     &( ( *compression_context_pool )->contexts ),
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create contexts array.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *compression_context_pool )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	return( 1 );
+
+on_error:
+	if( *compression_context_pool != NULL )
+	{
+		if( ( *compression_context_pool )->contexts != NULL )
+		{
+			libcdata_array_free(
+			 &( ( *compression_context_pool )->contexts ),
+			 NULL,
+			 NULL );
+		}
+		memory_free(
+		 *compression_context_pool );
+
+		*compression_context_pool = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a compression context pool
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_compression_context_pool_free(
+     libewf_compression_context_pool_t **compression_context_pool,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_compression_context_pool_free";
+	int buffer_index      = 0;
+	int result            = 1;
+
+	if( compression_context_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression context pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( *compression_context_pool != NULL )
+	{
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_free(
+		     &( ( *compression_context_pool )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		if( libcdata_array_free(
+		     &( ( *compression_context_pool )->contexts ),
+		     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_compression_context_free,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free contexts array.",
+			 function );
+
+			result = -1;
+		}
+		for( buffer_index = 0;
+		     buffer_index < ( *compression_context_pool )->number_of_buffers;
+		     buffer_index++ )
+		{
+			memory_free(
+			 ( *compression_context_pool )->buffers[ buffer_index ] );
+		}
+		memory_free(
+		 *compression_context_pool );
+
+		*compression_context_pool = NULL;
+	}
+	return( result );
+}
+
+/* Grabs a compression context from the pool
+ * A new compression context is created if none is available
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_compression_context_pool_grab_context(
+     libewf_compression_context_pool_t *compression_context_pool,
+     libewf_compression_context_t **compression_context,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_compression_context_pool_grab_context";
+	int number_of_entries = 0;
+	int result            = 1;
+
+	if( compression_context_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression context pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( compression_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression context.",
+		 function );
+
+		return( -1 );
+	}
+	*compression_context = NULL;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     compression_context_pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libcdata_array_get_number_of_entries(
+	     compression_context_pool->contexts,
+	     &number_of_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of contexts.",
+		 function );
+
+		result = -1;
+	}
+	else if( number_of_entries > 0 )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     compression_context_pool->contexts,
+		     number_of_entries - 1,
+		     (intptr_t **) compression_context,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve context: %d.",
+			 function,
+			 number_of_entries - 1 );
+
+			result = -1;
+		}
+		else if( libcdata_array_set_entry_by_index(
+		          compression_context_pool->contexts,
+		          number_of_entries - 1,
+		          NULL,
+		          error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set context: %d.",
+			 function,
+			 number_of_entries - 1 );
+
+			*compression_context = NULL;
+
+			result = -1;
+		}
+		else if( libcdata_array_resize(
+		          compression_context_pool->contexts,
+		          number_of_entries - 1,
+		          NULL,
+		          error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+			 "%s: unable to resize contexts array.",
+			 function );
+
+			result = -1;
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     compression_context_pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		result = -1;
+	}
+#endif
+	if( result != 1 )
+	{
+		goto on_error;
+	}
+	if( *compression_context == NULL )
+	{
+		if( libewf_compression_context_initialize(
+		     compression_context,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create compression context.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( *compression_context != NULL )
+	{
+		libewf_compression_context_free(
+		 compression_context,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Releases a compression context back into the pool
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_compression_context_pool_release_context(
+     libewf_compression_context_pool_t *compression_context_pool,
+     libewf_compression_context_t **compression_context,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_compression_context_pool_release_context";
+	int entry_index       = 0;
+	int result            = 1;
+
+	if( compression_context_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression context pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( compression_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression context.",
+		 function );
+
+		return( -1 );
+	}
+	if( *compression_context == NULL )
+	{
+		return( 1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     compression_context_pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libcdata_array_append_entry(
+	     compression_context_pool->contexts,
+	     &entry_index,
+	     (intptr_t *) *compression_context,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append context to array.",
+		 function );
+
+		libewf_compression_context_free(
+		 compression_context,
+		 NULL );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     compression_context_pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		result = -1;
+	}
+#endif
+	*compression_context = NULL;
+
+	return( result );
+}
+
+/* Grabs a buffer of at least the minimum buffer size from the pool
+ * A new buffer is allocated if none of the pooled buffers is large enough
+ * The buffer is owned by the caller and can be freed with memory_free
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_compression_context_pool_grab_buffer(
+     libewf_compression_context_pool_t *compression_context_pool,
+     size_t minimum_buffer_size,
+     uint8_t **buffer,
+     size_t *buffer_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_compression_context_pool_grab_buffer";
+	int buffer_index      = 0;
+
+	if( compression_context_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression context pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( minimum_buffer_size == 0 )
+	 || ( minimum_buffer_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid minimum buffer size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer size.",
+		 function );
+
+		return( -1 );
+	}
+	*buffer      = NULL;
+	*buffer_size = 0;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     compression_context_pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	for( buffer_index = compression_context_pool->number_of_buffers - 1;
+	     buffer_index >= 0;
+	     buffer_index-- )
+	{
+		if( compression_context_pool->buffer_sizes[ buffer_index ] >= minimum_buffer_size )
+		{
+			*buffer      = compression_context_pool->buffers[ buffer_index ];
+			*buffer_size = compression_context_pool->buffer_sizes[ buffer_index ];
+
+			compression_context_pool->number_of_buffers -= 1;
+
+			/* Keep the remaining pooled buffers contiguous
+			 */
+			compression_context_pool->buffers[ buffer_index ]      = compression_context_pool->buffers[ compression_context_pool->number_of_buffers ];
+			compression_context_pool->buffer_sizes[ buffer_index ] = compression_context_pool->buffer_sizes[ compression_context_pool->number_of_buffers ];
+
+			compression_context_pool->buffers[ compression_context_pool->number_of_buffers ]      = NULL;
+			compression_context_pool->buffer_sizes[ compression_context_pool->number_of_buffers ] = 0;
+
+			break;
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     compression_context_pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	if( *buffer == NULL )
+	{
+		*buffer = (uint8_t *) memory_allocate(
+		                       sizeof( uint8_t ) * minimum_buffer_size );
+
+		if( *buffer == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create buffer.",
+			 function );
+
+			goto on_error;
+		}
+		*buffer_size = minimum_buffer_size;
+	}
+	return( 1 );
+
+on_error:
+	if( *buffer != NULL )
+	{
+		memory_free(
+		 *buffer );
+
+		*buffer = NULL;
+	}
+	*buffer_size = 0;
+
+	return( -1 );
+}
+
+/* Releases a buffer back into the pool
+ * The buffer is freed if the pool is full
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_compression_context_pool_release_buffer(
+     libewf_compression_context_pool_t *compression_context_pool,
+     uint8_t **buffer,
+     size_t buffer_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_compression_context_pool_release_buffer";
+	int result            = 1;
+
+	if( compression_context_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression context pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( *buffer == NULL )
+	{
+		return( 1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     compression_context_pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( compression_context_pool->number_of_buffers < LIBEWF_MAXIMUM_NUMBER_OF_POOLED_BUFFERS )
+	{
+		compression_context_pool->buffers[ compression_context_pool->number_of_buffers ]      = *buffer;
+		compression_context_pool->buffer_sizes[ compression_context_pool->number_of_buffers ] = buffer_size;
+
+		compression_context_pool->number_of_buffers += 1;
+
+		*buffer = NULL;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     compression_context_pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		result = -1;
+	}
+#endif
+	if( *buffer != NULL )
+	{
+		memory_free(
+		 *buffer );
+
+		*buffer = NULL;
+	}
+	return( result );
+}
+
@@ -0,0 +1,101 @@
+/*
+ * Compression context pool functions
+ *
+ * Copyright (C) 2006-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_COMPRESSION_CONTEXT_POOL_H )
+#define _LIBEWF_COMPRESSION_CONTEXT_POOL_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_compression_context.h"
+#include "libewf_definitions.h"
+#include "libewf_libcdata.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libewf_compression_context_pool libewf_compression_context_pool_t;
+
+struct libewf_compression_context_pool
+{
+	/* The compression contexts that are currently not in use
+	 */
+	libcdata_array_t *contexts;
+
+	/* The buffers that are currently not in use
+	 */
+	uint8_t *buffers[ LIBEWF_MAXIMUM_NUMBER_OF_POOLED_BUFFERS ];
+
+	/* The sizes of the buffers
+	 */
+	size_t buffer_sizes[ LIBEWF_MAXIMUM_NUMBER_OF_POOLED_BUFFERS ];
+
+	/* The number of buffers
+	 */
+	int number_of_buffers;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* The mutex
+	 */
+	libcthreads_mutex_t *mutex;
+#endif
+};
+
+int libewf_compression_context_pool_initialize(
+     libewf_compression_context_pool_t **compression_context_pool,
+     libcerror_error_t **error );
+
+int libewf_compression_context_pool_free(
+     libewf_compression_context_pool_t **compression_context_pool,
+     libcerror_error_t **error );
+
+int libewf_compression_context_pool_grab_context(
+     libewf_compression_context_pool_t *compression_context_pool,
+     libewf_compression_context_t **compression_context,
+     libcerror_error_t **error );
+
+int libewf_compression_context_pool_release_context(
+     libewf_compression_context_pool_t *compression_context_pool,
+     libewf_compression_context_t **compression_context,
+     libcerror_error_t **error );
+
+int libewf_compression_context_pool_grab_buffer(
+     libewf_compression_context_pool_t *compression_context_pool,
+     size_t minimum_buffer_size,
+     uint8_t **buffer,
+     size_t *buffer_size,
+     libcerror_error_t **error );
+
+int libewf_compression_context_pool_release_buffer(
+     libewf_compression_context_pool_t *compression_context_pool,
+     uint8_t **buffer,
+     size_t buffer_size,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_COMPRESSION_CONTEXT_POOL_H ) */
+
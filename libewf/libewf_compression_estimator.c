@@ -0,0 +1,547 @@
+/*
+ * Compression estimator functions
+ *
+ * Copyright (C) 2006-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_compression_estimator.h"
+#include "libewf_definitions.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+
+/* Creates a compression estimator
+ * Make sure the value compression_estimator is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_compression_estimator_initialize(
+     libewf_compression_estimator_t **compression_estimator,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_compression_estimator_initialize";
+
+	if( compression_estimator == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression estimator.",
+		 function );
+
+		return( -1 );
+	}
+	if( *compression_estimator != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid compression estimator value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*compression_estimator = memory_allocate_structure(
+	                          libewf_compression_estimator_t );
+
+	if( *compression_estimator == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create compression estimator.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *compression_estimator,
+	     0,
+	     sizeof( libewf_compression_estimator_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear compression estimator.",
+		 function );
+
+		memory_free(
+		 *compression_estimator );
+
+		*compression_estimator = NULL;
+
+		return( -1 );
+	}
+	( *compression_estimator )->skip_interval = LIBEWF_COMPRESSION_ESTIMATOR_MINIMUM_SKIP_INTERVAL;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *compression_estimator )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	return( 1 );
+
+on_error:
+	if( *compression_estimator != NULL )
+	{
+		memory_free(
+		 *compression_estimator );
+
+		*compression_estimator = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a compression estimator
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_compression_estimator_free(
+     libewf_compression_estimator_t **compression_estimator,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_compression_estimator_free";
+	int result            = 1;
+
+	if( compression_estimator == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression estimator.",
+		 function );
+
+		return( -1 );
+	}
+	if( *compression_estimator != NULL )
+	{
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_free(
+		     &( ( *compression_estimator )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		memory_free(
+		 *compression_estimator );
+
+		*compression_estimator = NULL;
+	}
+	return( result );
+}
+
+/* Tests if the data is likely to be compressible
+ * The byte value distribution of a number of samples spread over the data is used
+ * to estimate the entropy. Note that this does not detect repeated sequences of
+ * random data, in which case the data is considered incompressible.
+ * Returns 1 if the data is likely compressible, 0 if not or -1 on error
+ */
+int libewf_compression_estimator_test_entropy(
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	uint32_t byte_value_counts[ 256 ];
+
+	static char *function          = "libewf_compression_estimator_test_entropy";
+	size_t data_offset             = 0;
+	size_t sample_distance         = 0;
+	size_t sample_offset           = 0;
+	size_t sample_size             = 0;
+	uint64_t number_of_bytes       = 0;
+	uint64_t sum_of_squared_counts = 0;
+	uint16_t byte_value            = 0;
+	int sample_index               = 0;
+
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size < LIBEWF_COMPRESSION_ESTIMATOR_MINIMUM_DATA_SIZE )
+	{
+		return( 1 );
+	}
+	if( memory_set(
+	     byte_value_counts,
+	     0,
+	     sizeof( uint32_t ) * 256 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear byte value counts.",
+		 function );
+
+		return( -1 );
+	}
+	sample_distance = data_size / LIBEWF_COMPRESSION_ESTIMATOR_NUMBER_OF_SAMPLES;
+	sample_size     = sample_distance;
+
+	if( sample_size > LIBEWF_COMPRESSION_ESTIMATOR_MAXIMUM_SAMPLE_SIZE )
+	{
+		sample_size = LIBEWF_COMPRESSION_ESTIMATOR_MAXIMUM_SAMPLE_SIZE;
+	}
+	for( sample_index = 0;
+	     sample_index < LIBEWF_COMPRESSION_ESTIMATOR_NUMBER_OF_SAMPLES;
+	     sample_index++ )
+	{
+		data_offset = (size_t) sample_index * sample_distance;
+
+		for( sample_offset = 0;
+		     sample_offset < sample_size;
+		     sample_offset++ )
+		{
+			byte_value_counts[ data[ data_offset++ ] ] += 1;
+		}
+	}
+	number_of_bytes = (uint64_t) sample_size * LIBEWF_COMPRESSION_ESTIMATOR_NUMBER_OF_SAMPLES;
+
+	for( byte_value = 0;
+	     byte_value < 256;
+	     byte_value++ )
+	{
+		sum_of_squared_counts += (uint64_t) byte_value_counts[ byte_value ] * byte_value_counts[ byte_value ];
+	}
+	/* For uniformly distributed byte values 256 * sum_of_squared_counts is expected
+	 * to be N * N + 255 * N, where N is the number of sampled bytes. The margin of
+	 * N * N / 8 corresponds with an estimated entropy of about 7.8 bits per byte,
+	 * which deflate is unlikely to reduce in size.
+	 */
+	if( ( 256 * sum_of_squared_counts ) <= ( ( number_of_bytes * number_of_bytes ) + ( 255 * number_of_bytes ) + ( ( number_of_bytes * number_of_bytes ) / 8 ) ) )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Updates the adaptive compression state
+ * This function expects the mutex to be held by the caller
+ */
+static void libewf_compression_estimator_update_state(
+             libewf_compression_estimator_t *compression_estimator,
+             uint8_t is_compressible )
+{
+	if( is_compressible != 0 )
+	{
+		compression_estimator->number_of_incompressible_chunks = 0;
+		compression_estimator->skip_interval                   = LIBEWF_COMPRESSION_ESTIMATOR_MINIMUM_SKIP_INTERVAL;
+	}
+	else
+	{
+		compression_estimator->number_of_incompressible_chunks += 1;
+
+		if( compression_estimator->number_of_incompressible_chunks >= LIBEWF_COMPRESSION_ESTIMATOR_INCOMPRESSIBLE_THRESHOLD )
+		{
+			compression_estimator->number_of_chunks_to_skip = compression_estimator->skip_interval;
+
+			if( compression_estimator->skip_interval < LIBEWF_COMPRESSION_ESTIMATOR_MAXIMUM_SKIP_INTERVAL )
+			{
+				compression_estimator->skip_interval *= 2;
+			}
+			/* A single failed probe suffices to resume skipping
+			 */
+			compression_estimator->number_of_incompressible_chunks = LIBEWF_COMPRESSION_ESTIMATOR_INCOMPRESSIBLE_THRESHOLD - 1;
+		}
+	}
+}
+
+/* Checks if compressing the chunk data is worth the effort
+ * Returns 1 if the data should be compressed, 0 if not or -1 on error
+ */
+int libewf_compression_estimator_check_data(
+     libewf_compression_estimator_t *compression_estimator,
+     uint8_t compression_flags,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_compression_estimator_check_data";
+	int result            = 1;
+
+	if( compression_estimator == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression estimator.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( compression_flags & ( LIBEWF_COMPRESS_FLAG_USE_ENTROPY_TEST | LIBEWF_COMPRESS_FLAG_USE_ADAPTIVE_COMPRESSION ) ) == 0 )
+	{
+		return( 1 );
+	}
+	if( ( compression_flags & LIBEWF_COMPRESS_FLAG_USE_ENTROPY_TEST ) != 0 )
+	{
+		result = libewf_compression_estimator_test_entropy(
+		          data,
+		          data_size,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to test entropy of data.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     compression_estimator->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( ( ( compression_flags & LIBEWF_COMPRESS_FLAG_USE_ADAPTIVE_COMPRESSION ) != 0 )
+	 && ( compression_estimator->number_of_chunks_to_skip > 0 ) )
+	{
+		compression_estimator->number_of_chunks_to_skip -= 1;
+		compression_estimator->number_of_adaptive_skips += 1;
+
+		result = 0;
+	}
+	else if( result == 0 )
+	{
+		compression_estimator->number_of_entropy_skips += 1;
+
+		if( ( compression_flags & LIBEWF_COMPRESS_FLAG_USE_ADAPTIVE_COMPRESSION ) != 0 )
+		{
+			libewf_compression_estimator_update_state(
+			 compression_estimator,
+			 0 );
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     compression_estimator->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Updates the compression estimator with the outcome of compressing chunk data
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_compression_estimator_update(
+     libewf_compression_estimator_t *compression_estimator,
+     uint8_t compression_flags,
+     uint8_t is_compressible,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_compression_estimator_update";
+
+	if( compression_estimator == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression estimator.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( compression_flags & LIBEWF_COMPRESS_FLAG_USE_ADAPTIVE_COMPRESSION ) == 0 )
+	{
+		return( 1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     compression_estimator->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	libewf_compression_estimator_update_state(
+	 compression_estimator,
+	 is_compressible );
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     compression_estimator->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Retrieves the number of chunks for which compression was skipped
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_compression_estimator_get_statistics(
+     libewf_compression_estimator_t *compression_estimator,
+     uint64_t *number_of_entropy_skips,
+     uint64_t *number_of_adaptive_skips,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_compression_estimator_get_statistics";
+
+	if( compression_estimator == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression estimator.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_entropy_skips == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of entropy skips.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_adaptive_skips == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of adaptive skips.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     compression_estimator->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*number_of_entropy_skips  = compression_estimator->number_of_entropy_skips;
+	*number_of_adaptive_skips = compression_estimator->number_of_adaptive_skips;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     compression_estimator->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
@@ -0,0 +1,123 @@
+/*
+ * Compression estimator functions
+ *
+ * Copyright (C) 2006-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_COMPRESSION_ESTIMATOR_H )
+#define _LIBEWF_COMPRESSION_ESTIMATOR_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The number and size of the samples used by the entropy test
+ */
+#define LIBEWF_COMPRESSION_ESTIMATOR_NUMBER_OF_SAMPLES		16
+#define LIBEWF_COMPRESSION_ESTIMATOR_MAXIMUM_SAMPLE_SIZE	256
+
+/* Data smaller than the minimum size is always considered compressible
+ */
+#define LIBEWF_COMPRESSION_ESTIMATOR_MINIMUM_DATA_SIZE		1024
+
+/* The number of consecutive incompressible chunks after which adaptive
+ * compression stops compressing
+ */
+#define LIBEWF_COMPRESSION_ESTIMATOR_INCOMPRESSIBLE_THRESHOLD	8
+
+/* The number of chunks that are not compressed before compression is probed again,
+ * the interval is doubled every time the probe fails
+ */
+#define LIBEWF_COMPRESSION_ESTIMATOR_MINIMUM_SKIP_INTERVAL	16
+#define LIBEWF_COMPRESSION_ESTIMATOR_MAXIMUM_SKIP_INTERVAL	1024
+
+typedef struct libewf_compression_estimator libewf_compression_estimator_t;
+
+struct libewf_compression_estimator
+{
+	/* The number of consecutive incompressible chunks
+	 */
+	uint32_t number_of_incompressible_chunks;
+
+	/* The number of chunks that remain to be skipped
+	 */
+	uint32_t number_of_chunks_to_skip;
+
+	/* The current skip interval
+	 */
+	uint32_t skip_interval;
+
+	/* The number of chunks skipped by the entropy test
+	 */
+	uint64_t number_of_entropy_skips;
+
+	/* The number of chunks skipped by adaptive compression
+	 */
+	uint64_t number_of_adaptive_skips;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* The mutex
+	 */
+	libcthreads_mutex_t *mutex;
+#endif
+};
+
+int libewf_compression_estimator_initialize(
+     libewf_compression_estimator_t **compression_estimator,
+     libcerror_error_t **error );
+
+int libewf_compression_estimator_free(
+     libewf_compression_estimator_t **compression_estimator,
+     libcerror_error_t **error );
+
+int libewf_compression_estimator_test_entropy(
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int libewf_compression_estimator_check_data(
+     libewf_compression_estimator_t *compression_estimator,
+     uint8_t compression_flags,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int libewf_compression_estimator_update(
+     libewf_compression_estimator_t *compression_estimator,
+     uint8_t compression_flags,
+     uint8_t is_compressible,
+     libcerror_error_t **error );
+
+int libewf_compression_estimator_get_statistics(
+     libewf_compression_estimator_t *compression_estimator,
+     uint64_t *number_of_entropy_skips,
+     uint64_t *number_of_adaptive_skips,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_COMPRESSION_ESTIMATOR_H ) */
+
@@ -0,0 +1,217 @@
+/*
+ * Compression job functions
+ *
+ * Copyright (C) 2006-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_chunk_data.h"
+#include "libewf_compression_job.h"
+#include "libewf_io_handle.h"
+#include "libewf_libcerror.h"
+#include "libewf_write_io_handle.h"
+
+/* Creates a compression job
+ * Make sure the value compression_job is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_compression_job_initialize(
+     libewf_compression_job_t **compression_job,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_compression_job_initialize";
+
+	if( compression_job == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression job.",
+		 function );
+
+		return( -1 );
+	}
+	if( *compression_job != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid compression job value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*compression_job = memory_allocate_structure(
+	                      libewf_compression_job_t );
+
+	if( *compression_job == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create compression job.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *compression_job,
+	     0,
+	     sizeof( libewf_compression_job_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear compression job.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *compression_job != NULL )
+	{
+		memory_free(
+		 *compression_job );
+
+		*compression_job = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a compression job
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_compression_job_free(
+     libewf_compression_job_t **compression_job,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_compression_job_free";
+	int result            = 1;
+
+	if( compression_job == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression job.",
+		 function );
+
+		return( -1 );
+	}
+	if( *compression_job != NULL )
+	{
+		if( ( *compression_job )->chunk_data != NULL )
+		{
+			if( libewf_chunk_data_free(
+			     &( ( *compression_job )->chunk_data ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free chunk data.",
+				 function );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 *compression_job );
+
+		*compression_job = NULL;
+	}
+	return( result );
+}
+
+/* Runs a compression job
+ * Packs the chunk data, which either adds the checksum or compresses the chunk data
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_compression_job_run(
+     libewf_compression_job_t *compression_job,
+     libewf_io_handle_t *io_handle,
+     libewf_write_io_handle_t *write_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_compression_job_run";
+
+	if( compression_job == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression job.",
+		 function );
+
+		return( -1 );
+	}
+	if( compression_job->chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid compression job - missing chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( write_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_chunk_data_pack(
+	     compression_job->chunk_data,
+	     io_handle,
+	     write_io_handle->compressed_zero_byte_empty_block,
+	     write_io_handle->compressed_zero_byte_empty_block_size,
+	     write_io_handle->pack_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to pack chunk: %" PRIu64 " data.",
+		 function,
+		 compression_job->chunk_index );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
@@ -0,0 +1,210 @@
+/*
+ * CPU features functions
+ *
+ * Copyright (C) 2006-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_cpu_features.h"
+
+#if defined( HAVE_LIBEWF_SSE2_SUPPORT ) || defined( HAVE_LIBEWF_AVX2_SUPPORT )
+#if defined( _MSC_VER )
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+#if defined( __clang__ ) || ( defined( __GNUC__ ) && ( ( __GNUC__ > 4 ) || ( ( __GNUC__ == 4 ) && ( __GNUC_MINOR__ >= 7 ) ) ) )
+#define libewf_cpu_features_atomic_load( value ) \
+	__atomic_load_n( value, __ATOMIC_RELAXED )
+
+#define libewf_cpu_features_atomic_store( value, new_value ) \
+	__atomic_store_n( value, new_value, __ATOMIC_RELAXED )
+#else
+#define libewf_cpu_features_atomic_load( value ) \
+	*( value )
+
+#define libewf_cpu_features_atomic_store( value, new_value ) \
+	*( value ) = new_value
+#endif
+
+/* The detected CPU features, the value is determined once
+ */
+static uint32_t libewf_cpu_features_flags = 0;
+
+#if defined( HAVE_LIBEWF_SSE2_SUPPORT ) || defined( HAVE_LIBEWF_AVX2_SUPPORT )
+
+/* Retrieves the x86 CPUID registers of a specific leaf and sub leaf
+ * Returns 1 if successful or 0 if the leaf is not supported
+ */
+static int libewf_cpu_features_get_cpuid(
+            uint32_t leaf,
+            uint32_t sub_leaf,
+            uint32_t registers[ 4 ] )
+{
+#if defined( _MSC_VER )
+	int cpuid_registers[ 4 ];
+
+	__cpuid(
+	 cpuid_registers,
+	 0 );
+
+	if( (uint32_t) cpuid_registers[ 0 ] < leaf )
+	{
+		return( 0 );
+	}
+	__cpuidex(
+	 cpuid_registers,
+	 (int) leaf,
+	 (int) sub_leaf );
+
+	registers[ 0 ] = (uint32_t) cpuid_registers[ 0 ];
+	registers[ 1 ] = (uint32_t) cpuid_registers[ 1 ];
+	registers[ 2 ] = (uint32_t) cpuid_registers[ 2 ];
+	registers[ 3 ] = (uint32_t) cpuid_registers[ 3 ];
+#else
+	unsigned int eax = 0;
+	unsigned int ebx = 0;
+	unsigned int ecx = 0;
+	unsigned int edx = 0;
+
+	if( __get_cpuid_max(
+	     0,
+	     NULL ) < leaf )
+	{
+		return( 0 );
+	}
+	__cpuid_count(
+	 leaf,
+	 sub_leaf,
+	 eax,
+	 ebx,
+	 ecx,
+	 edx );
+
+	registers[ 0 ] = (uint32_t) eax;
+	registers[ 1 ] = (uint32_t) ebx;
+	registers[ 2 ] = (uint32_t) ecx;
+	registers[ 3 ] = (uint32_t) edx;
+#endif
+	return( 1 );
+}
+
+/* Retrieves the x86 extended control register 0 (XCR0)
+ */
+static uint64_t libewf_cpu_features_get_xcr0(
+                 void )
+{
+#if defined( _MSC_VER )
+	return( (uint64_t) _xgetbv( 0 ) );
+#else
+	uint32_t eax = 0;
+	uint32_t edx = 0;
+
+	/* xgetbv is encoded as bytes to support assemblers that do not know the mnemonic
+	 */
+	__asm__ __volatile__ (
+	 ".byte 0x0f, 0x01, 0xd0"
+	 : "=a" ( eax ), "=d" ( edx )
+	 : "c" ( 0 ) );
+
+	return( ( (uint64_t) edx << 32 ) | eax );
+#endif
+}
+
+#endif /* defined( HAVE_LIBEWF_SSE2_SUPPORT ) || defined( HAVE_LIBEWF_AVX2_SUPPORT ) */
+
+/* Detects the CPU features supported by the CPU and the operating system
+ * Returns the CPU feature flags
+ */
+static uint32_t libewf_cpu_features_detect(
+                 void )
+{
+#if defined( HAVE_LIBEWF_SSE2_SUPPORT ) || defined( HAVE_LIBEWF_AVX2_SUPPORT )
+	uint32_t registers[ 4 ];
+#endif
+
+	uint32_t flags = 0;
+
+#if defined( HAVE_LIBEWF_SSE2_SUPPORT ) || defined( HAVE_LIBEWF_AVX2_SUPPORT )
+	if( libewf_cpu_features_get_cpuid(
+	     1,
+	     0,
+	     registers ) != 0 )
+	{
+		/* EDX bit 26 indicates SSE2
+		 */
+		if( ( registers[ 3 ] & 0x04000000UL ) != 0 )
+		{
+			flags |= LIBEWF_CPU_FEATURE_FLAG_SSE2;
+		}
+		/* AVX2 requires ECX bit 27 (OSXSAVE) and bit 28 (AVX) and the operating
+		 * system to preserve the XMM and YMM registers (XCR0 bits 1 and 2)
+		 */
+		if( ( ( registers[ 2 ] & 0x18000000UL ) == 0x18000000UL )
+		 && ( ( libewf_cpu_features_get_xcr0() & 0x06 ) == 0x06 ) )
+		{
+			/* Leaf 7 EBX bit 5 indicates AVX2
+			 */
+			if( libewf_cpu_features_get_cpuid(
+			     7,
+			     0,
+			     registers ) != 0 )
+			{
+				if( ( registers[ 1 ] & 0x00000020UL ) != 0 )
+				{
+					flags |= LIBEWF_CPU_FEATURE_FLAG_AVX2;
+				}
+			}
+		}
+	}
+#endif
+#if defined( HAVE_LIBEWF_NEON_SUPPORT )
+	flags |= LIBEWF_CPU_FEATURE_FLAG_NEON;
+#endif
+	return( flags );
+}
+
+/* Retrieves the CPU feature flags
+ * The features are detected on the first call, subsequent calls return the cached value
+ * Returns the CPU feature flags
+ */
+uint32_t libewf_cpu_features_get_flags(
+          void )
+{
+	uint32_t flags = 0;
+
+	flags = libewf_cpu_features_atomic_load(
+	         &libewf_cpu_features_flags );
+
+	if( ( flags & LIBEWF_CPU_FEATURE_FLAG_IS_DETECTED ) == 0 )
+	{
+		/* Concurrent callers detect the same value, hence the last store wins
+		 */
+		flags = libewf_cpu_features_detect() | LIBEWF_CPU_FEATURE_FLAG_IS_DETECTED;
+
+		libewf_cpu_features_atomic_store(
+		 &libewf_cpu_features_flags,
+		 flags );
+	}
+	return( flags & ~( (uint32_t) LIBEWF_CPU_FEATURE_FLAG_IS_DETECTED ) );
+}
+
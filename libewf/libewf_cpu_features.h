@@ -0,0 +1,77 @@
+/*
+ * CPU features functions
+ *
+ * Copyright (C) 2006-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_CPU_FEATURES_H )
+#define _LIBEWF_CPU_FEATURES_H
+
+#include <common.h>
+#include <types.h>
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The x86 SSE2 and AVX2 kernels are compiled using function target attributes
+ * so that the rest of the library does not require -msse2 or -mavx2
+ */
+#if ( defined( __x86_64__ ) || defined( __i386__ ) ) \
+ && ( defined( __clang__ ) || ( defined( __GNUC__ ) && ( ( __GNUC__ > 4 ) || ( ( __GNUC__ == 4 ) && ( __GNUC_MINOR__ >= 9 ) ) ) ) )
+#define HAVE_LIBEWF_SSE2_SUPPORT
+#define HAVE_LIBEWF_AVX2_SUPPORT
+
+#define LIBEWF_ATTRIBUTE_TARGET_SSE2	__attribute__ ((target ("sse2")))
+#define LIBEWF_ATTRIBUTE_TARGET_AVX2	__attribute__ ((target ("avx2")))
+
+#elif defined( _MSC_VER ) && ( _MSC_VER >= 1800 ) && ( defined( _M_X64 ) || defined( _M_IX86 ) )
+#define HAVE_LIBEWF_SSE2_SUPPORT
+#define HAVE_LIBEWF_AVX2_SUPPORT
+
+#define LIBEWF_ATTRIBUTE_TARGET_SSE2
+#define LIBEWF_ATTRIBUTE_TARGET_AVX2
+
+#endif
+
+/* NEON is part of the base AArch64 instruction set
+ */
+#if ( defined( __aarch64__ ) && !defined( __AARCH64EB__ ) ) || defined( _M_ARM64 )
+#define HAVE_LIBEWF_NEON_SUPPORT
+#endif
+
+enum LIBEWF_CPU_FEATURE_FLAGS
+{
+	LIBEWF_CPU_FEATURE_FLAG_SSE2		= 0x01,
+	LIBEWF_CPU_FEATURE_FLAG_AVX2		= 0x02,
+	LIBEWF_CPU_FEATURE_FLAG_NEON		= 0x04,
+
+	/* Used internally to indicate the features were detected
+	 */
+	LIBEWF_CPU_FEATURE_FLAG_IS_DETECTED	= 0x80
+};
+
+uint32_t libewf_cpu_features_get_flags(
+          void );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_CPU_FEATURES_H ) */
+
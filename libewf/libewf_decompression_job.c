@@ -0,0 +1,250 @@
+/*
+ * Decompression job functions
+ *
+ * Copyright (C) 2006-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_chunk_data.h"
+#include "libewf_decompression_job.h"
+#include "libewf_io_handle.h"
+#include "libewf_libcerror.h"
+
+/* Creates a decompression job
+ * Make sure the value decompression_job is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_decompression_job_initialize(
+     libewf_decompression_job_t **decompression_job,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_decompression_job_initialize";
+
+	if( decompression_job == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid decompression job.",
+		 function );
+
+		return( -1 );
+	}
+	if( *decompression_job != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid decompression job value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*decompression_job = memory_allocate_structure(
+	                      libewf_decompression_job_t );
+
+	if( *decompression_job == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create decompression job.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *decompression_job,
+	     0,
+	     sizeof( libewf_decompression_job_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear decompression job.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *decompression_job != NULL )
+	{
+		memory_free(
+		 *decompression_job );
+
+		*decompression_job = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a decompression job
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_decompression_job_free(
+     libewf_decompression_job_t **decompression_job,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_decompression_job_free";
+	int result            = 1;
+
+	if( decompression_job == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid decompression job.",
+		 function );
+
+		return( -1 );
+	}
+	if( *decompression_job != NULL )
+	{
+		if( ( *decompression_job )->chunk_data != NULL )
+		{
+			if( libewf_chunk_data_free(
+			     &( ( *decompression_job )->chunk_data ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free chunk data.",
+				 function );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 *decompression_job );
+
+		*decompression_job = NULL;
+	}
+	return( result );
+}
+
+/* Runs a decompression job
+ * Unpacks the chunk data and copies the requested part into the buffer
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_decompression_job_run(
+     libewf_decompression_job_t *decompression_job,
+     libewf_io_handle_t *io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_decompression_job_run";
+
+	if( decompression_job == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid decompression job.",
+		 function );
+
+		return( -1 );
+	}
+	if( decompression_job->chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid decompression job - missing chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( decompression_job->buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid decompression job - missing buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( decompression_job->chunk_data_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid decompression job - chunk data offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_chunk_data_unpack(
+	     decompression_job->chunk_data,
+	     io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to unpack chunk: %" PRIu64 " data.",
+		 function,
+		 decompression_job->chunk_index );
+
+		return( -1 );
+	}
+	if( ( (size64_t) decompression_job->chunk_data_offset + decompression_job->buffer_size ) > (size64_t) decompression_job->chunk_data->data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: chunk: %" PRIu64 " offset and size exceed data size.",
+		 function,
+		 decompression_job->chunk_index );
+
+		return( -1 );
+	}
+	if( memory_copy(
+	     decompression_job->buffer,
+	     &( ( decompression_job->chunk_data->data )[ decompression_job->chunk_data_offset ] ),
+	     decompression_job->buffer_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy chunk: %" PRIu64 " data to buffer.",
+		 function,
+		 decompression_job->chunk_index );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
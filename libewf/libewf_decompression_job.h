@@ -0,0 +1,86 @@
+/*
+ * Decompression job functions
+ *
+ * Copyright (C) 2006-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_DECOMPRESSION_JOB_H )
+#define _LIBEWF_DECOMPRESSION_JOB_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_chunk_data.h"
+#include "libewf_io_handle.h"
+#include "libewf_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libewf_decompression_job libewf_decompression_job_t;
+
+/* The decompression job unpacks a single chunk and copies
+ * the requested part of its data into the (read) buffer
+ */
+struct libewf_decompression_job
+{
+	/* The chunk index
+	 */
+	uint64_t chunk_index;
+
+	/* The chunk data
+	 */
+	libewf_chunk_data_t *chunk_data;
+
+	/* The offset relative to the start of the chunk data
+	 */
+	off64_t chunk_data_offset;
+
+	/* The buffer
+	 */
+	uint8_t *buffer;
+
+	/* The buffer size
+	 */
+	size_t buffer_size;
+
+	/* The result of the job
+	 */
+	int result;
+};
+
+int libewf_decompression_job_initialize(
+     libewf_decompression_job_t **decompression_job,
+     libcerror_error_t **error );
+
+int libewf_decompression_job_free(
+     libewf_decompression_job_t **decompression_job,
+     libcerror_error_t **error );
+
+int libewf_decompression_job_run(
+     libewf_decompression_job_t *decompression_job,
+     libewf_io_handle_t *io_handle,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_DECOMPRESSION_JOB_H ) */
+
@@ -24,6 +24,7 @@
 #include <memory.h>
 #include <types.h>
 
+#include "libewf_checksum.h"
 #include "libewf_deflate.h"
 #include "libewf_libcerror.h"
 
@@ -134,12 +135,26 @@ int libewf_deflate_huffman_table_construct(
 {
 	int code_offsets_array[ 16 ];
 
-	static char *function = "libewf_deflate_huffman_table_construct";
-	uint16_t code_size    = 0;
-	uint8_t bit_index     = 0;
-	int code_offset       = 0;
-	int left_value        = 0;
-	int symbol            = 0;
+	static char *function     = "libewf_deflate_huffman_table_construct";
+	uint32_t lookup_entry     = 0;
+	uint16_t code_size        = 0;
+	uint8_t bit_index         = 0;
+	uint8_t maximum_code_size = 0;
+	uint8_t next_code_size    = 0;
+	uint8_t sub_table_bits    = 0;
+	int code_index            = 0;
+	int code_offset           = 0;
+	int huffman_code          = 0;
+	int left_value            = 0;
+	int lookup_index          = 0;
+	int lookup_table_size     = 0;
+	int next_huffman_code     = 0;
+	int number_of_next_codes  = 0;
+	int reversed_huffman_code = 0;
+	int size_index            = 0;
+	int sub_table_offset      = 0;
+	int sub_table_prefix      = -1;
+	int symbol                = 0;
 
 	if( table == NULL )
 	{
@@ -309,6 +324,147 @@ int libewf_deflate_huffman_table_construct(
 		code_offsets_array[ code_size ]  += 1;
 		table->codes_array[ code_offset ] = symbol;
 	}
+	/* Build the lookup table from the canonical Huffman codes, codes that
+	 * are larger than the primary lookup table are stored in sub tables
+	 */
+	for( bit_index = 1;
+	     bit_index <= table->maximum_number_of_bits;
+	     bit_index++ )
+	{
+		if( table->code_counts_array[ bit_index ] != 0 )
+		{
+			maximum_code_size = bit_index;
+		}
+	}
+	if( maximum_code_size < LIBEWF_DEFLATE_HUFFMAN_LOOKUP_TABLE_BITS )
+	{
+		table->number_of_lookup_bits = maximum_code_size;
+	}
+	else
+	{
+		table->number_of_lookup_bits = LIBEWF_DEFLATE_HUFFMAN_LOOKUP_TABLE_BITS;
+	}
+	lookup_table_size = 1 << table->number_of_lookup_bits;
+
+	if( memory_set(
+	     table->lookup_table,
+	     0,
+	     sizeof( uint32_t ) * lookup_table_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear lookup table.",
+		 function );
+
+		return( -1 );
+	}
+	sub_table_offset = lookup_table_size;
+
+	for( code_size = 1;
+	     code_size <= maximum_code_size;
+	     code_size++ )
+	{
+		for( size_index = 0;
+		     size_index < table->code_counts_array[ code_size ];
+		     size_index++ )
+		{
+			symbol = table->codes_array[ code_index++ ];
+
+			/* The bit stream stores the most significant bit of the code first
+			 */
+			reversed_huffman_code = 0;
+
+			for( bit_index = 0;
+			     bit_index < code_size;
+			     bit_index++ )
+			{
+				reversed_huffman_code <<= 1;
+				reversed_huffman_code  |= ( huffman_code >> bit_index ) & 0x00000001UL;
+			}
+			if( code_size <= table->number_of_lookup_bits )
+			{
+				lookup_entry = ( (uint32_t) code_size << 16 ) | (uint32_t) symbol;
+
+				for( lookup_index = reversed_huffman_code;
+				     lookup_index < lookup_table_size;
+				     lookup_index += 1 << code_size )
+				{
+					table->lookup_table[ lookup_index ] = lookup_entry;
+				}
+			}
+			else
+			{
+				if( ( huffman_code >> ( code_size - table->number_of_lookup_bits ) ) != sub_table_prefix )
+				{
+					sub_table_prefix = huffman_code >> ( code_size - table->number_of_lookup_bits );
+
+					/* The sub table is sized for the largest code with the same prefix
+					 */
+					sub_table_bits       = (uint8_t) ( code_size - table->number_of_lookup_bits );
+					next_huffman_code    = huffman_code;
+					next_code_size       = (uint8_t) code_size;
+					number_of_next_codes = table->code_counts_array[ code_size ] - size_index;
+
+					while( next_code_size <= maximum_code_size )
+					{
+						next_huffman_code    += 1;
+						number_of_next_codes -= 1;
+
+						while( ( number_of_next_codes == 0 )
+						    && ( next_code_size < maximum_code_size ) )
+						{
+							next_huffman_code  <<= 1;
+							next_code_size      += 1;
+							number_of_next_codes = table->code_counts_array[ next_code_size ];
+						}
+						if( ( number_of_next_codes == 0 )
+						 || ( ( next_huffman_code >> ( next_code_size - table->number_of_lookup_bits ) ) != sub_table_prefix ) )
+						{
+							break;
+						}
+						sub_table_bits = (uint8_t) ( next_code_size - table->number_of_lookup_bits );
+					}
+					if( ( sub_table_offset + ( 1 << sub_table_bits ) ) > LIBEWF_DEFLATE_HUFFMAN_LOOKUP_TABLE_SIZE )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+						 "%s: invalid sub table offset value out of bounds.",
+						 function );
+
+						return( -1 );
+					}
+					for( lookup_index = 0;
+					     lookup_index < ( 1 << sub_table_bits );
+					     lookup_index++ )
+					{
+						table->lookup_table[ sub_table_offset + lookup_index ] = 0;
+					}
+					lookup_index = reversed_huffman_code & ( lookup_table_size - 1 );
+
+					table->lookup_table[ lookup_index ] = LIBEWF_DEFLATE_HUFFMAN_LOOKUP_ENTRY_FLAG_SUB_TABLE
+					                                    | ( (uint32_t) sub_table_bits << 16 )
+					                                    | (uint32_t) sub_table_offset;
+
+					sub_table_offset += 1 << sub_table_bits;
+				}
+				lookup_index = (int) ( table->lookup_table[ reversed_huffman_code & ( lookup_table_size - 1 ) ] & 0x0000ffffUL );
+				lookup_entry = ( (uint32_t) ( code_size - table->number_of_lookup_bits ) << 16 ) | (uint32_t) symbol;
+
+				for( reversed_huffman_code >>= table->number_of_lookup_bits;
+				     reversed_huffman_code < ( 1 << sub_table_bits );
+				     reversed_huffman_code += 1 << ( code_size - table->number_of_lookup_bits ) )
+				{
+					table->lookup_table[ lookup_index + reversed_huffman_code ] = lookup_entry;
+				}
+			}
+			huffman_code++;
+		}
+		huffman_code <<= 1;
+	}
 /* TODO only used by dynamic Huffman
 	if( left_value > 0 )
 	{
@@ -335,15 +491,9 @@ int libewf_deflate_bit_stream_get_huffman_encoded_value(
      libcerror_error_t **error )
 {
 	static char *function     = "libewf_deflate_bit_stream_get_huffman_encoded_value";
-	uint32_t bit_buffer       = 0;
+	uint32_t lookup_entry     = 0;
 	uint32_t safe_value_32bit = 0;
-	uint8_t bit_index         = 0;
 	uint8_t number_of_bits    = 0;
-	int code_size_count       = 0;
-	int first_huffman_code    = 0;
-	int first_index           = 0;
-	int huffman_code          = 0;
-	int result                = 0;
 
 	if( bit_stream == NULL )
 	{
@@ -392,44 +542,21 @@ int libewf_deflate_bit_stream_get_huffman_encoded_value(
 		bit_stream->bit_buffer      |= safe_value_32bit;
 		bit_stream->bit_buffer_size += 8;
 	}
-	if( table->maximum_number_of_bits < bit_stream->bit_buffer_size )
-	{
-		number_of_bits = table->maximum_number_of_bits;
-	}
-	else
-	{
-		number_of_bits = bit_stream->bit_buffer_size;
-	}
-	bit_buffer = bit_stream->bit_buffer;
+	lookup_entry = table->lookup_table[ bit_stream->bit_buffer & ( ( 1UL << table->number_of_lookup_bits ) - 1 ) ];
 
-	for( bit_index = 1;
-	     bit_index <= number_of_bits;
-	     bit_index++ )
+	if( ( lookup_entry & LIBEWF_DEFLATE_HUFFMAN_LOOKUP_ENTRY_FLAG_SUB_TABLE ) != 0 )
 	{
-		huffman_code <<= 1;
-		huffman_code  |= (int) bit_buffer & 0x00000001UL;
-		bit_buffer   >>= 1;
-
-		code_size_count = table->code_counts_array[ bit_index ];
-
-		if( ( huffman_code - code_size_count ) < first_huffman_code )
-		{
-			safe_value_32bit = table->codes_array[ first_index + ( huffman_code - first_huffman_code ) ];
+		safe_value_32bit = bit_stream->bit_buffer >> table->number_of_lookup_bits;
+		safe_value_32bit &= ( 1UL << ( ( lookup_entry >> 16 ) & 0x000000ffUL ) ) - 1;
 
-			result = 1;
+		lookup_entry = table->lookup_table[ ( lookup_entry & 0x0000ffffUL ) + safe_value_32bit ];
 
-			break;
-		}
-		first_huffman_code  += code_size_count;
-		first_huffman_code <<= 1;
-		first_index         += code_size_count;
-	}
-	if( result != 0 )
-	{
-		bit_stream->bit_buffer     >>= bit_index;
-		bit_stream->bit_buffer_size -= bit_index;
+		number_of_bits = table->number_of_lookup_bits;
 	}
-	if( result != 1 )
+	number_of_bits += (uint8_t) ( ( lookup_entry >> 16 ) & 0x000000ffUL );
+
+	if( ( lookup_entry == 0 )
+	 || ( number_of_bits > bit_stream->bit_buffer_size ) )
 	{
 		libcerror_error_set(
 		 error,
@@ -440,7 +567,10 @@ int libewf_deflate_bit_stream_get_huffman_encoded_value(
 
 		return( -1 );
 	}
-	*value_32bit = safe_value_32bit;
+	bit_stream->bit_buffer     >>= number_of_bits;
+	bit_stream->bit_buffer_size -= number_of_bits;
+
+	*value_32bit = lookup_entry & 0x0000ffffUL;
 
 	return( 1 );
 }
@@ -808,6 +938,9 @@ int libewf_deflate_initialize_fixed_huffman_tables(
 }
 
 /* Decodes a Huffman compressed block
+ * The bit stream is read into a 64-bit bit buffer that is refilled with
+ * 64-bit loads where possible, the bytes that remain in the bit buffer
+ * are returned to the bit stream when the block has been decoded
  * Returns 1 on success or -1 on error
  */
 int libewf_deflate_decode_huffman(
@@ -836,14 +969,55 @@ int libewf_deflate_decode_huffman(
 		0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
 		7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
 
-	static char *function         = "libewf_deflate_decode_huffman";
-	size_t data_offset            = 0;
-	uint32_t code_value           = 0;
-	uint32_t extra_bits           = 0;
-	uint16_t compression_offset   = 0;
-	uint16_t compression_size     = 0;
-	uint16_t number_of_extra_bits = 0;
+	const uint8_t *byte_stream     = NULL;
+	static char *function          = "libewf_deflate_decode_huffman";
+	size_t byte_stream_offset      = 0;
+	size_t byte_stream_size        = 0;
+	size_t data_offset             = 0;
+	uint64_t bit_buffer            = 0;
+	uint64_t value_64bit           = 0;
+	uint32_t code_value            = 0;
+	uint32_t distances_lookup_mask = 0;
+	uint32_t literals_lookup_mask  = 0;
+	uint32_t lookup_entry          = 0;
+	uint16_t compression_offset    = 0;
+	uint16_t compression_size      = 0;
+	uint8_t bit_buffer_size        = 0;
+	uint8_t number_of_bits         = 0;
 
+	if( bit_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid bit stream.",
+		 function );
+
+		return( -1 );
+	}
+	if( literals_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid literals table.",
+		 function );
+
+		return( -1 );
+	}
+	if( distances_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid distances table.",
+		 function );
+
+		return( -1 );
+	}
 	if( uncompressed_data == NULL )
 	{
 		libcerror_error_set(
@@ -877,15 +1051,57 @@ int libewf_deflate_decode_huffman(
 
 		return( -1 );
 	}
+	byte_stream        = bit_stream->byte_stream;
+	byte_stream_size   = bit_stream->byte_stream_size;
+	byte_stream_offset = bit_stream->byte_stream_offset;
+	bit_buffer         = bit_stream->bit_buffer;
+	bit_buffer_size    = bit_stream->bit_buffer_size;
+
+	literals_lookup_mask  = ( 1UL << literals_table->number_of_lookup_bits ) - 1;
+	distances_lookup_mask = ( 1UL << distances_table->number_of_lookup_bits ) - 1;
+
 	data_offset = *uncompressed_data_offset;
 
 	do
 	{
-		if( libewf_deflate_bit_stream_get_huffman_encoded_value(
-		     bit_stream,
-		     literals_table,
-		     &code_value,
-		     error ) != 1 )
+		/* Refill the bit buffer, a literal and length code with a distance code
+		 * and their extra bits require at most 48 bits
+		 */
+		if( ( byte_stream_size - byte_stream_offset ) >= 8 )
+		{
+			byte_stream_copy_to_uint64_little_endian(
+			 &( byte_stream[ byte_stream_offset ] ),
+			 value_64bit );
+
+			/* The bits of a partially consumed byte are loaded again at
+			 * the same position
+			 */
+			bit_buffer         |= value_64bit << bit_buffer_size;
+			byte_stream_offset += ( 63 - bit_buffer_size ) >> 3;
+			bit_buffer_size    |= 56;
+		}
+		else
+		{
+			while( ( bit_buffer_size < 56 )
+			    && ( byte_stream_offset < byte_stream_size ) )
+			{
+				bit_buffer      |= (uint64_t) byte_stream[ byte_stream_offset++ ] << bit_buffer_size;
+				bit_buffer_size += 8;
+			}
+		}
+		lookup_entry   = literals_table->lookup_table[ bit_buffer & literals_lookup_mask ];
+		number_of_bits = 0;
+
+		if( ( lookup_entry & LIBEWF_DEFLATE_HUFFMAN_LOOKUP_ENTRY_FLAG_SUB_TABLE ) != 0 )
+		{
+			number_of_bits = literals_table->number_of_lookup_bits;
+			code_value     = (uint32_t) ( bit_buffer >> number_of_bits ) & ( ( 1UL << ( ( lookup_entry >> 16 ) & 0x000000ffUL ) ) - 1 );
+			lookup_entry   = literals_table->lookup_table[ ( lookup_entry & 0x0000ffffUL ) + code_value ];
+		}
+		number_of_bits += (uint8_t) ( ( lookup_entry >> 16 ) & 0x000000ffUL );
+
+		if( ( lookup_entry == 0 )
+		 || ( number_of_bits > bit_buffer_size ) )
 		{
 			libcerror_error_set(
 			 error,
@@ -896,6 +1112,11 @@ int libewf_deflate_decode_huffman(
 
 			return( -1 );
 		}
+		bit_buffer     >>= number_of_bits;
+		bit_buffer_size -= number_of_bits;
+
+		code_value = lookup_entry & 0x0000ffffUL;
+
 		if( code_value < 256 )
 		{
 			if( data_offset >= uncompressed_data_size )
@@ -916,13 +1137,9 @@ int libewf_deflate_decode_huffman(
 		{
 			code_value -= 257;
 
-			number_of_extra_bits = literal_codes_number_of_extra_bits[ code_value ];
+			number_of_bits = (uint8_t) literal_codes_number_of_extra_bits[ code_value ];
 
-			if( libewf_deflate_bit_stream_get_value(
-			     bit_stream,
-			     (uint8_t) number_of_extra_bits,
-			     &extra_bits,
-			     error ) != 1 )
+			if( number_of_bits > bit_buffer_size )
 			{
 				libcerror_error_set(
 				 error,
@@ -933,13 +1150,25 @@ int libewf_deflate_decode_huffman(
 
 				return( -1 );
 			}
-			compression_size = literal_codes_base[ code_value ] + (uint16_t) extra_bits;
+			compression_size = literal_codes_base[ code_value ] + (uint16_t) ( bit_buffer & ( ( 1UL << number_of_bits ) - 1 ) );
 
-			if( libewf_deflate_bit_stream_get_huffman_encoded_value(
-			     bit_stream,
-			     distances_table,
-			     &code_value,
-			     error ) != 1 )
+			bit_buffer     >>= number_of_bits;
+			bit_buffer_size -= number_of_bits;
+
+			lookup_entry   = distances_table->lookup_table[ bit_buffer & distances_lookup_mask ];
+			number_of_bits = 0;
+
+			if( ( lookup_entry & LIBEWF_DEFLATE_HUFFMAN_LOOKUP_ENTRY_FLAG_SUB_TABLE ) != 0 )
+			{
+				number_of_bits = distances_table->number_of_lookup_bits;
+				code_value     = (uint32_t) ( bit_buffer >> number_of_bits ) & ( ( 1UL << ( ( lookup_entry >> 16 ) & 0x000000ffUL ) ) - 1 );
+				lookup_entry   = distances_table->lookup_table[ ( lookup_entry & 0x0000ffffUL ) + code_value ];
+			}
+			number_of_bits += (uint8_t) ( ( lookup_entry >> 16 ) & 0x000000ffUL );
+
+			if( ( lookup_entry == 0 )
+			 || ( number_of_bits > bit_buffer_size )
+			 || ( ( lookup_entry & 0x0000ffffUL ) >= 30 ) )
 			{
 				libcerror_error_set(
 				 error,
@@ -950,13 +1179,14 @@ int libewf_deflate_decode_huffman(
 
 				return( -1 );
 			}
-			number_of_extra_bits = distance_codes_number_of_extra_bits[ code_value ];
+			bit_buffer     >>= number_of_bits;
+			bit_buffer_size -= number_of_bits;
 
-			if( libewf_deflate_bit_stream_get_value(
-			     bit_stream,
-			     (uint8_t) number_of_extra_bits,
-			     &extra_bits,
-			     error ) != 1 )
+			code_value = lookup_entry & 0x0000ffffUL;
+
+			number_of_bits = (uint8_t) distance_codes_number_of_extra_bits[ code_value ];
+
+			if( number_of_bits > bit_buffer_size )
 			{
 				libcerror_error_set(
 				 error,
@@ -967,7 +1197,10 @@ int libewf_deflate_decode_huffman(
 
 				return( -1 );
 			}
-			compression_offset = distance_codes_base[ code_value ] + (uint16_t) extra_bits;
+			compression_offset = distance_codes_base[ code_value ] + (uint16_t) ( bit_buffer & ( ( 1UL << number_of_bits ) - 1 ) );
+
+			bit_buffer     >>= number_of_bits;
+			bit_buffer_size -= number_of_bits;
 
 			if( compression_offset > data_offset )
 			{
@@ -991,12 +1224,35 @@ int libewf_deflate_decode_huffman(
 
 				return( -1 );
 			}
-			while( compression_size > 0 )
+			if( compression_offset >= compression_size )
+			{
+				if( memory_copy(
+				     &( uncompressed_data[ data_offset ] ),
+				     &( uncompressed_data[ data_offset - compression_offset ] ),
+				     (size_t) compression_size ) == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+					 "%s: unable to copy compressed data.",
+					 function );
+
+					return( -1 );
+				}
+				data_offset += compression_size;
+			}
+			else
 			{
-				uncompressed_data[ data_offset ] = uncompressed_data[ data_offset - compression_offset ];
+				/* The source and destination overlap
+				 */
+				while( compression_size > 0 )
+				{
+					uncompressed_data[ data_offset ] = uncompressed_data[ data_offset - compression_offset ];
 
-				data_offset++;
-				compression_size--;
+					data_offset++;
+					compression_size--;
+				}
 			}
 		}
 		else if( code_value != 256 )
@@ -1005,7 +1261,7 @@ int libewf_deflate_decode_huffman(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: invalid code value: %" PRIu16 ".",
+			 "%s: invalid code value: %" PRIu32 ".",
 			 function,
 			 code_value );
 
@@ -1014,6 +1270,17 @@ int libewf_deflate_decode_huffman(
 	}
 	while( code_value != 256 );
 
+	/* Return the unused bytes in the bit buffer to the bit stream
+	 */
+	while( bit_buffer_size >= 8 )
+	{
+		byte_stream_offset -= 1;
+		bit_buffer_size    -= 8;
+	}
+	bit_stream->byte_stream_offset = byte_stream_offset;
+	bit_stream->bit_buffer         = (uint32_t) ( bit_buffer & ( ( 1UL << bit_buffer_size ) - 1 ) );
+	bit_stream->bit_buffer_size    = bit_buffer_size;
+
 	*uncompressed_data_offset = data_offset;
 
 	return( 1 );
@@ -1948,7 +2215,7 @@ int libewf_deflate_decompress_zlib(
 		 &( bit_stream.byte_stream[ bit_stream.byte_stream_offset ] ),
 		 stored_checksum );
 
-		if( libewf_deflate_calculate_adler32(
+		if( libewf_checksum_calculate_adler32(
 		     &calculated_checksum,
 		     uncompressed_data,
 		     uncompressed_data_offset,
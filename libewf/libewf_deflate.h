@@ -41,6 +41,21 @@ enum LIBEWF_DEFLATE_BLOCK_TYPES
 	LIBEWF_DEFLATE_BLOCK_TYPE_RESERVED		= 0x03
 };
 
+/* The number of bits of the primary Huffman lookup table
+ */
+#define LIBEWF_DEFLATE_HUFFMAN_LOOKUP_TABLE_BITS		10
+
+/* The size of the Huffman lookup table
+ * The primary lookup table is followed by the sub tables of the codes
+ * that are larger than the primary lookup table, which require at most
+ * 288 + 62 entries
+ */
+#define LIBEWF_DEFLATE_HUFFMAN_LOOKUP_TABLE_SIZE		( ( 1 << LIBEWF_DEFLATE_HUFFMAN_LOOKUP_TABLE_BITS ) + 512 )
+
+/* The Huffman lookup table entry flags
+ */
+#define LIBEWF_DEFLATE_HUFFMAN_LOOKUP_ENTRY_FLAG_SUB_TABLE	0x80000000UL
+
 typedef struct libewf_deflate_bit_stream libewf_deflate_bit_stream_t;
 
 struct libewf_deflate_bit_stream
@@ -86,6 +101,18 @@ struct libewf_deflate_huffman_table
 	/* The number of codes
 	 */
 	int number_of_codes;
+
+	/* The number of bits of the primary lookup table
+	 */
+	uint8_t number_of_lookup_bits;
+
+	/* The lookup table
+	 * An entry contains the symbol in the lower 16 bits and the code size
+	 * in the next 8 bits. A sub table entry contains the offset of the
+	 * sub table in the lower 16 bits and the number of bits of the sub table
+	 * in the next 8 bits.
+	 */
+	uint32_t lookup_table[ LIBEWF_DEFLATE_HUFFMAN_LOOKUP_TABLE_SIZE ];
 };
 
 int libewf_deflate_bit_stream_get_value(
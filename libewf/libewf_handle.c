@@ -28,12 +28,14 @@
 #include "libewf_analytical_data.h"
 #include "libewf_case_data.h"
 #include "libewf_case_data_section.h"
+#include "libewf_chunk_cache.h"
 #include "libewf_chunk_data.h"
 #include "libewf_chunk_table.h"
 #include "libewf_codepage.h"
 #include "libewf_compression.h"
 #include "libewf_data_chunk.h"
 #include "libewf_debug.h"
+#include "libewf_decompression_job.h"
 #include "libewf_definitions.h"
 #include "libewf_device_information.h"
 #include "libewf_device_information_section.h"
@@ -45,6 +47,7 @@
 #include "libewf_hash_values.h"
 #include "libewf_header_sections.h"
 #include "libewf_header_values.h"
+#include "libewf_index_file.h"
 #include "libewf_io_handle.h"
 #include "libewf_lef_file_entry.h"
 #include "libewf_libbfio.h"
@@ -57,12 +60,14 @@
 #include "libewf_libfvalue.h"
 #include "libewf_ltree_section.h"
 #include "libewf_md5_hash_section.h"
+#include "libewf_prefetch_job.h"
 #include "libewf_restart_data.h"
 #include "libewf_section.h"
 #include "libewf_section_descriptor.h"
 #include "libewf_sector_range.h"
 #include "libewf_sector_range_list.h"
 #include "libewf_segment_file.h"
+#include "libewf_segment_file_job.h"
 #include "libewf_session_section.h"
 #include "libewf_sha1_hash_section.h"
 #include "libewf_single_file_tree.h"
@@ -221,6 +226,32 @@ int libewf_handle_initialize(
 
 		goto on_error;
 	}
+	if( libewf_compression_context_pool_initialize(
+	     &( internal_handle->compression_context_pool ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create compression context pool.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_compression_estimator_initialize(
+	     &( internal_handle->compression_estimator ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create compression estimator.",
+		 function );
+
+		goto on_error;
+	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_initialize(
 	     &( internal_handle->read_write_lock ),
@@ -235,9 +266,36 @@ int libewf_handle_initialize(
 
 		goto on_error;
 	}
+	if( libcthreads_mutex_initialize(
+	     &( internal_handle->file_io_pool_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize file IO pool mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( internal_handle->prefetch_condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize prefetch condition.",
+		 function );
+
+		goto on_error;
+	}
 #endif
 	internal_handle->date_format                    = LIBEWF_DATE_FORMAT_CTIME;
 	internal_handle->maximum_number_of_open_handles = LIBBFIO_POOL_UNLIMITED_NUMBER_OF_OPEN_HANDLES;
+	internal_handle->maximum_cache_size             = LIBEWF_DEFAULT_MAXIMUM_CACHE_SIZE;
 
 	*handle = (libewf_handle_t *) internal_handle;
 
@@ -246,6 +304,32 @@ int libewf_handle_initialize(
 on_error:
 	if( internal_handle != NULL )
 	{
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( internal_handle->file_io_pool_mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( internal_handle->file_io_pool_mutex ),
+			 NULL );
+		}
+		if( internal_handle->read_write_lock != NULL )
+		{
+			libcthreads_read_write_lock_free(
+			 &( internal_handle->read_write_lock ),
+			 NULL );
+		}
+#endif
+		if( internal_handle->compression_estimator != NULL )
+		{
+			libewf_compression_estimator_free(
+			 &( internal_handle->compression_estimator ),
+			 NULL );
+		}
+		if( internal_handle->compression_context_pool != NULL )
+		{
+			libewf_compression_context_pool_free(
+			 &( internal_handle->compression_context_pool ),
+			 NULL );
+		}
 		if( internal_handle->acquiry_errors != NULL )
 		{
 			libcdata_range_list_free(
@@ -330,6 +414,90 @@ int libewf_handle_free(
 		*handle = NULL;
 
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( internal_handle->prefetch_thread_pool != NULL )
+		{
+			if( libcthreads_thread_pool_join(
+			     &( internal_handle->prefetch_thread_pool ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to join prefetch thread pool.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( internal_handle->decompression_thread_pool != NULL )
+		{
+			if( libcthreads_thread_pool_join(
+			     &( internal_handle->decompression_thread_pool ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to join decompression thread pool.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( internal_handle->decompression_jobs_queue != NULL )
+		{
+			if( libcthreads_queue_free(
+			     &( internal_handle->decompression_jobs_queue ),
+			     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_decompression_job_free,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free decompression jobs queue.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( internal_handle->compression_thread_pool != NULL )
+		{
+			if( libcthreads_thread_pool_join(
+			     &( internal_handle->compression_thread_pool ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to join compression thread pool.",
+				 function );
+
+				result = -1;
+			}
+		}
+		/* The compression jobs are freed by close hence the queue does not manage them
+		 */
+		if( internal_handle->compression_jobs_queue != NULL )
+		{
+			if( libcthreads_queue_free(
+			     &( internal_handle->compression_jobs_queue ),
+			     NULL,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free compression jobs queue.",
+				 function );
+
+				result = -1;
+			}
+		}
 		if( libcthreads_read_write_lock_free(
 		     &( internal_handle->read_write_lock ),
 		     error ) != 1 )
@@ -343,6 +511,32 @@ int libewf_handle_free(
 
 			result = -1;
 		}
+		if( libcthreads_mutex_free(
+		     &( internal_handle->file_io_pool_mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free file IO pool mutex.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_condition_free(
+		     &( internal_handle->prefetch_condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free prefetch condition.",
+			 function );
+
+			result = -1;
+		}
 #endif
 		if( libewf_segment_table_free(
 		     &( internal_handle->segment_table ),
@@ -357,6 +551,48 @@ int libewf_handle_free(
 
 			result = -1;
 		}
+		if( libewf_compression_context_pool_free(
+		     &( internal_handle->compression_context_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free compression context pool.",
+			 function );
+
+			result = -1;
+		}
+		if( libewf_compression_estimator_free(
+		     &( internal_handle->compression_estimator ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free compression estimator.",
+			 function );
+
+			result = -1;
+		}
+		if( internal_handle->index_file_io_handle != NULL )
+		{
+			if( libbfio_handle_free(
+			     &( internal_handle->index_file_io_handle ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free index file IO handle.",
+				 function );
+
+				result = -1;
+			}
+		}
 		if( libcdata_range_list_free(
 		     &( internal_handle->acquiry_errors ),
 		     NULL,
@@ -537,6 +773,36 @@ int libewf_handle_clone(
 
 		goto on_error;
 	}
+	if( libewf_compression_context_pool_initialize(
+	     &( internal_destination_handle->compression_context_pool ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create destination compression context pool.",
+		 function );
+
+		goto on_error;
+	}
+	internal_destination_handle->io_handle->compression_context_pool = internal_destination_handle->compression_context_pool;
+
+	if( libewf_compression_estimator_initialize(
+	     &( internal_destination_handle->compression_estimator ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create destination compression estimator.",
+		 function );
+
+		goto on_error;
+	}
+	internal_destination_handle->io_handle->compression_estimator = internal_destination_handle->compression_estimator;
+
 	if( libewf_media_values_clone(
 	     &( internal_destination_handle->media_values ),
 	     internal_source_handle->media_values,
@@ -736,6 +1002,7 @@ int libewf_handle_clone(
 		internal_destination_handle->hash_values_parsed = internal_source_handle->hash_values_parsed;
 	}
 	internal_destination_handle->maximum_number_of_open_handles = internal_source_handle->maximum_number_of_open_handles;
+	internal_destination_handle->maximum_cache_size             = internal_source_handle->maximum_cache_size;
 	internal_destination_handle->date_format                    = internal_source_handle->date_format;
 
 	*destination_handle = (libewf_handle_t *) internal_destination_handle;
@@ -775,6 +1042,18 @@ on_error:
 			 &( internal_destination_handle->segment_table ),
 			 NULL );
 		}
+		if( internal_destination_handle->compression_estimator != NULL )
+		{
+			libewf_compression_estimator_free(
+			 &( internal_destination_handle->compression_estimator ),
+			 NULL );
+		}
+		if( internal_destination_handle->compression_context_pool != NULL )
+		{
+			libewf_compression_context_pool_free(
+			 &( internal_destination_handle->compression_context_pool ),
+			 NULL );
+		}
 		if( internal_destination_handle->write_io_handle != NULL )
 		{
 			libewf_write_io_handle_free(
@@ -1057,6 +1336,23 @@ int libewf_handle_open(
 
 				goto on_error;
 			}
+			if( internal_handle->io_backend != NULL )
+			{
+				if( libbfio_file_set_io_backend(
+				     file_io_handle,
+				     internal_handle->io_backend,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to set IO backend in file IO handle.",
+					 function );
+
+					goto on_error;
+				}
+			}
 			if( libbfio_pool_append_handle(
 			     file_io_pool,
 			     &file_io_pool_entry,
@@ -1426,6 +1722,23 @@ int libewf_handle_open_wide(
 
 				goto on_error;
 			}
+			if( internal_handle->io_backend != NULL )
+			{
+				if( libbfio_file_set_io_backend(
+				     file_io_handle,
+				     internal_handle->io_backend,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to set IO backend in file IO handle.",
+					 function );
+
+					goto on_error;
+				}
+			}
 			if( libbfio_pool_append_handle(
 			     file_io_pool,
 			     &file_io_pool_entry,
@@ -2803,6 +3116,10 @@ int libewf_internal_handle_open_read_segment_files(
 	int file_io_pool_entry              = 0;
 	int last_segment_file               = 0;
 
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	uint32_t number_of_batch_segments   = 0;
+#endif
+
 	if( internal_handle == NULL )
 	{
 		libcerror_error_set(
@@ -2923,6 +3240,41 @@ int libewf_internal_handle_open_read_segment_files(
 				return( -1 );
 			}
 		}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		/* The first segment file is read on its own since it determines
+		 * the segment file type the other segment files are validated against
+		 */
+		if( ( internal_handle->number_of_open_threads > 0 )
+		 && ( segment_number > 0 )
+		 && ( ( ( segment_number - 1 ) % LIBEWF_OPEN_SEGMENT_FILES_PER_BATCH ) == 0 ) )
+		{
+			number_of_batch_segments = number_of_segments - segment_number;
+
+			if( number_of_batch_segments > LIBEWF_OPEN_SEGMENT_FILES_PER_BATCH )
+			{
+				number_of_batch_segments = LIBEWF_OPEN_SEGMENT_FILES_PER_BATCH;
+			}
+			if( libewf_internal_handle_open_read_segment_files_with_threads(
+			     internal_handle,
+			     file_io_pool,
+			     segment_table,
+			     segment_number,
+			     number_of_batch_segments,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read segment files: %" PRIu32 " to %" PRIu32 " with threads.",
+				 function,
+				 segment_number,
+				 segment_number + number_of_batch_segments - 1 );
+
+				return( -1 );
+			}
+		}
+#endif
 		if( libewf_segment_table_get_segment_file_by_index(
 		     segment_table,
 		     segment_number,
@@ -3064,6 +3416,26 @@ int libewf_internal_handle_open_read_segment_files(
 		{
 			segment_table->flags |= LIBEWF_SEGMENT_TABLE_FLAG_IS_CORRUPTED;
 		}
+		else if( ( internal_handle->index_file != NULL )
+		      && ( ( segment_file->flags & LIBEWF_SEGMENT_FILE_FLAG_IS_INDEXED ) == 0 ) )
+		{
+			if( libewf_segment_file_write_index_record(
+			     segment_file,
+			     internal_handle->index_file,
+			     segment_file_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to write segment file: %" PRIu32 " index record.",
+				 function,
+				 segment_number );
+
+				return( -1 );
+			}
+		}
 		if( libewf_segment_table_set_segment_storage_media_size_by_index(
 		     segment_table,
 		     segment_number,
@@ -3111,24 +3483,111 @@ int libewf_internal_handle_open_read_segment_files(
 	return( 1 );
 }
 
-/* Reads the device information from the segment files
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+/* Callback function for the segment file thread pool
  * Returns 1 if successful or -1 on error
  */
-int libewf_internal_handle_open_read_device_information(
-     libewf_internal_handle_t *internal_handle,
+int libewf_internal_handle_segment_file_thread_pool_callback(
+     libewf_segment_file_job_t *segment_file_job,
+     libewf_internal_handle_t *internal_handle )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "libewf_internal_handle_segment_file_thread_pool_callback";
+
+	if( segment_file_job == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment file job.",
+		 function );
+
+		goto on_error;
+	}
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		goto on_error;
+	}
+	segment_file_job->result = libewf_segment_file_job_run(
+	                            segment_file_job,
+	                            internal_handle->io_handle,
+	                            &error );
+
+	if( segment_file_job->result != 1 )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( ( libcnotify_verbose != 0 )
+		 && ( error != NULL ) )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	/* The opener waits for the job on the segment file jobs queue
+	 * and takes over the management of segment_file_job
+	 */
+	if( libcthreads_queue_push(
+	     internal_handle->segment_file_jobs_queue,
+	     (intptr_t *) segment_file_job,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to push segment file job onto queue.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+	}
+#endif
+	libcerror_error_free(
+	 &error );
+
+	return( -1 );
+}
+
+/* Reads a batch of segment files concurrently and stores them in the segment table
+ * A segment file that cannot be read by a thread is not stored, hence it is read
+ * again by libewf_internal_handle_open_read_segment_files, which reports the error
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_open_read_segment_files_with_threads(
+     libewf_internal_handle_t *internal_handle,
      libbfio_pool_t *file_io_pool,
      libewf_segment_table_t *segment_table,
+     uint32_t first_segment_number,
      uint32_t number_of_segments,
      libcerror_error_t **error )
 {
-	libewf_section_descriptor_t *section_descriptor = NULL;
-	libewf_segment_file_t *segment_file             = NULL;
-	libfcache_cache_t *sections_cache               = NULL;
-	static char *function                           = "libewf_internal_handle_open_read_device_information";
-	size64_t segment_file_size                      = 0;
-	ssize_t read_count                              = 0;
-	uint32_t segment_number                         = 0;
-	int file_io_pool_entry                          = 0;
+	libcthreads_thread_pool_t *thread_pool      = NULL;
+	libewf_segment_file_job_t *segment_file_job = NULL;
+	static char *function                       = "libewf_internal_handle_open_read_segment_files_with_threads";
+	uint32_t segment_number                     = 0;
+	int number_of_jobs                          = 0;
+	int number_of_threads                       = 0;
+	int result                                  = 1;
 
 	if( internal_handle == NULL )
 	{
@@ -3141,230 +3600,434 @@ int libewf_internal_handle_open_read_device_information(
 
 		return( -1 );
 	}
-	if( number_of_segments == 0 )
+	if( internal_handle->segment_file_jobs_queue != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - segment file jobs queue value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_segments == 0 )
+	 || ( number_of_segments > (uint32_t) LIBEWF_OPEN_SEGMENT_FILES_PER_BATCH ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
 		 "%s: invalid number of segments value out of bounds.",
 		 function );
 
 		return( -1 );
 	}
-	if( libewf_segment_table_get_segment_file_by_index(
-	     segment_table,
-	     segment_number,
-	     file_io_pool,
-	     &segment_file,
+	number_of_threads = internal_handle->number_of_open_threads;
+
+	if( (uint32_t) number_of_threads > number_of_segments )
+	{
+		number_of_threads = (int) number_of_segments;
+	}
+	/* The number of jobs is limited to the size of the queue
+	 * hence the push onto the queue never blocks
+	 */
+	if( libcthreads_queue_initialize(
+	     &( internal_handle->segment_file_jobs_queue ),
+	     (int) number_of_segments,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve segment file: %" PRIu32 " from segment table.",
-		 function,
-		 segment_number );
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create segment file jobs queue.",
+		 function );
 
 		goto on_error;
 	}
-	if( segment_file == NULL )
+	if( libcthreads_thread_pool_create(
+	     &thread_pool,
+	     NULL,
+	     number_of_threads,
+	     (int) number_of_segments,
+	     (int (*)(intptr_t *, void *)) &libewf_internal_handle_segment_file_thread_pool_callback,
+	     (void *) internal_handle,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: missing segment file: %" PRIu32 ".",
-		 function,
-		 segment_number );
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create segment file thread pool.",
+		 function );
 
 		goto on_error;
 	}
-	if( segment_file->major_version != 2 )
-	{
-		return( 1 );
-	}
-	if( segment_file->device_information_section_index == -1 )
+	for( segment_number = first_segment_number;
+	     segment_number < ( first_segment_number + number_of_segments );
+	     segment_number++ )
 	{
-		/* Lx01 stores the device information in the last segment file
-		 */
-		segment_number = number_of_segments - 1;
+		if( libewf_segment_file_job_initialize(
+		     &segment_file_job,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create segment file job.",
+			 function );
 
-		if( libewf_segment_table_get_segment_file_by_index(
+			result = -1;
+
+			break;
+		}
+		segment_file_job->segment_index = segment_number;
+
+		if( libewf_segment_table_get_segment_by_index(
 		     segment_table,
 		     segment_number,
-		     file_io_pool,
-		     &segment_file,
+		     &( segment_file_job->file_io_pool_entry ),
+		     &( segment_file_job->segment_file_size ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve segment file: %" PRIu32 " from segment table.",
+			 "%s: unable to retrieve segment: %" PRIu32 " from segment table.",
 			 function,
 			 segment_number );
 
-			goto on_error;
+			result = -1;
+
+			break;
 		}
-		if( segment_file == NULL )
+		if( libbfio_pool_get_handle(
+		     file_io_pool,
+		     segment_file_job->file_io_pool_entry,
+		     &( segment_file_job->file_io_handle ),
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing segment file: %" PRIu32 ".",
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve file IO handle: %d from pool.",
 			 function,
-			 segment_number );
+			 segment_file_job->file_io_pool_entry );
+
+			result = -1;
+
+			break;
+		}
+		if( libcthreads_thread_pool_push(
+		     thread_pool,
+		     (intptr_t *) segment_file_job,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push segment file job onto thread pool.",
+			 function );
+
+			result = -1;
+
+			break;
+		}
+		segment_file_job = NULL;
+
+		number_of_jobs++;
+	}
+	if( segment_file_job != NULL )
+	{
+		libewf_segment_file_job_free(
+		 &segment_file_job,
+		 NULL );
+	}
+	/* Wait for all the jobs that were pushed, also on error, since the jobs
+	 * reference the file IO handles of the file IO pool
+	 */
+	while( number_of_jobs > 0 )
+	{
+		if( libcthreads_queue_pop(
+		     internal_handle->segment_file_jobs_queue,
+		     (intptr_t **) &segment_file_job,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to pop segment file job from queue.",
+			 function );
 
 			goto on_error;
 		}
+		number_of_jobs--;
+
+		if( segment_file_job == NULL )
+		{
+			continue;
+		}
+		if( ( result == 1 )
+		 && ( segment_file_job->result == 1 ) )
+		{
+			if( libewf_segment_table_set_segment_file_by_index(
+			     segment_table,
+			     segment_file_job->segment_index,
+			     file_io_pool,
+			     segment_file_job->segment_file,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set segment file: %" PRIu32 " in segment table.",
+				 function,
+				 segment_file_job->segment_index );
+
+				result = -1;
+			}
+			else
+			{
+				/* The segment file is now managed by the segment table
+				 */
+				segment_file_job->segment_file = NULL;
+			}
+		}
+		if( libewf_segment_file_job_free(
+		     &segment_file_job,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free segment file job.",
+			 function );
+
+			result = -1;
+		}
 	}
-	if( segment_file->device_information_section_index == -1 )
+	if( libcthreads_thread_pool_join(
+	     &thread_pool,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: unable to locate a device information section.",
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to join segment file thread pool.",
 		 function );
 
 		goto on_error;
 	}
-	if( libewf_segment_table_get_segment_by_index(
-	     segment_table,
-	     segment_number,
-	     &file_io_pool_entry,
-	     &segment_file_size,
+	if( libcthreads_queue_free(
+	     &( internal_handle->segment_file_jobs_queue ),
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_segment_file_job_free,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve segment: %" PRIu32 " from segment table.",
-		 function,
-		 segment_number );
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free segment file jobs queue.",
+		 function );
 
 		goto on_error;
 	}
-	if( libfcache_cache_initialize(
-	     &sections_cache,
-	     LIBEWF_MAXIMUM_CACHE_ENTRIES_SECTIONS,
-	     error ) != 1 )
+	return( result );
+
+on_error:
+	if( thread_pool != NULL )
+	{
+		libcthreads_thread_pool_join(
+		 &thread_pool,
+		 NULL );
+	}
+	if( internal_handle->segment_file_jobs_queue != NULL )
+	{
+		libcthreads_queue_free(
+		 &( internal_handle->segment_file_jobs_queue ),
+		 (int (*)(intptr_t **, libcerror_error_t **)) &libewf_segment_file_job_free,
+		 NULL );
+	}
+	return( -1 );
+}
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+/* Reads the index file
+ * An index file that is missing or cannot be read is replaced when the segment files have been read
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_open_read_index_file(
+     libewf_internal_handle_t *internal_handle,
+     libewf_segment_table_t *segment_table,
+     libcerror_error_t **error )
+{
+	static char *function       = "libewf_internal_handle_open_read_index_file";
+	uint32_t number_of_segments = 0;
+
+	if( internal_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create sections cache.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libfdata_list_get_element_value_by_index(
-	     segment_file->sections_list,
-	     (intptr_t *) file_io_pool,
-	     (libfdata_cache_t *) sections_cache,
-	     segment_file->device_information_section_index,
-	     (intptr_t **) &section_descriptor,
-	     0,
-	     error ) != 1 )
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->index_file != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - index file value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_segment_table_get_number_of_segments(
+	     segment_table,
+	     &number_of_segments,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve section: %d from sections list.",
-		 function,
-		 segment_file->device_information_section_index );
+		 "%s: unable to retrieve number of segments from segment table.",
+		 function );
 
 		goto on_error;
 	}
-	if( libewf_segment_file_seek_offset(
-	     segment_file,
-	     file_io_pool,
-	     file_io_pool_entry,
-	     section_descriptor->start_offset,
-	     error ) == -1 )
+	/* The index file is accessed using the same IO backend as the segment files
+	 */
+	if( internal_handle->io_backend != NULL )
+	{
+		if( libbfio_file_set_io_backend(
+		     internal_handle->index_file_io_handle,
+		     internal_handle->io_backend,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set IO backend in index file IO handle.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libewf_index_file_initialize(
+	     &( internal_handle->index_file ),
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_OPEN_FAILED,
-		 "%s: unable to seek section: %d data offset: %" PRIu64 " (0x%08%" PRIx64 ").",
-		 function,
-		 segment_file->device_information_section_index,
-		 section_descriptor->start_offset );
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create index file.",
+		 function );
 
 		goto on_error;
 	}
-	read_count = libewf_device_information_section_read_file_io_pool(
-		      section_descriptor,
-		      internal_handle->io_handle,
-		      file_io_pool,
-		      file_io_pool_entry,
-		      internal_handle->read_io_handle,
-		      internal_handle->media_values,
-		      internal_handle->header_values,
-		      error );
-
-	if( read_count == -1 )
+	if( libewf_index_file_read_file_io_handle(
+	     internal_handle->index_file,
+	     internal_handle->index_file_io_handle,
+	     number_of_segments,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_IO,
 		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read device information section: %d.",
-		 function,
-		 segment_file->device_information_section_index );
+		 "%s: unable to read index file.",
+		 function );
 
-		goto on_error;
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			if( ( error != NULL )
+			 && ( *error != NULL ) )
+			{
+				libcnotify_print_error_backtrace(
+				 *error );
+			}
+		}
+#endif
+		libcerror_error_free(
+		 error );
+
+		internal_handle->index_file->is_modified = 1;
 	}
-	if( libfcache_cache_free(
-	     &sections_cache,
+	if( libewf_index_file_resize(
+	     internal_handle->index_file,
+	     number_of_segments,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to free sections cache.",
+		 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+		 "%s: unable to resize index file.",
 		 function );
 
 		goto on_error;
 	}
+	internal_handle->io_handle->index_file = internal_handle->index_file;
+
 	return( 1 );
 
 on_error:
-	if( sections_cache != NULL )
+	if( internal_handle->index_file != NULL )
 	{
-		libfcache_cache_free(
-		 &sections_cache,
+		libewf_index_file_free(
+		 &( internal_handle->index_file ),
 		 NULL );
 	}
 	return( -1 );
 }
 
-/* Opens a set of EWF file(s) using a Basic File IO (bfio) pool
- * This function is not multi-thread safe acquire write lock before call
+/* Reads the device information from the segment files
  * Returns 1 if successful or -1 on error
  */
-int libewf_internal_handle_open_file_io_pool(
+int libewf_internal_handle_open_read_device_information(
      libewf_internal_handle_t *internal_handle,
      libbfio_pool_t *file_io_pool,
-     int access_flags,
      libewf_segment_table_t *segment_table,
+     uint32_t number_of_segments,
      libcerror_error_t **error )
 {
-	libbfio_handle_t *file_io_handle    = NULL;
-	libewf_segment_file_t *segment_file = NULL;
-	static char *function               = "libewf_internal_handle_open_file_io_pool";
-	size64_t segment_file_size          = 0;
-	ssize_t read_count                  = 0;
-	int file_io_pool_entry              = 0;
-	int number_of_file_io_handles       = 0;
+	libewf_section_descriptor_t *section_descriptor = NULL;
+	libewf_segment_file_t *segment_file             = NULL;
+	libfcache_cache_t *sections_cache               = NULL;
+	static char *function                           = "libewf_internal_handle_open_read_device_information";
+	size64_t segment_file_size                      = 0;
+	ssize_t read_count                              = 0;
+	uint32_t segment_number                         = 0;
+	int file_io_pool_entry                          = 0;
 
 	if( internal_handle == NULL )
 	{
@@ -3377,220 +4040,351 @@ int libewf_internal_handle_open_file_io_pool(
 
 		return( -1 );
 	}
-	if( internal_handle->io_handle == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing IO handle.",
-		 function );
-
-		return( -1 );
-	}
-	if( internal_handle->file_io_pool != NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - file IO pool value already set.",
-		 function );
-
-		return( -1 );
-	}
-	if( internal_handle->chunk_table != NULL )
+	if( number_of_segments == 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - chunk table value already set.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of segments value out of bounds.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->hash_sections != NULL )
+	if( libewf_segment_table_get_segment_file_by_index(
+	     segment_table,
+	     segment_number,
+	     file_io_pool,
+	     &segment_file,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - hash sections value already set.",
-		 function );
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve segment file: %" PRIu32 " from segment table.",
+		 function,
+		 segment_number );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( internal_handle->single_files != NULL )
+	if( segment_file == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - single files value already set.",
-		 function );
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing segment file: %" PRIu32 ".",
+		 function,
+		 segment_number );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( file_io_pool == NULL )
+	if( segment_file->major_version != 2 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid file IO pool.",
-		 function );
-
-		return( -1 );
+		return( 1 );
 	}
-	if( ( ( access_flags & ~( LIBEWF_ACCESS_FLAG_READ | LIBEWF_ACCESS_FLAG_WRITE | LIBEWF_ACCESS_FLAG_RESUME ) ) != 0 )
-	 || ( ( ( access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
-	  &&  ( ( access_flags & LIBEWF_ACCESS_FLAG_WRITE ) != 0 ) ) )
+	if( segment_file->device_information_section_index == -1 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-		 "%s: unsupported access flags.",
-		 function );
+		/* Lx01 stores the device information in the last segment file
+		 */
+		segment_number = number_of_segments - 1;
 
-		return( -1 );
-	}
-	if( ( ( access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
-	 || ( ( access_flags & LIBEWF_ACCESS_FLAG_RESUME ) != 0 ) )
-	{
-		if( libewf_read_io_handle_initialize(
-		     &( internal_handle->read_io_handle ),
+		if( libewf_segment_table_get_segment_file_by_index(
+		     segment_table,
+		     segment_number,
+		     file_io_pool,
+		     &segment_file,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create read IO handle.",
-			 function );
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment file: %" PRIu32 " from segment table.",
+			 function,
+			 segment_number );
 
 			goto on_error;
 		}
-	}
-	if( ( access_flags & LIBEWF_ACCESS_FLAG_WRITE ) != 0 )
-	{
-		if( libewf_write_io_handle_initialize(
-		     &( internal_handle->write_io_handle ),
-		     internal_handle->io_handle,
-		     error ) != 1 )
+		if( segment_file == NULL )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create write IO handle.",
-			 function );
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing segment file: %" PRIu32 ".",
+			 function,
+			 segment_number );
 
 			goto on_error;
 		}
 	}
-	if( libewf_chunk_table_initialize(
-	     &( internal_handle->chunk_table ),
-	     internal_handle->io_handle,
-	     error ) != 1 )
+	if( segment_file->device_information_section_index == -1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create chunk table.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: unable to locate a device information section.",
 		 function );
 
 		goto on_error;
 	}
-	if( libewf_header_values_initialize(
-	     &( internal_handle->header_values ),
+	if( libewf_segment_table_get_segment_by_index(
+	     segment_table,
+	     segment_number,
+	     &file_io_pool_entry,
+	     &segment_file_size,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create header values.",
-		 function );
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve segment: %" PRIu32 " from segment table.",
+		 function,
+		 segment_number );
 
 		goto on_error;
 	}
-	if( libewf_hash_sections_initialize(
-	     &( internal_handle->hash_sections ),
+	if( libfcache_cache_initialize(
+	     &sections_cache,
+	     LIBEWF_MAXIMUM_CACHE_ENTRIES_SECTIONS,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create hash sections.",
+		 "%s: unable to create sections cache.",
 		 function );
 
 		goto on_error;
 	}
-	if( libcdata_array_empty(
-	     internal_handle->sessions,
-	     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_sector_range_free,
+	if( libfdata_list_get_element_value_by_index(
+	     segment_file->sections_list,
+	     (intptr_t *) file_io_pool,
+	     (libfdata_cache_t *) sections_cache,
+	     segment_file->device_information_section_index,
+	     (intptr_t **) &section_descriptor,
+	     0,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to empty sessions array.",
-		 function );
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve section: %d from sections list.",
+		 function,
+		 segment_file->device_information_section_index );
 
 		goto on_error;
 	}
-	if( libcdata_array_empty(
-	     internal_handle->tracks,
-	     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_sector_range_free,
+	if( libewf_segment_file_seek_offset(
+	     segment_file,
+	     file_io_pool,
+	     file_io_pool_entry,
+	     section_descriptor->start_offset,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to seek section: %d data offset: %" PRIu64 " (0x%08%" PRIx64 ").",
+		 function,
+		 segment_file->device_information_section_index,
+		 section_descriptor->start_offset );
+
+		goto on_error;
+	}
+	read_count = libewf_device_information_section_read_file_io_pool(
+		      section_descriptor,
+		      internal_handle->io_handle,
+		      file_io_pool,
+		      file_io_pool_entry,
+		      internal_handle->read_io_handle,
+		      internal_handle->media_values,
+		      internal_handle->header_values,
+		      error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read device information section: %d.",
+		 function,
+		 segment_file->device_information_section_index );
+
+		goto on_error;
+	}
+	if( libfcache_cache_free(
+	     &sections_cache,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to empty tracks array.",
+		 "%s: unable to free sections cache.",
 		 function );
 
 		goto on_error;
 	}
-	if( libcdata_range_list_empty(
-	     internal_handle->acquiry_errors,
-	     NULL,
-	     error ) != 1 )
+	return( 1 );
+
+on_error:
+	if( sections_cache != NULL )
+	{
+		libfcache_cache_free(
+		 &sections_cache,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Opens a set of EWF file(s) using a Basic File IO (bfio) pool
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_open_file_io_pool(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     int access_flags,
+     libewf_segment_table_t *segment_table,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle    = NULL;
+	libewf_segment_file_t *segment_file = NULL;
+	static char *function               = "libewf_internal_handle_open_file_io_pool";
+	size64_t segment_file_size          = 0;
+	ssize_t read_count                  = 0;
+	int file_io_pool_entry              = 0;
+	int number_of_file_io_handles       = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to empty acquiry errors range list.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
 		 function );
 
-		goto on_error;
+		return( -1 );
+	}
+	if( internal_handle->file_io_pool != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - file IO pool value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->chunk_table != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - chunk table value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->hash_sections != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - hash sections value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->single_files != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - single files value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( ( access_flags & ~( LIBEWF_ACCESS_FLAG_READ | LIBEWF_ACCESS_FLAG_WRITE | LIBEWF_ACCESS_FLAG_RESUME ) ) != 0 )
+	 || ( ( ( access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
+	  &&  ( ( access_flags & LIBEWF_ACCESS_FLAG_WRITE ) != 0 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported access flags.",
+		 function );
+
+		return( -1 );
 	}
 	if( ( ( access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
 	 || ( ( access_flags & LIBEWF_ACCESS_FLAG_RESUME ) != 0 ) )
 	{
-		if( libbfio_pool_get_number_of_handles(
-		     file_io_pool,
-		     &number_of_file_io_handles,
+		if( libewf_read_io_handle_initialize(
+		     &( internal_handle->read_io_handle ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve the number of handles in the pool.",
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create read IO handle.",
 			 function );
 
 			goto on_error;
 		}
-		if( libewf_segment_file_initialize(
-		     &segment_file,
+	}
+	/* The segment files created while writing use the IO backend of the handle
+	 */
+	internal_handle->io_handle->io_backend = internal_handle->io_backend;
+
+	/* The chunks are packed and unpacked using the compression contexts, buffers and estimator of the handle
+	 */
+	internal_handle->io_handle->compression_context_pool = internal_handle->compression_context_pool;
+	internal_handle->io_handle->compression_estimator    = internal_handle->compression_estimator;
+
+	if( ( access_flags & LIBEWF_ACCESS_FLAG_WRITE ) != 0 )
+	{
+		if( libewf_write_io_handle_initialize(
+		     &( internal_handle->write_io_handle ),
 		     internal_handle->io_handle,
 		     error ) != 1 )
 		{
@@ -3598,42 +4392,170 @@ int libewf_internal_handle_open_file_io_pool(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create segment file.",
+			 "%s: unable to create write IO handle.",
 			 function );
 
 			goto on_error;
 		}
-		for( file_io_pool_entry = 0;
-		     file_io_pool_entry < number_of_file_io_handles;
-		     file_io_pool_entry++ )
-		{
-			if( libbfio_pool_get_size(
-			     file_io_pool,
-			     file_io_pool_entry,
-			     &segment_file_size,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve size of file IO pool entry: %d.",
-				 function,
-				 file_io_pool_entry );
+	}
+	if( libewf_chunk_table_initialize(
+	     &( internal_handle->chunk_table ),
+	     internal_handle->io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create chunk table.",
+		 function );
 
-				goto on_error;
-			}
-			if( libbfio_pool_get_handle(
-			     file_io_pool,
-			     file_io_pool_entry,
-			     &file_io_handle,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-				 "%s: unable to retrieve file IO handle: %d from pool.",
+		goto on_error;
+	}
+	if( libewf_chunk_cache_set_maximum_size(
+	     internal_handle->chunk_table->chunk_cache,
+	     internal_handle->maximum_cache_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set maximum size of chunk cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_header_values_initialize(
+	     &( internal_handle->header_values ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create header values.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_hash_sections_initialize(
+	     &( internal_handle->hash_sections ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create hash sections.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcdata_array_empty(
+	     internal_handle->sessions,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_sector_range_free,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to empty sessions array.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcdata_array_empty(
+	     internal_handle->tracks,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_sector_range_free,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to empty tracks array.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcdata_range_list_empty(
+	     internal_handle->acquiry_errors,
+	     NULL,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to empty acquiry errors range list.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( ( access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
+	 || ( ( access_flags & LIBEWF_ACCESS_FLAG_RESUME ) != 0 ) )
+	{
+		if( libbfio_pool_get_number_of_handles(
+		     file_io_pool,
+		     &number_of_file_io_handles,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve the number of handles in the pool.",
+			 function );
+
+			goto on_error;
+		}
+		if( libewf_segment_file_initialize(
+		     &segment_file,
+		     internal_handle->io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create segment file.",
+			 function );
+
+			goto on_error;
+		}
+		for( file_io_pool_entry = 0;
+		     file_io_pool_entry < number_of_file_io_handles;
+		     file_io_pool_entry++ )
+		{
+			if( libbfio_pool_get_size(
+			     file_io_pool,
+			     file_io_pool_entry,
+			     &segment_file_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve size of file IO pool entry: %d.",
+				 function,
+				 file_io_pool_entry );
+
+				goto on_error;
+			}
+			if( libbfio_pool_get_handle(
+			     file_io_pool,
+			     file_io_pool_entry,
+			     &file_io_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to retrieve file IO handle: %d from pool.",
 				 function,
 				 file_io_pool_entry );
 
@@ -3708,6 +4630,24 @@ int libewf_internal_handle_open_file_io_pool(
 
 			goto on_error;
 		}
+		if( ( ( access_flags & LIBEWF_ACCESS_FLAG_RESUME ) == 0 )
+		 && ( internal_handle->index_file_io_handle != NULL ) )
+		{
+			if( libewf_internal_handle_open_read_index_file(
+			     internal_handle,
+			     segment_table,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read index file.",
+				 function );
+
+				goto on_error;
+			}
+		}
 		if( libewf_internal_handle_open_read_segment_files(
 		     internal_handle,
 		     file_io_pool,
@@ -3739,6 +4679,38 @@ int libewf_internal_handle_open_file_io_pool(
 			libcerror_error_free(
 			 error );
 		}
+		if( ( internal_handle->index_file != NULL )
+		 && ( internal_handle->index_file->is_modified != 0 ) )
+		{
+			/* The index file is an optimization hence failing to write it is not fatal
+			 */
+			if( libewf_index_file_write_file_io_handle(
+			     internal_handle->index_file,
+			     internal_handle->index_file_io_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write index file.",
+				 function );
+
+#if defined( HAVE_DEBUG_OUTPUT )
+				if( libcnotify_verbose != 0 )
+				{
+					if( ( error != NULL )
+					 && ( *error != NULL ) )
+					{
+						libcnotify_print_error_backtrace(
+						 *error );
+					}
+				}
+#endif
+				libcerror_error_free(
+				 error );
+			}
+		}
 		if( internal_handle->media_values == NULL )
 		{
 			libcerror_error_set(
@@ -3823,6 +4795,14 @@ on_error:
 		 &segment_file,
 		 NULL );
 	}
+	if( internal_handle->index_file != NULL )
+	{
+		libewf_index_file_free(
+		 &( internal_handle->index_file ),
+		 NULL );
+	}
+	internal_handle->io_handle->index_file = NULL;
+
 	if( internal_handle->single_files != NULL )
 	{
 		libewf_single_files_free(
@@ -4013,6 +4993,22 @@ int libewf_handle_close(
 
 		return( -1 );
 	}
+	/* The prefetch jobs do not grab the read/write lock
+	 * hence wait for them to complete before the file IO pool is closed
+	 */
+	if( libewf_internal_handle_wait_for_prefetch_jobs(
+	     internal_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to wait for prefetch jobs.",
+		 function );
+
+		result = -1;
+	}
 #endif
 	if( ( internal_handle->write_io_handle != NULL )
 	 && ( internal_handle->write_io_handle->write_finalized == 0 ) )
@@ -4034,6 +5030,27 @@ int libewf_handle_close(
 			result = -1;
 		}
 	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* Compression jobs remain when the write failed, they reference
+	 * the IO handles hence wait for them to complete before they are freed
+	 */
+	if( internal_handle->number_of_compression_jobs > 0 )
+	{
+		if( libewf_internal_handle_free_compression_jobs(
+		     internal_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free compression jobs.",
+			 function );
+
+			result = -1;
+		}
+	}
+#endif
 	if( internal_handle->file_io_pool_created_in_library != 0 )
 	{
 		if( libbfio_pool_close_all(
@@ -4158,6 +5175,22 @@ int libewf_handle_close(
 			result = -1;
 		}
 	}
+	if( internal_handle->index_file != NULL )
+	{
+		if( libewf_index_file_free(
+		     &( internal_handle->index_file ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free index file.",
+			 function );
+
+			result = -1;
+		}
+	}
 	if( internal_handle->hash_sections != NULL )
 	{
 		if( libewf_hash_sections_free(
@@ -4319,11 +5352,8 @@ ssize_t libewf_internal_handle_read_buffer_from_file_io_pool(
          size_t buffer_size,
          libcerror_error_t **error )
 {
-	libewf_chunk_data_t *chunk_data = NULL;
-	static char *function           = "libewf_internal_handle_read_buffer_from_file_io_pool";
-	off64_t chunk_data_offset       = 0;
-	size_t buffer_offset            = 0;
-	size_t read_size                = 0;
+	static char *function = "libewf_internal_handle_read_buffer_from_file_io_pool";
+	ssize_t read_count    = 0;
 
 	if( internal_handle == NULL )
 	{
@@ -4423,673 +5453,635 @@ ssize_t libewf_internal_handle_read_buffer_from_file_io_pool(
 	{
 		buffer_size = (size_t) ( internal_handle->media_values->media_size - internal_handle->current_offset );
 	}
-	while( buffer_size > 0 )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libewf_internal_handle_schedule_prefetch_jobs(
+	     internal_handle,
+	     internal_handle->current_offset,
+	     buffer_size,
+	     error ) != 1 )
 	{
-		if( libewf_chunk_table_get_chunk_data_by_offset(
-		     internal_handle->chunk_table,
-		     internal_handle->io_handle,
-		     file_io_pool,
-		     internal_handle->media_values,
-		     internal_handle->segment_table,
-		     internal_handle->current_offset,
-		     &chunk_data_offset,
-		     &chunk_data,
-		     error ) != 1 )
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to schedule prefetch jobs.",
+		 function );
+
+		return( -1 );
+	}
+	/* Reads that span multiple chunks are unpacked by the decompression threads
+	 */
+	if( ( internal_handle->decompression_thread_pool != NULL )
+	 && ( ( ( (size64_t) internal_handle->current_offset % internal_handle->media_values->chunk_size ) + buffer_size ) > internal_handle->media_values->chunk_size ) )
+	{
+		read_count = libewf_internal_handle_read_buffer_from_file_io_pool_with_threads(
+		              internal_handle,
+		              file_io_pool,
+		              buffer,
+		              buffer_size,
+		              error );
+
+		if( read_count == -1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve chunk data for offset: %" PRIi64 " (0x%08" PRIx64 ").",
-			 function,
-			 internal_handle->current_offset,
-			 internal_handle->current_offset );
-
-			return( -1 );
-		}
-		if( chunk_data == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing chunk data for offset: %" PRIi64 " (0x%08" PRIx64 ").",
-			 function,
-			 internal_handle->current_offset,
-			 internal_handle->current_offset );
-
-			return( -1 );
-		}
-		if( (off64_t) chunk_data_offset > (off64_t) chunk_data->data_size )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-			 "%s: chunk: %" PRIu64 " offset exceeds data size.",
-			 function,
-			 chunk_data->chunk_index );
-
-			return( -1 );
-		}
-		read_size = (size_t) ( chunk_data->data_size - chunk_data_offset );
-
-		if( read_size > buffer_size )
-		{
-			read_size = buffer_size;
-		}
-		if( read_size == 0 )
-		{
-			break;
-		}
-		if( memory_copy(
-		     &( ( (uint8_t *) buffer )[ buffer_offset ] ),
-		     &( ( chunk_data->data )[ chunk_data_offset ] ),
-		     read_size ) == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-			 "%s: unable to copy chunk: %" PRIu64 " data to buffer.",
-			 function,
-			 chunk_data->chunk_index );
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read buffer using decompression threads.",
+			 function );
 
 			return( -1 );
 		}
-		buffer_offset += read_size;
-		buffer_size   -= read_size;
+		return( read_count );
+	}
+#endif
+	/* The chunk data is read by means of the chunk cache so that
+	 * the maximum cache size also applies to sequential reads
+	 */
+	read_count = libewf_internal_handle_read_buffer_at_offset_from_file_io_pool(
+	              internal_handle,
+	              file_io_pool,
+	              buffer,
+	              buffer_size,
+	              internal_handle->current_offset,
+	              error );
 
-		internal_handle->current_offset += (off64_t) read_size;
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 internal_handle->current_offset,
+		 internal_handle->current_offset );
 
-		if( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size )
-		{
-			break;
-		}
-		if( internal_handle->io_handle->abort != 0 )
-		{
-			break;
-		}
-		chunk_data        = NULL;
-		chunk_data_offset = 0;
+		return( -1 );
 	}
 	internal_handle->io_handle->abort = 0;
 
-	return( (ssize_t) buffer_offset );
+	return( read_count );
 }
 
-/* Reads (media) data at the current offset into a buffer
- * Returns the number of bytes read, 0 when no longer data can be read or -1 on error
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+/* Callback function for the decompression thread pool
+ * Returns 1 if successful or -1 on error
  */
-ssize_t libewf_handle_read_buffer(
-         libewf_handle_t *handle,
-         void *buffer,
-         size_t buffer_size,
-         libcerror_error_t **error )
+int libewf_internal_handle_decompression_thread_pool_callback(
+     libewf_decompression_job_t *decompression_job,
+     libewf_internal_handle_t *internal_handle )
 {
-	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_read_buffer";
-	ssize_t read_count                        = 0;
+	libcerror_error_t *error = NULL;
+	static char *function    = "libewf_internal_handle_decompression_thread_pool_callback";
 
-	if( handle == NULL )
+	if( decompression_job == NULL )
 	{
 		libcerror_error_set(
-		 error,
+		 &error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid handle.",
+		 "%s: invalid decompression job.",
 		 function );
 
-		return( -1 );
-	}
-	internal_handle = (libewf_internal_handle_t *) handle;
-
-	if( internal_handle->file_io_pool == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing file IO pool.",
-		 function );
-
-		return( -1 );
+		goto on_error;
 	}
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
+	if( internal_handle == NULL )
 	{
 		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-#endif
-	read_count = libewf_internal_handle_read_buffer_from_file_io_pool(
-		      internal_handle,
-		      internal_handle->file_io_pool,
-		      buffer,
-		      buffer_size,
-		      error );
+	decompression_job->result = libewf_decompression_job_run(
+	                             decompression_job,
+	                             internal_handle->io_handle,
+	                             &error );
 
-	if( read_count == -1 )
+	if( decompression_job->result != 1 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read buffer.",
-		 function );
-
-		read_count = -1;
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( ( libcnotify_verbose != 0 )
+		 && ( error != NULL ) )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
 	}
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
+	/* The reader waits for the job on the decompression jobs queue
+	 * and takes over the management of decompression_job
+	 */
+	if( libcthreads_queue_push(
+	     internal_handle->decompression_jobs_queue,
+	     (intptr_t *) decompression_job,
+	     &error ) != 1 )
 	{
 		libcerror_error_set(
-		 error,
+		 &error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to push decompression job onto queue.",
 		 function );
 
-		return( -1 );
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( ( libcnotify_verbose != 0 )
+	 && ( error != NULL ) )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
 	}
 #endif
-	return( read_count );
+	libcerror_error_free(
+	 &error );
+
+	return( -1 );
 }
 
-/* Reads (media) data at a specific offset
- * Returns the number of bytes read, 0 when no longer data can be read or -1 on error
+/* Callback function for the prefetch thread pool
+ * Reads and unpacks the chunk of the prefetch job into the chunk cache
+ * Returns 1 if successful or -1 on error
  */
-ssize_t libewf_handle_read_buffer_at_offset(
-         libewf_handle_t *handle,
-         void *buffer,
-         size_t buffer_size,
-         off64_t offset,
-         libcerror_error_t **error )
+int libewf_internal_handle_prefetch_thread_pool_callback(
+     libewf_prefetch_job_t *prefetch_job,
+     libewf_internal_handle_t *internal_handle )
 {
-	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_read_buffer_at_offset";
-	ssize_t read_count                        = 0;
+	libewf_chunk_data_t *chunk_data    = NULL;
+	libcerror_error_t *error           = NULL;
+	static char *function              = "libewf_internal_handle_prefetch_thread_pool_callback";
+	uint64_t number_of_sectors         = 0;
+	uint64_t start_sector              = 0;
+	uint8_t file_io_pool_mutex_grabbed = 0;
+	int result                         = 0;
 
-	if( handle == NULL )
+	if( prefetch_job == NULL )
 	{
 		libcerror_error_set(
-		 error,
+		 &error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid handle.",
+		 "%s: invalid prefetch job.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	internal_handle = (libewf_internal_handle_t *) handle;
-
-	if( internal_handle->file_io_pool == NULL )
+	if( internal_handle == NULL )
 	{
 		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing file IO pool.",
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
+	/* The prefetch job does not grab the read/write lock, since a sequential reader holds it
+	 * for writing, instead the handle waits for outstanding prefetch jobs on close
+	 */
+	if( libcthreads_mutex_grab(
+	     internal_handle->file_io_pool_mutex,
+	     &error ) != 1 )
 	{
 		libcerror_error_set(
-		 error,
+		 &error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 "%s: unable to grab file IO pool mutex.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-#endif
-	if( libewf_internal_handle_seek_offset(
-	     internal_handle,
-	     offset,
-	     SEEK_SET,
-	     error ) == -1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek offset.",
-		 function );
+	file_io_pool_mutex_grabbed = 1;
 
-		read_count = -1;
+	/* The chunk is skipped if the reader already passed the chunk and therefore read it itself
+	 */
+	if( ( internal_handle->file_io_pool == NULL )
+	 || ( internal_handle->chunk_table == NULL )
+	 || ( internal_handle->media_values == NULL )
+	 || ( prefetch_job->chunk_index >= internal_handle->media_values->number_of_chunks )
+	 || ( prefetch_job->chunk_index <= internal_handle->last_read_chunk_index ) )
+	{
+		result = 0;
 	}
-	if( read_count != -1 )
+	else
 	{
-		read_count = libewf_internal_handle_read_buffer_from_file_io_pool(
-		              internal_handle,
-		              internal_handle->file_io_pool,
-		              buffer,
-		              buffer_size,
-		              error );
+		result = libewf_chunk_cache_has_chunk_data(
+		          internal_handle->chunk_table->chunk_cache,
+		          prefetch_job->chunk_index,
+		          &error );
 
-		if( read_count == -1 )
+		if( result == -1 )
 		{
 			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read buffer.",
-			 function );
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine if chunk: %" PRIu64 " is cached.",
+			 function,
+			 prefetch_job->chunk_index );
 
-			read_count = -1;
+			goto on_error;
 		}
+		result = ( result == 0 ) ? 1 : 0;
 	}
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
+	file_io_pool_mutex_grabbed = 0;
+
+	if( libcthreads_mutex_release(
+	     internal_handle->file_io_pool_mutex,
+	     &error ) != 1 )
 	{
 		libcerror_error_set(
-		 error,
+		 &error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 "%s: unable to release file IO pool mutex.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-#endif
-	return( read_count );
-}
-
-/* Writes (media) data at the current offset from a buffer using a Basic File IO (bfio) pool
- * the necessary settings of the write values must have been made
- * Will initialize write if necessary
- * This function is not multi-thread safe acquire write lock before call
- * Returns the number of bytes written, 0 when no longer data can be written or -1 on error
- */
-ssize_t libewf_internal_handle_write_buffer_to_file_io_pool(
-         libewf_internal_handle_t *internal_handle,
-         libbfio_pool_t *file_io_pool,
-         const void *buffer,
-         size_t buffer_size,
-         libcerror_error_t **error )
-{
-	static char *function     = "libewf_internal_handle_write_buffer_to_file_io_pool";
-	size_t buffer_offset      = 0;
-	size_t input_data_size    = 0;
-	size_t write_size         = 0;
-	ssize_t write_count       = 0;
-	off64_t chunk_data_offset = 0;
-	uint64_t chunk_index      = 0;
-	int write_chunk           = 0;
-
-	if( internal_handle == NULL )
+	if( result != 0 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid handle.",
-		 function );
-
-		return( -1 );
-	}
-	if( internal_handle->io_handle == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing IO handle.",
-		 function );
+		if( libewf_internal_handle_read_chunk_data_by_offset_no_cache(
+		     internal_handle,
+		     internal_handle->file_io_pool,
+		     prefetch_job->offset,
+		     &chunk_data,
+		     &error ) == -1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to read chunk data for offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 prefetch_job->offset,
+			 prefetch_job->offset );
 
-		return( -1 );
+			goto on_error;
+		}
 	}
-	if( internal_handle->current_offset < 0 )
+	if( chunk_data != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
-		 function );
+		if( libewf_chunk_data_unpack(
+		     chunk_data,
+		     internal_handle->io_handle,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to unpack chunk: %" PRIu64 " data.",
+			 function,
+			 prefetch_job->chunk_index );
 
-		return( -1 );
-	}
-	if( ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
-	 && ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_RESUME ) == 0 ) )
-	{
-		if( internal_handle->chunk_data != NULL )
+			goto on_error;
+		}
+		/* The checksum error is recorded here since the reader
+		 * retrieves the chunk from the chunk cache
+		 */
+		if( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_CORRUPTED ) != 0 )
+		{
+			start_sector      = chunk_data->range_start_offset / internal_handle->media_values->bytes_per_sector;
+			number_of_sectors = internal_handle->media_values->sectors_per_chunk;
+
+			if( ( start_sector + number_of_sectors ) > (uint64_t) internal_handle->media_values->number_of_sectors )
+			{
+				number_of_sectors = (uint64_t) internal_handle->media_values->number_of_sectors - start_sector;
+			}
+			if( libcthreads_mutex_grab(
+			     internal_handle->file_io_pool_mutex,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to grab file IO pool mutex.",
+				 function );
+
+				goto on_error;
+			}
+			file_io_pool_mutex_grabbed = 1;
+
+			if( libewf_chunk_table_append_checksum_error(
+			     internal_handle->chunk_table,
+			     start_sector,
+			     number_of_sectors,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append checksum error.",
+				 function );
+
+				goto on_error;
+			}
+			file_io_pool_mutex_grabbed = 0;
+
+			if( libcthreads_mutex_release(
+			     internal_handle->file_io_pool_mutex,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to release file IO pool mutex.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		/* The chunk cache takes over management of chunk_data
+		 */
+		result = libewf_chunk_cache_set_chunk_data(
+		          internal_handle->chunk_table->chunk_cache,
+		          prefetch_job->chunk_index,
+		          chunk_data,
+		          1,
+		          &error );
+
+		chunk_data = NULL;
+
+		if( result != 1 )
 		{
 			libcerror_error_set(
-			 error,
+			 &error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-			 "%s: invalid handle - chunk data set.",
-			 function );
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set chunk: %" PRIu64 " data in chunk cache.",
+			 function,
+			 prefetch_job->chunk_index );
 
-			return( -1 );
+			goto on_error;
 		}
 	}
-	if( internal_handle->media_values == NULL )
+	result = 1;
+
+on_error:
+	if( error != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing media values.",
-		 function );
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
 
-		return( -1 );
+		result = -1;
 	}
-	if( internal_handle->media_values->chunk_size == 0 )
+	if( chunk_data != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - invalid media values - missing chunk size.",
-		 function );
-
-		return( -1 );
+		libewf_chunk_data_free(
+		 &chunk_data,
+		 NULL );
 	}
-	if( internal_handle->write_io_handle == NULL )
+	if( internal_handle != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing subhandle write.",
-		 function );
+		if( file_io_pool_mutex_grabbed == 0 )
+		{
+			if( libcthreads_mutex_grab(
+			     internal_handle->file_io_pool_mutex,
+			     NULL ) == 1 )
+			{
+				file_io_pool_mutex_grabbed = 1;
+			}
+		}
+		if( file_io_pool_mutex_grabbed != 0 )
+		{
+			internal_handle->number_of_prefetch_jobs -= 1;
 
-		return( -1 );
+			if( internal_handle->number_of_prefetch_jobs == 0 )
+			{
+				libcthreads_condition_broadcast(
+				 internal_handle->prefetch_condition,
+				 NULL );
+			}
+			libcthreads_mutex_release(
+			 internal_handle->file_io_pool_mutex,
+			 NULL );
+		}
 	}
-	if( buffer == NULL )
+	libewf_prefetch_job_free(
+	 &prefetch_job,
+	 NULL );
+
+	return( result );
+}
+
+/* Schedules prefetch jobs for the chunks that follow a read
+ * Access is considered sequential when consecutive reads continue in the same or the next chunk,
+ * in which case up to prefetch depth chunks after the read are prefetched into the chunk cache
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_schedule_prefetch_jobs(
+     libewf_internal_handle_t *internal_handle,
+     off64_t offset,
+     size_t read_size,
+     libcerror_error_t **error )
+{
+	libewf_prefetch_job_t *prefetch_job = NULL;
+	static char *function               = "libewf_internal_handle_schedule_prefetch_jobs";
+	uint64_t chunk_index                = 0;
+	uint64_t first_chunk_index          = 0;
+	uint64_t last_chunk_index           = 0;
+	uint64_t maximum_chunk_index        = 0;
+	uint64_t next_chunk_index           = 0;
+	int number_of_jobs                  = 0;
+
+	if( internal_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid buffer.",
+		 "%s: invalid handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( buffer_size > (size_t) SSIZE_MAX )
+	if( ( internal_handle->prefetch_thread_pool == NULL )
+	 || ( internal_handle->io_handle == NULL )
+	 || ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_WRITE ) != 0 )
+	 || ( internal_handle->media_values == NULL )
+	 || ( internal_handle->media_values->chunk_size == 0 )
+	 || ( offset < 0 )
+	 || ( read_size == 0 ) )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid buffer size value exceeds maximum.",
-		 function );
-
-		return( -1 );
+		return( 1 );
 	}
-	if( internal_handle->current_offset < 0 )
+	first_chunk_index = (uint64_t) offset / internal_handle->media_values->chunk_size;
+	last_chunk_index  = ( (uint64_t) offset + read_size - 1 ) / internal_handle->media_values->chunk_size;
+
+	if( libcthreads_mutex_grab(
+	     internal_handle->file_io_pool_mutex,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid offset value out of bounds.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab file IO pool mutex.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( internal_handle->media_values->media_size != 0 )
-	 && ( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size ) )
+	if( ( first_chunk_index == internal_handle->last_read_chunk_index )
+	 || ( first_chunk_index == ( internal_handle->last_read_chunk_index + 1 ) ) )
 	{
-		return( 0 );
+		if( internal_handle->number_of_sequential_reads < LIBEWF_PREFETCH_SEQUENTIAL_THRESHOLD )
+		{
+			internal_handle->number_of_sequential_reads += 1;
+		}
 	}
-	internal_handle->io_handle->abort = 0;
-
-	if( ( internal_handle->media_values->media_size != 0 )
-	 && ( (size64_t) ( internal_handle->current_offset + buffer_size ) >= internal_handle->media_values->media_size ) )
+	else
 	{
-		buffer_size = (size_t) ( internal_handle->media_values->media_size - internal_handle->current_offset );
+		internal_handle->number_of_sequential_reads = 0;
+		internal_handle->next_prefetch_chunk_index  = 0;
 	}
-	chunk_index = internal_handle->current_offset / internal_handle->media_values->chunk_size;
+	internal_handle->last_read_chunk_index = last_chunk_index;
 
-	if( chunk_index >= (uint64_t) INT_MAX )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid chunk index value exceeds maximum.",
-		 function );
+	next_chunk_index = internal_handle->next_prefetch_chunk_index;
 
-		return( -1 );
+	if( next_chunk_index <= last_chunk_index )
+	{
+		next_chunk_index = last_chunk_index + 1;
 	}
-	chunk_data_offset = chunk_index * internal_handle->media_values->chunk_size;
-	chunk_data_offset = internal_handle->current_offset - chunk_data_offset;
+	if( internal_handle->number_of_sequential_reads >= LIBEWF_PREFETCH_SEQUENTIAL_THRESHOLD )
+	{
+		maximum_chunk_index = last_chunk_index + (uint64_t) internal_handle->prefetch_depth;
 
-	if( chunk_data_offset >= (off64_t) SSIZE_MAX )
+		if( maximum_chunk_index >= internal_handle->media_values->number_of_chunks )
+		{
+			maximum_chunk_index = internal_handle->media_values->number_of_chunks - 1;
+		}
+		/* The number of outstanding jobs is bounded by the prefetch depth
+		 * so that pushing onto the thread pool never blocks
+		 */
+		if( next_chunk_index <= maximum_chunk_index )
+		{
+			number_of_jobs = internal_handle->prefetch_depth - internal_handle->number_of_prefetch_jobs;
+
+			if( (uint64_t) number_of_jobs > ( maximum_chunk_index - next_chunk_index + 1 ) )
+			{
+				number_of_jobs = (int) ( maximum_chunk_index - next_chunk_index + 1 );
+			}
+		}
+		if( number_of_jobs > 0 )
+		{
+			internal_handle->number_of_prefetch_jobs  += number_of_jobs;
+			internal_handle->next_prefetch_chunk_index = next_chunk_index + (uint64_t) number_of_jobs;
+		}
+	}
+	if( libcthreads_mutex_release(
+	     internal_handle->file_io_pool_mutex,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid chunk data offset value exceeds maximum.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release file IO pool mutex.",
 		 function );
 
 		return( -1 );
 	}
-	while( buffer_size > 0 )
+	for( chunk_index = next_chunk_index;
+	     number_of_jobs > 0;
+	     chunk_index++ )
 	{
-		if( chunk_index < internal_handle->write_io_handle->number_of_chunks_written )
+		if( libewf_prefetch_job_initialize(
+		     &prefetch_job,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-			 "%s: chunk: %" PRIu64 " already exists.",
-			 function,
-			 chunk_index );
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create prefetch job.",
+			 function );
 
-			return( -1 );
-		}
-		if( internal_handle->write_io_handle->write_finalized != 0 )
-		{
-			break;
+			goto on_error;
 		}
-		if( internal_handle->chunk_data == NULL )
-		{
-			if( libewf_chunk_data_initialize(
-			     &( internal_handle->chunk_data ),
-			     internal_handle->media_values->chunk_size,
-			     0,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-				 "%s: unable to create chunk: %" PRIu64 " data.",
-				 function,
-				 chunk_index );
+		prefetch_job->chunk_index = chunk_index;
+		prefetch_job->offset      = (off64_t) ( chunk_index * internal_handle->media_values->chunk_size );
 
-				return( -1 );
-			}
-		}
-		if( internal_handle->chunk_data == NULL )
+		/* The thread pool takes over management of prefetch_job
+		 */
+		if( libcthreads_thread_pool_push(
+		     internal_handle->prefetch_thread_pool,
+		     (intptr_t *) prefetch_job,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: internal handle - missing chunk: %" PRIu64 " data.",
-			 function,
-			 chunk_index );
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push prefetch job onto thread pool.",
+			 function );
 
-			return( -1 );
+			goto on_error;
 		}
-		if( chunk_data_offset > internal_handle->media_values->chunk_size )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-			 "%s: chunk offset exceeds chunk data size.",
-			 function );
-
-			return( -1 );
-		}
-		write_size = (size_t) ( internal_handle->media_values->chunk_size - chunk_data_offset );
-
-		if( write_size > buffer_size )
-		{
-			write_size = buffer_size;
-		}
-		if( write_size == 0 )
-		{
-			break;
-		}
-		if( memory_copy(
-		     &( ( internal_handle->chunk_data->data )[ chunk_data_offset ] ),
-		     &( ( (uint8_t *) buffer )[ buffer_offset ] ),
-		     write_size ) == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-			 "%s: unable to copy buffer to chunk data.",
-			 function );
-
-			return( -1 );
-		}
-		internal_handle->chunk_data->data_size = (size_t) ( chunk_data_offset + write_size );
-
-		buffer_offset += write_size;
-		buffer_size   -= write_size;
-
-		if( internal_handle->chunk_data->data_size == internal_handle->media_values->chunk_size )
-		{
-			write_chunk = 1;
-		}
-		else if( ( internal_handle->media_values->media_size != 0 )
-		      && ( ( (size64_t) internal_handle->current_offset + write_size ) == internal_handle->media_values->media_size ) )
-		{
-			write_chunk = 1;
-		}
-		else
-		{
-			write_chunk = 0;
-		}
-		if( write_chunk != 0 )
-		{
-			input_data_size = internal_handle->chunk_data->data_size;
-
-			if( libewf_chunk_data_pack(
-			     internal_handle->chunk_data,
-			     internal_handle->io_handle,
-			     internal_handle->write_io_handle->compressed_zero_byte_empty_block,
-			     internal_handle->write_io_handle->compressed_zero_byte_empty_block_size,
-			     internal_handle->write_io_handle->pack_flags,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GENERIC,
-				 "%s: unable to pack chunk: %" PRIu64 " data.",
-				 function,
-				 chunk_index );
-
-				return( -1 );
-			}
-			write_count = libewf_write_io_handle_write_new_chunk(
-			               internal_handle->write_io_handle,
-			               internal_handle->io_handle,
-			               file_io_pool,
-			               internal_handle->media_values,
-			               internal_handle->segment_table,
-			               internal_handle->header_values,
-			               internal_handle->hash_values,
-			               internal_handle->hash_sections,
-			               internal_handle->sessions,
-			               internal_handle->tracks,
-			               internal_handle->acquiry_errors,
-			               chunk_index,
-			               internal_handle->chunk_data,
-			               input_data_size,
-			               error );
-
-			if( write_count <= 0 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_IO,
-				 LIBCERROR_IO_ERROR_WRITE_FAILED,
-				 "%s: unable to write new chunk.",
-				 function );
-
-				return( -1 );
-			}
-			if( libewf_chunk_data_free(
-			     &( internal_handle->chunk_data ),
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-				 "%s: unable to free chunk data.",
-				 function );
-
-				return( -1 );
-			}
-		}
-		chunk_index      += 1;
-		chunk_data_offset = 0;
+		prefetch_job = NULL;
 
-		internal_handle->current_offset += (off64_t) write_size;
+		number_of_jobs -= 1;
+	}
+	return( 1 );
 
-		if( ( internal_handle->media_values->media_size != 0 )
-		 && ( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size ) )
-		{
-			break;
-		}
-		if( internal_handle->io_handle->abort != 0 )
-		{
-			break;
-		}
+on_error:
+	if( prefetch_job != NULL )
+	{
+		libewf_prefetch_job_free(
+		 &prefetch_job,
+		 NULL );
 	}
-	internal_handle->io_handle->abort = 0;
+	/* Jobs that were not pushed are no longer outstanding
+	 */
+	if( libcthreads_mutex_grab(
+	     internal_handle->file_io_pool_mutex,
+	     NULL ) == 1 )
+	{
+		internal_handle->number_of_prefetch_jobs  -= number_of_jobs;
+		internal_handle->next_prefetch_chunk_index = chunk_index;
 
-	return( (ssize_t) buffer_offset );
+		libcthreads_mutex_release(
+		 internal_handle->file_io_pool_mutex,
+		 NULL );
+	}
+	return( -1 );
 }
 
-/* Writes (media) data at the current offset
- * the necessary settings of the write values must have been made
- * Will initialize write if necessary
- * Returns the number of bytes written, 0 when no longer data can be written or -1 on error
+/* Waits until the outstanding prefetch jobs have completed
+ * The caller must hold the read/write lock for writing, so no new jobs are scheduled
+ * Returns 1 if successful or -1 on error
  */
-ssize_t libewf_handle_write_buffer(
-         libewf_handle_t *handle,
-         const void *buffer,
-         size_t buffer_size,
-         libcerror_error_t **error )
+int libewf_internal_handle_wait_for_prefetch_jobs(
+     libewf_internal_handle_t *internal_handle,
+     libcerror_error_t **error )
 {
-	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_write_buffer";
-	ssize_t write_count                       = 0;
+	static char *function = "libewf_internal_handle_wait_for_prefetch_jobs";
+	int result            = 1;
 
-	if( handle == NULL )
+	if( internal_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -5100,109 +6092,89 @@ ssize_t libewf_handle_write_buffer(
 
 		return( -1 );
 	}
-	internal_handle = (libewf_internal_handle_t *) handle;
-
-	if( internal_handle->file_io_pool == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing file IO pool.",
-		 function );
-
-		return( -1 );
-	}
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     internal_handle->read_write_lock,
+	if( libcthreads_mutex_grab(
+	     internal_handle->file_io_pool_mutex,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 "%s: unable to grab file IO pool mutex.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	if( internal_handle->write_io_handle->values_initialized == 0 )
+	while( internal_handle->number_of_prefetch_jobs > 0 )
 	{
-		if( libewf_write_io_handle_initialize_values(
-		     internal_handle->write_io_handle,
-		     internal_handle->io_handle,
-		     internal_handle->media_values,
-		     internal_handle->segment_table,
+		if( libcthreads_condition_wait(
+		     internal_handle->prefetch_condition,
+		     internal_handle->file_io_pool_mutex,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to initialize write IO handle values.",
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to wait for prefetch condition.",
 			 function );
 
-			write_count = -1;
-		}
-	}
-	if( write_count != -1 )
-	{
-		write_count = libewf_internal_handle_write_buffer_to_file_io_pool(
-		               internal_handle,
-		               internal_handle->file_io_pool,
-		               buffer,
-		               buffer_size,
-		               error );
-
-		if( write_count == -1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to write buffer.",
-			 function );
+			result = -1;
 
-			write_count = -1;
+			break;
 		}
 	}
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
-	     internal_handle->read_write_lock,
+	internal_handle->number_of_sequential_reads = 0;
+	internal_handle->next_prefetch_chunk_index  = 0;
+
+	if( libcthreads_mutex_release(
+	     internal_handle->file_io_pool_mutex,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 "%s: unable to release file IO pool mutex.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	return( write_count );
+	return( result );
 }
 
-/* Writes (media) data at a specific offset,
- * the necessary settings of the write values must have been made
- * Will initialize write if necessary
- * Returns the number of bytes written, 0 when no longer data can be written or -1 on error
+/* Reads (media) data at the current offset into a buffer using the decompression threads
+ * The chunk data is read from the file IO pool by the calling thread
+ * and unpacked directly into the buffer by the decompression threads
+ * Returns the number of bytes read, 0 when no longer data can be read or -1 on error
  */
-ssize_t libewf_handle_write_buffer_at_offset(
-         libewf_handle_t *handle,
-         const void *buffer,
+ssize_t libewf_internal_handle_read_buffer_from_file_io_pool_with_threads(
+         libewf_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         void *buffer,
          size_t buffer_size,
-         off64_t offset,
          libcerror_error_t **error )
 {
-	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_write_buffer_at_offset";
-	ssize_t write_count                       = 0;
+	libewf_chunk_data_t *chunks_data[ LIBEWF_MAXIMUM_NUMBER_OF_CHUNKS_PER_READ_VECTOR ];
+
+	libewf_chunk_data_t *chunk_data               = NULL;
+	libewf_decompression_job_t *decompression_job = NULL;
+	static char *function                         = "libewf_internal_handle_read_buffer_from_file_io_pool_with_threads";
+	off64_t chunk_data_offset                     = 0;
+	size_t buffer_offset                          = 0;
+	size_t read_size                              = 0;
+	uint64_t chunk_index                          = 0;
+	uint64_t number_of_sectors                    = 0;
+	uint64_t start_sector                         = 0;
+	uint8_t file_io_pool_mutex_grabbed            = 0;
+	int chunks_data_index                         = 0;
+	int maximum_number_of_chunks                  = 0;
+	int maximum_number_of_jobs                    = 0;
+	int number_of_chunks_data                     = 0;
+	int number_of_jobs                            = 0;
+	int result                                    = 0;
 
-	if( handle == NULL )
+	if( internal_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -5213,136 +6185,29 @@ ssize_t libewf_handle_write_buffer_at_offset(
 
 		return( -1 );
 	}
-	internal_handle = (libewf_internal_handle_t *) handle;
-
-	if( internal_handle->file_io_pool == NULL )
+	if( internal_handle->io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing file IO pool.",
+		 "%s: invalid handle - missing IO handle.",
 		 function );
 
 		return( -1 );
 	}
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
+	if( internal_handle->chunk_table == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing chunk table.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	if( internal_handle->write_io_handle->values_initialized == 0 )
-	{
-		if( libewf_write_io_handle_initialize_values(
-		     internal_handle->write_io_handle,
-		     internal_handle->io_handle,
-		     internal_handle->media_values,
-		     internal_handle->segment_table,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to initialize write IO handle values.",
-			 function );
-
-			write_count = -1;
-		}
-	}
-	if( write_count != -1 )
-	{
-		if( libewf_internal_handle_seek_offset(
-		     internal_handle,
-		     offset,
-		     SEEK_SET,
-		     error ) == -1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_SEEK_FAILED,
-			 "%s: unable to seek offset.",
-			 function );
-
-			write_count = -1;
-		}
-	}
-	if( write_count != -1 )
-	{
-		write_count = libewf_internal_handle_write_buffer_to_file_io_pool(
-		               internal_handle,
-		               internal_handle->file_io_pool,
-		               buffer,
-		               buffer_size,
-		               error );
-
-		if( write_count == -1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to write buffer.",
-			 function );
-
-			write_count = -1;
-		}
-	}
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
-		 function );
-
-		return( -1 );
-	}
-#endif
-	return( write_count );
-}
-
-/* Retrieves a (media) data chunk
- * Returns 1 if successful or -1 on error
- */
-int libewf_handle_get_data_chunk(
-     libewf_handle_t *handle,
-     libewf_data_chunk_t **data_chunk,
-     libcerror_error_t **error )
-{
-	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_get_data_chunk";
-	int result                                = 1;
-
-	if( handle == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid handle.",
-		 function );
-
-		return( -1 );
-	}
-	internal_handle = (libewf_internal_handle_t *) handle;
-
-	if( internal_handle->media_values == NULL )
+	if( internal_handle->media_values == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -5353,253 +6218,3919 @@ int libewf_handle_get_data_chunk(
 
 		return( -1 );
 	}
-	if( data_chunk == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid data chunk.",
-		 function );
-
-		return( -1 );
-	}
-	if( *data_chunk != NULL )
+	if( internal_handle->media_values->chunk_size == 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: data chunk value already set.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - invalid media values - missing chunk size.",
 		 function );
 
 		return( -1 );
 	}
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
+	if( internal_handle->decompression_thread_pool == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing decompression thread pool.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	if( ( internal_handle->write_io_handle != NULL )
-	 && ( internal_handle->write_io_handle->values_initialized == 0 ) )
-	{
-		if( libewf_write_io_handle_initialize_values(
-		     internal_handle->write_io_handle,
-		     internal_handle->io_handle,
-		     internal_handle->media_values,
-		     internal_handle->segment_table,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to initialize write IO handle values.",
-			 function );
-
-			result = -1;
-		}
-	}
-	if( result != -1 )
-	{
-		if( libewf_data_chunk_initialize(
-		     data_chunk,
-		     internal_handle->io_handle,
-		     internal_handle->write_io_handle,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create data chunk.",
-			 function );
-
-			result = -1;
-		}
-	}
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
+	if( internal_handle->decompression_jobs_queue == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing decompression jobs queue.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	return( result );
-}
-
-/* Reads a (media) data chunk at the current offset
- * This function is not multi-thread safe acquire write lock before call
- * Returns the number of bytes in the data chunk, 0 when no longer data can be read or -1 on error
- */
-ssize_t libewf_internal_handle_read_data_chunk_from_file_io_pool(
-         libewf_internal_handle_t *internal_handle,
-         libbfio_pool_t *file_io_pool,
-         libewf_internal_data_chunk_t *internal_data_chunk,
-         libcerror_error_t **error )
-{
-	libewf_chunk_data_t *chunk_data = NULL;
-	static char *function           = "libewf_internal_handle_read_data_chunk_from_file_io_pool";
-	off64_t chunk_data_offset       = 0;
-	size_t read_count               = 0;
-
-	if( internal_handle == NULL )
+	if( buffer == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid handle.",
+		 "%s: invalid buffer.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->io_handle == NULL )
+	if( buffer_size > (size_t) SSIZE_MAX )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing IO handle.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->chunk_data != NULL )
+	if( memory_set(
+	     chunks_data,
+	     0,
+	     sizeof( libewf_chunk_data_t * ) * LIBEWF_MAXIMUM_NUMBER_OF_CHUNKS_PER_READ_VECTOR ) == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - chunk data set.",
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear chunks data.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->current_offset < 0 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
-		 function );
+	maximum_number_of_jobs = internal_handle->number_of_decompression_threads * LIBEWF_DECOMPRESSION_JOBS_PER_THREAD;
 
-		return( -1 );
-	}
-	if( internal_handle->media_values == NULL )
+	while( ( buffer_size > 0 )
+	    || ( number_of_jobs > 0 ) )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing media values.",
-		 function );
+		if( ( buffer_size > 0 )
+		 && ( number_of_jobs < maximum_number_of_jobs )
+		 && ( internal_handle->io_handle->abort == 0 ) )
+		{
+			chunk_index       = (uint64_t) internal_handle->current_offset / internal_handle->media_values->chunk_size;
+			chunk_data_offset = internal_handle->current_offset - (off64_t) ( chunk_index * internal_handle->media_values->chunk_size );
+
+			result = libewf_chunk_cache_copy_data(
+			          internal_handle->chunk_table->chunk_cache,
+			          chunk_index,
+			          chunk_data_offset,
+			          &( ( (uint8_t *) buffer )[ buffer_offset ] ),
+			          buffer_size,
+			          &read_size,
+			          error );
 
-		return( -1 );
-	}
-	if( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size )
-	{
-		return( 0 );
-	}
-	if( libewf_chunk_table_get_chunk_data_by_offset_no_cache(
-	     internal_handle->chunk_table,
-	     internal_handle->io_handle,
-	     file_io_pool,
-	     internal_handle->media_values,
-	     internal_handle->segment_table,
-	     internal_handle->current_offset,
-	     &chunk_data_offset,
-	     &chunk_data,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve chunk data for offset: %" PRIi64 " (0x%08" PRIx64 ").",
-		 function,
-		 internal_handle->current_offset,
-		 internal_handle->current_offset );
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to copy chunk: %" PRIu64 " data from chunk cache.",
+				 function,
+				 chunk_index );
 
-		goto on_error;
+				goto on_error;
+			}
+			else if( result == 0 )
+			{
+				/* Chunks that were read ahead by a previous vectored read
+				 * but have since been retrieved from the chunk cache are discarded
+				 */
+				while( ( chunks_data_index < number_of_chunks_data )
+				    && ( chunks_data[ chunks_data_index ]->chunk_index != chunk_index ) )
+				{
+					if( libewf_chunk_data_free(
+					     &( chunks_data[ chunks_data_index ] ),
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+						 "%s: unable to free chunk data.",
+						 function );
+
+						goto on_error;
+					}
+					chunks_data_index++;
+				}
+				/* The chunks spanned by the remainder of the buffer are read
+				 * using a single vectored read per segment file
+				 */
+				if( chunks_data_index >= number_of_chunks_data )
+				{
+					chunks_data_index     = 0;
+					number_of_chunks_data = 0;
+
+					maximum_number_of_chunks = (int) ( ( (size64_t) chunk_data_offset + buffer_size + internal_handle->media_values->chunk_size - 1 ) / internal_handle->media_values->chunk_size );
+
+					if( maximum_number_of_chunks > ( maximum_number_of_jobs - number_of_jobs ) )
+					{
+						maximum_number_of_chunks = maximum_number_of_jobs - number_of_jobs;
+					}
+					if( maximum_number_of_chunks > LIBEWF_MAXIMUM_NUMBER_OF_CHUNKS_PER_READ_VECTOR )
+					{
+						maximum_number_of_chunks = LIBEWF_MAXIMUM_NUMBER_OF_CHUNKS_PER_READ_VECTOR;
+					}
+					if( maximum_number_of_chunks > 1 )
+					{
+						if( libcthreads_mutex_grab(
+						     internal_handle->file_io_pool_mutex,
+						     error ) != 1 )
+						{
+							libcerror_error_set(
+							 error,
+							 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+							 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+							 "%s: unable to grab file IO pool mutex.",
+							 function );
+
+							goto on_error;
+						}
+						file_io_pool_mutex_grabbed = 1;
+
+						if( libewf_chunk_table_get_chunks_data_by_offset_no_cache(
+						     internal_handle->chunk_table,
+						     internal_handle->io_handle,
+						     file_io_pool,
+						     internal_handle->media_values,
+						     internal_handle->segment_table,
+						     internal_handle->current_offset,
+						     chunks_data,
+						     maximum_number_of_chunks,
+						     &number_of_chunks_data,
+						     error ) != 1 )
+						{
+							libcerror_error_set(
+							 error,
+							 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+							 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+							 "%s: unable to retrieve chunks data for offset: %" PRIi64 " (0x%08" PRIx64 ").",
+							 function,
+							 internal_handle->current_offset,
+							 internal_handle->current_offset );
+
+							goto on_error;
+						}
+						file_io_pool_mutex_grabbed = 0;
+
+						if( libcthreads_mutex_release(
+						     internal_handle->file_io_pool_mutex,
+						     error ) != 1 )
+						{
+							libcerror_error_set(
+							 error,
+							 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+							 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+							 "%s: unable to release file IO pool mutex.",
+							 function );
+
+							goto on_error;
+						}
+					}
+				}
+				if( chunks_data_index < number_of_chunks_data )
+				{
+					chunk_data = chunks_data[ chunks_data_index ];
+
+					chunks_data[ chunks_data_index++ ] = NULL;
+				}
+				else
+				{
+					/* The file IO pool is shared with the prefetch thread
+					 */
+					if( libcthreads_mutex_grab(
+					     internal_handle->file_io_pool_mutex,
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+						 "%s: unable to grab file IO pool mutex.",
+						 function );
+
+						goto on_error;
+					}
+					file_io_pool_mutex_grabbed = 1;
+
+					if( libewf_chunk_table_get_chunk_data_by_offset_no_cache(
+					     internal_handle->chunk_table,
+					     internal_handle->io_handle,
+					     file_io_pool,
+					     internal_handle->media_values,
+					     internal_handle->segment_table,
+					     internal_handle->current_offset,
+					     &chunk_data_offset,
+					     &chunk_data,
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+						 "%s: unable to retrieve chunk data for offset: %" PRIi64 " (0x%08" PRIx64 ").",
+						 function,
+						 internal_handle->current_offset,
+						 internal_handle->current_offset );
+
+						goto on_error;
+					}
+					file_io_pool_mutex_grabbed = 0;
+
+					if( libcthreads_mutex_release(
+					     internal_handle->file_io_pool_mutex,
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+						 "%s: unable to release file IO pool mutex.",
+						 function );
+
+						goto on_error;
+					}
+				}
+				if( chunk_data == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+					 "%s: missing chunk data for offset: %" PRIi64 " (0x%08" PRIx64 ").",
+					 function,
+					 internal_handle->current_offset,
+					 internal_handle->current_offset );
+
+					goto on_error;
+				}
+				/* The size of the unpacked chunk data is not known before it is unpacked
+				 * hence the read size is determined by the chunk size, the buffer size
+				 * was already limited to the media size
+				 */
+				read_size = (size_t) ( internal_handle->media_values->chunk_size - chunk_data_offset );
+
+				if( read_size > buffer_size )
+				{
+					read_size = buffer_size;
+				}
+				if( libewf_decompression_job_initialize(
+				     &decompression_job,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+					 "%s: unable to create decompression job.",
+					 function );
+
+					goto on_error;
+				}
+				decompression_job->chunk_index       = chunk_index;
+				decompression_job->chunk_data        = chunk_data;
+				decompression_job->chunk_data_offset = chunk_data_offset;
+				decompression_job->buffer            = &( ( (uint8_t *) buffer )[ buffer_offset ] );
+				decompression_job->buffer_size       = read_size;
+
+				chunk_data = NULL;
+
+				if( libcthreads_thread_pool_push(
+				     internal_handle->decompression_thread_pool,
+				     (intptr_t *) decompression_job,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+					 "%s: unable to push decompression job onto thread pool queue.",
+					 function );
+
+					goto on_error;
+				}
+				decompression_job = NULL;
+
+				number_of_jobs++;
+			}
+			if( read_size == 0 )
+			{
+				/* Stop reading but make sure the outstanding jobs are finished
+				 */
+				buffer_size = 0;
+
+				continue;
+			}
+			buffer_offset += read_size;
+			buffer_size   -= read_size;
+
+			internal_handle->current_offset += (off64_t) read_size;
+		}
+		else if( number_of_jobs > 0 )
+		{
+			if( libcthreads_queue_pop(
+			     internal_handle->decompression_jobs_queue,
+			     (intptr_t **) &decompression_job,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to pop decompression job from queue.",
+				 function );
+
+				goto on_error;
+			}
+			number_of_jobs--;
+
+			if( decompression_job == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+				 "%s: missing decompression job.",
+				 function );
+
+				goto on_error;
+			}
+			if( decompression_job->result != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to decompress chunk: %" PRIu64 " data.",
+				 function,
+				 decompression_job->chunk_index );
+
+				goto on_error;
+			}
+			if( ( decompression_job->chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_CORRUPTED ) != 0 )
+			{
+				start_sector      = decompression_job->chunk_data->range_start_offset / internal_handle->media_values->bytes_per_sector;
+				number_of_sectors = internal_handle->media_values->sectors_per_chunk;
+
+				if( ( start_sector + number_of_sectors ) > (uint64_t) internal_handle->media_values->number_of_sectors )
+				{
+					number_of_sectors = (uint64_t) internal_handle->media_values->number_of_sectors - start_sector;
+				}
+				if( libcthreads_mutex_grab(
+				     internal_handle->file_io_pool_mutex,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to grab file IO pool mutex.",
+					 function );
+
+					goto on_error;
+				}
+				file_io_pool_mutex_grabbed = 1;
+
+				if( libewf_chunk_table_append_checksum_error(
+				     internal_handle->chunk_table,
+				     start_sector,
+				     number_of_sectors,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+					 "%s: unable to append checksum error.",
+					 function );
+
+					goto on_error;
+				}
+				file_io_pool_mutex_grabbed = 0;
+
+				if( libcthreads_mutex_release(
+				     internal_handle->file_io_pool_mutex,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to release file IO pool mutex.",
+					 function );
+
+					goto on_error;
+				}
+			}
+			/* The chunk cache takes over management of the chunk data
+			 */
+			result = libewf_chunk_cache_set_chunk_data(
+			          internal_handle->chunk_table->chunk_cache,
+			          decompression_job->chunk_index,
+			          decompression_job->chunk_data,
+			          0,
+			          error );
+
+			decompression_job->chunk_data = NULL;
+
+			if( result != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set chunk: %" PRIu64 " data in chunk cache.",
+				 function,
+				 decompression_job->chunk_index );
+
+				goto on_error;
+			}
+			if( libewf_decompression_job_free(
+			     &decompression_job,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free decompression job.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		else
+		{
+			break;
+		}
+	}
+	/* Chunks that were read ahead but not used, for example when reading was aborted
+	 */
+	while( chunks_data_index < number_of_chunks_data )
+	{
+		if( chunks_data[ chunks_data_index ] != NULL )
+		{
+			libewf_chunk_data_free(
+			 &( chunks_data[ chunks_data_index ] ),
+			 NULL );
+		}
+		chunks_data_index++;
+	}
+	internal_handle->io_handle->abort = 0;
+
+	return( (ssize_t) buffer_offset );
+
+on_error:
+	if( file_io_pool_mutex_grabbed != 0 )
+	{
+		libcthreads_mutex_release(
+		 internal_handle->file_io_pool_mutex,
+		 NULL );
+	}
+	if( decompression_job != NULL )
+	{
+		libewf_decompression_job_free(
+		 &decompression_job,
+		 NULL );
+	}
+	if( chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 &chunk_data,
+		 NULL );
+	}
+	while( chunks_data_index < number_of_chunks_data )
+	{
+		if( chunks_data[ chunks_data_index ] != NULL )
+		{
+			libewf_chunk_data_free(
+			 &( chunks_data[ chunks_data_index ] ),
+			 NULL );
+		}
+		chunks_data_index++;
+	}
+	/* Wait for the outstanding jobs since they write into the buffer
+	 */
+	while( number_of_jobs > 0 )
+	{
+		if( libcthreads_queue_pop(
+		     internal_handle->decompression_jobs_queue,
+		     (intptr_t **) &decompression_job,
+		     NULL ) != 1 )
+		{
+			break;
+		}
+		number_of_jobs--;
+
+		libewf_decompression_job_free(
+		 &decompression_job,
+		 NULL );
+	}
+	internal_handle->io_handle->abort = 0;
+
+	return( -1 );
+}
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+/* Reads (media) data at the current offset into a buffer
+ * Returns the number of bytes read, 0 when no longer data can be read or -1 on error
+ */
+ssize_t libewf_handle_read_buffer(
+         libewf_handle_t *handle,
+         void *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_read_buffer";
+	ssize_t read_count                        = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	read_count = libewf_internal_handle_read_buffer_from_file_io_pool(
+		      internal_handle,
+		      internal_handle->file_io_pool,
+		      buffer,
+		      buffer_size,
+		      error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer.",
+		 function );
+
+		read_count = -1;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( read_count );
+}
+
+/* Reads the chunk data of a chunk at a specific offset without caching
+ * The chunk is looked up while the file IO pool mutex is grabbed, the chunk data is read
+ * after the mutex is released if the file IO pool entry supports shared reads,
+ * so that multiple readers can read from the segment files concurrently
+ * The chunk data is managed by the caller
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libewf_internal_handle_read_chunk_data_by_offset_no_cache(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     off64_t offset,
+     libewf_chunk_data_t **chunk_data,
+     libcerror_error_t **error )
+{
+	libewf_chunk_data_t *safe_chunk_data = NULL;
+	static char *function                = "libewf_internal_handle_read_chunk_data_by_offset_no_cache";
+	off64_t chunk_data_offset            = 0;
+	size64_t chunk_data_size             = 0;
+	ssize_t read_count                   = 0;
+	uint32_t chunk_data_flags            = 0;
+	int file_io_pool_entry               = -1;
+	int result                           = 0;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	uint8_t file_io_pool_mutex_grabbed   = 0;
+	int supports_shared_read             = 0;
+#endif
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     internal_handle->file_io_pool_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab file IO pool mutex.",
+		 function );
+
+		return( -1 );
+	}
+	file_io_pool_mutex_grabbed = 1;
+#endif
+	result = libewf_chunk_table_get_chunk_data_range_by_offset(
+	          internal_handle->chunk_table,
+	          internal_handle->io_handle,
+	          file_io_pool,
+	          internal_handle->media_values,
+	          internal_handle->segment_table,
+	          offset,
+	          &safe_chunk_data,
+	          &file_io_pool_entry,
+	          &chunk_data_offset,
+	          &chunk_data_size,
+	          &chunk_data_flags,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk data range for offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 offset,
+		 offset );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( result != 0 )
+	{
+		supports_shared_read = libbfio_pool_supports_shared_read(
+		                        file_io_pool,
+		                        file_io_pool_entry,
+		                        error );
+
+		if( supports_shared_read == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine if file IO pool entry: %d supports shared reads.",
+			 function,
+			 file_io_pool_entry );
+
+			goto on_error;
+		}
+	}
+	/* A file IO pool entry that does not support shared reads changes the state of the
+	 * file IO pool or its handle when read, hence it is read while the mutex is grabbed
+	 */
+	if( supports_shared_read != 0 )
+	{
+		file_io_pool_mutex_grabbed = 0;
+
+		if( libcthreads_mutex_release(
+		     internal_handle->file_io_pool_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release file IO pool mutex.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif
+	if( result != 0 )
+	{
+		read_count = libewf_chunk_data_read_from_file_io_pool(
+		              safe_chunk_data,
+		              file_io_pool,
+		              file_io_pool_entry,
+		              chunk_data_offset,
+		              chunk_data_size,
+		              chunk_data_flags,
+		              error );
+
+		if( read_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read chunk: %" PRIu64 " data.",
+			 function,
+			 safe_chunk_data->chunk_index );
+
+			goto on_error;
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( file_io_pool_mutex_grabbed != 0 )
+	{
+		file_io_pool_mutex_grabbed = 0;
+
+		if( libcthreads_mutex_release(
+		     internal_handle->file_io_pool_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release file IO pool mutex.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif
+	*chunk_data = safe_chunk_data;
+
+	return( result );
+
+on_error:
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( file_io_pool_mutex_grabbed != 0 )
+	{
+		libcthreads_mutex_release(
+		 internal_handle->file_io_pool_mutex,
+		 NULL );
+	}
+#endif
+	if( safe_chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 &safe_chunk_data,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads (media) data at a specific offset into a buffer using a Basic File IO (bfio) pool
+ * This function can be called concurrently by readers that hold the read lock,
+ * chunk data is read from the chunk cache or from the segment files, where only
+ * the chunk lookup is serialized by the file IO pool mutex
+ * Returns the number of bytes read, 0 when no longer data can be read or -1 on error
+ */
+ssize_t libewf_internal_handle_read_buffer_at_offset_from_file_io_pool(
+         libewf_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	libewf_chunk_data_t *chunk_data = NULL;
+	static char *function           = "libewf_internal_handle_read_buffer_at_offset_from_file_io_pool";
+	off64_t chunk_data_offset       = 0;
+	size_t buffer_offset            = 0;
+	size_t read_size                = 0;
+	uint64_t chunk_index            = 0;
+	uint64_t number_of_sectors      = 0;
+	uint64_t start_sector           = 0;
+	int result                      = 0;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	uint8_t file_io_pool_mutex_grabbed = 0;
+#endif
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->chunk_data != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - chunk data set.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->chunk_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing chunk table.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( (size64_t) offset < internal_handle->media_values->media_size )
+	{
+		if( (size64_t) ( offset + buffer_size ) >= internal_handle->media_values->media_size )
+		{
+			buffer_size = (size_t) ( internal_handle->media_values->media_size - offset );
+		}
+	}
+	else
+	{
+		buffer_size = 0;
+	}
+	while( buffer_size > 0 )
+	{
+		chunk_index       = (uint64_t) offset / internal_handle->media_values->chunk_size;
+		chunk_data_offset = offset - (off64_t) ( chunk_index * internal_handle->media_values->chunk_size );
+
+		result = libewf_chunk_cache_copy_data(
+		          internal_handle->chunk_table->chunk_cache,
+		          chunk_index,
+		          chunk_data_offset,
+		          &( ( (uint8_t *) buffer )[ buffer_offset ] ),
+		          buffer_size,
+		          &read_size,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to copy chunk: %" PRIu64 " data from chunk cache.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			/* The chunk data is read without caching so that it is owned by this reader
+			 */
+			result = libewf_internal_handle_read_chunk_data_by_offset_no_cache(
+			          internal_handle,
+			          file_io_pool,
+			          offset,
+			          &chunk_data,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to read chunk data for offset: %" PRIi64 " (0x%08" PRIx64 ").",
+				 function,
+				 offset,
+				 offset );
+
+				goto on_error;
+			}
+			if( chunk_data == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+				 "%s: missing chunk data for offset: %" PRIi64 " (0x%08" PRIx64 ").",
+				 function,
+				 offset,
+				 offset );
+
+				goto on_error;
+			}
+			/* Unpacking is done outside the file IO pool mutex so that
+			 * multiple chunks can be decompressed concurrently
+			 */
+			if( libewf_chunk_data_unpack(
+			     chunk_data,
+			     internal_handle->io_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to unpack chunk: %" PRIu64 " data.",
+				 function,
+				 chunk_index );
+
+				goto on_error;
+			}
+			if( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_CORRUPTED ) != 0 )
+			{
+				start_sector      = chunk_data->range_start_offset / internal_handle->media_values->bytes_per_sector;
+				number_of_sectors = internal_handle->media_values->sectors_per_chunk;
+
+				if( ( start_sector + number_of_sectors ) > (uint64_t) internal_handle->media_values->number_of_sectors )
+				{
+					number_of_sectors = (uint64_t) internal_handle->media_values->number_of_sectors - start_sector;
+				}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+				if( libcthreads_mutex_grab(
+				     internal_handle->file_io_pool_mutex,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to grab file IO pool mutex.",
+					 function );
+
+					goto on_error;
+				}
+				file_io_pool_mutex_grabbed = 1;
+#endif
+				if( libewf_chunk_table_append_checksum_error(
+				     internal_handle->chunk_table,
+				     start_sector,
+				     number_of_sectors,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+					 "%s: unable to append checksum error.",
+					 function );
+
+					goto on_error;
+				}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+				file_io_pool_mutex_grabbed = 0;
+
+				if( libcthreads_mutex_release(
+				     internal_handle->file_io_pool_mutex,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to release file IO pool mutex.",
+					 function );
+
+					goto on_error;
+				}
+#endif
+			}
+			if( (off64_t) chunk_data_offset > (off64_t) chunk_data->data_size )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: chunk: %" PRIu64 " offset exceeds data size.",
+				 function,
+				 chunk_index );
+
+				goto on_error;
+			}
+			read_size = (size_t) ( chunk_data->data_size - chunk_data_offset );
+
+			if( read_size > buffer_size )
+			{
+				read_size = buffer_size;
+			}
+			if( memory_copy(
+			     &( ( (uint8_t *) buffer )[ buffer_offset ] ),
+			     &( ( chunk_data->data )[ chunk_data_offset ] ),
+			     read_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy chunk: %" PRIu64 " data to buffer.",
+				 function,
+				 chunk_index );
+
+				goto on_error;
+			}
+			/* The chunk cache takes over management of chunk_data
+			 */
+			result = libewf_chunk_cache_set_chunk_data(
+			          internal_handle->chunk_table->chunk_cache,
+			          chunk_index,
+			          chunk_data,
+			          0,
+			          error );
+
+			chunk_data = NULL;
+
+			if( result != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set chunk: %" PRIu64 " data in chunk cache.",
+				 function,
+				 chunk_index );
+
+				goto on_error;
+			}
+		}
+		if( read_size == 0 )
+		{
+			break;
+		}
+		buffer_offset += read_size;
+		buffer_size   -= read_size;
+		offset        += (off64_t) read_size;
+
+		if( (size64_t) offset >= internal_handle->media_values->media_size )
+		{
+			break;
+		}
+		/* The abort flag is not reset here since it is shared with other readers
+		 */
+		if( internal_handle->io_handle->abort != 0 )
+		{
+			break;
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     internal_handle->file_io_pool_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab file IO pool mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	internal_handle->current_offset = offset;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     internal_handle->file_io_pool_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release file IO pool mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( (ssize_t) buffer_offset );
+
+on_error:
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( file_io_pool_mutex_grabbed != 0 )
+	{
+		libcthreads_mutex_release(
+		 internal_handle->file_io_pool_mutex,
+		 NULL );
+	}
+#endif
+	if( chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 &chunk_data,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads (media) data at a specific offset
+ * Returns the number of bytes read, 0 when no longer data can be read or -1 on error
+ */
+ssize_t libewf_handle_read_buffer_at_offset(
+         libewf_handle_t *handle,
+         void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_read_buffer_at_offset";
+	ssize_t read_count                        = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_internal_handle_schedule_prefetch_jobs(
+	     internal_handle,
+	     offset,
+	     buffer_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to schedule prefetch jobs.",
+		 function );
+
+		libcthreads_read_write_lock_release_for_read(
+		 internal_handle->read_write_lock,
+		 NULL );
+
+		return( -1 );
+	}
+#endif
+	read_count = libewf_internal_handle_read_buffer_at_offset_from_file_io_pool(
+		      internal_handle,
+		      internal_handle->file_io_pool,
+		      buffer,
+		      buffer_size,
+		      offset,
+		      error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 offset,
+		 offset );
+
+		read_count = -1;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( read_count );
+}
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+/* Callback function for the compression thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_compression_thread_pool_callback(
+     libewf_compression_job_t *compression_job,
+     libewf_internal_handle_t *internal_handle )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "libewf_internal_handle_compression_thread_pool_callback";
+
+	if( compression_job == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression job.",
+		 function );
+
+		goto on_error;
+	}
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		goto on_error;
+	}
+	compression_job->result = libewf_compression_job_run(
+	                           compression_job,
+	                           internal_handle->io_handle,
+	                           internal_handle->write_io_handle,
+	                           &error );
+
+	if( compression_job->result != 1 )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( ( libcnotify_verbose != 0 )
+		 && ( error != NULL ) )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	/* The writer waits for the job on the compression jobs queue,
+	 * the job remains managed by the compression jobs of the handle
+	 */
+	if( libcthreads_queue_push(
+	     internal_handle->compression_jobs_queue,
+	     (intptr_t *) compression_job,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to push compression job onto queue.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( ( libcnotify_verbose != 0 )
+	 && ( error != NULL ) )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+	}
+#endif
+	libcerror_error_free(
+	 &error );
+
+	return( -1 );
+}
+
+/* Writes the packed chunks of the compression jobs in chunk order
+ * until at most maximum number of jobs remain outstanding
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_write_compression_jobs(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     int maximum_number_of_jobs,
+     libcerror_error_t **error )
+{
+	libewf_compression_job_t *compression_job          = NULL;
+	libewf_compression_job_t *finished_compression_job = NULL;
+	static char *function                              = "libewf_internal_handle_write_compression_jobs";
+	ssize_t write_count                                = 0;
+	int jobs_array_size                                = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_jobs < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid maximum number of jobs value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	jobs_array_size = internal_handle->number_of_compression_threads * LIBEWF_COMPRESSION_JOBS_PER_THREAD;
+
+	while( internal_handle->number_of_compression_jobs > maximum_number_of_jobs )
+	{
+		compression_job = internal_handle->compression_jobs[ internal_handle->compression_jobs_index ];
+
+		if( compression_job == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing compression job: %d.",
+			 function,
+			 internal_handle->compression_jobs_index );
+
+			return( -1 );
+		}
+		/* The jobs finish in arbitrary order, mark the finished jobs
+		 * until the oldest outstanding job has finished
+		 */
+		while( compression_job->is_finished == 0 )
+		{
+			if( libcthreads_queue_pop(
+			     internal_handle->compression_jobs_queue,
+			     (intptr_t **) &finished_compression_job,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to pop compression job from queue.",
+				 function );
+
+				return( -1 );
+			}
+			if( finished_compression_job == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+				 "%s: missing finished compression job.",
+				 function );
+
+				return( -1 );
+			}
+			finished_compression_job->is_finished = 1;
+		}
+		internal_handle->compression_jobs[ internal_handle->compression_jobs_index ] = NULL;
+
+		internal_handle->compression_jobs_index += 1;
+
+		if( internal_handle->compression_jobs_index >= jobs_array_size )
+		{
+			internal_handle->compression_jobs_index = 0;
+		}
+		internal_handle->number_of_compression_jobs -= 1;
+
+		if( compression_job->result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to pack chunk: %" PRIu64 " data.",
+			 function,
+			 compression_job->chunk_index );
+
+			goto on_error;
+		}
+		write_count = libewf_write_io_handle_write_new_chunk(
+		               internal_handle->write_io_handle,
+		               internal_handle->io_handle,
+		               file_io_pool,
+		               internal_handle->media_values,
+		               internal_handle->segment_table,
+		               internal_handle->header_values,
+		               internal_handle->hash_values,
+		               internal_handle->hash_sections,
+		               internal_handle->sessions,
+		               internal_handle->tracks,
+		               internal_handle->acquiry_errors,
+		               compression_job->chunk_index,
+		               compression_job->chunk_data,
+		               compression_job->input_data_size,
+		               error );
+
+		if( write_count <= 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write new chunk: %" PRIu64 ".",
+			 function,
+			 compression_job->chunk_index );
+
+			goto on_error;
+		}
+		if( libewf_compression_job_free(
+		     &compression_job,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free compression job.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( compression_job != NULL )
+	{
+		libewf_compression_job_free(
+		 &compression_job,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Frees the compression jobs that have not been written
+ * Waits for the outstanding jobs to finish before they are freed
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_free_compression_jobs(
+     libewf_internal_handle_t *internal_handle,
+     libcerror_error_t **error )
+{
+	libewf_compression_job_t *compression_job          = NULL;
+	libewf_compression_job_t *finished_compression_job = NULL;
+	static char *function                              = "libewf_internal_handle_free_compression_jobs";
+	int jobs_array_size                                = 0;
+	int result                                         = 1;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	jobs_array_size = internal_handle->number_of_compression_threads * LIBEWF_COMPRESSION_JOBS_PER_THREAD;
+
+	while( internal_handle->number_of_compression_jobs > 0 )
+	{
+		compression_job = internal_handle->compression_jobs[ internal_handle->compression_jobs_index ];
+
+		while( ( compression_job != NULL )
+		    && ( compression_job->is_finished == 0 ) )
+		{
+			if( libcthreads_queue_pop(
+			     internal_handle->compression_jobs_queue,
+			     (intptr_t **) &finished_compression_job,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to pop compression job from queue.",
+				 function );
+
+				return( -1 );
+			}
+			if( finished_compression_job != NULL )
+			{
+				finished_compression_job->is_finished = 1;
+			}
+		}
+		internal_handle->compression_jobs[ internal_handle->compression_jobs_index ] = NULL;
+
+		internal_handle->compression_jobs_index += 1;
+
+		if( internal_handle->compression_jobs_index >= jobs_array_size )
+		{
+			internal_handle->compression_jobs_index = 0;
+		}
+		internal_handle->number_of_compression_jobs -= 1;
+
+		if( libewf_compression_job_free(
+		     &compression_job,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free compression job.",
+			 function );
+
+			result = -1;
+		}
+	}
+	internal_handle->compression_jobs_index = 0;
+
+	return( result );
+}
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+/* Writes (media) data at the current offset from a buffer using a Basic File IO (bfio) pool
+ * the necessary settings of the write values must have been made
+ * Will initialize write if necessary
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns the number of bytes written, 0 when no longer data can be written or -1 on error
+ */
+ssize_t libewf_internal_handle_write_buffer_to_file_io_pool(
+         libewf_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         const void *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libewf_compression_job_t *compression_job = NULL;
+	int jobs_index                            = 0;
+	int maximum_number_of_jobs                = 0;
+#endif
+	static char *function                     = "libewf_internal_handle_write_buffer_to_file_io_pool";
+	size_t buffer_offset                      = 0;
+	size_t input_data_size                    = 0;
+	size_t write_size                         = 0;
+	ssize_t write_count                       = 0;
+	off64_t chunk_data_offset                 = 0;
+	uint64_t chunk_index                      = 0;
+	uint64_t number_of_chunks_written         = 0;
+	int write_chunk                           = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->current_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
+	 && ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_RESUME ) == 0 ) )
+	{
+		if( internal_handle->chunk_data != NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+			 "%s: invalid handle - chunk data set.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->write_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing subhandle write.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->current_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( internal_handle->media_values->media_size != 0 )
+	 && ( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size ) )
+	{
+		return( 0 );
+	}
+	internal_handle->io_handle->abort = 0;
+
+	if( ( internal_handle->media_values->media_size != 0 )
+	 && ( (size64_t) ( internal_handle->current_offset + buffer_size ) >= internal_handle->media_values->media_size ) )
+	{
+		buffer_size = (size_t) ( internal_handle->media_values->media_size - internal_handle->current_offset );
+	}
+	chunk_index = internal_handle->current_offset / internal_handle->media_values->chunk_size;
+
+	if( chunk_index >= (uint64_t) INT_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid chunk index value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	chunk_data_offset = chunk_index * internal_handle->media_values->chunk_size;
+	chunk_data_offset = internal_handle->current_offset - chunk_data_offset;
+
+	if( chunk_data_offset >= (off64_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid chunk data offset value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	maximum_number_of_jobs = internal_handle->number_of_compression_threads * LIBEWF_COMPRESSION_JOBS_PER_THREAD;
+#endif
+	while( buffer_size > 0 )
+	{
+		/* The chunks of the outstanding compression jobs are considered written
+		 */
+		number_of_chunks_written = internal_handle->write_io_handle->number_of_chunks_written;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		number_of_chunks_written += internal_handle->number_of_compression_jobs;
+#endif
+		if( chunk_index < number_of_chunks_written )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+			 "%s: chunk: %" PRIu64 " already exists.",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+		if( internal_handle->write_io_handle->write_finalized != 0 )
+		{
+			break;
+		}
+		if( internal_handle->chunk_data == NULL )
+		{
+			if( libewf_chunk_data_initialize(
+			     &( internal_handle->chunk_data ),
+			     internal_handle->media_values->chunk_size,
+			     0,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create chunk: %" PRIu64 " data.",
+				 function,
+				 chunk_index );
+
+				return( -1 );
+			}
+		}
+		if( internal_handle->chunk_data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: internal handle - missing chunk: %" PRIu64 " data.",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+		if( chunk_data_offset > internal_handle->media_values->chunk_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: chunk offset exceeds chunk data size.",
+			 function );
+
+			return( -1 );
+		}
+		write_size = (size_t) ( internal_handle->media_values->chunk_size - chunk_data_offset );
+
+		if( write_size > buffer_size )
+		{
+			write_size = buffer_size;
+		}
+		if( write_size == 0 )
+		{
+			break;
+		}
+		if( memory_copy(
+		     &( ( internal_handle->chunk_data->data )[ chunk_data_offset ] ),
+		     &( ( (uint8_t *) buffer )[ buffer_offset ] ),
+		     write_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy buffer to chunk data.",
+			 function );
+
+			return( -1 );
+		}
+		internal_handle->chunk_data->data_size = (size_t) ( chunk_data_offset + write_size );
+
+		buffer_offset += write_size;
+		buffer_size   -= write_size;
+
+		if( internal_handle->chunk_data->data_size == internal_handle->media_values->chunk_size )
+		{
+			write_chunk = 1;
+		}
+		else if( ( internal_handle->media_values->media_size != 0 )
+		      && ( ( (size64_t) internal_handle->current_offset + write_size ) == internal_handle->media_values->media_size ) )
+		{
+			write_chunk = 1;
+		}
+		else
+		{
+			write_chunk = 0;
+		}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( ( write_chunk != 0 )
+		 && ( internal_handle->compression_thread_pool != NULL ) )
+		{
+			/* Wait for the oldest outstanding job to be written if no job slot is available
+			 */
+			if( libewf_internal_handle_write_compression_jobs(
+			     internal_handle,
+			     file_io_pool,
+			     maximum_number_of_jobs - 1,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write compression jobs.",
+				 function );
+
+				return( -1 );
+			}
+			if( libewf_compression_job_initialize(
+			     &compression_job,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create compression job.",
+				 function );
+
+				return( -1 );
+			}
+			compression_job->chunk_index     = chunk_index;
+			compression_job->chunk_data      = internal_handle->chunk_data;
+			compression_job->input_data_size = internal_handle->chunk_data->data_size;
+
+			internal_handle->chunk_data = NULL;
+
+			jobs_index = internal_handle->compression_jobs_index + internal_handle->number_of_compression_jobs;
+
+			if( jobs_index >= maximum_number_of_jobs )
+			{
+				jobs_index -= maximum_number_of_jobs;
+			}
+			internal_handle->compression_jobs[ jobs_index ] = compression_job;
+
+			internal_handle->number_of_compression_jobs += 1;
+
+			if( libcthreads_thread_pool_push(
+			     internal_handle->compression_thread_pool,
+			     (intptr_t *) compression_job,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to push compression job onto thread pool.",
+				 function );
+
+				internal_handle->compression_jobs[ jobs_index ] = NULL;
+
+				internal_handle->number_of_compression_jobs -= 1;
+
+				libewf_compression_job_free(
+				 &compression_job,
+				 NULL );
+
+				return( -1 );
+			}
+			compression_job = NULL;
+		}
+		else
+#endif
+		if( write_chunk != 0 )
+		{
+			input_data_size = internal_handle->chunk_data->data_size;
+
+			if( libewf_chunk_data_pack(
+			     internal_handle->chunk_data,
+			     internal_handle->io_handle,
+			     internal_handle->write_io_handle->compressed_zero_byte_empty_block,
+			     internal_handle->write_io_handle->compressed_zero_byte_empty_block_size,
+			     internal_handle->write_io_handle->pack_flags,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to pack chunk: %" PRIu64 " data.",
+				 function,
+				 chunk_index );
+
+				return( -1 );
+			}
+			write_count = libewf_write_io_handle_write_new_chunk(
+			               internal_handle->write_io_handle,
+			               internal_handle->io_handle,
+			               file_io_pool,
+			               internal_handle->media_values,
+			               internal_handle->segment_table,
+			               internal_handle->header_values,
+			               internal_handle->hash_values,
+			               internal_handle->hash_sections,
+			               internal_handle->sessions,
+			               internal_handle->tracks,
+			               internal_handle->acquiry_errors,
+			               chunk_index,
+			               internal_handle->chunk_data,
+			               input_data_size,
+			               error );
+
+			if( write_count <= 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write new chunk.",
+				 function );
+
+				return( -1 );
+			}
+			if( libewf_chunk_data_free(
+			     &( internal_handle->chunk_data ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free chunk data.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		chunk_index      += 1;
+		chunk_data_offset = 0;
+
+		internal_handle->current_offset += (off64_t) write_size;
+
+		if( ( internal_handle->media_values->media_size != 0 )
+		 && ( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size ) )
+		{
+			break;
+		}
+		if( internal_handle->io_handle->abort != 0 )
+		{
+			break;
+		}
+	}
+	internal_handle->io_handle->abort = 0;
+
+	return( (ssize_t) buffer_offset );
+}
+
+/* Writes (media) data at the current offset
+ * the necessary settings of the write values must have been made
+ * Will initialize write if necessary
+ * Returns the number of bytes written, 0 when no longer data can be written or -1 on error
+ */
+ssize_t libewf_handle_write_buffer(
+         libewf_handle_t *handle,
+         const void *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_write_buffer";
+	ssize_t write_count                       = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_handle->write_io_handle->values_initialized == 0 )
+	{
+		if( libewf_write_io_handle_initialize_values(
+		     internal_handle->write_io_handle,
+		     internal_handle->io_handle,
+		     internal_handle->media_values,
+		     internal_handle->segment_table,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize write IO handle values.",
+			 function );
+
+			write_count = -1;
+		}
+	}
+	if( write_count != -1 )
+	{
+		write_count = libewf_internal_handle_write_buffer_to_file_io_pool(
+		               internal_handle,
+		               internal_handle->file_io_pool,
+		               buffer,
+		               buffer_size,
+		               error );
+
+		if( write_count == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to write buffer.",
+			 function );
+
+			write_count = -1;
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( write_count );
+}
+
+/* Writes (media) data at a specific offset,
+ * the necessary settings of the write values must have been made
+ * Will initialize write if necessary
+ * Returns the number of bytes written, 0 when no longer data can be written or -1 on error
+ */
+ssize_t libewf_handle_write_buffer_at_offset(
+         libewf_handle_t *handle,
+         const void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_write_buffer_at_offset";
+	ssize_t write_count                       = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_handle->write_io_handle->values_initialized == 0 )
+	{
+		if( libewf_write_io_handle_initialize_values(
+		     internal_handle->write_io_handle,
+		     internal_handle->io_handle,
+		     internal_handle->media_values,
+		     internal_handle->segment_table,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize write IO handle values.",
+			 function );
+
+			write_count = -1;
+		}
+	}
+	if( write_count != -1 )
+	{
+		if( libewf_internal_handle_seek_offset(
+		     internal_handle,
+		     offset,
+		     SEEK_SET,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_SEEK_FAILED,
+			 "%s: unable to seek offset.",
+			 function );
+
+			write_count = -1;
+		}
+	}
+	if( write_count != -1 )
+	{
+		write_count = libewf_internal_handle_write_buffer_to_file_io_pool(
+		               internal_handle,
+		               internal_handle->file_io_pool,
+		               buffer,
+		               buffer_size,
+		               error );
+
+		if( write_count == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to write buffer.",
+			 function );
+
+			write_count = -1;
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( write_count );
+}
+
+/* Retrieves a (media) data chunk
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_get_data_chunk(
+     libewf_handle_t *handle,
+     libewf_data_chunk_t **data_chunk,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_data_chunk";
+	int result                                = 1;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_chunk == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data chunk.",
+		 function );
+
+		return( -1 );
+	}
+	if( *data_chunk != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: data chunk value already set.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( ( internal_handle->write_io_handle != NULL )
+	 && ( internal_handle->write_io_handle->values_initialized == 0 ) )
+	{
+		if( libewf_write_io_handle_initialize_values(
+		     internal_handle->write_io_handle,
+		     internal_handle->io_handle,
+		     internal_handle->media_values,
+		     internal_handle->segment_table,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize write IO handle values.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( result != -1 )
+	{
+		if( libewf_data_chunk_initialize(
+		     data_chunk,
+		     internal_handle->io_handle,
+		     internal_handle->write_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create data chunk.",
+			 function );
+
+			result = -1;
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Reads a (media) data chunk at the current offset
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns the number of bytes in the data chunk, 0 when no longer data can be read or -1 on error
+ */
+ssize_t libewf_internal_handle_read_data_chunk_from_file_io_pool(
+         libewf_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         libewf_internal_data_chunk_t *internal_data_chunk,
+         libcerror_error_t **error )
+{
+	libewf_chunk_data_t *chunk_data = NULL;
+	static char *function           = "libewf_internal_handle_read_data_chunk_from_file_io_pool";
+	off64_t chunk_data_offset       = 0;
+	size_t read_count               = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->chunk_data != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - chunk data set.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->current_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size )
+	{
+		return( 0 );
+	}
+	if( libewf_chunk_table_get_chunk_data_by_offset_no_cache(
+	     internal_handle->chunk_table,
+	     internal_handle->io_handle,
+	     file_io_pool,
+	     internal_handle->media_values,
+	     internal_handle->segment_table,
+	     internal_handle->current_offset,
+	     &chunk_data_offset,
+	     &chunk_data,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk data for offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 internal_handle->current_offset,
+		 internal_handle->current_offset );
+
+		goto on_error;
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing chunk data for offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 internal_handle->current_offset,
+		 internal_handle->current_offset );
+
+		goto on_error;
+	}
+	/* data_chunk takes over management of chunk_data
+	 */
+	if( libewf_internal_data_chunk_set_chunk_data(
+	     internal_data_chunk,
+	     chunk_data,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set chunk: %" PRIu64 " data in data chunk.",
+		 function,
+		 chunk_data->chunk_index );
+
+		goto on_error;
+	}
+	internal_handle->current_offset = chunk_data->range_end_offset;
+
+	read_count = (ssize_t) ( chunk_data->range_end_offset - chunk_data->range_start_offset );
+
+	return( read_count );
+
+on_error:
+	if( chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 &chunk_data,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads a (media) data chunk at the current offset
+ * Returns the number of bytes read, 0 when no longer data can be read or -1 on error
+ * Returns the number of bytes in the data chunk, 0 when no longer data can be read or -1 on error
+ */
+ssize_t libewf_handle_read_data_chunk(
+         libewf_handle_t *handle,
+         libewf_data_chunk_t *data_chunk,
+         libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_read_data_chunk";
+	ssize_t read_count                        = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	read_count = libewf_internal_handle_read_data_chunk_from_file_io_pool(
+	              internal_handle,
+	              internal_handle->file_io_pool,
+	              (libewf_internal_data_chunk_t *) data_chunk,
+	              error );
+
+	if( read_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read data chunk.",
+		 function );
+
+		read_count = -1;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( read_count );
+}
+
+/* Writes a (media) data chunk at the current offset
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns the number of bytes written, 0 when no longer data can be written or -1 on error
+ */
+ssize_t libewf_internal_handle_write_data_chunk_to_file_io_pool(
+         libewf_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         libewf_internal_data_chunk_t *internal_data_chunk,
+         libcerror_error_t **error )
+{
+	static char *function        = "libewf_internal_handle_write_data_chunk_to_file_io_pool";
+	size_t data_size             = 0;
+	ssize_t write_count          = 0;
+	uint64_t current_chunk_index = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->chunk_data != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - chunk data set.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->current_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->write_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing subhandle write.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_data_chunk == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data chunk.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* The chunks written by write buffer precede the data chunk
+	 */
+	if( internal_handle->number_of_compression_jobs > 0 )
+	{
+		if( libewf_internal_handle_write_compression_jobs(
+		     internal_handle,
+		     file_io_pool,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write compression jobs.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#endif
+	if( ( internal_handle->media_values->media_size != 0 )
+	 && ( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size ) )
+	{
+		return( 0 );
+	}
+	data_size = internal_data_chunk->data_size;
+
+	if( internal_handle->media_values->media_size != 0 )
+	{
+		if( (size64_t) ( internal_handle->current_offset + data_size ) > internal_handle->media_values->media_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: last data chunk size value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+	}
+/* TODO remove need to calculate */
+	current_chunk_index = internal_handle->current_offset / internal_handle->media_values->chunk_size;
+
+	internal_handle->current_offset = (off64_t) current_chunk_index * (off64_t) internal_handle->media_values->chunk_size;
+
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: writing chunk: %" PRIu64 " of size: %" PRIzd ".\n",
+		 function,
+		 current_chunk_index,
+		 data_size );
+	}
+#endif
+	if( current_chunk_index < internal_handle->write_io_handle->number_of_chunks_written )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: chunk: %" PRIu64 " already exists.",
+		 function,
+		 current_chunk_index );
+
+		return( -1 );
+	}
+	write_count = libewf_write_io_handle_write_new_chunk(
+	               internal_handle->write_io_handle,
+	               internal_handle->io_handle,
+	               file_io_pool,
+	               internal_handle->media_values,
+	               internal_handle->segment_table,
+	               internal_handle->header_values,
+	               internal_handle->hash_values,
+	               internal_handle->hash_sections,
+	               internal_handle->sessions,
+	               internal_handle->tracks,
+	               internal_handle->acquiry_errors,
+	               current_chunk_index,
+	               internal_data_chunk->chunk_data,
+	               data_size,
+	               error );
+
+	if( write_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle->current_offset += (off64_t) data_size;
+
+	return( write_count );
+}
+
+/* Writes a (media) data chunk at the current offset
+ * Returns the number of bytes written, 0 when no longer data can be written or -1 on error
+ */
+ssize_t libewf_handle_write_data_chunk(
+         libewf_handle_t *handle,
+         libewf_data_chunk_t *data_chunk,
+         libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_write_data_chunk";
+	ssize_t write_count                       = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	write_count = libewf_internal_handle_write_data_chunk_to_file_io_pool(
+	               internal_handle,
+	               internal_handle->file_io_pool,
+	               (libewf_internal_data_chunk_t *) data_chunk,
+	               error );
+
+	if( write_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write data chunk.",
+		 function );
+
+		write_count = -1;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( write_count );
+}
+
+/* Finalizes the write by correcting the EWF the meta data in the segment files
+ * This function is required after write from stream
+ * Returns the number of bytes written or -1 on error
+ */
+ssize_t libewf_internal_handle_write_finalize_file_io_pool(
+         libewf_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         libcerror_error_t **error )
+{
+	libewf_segment_file_t *segment_file = NULL;
+	static char *function               = "libewf_internal_handle_write_finalize_file_io_pool";
+	size64_t segment_file_size          = 0;
+	size_t input_data_size              = 0;
+	ssize_t write_count                 = 0;
+	ssize_t write_finalize_count        = 0;
+	uint64_t chunk_index                = 0;
+	uint32_t number_of_segments         = 0;
+	int file_io_pool_entry              = -1;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->current_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
+	 && ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_RESUME ) == 0 ) )
+	{
+		if( internal_handle->chunk_data != NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+			 "%s: invalid handle - chunk data set.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( internal_handle->write_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing write IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->write_io_handle->write_finalized != 0 )
+	{
+		return( 0 );
+	}
+	if( ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
+	 && ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_RESUME ) == 0 ) )
+	{
+		return( 0 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( internal_handle->number_of_compression_jobs > 0 )
+	{
+		if( libewf_internal_handle_write_compression_jobs(
+		     internal_handle,
+		     file_io_pool,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write compression jobs.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#endif
+	if( internal_handle->chunk_data != NULL )
+	{
+		chunk_index = internal_handle->current_offset / internal_handle->media_values->chunk_size;
+
+		if( chunk_index < internal_handle->write_io_handle->number_of_chunks_written )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+			 "%s: chunk: %" PRIu64 " already exists.",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+		input_data_size = internal_handle->chunk_data->data_size;
+
+		if( libewf_chunk_data_pack(
+		     internal_handle->chunk_data,
+		     internal_handle->io_handle,
+		     internal_handle->write_io_handle->compressed_zero_byte_empty_block,
+		     internal_handle->write_io_handle->compressed_zero_byte_empty_block_size,
+		     internal_handle->write_io_handle->pack_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to pack chunk: %" PRIu64 " data.",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+		write_count = libewf_write_io_handle_write_new_chunk(
+			       internal_handle->write_io_handle,
+			       internal_handle->io_handle,
+			       file_io_pool,
+			       internal_handle->media_values,
+			       internal_handle->segment_table,
+			       internal_handle->header_values,
+			       internal_handle->hash_values,
+			       internal_handle->hash_sections,
+			       internal_handle->sessions,
+			       internal_handle->tracks,
+			       internal_handle->acquiry_errors,
+			       chunk_index,
+			       internal_handle->chunk_data,
+			       input_data_size,
+			       error );
+
+		if( write_count <= 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write new chunk.",
+			 function );
+
+			return( -1 );
+		}
+		write_finalize_count += write_count;
+
+		if( libewf_chunk_data_free(
+		     &( internal_handle->chunk_data ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunk data.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	/* Check if all media data has been written
+	 */
+	if( ( internal_handle->media_values->media_size != 0 )
+	 && ( internal_handle->write_io_handle->input_write_count < (ssize64_t) internal_handle->media_values->media_size ) )
+	{
+		return( write_finalize_count );
+	}
+	if( libewf_segment_table_get_number_of_segments(
+	     internal_handle->segment_table,
+	     &number_of_segments,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of segments.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_segments == 0 )
+	{
+		/* No segment file needs to be created
+		 */
+/* TODO clean up this logic: when is this triggered? */
+		if( internal_handle->media_values->media_size != 0 )
+		{
+			return( write_finalize_count );
+		}
+		/* Create the segment file if required
+		 */
+		if( libewf_write_io_handle_create_segment_file(
+		     internal_handle->io_handle,
+		     file_io_pool,
+		     internal_handle->segment_table,
+		     internal_handle->io_handle->segment_file_type,
+		     0,
+		     internal_handle->write_io_handle->maximum_number_of_segments,
+		     internal_handle->media_values->set_identifier,
+		     &file_io_pool_entry,
+		     &segment_file,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to create segment file: 0.",
+			 function );
+
+			return( -1 );
+		}
+		write_count = libewf_segment_file_write_start(
+		               segment_file,
+		               file_io_pool,
+		               file_io_pool_entry,
+		               &( internal_handle->write_io_handle->case_data ),
+		               &( internal_handle->write_io_handle->case_data_size ),
+		               &( internal_handle->write_io_handle->device_information ),
+		               &( internal_handle->write_io_handle->device_information_size ),
+		               &( internal_handle->write_io_handle->data_section ),
+		               internal_handle->media_values,
+		               internal_handle->header_values,
+		               internal_handle->write_io_handle->timestamp,
+		               error );
+
+		if( write_count == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write segment file: 0 start.",
+			 function );
+
+			return( -1 );
+		}
+		write_finalize_count += write_count;
+	}
+	/* Check if the last segment file is still open for writing
+	 */
+	else if( internal_handle->write_io_handle->current_segment_file != NULL )
+	{
+		if( libewf_segment_table_get_segment_by_index(
+		     internal_handle->segment_table,
+		     internal_handle->write_io_handle->current_segment_number,
+		     &file_io_pool_entry,
+		     &segment_file_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment: %" PRIu32 " from segment table.",
+			 function,
+			 internal_handle->write_io_handle->current_segment_number );
+
+			return( -1 );
+		}
+		/* Check if chunks section needs to be corrected
+		 */
+		if( internal_handle->write_io_handle->chunks_section_offset != 0 )
+		{
+			write_count = libewf_write_io_handle_write_chunks_section_end(
+			               internal_handle->write_io_handle,
+			               internal_handle->io_handle,
+				       file_io_pool,
+				       file_io_pool_entry,
+			               internal_handle->write_io_handle->current_segment_file,
+			               error );
+
+			if( write_count == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write chunks section end: %" PRIu32 ".",
+				 function,
+				 internal_handle->write_io_handle->current_segment_number );
+
+				return( -1 );
+			}
+			write_finalize_count += write_count;
+		}
+		/* Close the segment file
+		 */
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: closing last segment file: %" PRIu32 ".\n",
+			 function,
+			 internal_handle->write_io_handle->current_segment_number );
+		}
+#endif
+		write_count = libewf_segment_file_write_close(
+		               internal_handle->write_io_handle->current_segment_file,
+		               file_io_pool,
+		               file_io_pool_entry,
+		               internal_handle->write_io_handle->number_of_chunks_written_to_segment_file,
+		               1,
+		               internal_handle->hash_sections,
+		               internal_handle->hash_values,
+		               internal_handle->media_values,
+		               internal_handle->sessions,
+		               internal_handle->tracks,
+		               internal_handle->acquiry_errors,
+		               &( internal_handle->write_io_handle->data_section ),
+		               error );
+
+		if( write_count == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to close segment file: %" PRIu32 ".",
+			 function,
+			 internal_handle->write_io_handle->current_segment_number );
+
+			return( -1 );
+		}
+		write_finalize_count += write_count;
+
+		internal_handle->write_io_handle->current_segment_file = NULL;
+	}
+	/* Correct the media values if streamed write was used
+	 */
+	if( internal_handle->media_values->media_size == 0 )
+	{
+		/* Determine the media values
+		 */
+		internal_handle->media_values->number_of_chunks  = internal_handle->write_io_handle->number_of_chunks_written;
+		internal_handle->media_values->number_of_sectors = (uint64_t) ( internal_handle->write_io_handle->input_write_count / internal_handle->media_values->bytes_per_sector );
+		internal_handle->media_values->media_size        = (size64_t) internal_handle->write_io_handle->input_write_count;
+
+		/* Flush the section write caches
+		 */
+		if( internal_handle->write_io_handle->case_data != NULL )
+		{
+			memory_free(
+			 internal_handle->write_io_handle->case_data );
+
+			internal_handle->write_io_handle->case_data      = NULL;
+			internal_handle->write_io_handle->case_data_size = 0;
+		}
+		if( internal_handle->write_io_handle->device_information != NULL )
+		{
+			memory_free(
+			 internal_handle->write_io_handle->device_information );
+
+			internal_handle->write_io_handle->device_information      = NULL;
+			internal_handle->write_io_handle->device_information_size = 0;
+		}
+		if( internal_handle->write_io_handle->data_section != NULL )
+		{
+			memory_free(
+			 internal_handle->write_io_handle->data_section );
+
+			internal_handle->write_io_handle->data_section = NULL;
+		}
+		/* Correct the sections in the segment files
+		 */
+		if( libewf_write_io_handle_finalize_write_sections_corrections(
+		     internal_handle->write_io_handle,
+		     file_io_pool,
+		     internal_handle->media_values,
+		     internal_handle->segment_table,
+		     internal_handle->header_values,
+		     internal_handle->hash_values,
+		     internal_handle->hash_sections,
+		     internal_handle->sessions,
+		     internal_handle->tracks,
+		     internal_handle->acquiry_errors,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write sections corrections to segment files.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	internal_handle->write_io_handle->write_finalized = 1;
+
+	return( write_finalize_count );
+}
+
+/* Finalizes the write by correcting the EWF the meta data in the segment files
+ * This function is required after write from stream
+ * Returns the number of bytes written or -1 on error
+ */
+ssize_t libewf_handle_write_finalize(
+         libewf_handle_t *handle,
+         libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_write_finalize";
+	ssize_t write_count                       = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	write_count = libewf_internal_handle_write_finalize_file_io_pool(
+	               internal_handle,
+	               internal_handle->file_io_pool,
+	               error );
+
+	if( write_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to write finalize.",
+		 function );
+
+		write_count = -1;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( write_count );
+}
+
+/* Seeks a certain offset of the (media) data
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns the offset if seek is successful or -1 on error
+ */
+off64_t libewf_internal_handle_seek_offset(
+         libewf_internal_handle_t *internal_handle,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error )
+{
+	static char *function = "libewf_internal_handle_seek_offset";
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->chunk_data != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - chunk data set.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( whence != SEEK_CUR )
+	 && ( whence != SEEK_END )
+	 && ( whence != SEEK_SET ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported whence.",
+		 function );
+
+		return( -1 );
+	}
+	if( whence == SEEK_CUR )
+	{	
+		offset += internal_handle->current_offset;
 	}
-	if( chunk_data == NULL )
+	else if( whence == SEEK_END )
+	{	
+		offset += (off64_t) internal_handle->media_values->media_size;
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: seeking media data offset: %" PRIi64 ".\n",
+		 function,
+		 offset );
+	}
+#endif
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle->current_offset = offset;
+
+	return( offset );
+}
+
+/* Seeks a certain offset of the (media) data
+ * Returns the offset if seek is successful or -1 on error
+ */
+off64_t libewf_handle_seek_offset(
+         libewf_handle_t *handle,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_seek_offset";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->file_io_pool == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: missing chunk data for offset: %" PRIi64 " (0x%08" PRIx64 ").",
-		 function,
-		 internal_handle->current_offset,
-		 internal_handle->current_offset );
+		 "%s: invalid handle - missing file IO pool.",
+		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	/* data_chunk takes over management of chunk_data
-	 */
-	if( libewf_internal_data_chunk_set_chunk_data(
-	     internal_data_chunk,
-	     chunk_data,
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set chunk: %" PRIu64 " data in data chunk.",
-		 function,
-		 chunk_data->chunk_index );
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	internal_handle->current_offset = chunk_data->range_end_offset;
+#endif
+	offset = libewf_internal_handle_seek_offset(
+	          internal_handle,
+	          offset,
+	          whence,
+	          error );
 
-	read_count = (ssize_t) ( chunk_data->range_end_offset - chunk_data->range_start_offset );
+	if( offset == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset.",
+		 function );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
 
-	return( read_count );
+		return( -1 );
+	}
+#endif
+	return( offset );
+}
+
+/* Retrieves the current offset of the (media) data
+ * The write lock is grabbed since concurrent reads at a specific offset update the current offset
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_get_offset(
+     libewf_handle_t *handle,
+     off64_t *offset,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_offset";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid offset.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*offset = internal_handle->current_offset;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Sets the maximum number of (concurrent) open file handles
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_set_maximum_number_of_open_handles(
+     libewf_handle_t *handle,
+     int maximum_number_of_open_handles,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_set_maximum_number_of_open_handles";
+	int result                                = 1;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_handle->file_io_pool != NULL )
+	{
+		result = libbfio_pool_set_maximum_number_of_open_handles(
+		          internal_handle->file_io_pool,
+		          maximum_number_of_open_handles,
+		          error );
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set maximum number of open handles in file IO pool.",
+			 function );
+		}
+	}
+	if( result == 1 )
+	{
+		internal_handle->maximum_number_of_open_handles = maximum_number_of_open_handles;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
 
-on_error:
-	if( chunk_data != NULL )
-	{
-		libewf_chunk_data_free(
-		 &chunk_data,
-		 NULL );
+		return( -1 );
 	}
-	return( -1 );
+#endif
+	return( result );
 }
 
-/* Reads a (media) data chunk at the current offset
- * Returns the number of bytes read, 0 when no longer data can be read or -1 on error
- * Returns the number of bytes in the data chunk, 0 when no longer data can be read or -1 on error
+/* Sets the IO backend of the segment files
+ * The IO backend is used by the segment files opened or created after it is set,
+ * it is not copied and must remain valid while the handle is open
+ * A NULL IO backend resets the handle to the process-wide IO backend
+ * Returns 1 if successful or -1 on error
  */
-ssize_t libewf_handle_read_data_chunk(
-         libewf_handle_t *handle,
-         libewf_data_chunk_t *data_chunk,
-         libcerror_error_t **error )
+int libewf_handle_set_io_backend(
+     libewf_handle_t *handle,
+     const file_io_backend_t *io_backend,
+     libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_read_data_chunk";
-	ssize_t read_count                        = 0;
+	static char *function                     = "libewf_handle_set_io_backend";
+	int result                                = 1;
 
 	if( handle == NULL )
 	{
@@ -5614,13 +10145,14 @@ ssize_t libewf_handle_read_data_chunk(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->file_io_pool == NULL )
+	if( ( io_backend != NULL )
+	 && ( ( io_backend->file_read_submit == NULL ) != ( io_backend->file_read_complete == NULL ) ) )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing file IO pool.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO backend - file read submit and complete callbacks must be set together.",
 		 function );
 
 		return( -1 );
@@ -5640,22 +10172,20 @@ ssize_t libewf_handle_read_data_chunk(
 		return( -1 );
 	}
 #endif
-	read_count = libewf_internal_handle_read_data_chunk_from_file_io_pool(
-	              internal_handle,
-	              internal_handle->file_io_pool,
-	              (libewf_internal_data_chunk_t *) data_chunk,
-	              error );
-
-	if( read_count < 0 )
+	if( internal_handle->file_io_pool != NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read data chunk.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - file IO pool value already set.",
 		 function );
 
-		read_count = -1;
+		result = -1;
+	}
+	else
+	{
+		internal_handle->io_backend = io_backend;
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
@@ -5672,25 +10202,28 @@ ssize_t libewf_handle_read_data_chunk(
 		return( -1 );
 	}
 #endif
-	return( read_count );
+	return( result );
 }
 
-/* Writes a (media) data chunk at the current offset
- * This function is not multi-thread safe acquire write lock before call
- * Returns the number of bytes written, 0 when no longer data can be written or -1 on error
+/* Sets the filename of the index file
+ * The index file contains the sections and chunk groups of the segment files
+ * so they do not need to be scanned again when the segment files are reopened.
+ * The index file is read when the segment files are opened for reading and
+ * (re)written if it was missing or does not match the segment files.
+ * Returns 1 if successful or -1 on error
  */
-ssize_t libewf_internal_handle_write_data_chunk_to_file_io_pool(
-         libewf_internal_handle_t *internal_handle,
-         libbfio_pool_t *file_io_pool,
-         libewf_internal_data_chunk_t *internal_data_chunk,
-         libcerror_error_t **error )
+int libewf_handle_set_index_filename(
+     libewf_handle_t *handle,
+     const char *filename,
+     size_t filename_length,
+     libcerror_error_t **error )
 {
-	static char *function        = "libewf_internal_handle_write_data_chunk_to_file_io_pool";
-	size_t data_size             = 0;
-	ssize_t write_count          = 0;
-	uint64_t current_chunk_index = 0;
+	libbfio_handle_t *file_io_handle          = NULL;
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_set_index_filename";
+	int result                                = 1;
 
-	if( internal_handle == NULL )
+	if( handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -5701,199 +10234,198 @@ ssize_t libewf_internal_handle_write_data_chunk_to_file_io_pool(
 
 		return( -1 );
 	}
-	if( internal_handle->io_handle == NULL )
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( filename == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing IO handle.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->chunk_data != NULL )
+	if( ( filename_length == 0 )
+	 || ( filename_length > (size_t) SSIZE_MAX ) )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - chunk data set.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid filename length value out of bounds.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->current_offset < 0 )
+	if( libbfio_file_initialize(
+	     &file_io_handle,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( internal_handle->media_values == NULL )
+	if( libbfio_file_set_name(
+	     file_io_handle,
+	     filename,
+	     filename_length,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing media values.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set filename in file IO handle.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( internal_handle->media_values->chunk_size == 0 )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( internal_handle->write_io_handle == NULL )
+#endif
+	result = libewf_internal_handle_set_index_file_io_handle(
+	          internal_handle,
+	          &file_io_handle,
+	          error );
+
+	if( result != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing subhandle write.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set index file IO handle.",
 		 function );
-
-		return( -1 );
 	}
-	if( internal_data_chunk == NULL )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid data chunk.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( ( internal_handle->media_values->media_size != 0 )
-	 && ( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size ) )
+#endif
+	if( result != 1 )
 	{
-		return( 0 );
+		goto on_error;
 	}
-	data_size = internal_data_chunk->data_size;
+	return( 1 );
 
-	if( internal_handle->media_values->media_size != 0 )
+on_error:
+	if( file_io_handle != NULL )
 	{
-		if( (size64_t) ( internal_handle->current_offset + data_size ) > internal_handle->media_values->media_size )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-			 "%s: last data chunk size value out of bounds.",
-			 function );
-
-			return( -1 );
-		}
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
 	}
-/* TODO remove need to calculate */
-	current_chunk_index = internal_handle->current_offset / internal_handle->media_values->chunk_size;
+	return( -1 );
+}
 
-	internal_handle->current_offset = (off64_t) current_chunk_index * (off64_t) internal_handle->media_values->chunk_size;
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
 
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
-	{
-		libcnotify_printf(
-		 "%s: writing chunk: %" PRIu64 " of size: %" PRIzd ".\n",
-		 function,
-		 current_chunk_index,
-		 data_size );
-	}
-#endif
-	if( current_chunk_index < internal_handle->write_io_handle->number_of_chunks_written )
+/* Sets the filename of the index file
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_set_index_filename_wide(
+     libewf_handle_t *handle,
+     const wchar_t *filename,
+     size_t filename_length,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle          = NULL;
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_set_index_filename_wide";
+	int result                                = 1;
+
+	if( handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: chunk: %" PRIu64 " already exists.",
-		 function,
-		 current_chunk_index );
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
 
 		return( -1 );
 	}
-	write_count = libewf_write_io_handle_write_new_chunk(
-	               internal_handle->write_io_handle,
-	               internal_handle->io_handle,
-	               file_io_pool,
-	               internal_handle->media_values,
-	               internal_handle->segment_table,
-	               internal_handle->header_values,
-	               internal_handle->hash_values,
-	               internal_handle->hash_sections,
-	               internal_handle->sessions,
-	               internal_handle->tracks,
-	               internal_handle->acquiry_errors,
-	               current_chunk_index,
-	               internal_data_chunk->chunk_data,
-	               data_size,
-	               error );
+	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( write_count < 0 )
+	if( filename == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_WRITE_FAILED,
-		 "%s: unable to write chunk data.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
 		 function );
 
 		return( -1 );
 	}
-	internal_handle->current_offset += (off64_t) data_size;
-
-	return( write_count );
-}
-
-/* Writes a (media) data chunk at the current offset
- * Returns the number of bytes written, 0 when no longer data can be written or -1 on error
- */
-ssize_t libewf_handle_write_data_chunk(
-         libewf_handle_t *handle,
-         libewf_data_chunk_t *data_chunk,
-         libcerror_error_t **error )
-{
-	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_write_data_chunk";
-	ssize_t write_count                       = 0;
-
-	if( handle == NULL )
+	if( ( filename_length == 0 )
+	 || ( filename_length > (size_t) SSIZE_MAX ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid handle.",
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid filename length value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_file_initialize(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	internal_handle = (libewf_internal_handle_t *) handle;
-
-	if( internal_handle->file_io_pool == NULL )
+	if( libbfio_file_set_name_wide(
+	     file_io_handle,
+	     filename,
+	     filename_length,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing file IO pool.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set filename in file IO handle.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_grab_for_write(
@@ -5907,25 +10439,22 @@ ssize_t libewf_handle_write_data_chunk(
 		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
 #endif
-	write_count = libewf_internal_handle_write_data_chunk_to_file_io_pool(
-	               internal_handle,
-	               internal_handle->file_io_pool,
-	               (libewf_internal_data_chunk_t *) data_chunk,
-	               error );
+	result = libewf_internal_handle_set_index_file_io_handle(
+	          internal_handle,
+	          &file_io_handle,
+	          error );
 
-	if( write_count < 0 )
+	if( result != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_WRITE_FAILED,
-		 "%s: unable to write data chunk.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set index file IO handle.",
 		 function );
-
-		write_count = -1;
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
@@ -5939,30 +10468,38 @@ ssize_t libewf_handle_write_data_chunk(
 		 "%s: unable to release read/write lock for writing.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
 #endif
-	return( write_count );
+	if( result != 1 )
+	{
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( -1 );
 }
 
-/* Finalizes the write by correcting the EWF the meta data in the segment files
- * This function is required after write from stream
- * Returns the number of bytes written or -1 on error
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+/* Sets the index file IO handle
+ * The handle takes over the ownership of the file IO handle
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful or -1 on error
  */
-ssize_t libewf_internal_handle_write_finalize_file_io_pool(
-         libewf_internal_handle_t *internal_handle,
-         libbfio_pool_t *file_io_pool,
-         libcerror_error_t **error )
+int libewf_internal_handle_set_index_file_io_handle(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_handle_t **file_io_handle,
+     libcerror_error_t **error )
 {
-	libewf_segment_file_t *segment_file = NULL;
-	static char *function               = "libewf_internal_handle_write_finalize_file_io_pool";
-	size64_t segment_file_size          = 0;
-	size_t input_data_size              = 0;
-	ssize_t write_count                 = 0;
-	ssize_t write_finalize_count        = 0;
-	uint64_t chunk_index                = 0;
-	uint32_t number_of_segments         = 0;
-	int file_io_pool_entry              = -1;
+	static char *function = "libewf_internal_handle_set_index_file_io_handle";
 
 	if( internal_handle == NULL )
 	{
@@ -5975,410 +10512,444 @@ ssize_t libewf_internal_handle_write_finalize_file_io_pool(
 
 		return( -1 );
 	}
-	if( internal_handle->io_handle == NULL )
+	if( file_io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing IO handle.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->current_offset < 0 )
+	if( internal_handle->file_io_pool != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - file IO pool value already set.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
-	 && ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_RESUME ) == 0 ) )
+	if( internal_handle->index_file_io_handle != NULL )
 	{
-		if( internal_handle->chunk_data != NULL )
+		if( libbfio_handle_free(
+		     &( internal_handle->index_file_io_handle ),
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-			 "%s: invalid handle - chunk data set.",
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free index file IO handle.",
 			 function );
 
 			return( -1 );
 		}
 	}
-	if( internal_handle->write_io_handle == NULL )
+	internal_handle->index_file_io_handle = *file_io_handle;
+
+	*file_io_handle = NULL;
+
+	return( 1 );
+}
+
+/* Sets the number of decompression threads
+ * Reads that span multiple chunks are unpacked concurrently by the decompression threads
+ * A value of 0 disables the decompression threads
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_set_number_of_decompression_threads(
+     libewf_handle_t *handle,
+     int number_of_threads,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_set_number_of_decompression_threads";
+	int result                                = 1;
+
+	if( handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing write IO handle.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->media_values == NULL )
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( ( number_of_threads < 0 )
+	 || ( number_of_threads > LIBEWF_MAXIMUM_NUMBER_OF_DECOMPRESSION_THREADS ) )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing media values.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->media_values->chunk_size == 0 )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->write_io_handle->write_finalized != 0 )
-	{
-		return( 0 );
-	}
-	if( ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
-	 && ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_RESUME ) == 0 ) )
-	{
-		return( 0 );
-	}
-	if( internal_handle->chunk_data != NULL )
+	if( internal_handle->decompression_thread_pool != NULL )
 	{
-		chunk_index = internal_handle->current_offset / internal_handle->media_values->chunk_size;
-
-		if( chunk_index < internal_handle->write_io_handle->number_of_chunks_written )
+		if( libcthreads_thread_pool_join(
+		     &( internal_handle->decompression_thread_pool ),
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-			 "%s: chunk: %" PRIu64 " already exists.",
-			 function,
-			 chunk_index );
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join decompression thread pool.",
+			 function );
 
-			return( -1 );
+			result = -1;
 		}
-		input_data_size = internal_handle->chunk_data->data_size;
-
-		if( libewf_chunk_data_pack(
-		     internal_handle->chunk_data,
-		     internal_handle->io_handle,
-		     internal_handle->write_io_handle->compressed_zero_byte_empty_block,
-		     internal_handle->write_io_handle->compressed_zero_byte_empty_block_size,
-		     internal_handle->write_io_handle->pack_flags,
+	}
+	if( internal_handle->decompression_jobs_queue != NULL )
+	{
+		if( libcthreads_queue_free(
+		     &( internal_handle->decompression_jobs_queue ),
+		     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_decompression_job_free,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GENERIC,
-			 "%s: unable to pack chunk: %" PRIu64 " data.",
-			 function,
-			 chunk_index );
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free decompression jobs queue.",
+			 function );
 
-			return( -1 );
+			result = -1;
 		}
-		write_count = libewf_write_io_handle_write_new_chunk(
-			       internal_handle->write_io_handle,
-			       internal_handle->io_handle,
-			       file_io_pool,
-			       internal_handle->media_values,
-			       internal_handle->segment_table,
-			       internal_handle->header_values,
-			       internal_handle->hash_values,
-			       internal_handle->hash_sections,
-			       internal_handle->sessions,
-			       internal_handle->tracks,
-			       internal_handle->acquiry_errors,
-			       chunk_index,
-			       internal_handle->chunk_data,
-			       input_data_size,
-			       error );
+	}
+	internal_handle->number_of_decompression_threads = 0;
 
-		if( write_count <= 0 )
+	if( ( result == 1 )
+	 && ( number_of_threads > 0 ) )
+	{
+		/* The queue holds the finished jobs, since the number of outstanding jobs
+		 * is limited by the reader the push onto the queue never blocks
+		 */
+		if( libcthreads_queue_initialize(
+		     &( internal_handle->decompression_jobs_queue ),
+		     number_of_threads * LIBEWF_DECOMPRESSION_JOBS_PER_THREAD,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_WRITE_FAILED,
-			 "%s: unable to write new chunk.",
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create decompression jobs queue.",
 			 function );
 
-			return( -1 );
+			result = -1;
 		}
-		write_finalize_count += write_count;
-
-		if( libewf_chunk_data_free(
-		     &( internal_handle->chunk_data ),
-		     error ) != 1 )
+		else if( libcthreads_thread_pool_create(
+		          &( internal_handle->decompression_thread_pool ),
+		          NULL,
+		          number_of_threads,
+		          number_of_threads * LIBEWF_DECOMPRESSION_JOBS_PER_THREAD,
+		          (int (*)(intptr_t *, void *)) &libewf_internal_handle_decompression_thread_pool_callback,
+		          (void *) internal_handle,
+		          error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free chunk data.",
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create decompression thread pool.",
 			 function );
 
-			return( -1 );
+			libcthreads_queue_free(
+			 &( internal_handle->decompression_jobs_queue ),
+			 NULL,
+			 NULL );
+
+			result = -1;
 		}
+		else
+		{
+			internal_handle->number_of_decompression_threads = number_of_threads;
+		}
+	}
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#else
+	if( number_of_threads != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: multi-threading not supported.",
+		 function );
+
+		result = -1;
+	}
+#endif
+	return( result );
+}
+
+/* Sets the number of compression threads
+ * Chunks written by write buffer are packed concurrently by the compression threads
+ * and written in order, hence errors of packing or writing a chunk can be returned
+ * by a subsequent write buffer or write finalize
+ * Adaptive compression is not supported with compression threads, since its decisions
+ * depend on the order in which the chunks are packed, the entropy test is supported
+ * A value of 0 disables the compression threads
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_set_number_of_compression_threads(
+     libewf_handle_t *handle,
+     int number_of_threads,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_set_number_of_compression_threads";
+	int result                                = 1;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
 	}
-	/* Check if all media data has been written
-	 */
-	if( ( internal_handle->media_values->media_size != 0 )
-	 && ( internal_handle->write_io_handle->input_write_count < (ssize64_t) internal_handle->media_values->media_size ) )
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( ( number_of_threads < 0 )
+	 || ( number_of_threads > LIBEWF_MAXIMUM_NUMBER_OF_COMPRESSION_THREADS ) )
 	{
-		return( write_finalize_count );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
 	}
-	if( libewf_segment_table_get_number_of_segments(
-	     internal_handle->segment_table,
-	     &number_of_segments,
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of segments.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
-	if( number_of_segments == 0 )
+	/* The adaptive compression decisions depend on the order in which the chunks are packed
+	 */
+	if( ( number_of_threads > 0 )
+	 && ( internal_handle->io_handle != NULL )
+	 && ( ( internal_handle->io_handle->compression_flags & LIBEWF_COMPRESS_FLAG_USE_ADAPTIVE_COMPRESSION ) != 0 ) )
 	{
-		/* No segment file needs to be created
-		 */
-/* TODO clean up this logic: when is this triggered? */
-		if( internal_handle->media_values->media_size != 0 )
-		{
-			return( write_finalize_count );
-		}
-		/* Create the segment file if required
-		 */
-		if( libewf_write_io_handle_create_segment_file(
-		     internal_handle->io_handle,
-		     file_io_pool,
-		     internal_handle->segment_table,
-		     internal_handle->io_handle->segment_file_type,
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: compression threads are not supported with adaptive compression.",
+		 function );
+
+		libcthreads_read_write_lock_release_for_write(
+		 internal_handle->read_write_lock,
+		 NULL );
+
+		return( -1 );
+	}
+	/* The outstanding jobs are written before the thread pool is replaced
+	 */
+	if( internal_handle->number_of_compression_jobs > 0 )
+	{
+		if( libewf_internal_handle_write_compression_jobs(
+		     internal_handle,
+		     internal_handle->file_io_pool,
 		     0,
-		     internal_handle->write_io_handle->maximum_number_of_segments,
-		     internal_handle->media_values->set_identifier,
-		     &file_io_pool_entry,
-		     &segment_file,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_OPEN_FAILED,
-			 "%s: unable to create segment file: 0.",
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write compression jobs.",
 			 function );
 
-			return( -1 );
+			result = -1;
 		}
-		write_count = libewf_segment_file_write_start(
-		               segment_file,
-		               file_io_pool,
-		               file_io_pool_entry,
-		               &( internal_handle->write_io_handle->case_data ),
-		               &( internal_handle->write_io_handle->case_data_size ),
-		               &( internal_handle->write_io_handle->device_information ),
-		               &( internal_handle->write_io_handle->device_information_size ),
-		               &( internal_handle->write_io_handle->data_section ),
-		               internal_handle->media_values,
-		               internal_handle->header_values,
-		               internal_handle->write_io_handle->timestamp,
-		               error );
-
-		if( write_count == -1 )
+		if( internal_handle->number_of_compression_jobs > 0 )
+		{
+			libewf_internal_handle_free_compression_jobs(
+			 internal_handle,
+			 NULL );
+		}
+	}
+	if( internal_handle->compression_thread_pool != NULL )
+	{
+		if( libcthreads_thread_pool_join(
+		     &( internal_handle->compression_thread_pool ),
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_WRITE_FAILED,
-			 "%s: unable to write segment file: 0 start.",
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join compression thread pool.",
 			 function );
 
-			return( -1 );
+			result = -1;
 		}
-		write_finalize_count += write_count;
 	}
-	/* Check if the last segment file is still open for writing
-	 */
-	else if( internal_handle->write_io_handle->current_segment_file != NULL )
+	if( internal_handle->compression_jobs_queue != NULL )
 	{
-		if( libewf_segment_table_get_segment_by_index(
-		     internal_handle->segment_table,
-		     internal_handle->write_io_handle->current_segment_number,
-		     &file_io_pool_entry,
-		     &segment_file_size,
+		if( libcthreads_queue_free(
+		     &( internal_handle->compression_jobs_queue ),
+		     NULL,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve segment: %" PRIu32 " from segment table.",
-			 function,
-			 internal_handle->write_io_handle->current_segment_number );
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free compression jobs queue.",
+			 function );
 
-			return( -1 );
+			result = -1;
 		}
-		/* Check if chunks section needs to be corrected
-		 */
-		if( internal_handle->write_io_handle->chunks_section_offset != 0 )
-		{
-			write_count = libewf_write_io_handle_write_chunks_section_end(
-			               internal_handle->write_io_handle,
-			               internal_handle->io_handle,
-				       file_io_pool,
-				       file_io_pool_entry,
-			               internal_handle->write_io_handle->current_segment_file,
-			               error );
-
-			if( write_count == -1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_IO,
-				 LIBCERROR_IO_ERROR_WRITE_FAILED,
-				 "%s: unable to write chunks section end: %" PRIu32 ".",
-				 function,
-				 internal_handle->write_io_handle->current_segment_number );
+	}
+	internal_handle->number_of_compression_threads = 0;
+	internal_handle->compression_jobs_index        = 0;
 
-				return( -1 );
-			}
-			write_finalize_count += write_count;
-		}
-		/* Close the segment file
+	if( ( result == 1 )
+	 && ( number_of_threads > 0 ) )
+	{
+		/* The queue holds the finished jobs, since the number of outstanding jobs
+		 * is limited by the writer the push onto the queue never blocks
 		 */
-#if defined( HAVE_DEBUG_OUTPUT )
-		if( libcnotify_verbose != 0 )
-		{
-			libcnotify_printf(
-			 "%s: closing last segment file: %" PRIu32 ".\n",
-			 function,
-			 internal_handle->write_io_handle->current_segment_number );
-		}
-#endif
-		write_count = libewf_segment_file_write_close(
-		               internal_handle->write_io_handle->current_segment_file,
-		               file_io_pool,
-		               file_io_pool_entry,
-		               internal_handle->write_io_handle->number_of_chunks_written_to_segment_file,
-		               1,
-		               internal_handle->hash_sections,
-		               internal_handle->hash_values,
-		               internal_handle->media_values,
-		               internal_handle->sessions,
-		               internal_handle->tracks,
-		               internal_handle->acquiry_errors,
-		               &( internal_handle->write_io_handle->data_section ),
-		               error );
-
-		if( write_count == -1 )
+		if( libcthreads_queue_initialize(
+		     &( internal_handle->compression_jobs_queue ),
+		     number_of_threads * LIBEWF_COMPRESSION_JOBS_PER_THREAD,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_WRITE_FAILED,
-			 "%s: unable to close segment file: %" PRIu32 ".",
-			 function,
-			 internal_handle->write_io_handle->current_segment_number );
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create compression jobs queue.",
+			 function );
 
-			return( -1 );
+			result = -1;
 		}
-		write_finalize_count += write_count;
-
-		internal_handle->write_io_handle->current_segment_file = NULL;
-	}
-	/* Correct the media values if streamed write was used
-	 */
-	if( internal_handle->media_values->media_size == 0 )
-	{
-		/* Determine the media values
-		 */
-		internal_handle->media_values->number_of_chunks  = internal_handle->write_io_handle->number_of_chunks_written;
-		internal_handle->media_values->number_of_sectors = (uint64_t) ( internal_handle->write_io_handle->input_write_count / internal_handle->media_values->bytes_per_sector );
-		internal_handle->media_values->media_size        = (size64_t) internal_handle->write_io_handle->input_write_count;
-
-		/* Flush the section write caches
-		 */
-		if( internal_handle->write_io_handle->case_data != NULL )
+		else if( libcthreads_thread_pool_create(
+		          &( internal_handle->compression_thread_pool ),
+		          NULL,
+		          number_of_threads,
+		          number_of_threads * LIBEWF_COMPRESSION_JOBS_PER_THREAD,
+		          (int (*)(intptr_t *, void *)) &libewf_internal_handle_compression_thread_pool_callback,
+		          (void *) internal_handle,
+		          error ) != 1 )
 		{
-			memory_free(
-			 internal_handle->write_io_handle->case_data );
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create compression thread pool.",
+			 function );
 
-			internal_handle->write_io_handle->case_data      = NULL;
-			internal_handle->write_io_handle->case_data_size = 0;
-		}
-		if( internal_handle->write_io_handle->device_information != NULL )
-		{
-			memory_free(
-			 internal_handle->write_io_handle->device_information );
+			libcthreads_queue_free(
+			 &( internal_handle->compression_jobs_queue ),
+			 NULL,
+			 NULL );
 
-			internal_handle->write_io_handle->device_information      = NULL;
-			internal_handle->write_io_handle->device_information_size = 0;
+			result = -1;
 		}
-		if( internal_handle->write_io_handle->data_section != NULL )
+		else
 		{
-			memory_free(
-			 internal_handle->write_io_handle->data_section );
-
-			internal_handle->write_io_handle->data_section = NULL;
+			internal_handle->number_of_compression_threads = number_of_threads;
 		}
-		/* Correct the sections in the segment files
-		 */
-		if( libewf_write_io_handle_finalize_write_sections_corrections(
-		     internal_handle->write_io_handle,
-		     file_io_pool,
-		     internal_handle->media_values,
-		     internal_handle->segment_table,
-		     internal_handle->header_values,
-		     internal_handle->hash_values,
-		     internal_handle->hash_sections,
-		     internal_handle->sessions,
-		     internal_handle->tracks,
-		     internal_handle->acquiry_errors,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_WRITE_FAILED,
-			 "%s: unable to write sections corrections to segment files.",
-			 function );
+	}
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#else
+	if( number_of_threads != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: multi-threading not supported.",
+		 function );
 
-			return( -1 );
-		}
+		result = -1;
 	}
-	internal_handle->write_io_handle->write_finalized = 1;
-
-	return( write_finalize_count );
+#endif
+	return( result );
 }
 
-/* Finalizes the write by correcting the EWF the meta data in the segment files
- * This function is required after write from stream
- * Returns the number of bytes written or -1 on error
+/* Sets the number of open threads
+ * The segment files are read concurrently by the open threads when the handle is opened
+ * A value of 0 disables the open threads
+ * Returns 1 if successful or -1 on error
  */
-ssize_t libewf_handle_write_finalize(
-         libewf_handle_t *handle,
-         libcerror_error_t **error )
+int libewf_handle_set_number_of_open_threads(
+     libewf_handle_t *handle,
+     int number_of_threads,
+     libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_write_finalize";
-	ssize_t write_count                       = 0;
+	static char *function                     = "libewf_handle_set_number_of_open_threads";
+	int result                                = 1;
 
 	if( handle == NULL )
 	{
@@ -6393,13 +10964,14 @@ ssize_t libewf_handle_write_finalize(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->file_io_pool == NULL )
+	if( ( number_of_threads < 0 )
+	 || ( number_of_threads > LIBEWF_MAXIMUM_NUMBER_OF_OPEN_THREADS ) )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing file IO pool.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
 		 function );
 
 		return( -1 );
@@ -6418,24 +10990,8 @@ ssize_t libewf_handle_write_finalize(
 
 		return( -1 );
 	}
-#endif
-	write_count = libewf_internal_handle_write_finalize_file_io_pool(
-	               internal_handle,
-	               internal_handle->file_io_pool,
-	               error );
-
-	if( write_count == -1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to write finalize.",
-		 function );
+	internal_handle->number_of_open_threads = number_of_threads;
 
-		write_count = -1;
-	}
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
@@ -6449,23 +11005,38 @@ ssize_t libewf_handle_write_finalize(
 
 		return( -1 );
 	}
+#else
+	if( number_of_threads != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: multi-threading not supported.",
+		 function );
+
+		result = -1;
+	}
 #endif
-	return( write_count );
+	return( result );
 }
 
-/* Seeks a certain offset of the (media) data
- * This function is not multi-thread safe acquire write lock before call
- * Returns the offset if seek is successful or -1 on error
+/* Sets the prefetch depth
+ * When a sequential access pattern is detected, up to prefetch depth chunks
+ * following the read are read and unpacked into the chunk cache by a background thread
+ * A value of 0 disables prefetching
+ * Returns 1 if successful or -1 on error
  */
-off64_t libewf_internal_handle_seek_offset(
-         libewf_internal_handle_t *internal_handle,
-         off64_t offset,
-         int whence,
-         libcerror_error_t **error )
+int libewf_handle_set_prefetch_depth(
+     libewf_handle_t *handle,
+     int prefetch_depth,
+     libcerror_error_t **error )
 {
-	static char *function = "libewf_internal_handle_seek_offset";
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_set_prefetch_depth";
+	int result                                = 1;
 
-	if( internal_handle == NULL )
+	if( handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -6476,96 +11047,127 @@ off64_t libewf_internal_handle_seek_offset(
 
 		return( -1 );
 	}
-	if( internal_handle->chunk_data != NULL )
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( ( prefetch_depth < 0 )
+	 || ( prefetch_depth > LIBEWF_MAXIMUM_PREFETCH_DEPTH ) )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - chunk data set.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid prefetch depth value out of bounds.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->media_values == NULL )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing media values.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->media_values->chunk_size == 0 )
+	/* Joining the thread pool runs the outstanding prefetch jobs to completion
+	 */
+	if( internal_handle->prefetch_thread_pool != NULL )
+	{
+		if( libcthreads_thread_pool_join(
+		     &( internal_handle->prefetch_thread_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join prefetch thread pool.",
+			 function );
+
+			result = -1;
+		}
+	}
+	internal_handle->prefetch_depth             = 0;
+	internal_handle->number_of_prefetch_jobs    = 0;
+	internal_handle->number_of_sequential_reads = 0;
+	internal_handle->next_prefetch_chunk_index  = 0;
+
+	if( ( result == 1 )
+	 && ( prefetch_depth > 0 ) )
+	{
+		/* The number of outstanding jobs is limited to the prefetch depth
+		 * hence the push onto the thread pool never blocks
+		 */
+		if( libcthreads_thread_pool_create(
+		     &( internal_handle->prefetch_thread_pool ),
+		     NULL,
+		     1,
+		     prefetch_depth,
+		     (int (*)(intptr_t *, void *)) &libewf_internal_handle_prefetch_thread_pool_callback,
+		     (void *) internal_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create prefetch thread pool.",
+			 function );
+
+			result = -1;
+		}
+		else
+		{
+			internal_handle->prefetch_depth = prefetch_depth;
+		}
+	}
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( whence != SEEK_CUR )
-	 && ( whence != SEEK_END )
-	 && ( whence != SEEK_SET ) )
+#else
+	if( prefetch_depth != 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-		 "%s: unsupported whence.",
+		 "%s: multi-threading not supported.",
 		 function );
 
-		return( -1 );
-	}
-	if( whence == SEEK_CUR )
-	{	
-		offset += internal_handle->current_offset;
-	}
-	else if( whence == SEEK_END )
-	{	
-		offset += (off64_t) internal_handle->media_values->media_size;
-	}
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
-	{
-		libcnotify_printf(
-		 "%s: seeking media data offset: %" PRIi64 ".\n",
-		 function,
-		 offset );
+		result = -1;
 	}
 #endif
-	if( offset < 0 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid offset value out of bounds.",
-		 function );
-
-		return( -1 );
-	}
-	internal_handle->current_offset = offset;
-
-	return( offset );
+	return( result );
 }
 
-/* Seeks a certain offset of the (media) data
- * Returns the offset if seek is successful or -1 on error
+/* Retrieves the number of prefetched chunks that were read and that were evicted without being read
+ * Returns 1 if successful or -1 on error
  */
-off64_t libewf_handle_seek_offset(
-         libewf_handle_t *handle,
-         off64_t offset,
-         int whence,
-         libcerror_error_t **error )
+int libewf_handle_get_prefetch_statistics(
+     libewf_handle_t *handle,
+     uint64_t *number_of_hits,
+     uint64_t *number_of_wasted,
+     libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_seek_offset";
+	static char *function                     = "libewf_handle_get_prefetch_statistics";
+	int result                                = 1;
 
 	if( handle == NULL )
 	{
@@ -6580,19 +11182,30 @@ off64_t libewf_handle_seek_offset(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->file_io_pool == NULL )
+	if( number_of_hits == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing file IO pool.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of hits.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_wasted == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of wasted.",
 		 function );
 
 		return( -1 );
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
+	if( libcthreads_read_write_lock_grab_for_read(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -6600,29 +11213,37 @@ off64_t libewf_handle_seek_offset(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 "%s: unable to grab read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	offset = libewf_internal_handle_seek_offset(
-	          internal_handle,
-	          offset,
-	          whence,
-	          error );
-
-	if( offset == -1 )
+	if( internal_handle->chunk_table == NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek offset.",
-		 function );
+		*number_of_hits   = 0;
+		*number_of_wasted = 0;
+	}
+	else
+	{
+		result = libewf_chunk_cache_get_prefetch_statistics(
+		          internal_handle->chunk_table->chunk_cache,
+		          number_of_hits,
+		          number_of_wasted,
+		          error );
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve prefetch statistics from chunk cache.",
+			 function );
+		}
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
+	if( libcthreads_read_write_lock_release_for_read(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -6630,25 +11251,27 @@ off64_t libewf_handle_seek_offset(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 "%s: unable to release read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	return( offset );
+	return( result );
 }
 
-/* Retrieves the current offset of the (media) data
+/* Sets the maximum size of the chunk cache
+ * The cache holds unpacked chunk data, a value of 0 disables caching
  * Returns 1 if successful or -1 on error
  */
-int libewf_handle_get_offset(
+int libewf_handle_set_maximum_cache_size(
      libewf_handle_t *handle,
-     off64_t *offset,
+     size64_t maximum_cache_size,
      libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_get_offset";
+	static char *function                     = "libewf_handle_set_maximum_cache_size";
+	int result                                = 1;
 
 	if( handle == NULL )
 	{
@@ -6663,19 +11286,19 @@ int libewf_handle_get_offset(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( offset == NULL )
+	if( maximum_cache_size > (size64_t) INT64_MAX )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid offset.",
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid maximum cache size value exceeds maximum.",
 		 function );
 
 		return( -1 );
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
+	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -6683,16 +11306,35 @@ int libewf_handle_get_offset(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	*offset = internal_handle->current_offset;
-
+#endif
+	if( internal_handle->chunk_table != NULL )
+	{
+		result = libewf_chunk_cache_set_maximum_size(
+		          internal_handle->chunk_table->chunk_cache,
+		          maximum_cache_size,
+		          error );
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set maximum size of chunk cache.",
+			 function );
+		}
+	}
+	if( result == 1 )
+	{
+		internal_handle->maximum_cache_size = maximum_cache_size;
+	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
+	if( libcthreads_read_write_lock_release_for_write(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -6700,25 +11342,26 @@ int libewf_handle_get_offset(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	return( 1 );
+	return( result );
 }
 
-/* Sets the maximum number of (concurrent) open file handles
+/* Retrieves the number of chunk cache hits and misses
  * Returns 1 if successful or -1 on error
  */
-int libewf_handle_set_maximum_number_of_open_handles(
+int libewf_handle_get_cache_statistics(
      libewf_handle_t *handle,
-     int maximum_number_of_open_handles,
+     uint64_t *number_of_hits,
+     uint64_t *number_of_misses,
      libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_set_maximum_number_of_open_handles";
+	static char *function                     = "libewf_handle_get_cache_statistics";
 	int result                                = 1;
 
 	if( handle == NULL )
@@ -6734,8 +11377,30 @@ int libewf_handle_set_maximum_number_of_open_handles(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
+	if( number_of_hits == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of hits.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_misses == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of misses.",
+		 function );
+
+		return( -1 );
+	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
+	if( libcthreads_read_write_lock_grab_for_read(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -6743,17 +11408,23 @@ int libewf_handle_set_maximum_number_of_open_handles(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 "%s: unable to grab read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	if( internal_handle->file_io_pool != NULL )
+	if( internal_handle->chunk_table == NULL )
 	{
-		result = libbfio_pool_set_maximum_number_of_open_handles(
-		          internal_handle->file_io_pool,
-		          maximum_number_of_open_handles,
+		*number_of_hits   = 0;
+		*number_of_misses = 0;
+	}
+	else
+	{
+		result = libewf_chunk_cache_get_statistics(
+		          internal_handle->chunk_table->chunk_cache,
+		          number_of_hits,
+		          number_of_misses,
 		          error );
 
 		if( result != 1 )
@@ -6761,17 +11432,13 @@ int libewf_handle_set_maximum_number_of_open_handles(
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set maximum number of open handles in file IO pool.",
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve chunk cache statistics.",
 			 function );
 		}
 	}
-	if( result == 1 )
-	{
-		internal_handle->maximum_number_of_open_handles = maximum_number_of_open_handles;
-	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
+	if( libcthreads_read_write_lock_release_for_read(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -6779,7 +11446,7 @@ int libewf_handle_set_maximum_number_of_open_handles(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 "%s: unable to release read/write lock for reading.",
 		 function );
 
 		return( -1 );
@@ -7601,6 +12268,107 @@ int libewf_handle_set_maximum_segment_size(
 	return( result );
 }
 
+/* Sets the write buffer size
+ * The segment files created for writing collect the data written in a write buffer
+ * of this size, which is written to the file in a single write when full
+ * The file IO handles of these segment files are not libbfio file handles
+ * A value of 0 disables the write buffer
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_set_write_buffer_size(
+     libewf_handle_t *handle,
+     size_t write_buffer_size,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_set_write_buffer_size";
+	int result                                = 1;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( write_buffer_size > (size_t) LIBEWF_MAXIMUM_WRITE_BUFFER_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid write buffer size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( ( internal_handle->read_io_handle != NULL )
+	 || ( internal_handle->write_io_handle == NULL )
+	 || ( internal_handle->write_io_handle->values_initialized != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: write buffer size cannot be changed.",
+		 function );
+
+		result = -1;
+	}
+	else
+	{
+		internal_handle->io_handle->write_buffer_size = write_buffer_size;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
 /* Retrieves the filename size of the segment file of the current chunk
  * The filename size should include the end of string character
  * Returns 1 if successful, 0 if no such filename or -1 on error
@@ -10283,6 +15051,7 @@ int libewf_handle_get_compression_values(
 }
 
 /* Sets the compression values
+ * Adaptive compression cannot be set when compression threads are used
  * Returns 1 if successful or -1 on error
  */
 int libewf_handle_set_compression_values(
@@ -10331,7 +15100,7 @@ int libewf_handle_set_compression_values(
 
 		return( -1 );
 	}
-	if( ( compression_flags & ~( LIBEWF_COMPRESS_FLAG_USE_EMPTY_BLOCK_COMPRESSION ) ) != 0 )
+	if( ( compression_flags & ~( LIBEWF_COMPRESS_FLAG_USE_EMPTY_BLOCK_COMPRESSION | LIBEWF_COMPRESS_FLAG_USE_ENTROPY_TEST | LIBEWF_COMPRESS_FLAG_USE_ADAPTIVE_COMPRESSION ) ) != 0 )
 	{
 		libcerror_error_set(
 		 error,
@@ -10369,6 +15138,22 @@ int libewf_handle_set_compression_values(
 
 		goto on_error;
 	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* The adaptive compression decisions depend on the order in which the chunks are packed
+	 */
+	if( ( ( compression_flags & LIBEWF_COMPRESS_FLAG_USE_ADAPTIVE_COMPRESSION ) != 0 )
+	 && ( internal_handle->number_of_compression_threads > 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: adaptive compression is not supported with compression threads.",
+		 function );
+
+		goto on_error;
+	}
+#endif
 	if( ( internal_handle->io_handle->segment_file_type == LIBEWF_SEGMENT_FILE_TYPE_EWF2 )
 	 && ( internal_handle->io_handle->segment_file_type == LIBEWF_SEGMENT_FILE_TYPE_EWF2_LOGICAL ) )
 	{
@@ -10403,6 +15188,102 @@ on_error:
 	return( -1 );
 }
 
+/* Retrieves the number of chunks for which compression was skipped by the entropy test and by adaptive compression
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_get_compression_skip_statistics(
+     libewf_handle_t *handle,
+     uint64_t *number_of_entropy_skips,
+     uint64_t *number_of_adaptive_skips,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_compression_skip_statistics";
+	int result                                = 1;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( number_of_entropy_skips == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of entropy skips.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_adaptive_skips == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of adaptive skips.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	result = libewf_compression_estimator_get_statistics(
+	          internal_handle->compression_estimator,
+	          number_of_entropy_skips,
+	          number_of_adaptive_skips,
+	          error );
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve statistics from compression estimator.",
+		 function );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
 /* Retrieves the size of the contained media data
  * Returns 1 if successful or -1 on error
  */
@@ -12665,6 +17546,7 @@ int libewf_handle_append_acquiry_error(
 }
 
 /* Retrieves the number of checksum errors
+ * The write lock is grabbed since concurrent reads at a specific offset can add checksum errors
  * Returns 1 if successful or -1 on error
  */
 int libewf_handle_get_number_of_checksum_errors(
@@ -12701,7 +17583,7 @@ int libewf_handle_get_number_of_checksum_errors(
 		return( -1 );
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
+	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -12709,7 +17591,7 @@ int libewf_handle_get_number_of_checksum_errors(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
@@ -12735,7 +17617,7 @@ int libewf_handle_get_number_of_checksum_errors(
 	*number_of_errors = number_of_elements;
 
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
+	if( libcthreads_read_write_lock_release_for_write(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -12743,7 +17625,7 @@ int libewf_handle_get_number_of_checksum_errors(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
 		return( -1 );
@@ -12753,7 +17635,7 @@ int libewf_handle_get_number_of_checksum_errors(
 
 on_error:
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	libcthreads_read_write_lock_release_for_read(
+	libcthreads_read_write_lock_release_for_write(
 	 internal_handle->read_write_lock,
 	 NULL );
 #endif
@@ -12761,6 +17643,7 @@ on_error:
 }
 
 /* Retrieves a checksum error
+ * The write lock is grabbed since concurrent reads at a specific offset can add checksum errors
  * Returns 1 if successful or -1 on error
  */
 int libewf_handle_get_checksum_error(
@@ -12799,7 +17682,7 @@ int libewf_handle_get_checksum_error(
 		return( -1 );
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
+	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -12807,7 +17690,7 @@ int libewf_handle_get_checksum_error(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
@@ -12831,7 +17714,7 @@ int libewf_handle_get_checksum_error(
 		 error_index );
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
+	if( libcthreads_read_write_lock_release_for_write(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -12839,7 +17722,7 @@ int libewf_handle_get_checksum_error(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
 		return( -1 );
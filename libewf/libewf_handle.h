@@ -28,19 +28,27 @@
 #include "libewf_chunk_data.h"
 #include "libewf_chunk_group.h"
 #include "libewf_chunk_table.h"
+#include "libewf_compression_context_pool.h"
+#include "libewf_compression_estimator.h"
+#include "libewf_compression_job.h"
 #include "libewf_data_chunk.h"
+#include "libewf_decompression_job.h"
 #include "libewf_extern.h"
 #include "libewf_hash_sections.h"
+#include "libewf_index_file.h"
 #include "libewf_libbfio.h"
 #include "libewf_libcdata.h"
 #include "libewf_libcerror.h"
+#include "libewf_libcfile.h"
 #include "libewf_libcthreads.h"
 #include "libewf_libfcache.h"
 #include "libewf_libfdata.h"
 #include "libewf_libfvalue.h"
 #include "libewf_io_handle.h"
 #include "libewf_media_values.h"
+#include "libewf_prefetch_job.h"
 #include "libewf_read_io_handle.h"
+#include "libewf_segment_file_job.h"
 #include "libewf_segment_table.h"
 #include "libewf_single_files.h"
 #include "libewf_types.h"
@@ -94,6 +102,30 @@ struct libewf_internal_handle
 	 */
 	int maximum_number_of_open_handles;
 
+	/* The IO backend of the segment files
+	 */
+	const file_io_backend_t *io_backend;
+
+	/* The compression context pool
+	 */
+	libewf_compression_context_pool_t *compression_context_pool;
+
+	/* The compression estimator
+	 */
+	libewf_compression_estimator_t *compression_estimator;
+
+	/* The index file IO handle
+	 */
+	libbfio_handle_t *index_file_io_handle;
+
+	/* The index file
+	 */
+	libewf_index_file_t *index_file;
+
+	/* The maximum size of the chunk cache
+	 */
+	size64_t maximum_cache_size;
+
 	/* The current (storage media) offset
 	 */
 	off64_t current_offset;
@@ -142,6 +174,85 @@ struct libewf_internal_handle
 	/* The read/write lock
 	 */
 	libcthreads_read_write_lock_t *read_write_lock;
+
+	/* The file IO pool mutex
+	 * Serializes access of concurrent readers to the segment table,
+	 * the chunk table and the file IO pool
+	 */
+	libcthreads_mutex_t *file_io_pool_mutex;
+
+	/* The number of decompression threads
+	 */
+	int number_of_decompression_threads;
+
+	/* The decompression thread pool
+	 */
+	libcthreads_thread_pool_t *decompression_thread_pool;
+
+	/* The queue of finished decompression jobs
+	 */
+	libcthreads_queue_t *decompression_jobs_queue;
+
+	/* The number of compression threads
+	 */
+	int number_of_compression_threads;
+
+	/* The compression thread pool
+	 */
+	libcthreads_thread_pool_t *compression_thread_pool;
+
+	/* The queue of finished compression jobs
+	 */
+	libcthreads_queue_t *compression_jobs_queue;
+
+	/* The compression jobs that have not been written, in chunk order
+	 */
+	libewf_compression_job_t *compression_jobs[ LIBEWF_MAXIMUM_NUMBER_OF_COMPRESSION_THREADS * LIBEWF_COMPRESSION_JOBS_PER_THREAD ];
+
+	/* The index of the first compression job that has not been written
+	 */
+	int compression_jobs_index;
+
+	/* The number of compression jobs that have not been written
+	 */
+	int number_of_compression_jobs;
+
+	/* The prefetch depth, the number of chunks read ahead of a sequential reader
+	 */
+	int prefetch_depth;
+
+	/* The prefetch thread pool
+	 */
+	libcthreads_thread_pool_t *prefetch_thread_pool;
+
+	/* The number of outstanding prefetch jobs
+	 */
+	int number_of_prefetch_jobs;
+
+	/* The number of consecutive sequential reads
+	 */
+	int number_of_sequential_reads;
+
+	/* The index of the last chunk that was read
+	 */
+	uint64_t last_read_chunk_index;
+
+	/* The index of the next chunk to prefetch
+	 */
+	uint64_t next_prefetch_chunk_index;
+
+	/* The prefetch condition, signalled when no prefetch jobs are outstanding
+	 */
+	libcthreads_condition_t *prefetch_condition;
+
+	/* The number of open threads
+	 */
+	int number_of_open_threads;
+
+	/* The queue of finished segment file jobs
+	 * The queue is only available while the segment files are being opened
+	 */
+	libcthreads_queue_t *segment_file_jobs_queue;
 #endif
 };
 
@@ -199,6 +310,11 @@ int libewf_internal_handle_open_read_segment_files(
      libewf_segment_table_t *segment_table,
      libcerror_error_t **error );
 
+int libewf_internal_handle_open_read_index_file(
+     libewf_internal_handle_t *internal_handle,
+     libewf_segment_table_t *segment_table,
+     libcerror_error_t **error );
+
 int libewf_internal_handle_open_read_device_information(
      libewf_internal_handle_t *internal_handle,
      libbfio_pool_t *file_io_pool,
@@ -232,6 +348,59 @@ ssize_t libewf_internal_handle_read_buffer_from_file_io_pool(
          size_t buffer_size,
          libcerror_error_t **error );
 
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+int libewf_internal_handle_decompression_thread_pool_callback(
+     libewf_decompression_job_t *decompression_job,
+     libewf_internal_handle_t *internal_handle );
+
+ssize_t libewf_internal_handle_read_buffer_from_file_io_pool_with_threads(
+         libewf_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         void *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error );
+
+int libewf_internal_handle_prefetch_thread_pool_callback(
+     libewf_prefetch_job_t *prefetch_job,
+     libewf_internal_handle_t *internal_handle );
+
+int libewf_internal_handle_schedule_prefetch_jobs(
+     libewf_internal_handle_t *internal_handle,
+     off64_t offset,
+     size_t read_size,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_wait_for_prefetch_jobs(
+     libewf_internal_handle_t *internal_handle,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_compression_thread_pool_callback(
+     libewf_compression_job_t *compression_job,
+     libewf_internal_handle_t *internal_handle );
+
+int libewf_internal_handle_write_compression_jobs(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     int maximum_number_of_jobs,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_free_compression_jobs(
+     libewf_internal_handle_t *internal_handle,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_segment_file_thread_pool_callback(
+     libewf_segment_file_job_t *segment_file_job,
+     libewf_internal_handle_t *internal_handle );
+
+int libewf_internal_handle_open_read_segment_files_with_threads(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     libewf_segment_table_t *segment_table,
+     uint32_t first_segment_number,
+     uint32_t number_of_segments,
+     libcerror_error_t **error );
+#endif
+
 LIBEWF_EXTERN \
 ssize_t libewf_handle_read_buffer(
          libewf_handle_t *handle,
@@ -239,6 +408,21 @@ ssize_t libewf_handle_read_buffer(
          size_t buffer_size,
          libcerror_error_t **error );
 
+int libewf_internal_handle_read_chunk_data_by_offset_no_cache(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     off64_t offset,
+     libewf_chunk_data_t **chunk_data,
+     libcerror_error_t **error );
+
+ssize_t libewf_internal_handle_read_buffer_at_offset_from_file_io_pool(
+         libewf_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error );
+
 LIBEWF_EXTERN \
 ssize_t libewf_handle_read_buffer_at_offset(
          libewf_handle_t *handle,
@@ -334,6 +518,79 @@ int libewf_handle_set_maximum_number_of_open_handles(
      int maximum_number_of_open_handles,
      libcerror_error_t **error );
 
+LIBEWF_EXTERN \
+int libewf_handle_set_io_backend(
+     libewf_handle_t *handle,
+     const file_io_backend_t *io_backend,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_index_filename(
+     libewf_handle_t *handle,
+     const char *filename,
+     size_t filename_length,
+     libcerror_error_t **error );
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+LIBEWF_EXTERN \
+int libewf_handle_set_index_filename_wide(
+     libewf_handle_t *handle,
+     const wchar_t *filename,
+     size_t filename_length,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+int libewf_internal_handle_set_index_file_io_handle(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_handle_t **file_io_handle,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_number_of_decompression_threads(
+     libewf_handle_t *handle,
+     int number_of_threads,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_number_of_compression_threads(
+     libewf_handle_t *handle,
+     int number_of_threads,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_number_of_open_threads(
+     libewf_handle_t *handle,
+     int number_of_threads,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_prefetch_depth(
+     libewf_handle_t *handle,
+     int prefetch_depth,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_prefetch_statistics(
+     libewf_handle_t *handle,
+     uint64_t *number_of_hits,
+     uint64_t *number_of_wasted,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_maximum_cache_size(
+     libewf_handle_t *handle,
+     size64_t maximum_cache_size,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_cache_statistics(
+     libewf_handle_t *handle,
+     uint64_t *number_of_hits,
+     uint64_t *number_of_misses,
+     libcerror_error_t **error );
+
 LIBEWF_EXTERN \
 int libewf_handle_segment_files_corrupted(
      libewf_handle_t *handle,
@@ -400,6 +657,12 @@ int libewf_handle_set_maximum_segment_size(
      size64_t maximum_segment_size,
      libcerror_error_t **error );
 
+LIBEWF_EXTERN \
+int libewf_handle_set_write_buffer_size(
+     libewf_handle_t *handle,
+     size_t write_buffer_size,
+     libcerror_error_t **error );
+
 LIBEWF_EXTERN \
 int libewf_handle_get_filename_size(
      libewf_handle_t *handle,
@@ -563,6 +826,13 @@ int libewf_handle_set_compression_values(
      uint8_t compression_flags,
      libcerror_error_t **error );
 
+LIBEWF_EXTERN \
+int libewf_handle_get_compression_skip_statistics(
+     libewf_handle_t *handle,
+     uint64_t *number_of_entropy_skips,
+     uint64_t *number_of_adaptive_skips,
+     libcerror_error_t **error );
+
 LIBEWF_EXTERN \
 int libewf_handle_get_media_size(
      libewf_handle_t *handle,
@@ -0,0 +1,1232 @@
+/*
+ * Index file functions
+ *
+ * Copyright (C) 2006-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_checksum.h"
+#include "libewf_index_file.h"
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+
+#include "ewf_index_file.h"
+
+const uint8_t ewf_index_file_signature[ 8 ] = { 0x45, 0x57, 0x46, 0x49, 0x44, 0x58, 0x0d, 0x0a };
+
+/* Creates an index file
+ * Make sure the value index_file is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_index_file_initialize(
+     libewf_index_file_t **index_file,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_index_file_initialize";
+
+	if( index_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index file.",
+		 function );
+
+		return( -1 );
+	}
+	if( *index_file != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid index file value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*index_file = memory_allocate_structure(
+	               libewf_index_file_t );
+
+	if( *index_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create index file.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *index_file,
+	     0,
+	     sizeof( libewf_index_file_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear index file.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *index_file != NULL )
+	{
+		memory_free(
+		 *index_file );
+
+		*index_file = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees an index file
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_index_file_free(
+     libewf_index_file_t **index_file,
+     libcerror_error_t **error )
+{
+	static char *function  = "libewf_index_file_free";
+	uint32_t segment_index = 0;
+
+	if( index_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index file.",
+		 function );
+
+		return( -1 );
+	}
+	if( *index_file != NULL )
+	{
+		if( ( *index_file )->segment_records != NULL )
+		{
+			for( segment_index = 0;
+			     segment_index < ( *index_file )->number_of_segments;
+			     segment_index++ )
+			{
+				if( ( *index_file )->segment_records[ segment_index ] != NULL )
+				{
+					memory_free(
+					 ( *index_file )->segment_records[ segment_index ] );
+				}
+			}
+			memory_free(
+			 ( *index_file )->segment_records );
+		}
+		if( ( *index_file )->segment_record_sizes != NULL )
+		{
+			memory_free(
+			 ( *index_file )->segment_record_sizes );
+		}
+		memory_free(
+		 *index_file );
+
+		*index_file = NULL;
+	}
+	return( 1 );
+}
+
+/* Resizes the index file to the number of segments
+ * Records of segments that no longer fit are removed
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_index_file_resize(
+     libewf_index_file_t *index_file,
+     uint32_t number_of_segments,
+     libcerror_error_t **error )
+{
+	void *reallocation     = NULL;
+	static char *function  = "libewf_index_file_resize";
+	uint32_t segment_index = 0;
+
+	if( index_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index file.",
+		 function );
+
+		return( -1 );
+	}
+	if( (size_t) number_of_segments > ( MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( uint8_t * ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid number of segments value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_segments == index_file->number_of_segments )
+	{
+		return( 1 );
+	}
+	for( segment_index = number_of_segments;
+	     segment_index < index_file->number_of_segments;
+	     segment_index++ )
+	{
+		if( index_file->segment_records[ segment_index ] != NULL )
+		{
+			memory_free(
+			 index_file->segment_records[ segment_index ] );
+
+			index_file->segment_records[ segment_index ] = NULL;
+			index_file->is_modified                      = 1;
+		}
+	}
+	if( number_of_segments == 0 )
+	{
+		memory_free(
+		 index_file->segment_records );
+
+		memory_free(
+		 index_file->segment_record_sizes );
+
+		index_file->segment_records      = NULL;
+		index_file->segment_record_sizes = NULL;
+		index_file->number_of_segments   = 0;
+
+		return( 1 );
+	}
+	reallocation = memory_reallocate(
+	                index_file->segment_records,
+	                sizeof( uint8_t * ) * number_of_segments );
+
+	if( reallocation == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to resize segment records.",
+		 function );
+
+		return( -1 );
+	}
+	index_file->segment_records = (uint8_t **) reallocation;
+
+	reallocation = memory_reallocate(
+	                index_file->segment_record_sizes,
+	                sizeof( size_t ) * number_of_segments );
+
+	if( reallocation == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to resize segment record sizes.",
+		 function );
+
+		return( -1 );
+	}
+	index_file->segment_record_sizes = (size_t *) reallocation;
+
+	for( segment_index = index_file->number_of_segments;
+	     segment_index < number_of_segments;
+	     segment_index++ )
+	{
+		index_file->segment_records[ segment_index ]      = NULL;
+		index_file->segment_record_sizes[ segment_index ] = 0;
+	}
+	index_file->number_of_segments = number_of_segments;
+
+	return( 1 );
+}
+
+/* Retrieves the record of a specific segment
+ * Returns 1 if successful, 0 if no such record or -1 on error
+ */
+int libewf_index_file_get_segment_record(
+     libewf_index_file_t *index_file,
+     uint32_t segment_index,
+     const uint8_t **record_data,
+     size_t *record_data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_index_file_get_segment_record";
+
+	if( index_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index file.",
+		 function );
+
+		return( -1 );
+	}
+	if( record_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid record data.",
+		 function );
+
+		return( -1 );
+	}
+	if( record_data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid record data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( segment_index >= index_file->number_of_segments )
+	 || ( index_file->segment_records[ segment_index ] == NULL ) )
+	{
+		return( 0 );
+	}
+	*record_data      = index_file->segment_records[ segment_index ];
+	*record_data_size = index_file->segment_record_sizes[ segment_index ];
+
+	return( 1 );
+}
+
+/* Sets the record of a specific segment
+ * The record data is copied, NULL record data removes the record
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_index_file_set_segment_record(
+     libewf_index_file_t *index_file,
+     uint32_t segment_index,
+     const uint8_t *record_data,
+     size_t record_data_size,
+     libcerror_error_t **error )
+{
+	uint8_t *segment_record = NULL;
+	static char *function   = "libewf_index_file_set_segment_record";
+
+	if( index_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index file.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_index >= index_file->number_of_segments )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid segment index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( record_data != NULL )
+	{
+		if( ( record_data_size < sizeof( ewf_index_file_segment_t ) )
+		 || ( record_data_size > (size_t) UINT32_MAX )
+		 || ( record_data_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid record data size value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+		segment_record = (uint8_t *) memory_allocate(
+		                              sizeof( uint8_t ) * record_data_size );
+
+		if( segment_record == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create segment record.",
+			 function );
+
+			return( -1 );
+		}
+		if( memory_copy(
+		     segment_record,
+		     record_data,
+		     record_data_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy segment record.",
+			 function );
+
+			memory_free(
+			 segment_record );
+
+			return( -1 );
+		}
+	}
+	else if( index_file->segment_records[ segment_index ] == NULL )
+	{
+		return( 1 );
+	}
+	if( index_file->segment_records[ segment_index ] != NULL )
+	{
+		memory_free(
+		 index_file->segment_records[ segment_index ] );
+	}
+	index_file->segment_records[ segment_index ]      = segment_record;
+	index_file->segment_record_sizes[ segment_index ] = ( segment_record != NULL ) ? record_data_size : 0;
+	index_file->is_modified                           = 1;
+
+	return( 1 );
+}
+
+/* Reads the index file
+ * The number of segments is the number of segment files in the segment file set,
+ * an index file with a record of a segment beyond it is rejected
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_index_file_read_data(
+     libewf_index_file_t *index_file,
+     const uint8_t *data,
+     size_t data_size,
+     uint32_t number_of_segments,
+     libcerror_error_t **error )
+{
+	const uint8_t *record_data   = NULL;
+	static char *function        = "libewf_index_file_read_data";
+	size_t data_offset           = 0;
+	uint64_t records_data_size   = 0;
+	uint32_t calculated_checksum = 0;
+	uint32_t format_version      = 0;
+	uint32_t number_of_records   = 0;
+	uint32_t record_index        = 0;
+	uint32_t record_size         = 0;
+	uint32_t segment_number      = 0;
+	uint32_t stored_checksum     = 0;
+
+	if( index_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index file.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_size < sizeof( ewf_index_file_header_t ) )
+	 || ( data_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_compare(
+	     ( (ewf_index_file_header_t *) data )->signature,
+	     ewf_index_file_signature,
+	     8 ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported index file signature.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (ewf_index_file_header_t *) data )->format_version,
+	 format_version );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (ewf_index_file_header_t *) data )->number_of_records,
+	 number_of_records );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 ( (ewf_index_file_header_t *) data )->records_data_size,
+	 records_data_size );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (ewf_index_file_header_t *) data )->checksum,
+	 stored_checksum );
+
+	if( libewf_checksum_calculate_adler32(
+	     &calculated_checksum,
+	     data,
+	     sizeof( ewf_index_file_header_t ) - 4,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to calculate header checksum.",
+		 function );
+
+		return( -1 );
+	}
+	if( stored_checksum != calculated_checksum )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_INPUT,
+		 LIBCERROR_INPUT_ERROR_CHECKSUM_MISMATCH,
+		 "%s: header checksum does not match (stored: 0x%08" PRIx32 ", calculated: 0x%08" PRIx32 ").",
+		 function,
+		 stored_checksum,
+		 calculated_checksum );
+
+		return( -1 );
+	}
+	if( format_version != LIBEWF_INDEX_FILE_FORMAT_VERSION )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported format version: %" PRIu32 ".",
+		 function,
+		 format_version );
+
+		return( -1 );
+	}
+	if( records_data_size != (uint64_t) ( data_size - sizeof( ewf_index_file_header_t ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid records data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (ewf_index_file_header_t *) data )->records_data_checksum,
+	 stored_checksum );
+
+	data_offset = sizeof( ewf_index_file_header_t );
+
+	if( libewf_checksum_calculate_adler32(
+	     &calculated_checksum,
+	     &( data[ data_offset ] ),
+	     data_size - data_offset,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to calculate records data checksum.",
+		 function );
+
+		return( -1 );
+	}
+	if( stored_checksum != calculated_checksum )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_INPUT,
+		 LIBCERROR_INPUT_ERROR_CHECKSUM_MISMATCH,
+		 "%s: records data checksum does not match (stored: 0x%08" PRIx32 ", calculated: 0x%08" PRIx32 ").",
+		 function,
+		 stored_checksum,
+		 calculated_checksum );
+
+		return( -1 );
+	}
+	if( libewf_index_file_resize(
+	     index_file,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+		 "%s: unable to empty index file.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_index_file_resize(
+	     index_file,
+	     number_of_segments,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+		 "%s: unable to resize index file.",
+		 function );
+
+		goto on_error;
+	}
+	for( record_index = 0;
+	     record_index < number_of_records;
+	     record_index++ )
+	{
+		if( ( data_size - data_offset ) < sizeof( ewf_index_file_segment_t ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid record: %" PRIu32 " - data size value out of bounds.",
+			 function,
+			 record_index );
+
+			goto on_error;
+		}
+		record_data = &( data[ data_offset ] );
+
+		byte_stream_copy_to_uint32_little_endian(
+		 ( (ewf_index_file_segment_t *) record_data )->record_size,
+		 record_size );
+
+		byte_stream_copy_to_uint32_little_endian(
+		 ( (ewf_index_file_segment_t *) record_data )->segment_number,
+		 segment_number );
+
+		if( ( (size_t) record_size < sizeof( ewf_index_file_segment_t ) )
+		 || ( (size_t) record_size > ( data_size - data_offset ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid record: %" PRIu32 " - record size value out of bounds.",
+			 function,
+			 record_index );
+
+			goto on_error;
+		}
+		if( ( segment_number == 0 )
+		 || ( segment_number > number_of_segments ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid record: %" PRIu32 " - segment number value out of bounds.",
+			 function,
+			 record_index );
+
+			goto on_error;
+		}
+		if( index_file->segment_records[ segment_number - 1 ] != NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+			 "%s: invalid record: %" PRIu32 " - segment: %" PRIu32 " value already set.",
+			 function,
+			 record_index,
+			 segment_number );
+
+			goto on_error;
+		}
+		if( libewf_index_file_set_segment_record(
+		     index_file,
+		     segment_number - 1,
+		     record_data,
+		     (size_t) record_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set record: %" PRIu32 ".",
+			 function,
+			 record_index );
+
+			goto on_error;
+		}
+		data_offset += (size_t) record_size;
+	}
+	if( data_offset != data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid records data size value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	index_file->is_modified = 0;
+
+	return( 1 );
+
+on_error:
+	libewf_index_file_resize(
+	 index_file,
+	 0,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Reads the index file
+ * The number of segments is the number of segment files in the segment file set
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_index_file_read_file_io_handle(
+     libewf_index_file_t *index_file,
+     libbfio_handle_t *file_io_handle,
+     uint32_t number_of_segments,
+     libcerror_error_t **error )
+{
+	uint8_t *data                        = NULL;
+	static char *function                = "libewf_index_file_read_file_io_handle";
+	size64_t file_size                   = 0;
+	ssize_t read_count                   = 0;
+	int file_io_handle_opened_in_library = 0;
+
+	if( index_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index file.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_handle_open(
+	     file_io_handle,
+	     LIBBFIO_OPEN_READ,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	file_io_handle_opened_in_library = 1;
+
+	if( libbfio_handle_get_size(
+	     file_io_handle,
+	     &file_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file size.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( file_size < (size64_t) sizeof( ewf_index_file_header_t ) )
+	 || ( file_size > (size64_t) MEMORY_MAXIMUM_ALLOCATION_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid file size value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	data = (uint8_t *) memory_allocate(
+	                    sizeof( uint8_t ) * (size_t) file_size );
+
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create data.",
+		 function );
+
+		goto on_error;
+	}
+	read_count = libbfio_handle_read_buffer_at_offset(
+	              file_io_handle,
+	              data,
+	              (size_t) file_size,
+	              0,
+	              error );
+
+	if( read_count != (ssize_t) file_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read index file data.",
+		 function );
+
+		goto on_error;
+	}
+	file_io_handle_opened_in_library = 0;
+
+	if( libbfio_handle_close(
+	     file_io_handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_index_file_read_data(
+	     index_file,
+	     data,
+	     (size_t) file_size,
+	     number_of_segments,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read index file.",
+		 function );
+
+		goto on_error;
+	}
+	memory_free(
+	 data );
+
+	return( 1 );
+
+on_error:
+	if( data != NULL )
+	{
+		memory_free(
+		 data );
+	}
+	if( file_io_handle_opened_in_library != 0 )
+	{
+		libbfio_handle_close(
+		 file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Writes the index file
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_index_file_write_data(
+     libewf_index_file_t *index_file,
+     uint8_t **data,
+     size_t *data_size,
+     libcerror_error_t **error )
+{
+	uint8_t *safe_data         = NULL;
+	static char *function      = "libewf_index_file_write_data";
+	size_t data_offset         = 0;
+	size_t records_data_size   = 0;
+	size_t safe_data_size      = 0;
+	uint32_t checksum          = 0;
+	uint32_t number_of_records = 0;
+	uint32_t segment_index     = 0;
+
+	if( index_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index file.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( *data != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid data value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data size.",
+		 function );
+
+		return( -1 );
+	}
+	for( segment_index = 0;
+	     segment_index < index_file->number_of_segments;
+	     segment_index++ )
+	{
+		if( index_file->segment_records[ segment_index ] != NULL )
+		{
+			if( index_file->segment_record_sizes[ segment_index ] > ( (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE - records_data_size ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+				 "%s: invalid records data size value exceeds maximum.",
+				 function );
+
+				goto on_error;
+			}
+			records_data_size += index_file->segment_record_sizes[ segment_index ];
+
+			number_of_records++;
+		}
+	}
+	safe_data_size = sizeof( ewf_index_file_header_t ) + records_data_size;
+
+	if( safe_data_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		goto on_error;
+	}
+	safe_data = (uint8_t *) memory_allocate(
+	                         sizeof( uint8_t ) * safe_data_size );
+
+	if( safe_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create data.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     safe_data,
+	     0,
+	     sizeof( ewf_index_file_header_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear index file header.",
+		 function );
+
+		goto on_error;
+	}
+	data_offset = sizeof( ewf_index_file_header_t );
+
+	for( segment_index = 0;
+	     segment_index < index_file->number_of_segments;
+	     segment_index++ )
+	{
+		if( index_file->segment_records[ segment_index ] != NULL )
+		{
+			if( memory_copy(
+			     &( safe_data[ data_offset ] ),
+			     index_file->segment_records[ segment_index ],
+			     index_file->segment_record_sizes[ segment_index ] ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy segment: %" PRIu32 " record.",
+				 function,
+				 segment_index + 1 );
+
+				goto on_error;
+			}
+			data_offset += index_file->segment_record_sizes[ segment_index ];
+		}
+	}
+	if( memory_copy(
+	     ( (ewf_index_file_header_t *) safe_data )->signature,
+	     ewf_index_file_signature,
+	     8 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy signature.",
+		 function );
+
+		goto on_error;
+	}
+	byte_stream_copy_from_uint32_little_endian(
+	 ( (ewf_index_file_header_t *) safe_data )->format_version,
+	 LIBEWF_INDEX_FILE_FORMAT_VERSION );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 ( (ewf_index_file_header_t *) safe_data )->number_of_records,
+	 number_of_records );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 ( (ewf_index_file_header_t *) safe_data )->records_data_size,
+	 (uint64_t) records_data_size );
+
+	if( libewf_checksum_calculate_adler32(
+	     &checksum,
+	     &( safe_data[ sizeof( ewf_index_file_header_t ) ] ),
+	     records_data_size,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to calculate records data checksum.",
+		 function );
+
+		goto on_error;
+	}
+	byte_stream_copy_from_uint32_little_endian(
+	 ( (ewf_index_file_header_t *) safe_data )->records_data_checksum,
+	 checksum );
+
+	if( libewf_checksum_calculate_adler32(
+	     &checksum,
+	     safe_data,
+	     sizeof( ewf_index_file_header_t ) - 4,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to calculate header checksum.",
+		 function );
+
+		goto on_error;
+	}
+	byte_stream_copy_from_uint32_little_endian(
+	 ( (ewf_index_file_header_t *) safe_data )->checksum,
+	 checksum );
+
+	*data      = safe_data;
+	*data_size = safe_data_size;
+
+	return( 1 );
+
+on_error:
+	if( safe_data != NULL )
+	{
+		memory_free(
+		 safe_data );
+	}
+	return( -1 );
+}
+
+/* Writes the index file
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_index_file_write_file_io_handle(
+     libewf_index_file_t *index_file,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	uint8_t *data                        = NULL;
+	static char *function                = "libewf_index_file_write_file_io_handle";
+	size_t data_size                     = 0;
+	ssize_t write_count                  = 0;
+	int file_io_handle_opened_in_library = 0;
+
+	if( index_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index file.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_index_file_write_data(
+	     index_file,
+	     &data,
+	     &data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to write index file data.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_open(
+	     file_io_handle,
+	     LIBBFIO_OPEN_WRITE_TRUNCATE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	file_io_handle_opened_in_library = 1;
+
+	write_count = libbfio_handle_write_buffer_at_offset(
+	               file_io_handle,
+	               data,
+	               data_size,
+	               0,
+	               error );
+
+	if( write_count != (ssize_t) data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write index file data.",
+		 function );
+
+		goto on_error;
+	}
+	file_io_handle_opened_in_library = 0;
+
+	if( libbfio_handle_close(
+	     file_io_handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	memory_free(
+	 data );
+
+	index_file->is_modified = 0;
+
+	return( 1 );
+
+on_error:
+	if( file_io_handle_opened_in_library != 0 )
+	{
+		libbfio_handle_close(
+		 file_io_handle,
+		 NULL );
+	}
+	if( data != NULL )
+	{
+		memory_free(
+		 data );
+	}
+	return( -1 );
+}
+
@@ -0,0 +1,122 @@
+/*
+ * Index file functions
+ *
+ * Copyright (C) 2006-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_INDEX_FILE_H )
+#define _LIBEWF_INDEX_FILE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The index file format version
+ */
+#define LIBEWF_INDEX_FILE_FORMAT_VERSION	1
+
+extern const uint8_t ewf_index_file_signature[ 8 ];
+
+typedef struct libewf_index_file libewf_index_file_t;
+
+/* The index file is an optional sidecar file that contains a record per segment file,
+ * with the values that are otherwise determined by scanning the section descriptors
+ * and table sections of the segment file
+ */
+struct libewf_index_file
+{
+	/* The segment records
+	 */
+	uint8_t **segment_records;
+
+	/* The segment record sizes
+	 */
+	size_t *segment_record_sizes;
+
+	/* The number of segments
+	 */
+	uint32_t number_of_segments;
+
+	/* Value to indicate the segment records were modified
+	 */
+	uint8_t is_modified;
+};
+
+int libewf_index_file_initialize(
+     libewf_index_file_t **index_file,
+     libcerror_error_t **error );
+
+int libewf_index_file_free(
+     libewf_index_file_t **index_file,
+     libcerror_error_t **error );
+
+int libewf_index_file_resize(
+     libewf_index_file_t *index_file,
+     uint32_t number_of_segments,
+     libcerror_error_t **error );
+
+int libewf_index_file_get_segment_record(
+     libewf_index_file_t *index_file,
+     uint32_t segment_index,
+     const uint8_t **record_data,
+     size_t *record_data_size,
+     libcerror_error_t **error );
+
+int libewf_index_file_set_segment_record(
+     libewf_index_file_t *index_file,
+     uint32_t segment_index,
+     const uint8_t *record_data,
+     size_t record_data_size,
+     libcerror_error_t **error );
+
+int libewf_index_file_read_data(
+     libewf_index_file_t *index_file,
+     const uint8_t *data,
+     size_t data_size,
+     uint32_t number_of_segments,
+     libcerror_error_t **error );
+
+int libewf_index_file_read_file_io_handle(
+     libewf_index_file_t *index_file,
+     libbfio_handle_t *file_io_handle,
+     uint32_t number_of_segments,
+     libcerror_error_t **error );
+
+int libewf_index_file_write_data(
+     libewf_index_file_t *index_file,
+     uint8_t **data,
+     size_t *data_size,
+     libcerror_error_t **error );
+
+int libewf_index_file_write_file_io_handle(
+     libewf_index_file_t *index_file,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_INDEX_FILE_H ) */
+
@@ -268,6 +268,12 @@ int libewf_io_handle_clone(
 	}
 	( *destination_io_handle )->zero_on_error = source_io_handle->zero_on_error;
 
+	/* The compression context pool, estimator and index file are owned by the handle and not shared with the clone
+	 */
+	( *destination_io_handle )->compression_context_pool = NULL;
+	( *destination_io_handle )->compression_estimator    = NULL;
+	( *destination_io_handle )->index_file               = NULL;
+
 	return( 1 );
 
 on_error:
@@ -25,7 +25,11 @@
 #include <common.h>
 #include <types.h>
 
+#include "libewf_compression_context_pool.h"
+#include "libewf_compression_estimator.h"
+#include "libewf_index_file.h"
 #include "libewf_libcerror.h"
+#include "libewf_libcfile.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -86,6 +90,27 @@ struct libewf_io_handle
 	/* Value to indicate if abort was signalled
 	 */
 	int abort;
+
+	/* The IO backend of the segment files
+	 */
+	const file_io_backend_t *io_backend;
+
+	/* The size of the write buffer of the segment files created for writing
+	 * A value of 0 represents no write buffer
+	 */
+	size_t write_buffer_size;
+
+	/* The compression context pool
+	 */
+	libewf_compression_context_pool_t *compression_context_pool;
+
+	/* The compression estimator
+	 */
+	libewf_compression_estimator_t *compression_estimator;
+
+	/* The index file
+	 */
+	libewf_index_file_t *index_file;
 };
 
 int libewf_io_handle_initialize(
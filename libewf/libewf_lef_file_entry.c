@@ -33,6 +33,7 @@
 #include "libewf_libfvalue.h"
 #include "libewf_libuna.h"
 #include "libewf_serialized_string.h"
+#include "libewf_sub_node_index.h"
 #include "libewf_lef_file_entry.h"
 
 const uint8_t libewf_lef_extended_attributes_header[ 37 ] = {
@@ -351,6 +352,22 @@ int libewf_lef_file_entry_free(
 				result = -1;
 			}
 		}
+		if( ( *lef_file_entry )->sub_node_index != NULL )
+		{
+			if( libewf_sub_node_index_free(
+			     &( ( *lef_file_entry )->sub_node_index ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free sub node index.",
+				 function );
+
+				result = -1;
+			}
+		}
 		memory_free(
 		 *lef_file_entry );
 
@@ -436,6 +453,7 @@ int libewf_lef_file_entry_clone(
 	( *destination_lef_file_entry )->md5_hash            = NULL;
 	( *destination_lef_file_entry )->sha1_hash           = NULL;
 	( *destination_lef_file_entry )->extended_attributes = NULL;
+	( *destination_lef_file_entry )->sub_node_index      = NULL;
 
 	if( libewf_serialized_string_clone(
 	     &( ( *destination_lef_file_entry )->guid ),
@@ -30,6 +30,7 @@
 #include "libewf_libcerror.h"
 #include "libewf_libfvalue.h"
 #include "libewf_serialized_string.h"
+#include "libewf_sub_node_index.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -139,6 +140,10 @@ struct libewf_lef_file_entry
 	/* The extended attributes array
 	 */
 	libcdata_array_t *extended_attributes;
+
+	/* The sub node (name) index
+	 */
+	libewf_sub_node_index_t *sub_node_index;
 };
 
 int libewf_lef_file_entry_initialize(
@@ -0,0 +1,131 @@
+/*
+ * Prefetch job functions
+ *
+ * Copyright (C) 2006-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_libcerror.h"
+#include "libewf_prefetch_job.h"
+
+/* Creates a prefetch job
+ * Make sure the value prefetch_job is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_prefetch_job_initialize(
+     libewf_prefetch_job_t **prefetch_job,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_prefetch_job_initialize";
+
+	if( prefetch_job == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid prefetch job.",
+		 function );
+
+		return( -1 );
+	}
+	if( *prefetch_job != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid prefetch job value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*prefetch_job = memory_allocate_structure(
+	                      libewf_prefetch_job_t );
+
+	if( *prefetch_job == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create prefetch job.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *prefetch_job,
+	     0,
+	     sizeof( libewf_prefetch_job_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear prefetch job.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *prefetch_job != NULL )
+	{
+		memory_free(
+		 *prefetch_job );
+
+		*prefetch_job = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a prefetch job
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_prefetch_job_free(
+     libewf_prefetch_job_t **prefetch_job,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_prefetch_job_free";
+
+	if( prefetch_job == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid prefetch job.",
+		 function );
+
+		return( -1 );
+	}
+	if( *prefetch_job != NULL )
+	{
+		memory_free(
+		 *prefetch_job );
+
+		*prefetch_job = NULL;
+	}
+	return( 1 );
+}
+
@@ -0,0 +1,62 @@
+/*
+ * Prefetch job functions
+ *
+ * Copyright (C) 2006-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_PREFETCH_JOB_H )
+#define _LIBEWF_PREFETCH_JOB_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libewf_prefetch_job libewf_prefetch_job_t;
+
+/* The prefetch job reads and unpacks a single chunk ahead of a sequential reader
+ */
+struct libewf_prefetch_job
+{
+	/* The chunk index
+	 */
+	uint64_t chunk_index;
+
+	/* The (media) offset of the chunk
+	 */
+	off64_t offset;
+};
+
+int libewf_prefetch_job_initialize(
+     libewf_prefetch_job_t **prefetch_job,
+     libcerror_error_t **error );
+
+int libewf_prefetch_job_free(
+     libewf_prefetch_job_t **prefetch_job,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_PREFETCH_JOB_H ) */
+
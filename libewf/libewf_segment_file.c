@@ -42,6 +42,7 @@
 #include "libewf_error2_section.h"
 #include "libewf_hash_values.h"
 #include "libewf_header_values.h"
+#include "libewf_index_file.h"
 #include "libewf_io_handle.h"
 #include "libewf_libbfio.h"
 #include "libewf_libcdata.h"
@@ -64,6 +65,7 @@
 #include "libewf_volume_section.h"
 
 #include "ewf_file_header.h"
+#include "ewf_index_file.h"
 #include "ewf_section.h"
 #include "ewf_volume.h"
 
@@ -6119,146 +6121,749 @@ on_error:
 	return( -1 );
 }
 
-/* Reads a segment file
- * Callback function for the segment files list
- * Returns 1 if successful or -1 on error
+/* Reads the index record of the segment file
+ * The index record is only used if the segment file header, size and last section
+ * match the values stored in the record
+ * Returns 1 if successful, 0 if no matching index record is available or -1 on error
  */
-int libewf_segment_file_read_element_data(
-     libewf_io_handle_t *io_handle,
+int libewf_segment_file_read_index_record(
+     libewf_segment_file_t *segment_file,
+     libewf_index_file_t *index_file,
      libbfio_pool_t *file_io_pool,
-     libfdata_list_element_t *element,
-     libfdata_cache_t *segment_file_cache,
      int file_io_pool_entry,
-     off64_t segment_file_offset,
      size64_t segment_file_size,
-     uint32_t element_flags LIBEWF_ATTRIBUTE_UNUSED,
-     uint8_t read_flags LIBEWF_ATTRIBUTE_UNUSED,
      libcerror_error_t **error )
 {
-	libewf_section_descriptor_t *section_descriptor = NULL;
-	libewf_segment_file_t *segment_file             = NULL;
-	libfcache_cache_t *sections_cache               = NULL;
-	static char *function                           = "libewf_segment_file_read_element_data";
-	ssize_t read_count                              = 0;
-	off64_t section_data_offset                     = 0;
-	int element_index                               = 0;
-	int last_section                                = 0;
-	int number_of_sections                          = 0;
-	int result                                      = 0;
-	int section_index                               = 0;
+	ewf_index_file_chunk_group_entry_t *chunk_group_entry = NULL;
+	ewf_index_file_section_entry_t *section_entry         = NULL;
+	ewf_index_file_segment_t *segment_record              = NULL;
+	libewf_section_descriptor_t *section_descriptor       = NULL;
+	const uint8_t *record_data                            = NULL;
+	static char *function                                 = "libewf_segment_file_read_index_record";
+	size_t record_data_offset                             = 0;
+	size_t record_data_size                               = 0;
+	size_t section_descriptor_size                        = 0;
+	size64_t chunk_group_data_size                        = 0;
+	size64_t mapped_size                                  = 0;
+	size64_t stored_segment_file_size                     = 0;
+	ssize_t read_count                                    = 0;
+	uint64_t chunk_group_data_offset                      = 0;
+	uint64_t last_section_offset                          = 0;
+	uint64_t section_offset                               = 0;
+	uint32_t device_information_section_index             = 0;
+	uint32_t entry_index                                  = 0;
+	uint32_t last_section_type                            = 0;
+	uint32_t number_of_chunk_groups                       = 0;
+	uint32_t number_of_sections                           = 0;
+	uint32_t range_flags                                  = 0;
+	uint32_t segment_number                               = 0;
+	uint16_t compression_method                           = 0;
+	int element_index                                     = 0;
+	int result                                            = 0;
 
-	LIBEWF_UNREFERENCED_PARAMETER( element_flags )
-	LIBEWF_UNREFERENCED_PARAMETER( read_flags )
-
-	if( io_handle == NULL )
+	if( segment_file == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid IO handle.",
+		 "%s: invalid segment file.",
 		 function );
 
 		return( -1 );
 	}
-	if( libewf_segment_file_initialize(
-	     &segment_file,
-	     io_handle,
+	if( segment_file->segment_number == 0 )
+	{
+		return( 0 );
+	}
+	result = libewf_index_file_get_segment_record(
+	          index_file,
+	          segment_file->segment_number - 1,
+	          &record_data,
+	          &record_data_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve segment: %" PRIu32 " record from index file.",
+		 function,
+		 segment_file->segment_number );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	segment_record = (ewf_index_file_segment_t *) record_data;
+
+	byte_stream_copy_to_uint32_little_endian(
+	 segment_record->segment_number,
+	 segment_number );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 segment_record->segment_file_size,
+	 stored_segment_file_size );
+
+	byte_stream_copy_to_uint16_little_endian(
+	 segment_record->compression_method,
+	 compression_method );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 segment_record->last_section_offset,
+	 last_section_offset );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 segment_record->last_section_type,
+	 last_section_type );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 segment_record->device_information_section_index,
+	 device_information_section_index );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 segment_record->number_of_sections,
+	 number_of_sections );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 segment_record->number_of_chunk_groups,
+	 number_of_chunk_groups );
+
+	if( ( segment_number != segment_file->segment_number )
+	 || ( stored_segment_file_size != segment_file_size )
+	 || ( segment_record->segment_file_type != segment_file->type )
+	 || ( segment_record->major_version != segment_file->major_version )
+	 || ( segment_record->minor_version != segment_file->minor_version ) )
+	{
+		return( 0 );
+	}
+	if( segment_file->major_version == 1 )
+	{
+		section_descriptor_size = sizeof( ewf_section_descriptor_v1_t );
+	}
+	else if( segment_file->major_version == 2 )
+	{
+		if( ( compression_method != segment_file->compression_method )
+		 || ( memory_compare(
+		       segment_record->set_identifier,
+		       segment_file->set_identifier,
+		       16 ) != 0 ) )
+		{
+			return( 0 );
+		}
+		section_descriptor_size = sizeof( ewf_section_descriptor_v2_t );
+	}
+	else
+	{
+		return( 0 );
+	}
+	if( ( number_of_sections == 0 )
+	 || ( number_of_sections > (uint32_t) INT_MAX )
+	 || ( number_of_chunk_groups > (uint32_t) INT_MAX )
+	 || ( ( (uint64_t) number_of_sections * sizeof( ewf_index_file_section_entry_t ) )
+	    + ( (uint64_t) number_of_chunk_groups * sizeof( ewf_index_file_chunk_group_entry_t ) )
+	    != (uint64_t) ( record_data_size - sizeof( ewf_index_file_segment_t ) ) ) )
+	{
+		return( 0 );
+	}
+	if( ( device_information_section_index != 0xffffffffUL )
+	 && ( device_information_section_index >= number_of_sections ) )
+	{
+		return( 0 );
+	}
+	if( ( last_section_offset == 0 )
+	 || ( last_section_offset >= (uint64_t) segment_file_size ) )
+	{
+		return( 0 );
+	}
+	/* Check the section entries and chunk group entries before changing the segment file
+	 */
+	record_data_offset = sizeof( ewf_index_file_segment_t );
+
+	for( entry_index = 0;
+	     entry_index < number_of_sections;
+	     entry_index++ )
+	{
+		section_entry = (ewf_index_file_section_entry_t *) &( record_data[ record_data_offset ] );
+
+		byte_stream_copy_to_uint64_little_endian(
+		 section_entry->offset,
+		 section_offset );
+
+		if( section_offset >= (uint64_t) segment_file_size )
+		{
+			return( 0 );
+		}
+		record_data_offset += sizeof( ewf_index_file_section_entry_t );
+	}
+	for( entry_index = 0;
+	     entry_index < number_of_chunk_groups;
+	     entry_index++ )
+	{
+		chunk_group_entry = (ewf_index_file_chunk_group_entry_t *) &( record_data[ record_data_offset ] );
+
+		byte_stream_copy_to_uint64_little_endian(
+		 chunk_group_entry->data_offset,
+		 chunk_group_data_offset );
+
+		byte_stream_copy_to_uint64_little_endian(
+		 chunk_group_entry->data_size,
+		 chunk_group_data_size );
+
+		if( ( chunk_group_data_offset >= (uint64_t) segment_file_size )
+		 || ( chunk_group_data_size > ( (uint64_t) segment_file_size - chunk_group_data_offset ) ) )
+		{
+			return( 0 );
+		}
+		record_data_offset += sizeof( ewf_index_file_chunk_group_entry_t );
+	}
+	/* Make sure the segment file was not changed after the index record was written
+	 */
+	if( libewf_section_descriptor_initialize(
+	     &section_descriptor,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create segment file.",
+		 "%s: unable to create section descriptor.",
 		 function );
 
 		goto on_error;
 	}
-	if( segment_file_size == 0 )
+	read_count = libewf_section_descriptor_read_file_io_pool(
+	              section_descriptor,
+	              file_io_pool,
+	              file_io_pool_entry,
+	              (off64_t) last_section_offset,
+	              segment_file->major_version,
+	              error );
+
+	if( read_count == -1 )
 	{
-		/* segment_file_size is 0 on write correction
-		 */
-		if( libbfio_pool_get_size(
-		     file_io_pool,
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			if( ( error != NULL )
+			 && ( *error != NULL ) )
+			{
+				libcnotify_print_error_backtrace(
+				 *error );
+			}
+		}
+#endif
+		libcerror_error_free(
+		 error );
+
+		result = 0;
+	}
+	else if( section_descriptor->type != last_section_type )
+	{
+		result = 0;
+	}
+	if( libewf_section_descriptor_free(
+	     &section_descriptor,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free section descriptor.",
+		 function );
+
+		goto on_error;
+	}
+	if( result == 0 )
+	{
+		return( 0 );
+	}
+	record_data_offset = sizeof( ewf_index_file_segment_t );
+
+	for( entry_index = 0;
+	     entry_index < number_of_sections;
+	     entry_index++ )
+	{
+		section_entry = (ewf_index_file_section_entry_t *) &( record_data[ record_data_offset ] );
+
+		byte_stream_copy_to_uint64_little_endian(
+		 section_entry->offset,
+		 section_offset );
+
+		if( libfdata_list_append_element(
+		     segment_file->sections_list,
+		     &element_index,
 		     file_io_pool_entry,
-		     &segment_file_size,
+		     (off64_t) section_offset,
+		     (size64_t) section_descriptor_size,
+		     0,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve segment file size.",
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append element to sections list.",
 			 function );
 
 			goto on_error;
 		}
+		record_data_offset += sizeof( ewf_index_file_section_entry_t );
 	}
-	read_count = libewf_segment_file_read_file_header_file_io_pool(
-		      segment_file,
-		      file_io_pool,
-		      file_io_pool_entry,
-		      error );
+	for( entry_index = 0;
+	     entry_index < number_of_chunk_groups;
+	     entry_index++ )
+	{
+		chunk_group_entry = (ewf_index_file_chunk_group_entry_t *) &( record_data[ record_data_offset ] );
 
-/* TODO deal with corrupted header ? */
-	if( read_count == -1 )
+		byte_stream_copy_to_uint64_little_endian(
+		 chunk_group_entry->data_offset,
+		 chunk_group_data_offset );
+
+		byte_stream_copy_to_uint64_little_endian(
+		 chunk_group_entry->data_size,
+		 chunk_group_data_size );
+
+		byte_stream_copy_to_uint64_little_endian(
+		 chunk_group_entry->mapped_size,
+		 mapped_size );
+
+		byte_stream_copy_to_uint32_little_endian(
+		 chunk_group_entry->range_flags,
+		 range_flags );
+
+		if( libfdata_list_append_element_with_mapped_size(
+		     segment_file->chunk_groups_list,
+		     &( segment_file->current_chunk_group_index ),
+		     file_io_pool_entry,
+		     (off64_t) chunk_group_data_offset,
+		     chunk_group_data_size,
+		     range_flags,
+		     mapped_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append element with mapped size to chunk groups list.",
+			 function );
+
+			goto on_error;
+		}
+		record_data_offset += sizeof( ewf_index_file_chunk_group_entry_t );
+	}
+	segment_file->last_section_offset = (off64_t) last_section_offset;
+
+	if( device_information_section_index != 0xffffffffUL )
+	{
+		segment_file->device_information_section_index = (int) device_information_section_index;
+	}
+	byte_stream_copy_to_uint64_little_endian(
+	 segment_record->storage_media_size,
+	 segment_file->storage_media_size );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 segment_record->number_of_chunks,
+	 segment_file->number_of_chunks );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 segment_record->last_chunk_filled,
+	 segment_file->last_chunk_filled );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 segment_record->last_chunk_compared,
+	 segment_file->last_chunk_compared );
+
+	segment_file->flags |= segment_record->flags & ( LIBEWF_SEGMENT_FILE_FLAG_IS_LAST | LIBEWF_SEGMENT_FILE_FLAG_IS_ENCRYPTED );
+	segment_file->flags |= LIBEWF_SEGMENT_FILE_FLAG_IS_INDEXED;
+
+	return( 1 );
+
+on_error:
+	if( section_descriptor != NULL )
+	{
+		libewf_section_descriptor_free(
+		 &section_descriptor,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Writes the index record of the segment file
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_file_write_index_record(
+     libewf_segment_file_t *segment_file,
+     libewf_index_file_t *index_file,
+     size64_t segment_file_size,
+     libcerror_error_t **error )
+{
+	ewf_index_file_chunk_group_entry_t *chunk_group_entry = NULL;
+	ewf_index_file_section_entry_t *section_entry         = NULL;
+	ewf_index_file_segment_t *segment_record              = NULL;
+	uint8_t *record_data                                  = NULL;
+	static char *function                                 = "libewf_segment_file_write_index_record";
+	size_t record_data_offset                             = 0;
+	size_t record_data_size                               = 0;
+	size64_t element_size                                 = 0;
+	size64_t mapped_size                                  = 0;
+	off64_t element_offset                                = 0;
+	uint32_t element_flags                                = 0;
+	uint32_t last_section_type                            = 0;
+	int element_file_index                                = 0;
+	int element_index                                     = 0;
+	int number_of_chunk_groups                            = 0;
+	int number_of_sections                                = 0;
+
+	if( segment_file == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read segment file header.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment file.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( ( segment_file->type != LIBEWF_SEGMENT_FILE_TYPE_EWF1 )
-	 && ( segment_file->type != LIBEWF_SEGMENT_FILE_TYPE_EWF1_LOGICAL )
-	 && ( segment_file->type != LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART )
-	 && ( segment_file->type != LIBEWF_SEGMENT_FILE_TYPE_EWF2 )
-	 && ( segment_file->type != LIBEWF_SEGMENT_FILE_TYPE_EWF2_LOGICAL ) )
+	if( segment_file->segment_number == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid segment file - segment number value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( segment_file->flags & LIBEWF_SEGMENT_FILE_FLAG_IS_CORRUPTED ) != 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
-		 "%s: unsupported segment file type.",
+		 "%s: unsupported corrupted segment file.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfdata_list_get_number_of_elements(
+	     segment_file->sections_list,
+	     &number_of_sections,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of elements from sections list.",
 		 function );
 
 		goto on_error;
 	}
-	if( ( io_handle->segment_file_type == LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART )
-	 && ( segment_file->type == LIBEWF_SEGMENT_FILE_TYPE_EWF1 ) )
+	if( libfdata_list_get_number_of_elements(
+	     segment_file->chunk_groups_list,
+	     &number_of_chunk_groups,
+	     error ) != 1 )
 	{
-		segment_file->type = LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART;
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of elements from chunk groups list.",
+		 function );
+
+		goto on_error;
 	}
-	else if( ( io_handle->segment_file_type != LIBEWF_SEGMENT_FILE_TYPE_UNDEFINED )
-	      && ( io_handle->segment_file_type != segment_file->type ) )
+	record_data_size = sizeof( ewf_index_file_segment_t )
+	                 + ( (size_t) number_of_sections * sizeof( ewf_index_file_section_entry_t ) )
+	                 + ( (size_t) number_of_chunk_groups * sizeof( ewf_index_file_chunk_group_entry_t ) );
+
+	if( record_data_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_INPUT,
-		 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
-		 "%s: segment file type value mismatch.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid record data size value exceeds maximum.",
+		 function );
+
+		goto on_error;
+	}
+	record_data = (uint8_t *) memory_allocate(
+	                           sizeof( uint8_t ) * record_data_size );
+
+	if( record_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create record data.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     record_data,
+	     0,
+	     sizeof( ewf_index_file_segment_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear record data.",
+		 function );
+
+		goto on_error;
+	}
+	/* The last section of a segment file that is not corrupted is either the next or the done section
+	 */
+	if( ( segment_file->flags & LIBEWF_SEGMENT_FILE_FLAG_IS_LAST ) != 0 )
+	{
+		last_section_type = LIBEWF_SECTION_TYPE_DONE;
+	}
+	else
+	{
+		last_section_type = LIBEWF_SECTION_TYPE_NEXT;
+	}
+	segment_record = (ewf_index_file_segment_t *) record_data;
+
+	byte_stream_copy_from_uint32_little_endian(
+	 segment_record->record_size,
+	 (uint32_t) record_data_size );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 segment_record->segment_number,
+	 segment_file->segment_number );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 segment_record->segment_file_size,
+	 segment_file_size );
+
+	segment_record->segment_file_type = segment_file->type;
+	segment_record->major_version     = segment_file->major_version;
+	segment_record->minor_version     = segment_file->minor_version;
+	segment_record->flags             = segment_file->flags & ( LIBEWF_SEGMENT_FILE_FLAG_IS_LAST | LIBEWF_SEGMENT_FILE_FLAG_IS_ENCRYPTED );
+
+	byte_stream_copy_from_uint16_little_endian(
+	 segment_record->compression_method,
+	 segment_file->compression_method );
+
+	if( memory_copy(
+	     segment_record->set_identifier,
+	     segment_file->set_identifier,
+	     16 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy set identifier.",
 		 function );
 
 		goto on_error;
 	}
-	if( segment_file->major_version == 2 )
+	byte_stream_copy_from_uint64_little_endian(
+	 segment_record->last_section_offset,
+	 (uint64_t) segment_file->last_section_offset );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 segment_record->last_section_type,
+	 last_section_type );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 segment_record->device_information_section_index,
+	 (uint32_t) segment_file->device_information_section_index );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 segment_record->storage_media_size,
+	 segment_file->storage_media_size );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 segment_record->number_of_chunks,
+	 segment_file->number_of_chunks );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 segment_record->last_chunk_filled,
+	 (uint64_t) segment_file->last_chunk_filled );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 segment_record->last_chunk_compared,
+	 (uint64_t) segment_file->last_chunk_compared );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 segment_record->number_of_sections,
+	 (uint32_t) number_of_sections );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 segment_record->number_of_chunk_groups,
+	 (uint32_t) number_of_chunk_groups );
+
+	record_data_offset = sizeof( ewf_index_file_segment_t );
+
+	for( element_index = 0;
+	     element_index < number_of_sections;
+	     element_index++ )
+	{
+		if( libfdata_list_get_element_by_index(
+		     segment_file->sections_list,
+		     element_index,
+		     &element_file_index,
+		     &element_offset,
+		     &element_size,
+		     &element_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve element: %d from sections list.",
+			 function,
+			 element_index );
+
+			goto on_error;
+		}
+		section_entry = (ewf_index_file_section_entry_t *) &( record_data[ record_data_offset ] );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 section_entry->offset,
+		 (uint64_t) element_offset );
+
+		record_data_offset += sizeof( ewf_index_file_section_entry_t );
+	}
+	for( element_index = 0;
+	     element_index < number_of_chunk_groups;
+	     element_index++ )
+	{
+		if( libfdata_list_get_element_by_index_with_mapped_size(
+		     segment_file->chunk_groups_list,
+		     element_index,
+		     &element_file_index,
+		     &element_offset,
+		     &element_size,
+		     &element_flags,
+		     &mapped_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve element: %d from chunk groups list.",
+			 function,
+			 element_index );
+
+			goto on_error;
+		}
+		chunk_group_entry = (ewf_index_file_chunk_group_entry_t *) &( record_data[ record_data_offset ] );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 chunk_group_entry->data_offset,
+		 (uint64_t) element_offset );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 chunk_group_entry->data_size,
+		 element_size );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 chunk_group_entry->mapped_size,
+		 mapped_size );
+
+		byte_stream_copy_from_uint32_little_endian(
+		 chunk_group_entry->range_flags,
+		 element_flags );
+
+		byte_stream_copy_from_uint32_little_endian(
+		 chunk_group_entry->padding,
+		 0 );
+
+		record_data_offset += sizeof( ewf_index_file_chunk_group_entry_t );
+	}
+	if( libewf_index_file_set_segment_record(
+	     index_file,
+	     segment_file->segment_number - 1,
+	     record_data,
+	     record_data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set segment: %" PRIu32 " record in index file.",
+		 function,
+		 segment_file->segment_number );
+
+		goto on_error;
+	}
+	memory_free(
+	 record_data );
+
+	return( 1 );
+
+on_error:
+	if( record_data != NULL )
+	{
+		memory_free(
+		 record_data );
+	}
+	return( -1 );
+}
+
+/* Reads the section descriptors and the table sections of a segment file
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_file_read_sections_file_io_pool(
+     libewf_segment_file_t *segment_file,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     size_t file_header_size,
+     size64_t segment_file_size,
+     libcerror_error_t **error )
+{
+	libewf_section_descriptor_t *section_descriptor = NULL;
+	libfcache_cache_t *sections_cache               = NULL;
+	static char *function                           = "libewf_segment_file_read_sections_file_io_pool";
+	ssize_t read_count                              = 0;
+	off64_t section_data_offset                     = 0;
+	off64_t segment_file_offset                     = 0;
+	int element_index                               = 0;
+	int last_section                                = 0;
+	int number_of_sections                          = 0;
+	int result                                      = 0;
+	int section_index                               = 0;
+
+	if( segment_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment file.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_file->io_handle == NULL )
 	{
-		if( ( segment_file->compression_method != LIBEWF_COMPRESSION_METHOD_DEFLATE )
-		 && ( segment_file->compression_method != LIBEWF_COMPRESSION_METHOD_BZIP2 ) )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-			 "%s: unsupported compression method.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid segment file - missing IO handle.",
+		 function );
 
-			goto on_error;
-		}
+		return( -1 );
 	}
 	/* Read the section descriptors:
 	 * EWF version 1 read from front to back
@@ -6266,7 +6871,7 @@ int libewf_segment_file_read_element_data(
 	 */
 	if( segment_file->major_version == 1 )
 	{
-		segment_file_offset = (off64_t) read_count;
+		segment_file_offset = (off64_t) file_header_size;
 	}
 	else if( segment_file->major_version == 2 )
 	{
@@ -6499,7 +7104,7 @@ int libewf_segment_file_read_element_data(
 			                                               - segment_file->device_information_section_index;
 		}
 	}
-	if( io_handle->chunk_size != 0 )
+	if( segment_file->io_handle->chunk_size != 0 )
 	{
 		if( libfcache_cache_initialize(
 		     &sections_cache,
@@ -6593,7 +7198,7 @@ int libewf_segment_file_read_element_data(
 					      section_descriptor,
 					      file_io_pool,
 					      file_io_pool_entry,
-					      io_handle->chunk_size,
+					      segment_file->io_handle->chunk_size,
 					      error );
 
 				if( read_count == -1 )
@@ -6686,6 +7291,261 @@ int libewf_segment_file_read_element_data(
 			goto on_error;
 		}
 	}
+	return( 1 );
+
+on_error:
+	if( sections_cache != NULL )
+	{
+		libfcache_cache_free(
+		 &sections_cache,
+		 NULL );
+	}
+	if( section_descriptor != NULL )
+	{
+		libewf_section_descriptor_free(
+		 &section_descriptor,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads a segment file
+ * Reads the file header and the sections and chunk groups of the segment file
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_file_read_file_io_pool(
+     libewf_segment_file_t *segment_file,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     size64_t segment_file_size,
+     libcerror_error_t **error )
+{
+	libewf_io_handle_t *io_handle = NULL;
+	static char *function         = "libewf_segment_file_read_file_io_pool";
+	ssize_t read_count            = 0;
+	int result                    = 0;
+
+	if( segment_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment file.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_file->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid segment file - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	io_handle = segment_file->io_handle;
+
+	if( segment_file_size == 0 )
+	{
+		/* segment_file_size is 0 on write correction
+		 */
+		if( libbfio_pool_get_size(
+		     file_io_pool,
+		     file_io_pool_entry,
+		     &segment_file_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment file size.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	read_count = libewf_segment_file_read_file_header_file_io_pool(
+		      segment_file,
+		      file_io_pool,
+		      file_io_pool_entry,
+		      error );
+
+/* TODO deal with corrupted header ? */
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read segment file header.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( segment_file->type != LIBEWF_SEGMENT_FILE_TYPE_EWF1 )
+	 && ( segment_file->type != LIBEWF_SEGMENT_FILE_TYPE_EWF1_LOGICAL )
+	 && ( segment_file->type != LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART )
+	 && ( segment_file->type != LIBEWF_SEGMENT_FILE_TYPE_EWF2 )
+	 && ( segment_file->type != LIBEWF_SEGMENT_FILE_TYPE_EWF2_LOGICAL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported segment file type.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( io_handle->segment_file_type == LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART )
+	 && ( segment_file->type == LIBEWF_SEGMENT_FILE_TYPE_EWF1 ) )
+	{
+		segment_file->type = LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART;
+	}
+	else if( ( io_handle->segment_file_type != LIBEWF_SEGMENT_FILE_TYPE_UNDEFINED )
+	      && ( io_handle->segment_file_type != segment_file->type ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_INPUT,
+		 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
+		 "%s: segment file type value mismatch.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_file->major_version == 2 )
+	{
+		if( ( segment_file->compression_method != LIBEWF_COMPRESSION_METHOD_DEFLATE )
+		 && ( segment_file->compression_method != LIBEWF_COMPRESSION_METHOD_BZIP2 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported compression method.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	/* The index file, if available, provides the sections and chunk groups
+	 * without having to scan the section descriptors and table sections
+	 */
+	if( io_handle->index_file != NULL )
+	{
+		result = libewf_segment_file_read_index_record(
+		          segment_file,
+		          io_handle->index_file,
+		          file_io_pool,
+		          file_io_pool_entry,
+		          segment_file_size,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read index record.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( result == 0 )
+	{
+		if( libewf_segment_file_read_sections_file_io_pool(
+		     segment_file,
+		     file_io_pool,
+		     file_io_pool_entry,
+		     (size_t) read_count,
+		     segment_file_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read sections.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Reads a segment file
+ * Callback function for the segment files list
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_file_read_element_data(
+     libewf_io_handle_t *io_handle,
+     libbfio_pool_t *file_io_pool,
+     libfdata_list_element_t *element,
+     libfdata_cache_t *segment_file_cache,
+     int file_io_pool_entry,
+     off64_t segment_file_offset LIBEWF_ATTRIBUTE_UNUSED,
+     size64_t segment_file_size,
+     uint32_t element_flags LIBEWF_ATTRIBUTE_UNUSED,
+     uint8_t read_flags LIBEWF_ATTRIBUTE_UNUSED,
+     libcerror_error_t **error )
+{
+	libewf_segment_file_t *segment_file = NULL;
+	static char *function               = "libewf_segment_file_read_element_data";
+
+	LIBEWF_UNREFERENCED_PARAMETER( segment_file_offset )
+	LIBEWF_UNREFERENCED_PARAMETER( element_flags )
+	LIBEWF_UNREFERENCED_PARAMETER( read_flags )
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_segment_file_initialize(
+	     &segment_file,
+	     io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create segment file.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_segment_file_read_file_io_pool(
+	     segment_file,
+	     file_io_pool,
+	     file_io_pool_entry,
+	     segment_file_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read segment file.",
+		 function );
+
+		goto on_error;
+	}
 	if( libfdata_list_element_set_element_value(
 	     element,
 	     (intptr_t *) file_io_pool,
@@ -6707,18 +7567,6 @@ int libewf_segment_file_read_element_data(
 	return( 1 );
 
 on_error:
-	if( sections_cache != NULL )
-	{
-		libfcache_cache_free(
-		 &sections_cache,
-		 NULL );
-	}
-	if( section_descriptor != NULL )
-	{
-		libewf_section_descriptor_free(
-		 &section_descriptor,
-		 NULL );
-	}
 	if( segment_file != NULL )
 	{
 		libewf_segment_file_free(
@@ -0,0 +1,336 @@
+/*
+ * Segment file job functions
+ *
+ * Copyright (C) 2006-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_io_handle.h"
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+#include "libewf_segment_file.h"
+#include "libewf_segment_file_job.h"
+
+/* Creates a segment file job
+ * Make sure the value segment_file_job is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_file_job_initialize(
+     libewf_segment_file_job_t **segment_file_job,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_segment_file_job_initialize";
+
+	if( segment_file_job == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment file job.",
+		 function );
+
+		return( -1 );
+	}
+	if( *segment_file_job != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid segment file job value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*segment_file_job = memory_allocate_structure(
+	                     libewf_segment_file_job_t );
+
+	if( *segment_file_job == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create segment file job.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *segment_file_job,
+	     0,
+	     sizeof( libewf_segment_file_job_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear segment file job.",
+		 function );
+
+		goto on_error;
+	}
+	( *segment_file_job )->file_io_pool_entry = -1;
+
+	return( 1 );
+
+on_error:
+	if( *segment_file_job != NULL )
+	{
+		memory_free(
+		 *segment_file_job );
+
+		*segment_file_job = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a segment file job
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_file_job_free(
+     libewf_segment_file_job_t **segment_file_job,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_segment_file_job_free";
+	int result            = 1;
+
+	if( segment_file_job == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment file job.",
+		 function );
+
+		return( -1 );
+	}
+	if( *segment_file_job != NULL )
+	{
+		/* The file_io_handle reference is freed elsewhere
+		 */
+		if( ( *segment_file_job )->segment_file != NULL )
+		{
+			if( libewf_segment_file_free(
+			     &( ( *segment_file_job )->segment_file ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free segment file.",
+				 function );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 *segment_file_job );
+
+		*segment_file_job = NULL;
+	}
+	return( result );
+}
+
+/* Runs a segment file job
+ * Reads the segment file using a clone of the file IO handle, so that the job
+ * does not share file offsets with the file IO pool of the handle
+ * The clone is stored in a file IO pool of its own at the same entry, hence
+ * the segment file can be used with the file IO pool of the handle afterwards
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_file_job_run(
+     libewf_segment_file_job_t *segment_file_job,
+     libewf_io_handle_t *io_handle,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle    = NULL;
+	libbfio_pool_t *file_io_pool        = NULL;
+	libewf_segment_file_t *segment_file = NULL;
+	static char *function               = "libewf_segment_file_job_run";
+
+	if( segment_file_job == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment file job.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_file_job->file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid segment file job - missing file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_file_job->file_io_pool_entry < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid segment file job - file IO pool entry value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_file_job->segment_file != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid segment file job - segment file value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_handle_clone(
+	     &file_io_handle,
+	     segment_file_job->file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_pool_initialize(
+	     &file_io_pool,
+	     segment_file_job->file_io_pool_entry + 1,
+	     LIBBFIO_POOL_UNLIMITED_NUMBER_OF_OPEN_HANDLES,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO pool.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_pool_set_handle(
+	     file_io_pool,
+	     segment_file_job->file_io_pool_entry,
+	     file_io_handle,
+	     LIBBFIO_OPEN_READ,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set file IO handle: %d in pool.",
+		 function,
+		 segment_file_job->file_io_pool_entry );
+
+		goto on_error;
+	}
+	/* The file IO pool now manages the file IO handle
+	 */
+	file_io_handle = NULL;
+
+	if( libewf_segment_file_initialize(
+	     &segment_file,
+	     io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create segment file.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_segment_file_read_file_io_pool(
+	     segment_file,
+	     file_io_pool,
+	     segment_file_job->file_io_pool_entry,
+	     segment_file_job->segment_file_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read segment file: %" PRIu32 ".",
+		 function,
+		 segment_file_job->segment_index );
+
+		goto on_error;
+	}
+	if( libbfio_pool_free(
+	     &file_io_pool,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file IO pool.",
+		 function );
+
+		goto on_error;
+	}
+	segment_file_job->segment_file = segment_file;
+
+	return( 1 );
+
+on_error:
+	if( segment_file != NULL )
+	{
+		libewf_segment_file_free(
+		 &segment_file,
+		 NULL );
+	}
+	if( file_io_pool != NULL )
+	{
+		libbfio_pool_free(
+		 &file_io_pool,
+		 NULL );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
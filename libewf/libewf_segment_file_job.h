@@ -0,0 +1,88 @@
+/*
+ * Segment file job functions
+ *
+ * Copyright (C) 2006-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_SEGMENT_FILE_JOB_H )
+#define _LIBEWF_SEGMENT_FILE_JOB_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_io_handle.h"
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+#include "libewf_segment_file.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libewf_segment_file_job libewf_segment_file_job_t;
+
+/* The segment file job reads the file header, sections and chunk groups
+ * of a single segment file using a clone of its file IO handle
+ */
+struct libewf_segment_file_job
+{
+	/* The segment index
+	 */
+	uint32_t segment_index;
+
+	/* The file IO pool entry
+	 */
+	int file_io_pool_entry;
+
+	/* The segment file size
+	 */
+	size64_t segment_file_size;
+
+	/* The file IO handle of the segment file
+	 * The file IO handle is not managed by the job
+	 */
+	libbfio_handle_t *file_io_handle;
+
+	/* The segment file
+	 */
+	libewf_segment_file_t *segment_file;
+
+	/* The result of the job
+	 */
+	int result;
+};
+
+int libewf_segment_file_job_initialize(
+     libewf_segment_file_job_t **segment_file_job,
+     libcerror_error_t **error );
+
+int libewf_segment_file_job_free(
+     libewf_segment_file_job_t **segment_file_job,
+     libcerror_error_t **error );
+
+int libewf_segment_file_job_run(
+     libewf_segment_file_job_t *segment_file_job,
+     libewf_io_handle_t *io_handle,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_SEGMENT_FILE_JOB_H ) */
+
@@ -173,6 +173,13 @@ int libewf_segment_table_get_segment_file_by_index(
      libewf_segment_file_t **segment_file,
      libcerror_error_t **error );
 
+int libewf_segment_table_set_segment_file_by_index(
+     libewf_segment_table_t *segment_table,
+     uint32_t segment_number,
+     libbfio_pool_t *file_io_pool,
+     libewf_segment_file_t *segment_file,
+     libcerror_error_t **error );
+
 int libewf_segment_table_get_segment_file_at_offset(
      libewf_segment_table_t *segment_table,
      off64_t offset,
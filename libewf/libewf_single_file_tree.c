@@ -25,10 +25,13 @@
 #include "libewf_lef_file_entry.h"
 #include "libewf_libcdata.h"
 #include "libewf_libcerror.h"
+#include "libewf_libcnotify.h"
 #include "libewf_libuna.h"
 #include "libewf_single_file_tree.h"
+#include "libewf_sub_node_index.h"
 
 /* Retrieves the file entry sub node for the specific UTF-8 formatted name
+ * The sub node (name) index of the node is used if available
  * Returns 1 if successful, 0 in no such value or -1 on error
  */
 int libewf_single_file_tree_get_sub_node_by_utf8_name(
@@ -40,6 +43,7 @@ int libewf_single_file_tree_get_sub_node_by_utf8_name(
      libcerror_error_t **error )
 {
 	libcdata_tree_node_t *safe_sub_node              = NULL;
+	libewf_lef_file_entry_t *lef_file_entry          = NULL;
 	libewf_lef_file_entry_t *safe_sub_lef_file_entry = NULL;
 	static char *function                            = "libewf_single_file_tree_get_sub_node_by_utf8_name";
 	int compare_result                               = LIBUNA_COMPARE_GREATER;
@@ -83,6 +87,72 @@ int libewf_single_file_tree_get_sub_node_by_utf8_name(
 	*sub_node           = NULL;
 	*sub_lef_file_entry = NULL;
 
+	if( libcdata_tree_node_get_value(
+	     node,
+	     (intptr_t **) &lef_file_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve value from node.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( lef_file_entry != NULL )
+	 && ( lef_file_entry->sub_node_index != NULL ) )
+	{
+		result = libewf_sub_node_index_get_sub_node_by_utf8_name(
+		          lef_file_entry->sub_node_index,
+		          node,
+		          utf8_string,
+		          utf8_string_length,
+		          &safe_sub_node,
+		          error );
+
+		if( result != -1 )
+		{
+			if( result != 0 )
+			{
+				if( libcdata_tree_node_get_value(
+				     safe_sub_node,
+				     (intptr_t **) &safe_sub_lef_file_entry,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve value from sub node.",
+					 function );
+
+					return( -1 );
+				}
+				*sub_node           = safe_sub_node;
+				*sub_lef_file_entry = safe_sub_lef_file_entry;
+			}
+			return( result );
+		}
+		/* Fall back to comparing the names of the sub nodes one by one
+		 */
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			if( ( error != NULL )
+			 && ( *error != NULL ) )
+			{
+				libcnotify_print_error_backtrace(
+				 *error );
+			}
+		}
+#endif
+		libcerror_error_free(
+		 error );
+
+		result = 0;
+	}
 	if( libcdata_tree_node_get_number_of_sub_nodes(
 	     node,
 	     &number_of_sub_nodes,
@@ -189,6 +259,7 @@ int libewf_single_file_tree_get_sub_node_by_utf8_name(
 }
 
 /* Retrieves the file entry sub node for the specific UTF-16 formatted name
+ * The sub node (name) index of the node is used if available
  * Returns 1 if successful, 0 in no such value or -1 on error
  */
 int libewf_single_file_tree_get_sub_node_by_utf16_name(
@@ -200,6 +271,7 @@ int libewf_single_file_tree_get_sub_node_by_utf16_name(
      libcerror_error_t **error )
 {
 	libcdata_tree_node_t *safe_sub_node              = NULL;
+	libewf_lef_file_entry_t *lef_file_entry          = NULL;
 	libewf_lef_file_entry_t *safe_sub_lef_file_entry = NULL;
 	static char *function                            = "libewf_single_file_tree_get_sub_node_by_utf16_name";
 	int compare_result                               = LIBUNA_COMPARE_GREATER;
@@ -243,6 +315,72 @@ int libewf_single_file_tree_get_sub_node_by_utf16_name(
 	*sub_node           = NULL;
 	*sub_lef_file_entry = NULL;
 
+	if( libcdata_tree_node_get_value(
+	     node,
+	     (intptr_t **) &lef_file_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve value from node.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( lef_file_entry != NULL )
+	 && ( lef_file_entry->sub_node_index != NULL ) )
+	{
+		result = libewf_sub_node_index_get_sub_node_by_utf16_name(
+		          lef_file_entry->sub_node_index,
+		          node,
+		          utf16_string,
+		          utf16_string_length,
+		          &safe_sub_node,
+		          error );
+
+		if( result != -1 )
+		{
+			if( result != 0 )
+			{
+				if( libcdata_tree_node_get_value(
+				     safe_sub_node,
+				     (intptr_t **) &safe_sub_lef_file_entry,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve value from sub node.",
+					 function );
+
+					return( -1 );
+				}
+				*sub_node           = safe_sub_node;
+				*sub_lef_file_entry = safe_sub_lef_file_entry;
+			}
+			return( result );
+		}
+		/* Fall back to comparing the names of the sub nodes one by one
+		 */
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			if( ( error != NULL )
+			 && ( *error != NULL ) )
+			{
+				libcnotify_print_error_backtrace(
+				 *error );
+			}
+		}
+#endif
+		libcerror_error_free(
+		 error );
+
+		result = 0;
+	}
 	if( libcdata_tree_node_get_number_of_sub_nodes(
 	     node,
 	     &number_of_sub_nodes,
@@ -36,6 +36,7 @@
 #include "libewf_libuna.h"
 #include "libewf_permission_group.h"
 #include "libewf_single_files.h"
+#include "libewf_sub_node_index.h"
 
 /* Creates single files
  * Make sure the value single_files is referencing, is set to NULL
@@ -3157,6 +3158,26 @@ int libewf_single_files_parse_file_entry(
 
 		goto on_error;
 	}
+	/* The sub node index is built on the first lookup by name, it is created
+	 * here while the file entry tree is not yet shared between threads
+	 */
+	if( ( number_of_sub_entries >= LIBEWF_SUB_NODE_INDEX_MINIMUM_NUMBER_OF_SUB_NODES )
+	 && ( number_of_sub_entries <= LIBEWF_SUB_NODE_INDEX_MAXIMUM_NUMBER_OF_SUB_NODES ) )
+	{
+		if( libewf_sub_node_index_initialize(
+		     &( lef_file_entry->sub_node_index ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create sub node index.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	if( libcdata_tree_node_set_value(
 	     parent_file_entry_node,
 	     (intptr_t *) lef_file_entry,
@@ -0,0 +1,976 @@
+/*
+ * Sub node (name) index functions
+ *
+ * Copyright (C) 2006-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_definitions.h"
+#include "libewf_lef_file_entry.h"
+#include "libewf_libcdata.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+#include "libewf_libuna.h"
+#include "libewf_serialized_string.h"
+#include "libewf_sub_node_index.h"
+
+/* Creates a sub node index
+ * Make sure the value sub_node_index is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_sub_node_index_initialize(
+     libewf_sub_node_index_t **sub_node_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_sub_node_index_initialize";
+
+	if( sub_node_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sub node index.",
+		 function );
+
+		return( -1 );
+	}
+	if( *sub_node_index != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid sub node index value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*sub_node_index = memory_allocate_structure(
+	                   libewf_sub_node_index_t );
+
+	if( *sub_node_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create sub node index.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *sub_node_index,
+	     0,
+	     sizeof( libewf_sub_node_index_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear sub node index.",
+		 function );
+
+		memory_free(
+		 *sub_node_index );
+
+		*sub_node_index = NULL;
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *sub_node_index )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	return( 1 );
+
+on_error:
+	if( *sub_node_index != NULL )
+	{
+		memory_free(
+		 *sub_node_index );
+
+		*sub_node_index = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a sub node index
+ * The sub nodes are referenced by the index and are not freed
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_sub_node_index_free(
+     libewf_sub_node_index_t **sub_node_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_sub_node_index_free";
+	int result            = 1;
+
+	if( sub_node_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sub node index.",
+		 function );
+
+		return( -1 );
+	}
+	if( *sub_node_index != NULL )
+	{
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_free(
+		     &( ( *sub_node_index )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		if( ( *sub_node_index )->sub_nodes != NULL )
+		{
+			memory_free(
+			 ( *sub_node_index )->sub_nodes );
+		}
+		if( ( *sub_node_index )->hashes != NULL )
+		{
+			memory_free(
+			 ( *sub_node_index )->hashes );
+		}
+		memory_free(
+		 *sub_node_index );
+
+		*sub_node_index = NULL;
+	}
+	return( result );
+}
+
+/* Calculates the name hash of an UTF-8 stream
+ * The name is hashed per Unicode character using 32-bit FNV-1a so that
+ * the UTF-8 and UTF-16 string representations of a name have the same hash
+ * A byte order mark and end-of-string character are ignored like
+ * libuna_utf8_string_compare_with_utf8_stream does
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_sub_node_index_get_utf8_stream_hash(
+     const uint8_t *utf8_stream,
+     size_t utf8_stream_size,
+     uint32_t *hash,
+     libcerror_error_t **error )
+{
+	static char *function                        = "libewf_sub_node_index_get_utf8_stream_hash";
+	libuna_unicode_character_t unicode_character = 0;
+	size_t utf8_stream_index                     = 0;
+	uint32_t safe_hash                           = 0x811c9dc5UL;
+
+	if( utf8_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid UTF-8 stream.",
+		 function );
+
+		return( -1 );
+	}
+	if( utf8_stream_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid UTF-8 stream size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash.",
+		 function );
+
+		return( -1 );
+	}
+	if( utf8_stream_size >= 3 )
+	{
+		if( ( utf8_stream[ 0 ] == 0x0ef )
+		 && ( utf8_stream[ 1 ] == 0x0bb )
+		 && ( utf8_stream[ 2 ] == 0x0bf ) )
+		{
+			utf8_stream_index += 3;
+		}
+	}
+	if( ( utf8_stream_size >= 1 )
+	 && ( utf8_stream[ utf8_stream_size - 1 ] == 0 ) )
+	{
+		utf8_stream_size -= 1;
+	}
+	while( utf8_stream_index < utf8_stream_size )
+	{
+		if( libuna_unicode_character_copy_from_utf8(
+		     &unicode_character,
+		     utf8_stream,
+		     utf8_stream_size,
+		     &utf8_stream_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+			 LIBCERROR_CONVERSION_ERROR_INPUT_FAILED,
+			 "%s: unable to copy Unicode character from UTF-8 stream.",
+			 function );
+
+			return( -1 );
+		}
+		safe_hash ^= (uint32_t) unicode_character;
+		safe_hash *= 0x01000193UL;
+	}
+	*hash = safe_hash;
+
+	return( 1 );
+}
+
+/* Calculates the name hash of an UTF-8 string
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_sub_node_index_get_utf8_string_hash(
+     const uint8_t *utf8_string,
+     size_t utf8_string_length,
+     uint32_t *hash,
+     libcerror_error_t **error )
+{
+	static char *function                        = "libewf_sub_node_index_get_utf8_string_hash";
+	libuna_unicode_character_t unicode_character = 0;
+	size_t utf8_string_index                     = 0;
+	uint32_t safe_hash                           = 0x811c9dc5UL;
+
+	if( utf8_string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid UTF-8 string.",
+		 function );
+
+		return( -1 );
+	}
+	if( utf8_string_length > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid UTF-8 string length value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( utf8_string_length >= 1 )
+	 && ( utf8_string[ utf8_string_length - 1 ] == 0 ) )
+	{
+		utf8_string_length -= 1;
+	}
+	while( utf8_string_index < utf8_string_length )
+	{
+		if( libuna_unicode_character_copy_from_utf8(
+		     &unicode_character,
+		     utf8_string,
+		     utf8_string_length,
+		     &utf8_string_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+			 LIBCERROR_CONVERSION_ERROR_INPUT_FAILED,
+			 "%s: unable to copy Unicode character from UTF-8 string.",
+			 function );
+
+			return( -1 );
+		}
+		safe_hash ^= (uint32_t) unicode_character;
+		safe_hash *= 0x01000193UL;
+	}
+	*hash = safe_hash;
+
+	return( 1 );
+}
+
+/* Calculates the name hash of an UTF-16 string
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_sub_node_index_get_utf16_string_hash(
+     const uint16_t *utf16_string,
+     size_t utf16_string_length,
+     uint32_t *hash,
+     libcerror_error_t **error )
+{
+	static char *function                        = "libewf_sub_node_index_get_utf16_string_hash";
+	libuna_unicode_character_t unicode_character = 0;
+	size_t utf16_string_index                    = 0;
+	uint32_t safe_hash                           = 0x811c9dc5UL;
+
+	if( utf16_string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid UTF-16 string.",
+		 function );
+
+		return( -1 );
+	}
+	if( utf16_string_length > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid UTF-16 string length value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( utf16_string_length >= 1 )
+	 && ( utf16_string[ utf16_string_length - 1 ] == 0 ) )
+	{
+		utf16_string_length -= 1;
+	}
+	while( utf16_string_index < utf16_string_length )
+	{
+		if( libuna_unicode_character_copy_from_utf16(
+		     &unicode_character,
+		     utf16_string,
+		     utf16_string_length,
+		     &utf16_string_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+			 LIBCERROR_CONVERSION_ERROR_INPUT_FAILED,
+			 "%s: unable to copy Unicode character from UTF-16 string.",
+			 function );
+
+			return( -1 );
+		}
+		safe_hash ^= (uint32_t) unicode_character;
+		safe_hash *= 0x01000193UL;
+	}
+	*hash = safe_hash;
+
+	return( 1 );
+}
+
+/* Builds the sub node index from the sub nodes of a (file entry tree) node
+ * The index is built once, subsequent calls return the previous result
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_sub_node_index_build(
+     libewf_sub_node_index_t *sub_node_index,
+     libcdata_tree_node_t *node,
+     libcerror_error_t **error )
+{
+	libcdata_tree_node_t *sub_node          = NULL;
+	libewf_lef_file_entry_t *lef_file_entry = NULL;
+	static char *function                   = "libewf_sub_node_index_build";
+	size_t slots_size                       = 0;
+	uint32_t hash                           = 0;
+	uint32_t number_of_slots                = 0;
+	uint32_t slot_index                     = 0;
+	int number_of_sub_nodes                 = 0;
+	int sub_node_number                     = 0;
+
+	if( sub_node_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sub node index.",
+		 function );
+
+		return( -1 );
+	}
+	if( node == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid node.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     sub_node_index->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( sub_node_index->build_failed != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid sub node index - build previously failed.",
+		 function );
+
+		goto on_error;
+	}
+	if( sub_node_index->is_built == 0 )
+	{
+		if( libcdata_tree_node_get_number_of_sub_nodes(
+		     node,
+		     &number_of_sub_nodes,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of sub nodes.",
+			 function );
+
+			goto on_error;
+		}
+		if( ( number_of_sub_nodes < 0 )
+		 || ( number_of_sub_nodes > (int) LIBEWF_SUB_NODE_INDEX_MAXIMUM_NUMBER_OF_SUB_NODES ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid number of sub nodes value out of bounds.",
+			 function );
+
+			goto on_error;
+		}
+		/* Keep at least half of the slots empty so that probe sequences remain short
+		 */
+		number_of_slots = 32;
+
+		while( number_of_slots < ( 2 * (uint32_t) number_of_sub_nodes ) )
+		{
+			number_of_slots <<= 1;
+		}
+		slots_size = sizeof( uint32_t ) * number_of_slots;
+
+		sub_node_index->hashes = (uint32_t *) memory_allocate(
+		                                       slots_size );
+
+		if( sub_node_index->hashes == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create hashes.",
+			 function );
+
+			goto on_error;
+		}
+		slots_size = sizeof( libcdata_tree_node_t * ) * number_of_slots;
+
+		sub_node_index->sub_nodes = (libcdata_tree_node_t **) memory_allocate(
+		                                                       slots_size );
+
+		if( sub_node_index->sub_nodes == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create sub nodes.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_set(
+		     sub_node_index->sub_nodes,
+		     0,
+		     slots_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear sub nodes.",
+			 function );
+
+			goto on_error;
+		}
+		sub_node_index->number_of_slots = number_of_slots;
+
+		if( number_of_sub_nodes > 0 )
+		{
+			if( libcdata_tree_node_get_sub_node_by_index(
+			     node,
+			     0,
+			     &sub_node,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve first sub node.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		/* The sub nodes are added in order so that the probe sequence
+		 * of a name returns the first sub node with that name
+		 */
+		for( sub_node_number = 0;
+		     sub_node_number < number_of_sub_nodes;
+		     sub_node_number++ )
+		{
+			if( libcdata_tree_node_get_value(
+			     sub_node,
+			     (intptr_t **) &lef_file_entry,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve value from sub node: %d.",
+				 function,
+				 sub_node_number );
+
+				goto on_error;
+			}
+			if( lef_file_entry == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+				 "%s: missing sub file entry: %d.",
+				 function,
+				 sub_node_number );
+
+				goto on_error;
+			}
+			/* A sub node without name data never matches and is not indexed
+			 */
+			if( ( lef_file_entry->name != NULL )
+			 && ( lef_file_entry->name->data != NULL )
+			 && ( lef_file_entry->name->data_size > 0 ) )
+			{
+				if( libewf_sub_node_index_get_utf8_stream_hash(
+				     lef_file_entry->name->data,
+				     lef_file_entry->name->data_size,
+				     &hash,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve name hash of sub node: %d.",
+					 function,
+					 sub_node_number );
+
+					goto on_error;
+				}
+				slot_index = hash & ( number_of_slots - 1 );
+
+				while( sub_node_index->sub_nodes[ slot_index ] != NULL )
+				{
+					slot_index = ( slot_index + 1 ) & ( number_of_slots - 1 );
+				}
+				sub_node_index->hashes[ slot_index ]    = hash;
+				sub_node_index->sub_nodes[ slot_index ] = sub_node;
+			}
+			if( libcdata_tree_node_get_next_node(
+			     sub_node,
+			     &sub_node,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve next node from sub node: %d.",
+				 function,
+				 sub_node_number );
+
+				goto on_error;
+			}
+		}
+		sub_node_index->is_built = 1;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     sub_node_index->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+
+on_error:
+	if( sub_node_index->is_built == 0 )
+	{
+		if( sub_node_index->sub_nodes != NULL )
+		{
+			memory_free(
+			 sub_node_index->sub_nodes );
+
+			sub_node_index->sub_nodes = NULL;
+		}
+		if( sub_node_index->hashes != NULL )
+		{
+			memory_free(
+			 sub_node_index->hashes );
+
+			sub_node_index->hashes = NULL;
+		}
+		sub_node_index->number_of_slots = 0;
+		sub_node_index->build_failed    = 1;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libcthreads_mutex_release(
+	 sub_node_index->mutex,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Retrieves the sub node for the specific UTF-8 formatted name
+ * The index is built on first use
+ * Returns 1 if successful, 0 if no such sub node or -1 on error
+ */
+int libewf_sub_node_index_get_sub_node_by_utf8_name(
+     libewf_sub_node_index_t *sub_node_index,
+     libcdata_tree_node_t *node,
+     const uint8_t *utf8_string,
+     size_t utf8_string_length,
+     libcdata_tree_node_t **sub_node,
+     libcerror_error_t **error )
+{
+	libewf_lef_file_entry_t *lef_file_entry = NULL;
+	static char *function                   = "libewf_sub_node_index_get_sub_node_by_utf8_name";
+	uint32_t hash                           = 0;
+	uint32_t slot_index                     = 0;
+	int compare_result                      = 0;
+
+	if( sub_node_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sub node index.",
+		 function );
+
+		return( -1 );
+	}
+	if( sub_node == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sub node.",
+		 function );
+
+		return( -1 );
+	}
+	*sub_node = NULL;
+
+	if( libewf_sub_node_index_build(
+	     sub_node_index,
+	     node,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to build sub node index.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_sub_node_index_get_utf8_string_hash(
+	     utf8_string,
+	     utf8_string_length,
+	     &hash,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve UTF-8 string hash.",
+		 function );
+
+		return( -1 );
+	}
+	/* The slots are not modified after the index was built
+	 * and can be read without holding the mutex
+	 */
+	slot_index = hash & ( sub_node_index->number_of_slots - 1 );
+
+	while( sub_node_index->sub_nodes[ slot_index ] != NULL )
+	{
+		if( sub_node_index->hashes[ slot_index ] == hash )
+		{
+			if( libcdata_tree_node_get_value(
+			     sub_node_index->sub_nodes[ slot_index ],
+			     (intptr_t **) &lef_file_entry,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve value from sub node in slot: %" PRIu32 ".",
+				 function,
+				 slot_index );
+
+				return( -1 );
+			}
+			compare_result = libewf_serialized_string_compare_with_utf8_string(
+			                  lef_file_entry->name,
+			                  utf8_string,
+			                  utf8_string_length,
+			                  error );
+
+			if( compare_result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to compare name with UTF-8 string.",
+				 function );
+
+				return( -1 );
+			}
+			else if( compare_result == LIBUNA_COMPARE_EQUAL )
+			{
+				*sub_node = sub_node_index->sub_nodes[ slot_index ];
+
+				return( 1 );
+			}
+		}
+		slot_index = ( slot_index + 1 ) & ( sub_node_index->number_of_slots - 1 );
+	}
+	return( 0 );
+}
+
+/* Retrieves the sub node for the specific UTF-16 formatted name
+ * The index is built on first use
+ * Returns 1 if successful, 0 if no such sub node or -1 on error
+ */
+int libewf_sub_node_index_get_sub_node_by_utf16_name(
+     libewf_sub_node_index_t *sub_node_index,
+     libcdata_tree_node_t *node,
+     const uint16_t *utf16_string,
+     size_t utf16_string_length,
+     libcdata_tree_node_t **sub_node,
+     libcerror_error_t **error )
+{
+	libewf_lef_file_entry_t *lef_file_entry = NULL;
+	static char *function                   = "libewf_sub_node_index_get_sub_node_by_utf16_name";
+	uint32_t hash                           = 0;
+	uint32_t slot_index                     = 0;
+	int compare_result                      = 0;
+
+	if( sub_node_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sub node index.",
+		 function );
+
+		return( -1 );
+	}
+	if( sub_node == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sub node.",
+		 function );
+
+		return( -1 );
+	}
+	*sub_node = NULL;
+
+	if( libewf_sub_node_index_build(
+	     sub_node_index,
+	     node,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to build sub node index.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_sub_node_index_get_utf16_string_hash(
+	     utf16_string,
+	     utf16_string_length,
+	     &hash,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve UTF-16 string hash.",
+		 function );
+
+		return( -1 );
+	}
+	/* The slots are not modified after the index was built
+	 * and can be read without holding the mutex
+	 */
+	slot_index = hash & ( sub_node_index->number_of_slots - 1 );
+
+	while( sub_node_index->sub_nodes[ slot_index ] != NULL )
+	{
+		if( sub_node_index->hashes[ slot_index ] == hash )
+		{
+			if( libcdata_tree_node_get_value(
+			     sub_node_index->sub_nodes[ slot_index ],
+			     (intptr_t **) &lef_file_entry,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve value from sub node in slot: %" PRIu32 ".",
+				 function,
+				 slot_index );
+
+				return( -1 );
+			}
+			compare_result = libewf_serialized_string_compare_with_utf16_string(
+			                  lef_file_entry->name,
+			                  utf16_string,
+			                  utf16_string_length,
+			                  error );
+
+			if( compare_result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to compare name with UTF-16 string.",
+				 function );
+
+				return( -1 );
+			}
+			else if( compare_result == LIBUNA_COMPARE_EQUAL )
+			{
+				*sub_node = sub_node_index->sub_nodes[ slot_index ];
+
+				return( 1 );
+			}
+		}
+		slot_index = ( slot_index + 1 ) & ( sub_node_index->number_of_slots - 1 );
+	}
+	return( 0 );
+}
+
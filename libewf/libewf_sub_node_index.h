@@ -0,0 +1,119 @@
+/*
+ * Sub node (name) index functions
+ *
+ * Copyright (C) 2006-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_SUB_NODE_INDEX_H )
+#define _LIBEWF_SUB_NODE_INDEX_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_libcdata.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libewf_sub_node_index libewf_sub_node_index_t;
+
+struct libewf_sub_node_index
+{
+	/* The number of slots, which is a power of 2
+	 */
+	uint32_t number_of_slots;
+
+	/* The name hashes of the slots
+	 */
+	uint32_t *hashes;
+
+	/* The sub nodes of the slots
+	 */
+	libcdata_tree_node_t **sub_nodes;
+
+	/* Value to indicate the slots were built
+	 */
+	uint8_t is_built;
+
+	/* Value to indicate the slots could not be built
+	 */
+	uint8_t build_failed;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* The mutex
+	 */
+	libcthreads_mutex_t *mutex;
+#endif
+};
+
+int libewf_sub_node_index_initialize(
+     libewf_sub_node_index_t **sub_node_index,
+     libcerror_error_t **error );
+
+int libewf_sub_node_index_free(
+     libewf_sub_node_index_t **sub_node_index,
+     libcerror_error_t **error );
+
+int libewf_sub_node_index_get_utf8_stream_hash(
+     const uint8_t *utf8_stream,
+     size_t utf8_stream_size,
+     uint32_t *hash,
+     libcerror_error_t **error );
+
+int libewf_sub_node_index_get_utf8_string_hash(
+     const uint8_t *utf8_string,
+     size_t utf8_string_length,
+     uint32_t *hash,
+     libcerror_error_t **error );
+
+int libewf_sub_node_index_get_utf16_string_hash(
+     const uint16_t *utf16_string,
+     size_t utf16_string_length,
+     uint32_t *hash,
+     libcerror_error_t **error );
+
+int libewf_sub_node_index_build(
+     libewf_sub_node_index_t *sub_node_index,
+     libcdata_tree_node_t *node,
+     libcerror_error_t **error );
+
+int libewf_sub_node_index_get_sub_node_by_utf8_name(
+     libewf_sub_node_index_t *sub_node_index,
+     libcdata_tree_node_t *node,
+     const uint8_t *utf8_string,
+     size_t utf8_string_length,
+     libcdata_tree_node_t **sub_node,
+     libcerror_error_t **error );
+
+int libewf_sub_node_index_get_sub_node_by_utf16_name(
+     libewf_sub_node_index_t *sub_node_index,
+     libcdata_tree_node_t *node,
+     const uint16_t *utf16_string,
+     size_t utf16_string_length,
+     libcdata_tree_node_t **sub_node,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_SUB_NODE_INDEX_H ) */
+
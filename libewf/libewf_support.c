@@ -146,6 +146,21 @@ int libewf_set_io_backend(
   return libcfile_set_io_backend(file_exists, file_exists_wide, file_create_handle, file_create_handle_wide, file_close_handle, file_read, file_seek, file_write, file_get_size);
 }
 
+int libewf_set_io_backend_vectored(
+  file_read_vector_ptr file_read_vector,
+  file_read_submit_ptr file_read_submit,
+  file_read_complete_ptr file_read_complete)
+{
+  return libcfile_set_io_backend_vectored(file_read_vector, file_read_submit, file_read_complete);
+}
+
+int libewf_set_io_backend_64(
+  file_read64_ptr file_read64,
+  file_write64_ptr file_write64)
+{
+  return libcfile_set_io_backend_64(file_read64, file_write64);
+}
+
 /* Determines if a file contains an EWF file signature
  * Returns 1 if true, 0 if not or -1 on error
  */
@@ -28,6 +28,7 @@
 
 #include "libewf_extern.h"
 #include "libewf_libbfio.h"
+#include "libewf_libcfile.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -77,6 +78,10 @@ typedef int (*file_seek_ptr)(void*, int64_t);
 typedef int (*file_write_ptr)(void*, const uint8_t*, int32_t, int32_t*);
 typedef int (*file_get_size_ptr)(void*, int64_t*);
 
+typedef int (*file_read_vector_ptr)(void*, file_read_range_t*, int32_t);
+typedef int (*file_read_submit_ptr)(void*, file_read_range_t*, int32_t, void**);
+typedef int (*file_read_complete_ptr)(void*, void*);
+
 LIBEWF_EXTERN \
 int libewf_set_io_backend(
   file_exists_ptr file_exists,
@@ -89,6 +94,17 @@ int libewf_set_io_backend(
   file_write_ptr file_write,
   file_get_size_ptr file_get_size );
 
+LIBEWF_EXTERN \
+int libewf_set_io_backend_vectored(
+  file_read_vector_ptr file_read_vector,
+  file_read_submit_ptr file_read_submit,
+  file_read_complete_ptr file_read_complete );
+
+LIBEWF_EXTERN \
+int libewf_set_io_backend_64(
+  file_read64_ptr file_read64,
+  file_write64_ptr file_write64 );
+
 LIBEWF_EXTERN \
 int libewf_check_file_signature(
      const char *filename,
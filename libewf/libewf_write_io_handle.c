@@ -34,6 +34,7 @@
 #include <time.h>
 #endif
 
+#include "libewf_buffered_io_handle.h"
 #include "libewf_chunk_data.h"
 #include "libewf_chunk_descriptor.h"
 #include "libewf_chunk_table.h"
@@ -2377,13 +2378,14 @@ int libewf_write_io_handle_create_segment_file(
      libewf_segment_file_t **segment_file,
      libcerror_error_t **error )
 {
-	libbfio_handle_t *file_io_handle         = NULL;
-	libewf_segment_file_t *safe_segment_file = NULL;
-	system_character_t *filename             = NULL;
-	static char *function                    = "libewf_write_io_handle_create_segment_file";
-	size_t filename_size                     = 0;
-	int bfio_access_flags                    = 0;
-	int safe_file_io_pool_entry              = 0;
+	libbfio_handle_t *buffered_file_io_handle = NULL;
+	libbfio_handle_t *file_io_handle          = NULL;
+	libewf_segment_file_t *safe_segment_file  = NULL;
+	system_character_t *filename              = NULL;
+	static char *function                     = "libewf_write_io_handle_create_segment_file";
+	size_t filename_size                      = 0;
+	int bfio_access_flags                     = 0;
+	int safe_file_io_pool_entry               = 0;
 
 	if( io_handle == NULL )
 	{
@@ -2518,11 +2520,48 @@ int libewf_write_io_handle_create_segment_file(
 
 		goto on_error;
 	}
+	if( io_handle->io_backend != NULL )
+	{
+		if( libbfio_file_set_io_backend(
+		     file_io_handle,
+		     io_handle->io_backend,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set IO backend in file IO handle.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	memory_free(
 	 filename );
 
 	filename = NULL;
 
+	if( io_handle->write_buffer_size > 0 )
+	{
+		if( libewf_buffered_file_initialize(
+		     &buffered_file_io_handle,
+		     file_io_handle,
+		     io_handle->write_buffer_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create buffered file IO handle.",
+			 function );
+
+			goto on_error;
+		}
+		file_io_handle          = buffered_file_io_handle;
+		buffered_file_io_handle = NULL;
+	}
 	bfio_access_flags = LIBBFIO_OPEN_WRITE_TRUNCATE;
 
 	if( libbfio_pool_append_handle(
@@ -30,6 +30,297 @@
 #include "libfcache_libcerror.h"
 #include "libfcache_types.h"
 
+/* Determines the hash bucket index of a cache value identifier
+ * Returns the bucket index
+ */
+int libfcache_internal_cache_get_bucket_index(
+     libfcache_internal_cache_t *internal_cache,
+     int file_index,
+     off64_t offset,
+     int64_t timestamp )
+{
+	uint64_t hash = 0;
+
+	/* The offset is mixed since it often is a multitude of a block size
+	 */
+	hash  = (uint64_t) offset ^ ( (uint64_t) file_index << 40 ) ^ (uint64_t) timestamp;
+	hash ^= hash >> 33;
+	hash *= 0xff51afd7ed558ccd;
+	hash ^= hash >> 33;
+
+	return( (int) ( hash & (uint64_t) ( internal_cache->number_of_buckets - 1 ) ) );
+}
+
+/* Inserts a cache value in the hash bucket of its identifier
+ */
+void libfcache_internal_cache_insert_bucket_value(
+      libfcache_internal_cache_t *internal_cache,
+      libfcache_internal_cache_value_t *internal_cache_value )
+{
+	int bucket_index = 0;
+
+	bucket_index = libfcache_internal_cache_get_bucket_index(
+	                internal_cache,
+	                internal_cache_value->file_index,
+	                internal_cache_value->offset,
+	                internal_cache_value->timestamp );
+
+	internal_cache_value->next_bucket_cache_value = internal_cache->buckets[ bucket_index ];
+	internal_cache->buckets[ bucket_index ]       = internal_cache_value;
+}
+
+/* Removes a cache value from the hash bucket of its identifier
+ */
+void libfcache_internal_cache_remove_bucket_value(
+      libfcache_internal_cache_t *internal_cache,
+      libfcache_internal_cache_value_t *internal_cache_value )
+{
+	libfcache_internal_cache_value_t **bucket_cache_value = NULL;
+	int bucket_index                                      = 0;
+
+	bucket_index = libfcache_internal_cache_get_bucket_index(
+	                internal_cache,
+	                internal_cache_value->file_index,
+	                internal_cache_value->offset,
+	                internal_cache_value->timestamp );
+
+	bucket_cache_value = &( internal_cache->buckets[ bucket_index ] );
+
+	while( *bucket_cache_value != NULL )
+	{
+		if( *bucket_cache_value == internal_cache_value )
+		{
+			*bucket_cache_value = internal_cache_value->next_bucket_cache_value;
+
+			break;
+		}
+		bucket_cache_value = &( ( *bucket_cache_value )->next_bucket_cache_value );
+	}
+	internal_cache_value->next_bucket_cache_value = NULL;
+}
+
+/* Prepends a cache value to the most recently used list
+ */
+void libfcache_internal_cache_prepend_value(
+      libfcache_internal_cache_t *internal_cache,
+      libfcache_internal_cache_value_t *internal_cache_value )
+{
+	internal_cache_value->previous_cache_value = NULL;
+	internal_cache_value->next_cache_value     = internal_cache->first_cache_value;
+
+	if( internal_cache->first_cache_value != NULL )
+	{
+		internal_cache->first_cache_value->previous_cache_value = internal_cache_value;
+	}
+	else
+	{
+		internal_cache->last_cache_value = internal_cache_value;
+	}
+	internal_cache->first_cache_value = internal_cache_value;
+}
+
+/* Removes a cache value from the most recently used list
+ */
+void libfcache_internal_cache_remove_value(
+      libfcache_internal_cache_t *internal_cache,
+      libfcache_internal_cache_value_t *internal_cache_value )
+{
+	if( internal_cache_value->previous_cache_value != NULL )
+	{
+		internal_cache_value->previous_cache_value->next_cache_value = internal_cache_value->next_cache_value;
+	}
+	else
+	{
+		internal_cache->first_cache_value = internal_cache_value->next_cache_value;
+	}
+	if( internal_cache_value->next_cache_value != NULL )
+	{
+		internal_cache_value->next_cache_value->previous_cache_value = internal_cache_value->previous_cache_value;
+	}
+	else
+	{
+		internal_cache->last_cache_value = internal_cache_value->previous_cache_value;
+	}
+	internal_cache_value->previous_cache_value = NULL;
+	internal_cache_value->next_cache_value     = NULL;
+}
+
+/* Sets the value and identifier of a cache value that is linked in the cache
+ * The value is set before the cache value is moved to the hash bucket of its new identifier
+ * so that on error the cache value remains in the hash bucket of its current identifier
+ * The cache value is moved to the front of the most recently used list
+ * Returns 1 if successful or -1 on error
+ */
+int libfcache_internal_cache_set_value(
+     libfcache_internal_cache_t *internal_cache,
+     libfcache_internal_cache_value_t *internal_cache_value,
+     int file_index,
+     off64_t offset,
+     int64_t timestamp,
+     intptr_t *value,
+     int (*value_free_function)(
+            intptr_t **value,
+            libcerror_error_t **error ),
+     uint8_t flags,
+     libcerror_error_t **error )
+{
+	static char *function = "libfcache_internal_cache_set_value";
+	int result            = 0;
+
+	if( libfcache_cache_value_set_value(
+	     (libfcache_cache_value_t *) internal_cache_value,
+	     value,
+	     value_free_function,
+	     flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set value in cache value.",
+		 function );
+
+		return( -1 );
+	}
+	libfcache_internal_cache_remove_bucket_value(
+	 internal_cache,
+	 internal_cache_value );
+
+	result = libfcache_cache_value_set_identifier(
+	          (libfcache_cache_value_t *) internal_cache_value,
+	          file_index,
+	          offset,
+	          timestamp,
+	          error );
+
+	libfcache_internal_cache_insert_bucket_value(
+	 internal_cache,
+	 internal_cache_value );
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set identifier in cache value.",
+		 function );
+
+		return( -1 );
+	}
+	/* Move the cache value to the front of the most recently used list
+	 */
+	if( internal_cache_value != internal_cache->first_cache_value )
+	{
+		libfcache_internal_cache_remove_value(
+		 internal_cache,
+		 internal_cache_value );
+
+		libfcache_internal_cache_prepend_value(
+		 internal_cache,
+		 internal_cache_value );
+	}
+	return( 1 );
+}
+
+/* Resizes the hash buckets to fit the maximum number of cache entries
+ * Returns 1 if successful or -1 on error
+ */
+int libfcache_internal_cache_resize_buckets(
+     libfcache_internal_cache_t *internal_cache,
+     int maximum_cache_entries,
+     libcerror_error_t **error )
+{
+	libfcache_internal_cache_value_t **buckets             = NULL;
+	libfcache_internal_cache_value_t *internal_cache_value = NULL;
+	static char *function                                  = "libfcache_internal_cache_resize_buckets";
+	size_t buckets_size                                    = 0;
+	int number_of_buckets                                  = 1;
+
+	if( internal_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( maximum_cache_entries <= 0 )
+	 || ( maximum_cache_entries > (int) ( MEMORY_MAXIMUM_ALLOCATION_SIZE / ( 2 * sizeof( libfcache_internal_cache_value_t * ) ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum cache entries value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	/* The number of buckets is a power of 2 so that it can be used as a mask
+	 */
+	while( number_of_buckets < maximum_cache_entries )
+	{
+		number_of_buckets <<= 1;
+	}
+	buckets_size = sizeof( libfcache_internal_cache_value_t * ) * number_of_buckets;
+
+	buckets = (libfcache_internal_cache_value_t **) memory_allocate(
+	                                                 buckets_size );
+
+	if( buckets == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buckets.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     buckets,
+	     0,
+	     buckets_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear buckets.",
+		 function );
+
+		memory_free(
+		 buckets );
+
+		return( -1 );
+	}
+	if( internal_cache->buckets != NULL )
+	{
+		memory_free(
+		 internal_cache->buckets );
+	}
+	internal_cache->buckets           = buckets;
+	internal_cache->number_of_buckets = number_of_buckets;
+
+	internal_cache_value = internal_cache->first_cache_value;
+
+	while( internal_cache_value != NULL )
+	{
+		libfcache_internal_cache_insert_bucket_value(
+		 internal_cache,
+		 internal_cache_value );
+
+		internal_cache_value = internal_cache_value->next_cache_value;
+	}
+	return( 1 );
+}
+
 /* Creates a cache
  * Make sure the value cache is referencing, is set to NULL
  * Returns 1 if successful or -1 on error
@@ -120,15 +411,16 @@ int libfcache_cache_initialize(
 
 		goto on_error;
 	}
-	if( libcdata_list_initialize(
-	     &( internal_cache->entries_list ),
+	if( libfcache_internal_cache_resize_buckets(
+	     internal_cache,
+	     maximum_cache_entries,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create entries list.",
+		 "%s: unable to create buckets.",
 		 function );
 
 		goto on_error;
@@ -147,6 +439,11 @@ on_error:
 			 NULL,
 			 NULL );
 		}
+		if( internal_cache->buckets != NULL )
+		{
+			memory_free(
+			 internal_cache->buckets );
+		}
 		memory_free(
 		 internal_cache );
 	}
@@ -180,19 +477,10 @@ int libfcache_cache_free(
 		internal_cache = (libfcache_internal_cache_t *) *cache;
 		*cache         = NULL;
 
-		if( libcdata_list_free(
-		     &( internal_cache->entries_list ),
-		     NULL,
-		     error ) != 1 )
+		if( internal_cache->buckets != NULL )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free the entries list.",
-			 function );
-
-			result = -1;
+			memory_free(
+			 internal_cache->buckets );
 		}
 		if( libcdata_array_free(
 		     &( internal_cache->entries_array ),
@@ -237,20 +525,23 @@ int libfcache_cache_empty(
 	}
 	internal_cache = (libfcache_internal_cache_t *) cache;
 
-	if( libcdata_list_empty(
-	     internal_cache->entries_list,
-	     NULL,
-	     error ) != 1 )
+	if( memory_set(
+	     internal_cache->buckets,
+	     0,
+	     sizeof( libfcache_internal_cache_value_t * ) * internal_cache->number_of_buckets ) == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to empty entries list.",
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear buckets.",
 		 function );
 
 		return( -1 );
 	}
+	internal_cache->first_cache_value = NULL;
+	internal_cache->last_cache_value  = NULL;
+
 	if( libcdata_array_clear(
 	     internal_cache->entries_array,
 	     (int (*)(intptr_t **, libcerror_error_t **)) &libfcache_cache_value_free,
@@ -351,8 +642,11 @@ int libfcache_cache_resize(
      int maximum_cache_entries,
      libcerror_error_t **error )
 {
-	libfcache_internal_cache_t *internal_cache = NULL;
-	static char *function                      = "libfcache_cache_resize";
+	libfcache_internal_cache_value_t *internal_cache_value = NULL;
+	libfcache_internal_cache_t *internal_cache             = NULL;
+	static char *function                                  = "libfcache_cache_resize";
+	int cache_entry_index                                  = 0;
+	int number_of_cache_entries                            = 0;
 
 	if( cache == NULL )
 	{
@@ -367,6 +661,55 @@ int libfcache_cache_resize(
 	}
 	internal_cache = (libfcache_internal_cache_t *) cache;
 
+	if( libcdata_array_get_number_of_entries(
+	     internal_cache->entries_array,
+	     &number_of_cache_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of cache entries from entries array.",
+		 function );
+
+		return( -1 );
+	}
+	/* Unlink the cache values that are freed when the entries array shrinks
+	 */
+	for( cache_entry_index = maximum_cache_entries;
+	     cache_entry_index < number_of_cache_entries;
+	     cache_entry_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     internal_cache->entries_array,
+		     cache_entry_index,
+		     (intptr_t **) &internal_cache_value,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve cache value: %d from entries array.",
+			 function,
+			 cache_entry_index );
+
+			return( -1 );
+		}
+		if( internal_cache_value != NULL )
+		{
+			libfcache_internal_cache_remove_bucket_value(
+			 internal_cache,
+			 internal_cache_value );
+
+			libfcache_internal_cache_remove_value(
+			 internal_cache,
+			 internal_cache_value );
+
+			internal_cache->number_of_cache_values -= 1;
+		}
+	}
 	if( libcdata_array_resize(
 	     internal_cache->entries_array,
 	     maximum_cache_entries,
@@ -382,6 +725,20 @@ int libfcache_cache_resize(
 
 		return( -1 );
 	}
+	if( libfcache_internal_cache_resize_buckets(
+	     internal_cache,
+	     maximum_cache_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+		 "%s: unable to resize buckets.",
+		 function );
+
+		return( -1 );
+	}
 	return( 1 );
 }
 
@@ -450,20 +807,19 @@ int libfcache_cache_get_number_of_cache_values(
 	}
 	internal_cache = (libfcache_internal_cache_t *) cache;
 
-	if( libcdata_list_get_number_of_elements(
-	     internal_cache->entries_list,
-	     number_of_cache_values,
-	     error ) != 1 )
+	if( number_of_cache_values == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of elements from entries list.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of cache values.",
 		 function );
 
 		return( -1 );
 	}
+	*number_of_cache_values = internal_cache->number_of_cache_values;
+
 	return( 1 );
 }
 
@@ -508,6 +864,12 @@ int libfcache_cache_clear_value_by_index(
 
 		return( -1 );
 	}
+	if( cache_value != NULL )
+	{
+		libfcache_internal_cache_remove_bucket_value(
+		 internal_cache,
+		 (libfcache_internal_cache_value_t *) cache_value );
+	}
 	if( libfcache_cache_value_clear(
 	     cache_value,
 	     error ) != 1 )
@@ -521,6 +883,10 @@ int libfcache_cache_clear_value_by_index(
 
 		return( -1 );
 	}
+	libfcache_internal_cache_insert_bucket_value(
+	 internal_cache,
+	 (libfcache_internal_cache_value_t *) cache_value );
+
 	return( 1 );
 }
 
@@ -535,15 +901,10 @@ int libfcache_cache_get_value_by_identifier(
      libfcache_cache_value_t **cache_value,
      libcerror_error_t **error )
 {
-	libcdata_list_element_t *list_element      = NULL;
-	libfcache_cache_value_t *safe_cache_value  = NULL;
-	libfcache_internal_cache_t *internal_cache = NULL;
-	static char *function                      = "libfcache_cache_get_value_by_identifier";
-	off64_t cache_value_offset                 = 0;
-	int64_t cache_value_timestamp              = 0;
-	int cache_value_file_index                 = 0;
-	int number_of_cache_values                 = 0;
-	int result                                 = 0;
+	libfcache_internal_cache_t *internal_cache             = NULL;
+	libfcache_internal_cache_value_t *internal_cache_value = NULL;
+	static char *function                                  = "libfcache_cache_get_value_by_identifier";
+	int bucket_index                                       = 0;
 
 	if( cache == NULL )
 	{
@@ -571,123 +932,43 @@ int libfcache_cache_get_value_by_identifier(
 	}
 	*cache_value = NULL;
 
-	if( libcdata_list_get_number_of_elements(
-	     internal_cache->entries_list,
-	     &number_of_cache_values,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of elements from entries list.",
-		 function );
+	bucket_index = libfcache_internal_cache_get_bucket_index(
+	                internal_cache,
+	                file_index,
+	                offset,
+	                timestamp );
 
-		return( -1 );
-	}
-	if( libcdata_list_get_first_element(
-	     internal_cache->entries_list,
-	     &list_element,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve first list element.",
-		 function );
+	internal_cache_value = internal_cache->buckets[ bucket_index ];
 
-		return( -1 );
-	}
-	while( list_element != NULL )
+	while( internal_cache_value != NULL )
 	{
-		if( libcdata_list_element_get_value(
-		     list_element,
-		     (intptr_t **) &safe_cache_value,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve cache value from list element.",
-			 function );
-
-			return( -1 );
-		}
-		if( libfcache_cache_value_get_identifier(
-		     safe_cache_value,
-		     &cache_value_file_index,
-		     &cache_value_offset,
-		     &cache_value_timestamp,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve cache value identifier.",
-			 function );
-
-			return( -1 );
-		}
-		if( ( cache_value_file_index == file_index )
-		 && ( cache_value_offset == offset )
-		 && ( cache_value_timestamp == timestamp ) )
+		if( ( internal_cache_value->file_index == file_index )
+		 && ( internal_cache_value->offset == offset )
+		 && ( internal_cache_value->timestamp == timestamp ) )
 		{
-			result = 1;
-
 			break;
 		}
-		if( libcdata_list_element_get_next_element(
-		     list_element,
-		     &list_element,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve next list element.",
-			 function );
-
-			return( -1 );
-		}
+		internal_cache_value = internal_cache_value->next_bucket_cache_value;
 	}
-	if( ( result != 0 )
-	 && ( number_of_cache_values > 0 ) )
+	if( internal_cache_value == NULL )
 	{
-		if( libcdata_list_remove_element(
-		     internal_cache->entries_list,
-		     list_element,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
-			 "%s: unable to remove list element.",
-			 function );
-
-			return( -1 );
-		}
-		if( libcdata_list_prepend_element(
-		     internal_cache->entries_list,
-		     list_element,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-			 "%s: unable to prepend list element.",
-			 function );
+		return( 0 );
+	}
+	/* Move the cache value to the front of the most recently used list
+	 */
+	if( internal_cache_value != internal_cache->first_cache_value )
+	{
+		libfcache_internal_cache_remove_value(
+		 internal_cache,
+		 internal_cache_value );
 
-			return( -1 );
-		}
-		*cache_value = safe_cache_value;
+		libfcache_internal_cache_prepend_value(
+		 internal_cache,
+		 internal_cache_value );
 	}
-	return( result );
+	*cache_value = (libfcache_cache_value_t *) internal_cache_value;
+
+	return( 1 );
 }
 
 /* Retrieves the cache value for the specific index
@@ -749,13 +1030,11 @@ int libfcache_cache_set_value_by_identifier(
      uint8_t flags,
      libcerror_error_t **error )
 {
-	libcdata_list_element_t *list_element      = NULL;
 	libfcache_cache_value_t *cache_value       = NULL;
 	libfcache_internal_cache_t *internal_cache = NULL;
 	static char *function                      = "libfcache_cache_set_value_by_identifier";
 	int cache_entry_index                      = 0;
 	int number_of_cache_entries                = 0;
-	int number_of_cache_values                 = 0;
 
 	if( cache == NULL )
 	{
@@ -784,23 +1063,9 @@ int libfcache_cache_set_value_by_identifier(
 
 		return( -1 );
 	}
-	if( libcdata_list_get_number_of_elements(
-	     internal_cache->entries_list,
-	     &number_of_cache_values,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of elements from entries list.",
-		 function );
-
-		return( -1 );
-	}
-	if( number_of_cache_values < number_of_cache_entries )
+	if( internal_cache->number_of_cache_values < number_of_cache_entries )
 	{
-		cache_entry_index = number_of_cache_values;
+		cache_entry_index = internal_cache->number_of_cache_values;
 
 		if( libfcache_cache_value_initialize(
 		     &cache_value,
@@ -853,100 +1118,40 @@ int libfcache_cache_set_value_by_identifier(
 
 			return( -1 );
 		}
-		if( libcdata_list_prepend_value(
-		     internal_cache->entries_list,
-		     (intptr_t *) cache_value,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-			 "%s: unable to prepend cache value: %d to entries list.",
-			 function );
+		libfcache_internal_cache_prepend_value(
+		 internal_cache,
+		 (libfcache_internal_cache_value_t *) cache_value );
 
-			return( -1 );
-		}
+		libfcache_internal_cache_insert_bucket_value(
+		 internal_cache,
+		 (libfcache_internal_cache_value_t *) cache_value );
+
+		internal_cache->number_of_cache_values += 1;
 	}
 	else
 	{
-		if( libcdata_list_get_last_element(
-		     internal_cache->entries_list,
-		     &list_element,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve last list element.",
-			 function );
+		/* Reuse the least recently used cache value
+		 */
+		cache_value = (libfcache_cache_value_t *) internal_cache->last_cache_value;
 
-			return( -1 );
-		}
-		if( libcdata_list_element_get_value(
-		     list_element,
-		     (intptr_t **) &cache_value,
-		     error ) != 1 )
+		if( cache_value == NULL )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve cache value from list element.",
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing last cache value.",
 			 function );
 
 			return( -1 );
 		}
-		if( libfcache_cache_value_get_cache_index(
-		     cache_value,
-		     &cache_entry_index,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve cache index from cache value.",
-			 function );
-
-			return( -1 );
-		}
-		if( libcdata_array_get_entry_by_index(
-		     internal_cache->entries_array,
-		     cache_entry_index,
-		     (intptr_t **) &cache_value,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve cache value: %d from entries array.",
-			 function,
-			 cache_entry_index );
-
-			return( -1 );
-		}
 	}
-	if( libfcache_cache_value_set_identifier(
-	     cache_value,
+	if( libfcache_internal_cache_set_value(
+	     internal_cache,
+	     (libfcache_internal_cache_value_t *) cache_value,
 	     file_index,
 	     offset,
 	     timestamp,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set identifier in cache value.",
-		 function );
-
-		return( -1 );
-	}
-	if( libfcache_cache_value_set_value(
-	     cache_value,
 	     value,
 	     value_free_function,
 	     flags,
@@ -1066,49 +1271,32 @@ int libfcache_cache_set_value_by_index(
 
 			return( -1 );
 		}
-		if( libcdata_list_prepend_value(
-		     internal_cache->entries_list,
-		     (intptr_t *) cache_value,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-			 "%s: unable to prepend cache value: %d to entries list.",
-			 function );
+		libfcache_internal_cache_prepend_value(
+		 internal_cache,
+		 (libfcache_internal_cache_value_t *) cache_value );
 
-			return( -1 );
-		}
-	}
-	if( libfcache_cache_value_set_value(
-	     cache_value,
-	     value,
-	     value_free_function,
-	     flags,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set value in cache value.",
-		 function );
+		libfcache_internal_cache_insert_bucket_value(
+		 internal_cache,
+		 (libfcache_internal_cache_value_t *) cache_value );
 
-		return( -1 );
+		internal_cache->number_of_cache_values += 1;
 	}
-	if( libfcache_cache_value_set_identifier(
-	     cache_value,
+	if( libfcache_internal_cache_set_value(
+	     internal_cache,
+	     (libfcache_internal_cache_value_t *) cache_value,
 	     file_index,
 	     offset,
 	     timestamp,
+	     value,
+	     value_free_function,
+	     flags,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set identifier in cache value.",
+		 "%s: unable to set value in cache value.",
 		 function );
 
 		return( -1 );
@@ -37,21 +37,78 @@ extern "C" {
 
 typedef struct libfcache_internal_cache libfcache_internal_cache_t;
 
+/* The cache values are indexed by their identifier in a hash table
+ * and kept in a most recently used order in a list that is part of
+ * the cache value, so that look up and promotion do not depend on
+ * the number of cache entries
+ */
 struct libfcache_internal_cache
 {
 	/* The cache entries array
 	 */
 	libcdata_array_t *entries_array;
 
-	/* The cache entries list
+	/* The first (most recently used) cache value
+	 */
+	libfcache_internal_cache_value_t *first_cache_value;
+
+	/* The last (least recently used) cache value
 	 */
-	libcdata_list_t *entries_list;
+	libfcache_internal_cache_value_t *last_cache_value;
 
 	/* The number of cache values
 	 */
 	int number_of_cache_values;
+
+	/* The hash buckets
+	 */
+	libfcache_internal_cache_value_t **buckets;
+
+	/* The number of hash buckets
+	 */
+	int number_of_buckets;
 };
 
+int libfcache_internal_cache_get_bucket_index(
+     libfcache_internal_cache_t *internal_cache,
+     int file_index,
+     off64_t offset,
+     int64_t timestamp );
+
+void libfcache_internal_cache_insert_bucket_value(
+      libfcache_internal_cache_t *internal_cache,
+      libfcache_internal_cache_value_t *internal_cache_value );
+
+void libfcache_internal_cache_remove_bucket_value(
+      libfcache_internal_cache_t *internal_cache,
+      libfcache_internal_cache_value_t *internal_cache_value );
+
+void libfcache_internal_cache_prepend_value(
+      libfcache_internal_cache_t *internal_cache,
+      libfcache_internal_cache_value_t *internal_cache_value );
+
+void libfcache_internal_cache_remove_value(
+      libfcache_internal_cache_t *internal_cache,
+      libfcache_internal_cache_value_t *internal_cache_value );
+
+int libfcache_internal_cache_set_value(
+     libfcache_internal_cache_t *internal_cache,
+     libfcache_internal_cache_value_t *internal_cache_value,
+     int file_index,
+     off64_t offset,
+     int64_t timestamp,
+     intptr_t *value,
+     int (*value_free_function)(
+            intptr_t **value,
+            libcerror_error_t **error ),
+     uint8_t flags,
+     libcerror_error_t **error );
+
+int libfcache_internal_cache_resize_buckets(
+     libfcache_internal_cache_t *internal_cache,
+     int maximum_cache_entries,
+     libcerror_error_t **error );
+
 LIBFCACHE_EXTERN \
 int libfcache_cache_initialize(
      libfcache_cache_t **cache,
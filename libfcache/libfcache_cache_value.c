@@ -170,6 +170,7 @@ int libfcache_cache_value_free(
 
 /* Clears the cache value
  * This function does not free the value
+ * The cache index and the references used by the cache are retained
  * Returns 1 if successful or -1 on error
  */
 int libfcache_cache_value_clear(
@@ -192,22 +193,12 @@ int libfcache_cache_value_clear(
 	}
 	internal_cache_value = (libfcache_internal_cache_value_t *) cache_value;
 
-	if( memory_set(
-	     internal_cache_value,
-	     0,
-	     sizeof( libfcache_internal_cache_value_t ) ) == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-		 "%s: unable to clear cache value.",
-		 function );
-
-		return( -1 );
-	}
-	internal_cache_value->file_index = -1;
-	internal_cache_value->offset     = (off64_t) -1;
+	internal_cache_value->file_index          = -1;
+	internal_cache_value->offset              = (off64_t) -1;
+	internal_cache_value->timestamp           = 0;
+	internal_cache_value->value               = NULL;
+	internal_cache_value->value_free_function = NULL;
+	internal_cache_value->flags               = 0;
 
 	return( 1 );
 }
@@ -66,6 +66,18 @@ struct libfcache_internal_cache_value
 	/* The flags
 	 */
 	uint8_t flags;
+
+	/* The previous (more recently used) cache value
+	 */
+	libfcache_internal_cache_value_t *previous_cache_value;
+
+	/* The next (less recently used) cache value
+	 */
+	libfcache_internal_cache_value_t *next_cache_value;
+
+	/* The next cache value in the same hash bucket
+	 */
+	libfcache_internal_cache_value_t *next_bucket_cache_value;
 };
 
 int libfcache_cache_value_initialize(
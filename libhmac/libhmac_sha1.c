@@ -40,6 +40,53 @@
 
 #if !defined( LIBHMAC_HAVE_SHA1_SUPPORT )
 
+/* The x86 SHA extensions are used by means of function target attributes
+ * so that the rest of the library does not require -msha
+ */
+#if ( defined( __x86_64__ ) || defined( __i386__ ) ) \
+ && ( defined( __clang__ ) || ( defined( __GNUC__ ) && ( __GNUC__ >= 5 ) ) )
+#define LIBHMAC_HAVE_SHA1_X86_SHA_EXTENSIONS
+
+#define LIBHMAC_SHA1_ATTRIBUTE_TARGET_SHA	__attribute__ ((target ("sha,sse4.1")))
+
+#define libhmac_sha1_atomic_load( value ) \
+	__atomic_load_n( value, __ATOMIC_RELAXED )
+
+#define libhmac_sha1_atomic_store( value, new_value ) \
+	__atomic_store_n( value, new_value, __ATOMIC_RELAXED )
+
+#include <cpuid.h>
+#include <immintrin.h>
+
+#elif defined( _MSC_VER ) && ( _MSC_VER >= 1900 ) && ( defined( _M_X64 ) || defined( _M_IX86 ) )
+#define LIBHMAC_HAVE_SHA1_X86_SHA_EXTENSIONS
+
+#define LIBHMAC_SHA1_ATTRIBUTE_TARGET_SHA
+
+#define libhmac_sha1_atomic_load( value ) \
+	*( (volatile int *) value )
+
+#define libhmac_sha1_atomic_store( value, new_value ) \
+	*( (volatile int *) value ) = new_value
+
+#include <intrin.h>
+#include <immintrin.h>
+
+/* The ARMv8 SHA-1 extensions are optional, hence they are only used
+ * when the compiler targets a CPU that provides them
+ */
+#elif defined( __aarch64__ ) && !defined( __AARCH64EB__ ) \
+ && ( defined( __ARM_FEATURE_SHA2 ) || defined( __ARM_FEATURE_CRYPTO ) )
+#define LIBHMAC_HAVE_SHA1_ARM_SHA_EXTENSIONS
+
+#include <arm_neon.h>
+
+#endif
+
+#endif /* !defined( LIBHMAC_HAVE_SHA1_SUPPORT ) */
+
+#if !defined( LIBHMAC_HAVE_SHA1_SUPPORT )
+
 /* RFC 3174/FIPS 180-1 based SHA-1 functions
  */
 
@@ -264,6 +311,448 @@ uint32_t libhmac_sha1_fixed_constants[ 5 ] = {
         libhmac_sha1_transform_unfolded_calculate_hash_value_round4( values_32bit, 78, hash_values, 2, 3, 4, 0, 1 ); \
         libhmac_sha1_transform_unfolded_calculate_hash_value_round4( values_32bit, 79, hash_values, 1, 2, 3, 4, 0 );
 
+#if defined( LIBHMAC_HAVE_SHA1_X86_SHA_EXTENSIONS )
+
+/* Value to indicate the x86 SHA extensions are supported
+ * -1 if not determined, 0 if not supported and 1 if supported
+ */
+static int libhmac_sha1_x86_sha_extensions_support = -1;
+
+/* Determines if the CPU supports the x86 SHA extensions
+ * The SHA-1 instructions are used in combination with SSSE3 and SSE4.1
+ * Returns 1 if supported or 0 if not
+ */
+static int libhmac_sha1_get_x86_sha_extensions_support(
+            void )
+{
+	uint32_t leaf1_registers[ 4 ] = { 0, 0, 0, 0 };
+	uint32_t leaf7_registers[ 4 ] = { 0, 0, 0, 0 };
+	int result                    = 0;
+
+#if defined( _MSC_VER )
+	int cpuid_registers[ 4 ];
+#endif
+
+	result = libhmac_sha1_atomic_load(
+	          &libhmac_sha1_x86_sha_extensions_support );
+
+	if( result != -1 )
+	{
+		return( result );
+	}
+	result = 0;
+
+#if defined( _MSC_VER )
+	__cpuid(
+	 cpuid_registers,
+	 0 );
+
+	if( cpuid_registers[ 0 ] >= 7 )
+	{
+		__cpuid(
+		 cpuid_registers,
+		 1 );
+
+		leaf1_registers[ 2 ] = (uint32_t) cpuid_registers[ 2 ];
+
+		__cpuidex(
+		 cpuid_registers,
+		 7,
+		 0 );
+
+		leaf7_registers[ 1 ] = (uint32_t) cpuid_registers[ 1 ];
+	}
+#else
+	if( __get_cpuid_max(
+	     0,
+	     NULL ) >= 7 )
+	{
+		__cpuid(
+		 1,
+		 leaf1_registers[ 0 ],
+		 leaf1_registers[ 1 ],
+		 leaf1_registers[ 2 ],
+		 leaf1_registers[ 3 ] );
+
+		__cpuid_count(
+		 7,
+		 0,
+		 leaf7_registers[ 0 ],
+		 leaf7_registers[ 1 ],
+		 leaf7_registers[ 2 ],
+		 leaf7_registers[ 3 ] );
+	}
+#endif
+	/* Leaf 1 ECX bit 9 is SSSE3 and bit 19 is SSE4.1, leaf 7 EBX bit 29 is SHA
+	 */
+	if( ( ( leaf1_registers[ 2 ] & 0x00080200UL ) == 0x00080200UL )
+	 && ( ( leaf7_registers[ 1 ] & 0x20000000UL ) != 0 ) )
+	{
+		result = 1;
+	}
+	libhmac_sha1_atomic_store(
+	 &libhmac_sha1_x86_sha_extensions_support,
+	 result );
+
+	return( result );
+}
+
+/* Calculates the hash values of 4 rounds using the x86 SHA extensions
+ * The function index is 0 for rounds 0 - 19, 1 for 20 - 39, 2 for 40 - 59 and 3 for 60 - 79
+ */
+#define libhmac_sha1_transform_x86_calculate_hash_values( abcd, next_e, e, message, function_index ) \
+	e      = _mm_sha1nexte_epu32( \
+	          e, \
+	          message ); \
+	next_e = abcd; \
+	abcd   = _mm_sha1rnds4_epu32( \
+	          abcd, \
+	          e, \
+	          function_index );
+
+/* Calculates the SHA1 of 64 byte sized blocks of data in a buffer using the x86 SHA extensions
+ */
+LIBHMAC_SHA1_ATTRIBUTE_TARGET_SHA \
+static void libhmac_sha1_transform_x86_sha_extensions(
+             uint32_t hash_values[ 5 ],
+             const uint8_t *buffer,
+             size_t number_of_blocks )
+{
+	__m128i abcd;
+	__m128i e0;
+	__m128i e1;
+	__m128i message0;
+	__m128i message1;
+	__m128i message2;
+	__m128i message3;
+	__m128i saved_abcd;
+	__m128i saved_e0;
+
+	/* Byte order mask to read the 32-bit values as big-endian
+	 */
+	const __m128i byte_order_mask = _mm_set_epi64x(
+	                                 0x0001020304050607ULL,
+	                                 0x08090a0b0c0d0e0fULL );
+
+	/* The SHA-1 instructions operate on the hash values in DCBA order
+	 */
+	abcd = _mm_loadu_si128(
+	        (const __m128i *) &( hash_values[ 0 ] ) );
+	abcd = _mm_shuffle_epi32(
+	        abcd,
+	        0x1b );
+	e0   = _mm_set_epi32(
+	        (int) hash_values[ 4 ],
+	        0,
+	        0,
+	        0 );
+
+	while( number_of_blocks > 0 )
+	{
+		saved_abcd = abcd;
+		saved_e0   = e0;
+
+		message0 = _mm_shuffle_epi8(
+		            _mm_loadu_si128(
+		             (const __m128i *) &( buffer[ 0 ] ) ),
+		            byte_order_mask );
+		message1 = _mm_shuffle_epi8(
+		            _mm_loadu_si128(
+		             (const __m128i *) &( buffer[ 16 ] ) ),
+		            byte_order_mask );
+		message2 = _mm_shuffle_epi8(
+		            _mm_loadu_si128(
+		             (const __m128i *) &( buffer[ 32 ] ) ),
+		            byte_order_mask );
+		message3 = _mm_shuffle_epi8(
+		            _mm_loadu_si128(
+		             (const __m128i *) &( buffer[ 48 ] ) ),
+		            byte_order_mask );
+
+		/* Rounds 0 - 19
+		 */
+		e0   = _mm_add_epi32(
+		        e0,
+		        message0 );
+		e1   = abcd;
+		abcd = _mm_sha1rnds4_epu32(
+		        abcd,
+		        e0,
+		        0 );
+
+		libhmac_sha1_transform_x86_calculate_hash_values( abcd, e0, e1, message1, 0 );
+		message0 = _mm_sha1msg1_epu32( message0, message1 );
+
+		libhmac_sha1_transform_x86_calculate_hash_values( abcd, e1, e0, message2, 0 );
+		message1 = _mm_sha1msg1_epu32( message1, message2 );
+		message0 = _mm_xor_si128( message0, message2 );
+
+		libhmac_sha1_transform_x86_calculate_hash_values( abcd, e0, e1, message3, 0 );
+		message0 = _mm_sha1msg2_epu32( message0, message3 );
+		message2 = _mm_sha1msg1_epu32( message2, message3 );
+		message1 = _mm_xor_si128( message1, message3 );
+
+		libhmac_sha1_transform_x86_calculate_hash_values( abcd, e1, e0, message0, 0 );
+		message1 = _mm_sha1msg2_epu32( message1, message0 );
+		message3 = _mm_sha1msg1_epu32( message3, message0 );
+		message2 = _mm_xor_si128( message2, message0 );
+
+		/* Rounds 20 - 39
+		 */
+		libhmac_sha1_transform_x86_calculate_hash_values( abcd, e0, e1, message1, 1 );
+		message2 = _mm_sha1msg2_epu32( message2, message1 );
+		message0 = _mm_sha1msg1_epu32( message0, message1 );
+		message3 = _mm_xor_si128( message3, message1 );
+
+		libhmac_sha1_transform_x86_calculate_hash_values( abcd, e1, e0, message2, 1 );
+		message3 = _mm_sha1msg2_epu32( message3, message2 );
+		message1 = _mm_sha1msg1_epu32( message1, message2 );
+		message0 = _mm_xor_si128( message0, message2 );
+
+		libhmac_sha1_transform_x86_calculate_hash_values( abcd, e0, e1, message3, 1 );
+		message0 = _mm_sha1msg2_epu32( message0, message3 );
+		message2 = _mm_sha1msg1_epu32( message2, message3 );
+		message1 = _mm_xor_si128( message1, message3 );
+
+		libhmac_sha1_transform_x86_calculate_hash_values( abcd, e1, e0, message0, 1 );
+		message1 = _mm_sha1msg2_epu32( message1, message0 );
+		message3 = _mm_sha1msg1_epu32( message3, message0 );
+		message2 = _mm_xor_si128( message2, message0 );
+
+		libhmac_sha1_transform_x86_calculate_hash_values( abcd, e0, e1, message1, 1 );
+		message2 = _mm_sha1msg2_epu32( message2, message1 );
+		message0 = _mm_sha1msg1_epu32( message0, message1 );
+		message3 = _mm_xor_si128( message3, message1 );
+
+		/* Rounds 40 - 59
+		 */
+		libhmac_sha1_transform_x86_calculate_hash_values( abcd, e1, e0, message2, 2 );
+		message3 = _mm_sha1msg2_epu32( message3, message2 );
+		message1 = _mm_sha1msg1_epu32( message1, message2 );
+		message0 = _mm_xor_si128( message0, message2 );
+
+		libhmac_sha1_transform_x86_calculate_hash_values( abcd, e0, e1, message3, 2 );
+		message0 = _mm_sha1msg2_epu32( message0, message3 );
+		message2 = _mm_sha1msg1_epu32( message2, message3 );
+		message1 = _mm_xor_si128( message1, message3 );
+
+		libhmac_sha1_transform_x86_calculate_hash_values( abcd, e1, e0, message0, 2 );
+		message1 = _mm_sha1msg2_epu32( message1, message0 );
+		message3 = _mm_sha1msg1_epu32( message3, message0 );
+		message2 = _mm_xor_si128( message2, message0 );
+
+		libhmac_sha1_transform_x86_calculate_hash_values( abcd, e0, e1, message1, 2 );
+		message2 = _mm_sha1msg2_epu32( message2, message1 );
+		message0 = _mm_sha1msg1_epu32( message0, message1 );
+		message3 = _mm_xor_si128( message3, message1 );
+
+		libhmac_sha1_transform_x86_calculate_hash_values( abcd, e1, e0, message2, 2 );
+		message3 = _mm_sha1msg2_epu32( message3, message2 );
+		message1 = _mm_sha1msg1_epu32( message1, message2 );
+		message0 = _mm_xor_si128( message0, message2 );
+
+		/* Rounds 60 - 79
+		 */
+		libhmac_sha1_transform_x86_calculate_hash_values( abcd, e0, e1, message3, 3 );
+		message0 = _mm_sha1msg2_epu32( message0, message3 );
+		message2 = _mm_sha1msg1_epu32( message2, message3 );
+		message1 = _mm_xor_si128( message1, message3 );
+
+		libhmac_sha1_transform_x86_calculate_hash_values( abcd, e1, e0, message0, 3 );
+		message1 = _mm_sha1msg2_epu32( message1, message0 );
+		message3 = _mm_sha1msg1_epu32( message3, message0 );
+		message2 = _mm_xor_si128( message2, message0 );
+
+		libhmac_sha1_transform_x86_calculate_hash_values( abcd, e0, e1, message1, 3 );
+		message2 = _mm_sha1msg2_epu32( message2, message1 );
+		message3 = _mm_xor_si128( message3, message1 );
+
+		libhmac_sha1_transform_x86_calculate_hash_values( abcd, e1, e0, message2, 3 );
+		message3 = _mm_sha1msg2_epu32( message3, message2 );
+
+		libhmac_sha1_transform_x86_calculate_hash_values( abcd, e0, e1, message3, 3 );
+
+		e0   = _mm_sha1nexte_epu32(
+		        e0,
+		        saved_e0 );
+		abcd = _mm_add_epi32(
+		        abcd,
+		        saved_abcd );
+
+		buffer           += LIBHMAC_SHA1_BLOCK_SIZE;
+		number_of_blocks -= 1;
+	}
+	/* Restore the ABCD order of the hash values
+	 */
+	abcd = _mm_shuffle_epi32(
+	        abcd,
+	        0x1b );
+
+	_mm_storeu_si128(
+	 (__m128i *) &( hash_values[ 0 ] ),
+	 abcd );
+
+	hash_values[ 4 ] = (uint32_t) _mm_extract_epi32(
+	                               e0,
+	                               3 );
+}
+
+#elif defined( LIBHMAC_HAVE_SHA1_ARM_SHA_EXTENSIONS )
+
+/* Calculates the hash values of 4 rounds using the ARMv8 SHA-1 extensions
+ */
+#define libhmac_sha1_transform_arm_calculate_hash_values( abcd, next_e, e, message, round_values, hash_function, round_constant ) \
+	round_values = vaddq_u32( \
+	                message, \
+	                vdupq_n_u32( \
+	                 round_constant ) ); \
+	next_e       = vsha1h_u32( \
+	                vgetq_lane_u32( \
+	                 abcd, \
+	                 0 ) ); \
+	abcd         = hash_function( \
+	                abcd, \
+	                e, \
+	                round_values );
+
+/* Extends the next 4 message values using the ARMv8 SHA-1 extensions
+ */
+#define libhmac_sha1_transform_arm_extend_message( message0, message1, message2, message3 ) \
+	message0 = vsha1su0q_u32( \
+	            message0, \
+	            message1, \
+	            message2 ); \
+	message0 = vsha1su1q_u32( \
+	            message0, \
+	            message3 );
+
+/* Calculates the SHA1 of 64 byte sized blocks of data in a buffer using the ARMv8 SHA-1 extensions
+ */
+static void libhmac_sha1_transform_arm_sha_extensions(
+             uint32_t hash_values[ 5 ],
+             const uint8_t *buffer,
+             size_t number_of_blocks )
+{
+	uint32x4_t abcd;
+	uint32x4_t message0;
+	uint32x4_t message1;
+	uint32x4_t message2;
+	uint32x4_t message3;
+	uint32x4_t round_values;
+	uint32x4_t saved_abcd;
+	uint32_t e0;
+	uint32_t e1;
+	uint32_t saved_e0;
+
+	abcd = vld1q_u32(
+	        &( hash_values[ 0 ] ) );
+	e0   = hash_values[ 4 ];
+
+	while( number_of_blocks > 0 )
+	{
+		saved_abcd = abcd;
+		saved_e0   = e0;
+
+		/* Read the 32-bit values as big-endian
+		 */
+		message0 = vreinterpretq_u32_u8(
+		            vrev32q_u8(
+		             vld1q_u8(
+		              &( buffer[ 0 ] ) ) ) );
+		message1 = vreinterpretq_u32_u8(
+		            vrev32q_u8(
+		             vld1q_u8(
+		              &( buffer[ 16 ] ) ) ) );
+		message2 = vreinterpretq_u32_u8(
+		            vrev32q_u8(
+		             vld1q_u8(
+		              &( buffer[ 32 ] ) ) ) );
+		message3 = vreinterpretq_u32_u8(
+		            vrev32q_u8(
+		             vld1q_u8(
+		              &( buffer[ 48 ] ) ) ) );
+
+		/* Rounds 0 - 19
+		 */
+		libhmac_sha1_transform_arm_calculate_hash_values( abcd, e1, e0, message0, round_values, vsha1cq_u32, 0x5a827999UL );
+		libhmac_sha1_transform_arm_extend_message( message0, message1, message2, message3 );
+
+		libhmac_sha1_transform_arm_calculate_hash_values( abcd, e0, e1, message1, round_values, vsha1cq_u32, 0x5a827999UL );
+		libhmac_sha1_transform_arm_extend_message( message1, message2, message3, message0 );
+
+		libhmac_sha1_transform_arm_calculate_hash_values( abcd, e1, e0, message2, round_values, vsha1cq_u32, 0x5a827999UL );
+		libhmac_sha1_transform_arm_extend_message( message2, message3, message0, message1 );
+
+		libhmac_sha1_transform_arm_calculate_hash_values( abcd, e0, e1, message3, round_values, vsha1cq_u32, 0x5a827999UL );
+		libhmac_sha1_transform_arm_extend_message( message3, message0, message1, message2 );
+
+		libhmac_sha1_transform_arm_calculate_hash_values( abcd, e1, e0, message0, round_values, vsha1cq_u32, 0x5a827999UL );
+		libhmac_sha1_transform_arm_extend_message( message0, message1, message2, message3 );
+
+		/* Rounds 20 - 39
+		 */
+		libhmac_sha1_transform_arm_calculate_hash_values( abcd, e0, e1, message1, round_values, vsha1pq_u32, 0x6ed9eba1UL );
+		libhmac_sha1_transform_arm_extend_message( message1, message2, message3, message0 );
+
+		libhmac_sha1_transform_arm_calculate_hash_values( abcd, e1, e0, message2, round_values, vsha1pq_u32, 0x6ed9eba1UL );
+		libhmac_sha1_transform_arm_extend_message( message2, message3, message0, message1 );
+
+		libhmac_sha1_transform_arm_calculate_hash_values( abcd, e0, e1, message3, round_values, vsha1pq_u32, 0x6ed9eba1UL );
+		libhmac_sha1_transform_arm_extend_message( message3, message0, message1, message2 );
+
+		libhmac_sha1_transform_arm_calculate_hash_values( abcd, e1, e0, message0, round_values, vsha1pq_u32, 0x6ed9eba1UL );
+		libhmac_sha1_transform_arm_extend_message( message0, message1, message2, message3 );
+
+		libhmac_sha1_transform_arm_calculate_hash_values( abcd, e0, e1, message1, round_values, vsha1pq_u32, 0x6ed9eba1UL );
+		libhmac_sha1_transform_arm_extend_message( message1, message2, message3, message0 );
+
+		/* Rounds 40 - 59
+		 */
+		libhmac_sha1_transform_arm_calculate_hash_values( abcd, e1, e0, message2, round_values, vsha1mq_u32, 0x8f1bbcdcUL );
+		libhmac_sha1_transform_arm_extend_message( message2, message3, message0, message1 );
+
+		libhmac_sha1_transform_arm_calculate_hash_values( abcd, e0, e1, message3, round_values, vsha1mq_u32, 0x8f1bbcdcUL );
+		libhmac_sha1_transform_arm_extend_message( message3, message0, message1, message2 );
+
+		libhmac_sha1_transform_arm_calculate_hash_values( abcd, e1, e0, message0, round_values, vsha1mq_u32, 0x8f1bbcdcUL );
+		libhmac_sha1_transform_arm_extend_message( message0, message1, message2, message3 );
+
+		libhmac_sha1_transform_arm_calculate_hash_values( abcd, e0, e1, message1, round_values, vsha1mq_u32, 0x8f1bbcdcUL );
+		libhmac_sha1_transform_arm_extend_message( message1, message2, message3, message0 );
+
+		libhmac_sha1_transform_arm_calculate_hash_values( abcd, e1, e0, message2, round_values, vsha1mq_u32, 0x8f1bbcdcUL );
+		libhmac_sha1_transform_arm_extend_message( message2, message3, message0, message1 );
+
+		/* Rounds 60 - 79
+		 */
+		libhmac_sha1_transform_arm_calculate_hash_values( abcd, e0, e1, message3, round_values, vsha1pq_u32, 0xca62c1d6UL );
+		libhmac_sha1_transform_arm_extend_message( message3, message0, message1, message2 );
+
+		libhmac_sha1_transform_arm_calculate_hash_values( abcd, e1, e0, message0, round_values, vsha1pq_u32, 0xca62c1d6UL );
+
+		libhmac_sha1_transform_arm_calculate_hash_values( abcd, e0, e1, message1, round_values, vsha1pq_u32, 0xca62c1d6UL );
+
+		libhmac_sha1_transform_arm_calculate_hash_values( abcd, e1, e0, message2, round_values, vsha1pq_u32, 0xca62c1d6UL );
+
+		libhmac_sha1_transform_arm_calculate_hash_values( abcd, e0, e1, message3, round_values, vsha1pq_u32, 0xca62c1d6UL );
+
+		abcd = vaddq_u32(
+		        abcd,
+		        saved_abcd );
+		e0  += saved_e0;
+
+		buffer           += LIBHMAC_SHA1_BLOCK_SIZE;
+		number_of_blocks -= 1;
+	}
+	vst1q_u32(
+	 &( hash_values[ 0 ] ),
+	 abcd );
+
+	hash_values[ 4 ] = e0;
+}
+
+#endif /* defined( LIBHMAC_HAVE_SHA1_X86_SHA_EXTENSIONS ) */
+
 /* Calculates the SHA1 of 64 byte sized blocks of data in a buffer
  * Returns the number of bytes used if successful or -1 on error
  */
@@ -318,6 +807,29 @@ ssize_t libhmac_sha1_transform(
 
 		return( -1 );
 	}
+#if defined( LIBHMAC_HAVE_SHA1_X86_SHA_EXTENSIONS )
+	if( libhmac_sha1_get_x86_sha_extensions_support() != 0 )
+	{
+		buffer_offset = size - ( size % LIBHMAC_SHA1_BLOCK_SIZE );
+
+		libhmac_sha1_transform_x86_sha_extensions(
+		 internal_context->hash_values,
+		 buffer,
+		 size / LIBHMAC_SHA1_BLOCK_SIZE );
+
+		return( (ssize_t) buffer_offset );
+	}
+#elif defined( LIBHMAC_HAVE_SHA1_ARM_SHA_EXTENSIONS )
+	buffer_offset = size - ( size % LIBHMAC_SHA1_BLOCK_SIZE );
+
+	libhmac_sha1_transform_arm_sha_extensions(
+	 internal_context->hash_values,
+	 buffer,
+	 size / LIBHMAC_SHA1_BLOCK_SIZE );
+
+	return( (ssize_t) buffer_offset );
+
+#endif
 	while( size >= LIBHMAC_SHA1_BLOCK_SIZE )
 	{
 		if( memory_copy(
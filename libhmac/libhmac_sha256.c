@@ -40,6 +40,53 @@
 
 #if !defined( LIBHMAC_HAVE_SHA256_SUPPORT )
 
+/* The x86 SHA extensions are used by means of function target attributes
+ * so that the rest of the library does not require -msha
+ */
+#if ( defined( __x86_64__ ) || defined( __i386__ ) ) \
+ && ( defined( __clang__ ) || ( defined( __GNUC__ ) && ( __GNUC__ >= 5 ) ) )
+#define LIBHMAC_HAVE_SHA256_X86_SHA_EXTENSIONS
+
+#define LIBHMAC_SHA256_ATTRIBUTE_TARGET_SHA	__attribute__ ((target ("sha,sse4.1")))
+
+#define libhmac_sha256_atomic_load( value ) \
+	__atomic_load_n( value, __ATOMIC_RELAXED )
+
+#define libhmac_sha256_atomic_store( value, new_value ) \
+	__atomic_store_n( value, new_value, __ATOMIC_RELAXED )
+
+#include <cpuid.h>
+#include <immintrin.h>
+
+#elif defined( _MSC_VER ) && ( _MSC_VER >= 1900 ) && ( defined( _M_X64 ) || defined( _M_IX86 ) )
+#define LIBHMAC_HAVE_SHA256_X86_SHA_EXTENSIONS
+
+#define LIBHMAC_SHA256_ATTRIBUTE_TARGET_SHA
+
+#define libhmac_sha256_atomic_load( value ) \
+	*( (volatile int *) value )
+
+#define libhmac_sha256_atomic_store( value, new_value ) \
+	*( (volatile int *) value ) = new_value
+
+#include <intrin.h>
+#include <immintrin.h>
+
+/* The ARMv8 SHA-2 extensions are optional, hence they are only used
+ * when the compiler targets a CPU that provides them
+ */
+#elif defined( __aarch64__ ) && !defined( __AARCH64EB__ ) \
+ && ( defined( __ARM_FEATURE_SHA2 ) || defined( __ARM_FEATURE_CRYPTO ) )
+#define LIBHMAC_HAVE_SHA256_ARM_SHA_EXTENSIONS
+
+#include <arm_neon.h>
+
+#endif
+
+#endif /* !defined( LIBHMAC_HAVE_SHA256_SUPPORT ) */
+
+#if !defined( LIBHMAC_HAVE_SHA256_SUPPORT )
+
 /* FIPS 180-2 based SHA-256 functions
  */
 
@@ -222,6 +269,433 @@ uint32_t libhmac_sha256_prime_cube_roots[ 64 ] = {
 	libhmac_sha256_transform_unfolded_calculate_hash_value( values_32bit, 62, hash_values, 2, 3, 4, 5, 6, 7, 0, 1, s0, s1, t1, t2 ) \
 	libhmac_sha256_transform_unfolded_calculate_hash_value( values_32bit, 63, hash_values, 1, 2, 3, 4, 5, 6, 7, 0, s0, s1, t1, t2 )
 
+#if defined( LIBHMAC_HAVE_SHA256_X86_SHA_EXTENSIONS )
+
+/* Value to indicate the x86 SHA extensions are supported
+ * -1 if not determined, 0 if not supported and 1 if supported
+ */
+static int libhmac_sha256_x86_sha_extensions_support = -1;
+
+/* Determines if the CPU supports the x86 SHA extensions
+ * The SHA-256 instructions are used in combination with SSSE3 and SSE4.1
+ * Returns 1 if supported or 0 if not
+ */
+static int libhmac_sha256_get_x86_sha_extensions_support(
+            void )
+{
+	uint32_t leaf1_registers[ 4 ] = { 0, 0, 0, 0 };
+	uint32_t leaf7_registers[ 4 ] = { 0, 0, 0, 0 };
+	int result                    = 0;
+
+#if defined( _MSC_VER )
+	int cpuid_registers[ 4 ];
+#endif
+
+	result = libhmac_sha256_atomic_load(
+	          &libhmac_sha256_x86_sha_extensions_support );
+
+	if( result != -1 )
+	{
+		return( result );
+	}
+	result = 0;
+
+#if defined( _MSC_VER )
+	__cpuid(
+	 cpuid_registers,
+	 0 );
+
+	if( cpuid_registers[ 0 ] >= 7 )
+	{
+		__cpuid(
+		 cpuid_registers,
+		 1 );
+
+		leaf1_registers[ 2 ] = (uint32_t) cpuid_registers[ 2 ];
+
+		__cpuidex(
+		 cpuid_registers,
+		 7,
+		 0 );
+
+		leaf7_registers[ 1 ] = (uint32_t) cpuid_registers[ 1 ];
+	}
+#else
+	if( __get_cpuid_max(
+	     0,
+	     NULL ) >= 7 )
+	{
+		__cpuid(
+		 1,
+		 leaf1_registers[ 0 ],
+		 leaf1_registers[ 1 ],
+		 leaf1_registers[ 2 ],
+		 leaf1_registers[ 3 ] );
+
+		__cpuid_count(
+		 7,
+		 0,
+		 leaf7_registers[ 0 ],
+		 leaf7_registers[ 1 ],
+		 leaf7_registers[ 2 ],
+		 leaf7_registers[ 3 ] );
+	}
+#endif
+	/* Leaf 1 ECX bit 9 is SSSE3 and bit 19 is SSE4.1, leaf 7 EBX bit 29 is SHA
+	 */
+	if( ( ( leaf1_registers[ 2 ] & 0x00080200UL ) == 0x00080200UL )
+	 && ( ( leaf7_registers[ 1 ] & 0x20000000UL ) != 0 ) )
+	{
+		result = 1;
+	}
+	libhmac_sha256_atomic_store(
+	 &libhmac_sha256_x86_sha_extensions_support,
+	 result );
+
+	return( result );
+}
+
+/* Calculates the hash values of 4 rounds using the x86 SHA extensions
+ */
+#define libhmac_sha256_transform_x86_calculate_hash_values( state0, state1, message, round_values, constants_index ) \
+	round_values = _mm_add_epi32( \
+	                message, \
+	                _mm_loadu_si128( \
+	                 (const __m128i *) &( libhmac_sha256_prime_cube_roots[ constants_index ] ) ) ); \
+	state1       = _mm_sha256rnds2_epu32( \
+	                state1, \
+	                state0, \
+	                round_values ); \
+	round_values = _mm_shuffle_epi32( \
+	                round_values, \
+	                0x0e ); \
+	state0       = _mm_sha256rnds2_epu32( \
+	                state0, \
+	                state1, \
+	                round_values );
+
+/* Extends the next 4 message values using the x86 SHA extensions
+ */
+#define libhmac_sha256_transform_x86_extend_message( next_message, message, previous_message, temporary_message ) \
+	temporary_message = _mm_alignr_epi8( \
+	                     message, \
+	                     previous_message, \
+	                     4 ); \
+	next_message      = _mm_add_epi32( \
+	                     next_message, \
+	                     temporary_message ); \
+	next_message      = _mm_sha256msg2_epu32( \
+	                     next_message, \
+	                     message );
+
+/* Calculates the SHA-256 of 64 byte sized blocks of data in a buffer using the x86 SHA extensions
+ */
+LIBHMAC_SHA256_ATTRIBUTE_TARGET_SHA \
+static void libhmac_sha256_transform_x86_sha_extensions(
+             uint32_t hash_values[ 8 ],
+             const uint8_t *buffer,
+             size_t number_of_blocks )
+{
+	__m128i message0;
+	__m128i message1;
+	__m128i message2;
+	__m128i message3;
+	__m128i round_values;
+	__m128i saved_state0;
+	__m128i saved_state1;
+	__m128i state0;
+	__m128i state1;
+	__m128i temporary_message;
+
+	/* Byte order mask to read the 32-bit values as big-endian
+	 */
+	const __m128i byte_order_mask = _mm_set_epi64x(
+	                                 0x0c0d0e0f08090a0bULL,
+	                                 0x0405060700010203ULL );
+
+	/* The SHA-256 instructions operate on the hash values in ABEF and CDGH order
+	 */
+	temporary_message = _mm_loadu_si128(
+	                     (const __m128i *) &( hash_values[ 0 ] ) );
+	state1            = _mm_loadu_si128(
+	                     (const __m128i *) &( hash_values[ 4 ] ) );
+
+	temporary_message = _mm_shuffle_epi32(
+	                     temporary_message,
+	                     0xb1 );
+	state1            = _mm_shuffle_epi32(
+	                     state1,
+	                     0x1b );
+	state0            = _mm_alignr_epi8(
+	                     temporary_message,
+	                     state1,
+	                     8 );
+	state1            = _mm_blend_epi16(
+	                     state1,
+	                     temporary_message,
+	                     0xf0 );
+
+	while( number_of_blocks > 0 )
+	{
+		saved_state0 = state0;
+		saved_state1 = state1;
+
+		message0 = _mm_shuffle_epi8(
+		            _mm_loadu_si128(
+		             (const __m128i *) &( buffer[ 0 ] ) ),
+		            byte_order_mask );
+		message1 = _mm_shuffle_epi8(
+		            _mm_loadu_si128(
+		             (const __m128i *) &( buffer[ 16 ] ) ),
+		            byte_order_mask );
+		message2 = _mm_shuffle_epi8(
+		            _mm_loadu_si128(
+		             (const __m128i *) &( buffer[ 32 ] ) ),
+		            byte_order_mask );
+		message3 = _mm_shuffle_epi8(
+		            _mm_loadu_si128(
+		             (const __m128i *) &( buffer[ 48 ] ) ),
+		            byte_order_mask );
+
+		/* Rounds 0 - 15
+		 */
+		libhmac_sha256_transform_x86_calculate_hash_values( state0, state1, message0, round_values, 0 );
+
+		libhmac_sha256_transform_x86_calculate_hash_values( state0, state1, message1, round_values, 4 );
+		message0 = _mm_sha256msg1_epu32( message0, message1 );
+
+		libhmac_sha256_transform_x86_calculate_hash_values( state0, state1, message2, round_values, 8 );
+		message1 = _mm_sha256msg1_epu32( message1, message2 );
+
+		libhmac_sha256_transform_x86_calculate_hash_values( state0, state1, message3, round_values, 12 );
+		libhmac_sha256_transform_x86_extend_message( message0, message3, message2, temporary_message );
+		message2 = _mm_sha256msg1_epu32( message2, message3 );
+
+		/* Rounds 16 - 47
+		 */
+		libhmac_sha256_transform_x86_calculate_hash_values( state0, state1, message0, round_values, 16 );
+		libhmac_sha256_transform_x86_extend_message( message1, message0, message3, temporary_message );
+		message3 = _mm_sha256msg1_epu32( message3, message0 );
+
+		libhmac_sha256_transform_x86_calculate_hash_values( state0, state1, message1, round_values, 20 );
+		libhmac_sha256_transform_x86_extend_message( message2, message1, message0, temporary_message );
+		message0 = _mm_sha256msg1_epu32( message0, message1 );
+
+		libhmac_sha256_transform_x86_calculate_hash_values( state0, state1, message2, round_values, 24 );
+		libhmac_sha256_transform_x86_extend_message( message3, message2, message1, temporary_message );
+		message1 = _mm_sha256msg1_epu32( message1, message2 );
+
+		libhmac_sha256_transform_x86_calculate_hash_values( state0, state1, message3, round_values, 28 );
+		libhmac_sha256_transform_x86_extend_message( message0, message3, message2, temporary_message );
+		message2 = _mm_sha256msg1_epu32( message2, message3 );
+
+		libhmac_sha256_transform_x86_calculate_hash_values( state0, state1, message0, round_values, 32 );
+		libhmac_sha256_transform_x86_extend_message( message1, message0, message3, temporary_message );
+		message3 = _mm_sha256msg1_epu32( message3, message0 );
+
+		libhmac_sha256_transform_x86_calculate_hash_values( state0, state1, message1, round_values, 36 );
+		libhmac_sha256_transform_x86_extend_message( message2, message1, message0, temporary_message );
+		message0 = _mm_sha256msg1_epu32( message0, message1 );
+
+		libhmac_sha256_transform_x86_calculate_hash_values( state0, state1, message2, round_values, 40 );
+		libhmac_sha256_transform_x86_extend_message( message3, message2, message1, temporary_message );
+		message1 = _mm_sha256msg1_epu32( message1, message2 );
+
+		libhmac_sha256_transform_x86_calculate_hash_values( state0, state1, message3, round_values, 44 );
+		libhmac_sha256_transform_x86_extend_message( message0, message3, message2, temporary_message );
+		message2 = _mm_sha256msg1_epu32( message2, message3 );
+
+		/* Rounds 48 - 63
+		 */
+		libhmac_sha256_transform_x86_calculate_hash_values( state0, state1, message0, round_values, 48 );
+		libhmac_sha256_transform_x86_extend_message( message1, message0, message3, temporary_message );
+		message3 = _mm_sha256msg1_epu32( message3, message0 );
+
+		libhmac_sha256_transform_x86_calculate_hash_values( state0, state1, message1, round_values, 52 );
+		libhmac_sha256_transform_x86_extend_message( message2, message1, message0, temporary_message );
+
+		libhmac_sha256_transform_x86_calculate_hash_values( state0, state1, message2, round_values, 56 );
+		libhmac_sha256_transform_x86_extend_message( message3, message2, message1, temporary_message );
+
+		libhmac_sha256_transform_x86_calculate_hash_values( state0, state1, message3, round_values, 60 );
+
+		state0 = _mm_add_epi32(
+		          state0,
+		          saved_state0 );
+		state1 = _mm_add_epi32(
+		          state1,
+		          saved_state1 );
+
+		buffer           += LIBHMAC_SHA256_BLOCK_SIZE;
+		number_of_blocks -= 1;
+	}
+	/* Restore the ABCD and EFGH order of the hash values
+	 */
+	temporary_message = _mm_shuffle_epi32(
+	                     state0,
+	                     0x1b );
+	state1            = _mm_shuffle_epi32(
+	                     state1,
+	                     0xb1 );
+	state0            = _mm_blend_epi16(
+	                     temporary_message,
+	                     state1,
+	                     0xf0 );
+	state1            = _mm_alignr_epi8(
+	                     state1,
+	                     temporary_message,
+	                     8 );
+
+	_mm_storeu_si128(
+	 (__m128i *) &( hash_values[ 0 ] ),
+	 state0 );
+	_mm_storeu_si128(
+	 (__m128i *) &( hash_values[ 4 ] ),
+	 state1 );
+}
+
+#elif defined( LIBHMAC_HAVE_SHA256_ARM_SHA_EXTENSIONS )
+
+/* Calculates the hash values of 4 rounds using the ARMv8 SHA-2 extensions
+ */
+#define libhmac_sha256_transform_arm_calculate_hash_values( state0, state1, temporary_state, message, round_values, constants_index ) \
+	round_values    = vaddq_u32( \
+	                   message, \
+	                   vld1q_u32( \
+	                    &( libhmac_sha256_prime_cube_roots[ constants_index ] ) ) ); \
+	temporary_state = state0; \
+	state0          = vsha256hq_u32( \
+	                   state0, \
+	                   state1, \
+	                   round_values ); \
+	state1          = vsha256h2q_u32( \
+	                   state1, \
+	                   temporary_state, \
+	                   round_values );
+
+/* Extends the next 4 message values using the ARMv8 SHA-2 extensions
+ */
+#define libhmac_sha256_transform_arm_extend_message( message0, message1, message2, message3 ) \
+	message0 = vsha256su0q_u32( \
+	            message0, \
+	            message1 ); \
+	message0 = vsha256su1q_u32( \
+	            message0, \
+	            message2, \
+	            message3 );
+
+/* Calculates the SHA-256 of 64 byte sized blocks of data in a buffer using the ARMv8 SHA-2 extensions
+ */
+static void libhmac_sha256_transform_arm_sha_extensions(
+             uint32_t hash_values[ 8 ],
+             const uint8_t *buffer,
+             size_t number_of_blocks )
+{
+	uint32x4_t message0;
+	uint32x4_t message1;
+	uint32x4_t message2;
+	uint32x4_t message3;
+	uint32x4_t round_values;
+	uint32x4_t saved_state0;
+	uint32x4_t saved_state1;
+	uint32x4_t state0;
+	uint32x4_t state1;
+	uint32x4_t temporary_state;
+
+	state0 = vld1q_u32(
+	          &( hash_values[ 0 ] ) );
+	state1 = vld1q_u32(
+	          &( hash_values[ 4 ] ) );
+
+	while( number_of_blocks > 0 )
+	{
+		saved_state0 = state0;
+		saved_state1 = state1;
+
+		/* Read the 32-bit values as big-endian
+		 */
+		message0 = vreinterpretq_u32_u8(
+		            vrev32q_u8(
+		             vld1q_u8(
+		              &( buffer[ 0 ] ) ) ) );
+		message1 = vreinterpretq_u32_u8(
+		            vrev32q_u8(
+		             vld1q_u8(
+		              &( buffer[ 16 ] ) ) ) );
+		message2 = vreinterpretq_u32_u8(
+		            vrev32q_u8(
+		             vld1q_u8(
+		              &( buffer[ 32 ] ) ) ) );
+		message3 = vreinterpretq_u32_u8(
+		            vrev32q_u8(
+		             vld1q_u8(
+		              &( buffer[ 48 ] ) ) ) );
+
+		/* Rounds 0 - 47
+		 */
+		libhmac_sha256_transform_arm_calculate_hash_values( state0, state1, temporary_state, message0, round_values, 0 );
+		libhmac_sha256_transform_arm_extend_message( message0, message1, message2, message3 );
+
+		libhmac_sha256_transform_arm_calculate_hash_values( state0, state1, temporary_state, message1, round_values, 4 );
+		libhmac_sha256_transform_arm_extend_message( message1, message2, message3, message0 );
+
+		libhmac_sha256_transform_arm_calculate_hash_values( state0, state1, temporary_state, message2, round_values, 8 );
+		libhmac_sha256_transform_arm_extend_message( message2, message3, message0, message1 );
+
+		libhmac_sha256_transform_arm_calculate_hash_values( state0, state1, temporary_state, message3, round_values, 12 );
+		libhmac_sha256_transform_arm_extend_message( message3, message0, message1, message2 );
+
+		libhmac_sha256_transform_arm_calculate_hash_values( state0, state1, temporary_state, message0, round_values, 16 );
+		libhmac_sha256_transform_arm_extend_message( message0, message1, message2, message3 );
+
+		libhmac_sha256_transform_arm_calculate_hash_values( state0, state1, temporary_state, message1, round_values, 20 );
+		libhmac_sha256_transform_arm_extend_message( message1, message2, message3, message0 );
+
+		libhmac_sha256_transform_arm_calculate_hash_values( state0, state1, temporary_state, message2, round_values, 24 );
+		libhmac_sha256_transform_arm_extend_message( message2, message3, message0, message1 );
+
+		libhmac_sha256_transform_arm_calculate_hash_values( state0, state1, temporary_state, message3, round_values, 28 );
+		libhmac_sha256_transform_arm_extend_message( message3, message0, message1, message2 );
+
+		libhmac_sha256_transform_arm_calculate_hash_values( state0, state1, temporary_state, message0, round_values, 32 );
+		libhmac_sha256_transform_arm_extend_message( message0, message1, message2, message3 );
+
+		libhmac_sha256_transform_arm_calculate_hash_values( state0, state1, temporary_state, message1, round_values, 36 );
+		libhmac_sha256_transform_arm_extend_message( message1, message2, message3, message0 );
+
+		libhmac_sha256_transform_arm_calculate_hash_values( state0, state1, temporary_state, message2, round_values, 40 );
+		libhmac_sha256_transform_arm_extend_message( message2, message3, message0, message1 );
+
+		libhmac_sha256_transform_arm_calculate_hash_values( state0, state1, temporary_state, message3, round_values, 44 );
+		libhmac_sha256_transform_arm_extend_message( message3, message0, message1, message2 );
+
+		/* Rounds 48 - 63
+		 */
+		libhmac_sha256_transform_arm_calculate_hash_values( state0, state1, temporary_state, message0, round_values, 48 );
+		libhmac_sha256_transform_arm_calculate_hash_values( state0, state1, temporary_state, message1, round_values, 52 );
+		libhmac_sha256_transform_arm_calculate_hash_values( state0, state1, temporary_state, message2, round_values, 56 );
+		libhmac_sha256_transform_arm_calculate_hash_values( state0, state1, temporary_state, message3, round_values, 60 );
+
+		state0 = vaddq_u32(
+		          state0,
+		          saved_state0 );
+		state1 = vaddq_u32(
+		          state1,
+		          saved_state1 );
+
+		buffer           += LIBHMAC_SHA256_BLOCK_SIZE;
+		number_of_blocks -= 1;
+	}
+	vst1q_u32(
+	 &( hash_values[ 0 ] ),
+	 state0 );
+	vst1q_u32(
+	 &( hash_values[ 4 ] ),
+	 state1 );
+}
+
+#endif /* defined( LIBHMAC_HAVE_SHA256_X86_SHA_EXTENSIONS ) */
+
 /* Calculates the SHA-256 of 64 byte sized blocks of data in a buffer
  * Returns the number of bytes used if successful or -1 on error
  */
@@ -279,6 +753,29 @@ ssize_t libhmac_sha256_transform(
 
 		return( -1 );
 	}
+#if defined( LIBHMAC_HAVE_SHA256_X86_SHA_EXTENSIONS )
+	if( libhmac_sha256_get_x86_sha_extensions_support() != 0 )
+	{
+		buffer_offset = size - ( size % LIBHMAC_SHA256_BLOCK_SIZE );
+
+		libhmac_sha256_transform_x86_sha_extensions(
+		 internal_context->hash_values,
+		 buffer,
+		 size / LIBHMAC_SHA256_BLOCK_SIZE );
+
+		return( (ssize_t) buffer_offset );
+	}
+#elif defined( LIBHMAC_HAVE_SHA256_ARM_SHA_EXTENSIONS )
+	buffer_offset = size - ( size % LIBHMAC_SHA256_BLOCK_SIZE );
+
+	libhmac_sha256_transform_arm_sha_extensions(
+	 internal_context->hash_values,
+	 buffer,
+	 size / LIBHMAC_SHA256_BLOCK_SIZE );
+
+	return( (ssize_t) buffer_offset );
+
+#endif
 	while( size >= LIBHMAC_SHA256_BLOCK_SIZE )
 	{
 		if( memory_copy(
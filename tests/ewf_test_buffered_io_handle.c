@@ -0,0 +1,1112 @@
+/*
+ * Library buffered_io_handle type test program
+ *
+ * Copyright (C) 2006-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_functions.h"
+#include "ewf_test_libbfio.h"
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_memory.h"
+#include "ewf_test_unused.h"
+
+#include "../libewf/libewf_buffered_io_handle.h"
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+/* Creates a memory range file IO handle for test data
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_buffered_io_handle_create_file_io_handle(
+     libbfio_handle_t **file_io_handle,
+     uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	if( libbfio_memory_range_initialize(
+	     file_io_handle,
+	     error ) != 1 )
+	{
+		return( -1 );
+	}
+	if( libbfio_memory_range_set(
+	     *file_io_handle,
+	     data,
+	     data_size,
+	     error ) != 1 )
+	{
+		libbfio_handle_free(
+		 file_io_handle,
+		 NULL );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Tests the libewf_buffered_io_handle_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_buffered_io_handle_initialize(
+     void )
+{
+	uint8_t data[ 64 ];
+
+	libbfio_handle_t *file_io_handle                = NULL;
+	libcerror_error_t *error                        = NULL;
+	libewf_buffered_io_handle_t *buffered_io_handle = NULL;
+	int result                                      = 0;
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+	int number_of_malloc_fail_tests                 = 1;
+	int number_of_memset_fail_tests                 = 1;
+	int test_number                                 = 0;
+#endif
+
+	/* Initialize test
+	 */
+	result = ewf_test_buffered_io_handle_create_file_io_handle(
+	          &file_io_handle,
+	          data,
+	          64,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libewf_buffered_io_handle_initialize(
+	          &buffered_io_handle,
+	          file_io_handle,
+	          16,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "buffered_io_handle",
+	 buffered_io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The buffered IO handle manages the file IO handle
+	 */
+	file_io_handle = NULL;
+
+	result = libewf_buffered_io_handle_free(
+	          &buffered_io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "buffered_io_handle",
+	 buffered_io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Initialize test
+	 */
+	result = ewf_test_buffered_io_handle_create_file_io_handle(
+	          &file_io_handle,
+	          data,
+	          64,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_buffered_io_handle_initialize(
+	          NULL,
+	          file_io_handle,
+	          16,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	buffered_io_handle = (libewf_buffered_io_handle_t *) 0x12345678UL;
+
+	result = libewf_buffered_io_handle_initialize(
+	          &buffered_io_handle,
+	          file_io_handle,
+	          16,
+	          &error );
+
+	buffered_io_handle = NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_buffered_io_handle_initialize(
+	          &buffered_io_handle,
+	          NULL,
+	          16,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_buffered_io_handle_initialize(
+	          &buffered_io_handle,
+	          file_io_handle,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libewf_buffered_io_handle_initialize with malloc failing
+		 */
+		ewf_test_malloc_attempts_before_fail = test_number;
+
+		result = libewf_buffered_io_handle_initialize(
+		          &buffered_io_handle,
+		          file_io_handle,
+		          16,
+		          &error );
+
+		if( ewf_test_malloc_attempts_before_fail != -1 )
+		{
+			ewf_test_malloc_attempts_before_fail = -1;
+
+			if( buffered_io_handle != NULL )
+			{
+				buffered_io_handle->file_io_handle = NULL;
+
+				libewf_buffered_io_handle_free(
+				 &buffered_io_handle,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "buffered_io_handle",
+			 buffered_io_handle );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libewf_buffered_io_handle_initialize with memset failing
+		 */
+		ewf_test_memset_attempts_before_fail = test_number;
+
+		result = libewf_buffered_io_handle_initialize(
+		          &buffered_io_handle,
+		          file_io_handle,
+		          16,
+		          &error );
+
+		if( ewf_test_memset_attempts_before_fail != -1 )
+		{
+			ewf_test_memset_attempts_before_fail = -1;
+
+			if( buffered_io_handle != NULL )
+			{
+				buffered_io_handle->file_io_handle = NULL;
+
+				libewf_buffered_io_handle_free(
+				 &buffered_io_handle,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "buffered_io_handle",
+			 buffered_io_handle );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_EWF_TEST_MEMORY ) */
+
+	/* Clean up
+	 */
+	result = libbfio_handle_free(
+	          &file_io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( buffered_io_handle != NULL )
+	{
+		libewf_buffered_io_handle_free(
+		 &buffered_io_handle,
+		 NULL );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_buffered_io_handle_free function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_buffered_io_handle_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libewf_buffered_io_handle_free(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_buffered_io_handle_write function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_buffered_io_handle_write(
+     void )
+{
+	uint8_t data[ 4096 ];
+	uint8_t read_buffer[ 16 ];
+	uint8_t write_buffer[ 2000 ];
+
+	libbfio_handle_t *file_io_handle                = NULL;
+	libcerror_error_t *error                        = NULL;
+	libewf_buffered_io_handle_t *buffered_io_handle = NULL;
+	ssize_t read_count                              = 0;
+	ssize_t write_count                             = 0;
+	off64_t offset                                  = 0;
+	size64_t size                                   = 0;
+	int result                                      = 0;
+
+	/* Initialize test
+	 */
+	result = ewf_test_buffered_io_handle_create_file_io_handle(
+	          &file_io_handle,
+	          data,
+	          4096,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_buffered_io_handle_initialize(
+	          &buffered_io_handle,
+	          file_io_handle,
+	          1024,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	file_io_handle = NULL;
+
+	result = libewf_buffered_io_handle_open(
+	          buffered_io_handle,
+	          LIBBFIO_OPEN_READ_WRITE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_buffered_io_handle_is_open(
+	          buffered_io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_set(
+	          data,
+	          0,
+	          4096 ) != NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = memory_set(
+	          write_buffer,
+	          'A',
+	          2000 ) != NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* Test regular cases
+	 */
+	write_count = libewf_buffered_io_handle_write(
+	               buffered_io_handle,
+	               write_buffer,
+	               100,
+	               &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "write_count",
+	 write_count,
+	 (ssize_t) 100 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The data is kept in the write buffer
+	 */
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "data[ 0 ]",
+	 data[ 0 ],
+	 (uint8_t) 0 );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "buffered_io_handle->buffer_data_size",
+	 buffered_io_handle->buffer_data_size,
+	 (size_t) 100 );
+
+	/* The write buffer is filled and written, 1024 bytes are written directly and the remainder is kept
+	 */
+	write_count = libewf_buffered_io_handle_write(
+	               buffered_io_handle,
+	               write_buffer,
+	               2000,
+	               &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "write_count",
+	 write_count,
+	 (ssize_t) 2000 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "data[ 2047 ]",
+	 data[ 2047 ],
+	 (uint8_t) 'A' );
+
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "data[ 2048 ]",
+	 data[ 2048 ],
+	 (uint8_t) 0 );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "buffered_io_handle->buffer_data_size",
+	 buffered_io_handle->buffer_data_size,
+	 (size_t) 52 );
+
+	/* Seeking the current offset does not flush the write buffer
+	 */
+	offset = libewf_buffered_io_handle_seek_offset(
+	          buffered_io_handle,
+	          2100,
+	          SEEK_SET,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) 2100 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "buffered_io_handle->buffer_data_size",
+	 buffered_io_handle->buffer_data_size,
+	 (size_t) 52 );
+
+	/* Seeking another offset flushes the write buffer
+	 */
+	offset = libewf_buffered_io_handle_seek_offset(
+	          buffered_io_handle,
+	          2092,
+	          SEEK_SET,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) 2092 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "buffered_io_handle->buffer_data_size",
+	 buffered_io_handle->buffer_data_size,
+	 (size_t) 0 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "data[ 2099 ]",
+	 data[ 2099 ],
+	 (uint8_t) 'A' );
+
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "data[ 2100 ]",
+	 data[ 2100 ],
+	 (uint8_t) 0 );
+
+	/* Reading flushes the write buffer
+	 */
+	write_count = libewf_buffered_io_handle_write(
+	               buffered_io_handle,
+	               (uint8_t *) "BBBB",
+	               4,
+	               &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "write_count",
+	 write_count,
+	 (ssize_t) 4 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	read_count = libewf_buffered_io_handle_read(
+	              buffered_io_handle,
+	              read_buffer,
+	              8,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 8 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "data[ 2092 ]",
+	 data[ 2092 ],
+	 (uint8_t) 'B' );
+
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "read_buffer[ 3 ]",
+	 read_buffer[ 3 ],
+	 (uint8_t) 'A' );
+
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "read_buffer[ 4 ]",
+	 read_buffer[ 4 ],
+	 (uint8_t) 0 );
+
+	/* Closing flushes the write buffer
+	 */
+	write_count = libewf_buffered_io_handle_write(
+	               buffered_io_handle,
+	               (uint8_t *) "CCCC",
+	               4,
+	               &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "write_count",
+	 write_count,
+	 (ssize_t) 4 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_buffered_io_handle_get_size(
+	          buffered_io_handle,
+	          &size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "size",
+	 (uint64_t) size,
+	 (uint64_t) 4096 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	write_count = libewf_buffered_io_handle_write(
+	               buffered_io_handle,
+	               (uint8_t *) "DDDD",
+	               4,
+	               &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "write_count",
+	 write_count,
+	 (ssize_t) 4 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_buffered_io_handle_close(
+	          buffered_io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "data[ 2104 ]",
+	 data[ 2104 ],
+	 (uint8_t) 'C' );
+
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "data[ 2111 ]",
+	 data[ 2111 ],
+	 (uint8_t) 'D' );
+
+	/* Test error cases
+	 */
+	write_count = libewf_buffered_io_handle_write(
+	               NULL,
+	               write_buffer,
+	               4,
+	               &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "write_count",
+	 write_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	write_count = libewf_buffered_io_handle_write(
+	               buffered_io_handle,
+	               NULL,
+	               4,
+	               &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "write_count",
+	 write_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_buffered_io_handle_free(
+	          &buffered_io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "buffered_io_handle",
+	 buffered_io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( buffered_io_handle != NULL )
+	{
+		libewf_buffered_io_handle_free(
+		 &buffered_io_handle,
+		 NULL );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_buffered_file_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_buffered_file_initialize(
+     void )
+{
+	uint8_t data[ 64 ];
+
+	libbfio_handle_t *clone_file_io_handle = NULL;
+	libbfio_handle_t *file_io_handle       = NULL;
+	libbfio_handle_t *handle               = NULL;
+	libcerror_error_t *error               = NULL;
+	ssize_t write_count                    = 0;
+	int result                             = 0;
+
+	/* Initialize test
+	 */
+	result = memory_set(
+	          data,
+	          0,
+	          64 ) != NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = ewf_test_buffered_io_handle_create_file_io_handle(
+	          &file_io_handle,
+	          data,
+	          64,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libewf_buffered_file_initialize(
+	          &handle,
+	          file_io_handle,
+	          16,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "handle",
+	 handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	file_io_handle = NULL;
+
+	result = libbfio_handle_clone(
+	          &clone_file_io_handle,
+	          handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "clone_file_io_handle",
+	 clone_file_io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_handle_free(
+	          &clone_file_io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_handle_open(
+	          handle,
+	          LIBBFIO_OPEN_WRITE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	write_count = libbfio_handle_write_buffer(
+	               handle,
+	               (uint8_t *) "EEEE",
+	               4,
+	               &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "write_count",
+	 write_count,
+	 (ssize_t) 4 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "data[ 0 ]",
+	 data[ 0 ],
+	 (uint8_t) 0 );
+
+	result = libbfio_handle_close(
+	          handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "data[ 0 ]",
+	 data[ 0 ],
+	 (uint8_t) 'E' );
+
+	result = libbfio_handle_free(
+	          &handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_buffered_file_initialize(
+	          NULL,
+	          NULL,
+	          16,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_buffered_file_initialize(
+	          &handle,
+	          NULL,
+	          16,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( clone_file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &clone_file_io_handle,
+		 NULL );
+	}
+	if( handle != NULL )
+	{
+		libbfio_handle_free(
+		 &handle,
+		 NULL );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+	EWF_TEST_RUN(
+	 "libewf_buffered_io_handle_initialize",
+	 ewf_test_buffered_io_handle_initialize );
+
+	EWF_TEST_RUN(
+	 "libewf_buffered_io_handle_free",
+	 ewf_test_buffered_io_handle_free );
+
+	EWF_TEST_RUN(
+	 "libewf_buffered_io_handle_write",
+	 ewf_test_buffered_io_handle_write );
+
+	EWF_TEST_RUN(
+	 "libewf_buffered_file_initialize",
+	 ewf_test_buffered_file_initialize );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+}
+
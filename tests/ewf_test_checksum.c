@@ -35,6 +35,7 @@
 #include "ewf_test_unused.h"
 
 #include "../libewf/libewf_checksum.h"
+#include "../libewf/libewf_cpu_features.h"
 #include "../libewf/libewf_deflate.h"
 
 /* Define to make ewf_test_checksum generate verbose output
@@ -626,6 +627,255 @@ on_error:
 	return( 0 );
 }
 
+
+/* Compares an Adler-32 function with libewf_deflate_calculate_adler32
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_checksum_compare_adler32(
+     int (*calculate_adler32)(
+            uint32_t *checksum_value,
+            const uint8_t *buffer,
+            size_t size,
+            uint32_t initial_value,
+            libcerror_error_t **error ) )
+{
+	uint32_t initial_values[ 2 ] = { 1, 0xfff0fff0UL };
+
+	libcerror_error_t *error   = NULL;
+	uint8_t *buffer            = NULL;
+	size_t buffer_offset       = 0;
+	size_t size                = 0;
+	uint32_t checksum          = 0;
+	uint32_t expected_checksum = 0;
+	int result                 = 0;
+	int value_index            = 0;
+
+	/* Use a buffer of 0xff bytes that is larger than the modulo block size to test for overflows
+	 */
+	buffer = (uint8_t *) memory_allocate(
+	                      sizeof( uint8_t ) * 65536 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "buffer",
+	 buffer );
+
+	for( buffer_offset = 0;
+	     buffer_offset < 65536;
+	     buffer_offset++ )
+	{
+		buffer[ buffer_offset ] = 0xff;
+	}
+	for( value_index = 0;
+	     value_index < 2;
+	     value_index++ )
+	{
+		result = libewf_deflate_calculate_adler32(
+		          &expected_checksum,
+		          buffer,
+		          65536,
+		          initial_values[ value_index ],
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		result = calculate_adler32(
+		          &checksum,
+		          buffer,
+		          65536,
+		          initial_values[ value_index ],
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_EQUAL_UINT32(
+		 "checksum",
+		 checksum,
+		 expected_checksum );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test unaligned buffers and sizes that are not a multiple of the block size
+	 */
+	for( buffer_offset = 0;
+	     buffer_offset < 7;
+	     buffer_offset++ )
+	{
+		for( size = 0;
+		     size < 200;
+		     size += 13 )
+		{
+			result = libewf_deflate_calculate_adler32(
+			          &expected_checksum,
+			          &( ewf_test_checksum_uncompressed_byte_stream[ buffer_offset ] ),
+			          size,
+			          1,
+			          &error );
+
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			result = calculate_adler32(
+			          &checksum,
+			          &( ewf_test_checksum_uncompressed_byte_stream[ buffer_offset ] ),
+			          size,
+			          1,
+			          &error );
+
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			EWF_TEST_ASSERT_EQUAL_UINT32(
+			 "checksum",
+			 checksum,
+			 expected_checksum );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+		}
+	}
+	result = calculate_adler32(
+	          &checksum,
+	          ewf_test_checksum_uncompressed_byte_stream,
+	          7640,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "checksum",
+	 checksum,
+	 (uint32_t) 0x304a56a4UL );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = calculate_adler32(
+	          NULL,
+	          ewf_test_checksum_uncompressed_byte_stream,
+	          7640,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = calculate_adler32(
+	          &checksum,
+	          NULL,
+	          7640,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	memory_free(
+	 buffer );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( buffer != NULL )
+	{
+		memory_free(
+		 buffer );
+	}
+	return( 0 );
+}
+
+#if defined( HAVE_LIBEWF_SSE2_SUPPORT )
+
+/* Tests the libewf_checksum_calculate_adler32_sse2 function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_checksum_calculate_adler32_sse2(
+     void )
+{
+	if( ( libewf_cpu_features_get_flags() & LIBEWF_CPU_FEATURE_FLAG_SSE2 ) == 0 )
+	{
+		return( 1 );
+	}
+	return( ewf_test_checksum_compare_adler32(
+	         &libewf_checksum_calculate_adler32_sse2 ) );
+}
+
+#endif /* defined( HAVE_LIBEWF_SSE2_SUPPORT ) */
+
+#if defined( HAVE_LIBEWF_AVX2_SUPPORT )
+
+/* Tests the libewf_checksum_calculate_adler32_avx2 function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_checksum_calculate_adler32_avx2(
+     void )
+{
+	if( ( libewf_cpu_features_get_flags() & LIBEWF_CPU_FEATURE_FLAG_AVX2 ) == 0 )
+	{
+		return( 1 );
+	}
+	return( ewf_test_checksum_compare_adler32(
+	         &libewf_checksum_calculate_adler32_avx2 ) );
+}
+
+#endif /* defined( HAVE_LIBEWF_AVX2_SUPPORT ) */
+
+#if defined( HAVE_LIBEWF_NEON_SUPPORT )
+
+/* Tests the libewf_checksum_calculate_adler32_neon function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_checksum_calculate_adler32_neon(
+     void )
+{
+	return( ewf_test_checksum_compare_adler32(
+	         &libewf_checksum_calculate_adler32_neon ) );
+}
+
+#endif /* defined( HAVE_LIBEWF_NEON_SUPPORT ) */
+
 #endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
 
 /* The main program
@@ -657,6 +907,24 @@ int main(
 	 "libewf_checksum_calculate_adler32",
 	 ewf_test_checksum_calculate_adler32 );
 
+#if defined( HAVE_LIBEWF_SSE2_SUPPORT )
+	EWF_TEST_RUN(
+	 "libewf_checksum_calculate_adler32_sse2",
+	 ewf_test_checksum_calculate_adler32_sse2 );
+#endif
+
+#if defined( HAVE_LIBEWF_AVX2_SUPPORT )
+	EWF_TEST_RUN(
+	 "libewf_checksum_calculate_adler32_avx2",
+	 ewf_test_checksum_calculate_adler32_avx2 );
+#endif
+
+#if defined( HAVE_LIBEWF_NEON_SUPPORT )
+	EWF_TEST_RUN(
+	 "libewf_checksum_calculate_adler32_neon",
+	 ewf_test_checksum_calculate_adler32_neon );
+#endif
+
 #endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
 
 	return( EXIT_SUCCESS );
@@ -0,0 +1,1286 @@
+/*
+ * Library chunk_cache type test program
+ *
+ * Copyright (C) 2006-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_memory.h"
+#include "ewf_test_unused.h"
+
+#include "../libewf/libewf_chunk_cache.h"
+#include "../libewf/libewf_chunk_data.h"
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+/* Creates chunk data filled with a specific byte value
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_chunk_cache_create_chunk_data(
+     libewf_chunk_data_t **chunk_data,
+     uint8_t byte_value,
+     libcerror_error_t **error )
+{
+	int result = 0;
+
+	result = libewf_chunk_data_initialize(
+	          chunk_data,
+	          512,
+	          1,
+	          error );
+
+	if( result != 1 )
+	{
+		return( -1 );
+	}
+	if( memory_set(
+	     ( *chunk_data )->data,
+	     byte_value,
+	     512 ) == NULL )
+	{
+		libewf_chunk_data_free(
+		 chunk_data,
+		 NULL );
+
+		return( -1 );
+	}
+	( *chunk_data )->data_size = 512;
+
+	return( 1 );
+}
+
+/* Tests the libewf_chunk_cache_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_cache_initialize(
+     void )
+{
+	libcerror_error_t *error          = NULL;
+	libewf_chunk_cache_t *chunk_cache = NULL;
+	int result                        = 0;
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+	int number_of_malloc_fail_tests   = 4;
+	int number_of_memset_fail_tests   = 3;
+	int test_number                   = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libewf_chunk_cache_initialize(
+	          &chunk_cache,
+	          4,
+	          4 * 4096,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_cache",
+	 chunk_cache );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_cache_free(
+	          &chunk_cache,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_cache",
+	 chunk_cache );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_chunk_cache_initialize(
+	          NULL,
+	          4,
+	          4 * 4096,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	chunk_cache = (libewf_chunk_cache_t *) 0x12345678UL;
+
+	result = libewf_chunk_cache_initialize(
+	          &chunk_cache,
+	          4,
+	          4 * 4096,
+	          &error );
+
+	chunk_cache = NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_cache_initialize(
+	          &chunk_cache,
+	          0,
+	          4 * 4096,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libewf_chunk_cache_initialize with malloc failing
+		 */
+		ewf_test_malloc_attempts_before_fail = test_number;
+
+		result = libewf_chunk_cache_initialize(
+		          &chunk_cache,
+		          4,
+		          4 * 4096,
+		          &error );
+
+		if( ewf_test_malloc_attempts_before_fail != -1 )
+		{
+			ewf_test_malloc_attempts_before_fail = -1;
+
+			if( chunk_cache != NULL )
+			{
+				libewf_chunk_cache_free(
+				 &chunk_cache,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "chunk_cache",
+			 chunk_cache );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libewf_chunk_cache_initialize with memset failing
+		 */
+		ewf_test_memset_attempts_before_fail = test_number;
+
+		result = libewf_chunk_cache_initialize(
+		          &chunk_cache,
+		          4,
+		          4 * 4096,
+		          &error );
+
+		if( ewf_test_memset_attempts_before_fail != -1 )
+		{
+			ewf_test_memset_attempts_before_fail = -1;
+
+			if( chunk_cache != NULL )
+			{
+				libewf_chunk_cache_free(
+				 &chunk_cache,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "chunk_cache",
+			 chunk_cache );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_EWF_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( chunk_cache != NULL )
+	{
+		libewf_chunk_cache_free(
+		 &chunk_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_chunk_cache_free function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_cache_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libewf_chunk_cache_free(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_chunk_cache_copy_data and libewf_chunk_cache_set_chunk_data functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_cache_copy_data(
+     void )
+{
+	uint8_t buffer[ 512 ];
+
+	libcerror_error_t *error          = NULL;
+	libewf_chunk_cache_t *chunk_cache = NULL;
+	libewf_chunk_data_t *chunk_data   = NULL;
+	size_t read_size                  = 0;
+	uint64_t number_of_hits           = 0;
+	uint64_t number_of_misses         = 0;
+	int result                        = 0;
+
+	/* Initialize test
+	 * Each shard can hold a single chunk of 512 bytes
+	 */
+	result = libewf_chunk_cache_initialize(
+	          &chunk_cache,
+	          4,
+	          4 * 600,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_cache",
+	 chunk_cache );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libewf_chunk_cache_copy_data(
+	          chunk_cache,
+	          5,
+	          0,
+	          buffer,
+	          512,
+	          &read_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = ewf_test_chunk_cache_create_chunk_data(
+	          &chunk_data,
+	          0x5a,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libewf_chunk_cache_set_chunk_data(
+	          chunk_cache,
+	          5,
+	          chunk_data,
+	          0,
+	          &error );
+
+	chunk_data = NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Setting an already cached chunk frees the chunk data
+	 */
+	result = ewf_test_chunk_cache_create_chunk_data(
+	          &chunk_data,
+	          0xa5,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libewf_chunk_cache_set_chunk_data(
+	          chunk_cache,
+	          5,
+	          chunk_data,
+	          0,
+	          &error );
+
+	chunk_data = NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_cache_copy_data(
+	          chunk_cache,
+	          5,
+	          500,
+	          buffer,
+	          512,
+	          &read_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "read_size",
+	 read_size,
+	 (size_t) 12 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "buffer[ 0 ]",
+	 buffer[ 0 ],
+	 0x5a );
+
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "buffer[ 11 ]",
+	 buffer[ 11 ],
+	 0x5a );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Chunk 9 maps to the same shard as chunk 5 and evicts it
+	 */
+	result = ewf_test_chunk_cache_create_chunk_data(
+	          &chunk_data,
+	          0x33,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libewf_chunk_cache_set_chunk_data(
+	          chunk_cache,
+	          9,
+	          chunk_data,
+	          0,
+	          &error );
+
+	chunk_data = NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_cache_copy_data(
+	          chunk_cache,
+	          5,
+	          0,
+	          buffer,
+	          512,
+	          &read_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_cache_copy_data(
+	          chunk_cache,
+	          9,
+	          0,
+	          buffer,
+	          16,
+	          &read_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "read_size",
+	 read_size,
+	 (size_t) 16 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "buffer[ 15 ]",
+	 buffer[ 15 ],
+	 0x33 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test libewf_chunk_cache_get_statistics
+	 */
+	result = libewf_chunk_cache_get_statistics(
+	          chunk_cache,
+	          &number_of_hits,
+	          &number_of_misses,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "number_of_hits",
+	 number_of_hits,
+	 (uint64_t) 2 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "number_of_misses",
+	 number_of_misses,
+	 (uint64_t) 2 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_chunk_cache_copy_data(
+	          NULL,
+	          9,
+	          0,
+	          buffer,
+	          512,
+	          &read_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_cache_copy_data(
+	          chunk_cache,
+	          9,
+	          -1,
+	          buffer,
+	          512,
+	          &read_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_cache_copy_data(
+	          chunk_cache,
+	          9,
+	          513,
+	          buffer,
+	          512,
+	          &read_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_cache_copy_data(
+	          chunk_cache,
+	          9,
+	          0,
+	          NULL,
+	          512,
+	          &read_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_cache_copy_data(
+	          chunk_cache,
+	          9,
+	          0,
+	          buffer,
+	          (size_t) SSIZE_MAX + 1,
+	          &read_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_cache_copy_data(
+	          chunk_cache,
+	          9,
+	          0,
+	          buffer,
+	          512,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_cache_set_chunk_data(
+	          chunk_cache,
+	          9,
+	          NULL,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_cache_get_statistics(
+	          NULL,
+	          &number_of_hits,
+	          &number_of_misses,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_cache_get_statistics(
+	          chunk_cache,
+	          NULL,
+	          &number_of_misses,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test libewf_chunk_cache_empty
+	 */
+	result = libewf_chunk_cache_empty(
+	          chunk_cache,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_cache_copy_data(
+	          chunk_cache,
+	          9,
+	          0,
+	          buffer,
+	          512,
+	          &read_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_cache_empty(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test libewf_chunk_cache_set_maximum_size
+	 * A maximum size of 0 disables caching
+	 */
+	result = libewf_chunk_cache_set_maximum_size(
+	          chunk_cache,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = ewf_test_chunk_cache_create_chunk_data(
+	          &chunk_data,
+	          0x33,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libewf_chunk_cache_set_chunk_data(
+	          chunk_cache,
+	          9,
+	          chunk_data,
+	          0,
+	          &error );
+
+	chunk_data = NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_cache_copy_data(
+	          chunk_cache,
+	          9,
+	          0,
+	          buffer,
+	          512,
+	          &read_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_cache_set_maximum_size(
+	          NULL,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_chunk_cache_free(
+	          &chunk_cache,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_cache",
+	 chunk_cache );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 &chunk_data,
+		 NULL );
+	}
+	if( chunk_cache != NULL )
+	{
+		libewf_chunk_cache_free(
+		 &chunk_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_chunk_cache_get_prefetch_statistics and libewf_chunk_cache_has_chunk_data functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_cache_get_prefetch_statistics(
+     void )
+{
+	uint8_t buffer[ 512 ];
+
+	libcerror_error_t *error          = NULL;
+	libewf_chunk_cache_t *chunk_cache = NULL;
+	libewf_chunk_data_t *chunk_data   = NULL;
+	size_t read_size                  = 0;
+	uint64_t chunk_index              = 0;
+	uint64_t number_of_hits           = 0;
+	uint64_t number_of_wasted         = 0;
+	int result                        = 0;
+
+	/* Initialize test
+	 * A single shard of 4 KiB only holds a few chunks
+	 */
+	result = libewf_chunk_cache_initialize(
+	          &chunk_cache,
+	          1,
+	          4096,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_cache",
+	 chunk_cache );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = ewf_test_chunk_cache_create_chunk_data(
+	          &chunk_data,
+	          0x11,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libewf_chunk_cache_set_chunk_data(
+	          chunk_cache,
+	          0,
+	          chunk_data,
+	          1,
+	          &error );
+
+	chunk_data = NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_cache_has_chunk_data(
+	          chunk_cache,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_cache_has_chunk_data(
+	          chunk_cache,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Reading the prefetched chunk counts as a prefetch hit only once
+	 */
+	for( chunk_index = 0;
+	     chunk_index < 2;
+	     chunk_index++ )
+	{
+		result = libewf_chunk_cache_copy_data(
+		          chunk_cache,
+		          0,
+		          0,
+		          buffer,
+		          512,
+		          &read_size,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Prefetched chunks that are evicted before being read are wasted
+	 */
+	for( chunk_index = 1;
+	     chunk_index < 16;
+	     chunk_index++ )
+	{
+		result = ewf_test_chunk_cache_create_chunk_data(
+		          &chunk_data,
+		          0x22,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		result = libewf_chunk_cache_set_chunk_data(
+		          chunk_cache,
+		          chunk_index,
+		          chunk_data,
+		          1,
+		          &error );
+
+		chunk_data = NULL;
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	result = libewf_chunk_cache_get_prefetch_statistics(
+	          chunk_cache,
+	          &number_of_hits,
+	          &number_of_wasted,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "number_of_hits",
+	 number_of_hits,
+	 (uint64_t) 1 );
+
+	EWF_TEST_ASSERT_GREATER_THAN_INT(
+	 "number_of_wasted",
+	 (int) number_of_wasted,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libewf_chunk_cache_get_prefetch_statistics(
+	          NULL,
+	          &number_of_hits,
+	          &number_of_wasted,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_cache_get_prefetch_statistics(
+	          chunk_cache,
+	          NULL,
+	          &number_of_wasted,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_cache_get_prefetch_statistics(
+	          chunk_cache,
+	          &number_of_hits,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_cache_has_chunk_data(
+	          NULL,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_chunk_cache_free(
+	          &chunk_cache,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_cache",
+	 chunk_cache );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 &chunk_data,
+		 NULL );
+	}
+	if( chunk_cache != NULL )
+	{
+		libewf_chunk_cache_free(
+		 &chunk_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+	EWF_TEST_RUN(
+	 "libewf_chunk_cache_initialize",
+	 ewf_test_chunk_cache_initialize );
+
+	EWF_TEST_RUN(
+	 "libewf_chunk_cache_free",
+	 ewf_test_chunk_cache_free );
+
+	EWF_TEST_RUN(
+	 "libewf_chunk_cache_copy_data",
+	 ewf_test_chunk_cache_copy_data );
+
+	EWF_TEST_RUN(
+	 "libewf_chunk_cache_get_prefetch_statistics",
+	 ewf_test_chunk_cache_get_prefetch_statistics );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+}
+
@@ -0,0 +1,886 @@
+/*
+ * Library chunk_cache_shard type test program
+ *
+ * Copyright (C) 2006-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_memory.h"
+#include "ewf_test_unused.h"
+
+#include "../libewf/libewf_chunk_cache_shard.h"
+#include "../libewf/libewf_chunk_data.h"
+#include "../libewf/libewf_definitions.h"
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+/* Creates chunk data of 512 bytes
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_chunk_cache_shard_create_chunk_data(
+     libewf_chunk_data_t **chunk_data,
+     libcerror_error_t **error )
+{
+	int result = 0;
+
+	result = libewf_chunk_data_initialize(
+	          chunk_data,
+	          512,
+	          1,
+	          error );
+
+	if( result != 1 )
+	{
+		return( -1 );
+	}
+	( *chunk_data )->data_size = 512;
+
+	return( 1 );
+}
+
+/* Adds chunk data of a specific chunk to the chunk cache shard
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_chunk_cache_shard_add_chunk(
+     libewf_chunk_cache_shard_t *chunk_cache_shard,
+     uint64_t chunk_index,
+     libcerror_error_t **error )
+{
+	libewf_chunk_data_t *chunk_data = NULL;
+
+	if( ewf_test_chunk_cache_shard_create_chunk_data(
+	     &chunk_data,
+	     error ) != 1 )
+	{
+		return( -1 );
+	}
+	return( libewf_chunk_cache_shard_set_chunk_data(
+	         chunk_cache_shard,
+	         chunk_index,
+	         chunk_data,
+	         0,
+	         error ) );
+}
+
+/* Tests the libewf_chunk_cache_shard_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_cache_shard_initialize(
+     void )
+{
+	libcerror_error_t *error                      = NULL;
+	libewf_chunk_cache_shard_t *chunk_cache_shard = NULL;
+	int result                                    = 0;
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+	int number_of_malloc_fail_tests               = 2;
+	int number_of_memset_fail_tests               = 2;
+	int test_number                               = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libewf_chunk_cache_shard_initialize(
+	          &chunk_cache_shard,
+	          4096,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_cache_shard",
+	 chunk_cache_shard );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_cache_shard_free(
+	          &chunk_cache_shard,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_cache_shard",
+	 chunk_cache_shard );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_chunk_cache_shard_initialize(
+	          NULL,
+	          4096,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	chunk_cache_shard = (libewf_chunk_cache_shard_t *) 0x12345678UL;
+
+	result = libewf_chunk_cache_shard_initialize(
+	          &chunk_cache_shard,
+	          4096,
+	          &error );
+
+	chunk_cache_shard = NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libewf_chunk_cache_shard_initialize with malloc failing
+		 */
+		ewf_test_malloc_attempts_before_fail = test_number;
+
+		result = libewf_chunk_cache_shard_initialize(
+		          &chunk_cache_shard,
+		          4096,
+		          &error );
+
+		if( ewf_test_malloc_attempts_before_fail != -1 )
+		{
+			ewf_test_malloc_attempts_before_fail = -1;
+
+			if( chunk_cache_shard != NULL )
+			{
+				libewf_chunk_cache_shard_free(
+				 &chunk_cache_shard,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "chunk_cache_shard",
+			 chunk_cache_shard );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libewf_chunk_cache_shard_initialize with memset failing
+		 */
+		ewf_test_memset_attempts_before_fail = test_number;
+
+		result = libewf_chunk_cache_shard_initialize(
+		          &chunk_cache_shard,
+		          4096,
+		          &error );
+
+		if( ewf_test_memset_attempts_before_fail != -1 )
+		{
+			ewf_test_memset_attempts_before_fail = -1;
+
+			if( chunk_cache_shard != NULL )
+			{
+				libewf_chunk_cache_shard_free(
+				 &chunk_cache_shard,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "chunk_cache_shard",
+			 chunk_cache_shard );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_EWF_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( chunk_cache_shard != NULL )
+	{
+		libewf_chunk_cache_shard_free(
+		 &chunk_cache_shard,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_chunk_cache_shard_free function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_cache_shard_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libewf_chunk_cache_shard_free(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_chunk_cache_shard_get_chunk_data and libewf_chunk_cache_shard_set_chunk_data functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_cache_shard_get_chunk_data(
+     void )
+{
+	libcerror_error_t *error                      = NULL;
+	libewf_chunk_cache_entry_t *entry             = NULL;
+	libewf_chunk_cache_shard_t *chunk_cache_shard = NULL;
+	libewf_chunk_data_t *chunk_data               = NULL;
+	int result                                    = 0;
+
+	/* Initialize test
+	 * The shard can hold a single chunk of 512 bytes
+	 */
+	result = libewf_chunk_cache_shard_initialize(
+	          &chunk_cache_shard,
+	          600,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_cache_shard",
+	 chunk_cache_shard );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libewf_chunk_cache_shard_get_chunk_data(
+	          chunk_cache_shard,
+	          1,
+	          &chunk_data,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = ewf_test_chunk_cache_shard_add_chunk(
+	          chunk_cache_shard,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_cache_shard_get_chunk_data(
+	          chunk_cache_shard,
+	          1,
+	          &chunk_data,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_data",
+	 chunk_data );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	chunk_data = NULL;
+
+	/* Chunk 2 does not fit and evicts chunk 1 from the first-in queue
+	 */
+	result = ewf_test_chunk_cache_shard_add_chunk(
+	          chunk_cache_shard,
+	          2,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_cache_shard_get_chunk_data(
+	          chunk_cache_shard,
+	          1,
+	          &chunk_data,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_cache_shard_get_entry(
+	          chunk_cache_shard,
+	          1,
+	          &entry,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "entry->queue_type",
+	 entry->queue_type,
+	 LIBEWF_CHUNK_CACHE_QUEUE_TYPE_GHOST );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Chunk 1 is read again while in the ghost queue and is added to the main queue
+	 */
+	result = ewf_test_chunk_cache_shard_add_chunk(
+	          chunk_cache_shard,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_cache_shard_get_entry(
+	          chunk_cache_shard,
+	          1,
+	          &entry,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "entry->queue_type",
+	 entry->queue_type,
+	 LIBEWF_CHUNK_CACHE_QUEUE_TYPE_MAIN );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Chunks that are read once do not evict chunk 1 from the main queue
+	 */
+	result = ewf_test_chunk_cache_shard_add_chunk(
+	          chunk_cache_shard,
+	          3,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = ewf_test_chunk_cache_shard_add_chunk(
+	          chunk_cache_shard,
+	          4,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_cache_shard_get_chunk_data(
+	          chunk_cache_shard,
+	          1,
+	          &chunk_data,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	chunk_data = NULL;
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "chunk_cache_shard->number_of_hits",
+	 chunk_cache_shard->number_of_hits,
+	 (uint64_t) 2 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "chunk_cache_shard->number_of_misses",
+	 chunk_cache_shard->number_of_misses,
+	 (uint64_t) 2 );
+
+	/* Test error cases
+	 */
+	result = libewf_chunk_cache_shard_get_chunk_data(
+	          NULL,
+	          1,
+	          &chunk_data,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_cache_shard_get_chunk_data(
+	          chunk_cache_shard,
+	          1,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_cache_shard_set_chunk_data(
+	          chunk_cache_shard,
+	          1,
+	          NULL,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_chunk_cache_shard_free(
+	          &chunk_cache_shard,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_cache_shard",
+	 chunk_cache_shard );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( chunk_cache_shard != NULL )
+	{
+		libewf_chunk_cache_shard_free(
+		 &chunk_cache_shard,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_chunk_cache_shard_set_maximum_size function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_cache_shard_set_maximum_size(
+     void )
+{
+	libcerror_error_t *error                      = NULL;
+	libewf_chunk_cache_shard_t *chunk_cache_shard = NULL;
+	libewf_chunk_data_t *chunk_data               = NULL;
+	uint64_t chunk_index                          = 0;
+	int result                                    = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_chunk_cache_shard_initialize(
+	          &chunk_cache_shard,
+	          1024 * 1024,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_cache_shard",
+	 chunk_cache_shard );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Adding more entries than hash buckets resizes the buckets
+	 */
+	for( chunk_index = 0;
+	     chunk_index < 512;
+	     chunk_index += 2 )
+	{
+		result = ewf_test_chunk_cache_shard_add_chunk(
+		          chunk_cache_shard,
+		          chunk_index,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	EWF_TEST_ASSERT_GREATER_THAN_INT(
+	 "chunk_cache_shard->number_of_buckets",
+	 chunk_cache_shard->number_of_buckets,
+	 LIBEWF_CHUNK_CACHE_SHARD_NUMBER_OF_BUCKETS );
+
+	for( chunk_index = 0;
+	     chunk_index < 512;
+	     chunk_index += 2 )
+	{
+		result = libewf_chunk_cache_shard_get_chunk_data(
+		          chunk_cache_shard,
+		          chunk_index,
+		          &chunk_data,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	chunk_data = NULL;
+
+	/* Test regular cases
+	 */
+	result = libewf_chunk_cache_shard_set_maximum_size(
+	          chunk_cache_shard,
+	          4096,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_LESS_THAN_UINT64(
+	 "chunk_cache_shard->first_in_queue.size + chunk_cache_shard->main_queue.size",
+	 (uint64_t) ( chunk_cache_shard->first_in_queue.size + chunk_cache_shard->main_queue.size ),
+	 (uint64_t) 4097 );
+
+	/* A maximum size of 0 disables caching
+	 */
+	result = libewf_chunk_cache_shard_set_maximum_size(
+	          chunk_cache_shard,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = ewf_test_chunk_cache_shard_add_chunk(
+	          chunk_cache_shard,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "chunk_cache_shard->number_of_entries",
+	 chunk_cache_shard->number_of_entries,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libewf_chunk_cache_shard_set_maximum_size(
+	          NULL,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_chunk_cache_shard_free(
+	          &chunk_cache_shard,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_cache_shard",
+	 chunk_cache_shard );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( chunk_cache_shard != NULL )
+	{
+		libewf_chunk_cache_shard_free(
+		 &chunk_cache_shard,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+	EWF_TEST_RUN(
+	 "libewf_chunk_cache_shard_initialize",
+	 ewf_test_chunk_cache_shard_initialize );
+
+	EWF_TEST_RUN(
+	 "libewf_chunk_cache_shard_free",
+	 ewf_test_chunk_cache_shard_free );
+
+	EWF_TEST_RUN(
+	 "libewf_chunk_cache_shard_get_chunk_data",
+	 ewf_test_chunk_cache_shard_get_chunk_data );
+
+	EWF_TEST_RUN(
+	 "libewf_chunk_cache_shard_set_maximum_size",
+	 ewf_test_chunk_cache_shard_set_maximum_size );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+}
+
@@ -39,6 +39,7 @@
 #include "ewf_test_unused.h"
 
 #include "../libewf/libewf_chunk_data.h"
+#include "../libewf/libewf_cpu_features.h"
 #include "../libewf/libewf_definitions.h"
 #include "../libewf/libewf_io_handle.h"
 
@@ -3778,6 +3779,171 @@ on_error:
 	return( 0 );
 }
 
+/* Tests a function that compares a buffer with a repeating 64-bit pattern
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_data_compare_with_64_bit_pattern_function(
+     int (*compare_with_64_bit_pattern)(
+            const uint8_t *data,
+            size_t data_size,
+            uint64_t pattern ) )
+{
+	uint8_t buffer[ 520 ];
+
+	size_t buffer_offset = 0;
+	size_t data_offset   = 0;
+	size_t data_size     = 0;
+	uint64_t pattern     = 0x0807060504030201ULL;
+	int result           = 0;
+
+	/* Initialize test
+	 */
+	for( data_offset = 0;
+	     data_offset < 520;
+	     data_offset++ )
+	{
+		buffer[ data_offset ] = (uint8_t) ( ( data_offset % 8 ) + 1 );
+	}
+	/* Test regular cases with unaligned buffers and sizes that are not a multiple of the vector size
+	 */
+	for( buffer_offset = 0;
+	     buffer_offset < 520;
+	     buffer_offset += 8 )
+	{
+		for( data_size = 0;
+		     ( buffer_offset + data_size ) <= 520;
+		     data_size += 37 )
+		{
+			result = compare_with_64_bit_pattern(
+			          &( buffer[ buffer_offset ] ),
+			          data_size,
+			          pattern );
+
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+		}
+	}
+	for( data_offset = 0;
+	     data_offset < 512;
+	     data_offset += 31 )
+	{
+		buffer[ data_offset ] ^= 0x80;
+
+		result = compare_with_64_bit_pattern(
+		          buffer,
+		          512,
+		          pattern );
+
+		buffer[ data_offset ] ^= 0x80;
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+	}
+	buffer[ 511 ] ^= 0x80;
+
+	result = compare_with_64_bit_pattern(
+	          buffer,
+	          512,
+	          pattern );
+
+	buffer[ 511 ] ^= 0x80;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = compare_with_64_bit_pattern(
+	          &( buffer[ 1 ] ),
+	          512,
+	          pattern );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	return( 1 );
+
+on_error:
+	return( 0 );
+}
+
+/* Tests the libewf_chunk_data_compare_with_64_bit_pattern function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_data_compare_with_64_bit_pattern(
+     void )
+{
+	uint32_t cpu_features = 0;
+	int result            = 0;
+
+	cpu_features = libewf_cpu_features_get_flags();
+
+	result = ewf_test_chunk_data_compare_with_64_bit_pattern_function(
+	          &libewf_chunk_data_compare_with_64_bit_pattern );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = ewf_test_chunk_data_compare_with_64_bit_pattern_function(
+	          &libewf_chunk_data_compare_with_64_bit_pattern_scalar );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+#if defined( HAVE_LIBEWF_SSE2_SUPPORT )
+	if( ( cpu_features & LIBEWF_CPU_FEATURE_FLAG_SSE2 ) != 0 )
+	{
+		result = ewf_test_chunk_data_compare_with_64_bit_pattern_function(
+		          &libewf_chunk_data_compare_with_64_bit_pattern_sse2 );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+	}
+#endif
+#if defined( HAVE_LIBEWF_AVX2_SUPPORT )
+	if( ( cpu_features & LIBEWF_CPU_FEATURE_FLAG_AVX2 ) != 0 )
+	{
+		result = ewf_test_chunk_data_compare_with_64_bit_pattern_function(
+		          &libewf_chunk_data_compare_with_64_bit_pattern_avx2 );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+	}
+#endif
+#if defined( HAVE_LIBEWF_NEON_SUPPORT )
+	if( ( cpu_features & LIBEWF_CPU_FEATURE_FLAG_NEON ) != 0 )
+	{
+		result = ewf_test_chunk_data_compare_with_64_bit_pattern_function(
+		          &libewf_chunk_data_compare_with_64_bit_pattern_neon );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+	}
+#endif
+	( void ) cpu_features;
+
+	return( 1 );
+
+on_error:
+	return( 0 );
+}
+
 /* Tests the libewf_chunk_data_write function
  * Returns 1 if successful or 0 if not
  */
@@ -4445,6 +4611,7 @@ int ewf_test_chunk_data_read_from_file_io_pool(
 	libbfio_pool_t *file_io_pool    = NULL;
 	libcerror_error_t *error        = NULL;
 	libewf_chunk_data_t *chunk_data = NULL;
+	off64_t offset                  = 0;
 	ssize_t read_count              = 0;
 	int result                      = 0;
 
@@ -4513,6 +4680,28 @@ int ewf_test_chunk_data_read_from_file_io_pool(
 	 "error",
 	 error );
 
+	/* Test if the current offset is not changed by the read
+	 */
+	result = libbfio_pool_get_offset(
+	          file_io_pool,
+	          0,
+	          &offset,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 (int64_t) offset,
+	 (int64_t) 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
 	/* Test error cases
 	 */
 	read_count = libewf_chunk_data_read_from_file_io_pool(
@@ -4578,7 +4767,7 @@ int ewf_test_chunk_data_read_from_file_io_pool(
 	libcerror_error_free(
 	 &error );
 
-	/* Test libewf_chunk_data_read_from_file_io_pool with libbfio_pool_read_buffer_at_offset failing
+	/* Test libewf_chunk_data_read_from_file_io_pool with libbfio_pool_pread_buffer failing
 	 */
 	read_count = libewf_chunk_data_read_from_file_io_pool(
 	              chunk_data,
@@ -4658,6 +4847,299 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libewf_chunk_data_read_vector_from_file_io_pool function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_data_read_vector_from_file_io_pool(
+     void )
+{
+	uint8_t file_data[ 512 ];
+
+	libewf_chunk_data_t *chunks_data[ 2 ] = { NULL, NULL };
+	libbfio_pool_t *file_io_pool          = NULL;
+	libcerror_error_t *error              = NULL;
+	size64_t chunks_data_size[ 2 ]        = { 256, 256 };
+	off64_t chunks_data_offset[ 2 ]       = { 0, 256 };
+	ssize_t read_count                    = 0;
+	uint32_t chunks_data_flags[ 2 ]       = { 0, 0 };
+	int chunks_data_index                 = 0;
+	int result                            = 0;
+
+	/* Initialize test
+	 */
+	for( chunks_data_index = 0;
+	     chunks_data_index < 2;
+	     chunks_data_index++ )
+	{
+		result = libewf_chunk_data_initialize(
+		          &( chunks_data[ chunks_data_index ] ),
+		          256,
+		          1,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NOT_NULL(
+		 "chunks_data[ chunks_data_index ]",
+		 chunks_data[ chunks_data_index ] );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Initialize file IO pool
+	 */
+	result = ewf_test_open_file_io_pool(
+	          &file_io_pool,
+	          file_data,
+	          512,
+	          LIBBFIO_OPEN_READ,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_pool",
+	 file_io_pool );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	read_count = libewf_chunk_data_read_vector_from_file_io_pool(
+	              chunks_data,
+	              2,
+	              file_io_pool,
+	              0,
+	              chunks_data_offset,
+	              chunks_data_size,
+	              chunks_data_flags,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 512 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "chunks_data[ 1 ]->data_size",
+	 chunks_data[ 1 ]->data_size,
+	 (size_t) 256 );
+
+	/* Test error cases
+	 */
+	read_count = libewf_chunk_data_read_vector_from_file_io_pool(
+	              NULL,
+	              2,
+	              file_io_pool,
+	              0,
+	              chunks_data_offset,
+	              chunks_data_size,
+	              chunks_data_flags,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libewf_chunk_data_read_vector_from_file_io_pool(
+	              chunks_data,
+	              0,
+	              file_io_pool,
+	              0,
+	              chunks_data_offset,
+	              chunks_data_size,
+	              chunks_data_flags,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libewf_chunk_data_read_vector_from_file_io_pool(
+	              chunks_data,
+	              2,
+	              file_io_pool,
+	              0,
+	              NULL,
+	              chunks_data_size,
+	              chunks_data_flags,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libewf_chunk_data_read_vector_from_file_io_pool(
+	              chunks_data,
+	              2,
+	              file_io_pool,
+	              0,
+	              chunks_data_offset,
+	              NULL,
+	              chunks_data_flags,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libewf_chunk_data_read_vector_from_file_io_pool(
+	              chunks_data,
+	              2,
+	              file_io_pool,
+	              0,
+	              chunks_data_offset,
+	              chunks_data_size,
+	              NULL,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test libewf_chunk_data_read_vector_from_file_io_pool with a read beyond the end of the data
+	 */
+	chunks_data_offset[ 1 ] = 384;
+
+	read_count = libewf_chunk_data_read_vector_from_file_io_pool(
+	              chunks_data,
+	              2,
+	              file_io_pool,
+	              0,
+	              chunks_data_offset,
+	              chunks_data_size,
+	              chunks_data_flags,
+	              &error );
+
+	chunks_data_offset[ 1 ] = 256;
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up file IO pool
+	 */
+	result = ewf_test_close_file_io_pool(
+	          &file_io_pool,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Clean up
+	 */
+	for( chunks_data_index = 0;
+	     chunks_data_index < 2;
+	     chunks_data_index++ )
+	{
+		result = libewf_chunk_data_free(
+		          &( chunks_data[ chunks_data_index ] ),
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( file_io_pool != NULL )
+	{
+		libbfio_pool_free(
+		 &file_io_pool,
+		 NULL );
+	}
+	for( chunks_data_index = 0;
+	     chunks_data_index < 2;
+	     chunks_data_index++ )
+	{
+		if( chunks_data[ chunks_data_index ] != NULL )
+		{
+			libewf_chunk_data_free(
+			 &( chunks_data[ chunks_data_index ] ),
+			 NULL );
+		}
+	}
+	return( 0 );
+}
+
 /* Tests the libewf_chunk_data_read_element_data function
  * Returns 1 if successful or 0 if not
  */
@@ -5001,6 +5483,10 @@ int main(
 	 "libewf_chunk_data_check_for_64_bit_pattern_fill",
 	 ewf_test_chunk_data_check_for_64_bit_pattern_fill );
 
+	EWF_TEST_RUN(
+	 "libewf_chunk_data_compare_with_64_bit_pattern",
+	 ewf_test_chunk_data_compare_with_64_bit_pattern );
+
 	EWF_TEST_RUN(
 	 "libewf_chunk_data_write",
 	 ewf_test_chunk_data_write );
@@ -5017,6 +5503,10 @@ int main(
 	 "libewf_chunk_data_read_from_file_io_pool",
 	 ewf_test_chunk_data_read_from_file_io_pool );
 
+	EWF_TEST_RUN(
+	 "libewf_chunk_data_read_vector_from_file_io_pool",
+	 ewf_test_chunk_data_read_vector_from_file_io_pool );
+
 	EWF_TEST_RUN(
 	 "libewf_chunk_data_read_element_data",
 	 ewf_test_chunk_data_read_element_data );
@@ -35,6 +35,7 @@
 #include "ewf_test_unused.h"
 
 #include "../libewf/libewf_chunk_group.h"
+#include "../libewf/libewf_definitions.h"
 #include "../libewf/libewf_section_descriptor.h"
 
 #if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
@@ -1604,6 +1605,381 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libewf_chunk_group_get_chunk_data_range function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_group_get_chunk_data_range(
+     void )
+{
+	uint8_t table_entries_data[ 16 ] = {
+		0x00, 0x01, 0x00, 0x00, 0x00, 0x02, 0x00, 0x80, 0x00, 0x03, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00 };
+
+	libcerror_error_t *error                   = NULL;
+	libewf_chunk_group_t *chunk_group          = NULL;
+	libewf_io_handle_t *io_handle              = NULL;
+	libewf_section_descriptor_t *table_section = NULL;
+	size64_t chunk_data_size                   = 0;
+	size64_t mapped_range_size                 = 0;
+	off64_t chunk_data_offset                  = 0;
+	off64_t mapped_range_offset                = 0;
+	uint32_t range_flags                       = 0;
+	int file_io_pool_entry                     = 0;
+	int number_of_chunks                       = 0;
+	int result                                 = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_group_initialize(
+	          &chunk_group,
+	          io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_group",
+	 chunk_group );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_section_descriptor_initialize(
+	          &table_section,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "table_section",
+	 table_section );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	table_section->start_offset = 0;
+	table_section->end_offset   = 0x00000500UL;
+
+	result = libewf_chunk_group_fill_v1(
+	          chunk_group,
+	          0,
+	          32768,
+	          3,
+	          table_section,
+	          0x00001000UL,
+	          4,
+	          table_entries_data,
+	          16,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libewf_chunk_group_get_number_of_chunks(
+	          chunk_group,
+	          &number_of_chunks,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_chunks",
+	 number_of_chunks,
+	 4 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_group_get_chunk_data_range(
+	          chunk_group,
+	          1,
+	          &file_io_pool_entry,
+	          &chunk_data_offset,
+	          &chunk_data_size,
+	          &range_flags,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "file_io_pool_entry",
+	 file_io_pool_entry,
+	 3 );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "chunk_data_offset",
+	 (int64_t) chunk_data_offset,
+	 (int64_t) 0x00001200UL );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "chunk_data_size",
+	 (uint64_t) chunk_data_size,
+	 (uint64_t) 0x00000100UL );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "range_flags",
+	 range_flags,
+	 (uint32_t) LIBEWF_RANGE_FLAG_IS_COMPRESSED );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_group_get_chunk_mapped_range(
+	          chunk_group,
+	          2,
+	          &mapped_range_offset,
+	          &mapped_range_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "mapped_range_offset",
+	 (int64_t) mapped_range_offset,
+	 (int64_t) 65536 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "mapped_range_size",
+	 (uint64_t) mapped_range_size,
+	 (uint64_t) 32768 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_chunk_group_get_chunk_data_range(
+	          NULL,
+	          1,
+	          &file_io_pool_entry,
+	          &chunk_data_offset,
+	          &chunk_data_size,
+	          &range_flags,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_group_get_chunk_data_range(
+	          chunk_group,
+	          4,
+	          &file_io_pool_entry,
+	          &chunk_data_offset,
+	          &chunk_data_size,
+	          &range_flags,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_group_get_chunk_data_range(
+	          chunk_group,
+	          1,
+	          NULL,
+	          &chunk_data_offset,
+	          &chunk_data_size,
+	          &range_flags,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_group_get_chunk_mapped_range(
+	          chunk_group,
+	          -1,
+	          &mapped_range_offset,
+	          &mapped_range_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test error case where the chunks are stored in another file IO pool entry
+	 */
+	result = libewf_chunk_group_set_chunk_data_range(
+	          chunk_group,
+	          1,
+	          2,
+	          0x00001200UL,
+	          0x00000100UL,
+	          LIBEWF_RANGE_FLAG_IS_COMPRESSED,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_section_descriptor_free(
+	          &table_section,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "table_section",
+	 table_section );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_group_free(
+	          &chunk_group,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_group",
+	 chunk_group );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "io_handle",
+	 io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( table_section != NULL )
+	{
+		libewf_section_descriptor_free(
+		 &table_section,
+		 NULL );
+	}
+	if( chunk_group != NULL )
+	{
+		libewf_chunk_group_free(
+		 &chunk_group,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libewf_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
 #endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
 
 /* The main program
@@ -1651,6 +2027,10 @@ int main(
 	 "libewf_chunk_group_correct_v1",
 	 ewf_test_chunk_group_correct_v1 );
 
+	EWF_TEST_RUN(
+	 "libewf_chunk_group_get_chunk_data_range",
+	 ewf_test_chunk_group_get_chunk_data_range );
+
 #endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
 
 	return( EXIT_SUCCESS );
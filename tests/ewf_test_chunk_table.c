@@ -34,8 +34,10 @@
 #include "ewf_test_memory.h"
 #include "ewf_test_unused.h"
 
+#include "../libewf/libewf_chunk_data.h"
 #include "../libewf/libewf_chunk_table.h"
 #include "../libewf/libewf_io_handle.h"
+#include "../libewf/libewf_media_values.h"
 
 #if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
 
@@ -1581,6 +1583,437 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libewf_chunk_table_get_chunk_data_range_by_offset function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_table_get_chunk_data_range_by_offset(
+     void )
+{
+	libcerror_error_t *error              = NULL;
+	libewf_chunk_data_t *chunk_data       = NULL;
+	libewf_chunk_table_t *chunk_table     = NULL;
+	libewf_io_handle_t *io_handle         = NULL;
+	libewf_media_values_t *media_values   = NULL;
+	off64_t chunk_data_offset             = 0;
+	size64_t chunk_data_size              = 0;
+	uint32_t chunk_data_flags             = 0;
+	int file_io_pool_entry                = 0;
+	int result                            = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_media_values_initialize(
+	          &media_values,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "media_values",
+	 media_values );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_table_initialize(
+	          &chunk_table,
+	          io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_table",
+	 chunk_table );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+/* TODO implement */
+
+	/* Test error cases
+	 */
+	result = libewf_chunk_table_get_chunk_data_range_by_offset(
+	          NULL,
+	          io_handle,
+	          NULL,
+	          media_values,
+	          NULL,
+	          0,
+	          &chunk_data,
+	          &file_io_pool_entry,
+	          &chunk_data_offset,
+	          &chunk_data_size,
+	          &chunk_data_flags,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_table_get_chunk_data_range_by_offset(
+	          chunk_table,
+	          NULL,
+	          NULL,
+	          media_values,
+	          NULL,
+	          0,
+	          &chunk_data,
+	          &file_io_pool_entry,
+	          &chunk_data_offset,
+	          &chunk_data_size,
+	          &chunk_data_flags,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_table_get_chunk_data_range_by_offset(
+	          chunk_table,
+	          io_handle,
+	          NULL,
+	          NULL,
+	          NULL,
+	          0,
+	          &chunk_data,
+	          &file_io_pool_entry,
+	          &chunk_data_offset,
+	          &chunk_data_size,
+	          &chunk_data_flags,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_table_get_chunk_data_range_by_offset(
+	          chunk_table,
+	          io_handle,
+	          NULL,
+	          media_values,
+	          NULL,
+	          -1,
+	          &chunk_data,
+	          &file_io_pool_entry,
+	          &chunk_data_offset,
+	          &chunk_data_size,
+	          &chunk_data_flags,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_table_get_chunk_data_range_by_offset(
+	          chunk_table,
+	          io_handle,
+	          NULL,
+	          media_values,
+	          NULL,
+	          0,
+	          NULL,
+	          &file_io_pool_entry,
+	          &chunk_data_offset,
+	          &chunk_data_size,
+	          &chunk_data_flags,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_table_get_chunk_data_range_by_offset(
+	          chunk_table,
+	          io_handle,
+	          NULL,
+	          media_values,
+	          NULL,
+	          0,
+	          &chunk_data,
+	          NULL,
+	          &chunk_data_offset,
+	          &chunk_data_size,
+	          &chunk_data_flags,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_table_get_chunk_data_range_by_offset(
+	          chunk_table,
+	          io_handle,
+	          NULL,
+	          media_values,
+	          NULL,
+	          0,
+	          &chunk_data,
+	          &file_io_pool_entry,
+	          NULL,
+	          &chunk_data_size,
+	          &chunk_data_flags,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_table_get_chunk_data_range_by_offset(
+	          chunk_table,
+	          io_handle,
+	          NULL,
+	          media_values,
+	          NULL,
+	          0,
+	          &chunk_data,
+	          &file_io_pool_entry,
+	          &chunk_data_offset,
+	          NULL,
+	          &chunk_data_flags,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_table_get_chunk_data_range_by_offset(
+	          chunk_table,
+	          io_handle,
+	          NULL,
+	          media_values,
+	          NULL,
+	          0,
+	          &chunk_data,
+	          &file_io_pool_entry,
+	          &chunk_data_offset,
+	          &chunk_data_size,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test libewf_chunk_table_get_chunk_data_range_by_offset without a segment table
+	 */
+	result = libewf_chunk_table_get_chunk_data_range_by_offset(
+	          chunk_table,
+	          io_handle,
+	          NULL,
+	          media_values,
+	          NULL,
+	          0,
+	          &chunk_data,
+	          &file_io_pool_entry,
+	          &chunk_data_offset,
+	          &chunk_data_size,
+	          &chunk_data_flags,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_data",
+	 chunk_data );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_chunk_table_free(
+	          &chunk_table,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_table",
+	 chunk_table );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_media_values_free(
+	          &media_values,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "media_values",
+	 media_values );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "io_handle",
+	 io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 &chunk_data,
+		 NULL );
+	}
+	if( chunk_table != NULL )
+	{
+		libewf_chunk_table_free(
+		 &chunk_table,
+		 NULL );
+	}
+	if( media_values != NULL )
+	{
+		libewf_media_values_free(
+		 &media_values,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libewf_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
 #endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
 
 /* The main program
@@ -1632,6 +2065,10 @@ int main(
 	 "libewf_chunk_table_get_chunk_data_by_offset",
 	 ewf_test_chunk_table_get_chunk_data_by_offset );
 
+	EWF_TEST_RUN(
+	 "libewf_chunk_table_get_chunk_data_range_by_offset",
+	 ewf_test_chunk_table_get_chunk_data_range_by_offset );
+
 #endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
 
 	return( EXIT_SUCCESS );
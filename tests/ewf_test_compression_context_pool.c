@@ -0,0 +1,825 @@
+/*
+ * Library compression_context_pool type test program
+ *
+ * Copyright (C) 2006-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_unused.h"
+
+#include "../libewf/libewf_compression_context.h"
+#include "../libewf/libewf_compression_context_pool.h"
+#include "../libewf/libewf_definitions.h"
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+/* Tests the libewf_compression_context_pool_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_compression_context_pool_initialize(
+     void )
+{
+	libcerror_error_t *error                                    = NULL;
+	libewf_compression_context_pool_t *compression_context_pool = NULL;
+	int result                                                  = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_compression_context_pool_initialize(
+	          &compression_context_pool,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "compression_context_pool",
+	 compression_context_pool );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_compression_context_pool_free(
+	          &compression_context_pool,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "compression_context_pool",
+	 compression_context_pool );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_compression_context_pool_initialize(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	compression_context_pool = (libewf_compression_context_pool_t *) 0x12345678UL;
+
+	result = libewf_compression_context_pool_initialize(
+	          &compression_context_pool,
+	          &error );
+
+	compression_context_pool = NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( compression_context_pool != NULL )
+	{
+		libewf_compression_context_pool_free(
+		 &compression_context_pool,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_compression_context_pool_free function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_compression_context_pool_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libewf_compression_context_pool_free(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_compression_context_pool_grab_context and libewf_compression_context_pool_release_context functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_compression_context_pool_grab_context(
+     void )
+{
+	libcerror_error_t *error                                    = NULL;
+	libewf_compression_context_t *compression_context1          = NULL;
+	libewf_compression_context_t *compression_context2          = NULL;
+	libewf_compression_context_t *released_compression_context  = NULL;
+	libewf_compression_context_pool_t *compression_context_pool = NULL;
+	int result                                                  = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_compression_context_pool_initialize(
+	          &compression_context_pool,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "compression_context_pool",
+	 compression_context_pool );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libewf_compression_context_pool_grab_context(
+	          compression_context_pool,
+	          &compression_context1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "compression_context1",
+	 compression_context1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that a context in use is not handed out twice
+	 */
+	result = libewf_compression_context_pool_grab_context(
+	          compression_context_pool,
+	          &compression_context2,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "compression_context2",
+	 compression_context2 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_NOT_EQUAL_INT64(
+	 "compression_context2",
+	 (int64_t) (intptr_t) compression_context2,
+	 (int64_t) (intptr_t) compression_context1 );
+
+	/* Test that a released context is reused
+	 */
+	released_compression_context = compression_context2;
+
+	result = libewf_compression_context_pool_release_context(
+	          compression_context_pool,
+	          &compression_context2,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "compression_context2",
+	 compression_context2 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_compression_context_pool_grab_context(
+	          compression_context_pool,
+	          &compression_context2,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "compression_context2",
+	 (int64_t) (intptr_t) compression_context2,
+	 (int64_t) (intptr_t) released_compression_context );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_compression_context_pool_release_context(
+	          compression_context_pool,
+	          &compression_context2,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_compression_context_pool_release_context(
+	          compression_context_pool,
+	          &compression_context1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_compression_context_pool_grab_context(
+	          NULL,
+	          &compression_context1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_compression_context_pool_grab_context(
+	          compression_context_pool,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_compression_context_pool_release_context(
+	          NULL,
+	          &compression_context1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_compression_context_pool_free(
+	          &compression_context_pool,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "compression_context_pool",
+	 compression_context_pool );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( compression_context2 != NULL )
+	{
+		libewf_compression_context_free(
+		 &compression_context2,
+		 NULL );
+	}
+	if( compression_context1 != NULL )
+	{
+		libewf_compression_context_free(
+		 &compression_context1,
+		 NULL );
+	}
+	if( compression_context_pool != NULL )
+	{
+		libewf_compression_context_pool_free(
+		 &compression_context_pool,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_compression_context_pool_grab_buffer and libewf_compression_context_pool_release_buffer functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_compression_context_pool_grab_buffer(
+     void )
+{
+	uint8_t *buffers[ LIBEWF_MAXIMUM_NUMBER_OF_POOLED_BUFFERS + 1 ];
+
+	libcerror_error_t *error                                    = NULL;
+	libewf_compression_context_pool_t *compression_context_pool = NULL;
+	uint8_t *buffer                                             = NULL;
+	uint8_t *released_buffer                                    = NULL;
+	size_t buffer_size                                          = 0;
+	int buffer_index                                            = 0;
+	int result                                                  = 0;
+
+	for( buffer_index = 0;
+	     buffer_index <= LIBEWF_MAXIMUM_NUMBER_OF_POOLED_BUFFERS;
+	     buffer_index++ )
+	{
+		buffers[ buffer_index ] = NULL;
+	}
+	/* Initialize test
+	 */
+	result = libewf_compression_context_pool_initialize(
+	          &compression_context_pool,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "compression_context_pool",
+	 compression_context_pool );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libewf_compression_context_pool_grab_buffer(
+	          compression_context_pool,
+	          1024,
+	          &buffer,
+	          &buffer_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "buffer",
+	 buffer );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "buffer_size",
+	 buffer_size,
+	 (size_t) 1024 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	released_buffer = buffer;
+
+	result = libewf_compression_context_pool_release_buffer(
+	          compression_context_pool,
+	          &buffer,
+	          buffer_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "buffer",
+	 buffer );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that a pooled buffer that is too small is not handed out
+	 */
+	result = libewf_compression_context_pool_grab_buffer(
+	          compression_context_pool,
+	          2048,
+	          &buffer,
+	          &buffer_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "buffer",
+	 buffer );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "buffer_size",
+	 buffer_size,
+	 (size_t) 2048 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	memory_free(
+	 buffer );
+
+	buffer = NULL;
+
+	/* Test that a pooled buffer that is large enough is reused
+	 */
+	result = libewf_compression_context_pool_grab_buffer(
+	          compression_context_pool,
+	          512,
+	          &buffer,
+	          &buffer_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "buffer",
+	 (int64_t) (intptr_t) buffer,
+	 (int64_t) (intptr_t) released_buffer );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "buffer_size",
+	 buffer_size,
+	 (size_t) 1024 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	memory_free(
+	 buffer );
+
+	buffer = NULL;
+
+	/* Test that buffers are freed when the pool is full
+	 */
+	for( buffer_index = 0;
+	     buffer_index <= LIBEWF_MAXIMUM_NUMBER_OF_POOLED_BUFFERS;
+	     buffer_index++ )
+	{
+		result = libewf_compression_context_pool_grab_buffer(
+		          compression_context_pool,
+		          64,
+		          &( buffers[ buffer_index ] ),
+		          &buffer_size,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	for( buffer_index = 0;
+	     buffer_index <= LIBEWF_MAXIMUM_NUMBER_OF_POOLED_BUFFERS;
+	     buffer_index++ )
+	{
+		result = libewf_compression_context_pool_release_buffer(
+		          compression_context_pool,
+		          &( buffers[ buffer_index ] ),
+		          64,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "buffers[ buffer_index ]",
+		 buffers[ buffer_index ] );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "compression_context_pool->number_of_buffers",
+	 compression_context_pool->number_of_buffers,
+	 LIBEWF_MAXIMUM_NUMBER_OF_POOLED_BUFFERS );
+
+	/* Test error cases
+	 */
+	result = libewf_compression_context_pool_grab_buffer(
+	          NULL,
+	          64,
+	          &buffer,
+	          &buffer_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_compression_context_pool_grab_buffer(
+	          compression_context_pool,
+	          0,
+	          &buffer,
+	          &buffer_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_compression_context_pool_grab_buffer(
+	          compression_context_pool,
+	          64,
+	          NULL,
+	          &buffer_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_compression_context_pool_grab_buffer(
+	          compression_context_pool,
+	          64,
+	          &buffer,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_compression_context_pool_release_buffer(
+	          NULL,
+	          &buffer,
+	          64,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_compression_context_pool_free(
+	          &compression_context_pool,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "compression_context_pool",
+	 compression_context_pool );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	for( buffer_index = 0;
+	     buffer_index <= LIBEWF_MAXIMUM_NUMBER_OF_POOLED_BUFFERS;
+	     buffer_index++ )
+	{
+		if( buffers[ buffer_index ] != NULL )
+		{
+			memory_free(
+			 buffers[ buffer_index ] );
+		}
+	}
+	if( buffer != NULL )
+	{
+		memory_free(
+		 buffer );
+	}
+	if( compression_context_pool != NULL )
+	{
+		libewf_compression_context_pool_free(
+		 &compression_context_pool,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+	EWF_TEST_RUN(
+	 "libewf_compression_context_pool_initialize",
+	 ewf_test_compression_context_pool_initialize );
+
+	EWF_TEST_RUN(
+	 "libewf_compression_context_pool_free",
+	 ewf_test_compression_context_pool_free );
+
+	EWF_TEST_RUN(
+	 "libewf_compression_context_pool_grab_context",
+	 ewf_test_compression_context_pool_grab_context );
+
+	EWF_TEST_RUN(
+	 "libewf_compression_context_pool_grab_buffer",
+	 ewf_test_compression_context_pool_grab_buffer );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+}
+
@@ -0,0 +1,778 @@
+/*
+ * Library compression_estimator type test program
+ *
+ * Copyright (C) 2006-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_unused.h"
+
+#include "../libewf/libewf_compression_estimator.h"
+#include "../libewf/libewf_definitions.h"
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+/* Fills a buffer with pseudo random data
+ */
+void ewf_test_compression_estimator_fill_random(
+      uint8_t *data,
+      size_t data_size )
+{
+	size_t data_offset = 0;
+	uint32_t value     = 0x12345678UL;
+
+	for( data_offset = 0;
+	     data_offset < data_size;
+	     data_offset++ )
+	{
+		value ^= value << 13;
+		value ^= value >> 17;
+		value ^= value << 5;
+
+		data[ data_offset ] = (uint8_t) ( value >> 24 );
+	}
+}
+
+/* Tests the libewf_compression_estimator_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_compression_estimator_initialize(
+     void )
+{
+	libcerror_error_t *error                              = NULL;
+	libewf_compression_estimator_t *compression_estimator = NULL;
+	int result                                            = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_compression_estimator_initialize(
+	          &compression_estimator,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "compression_estimator",
+	 compression_estimator );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_compression_estimator_free(
+	          &compression_estimator,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "compression_estimator",
+	 compression_estimator );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_compression_estimator_initialize(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	compression_estimator = (libewf_compression_estimator_t *) 0x12345678UL;
+
+	result = libewf_compression_estimator_initialize(
+	          &compression_estimator,
+	          &error );
+
+	compression_estimator = NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( compression_estimator != NULL )
+	{
+		libewf_compression_estimator_free(
+		 &compression_estimator,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_compression_estimator_free function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_compression_estimator_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libewf_compression_estimator_free(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_compression_estimator_test_entropy function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_compression_estimator_test_entropy(
+     void )
+{
+	uint8_t data[ 32768 ];
+
+	libcerror_error_t *error = NULL;
+	size_t data_offset       = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	ewf_test_compression_estimator_fill_random(
+	 data,
+	 32768 );
+
+	result = libewf_compression_estimator_test_entropy(
+	          data,
+	          32768,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_compression_estimator_test_entropy(
+	          data,
+	          1024,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that small data is always considered compressible
+	 */
+	result = libewf_compression_estimator_test_entropy(
+	          data,
+	          512,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that text like data is considered compressible
+	 */
+	for( data_offset = 0;
+	     data_offset < 32768;
+	     data_offset++ )
+	{
+		data[ data_offset ] = (uint8_t) ( 'a' + ( data[ data_offset ] % 26 ) );
+	}
+	result = libewf_compression_estimator_test_entropy(
+	          data,
+	          32768,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that random data with a zero filled tail is considered compressible
+	 */
+	ewf_test_compression_estimator_fill_random(
+	 data,
+	 16384 );
+
+	if( memory_set(
+	     &( data[ 16384 ] ),
+	     0,
+	     16384 ) == NULL )
+	{
+		goto on_error;
+	}
+	result = libewf_compression_estimator_test_entropy(
+	          data,
+	          32768,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_compression_estimator_test_entropy(
+	          NULL,
+	          32768,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_compression_estimator_test_entropy(
+	          data,
+	          (size_t) SSIZE_MAX + 1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_compression_estimator_check_data, libewf_compression_estimator_update and libewf_compression_estimator_get_statistics functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_compression_estimator_check_data(
+     void )
+{
+	uint8_t data[ 32768 ];
+
+	libcerror_error_t *error                              = NULL;
+	libewf_compression_estimator_t *compression_estimator = NULL;
+	uint64_t number_of_adaptive_skips                     = 0;
+	uint64_t number_of_entropy_skips                      = 0;
+	int chunk_index                                       = 0;
+	int result                                            = 0;
+
+	/* Initialize test
+	 */
+	ewf_test_compression_estimator_fill_random(
+	 data,
+	 32768 );
+
+	result = libewf_compression_estimator_initialize(
+	          &compression_estimator,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "compression_estimator",
+	 compression_estimator );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that data is always compressed without estimator flags
+	 */
+	result = libewf_compression_estimator_check_data(
+	          compression_estimator,
+	          0,
+	          data,
+	          32768,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test the entropy test
+	 */
+	result = libewf_compression_estimator_check_data(
+	          compression_estimator,
+	          LIBEWF_COMPRESS_FLAG_USE_ENTROPY_TEST,
+	          data,
+	          32768,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that adaptive compression skips chunks after a run of incompressible chunks
+	 */
+	for( chunk_index = 0;
+	     chunk_index < LIBEWF_COMPRESSION_ESTIMATOR_INCOMPRESSIBLE_THRESHOLD;
+	     chunk_index++ )
+	{
+		result = libewf_compression_estimator_check_data(
+		          compression_estimator,
+		          LIBEWF_COMPRESS_FLAG_USE_ADAPTIVE_COMPRESSION,
+		          data,
+		          32768,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libewf_compression_estimator_update(
+		          compression_estimator,
+		          LIBEWF_COMPRESS_FLAG_USE_ADAPTIVE_COMPRESSION,
+		          0,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	for( chunk_index = 0;
+	     chunk_index < LIBEWF_COMPRESSION_ESTIMATOR_MINIMUM_SKIP_INTERVAL;
+	     chunk_index++ )
+	{
+		result = libewf_compression_estimator_check_data(
+		          compression_estimator,
+		          LIBEWF_COMPRESS_FLAG_USE_ADAPTIVE_COMPRESSION,
+		          data,
+		          32768,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test that compression is probed again after the skip interval
+	 */
+	result = libewf_compression_estimator_check_data(
+	          compression_estimator,
+	          LIBEWF_COMPRESS_FLAG_USE_ADAPTIVE_COMPRESSION,
+	          data,
+	          32768,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that a failed probe doubles the skip interval
+	 */
+	result = libewf_compression_estimator_update(
+	          compression_estimator,
+	          LIBEWF_COMPRESS_FLAG_USE_ADAPTIVE_COMPRESSION,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "compression_estimator->number_of_chunks_to_skip",
+	 compression_estimator->number_of_chunks_to_skip,
+	 (uint32_t) ( 2 * LIBEWF_COMPRESSION_ESTIMATOR_MINIMUM_SKIP_INTERVAL ) );
+
+	/* Test that a compressible chunk resets the adaptive compression state
+	 */
+	compression_estimator->number_of_chunks_to_skip = 0;
+
+	result = libewf_compression_estimator_update(
+	          compression_estimator,
+	          LIBEWF_COMPRESS_FLAG_USE_ADAPTIVE_COMPRESSION,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "compression_estimator->number_of_incompressible_chunks",
+	 compression_estimator->number_of_incompressible_chunks,
+	 0 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "compression_estimator->skip_interval",
+	 compression_estimator->skip_interval,
+	 (uint32_t) LIBEWF_COMPRESSION_ESTIMATOR_MINIMUM_SKIP_INTERVAL );
+
+	result = libewf_compression_estimator_get_statistics(
+	          compression_estimator,
+	          &number_of_entropy_skips,
+	          &number_of_adaptive_skips,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "number_of_entropy_skips",
+	 number_of_entropy_skips,
+	 (uint64_t) 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "number_of_adaptive_skips",
+	 number_of_adaptive_skips,
+	 (uint64_t) LIBEWF_COMPRESSION_ESTIMATOR_MINIMUM_SKIP_INTERVAL );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_compression_estimator_check_data(
+	          NULL,
+	          LIBEWF_COMPRESS_FLAG_USE_ENTROPY_TEST,
+	          data,
+	          32768,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_compression_estimator_check_data(
+	          compression_estimator,
+	          LIBEWF_COMPRESS_FLAG_USE_ENTROPY_TEST,
+	          NULL,
+	          32768,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_compression_estimator_update(
+	          NULL,
+	          LIBEWF_COMPRESS_FLAG_USE_ADAPTIVE_COMPRESSION,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_compression_estimator_get_statistics(
+	          NULL,
+	          &number_of_entropy_skips,
+	          &number_of_adaptive_skips,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_compression_estimator_get_statistics(
+	          compression_estimator,
+	          NULL,
+	          &number_of_adaptive_skips,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_compression_estimator_get_statistics(
+	          compression_estimator,
+	          &number_of_entropy_skips,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_compression_estimator_free(
+	          &compression_estimator,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "compression_estimator",
+	 compression_estimator );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( compression_estimator != NULL )
+	{
+		libewf_compression_estimator_free(
+		 &compression_estimator,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+	EWF_TEST_RUN(
+	 "libewf_compression_estimator_initialize",
+	 ewf_test_compression_estimator_initialize );
+
+	EWF_TEST_RUN(
+	 "libewf_compression_estimator_free",
+	 ewf_test_compression_estimator_free );
+
+	EWF_TEST_RUN(
+	 "libewf_compression_estimator_test_entropy",
+	 ewf_test_compression_estimator_test_entropy );
+
+	EWF_TEST_RUN(
+	 "libewf_compression_estimator_check_data",
+	 ewf_test_compression_estimator_check_data );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+}
+
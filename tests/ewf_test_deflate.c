@@ -1142,13 +1142,18 @@ on_error:
 int ewf_test_deflate_bit_stream_get_huffman_encoded_value(
      void )
 {
+	uint8_t long_codes_byte_stream[ 2 ] = { 0xff, 0xff };
+	uint16_t code_size_array[ 16 ];
+
 	libewf_deflate_bit_stream_t bit_stream;
 	libewf_deflate_huffman_table_t distances_table;
 	libewf_deflate_huffman_table_t literals_table;
+	libewf_deflate_huffman_table_t long_codes_table;
 
 	libcerror_error_t *error = NULL;
 	void *memset_result      = NULL;
 	uint32_t value_32bit     = 0;
+	uint16_t symbol          = 0;
 	int result               = 0;
 
 	/* Initialize test
@@ -1224,6 +1229,73 @@ int ewf_test_deflate_bit_stream_get_huffman_encoded_value(
 	 "error",
 	 error );
 
+	/* Test a code that is longer than the primary lookup table
+	 */
+	memset_result = memory_set(
+	                 &long_codes_table,
+	                 0,
+	                 sizeof( libewf_deflate_huffman_table_t ) );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "memset_result",
+	 memset_result );
+
+	for( symbol = 0;
+	     symbol < 15;
+	     symbol++ )
+	{
+		code_size_array[ symbol ] = symbol + 1;
+	}
+	code_size_array[ 15 ] = 15;
+
+	result = libewf_deflate_huffman_table_construct(
+	          &long_codes_table,
+	          code_size_array,
+	          16,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	bit_stream.byte_stream        = long_codes_byte_stream;
+	bit_stream.byte_stream_size   = 2;
+	bit_stream.byte_stream_offset = 0;
+	bit_stream.bit_buffer         = 0;
+	bit_stream.bit_buffer_size    = 0;
+
+	value_32bit = 0;
+
+	result = libewf_deflate_bit_stream_get_huffman_encoded_value(
+	          &bit_stream,
+	          &long_codes_table,
+	          &value_32bit,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "value_32bit",
+	 value_32bit,
+	 (uint32_t) 15 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "bit_stream.bit_buffer_size",
+	 (uint32_t) bit_stream.bit_buffer_size,
+	 (uint32_t) 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
 	/* Test error cases
 	 */
 	bit_stream.byte_stream        = ewf_test_deflate_compressed_byte_stream;
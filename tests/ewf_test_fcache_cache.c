@@ -0,0 +1,1026 @@
+/*
+ * Library fcache cache type test program
+ *
+ * Copyright (C) 2006-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libfcache.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_unused.h"
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+#define EWF_TEST_FCACHE_CACHE_NUMBER_OF_ENTRIES		4
+
+int ewf_test_fcache_cache_values[ EWF_TEST_FCACHE_CACHE_NUMBER_OF_ENTRIES + 1 ];
+
+/* Checks if every cache value in the most recently used list is in the hash bucket of its identifier
+ * Returns 1 if consistent or 0 if not
+ */
+int ewf_test_fcache_cache_check_buckets(
+     libfcache_cache_t *cache )
+{
+#if defined( HAVE_LOCAL_LIBFCACHE )
+	libfcache_internal_cache_t *internal_cache             = NULL;
+	libfcache_internal_cache_value_t *bucket_cache_value   = NULL;
+	libfcache_internal_cache_value_t *internal_cache_value = NULL;
+	int bucket_index                                       = 0;
+	int number_of_bucket_values                            = 0;
+	int number_of_values                                   = 0;
+
+	internal_cache = (libfcache_internal_cache_t *) cache;
+
+	internal_cache_value = internal_cache->first_cache_value;
+
+	while( internal_cache_value != NULL )
+	{
+		bucket_index = libfcache_internal_cache_get_bucket_index(
+		                internal_cache,
+		                internal_cache_value->file_index,
+		                internal_cache_value->offset,
+		                internal_cache_value->timestamp );
+
+		bucket_cache_value = internal_cache->buckets[ bucket_index ];
+
+		while( bucket_cache_value != NULL )
+		{
+			if( bucket_cache_value == internal_cache_value )
+			{
+				break;
+			}
+			bucket_cache_value = bucket_cache_value->next_bucket_cache_value;
+		}
+		if( bucket_cache_value == NULL )
+		{
+			return( 0 );
+		}
+		number_of_values++;
+
+		internal_cache_value = internal_cache_value->next_cache_value;
+	}
+	if( number_of_values != internal_cache->number_of_cache_values )
+	{
+		return( 0 );
+	}
+	/* Check that the buckets do not contain stale cache values
+	 */
+	for( bucket_index = 0;
+	     bucket_index < internal_cache->number_of_buckets;
+	     bucket_index++ )
+	{
+		bucket_cache_value = internal_cache->buckets[ bucket_index ];
+
+		while( bucket_cache_value != NULL )
+		{
+			number_of_bucket_values++;
+
+			bucket_cache_value = bucket_cache_value->next_bucket_cache_value;
+		}
+	}
+	if( number_of_bucket_values != number_of_values )
+	{
+		return( 0 );
+	}
+#else
+	EWF_TEST_UNREFERENCED_PARAMETER( cache )
+
+#endif /* defined( HAVE_LOCAL_LIBFCACHE ) */
+
+	return( 1 );
+}
+
+/* Tests the libfcache_cache_get_value_by_identifier function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_fcache_cache_get_value_by_identifier(
+     void )
+{
+	libcerror_error_t *error             = NULL;
+	libfcache_cache_t *cache             = NULL;
+	libfcache_cache_value_t *cache_value = NULL;
+	intptr_t *value                      = NULL;
+	int result                           = 0;
+
+	/* Initialize test
+	 */
+	result = libfcache_cache_initialize(
+	          &cache,
+	          EWF_TEST_FCACHE_CACHE_NUMBER_OF_ENTRIES,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "cache",
+	 cache );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfcache_cache_set_value_by_identifier(
+	          cache,
+	          1,
+	          4096,
+	          0,
+	          (intptr_t *) &( ewf_test_fcache_cache_values[ 0 ] ),
+	          NULL,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfcache_cache_set_value_by_identifier(
+	          cache,
+	          1,
+	          8192,
+	          0,
+	          (intptr_t *) &( ewf_test_fcache_cache_values[ 1 ] ),
+	          NULL,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libfcache_cache_get_value_by_identifier(
+	          cache,
+	          1,
+	          4096,
+	          0,
+	          &cache_value,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "cache_value",
+	 cache_value );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfcache_cache_value_get_value(
+	          cache_value,
+	          &value,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INTPTR(
+	 "value",
+	 (intptr_t) value,
+	 (intptr_t) &( ewf_test_fcache_cache_values[ 0 ] ) );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test an identifier that differs only in the file index
+	 */
+	result = libfcache_cache_get_value_by_identifier(
+	          cache,
+	          2,
+	          4096,
+	          0,
+	          &cache_value,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "cache_value",
+	 cache_value );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test an identifier that differs only in the timestamp
+	 */
+	result = libfcache_cache_get_value_by_identifier(
+	          cache,
+	          1,
+	          8192,
+	          1,
+	          &cache_value,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "cache_value",
+	 cache_value );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = ewf_test_fcache_cache_check_buckets(
+	          cache );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* Test error cases
+	 */
+	result = libfcache_cache_get_value_by_identifier(
+	          NULL,
+	          1,
+	          4096,
+	          0,
+	          &cache_value,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfcache_cache_get_value_by_identifier(
+	          cache,
+	          1,
+	          4096,
+	          0,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfcache_cache_free(
+	          &cache,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "cache",
+	 cache );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( cache != NULL )
+	{
+		libfcache_cache_free(
+		 &cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfcache_cache_set_value_by_index function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_fcache_cache_set_value_by_index(
+     void )
+{
+	libcerror_error_t *error             = NULL;
+	libfcache_cache_t *cache             = NULL;
+	libfcache_cache_value_t *cache_value = NULL;
+	intptr_t *value                      = NULL;
+	int cache_entry_index                = 0;
+	int result                           = 0;
+
+	/* Initialize test
+	 */
+	result = libfcache_cache_initialize(
+	          &cache,
+	          EWF_TEST_FCACHE_CACHE_NUMBER_OF_ENTRIES,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "cache",
+	 cache );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( cache_entry_index = 0;
+	     cache_entry_index < EWF_TEST_FCACHE_CACHE_NUMBER_OF_ENTRIES;
+	     cache_entry_index++ )
+	{
+		result = libfcache_cache_set_value_by_index(
+		          cache,
+		          cache_entry_index,
+		          0,
+		          (off64_t) cache_entry_index * 4096,
+		          0,
+		          (intptr_t *) &( ewf_test_fcache_cache_values[ cache_entry_index ] ),
+		          NULL,
+		          0,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test replacing the value of an existing index
+	 */
+	result = libfcache_cache_set_value_by_index(
+	          cache,
+	          0,
+	          1,
+	          65536,
+	          0,
+	          (intptr_t *) &( ewf_test_fcache_cache_values[ EWF_TEST_FCACHE_CACHE_NUMBER_OF_ENTRIES ] ),
+	          NULL,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfcache_cache_get_value_by_identifier(
+	          cache,
+	          0,
+	          0,
+	          0,
+	          &cache_value,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = ewf_test_fcache_cache_check_buckets(
+	          cache );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+#if defined( HAVE_LOCAL_LIBFCACHE )
+
+	/* Test that the replaced value is the most recently used value
+	 */
+	result = libfcache_cache_get_value_by_index(
+	          cache,
+	          0,
+	          &cache_value,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INTPTR(
+	 "cache_value",
+	 (intptr_t) cache_value,
+	 (intptr_t) ( (libfcache_internal_cache_t *) cache )->first_cache_value );
+
+#endif /* defined( HAVE_LOCAL_LIBFCACHE ) */
+
+	result = libfcache_cache_get_value_by_identifier(
+	          cache,
+	          1,
+	          65536,
+	          0,
+	          &cache_value,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "cache_value",
+	 cache_value );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfcache_cache_value_get_value(
+	          cache_value,
+	          &value,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INTPTR(
+	 "value",
+	 (intptr_t) value,
+	 (intptr_t) &( ewf_test_fcache_cache_values[ EWF_TEST_FCACHE_CACHE_NUMBER_OF_ENTRIES ] ) );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfcache_cache_set_value_by_index(
+	          NULL,
+	          1,
+	          1,
+	          131072,
+	          0,
+	          (intptr_t *) &( ewf_test_fcache_cache_values[ 1 ] ),
+	          NULL,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfcache_cache_set_value_by_index(
+	          cache,
+	          -1,
+	          1,
+	          131072,
+	          0,
+	          (intptr_t *) &( ewf_test_fcache_cache_values[ 1 ] ),
+	          NULL,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test that a failed replacement leaves the existing value retrievable
+	 */
+	result = libfcache_cache_set_value_by_index(
+	          cache,
+	          1,
+	          1,
+	          131072,
+	          0,
+	          (intptr_t *) &( ewf_test_fcache_cache_values[ 1 ] ),
+	          NULL,
+	          LIBFCACHE_CACHE_VALUE_FLAG_MANAGED,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfcache_cache_get_value_by_identifier(
+	          cache,
+	          0,
+	          4096,
+	          0,
+	          &cache_value,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfcache_cache_get_value_by_identifier(
+	          cache,
+	          1,
+	          131072,
+	          0,
+	          &cache_value,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = ewf_test_fcache_cache_check_buckets(
+	          cache );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* Clean up
+	 */
+	result = libfcache_cache_free(
+	          &cache,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "cache",
+	 cache );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( cache != NULL )
+	{
+		libfcache_cache_free(
+		 &cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libfcache_cache_set_value_by_identifier function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_fcache_cache_set_value_by_identifier(
+     void )
+{
+	libcerror_error_t *error             = NULL;
+	libfcache_cache_t *cache             = NULL;
+	libfcache_cache_value_t *cache_value = NULL;
+	int number_of_cache_values           = 0;
+	int value_index                      = 0;
+	int result                           = 0;
+
+	/* Initialize test
+	 */
+	result = libfcache_cache_initialize(
+	          &cache,
+	          EWF_TEST_FCACHE_CACHE_NUMBER_OF_ENTRIES,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "cache",
+	 cache );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that setting more values than cache entries evicts the least recently used value
+	 */
+	for( value_index = 0;
+	     value_index < EWF_TEST_FCACHE_CACHE_NUMBER_OF_ENTRIES;
+	     value_index++ )
+	{
+		result = libfcache_cache_set_value_by_identifier(
+		          cache,
+		          0,
+		          (off64_t) value_index * 4096,
+		          0,
+		          (intptr_t *) &( ewf_test_fcache_cache_values[ value_index ] ),
+		          NULL,
+		          0,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Make the first value more recently used than the second value
+	 */
+	result = libfcache_cache_get_value_by_identifier(
+	          cache,
+	          0,
+	          0,
+	          0,
+	          &cache_value,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfcache_cache_set_value_by_identifier(
+	          cache,
+	          0,
+	          (off64_t) EWF_TEST_FCACHE_CACHE_NUMBER_OF_ENTRIES * 4096,
+	          0,
+	          (intptr_t *) &( ewf_test_fcache_cache_values[ EWF_TEST_FCACHE_CACHE_NUMBER_OF_ENTRIES ] ),
+	          NULL,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libfcache_cache_get_number_of_cache_values(
+	          cache,
+	          &number_of_cache_values,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_cache_values",
+	 number_of_cache_values,
+	 EWF_TEST_FCACHE_CACHE_NUMBER_OF_ENTRIES );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = ewf_test_fcache_cache_check_buckets(
+	          cache );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	for( value_index = 0;
+	     value_index <= EWF_TEST_FCACHE_CACHE_NUMBER_OF_ENTRIES;
+	     value_index++ )
+	{
+		result = libfcache_cache_get_value_by_identifier(
+		          cache,
+		          0,
+		          (off64_t) value_index * 4096,
+		          0,
+		          &cache_value,
+		          &error );
+
+		if( value_index == 1 )
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 0 );
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+		}
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test that a failed set leaves the least recently used value retrievable
+	 */
+	result = libfcache_cache_set_value_by_identifier(
+	          cache,
+	          0,
+	          (off64_t) ( EWF_TEST_FCACHE_CACHE_NUMBER_OF_ENTRIES + 1 ) * 4096,
+	          0,
+	          (intptr_t *) &( ewf_test_fcache_cache_values[ 0 ] ),
+	          NULL,
+	          LIBFCACHE_CACHE_VALUE_FLAG_MANAGED,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libfcache_cache_get_value_by_identifier(
+	          cache,
+	          0,
+	          0,
+	          0,
+	          &cache_value,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = ewf_test_fcache_cache_check_buckets(
+	          cache );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* Test that resizing the cache keeps the remaining values retrievable
+	 */
+	result = libfcache_cache_resize(
+	          cache,
+	          EWF_TEST_FCACHE_CACHE_NUMBER_OF_ENTRIES * 2,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = ewf_test_fcache_cache_check_buckets(
+	          cache );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libfcache_cache_get_value_by_identifier(
+	          cache,
+	          0,
+	          (off64_t) EWF_TEST_FCACHE_CACHE_NUMBER_OF_ENTRIES * 4096,
+	          0,
+	          &cache_value,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libfcache_cache_set_value_by_identifier(
+	          NULL,
+	          0,
+	          0,
+	          0,
+	          (intptr_t *) &( ewf_test_fcache_cache_values[ 0 ] ),
+	          NULL,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libfcache_cache_free(
+	          &cache,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "cache",
+	 cache );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( cache != NULL )
+	{
+		libfcache_cache_free(
+		 &cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+	EWF_TEST_RUN(
+	 "libfcache_cache_get_value_by_identifier",
+	 ewf_test_fcache_cache_get_value_by_identifier );
+
+	EWF_TEST_RUN(
+	 "libfcache_cache_set_value_by_index",
+	 ewf_test_fcache_cache_set_value_by_index );
+
+	EWF_TEST_RUN(
+	 "libfcache_cache_set_value_by_identifier",
+	 ewf_test_fcache_cache_set_value_by_identifier );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+}
+
@@ -21,6 +21,7 @@
 
 #include <common.h>
 #include <file_stream.h>
+#include <memory.h>
 #include <narrow_string.h>
 #include <system_string.h>
 #include <types.h>
@@ -43,9 +44,11 @@
 #include "ewf_test_getopt.h"
 #include "ewf_test_libbfio.h"
 #include "ewf_test_libcerror.h"
+#include "ewf_test_libcthreads.h"
 #include "ewf_test_libewf.h"
 #include "ewf_test_macros.h"
 #include "ewf_test_memory.h"
+#include "ewf_test_unused.h"
 
 #include "../libewf/libewf_handle.h"
 
@@ -59,6 +62,92 @@
 
 #define EWF_TEST_HANDLE_READ_BUFFER_SIZE	4096
 
+#if !defined( GENERIC_WRITE )
+#define GENERIC_WRITE				0x40000000UL
+#endif
+
+#if !defined( CREATE_ALWAYS )
+#define CREATE_ALWAYS				2
+#endif
+
+#define EWF_TEST_HANDLE_MAXIMUM_NUMBER_OF_MEMORY_FILES	32
+#define EWF_TEST_HANDLE_MEMORY_MEDIA_SIZE		( ( 2 * 1024 * 1024 ) + 1536 )
+#define EWF_TEST_HANDLE_MEMORY_SEGMENT_SIZE		( 256 * 1024 )
+#define EWF_TEST_HANDLE_MEMORY_BARRIER_NUMBER_OF_READS	2
+#define EWF_TEST_HANDLE_MEMORY_BARRIER_TIMEOUT		10
+
+typedef struct ewf_test_handle_memory_file ewf_test_handle_memory_file_t;
+
+struct ewf_test_handle_memory_file
+{
+	/* The filename
+	 */
+	char filename[ 256 ];
+
+	/* The data
+	 */
+	uint8_t *data;
+
+	/* The data size
+	 */
+	size_t data_size;
+
+	/* The allocated data size
+	 */
+	size_t allocated_data_size;
+
+	/* The current offset
+	 */
+	size_t current_offset;
+
+	/* The number of reads
+	 */
+	int number_of_reads;
+
+	/* The number of reads before a read fails, a value of 0 disables the failure
+	 */
+	int number_of_reads_before_failure;
+
+	/* The offset of the read that waits at the read barrier, a value of 0 disables the barrier
+	 */
+	int64_t barrier_offset;
+};
+
+typedef struct ewf_test_handle_memory_file_system ewf_test_handle_memory_file_system_t;
+
+struct ewf_test_handle_memory_file_system
+{
+	/* The files
+	 */
+	ewf_test_handle_memory_file_t files[ EWF_TEST_HANDLE_MAXIMUM_NUMBER_OF_MEMORY_FILES ];
+
+	/* The number of files
+	 */
+	int number_of_files;
+
+	/* The number of writes before a write fails, a value of 0 disables the failure
+	 */
+	int number_of_writes_before_failure;
+
+	/* The number of writes
+	 */
+	int number_of_writes;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The read barrier mutex
+	 */
+	libcthreads_mutex_t *barrier_mutex;
+
+	/* The number of reads that entered the read barrier
+	 */
+	int number_of_barrier_reads;
+
+	/* The number of reads that passed the read barrier after all reads entered it
+	 */
+	int number_of_passed_barrier_reads;
+#endif
+};
+
 #if !defined( LIBEWF_HAVE_BFIO )
 
 LIBEWF_EXTERN \
@@ -448,10 +537,3577 @@ int ewf_test_handle_clone(
 #endif
 #endif /* defined( HAVE_EWF_TEST_MEMORY ) */
 
-	/* Initialize test
-	 */
-	result = libewf_handle_initialize(
-	          &source_handle,
+	/* Initialize test
+	 */
+	result = libewf_handle_initialize(
+	          &source_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "source_handle",
+	 source_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libewf_handle_clone(
+	          &destination_handle,
+	          source_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "destination_handle",
+	 destination_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_free(
+	          &destination_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "destination_handle",
+	 destination_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_clone(
+	          &destination_handle,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "destination_handle",
+	 destination_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_handle_clone(
+	          NULL,
+	          source_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	destination_handle = (libewf_handle_t *) 0x12345678UL;
+
+	result = libewf_handle_clone(
+	          &destination_handle,
+	          source_handle,
+	          &error );
+
+	destination_handle = NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libewf_handle_clone with malloc failing
+		 */
+		ewf_test_malloc_attempts_before_fail = test_number;
+
+		result = libewf_handle_clone(
+		          &destination_handle,
+		          source_handle,
+		          &error );
+
+		if( ewf_test_malloc_attempts_before_fail != -1 )
+		{
+			ewf_test_malloc_attempts_before_fail = -1;
+
+			if( destination_handle != NULL )
+			{
+				libewf_handle_free(
+				 &destination_handle,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "destination_handle",
+			 destination_handle );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#if defined( OPTIMIZATION_DISABLED )
+
+	for( test_number = 0;
+	     test_number < number_of_memcpy_fail_tests;
+	     test_number++ )
+	{
+		/* Test libewf_handle_clone with memcpy failing
+		 */
+		ewf_test_memcpy_attempts_before_fail = test_number;
+
+		result = libewf_handle_clone(
+		          &destination_handle,
+		          source_handle,
+		          &error );
+
+		if( ewf_test_memcpy_attempts_before_fail != -1 )
+		{
+			ewf_test_memcpy_attempts_before_fail = -1;
+
+			if( destination_handle != NULL )
+			{
+				libewf_handle_free(
+				 &destination_handle,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "destination_handle",
+			 destination_handle );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( OPTIMIZATION_DISABLED ) */
+#endif /* defined( HAVE_EWF_TEST_MEMORY ) */
+
+	/* Clean up
+	 */
+	result = libewf_handle_free(
+	          &source_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "source_handle",
+	 source_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( destination_handle != NULL )
+	{
+		libewf_handle_free(
+		 &destination_handle,
+		 NULL );
+	}
+	if( source_handle != NULL )
+	{
+		libewf_handle_free(
+		 &source_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Submits a read of multiple ranges, used to test libewf_handle_set_io_backend
+ * Returns -1 on error
+ */
+int ewf_test_handle_io_backend_file_read_submit(
+     void *user_data EWF_TEST_ATTRIBUTE_UNUSED,
+     void *file_handle EWF_TEST_ATTRIBUTE_UNUSED,
+     file_read_range_t *ranges EWF_TEST_ATTRIBUTE_UNUSED,
+     int32_t number_of_ranges EWF_TEST_ATTRIBUTE_UNUSED,
+     void **request EWF_TEST_ATTRIBUTE_UNUSED )
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( user_data )
+	EWF_TEST_UNREFERENCED_PARAMETER( file_handle )
+	EWF_TEST_UNREFERENCED_PARAMETER( ranges )
+	EWF_TEST_UNREFERENCED_PARAMETER( number_of_ranges )
+	EWF_TEST_UNREFERENCED_PARAMETER( request )
+
+	return( -1 );
+}
+
+/* Tests the libewf_handle_set_io_backend function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_set_io_backend(
+     void )
+{
+	file_io_backend_t io_backend;
+
+	libcerror_error_t *error = NULL;
+	libewf_handle_t *handle  = NULL;
+	void *memset_result      = NULL;
+	int result               = 0;
+
+	/* Initialize test
+	 */
+	memset_result = memory_set(
+	                 &io_backend,
+	                 0,
+	                 sizeof( file_io_backend_t ) );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "memset_result",
+	 memset_result );
+
+	result = libewf_handle_initialize(
+	          &handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "handle",
+	 handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libewf_handle_set_io_backend(
+	          handle,
+	          &io_backend,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_set_io_backend(
+	          handle,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_handle_set_io_backend(
+	          NULL,
+	          &io_backend,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test libewf_handle_set_io_backend with only the file read submit callback set
+	 */
+	io_backend.file_read_submit = &ewf_test_handle_io_backend_file_read_submit;
+
+	result = libewf_handle_set_io_backend(
+	          handle,
+	          &io_backend,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_handle_free(
+	          &handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "handle",
+	 handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( handle != NULL )
+	{
+		libewf_handle_free(
+		 &handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Frees the files of a memory file system
+ */
+void ewf_test_handle_memory_file_system_clear(
+      ewf_test_handle_memory_file_system_t *file_system )
+{
+	int file_index = 0;
+
+	for( file_index = 0;
+	     file_index < file_system->number_of_files;
+	     file_index++ )
+	{
+		if( file_system->files[ file_index ].data != NULL )
+		{
+			memory_free(
+			 file_system->files[ file_index ].data );
+		}
+	}
+	memory_set(
+	 file_system,
+	 0,
+	 sizeof( ewf_test_handle_memory_file_system_t ) );
+}
+
+/* Retrieves the basename of a filename
+ * Returns the basename
+ */
+const char *ewf_test_handle_memory_file_system_get_basename(
+             const char *filename )
+{
+	const char *basename = filename;
+
+	while( *filename != 0 )
+	{
+		if( ( *filename == '/' )
+		 || ( *filename == '\\' ) )
+		{
+			basename = &( filename[ 1 ] );
+		}
+		filename++;
+	}
+	return( basename );
+}
+
+/* Retrieves a file of a memory file system by name
+ * The files are matched by basename since the library opens them by path
+ * Returns the file or NULL if not available
+ */
+ewf_test_handle_memory_file_t *ewf_test_handle_memory_file_system_get_file_by_name(
+                                ewf_test_handle_memory_file_system_t *file_system,
+                                const char *filename )
+{
+	const char *basename = NULL;
+	int file_index       = 0;
+
+	basename = ewf_test_handle_memory_file_system_get_basename(
+	            filename );
+
+	for( file_index = 0;
+	     file_index < file_system->number_of_files;
+	     file_index++ )
+	{
+		if( narrow_string_compare(
+		     ewf_test_handle_memory_file_system_get_basename(
+		      file_system->files[ file_index ].filename ),
+		     basename,
+		     narrow_string_length( basename ) + 1 ) == 0 )
+		{
+			return( &( file_system->files[ file_index ] ) );
+		}
+	}
+	return( NULL );
+}
+
+/* Retrieves the number of reads of the files of a memory file system
+ * Returns the number of reads
+ */
+int ewf_test_handle_memory_file_system_get_number_of_reads(
+     ewf_test_handle_memory_file_system_t *file_system )
+{
+	int file_index      = 0;
+	int number_of_reads = 0;
+
+	for( file_index = 0;
+	     file_index < file_system->number_of_files;
+	     file_index++ )
+	{
+		number_of_reads += file_system->files[ file_index ].number_of_reads;
+	}
+	return( number_of_reads );
+}
+
+/* Sets the data of a file of a memory file system, the file is created if it does not exist
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_handle_memory_file_system_set_file_data(
+     ewf_test_handle_memory_file_system_t *file_system,
+     const char *filename,
+     const uint8_t *data,
+     size_t data_size )
+{
+	ewf_test_handle_memory_file_t *file = NULL;
+	size_t filename_length              = 0;
+
+	file = ewf_test_handle_memory_file_system_get_file_by_name(
+	        file_system,
+	        filename );
+
+	if( file == NULL )
+	{
+		filename_length = narrow_string_length(
+		                   filename );
+
+		if( ( filename_length >= 256 )
+		 || ( file_system->number_of_files >= EWF_TEST_HANDLE_MAXIMUM_NUMBER_OF_MEMORY_FILES ) )
+		{
+			return( -1 );
+		}
+		file = &( file_system->files[ file_system->number_of_files ] );
+
+		memory_copy(
+		 file->filename,
+		 filename,
+		 filename_length + 1 );
+
+		file_system->number_of_files += 1;
+	}
+	if( data_size > file->allocated_data_size )
+	{
+		if( file->data != NULL )
+		{
+			memory_free(
+			 file->data );
+		}
+		file->data = (uint8_t *) memory_allocate(
+		                          data_size );
+
+		if( file->data == NULL )
+		{
+			file->allocated_data_size = 0;
+			file->data_size           = 0;
+
+			return( -1 );
+		}
+		file->allocated_data_size = data_size;
+	}
+	if( data_size > 0 )
+	{
+		memory_copy(
+		 file->data,
+		 data,
+		 data_size );
+	}
+	file->data_size = data_size;
+
+	return( 1 );
+}
+
+/* Determines if the files of two memory file systems are identical
+ * Returns 1 if identical or 0 if not
+ */
+int ewf_test_handle_memory_file_system_compare(
+     ewf_test_handle_memory_file_system_t *first_file_system,
+     ewf_test_handle_memory_file_system_t *second_file_system )
+{
+	ewf_test_handle_memory_file_t *first_file  = NULL;
+	ewf_test_handle_memory_file_t *second_file = NULL;
+	int file_index                             = 0;
+
+	if( first_file_system->number_of_files != second_file_system->number_of_files )
+	{
+		return( 0 );
+	}
+	for( file_index = 0;
+	     file_index < first_file_system->number_of_files;
+	     file_index++ )
+	{
+		first_file  = &( first_file_system->files[ file_index ] );
+		second_file = &( second_file_system->files[ file_index ] );
+
+		if( narrow_string_compare(
+		     first_file->filename,
+		     second_file->filename,
+		     256 ) != 0 )
+		{
+			return( 0 );
+		}
+		if( first_file->data_size != second_file->data_size )
+		{
+			return( 0 );
+		}
+		if( ( first_file->data_size > 0 )
+		 && ( memory_compare(
+		       first_file->data,
+		       second_file->data,
+		       first_file->data_size ) != 0 ) )
+		{
+			return( 0 );
+		}
+	}
+	return( 1 );
+}
+
+/* Creates a handle of a file in a memory file system
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_handle_memory_file_create_handle(
+     void *user_data,
+     const char *filename,
+     uint32_t access_flags,
+     uint32_t shared_flags EWF_TEST_ATTRIBUTE_UNUSED,
+     uint32_t creation_flags,
+     void **file_handle )
+{
+	ewf_test_handle_memory_file_system_t *file_system = NULL;
+	ewf_test_handle_memory_file_t *file               = NULL;
+	size_t filename_length                            = 0;
+
+	EWF_TEST_UNREFERENCED_PARAMETER( shared_flags )
+
+	file_system = (ewf_test_handle_memory_file_system_t *) user_data;
+
+	file = ewf_test_handle_memory_file_system_get_file_by_name(
+	        file_system,
+	        filename );
+
+	if( file == NULL )
+	{
+		filename_length = narrow_string_length(
+		                   filename );
+
+		if( ( ( access_flags & GENERIC_WRITE ) == 0 )
+		 || ( filename_length >= 256 )
+		 || ( file_system->number_of_files >= EWF_TEST_HANDLE_MAXIMUM_NUMBER_OF_MEMORY_FILES ) )
+		{
+			return( -1 );
+		}
+		file = &( file_system->files[ file_system->number_of_files ] );
+
+		memory_copy(
+		 file->filename,
+		 filename,
+		 filename_length + 1 );
+
+		file_system->number_of_files += 1;
+	}
+	else if( creation_flags == CREATE_ALWAYS )
+	{
+		file->data_size = 0;
+	}
+	file->current_offset = 0;
+
+	*file_handle = (void *) file;
+
+	return( 1 );
+}
+
+/* Closes a handle of a file in a memory file system
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_handle_memory_file_close_handle(
+     void *user_data EWF_TEST_ATTRIBUTE_UNUSED,
+     void *file_handle EWF_TEST_ATTRIBUTE_UNUSED )
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( user_data )
+	EWF_TEST_UNREFERENCED_PARAMETER( file_handle )
+
+	return( 1 );
+}
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Waits at the read barrier of a memory file system until all reads entered the barrier
+ * The wait times out so that reads that cannot enter the barrier concurrently do not block
+ * Returns 1 if all reads entered the barrier, 0 if the wait timed out or -1 on error
+ */
+int ewf_test_handle_memory_file_system_wait_at_barrier(
+     ewf_test_handle_memory_file_system_t *file_system )
+{
+	time_t start_time   = 0;
+	int number_of_reads = 0;
+
+	if( libcthreads_mutex_grab(
+	     file_system->barrier_mutex,
+	     NULL ) != 1 )
+	{
+		return( -1 );
+	}
+	file_system->number_of_barrier_reads += 1;
+
+	if( libcthreads_mutex_release(
+	     file_system->barrier_mutex,
+	     NULL ) != 1 )
+	{
+		return( -1 );
+	}
+	start_time = time(
+	              NULL );
+
+	while( ( time( NULL ) - start_time ) < EWF_TEST_HANDLE_MEMORY_BARRIER_TIMEOUT )
+	{
+		if( libcthreads_mutex_grab(
+		     file_system->barrier_mutex,
+		     NULL ) != 1 )
+		{
+			return( -1 );
+		}
+		number_of_reads = file_system->number_of_barrier_reads;
+
+		if( number_of_reads >= EWF_TEST_HANDLE_MEMORY_BARRIER_NUMBER_OF_READS )
+		{
+			file_system->number_of_passed_barrier_reads += 1;
+		}
+		if( libcthreads_mutex_release(
+		     file_system->barrier_mutex,
+		     NULL ) != 1 )
+		{
+			return( -1 );
+		}
+		if( number_of_reads >= EWF_TEST_HANDLE_MEMORY_BARRIER_NUMBER_OF_READS )
+		{
+			return( 1 );
+		}
+	}
+	return( 0 );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+/* Reads from a file in a memory file system at a specific offset
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_handle_memory_file_read64(
+     void *user_data EWF_TEST_ATTRIBUTE_UNUSED,
+     void *file_handle,
+     int64_t offset,
+     uint8_t *buffer,
+     int64_t size,
+     int64_t *read_count )
+{
+	ewf_test_handle_memory_file_t *file = NULL;
+
+	EWF_TEST_UNREFERENCED_PARAMETER( user_data )
+
+	file = (ewf_test_handle_memory_file_t *) file_handle;
+
+	/* The read counters are maintained per file since the open threads
+	 * read different segment files concurrently
+	 */
+	file->number_of_reads += 1;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( ( file->barrier_offset != 0 )
+	 && ( offset == file->barrier_offset ) )
+	{
+		ewf_test_handle_memory_file_system_wait_at_barrier(
+		 (ewf_test_handle_memory_file_system_t *) user_data );
+	}
+#endif
+
+	if( file->number_of_reads_before_failure > 0 )
+	{
+		file->number_of_reads_before_failure -= 1;
+
+		if( file->number_of_reads_before_failure == 0 )
+		{
+			return( -1 );
+		}
+	}
+	if( ( offset < 0 )
+	 || ( size < 0 ) )
+	{
+		return( -1 );
+	}
+	if( (size_t) offset >= file->data_size )
+	{
+		size = 0;
+	}
+	else if( (size_t) size > ( file->data_size - (size_t) offset ) )
+	{
+		size = (int64_t) ( file->data_size - (size_t) offset );
+	}
+	if( size > 0 )
+	{
+		memory_copy(
+		 buffer,
+		 &( file->data[ offset ] ),
+		 (size_t) size );
+	}
+	*read_count = size;
+
+	return( 1 );
+}
+
+/* Reads from a file in a memory file system at a specific offset
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_handle_memory_file_read(
+     void *user_data,
+     void *file_handle,
+     int64_t offset,
+     uint8_t *buffer,
+     int32_t size,
+     int32_t *read_count )
+{
+	int64_t read_count64 = 0;
+
+	if( ewf_test_handle_memory_file_read64(
+	     user_data,
+	     file_handle,
+	     offset,
+	     buffer,
+	     (int64_t) size,
+	     &read_count64 ) != 1 )
+	{
+		return( -1 );
+	}
+	*read_count = (int32_t) read_count64;
+
+	return( 1 );
+}
+
+/* Seeks an offset in a file in a memory file system
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_handle_memory_file_seek(
+     void *user_data EWF_TEST_ATTRIBUTE_UNUSED,
+     void *file_handle,
+     int64_t offset )
+{
+	ewf_test_handle_memory_file_t *file = NULL;
+
+	EWF_TEST_UNREFERENCED_PARAMETER( user_data )
+
+	file = (ewf_test_handle_memory_file_t *) file_handle;
+
+	if( offset < 0 )
+	{
+		return( -1 );
+	}
+	file->current_offset = (size_t) offset;
+
+	return( 1 );
+}
+
+/* Writes to a file in a memory file system at the current offset
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_handle_memory_file_write64(
+     void *user_data,
+     void *file_handle,
+     const uint8_t *buffer,
+     int64_t size,
+     int64_t *write_count )
+{
+	ewf_test_handle_memory_file_system_t *file_system = NULL;
+	ewf_test_handle_memory_file_t *file               = NULL;
+	uint8_t *data                                     = NULL;
+	size_t allocated_data_size                        = 0;
+	size_t end_offset                                 = 0;
+
+	file_system = (ewf_test_handle_memory_file_system_t *) user_data;
+	file        = (ewf_test_handle_memory_file_t *) file_handle;
+
+	if( size < 0 )
+	{
+		return( -1 );
+	}
+	file_system->number_of_writes += 1;
+
+	if( file_system->number_of_writes_before_failure > 0 )
+	{
+		file_system->number_of_writes_before_failure -= 1;
+
+		if( file_system->number_of_writes_before_failure == 0 )
+		{
+			return( -1 );
+		}
+	}
+	end_offset = file->current_offset + (size_t) size;
+
+	if( end_offset > file->allocated_data_size )
+	{
+		allocated_data_size = ( end_offset + 65535 ) & ~( (size_t) 65535 );
+
+		data = (uint8_t *) memory_reallocate(
+		                    file->data,
+		                    allocated_data_size );
+
+		if( data == NULL )
+		{
+			return( -1 );
+		}
+		file->data                = data;
+		file->allocated_data_size = allocated_data_size;
+	}
+	if( file->current_offset > file->data_size )
+	{
+		memory_set(
+		 &( file->data[ file->data_size ] ),
+		 0,
+		 file->current_offset - file->data_size );
+	}
+	if( size > 0 )
+	{
+		memory_copy(
+		 &( file->data[ file->current_offset ] ),
+		 buffer,
+		 (size_t) size );
+	}
+	file->current_offset = end_offset;
+
+	if( end_offset > file->data_size )
+	{
+		file->data_size = end_offset;
+	}
+	*write_count = size;
+
+	return( 1 );
+}
+
+/* Writes to a file in a memory file system at the current offset
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_handle_memory_file_write(
+     void *user_data,
+     void *file_handle,
+     const uint8_t *buffer,
+     int32_t size,
+     int32_t *write_count )
+{
+	int64_t write_count64 = 0;
+
+	if( ewf_test_handle_memory_file_write64(
+	     user_data,
+	     file_handle,
+	     buffer,
+	     (int64_t) size,
+	     &write_count64 ) != 1 )
+	{
+		return( -1 );
+	}
+	*write_count = (int32_t) write_count64;
+
+	return( 1 );
+}
+
+/* Retrieves the size of a file in a memory file system
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_handle_memory_file_get_size(
+     void *user_data EWF_TEST_ATTRIBUTE_UNUSED,
+     void *file_handle,
+     int64_t *size )
+{
+	ewf_test_handle_memory_file_t *file = NULL;
+
+	EWF_TEST_UNREFERENCED_PARAMETER( user_data )
+
+	file = (ewf_test_handle_memory_file_t *) file_handle;
+
+	*size = (int64_t) file->data_size;
+
+	return( 1 );
+}
+
+/* Initializes an IO backend that operates on a memory file system
+ * If use_64bit is set only the 64-bit read and write callbacks are set
+ */
+void ewf_test_handle_memory_io_backend_initialize(
+      file_io_backend_t *io_backend,
+      ewf_test_handle_memory_file_system_t *file_system,
+      uint8_t use_64bit )
+{
+	memory_set(
+	 io_backend,
+	 0,
+	 sizeof( file_io_backend_t ) );
+
+	io_backend->user_data          = (void *) file_system;
+	io_backend->file_create_handle = &ewf_test_handle_memory_file_create_handle;
+	io_backend->file_close_handle  = &ewf_test_handle_memory_file_close_handle;
+	io_backend->file_seek          = &ewf_test_handle_memory_file_seek;
+	io_backend->file_get_size      = &ewf_test_handle_memory_file_get_size;
+
+	if( use_64bit != 0 )
+	{
+		io_backend->file_read64  = &ewf_test_handle_memory_file_read64;
+		io_backend->file_write64 = &ewf_test_handle_memory_file_write64;
+	}
+	else
+	{
+		io_backend->file_read  = &ewf_test_handle_memory_file_read;
+		io_backend->file_write = &ewf_test_handle_memory_file_write;
+	}
+}
+
+/* Fills the media data used by the memory image tests
+ * The data contains chunks of a single byte value, chunks of random data and chunks of text
+ */
+void ewf_test_handle_memory_media_data_fill(
+      uint8_t *media_data,
+      size_t media_size )
+{
+	static char *text      = "The quick brown fox jumps over the lazy dog. ";
+	size_t data_offset     = 0;
+	uint32_t random_value  = 0x12345678UL;
+
+	for( data_offset = 0;
+	     data_offset < media_size;
+	     data_offset++ )
+	{
+		switch( ( data_offset / 32768 ) % 3 )
+		{
+			case 0:
+				media_data[ data_offset ] = (uint8_t) ( data_offset / 32768 );
+				break;
+
+			case 1:
+				random_value = ( random_value * 1103515245UL ) + 12345UL;
+
+				media_data[ data_offset ] = (uint8_t) ( random_value >> 16 );
+				break;
+
+			default:
+				media_data[ data_offset ] = (uint8_t) text[ data_offset % 45 ];
+				break;
+		}
+	}
+}
+
+/* Writes the media data to an image in a memory file system
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_handle_memory_image_write(
+     file_io_backend_t *io_backend,
+     const uint8_t *media_data,
+     size_t media_size,
+     int8_t compression_level,
+     uint8_t compression_flags,
+     int number_of_compression_threads,
+     size_t write_buffer_size,
+     libcerror_error_t **error )
+{
+	char *filename          = "ewf_test";
+	libewf_handle_t *handle = NULL;
+	static char *function   = "ewf_test_handle_memory_image_write";
+	size_t data_offset      = 0;
+	size_t write_size       = 0;
+	ssize_t write_count     = 0;
+
+	if( libewf_handle_initialize(
+	     &handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_set_io_backend(
+	     handle,
+	     io_backend,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set IO backend.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_open(
+	     handle,
+	     &filename,
+	     1,
+	     LIBEWF_OPEN_WRITE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open handle.",
+		 function );
+
+		goto on_error;
+	}
+	/* Set the dates so the segment files do not depend on the time they were written
+	 */
+	if( libewf_handle_set_utf8_header_value(
+	     handle,
+	     (uint8_t *) "acquiry_date",
+	     12,
+	     (uint8_t *) "2021 1 1 12 0 0",
+	     15,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set header value: acquiry_date.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_set_utf8_header_value(
+	     handle,
+	     (uint8_t *) "system_date",
+	     11,
+	     (uint8_t *) "2021 1 1 12 0 0",
+	     15,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set header value: system_date.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_set_media_size(
+	     handle,
+	     (size64_t) media_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set media size.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_set_maximum_segment_size(
+	     handle,
+	     EWF_TEST_HANDLE_MEMORY_SEGMENT_SIZE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set maximum segment size.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_set_compression_values(
+	     handle,
+	     compression_level,
+	     compression_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set compression values.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_set_number_of_compression_threads(
+	     handle,
+	     number_of_compression_threads,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set number of compression threads.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_set_write_buffer_size(
+	     handle,
+	     write_buffer_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set write buffer size.",
+		 function );
+
+		goto on_error;
+	}
+	/* Write in sizes that are not aligned to the chunk size
+	 */
+	while( data_offset < media_size )
+	{
+		write_size = media_size - data_offset;
+
+		if( write_size > 3751 )
+		{
+			write_size = 3751;
+		}
+		write_count = libewf_handle_write_buffer(
+		               handle,
+		               &( media_data[ data_offset ] ),
+		               write_size,
+		               error );
+
+		if( write_count != (ssize_t) write_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write buffer at offset: %" PRIzd ".",
+			 function,
+			 data_offset );
+
+			goto on_error;
+		}
+		data_offset += write_size;
+	}
+	if( libewf_handle_write_finalize(
+	     handle,
+	     error ) < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to finalize write.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_close(
+	     handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_free(
+	     &handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free handle.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( handle != NULL )
+	{
+		libewf_handle_free(
+		 &handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Opens the segment files of an image in a memory file system for reading
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_handle_memory_image_open(
+     libewf_handle_t *handle,
+     ewf_test_handle_memory_file_system_t *file_system,
+     libcerror_error_t **error )
+{
+	char *filenames[ EWF_TEST_HANDLE_MAXIMUM_NUMBER_OF_MEMORY_FILES ];
+
+	static char *function   = "ewf_test_handle_memory_image_open";
+	size_t filename_length  = 0;
+	int file_index          = 0;
+	int number_of_filenames = 0;
+
+	for( file_index = 0;
+	     file_index < file_system->number_of_files;
+	     file_index++ )
+	{
+		filename_length = narrow_string_length(
+		                   file_system->files[ file_index ].filename );
+
+		/* Only the segment files are opened, which have an extension like .E01
+		 */
+		if( ( filename_length > 4 )
+		 && ( file_system->files[ file_index ].filename[ filename_length - 4 ] == '.' )
+		 && ( file_system->files[ file_index ].filename[ filename_length - 3 ] == 'E' ) )
+		{
+			filenames[ number_of_filenames++ ] = file_system->files[ file_index ].filename;
+		}
+	}
+	if( libewf_handle_open(
+	     handle,
+	     filenames,
+	     number_of_filenames,
+	     LIBEWF_OPEN_READ,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open handle.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Reads the media data of an image opened by a handle and compares it with the expected media data
+ * Returns 1 if identical, 0 if not or -1 on error
+ */
+int ewf_test_handle_memory_image_compare_media_data(
+     libewf_handle_t *handle,
+     const uint8_t *media_data,
+     size_t media_size,
+     size_t read_size,
+     libcerror_error_t **error )
+{
+	uint8_t *buffer       = NULL;
+	static char *function = "ewf_test_handle_memory_image_compare_media_data";
+	size64_t image_size   = 0;
+	size_t data_offset    = 0;
+	ssize_t read_count    = 0;
+	int result            = 1;
+
+	if( libewf_handle_get_media_size(
+	     handle,
+	     &image_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve media size.",
+		 function );
+
+		return( -1 );
+	}
+	if( image_size != (size64_t) media_size )
+	{
+		return( 0 );
+	}
+	buffer = (uint8_t *) memory_allocate(
+	                      read_size );
+
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_handle_seek_offset(
+	     handle,
+	     0,
+	     SEEK_SET,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset: 0.",
+		 function );
+
+		memory_free(
+		 buffer );
+
+		return( -1 );
+	}
+	while( data_offset < media_size )
+	{
+		read_count = libewf_handle_read_buffer(
+		              handle,
+		              buffer,
+		              read_size,
+		              error );
+
+		if( read_count <= 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read buffer at offset: %" PRIzd ".",
+			 function,
+			 data_offset );
+
+			result = -1;
+
+			break;
+		}
+		if( ( (size_t) read_count > ( media_size - data_offset ) )
+		 || ( memory_compare(
+		       buffer,
+		       &( media_data[ data_offset ] ),
+		       (size_t) read_count ) != 0 ) )
+		{
+			result = 0;
+
+			break;
+		}
+		data_offset += (size_t) read_count;
+	}
+	memory_free(
+	 buffer );
+
+	return( result );
+}
+
+/* Creates a handle and opens the segment files of an image in a memory file system for reading
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_handle_memory_image_open_handle(
+     libewf_handle_t **handle,
+     file_io_backend_t *io_backend,
+     ewf_test_handle_memory_file_system_t *file_system,
+     const char *index_filename,
+     int number_of_open_threads,
+     libcerror_error_t **error )
+{
+	libewf_handle_t *safe_handle = NULL;
+	static char *function        = "ewf_test_handle_memory_image_open_handle";
+
+	if( libewf_handle_initialize(
+	     &safe_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_set_io_backend(
+	     safe_handle,
+	     io_backend,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set IO backend.",
+		 function );
+
+		goto on_error;
+	}
+	if( number_of_open_threads > 0 )
+	{
+		if( libewf_handle_set_number_of_open_threads(
+		     safe_handle,
+		     number_of_open_threads,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set number of open threads.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( index_filename != NULL )
+	{
+		if( libewf_handle_set_index_filename(
+		     safe_handle,
+		     index_filename,
+		     narrow_string_length(
+		      index_filename ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set index filename.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( ewf_test_handle_memory_image_open(
+	     safe_handle,
+	     file_system,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open image.",
+		 function );
+
+		goto on_error;
+	}
+	*handle = safe_handle;
+
+	return( 1 );
+
+on_error:
+	if( safe_handle != NULL )
+	{
+		libewf_handle_free(
+		 &safe_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Closes and frees a handle of an image in a memory file system
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_handle_memory_image_close_handle(
+     libewf_handle_t **handle,
+     libcerror_error_t **error )
+{
+	static char *function = "ewf_test_handle_memory_image_close_handle";
+	int result            = 1;
+
+	if( libewf_handle_close(
+	     *handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close handle.",
+		 function );
+
+		result = -1;
+	}
+	if( libewf_handle_free(
+	     handle,
+	     ( result == 1 ) ? error : NULL ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free handle.",
+		 function );
+
+		result = -1;
+	}
+	return( result );
+}
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+/* Retrieves the location of a chunk in the chunk table of a handle
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_handle_get_chunk_location(
+     libewf_handle_t *handle,
+     uint64_t chunk_index,
+     uint32_t *segment_number,
+     int *file_io_pool_entry,
+     off64_t *chunk_data_offset,
+     uint32_t *chunk_data_size,
+     uint16_t *chunk_range_flags,
+     libcerror_error_t **error )
+{
+	libewf_chunk_group_t *chunk_group         = NULL;
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "ewf_test_handle_get_chunk_location";
+	off64_t chunk_group_data_offset           = 0;
+	int chunk_group_index                     = 0;
+	int chunk_groups_list_index               = 0;
+
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( libewf_chunk_table_get_segment_file_chunk_group_by_offset(
+	     internal_handle->chunk_table,
+	     internal_handle->file_io_pool,
+	     internal_handle->segment_table,
+	     (off64_t) ( chunk_index * internal_handle->media_values->chunk_size ),
+	     segment_number,
+	     &chunk_groups_list_index,
+	     &chunk_group_data_offset,
+	     &chunk_group,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk group of chunk: %" PRIu64 ".",
+		 function,
+		 chunk_index );
+
+		return( -1 );
+	}
+	chunk_group_index = (int) ( chunk_group_data_offset / internal_handle->media_values->chunk_size );
+
+	if( ( chunk_group == NULL )
+	 || ( chunk_group_index < 0 )
+	 || ( chunk_group_index >= chunk_group->number_of_chunks ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk group index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*file_io_pool_entry = chunk_group->file_io_pool_entry;
+	*chunk_data_offset  = chunk_group->chunks_data_offsets[ chunk_group_index ];
+	*chunk_data_size    = chunk_group->chunks_data_sizes[ chunk_group_index ];
+	*chunk_range_flags  = chunk_group->chunks_range_flags[ chunk_group_index ];
+
+	return( 1 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+/* Determines if two handles opened the same image
+ * Compares the media values and the location of every chunk
+ * Returns 1 if identical, 0 if not or -1 on error
+ */
+int ewf_test_handle_memory_image_compare_handles(
+     libewf_handle_t *first_handle,
+     libewf_handle_t *second_handle,
+     libcerror_error_t **error )
+{
+	uint8_t first_md5_hash[ 16 ];
+	uint8_t second_md5_hash[ 16 ];
+
+	static char *function             = "ewf_test_handle_memory_image_compare_handles";
+	size64_t first_media_size         = 0;
+	size64_t second_media_size        = 0;
+	uint64_t first_number_of_sectors  = 0;
+	uint64_t second_number_of_sectors = 0;
+	uint32_t first_bytes_per_sector   = 0;
+	uint32_t first_chunk_size         = 0;
+	uint32_t second_bytes_per_sector  = 0;
+	uint32_t second_chunk_size        = 0;
+	int first_result                  = 0;
+	int second_result                 = 0;
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+	off64_t first_chunk_data_offset   = 0;
+	off64_t second_chunk_data_offset  = 0;
+	uint64_t chunk_index              = 0;
+	uint64_t number_of_chunks         = 0;
+	uint32_t first_chunk_data_size    = 0;
+	uint32_t first_segment_number     = 0;
+	uint32_t second_chunk_data_size   = 0;
+	uint32_t second_segment_number    = 0;
+	uint16_t first_chunk_range_flags  = 0;
+	uint16_t second_chunk_range_flags = 0;
+	int first_file_io_pool_entry      = 0;
+	int second_file_io_pool_entry     = 0;
+#endif
+
+	if( ( libewf_handle_get_media_size(
+	       first_handle,
+	       &first_media_size,
+	       error ) != 1 )
+	 || ( libewf_handle_get_media_size(
+	       second_handle,
+	       &second_media_size,
+	       error ) != 1 )
+	 || ( libewf_handle_get_chunk_size(
+	       first_handle,
+	       &first_chunk_size,
+	       error ) != 1 )
+	 || ( libewf_handle_get_chunk_size(
+	       second_handle,
+	       &second_chunk_size,
+	       error ) != 1 )
+	 || ( libewf_handle_get_bytes_per_sector(
+	       first_handle,
+	       &first_bytes_per_sector,
+	       error ) != 1 )
+	 || ( libewf_handle_get_bytes_per_sector(
+	       second_handle,
+	       &second_bytes_per_sector,
+	       error ) != 1 )
+	 || ( libewf_handle_get_number_of_sectors(
+	       first_handle,
+	       &first_number_of_sectors,
+	       error ) != 1 )
+	 || ( libewf_handle_get_number_of_sectors(
+	       second_handle,
+	       &second_number_of_sectors,
+	       error ) != 1 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( first_media_size != second_media_size )
+	 || ( first_chunk_size != second_chunk_size )
+	 || ( first_bytes_per_sector != second_bytes_per_sector )
+	 || ( first_number_of_sectors != second_number_of_sectors ) )
+	{
+		return( 0 );
+	}
+	first_result = libewf_handle_get_md5_hash(
+	                first_handle,
+	                first_md5_hash,
+	                16,
+	                error );
+
+	if( first_result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve first MD5 hash.",
+		 function );
+
+		return( -1 );
+	}
+	second_result = libewf_handle_get_md5_hash(
+	                 second_handle,
+	                 second_md5_hash,
+	                 16,
+	                 error );
+
+	if( second_result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve second MD5 hash.",
+		 function );
+
+		return( -1 );
+	}
+	if( first_result != second_result )
+	{
+		return( 0 );
+	}
+	if( ( first_result != 0 )
+	 && ( memory_compare(
+	       first_md5_hash,
+	       second_md5_hash,
+	       16 ) != 0 ) )
+	{
+		return( 0 );
+	}
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+	if( first_chunk_size == 0 )
+	{
+		return( 0 );
+	}
+	number_of_chunks = ( first_media_size + first_chunk_size - 1 ) / first_chunk_size;
+
+	for( chunk_index = 0;
+	     chunk_index < number_of_chunks;
+	     chunk_index++ )
+	{
+		if( ( ewf_test_handle_get_chunk_location(
+		       first_handle,
+		       chunk_index,
+		       &first_segment_number,
+		       &first_file_io_pool_entry,
+		       &first_chunk_data_offset,
+		       &first_chunk_data_size,
+		       &first_chunk_range_flags,
+		       error ) != 1 )
+		 || ( ewf_test_handle_get_chunk_location(
+		       second_handle,
+		       chunk_index,
+		       &second_segment_number,
+		       &second_file_io_pool_entry,
+		       &second_chunk_data_offset,
+		       &second_chunk_data_size,
+		       &second_chunk_range_flags,
+		       error ) != 1 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve location of chunk: %" PRIu64 ".",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+		if( ( first_segment_number != second_segment_number )
+		 || ( first_file_io_pool_entry != second_file_io_pool_entry )
+		 || ( first_chunk_data_offset != second_chunk_data_offset )
+		 || ( first_chunk_data_size != second_chunk_data_size )
+		 || ( first_chunk_range_flags != second_chunk_range_flags ) )
+		{
+			return( 0 );
+		}
+	}
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+	return( 1 );
+}
+
+/* Opens an image in a memory file system with and without an index file and compares the handles
+ * Returns 1 if identical, 0 if not or -1 on error
+ */
+int ewf_test_handle_memory_image_compare_index_open(
+     file_io_backend_t *io_backend,
+     ewf_test_handle_memory_file_system_t *file_system,
+     const uint8_t *media_data,
+     size_t media_size,
+     libcerror_error_t **error )
+{
+	libewf_handle_t *handle           = NULL;
+	libewf_handle_t *reference_handle = NULL;
+	static char *function             = "ewf_test_handle_memory_image_compare_index_open";
+	int result                        = 0;
+
+	if( ewf_test_handle_memory_image_open_handle(
+	     &reference_handle,
+	     io_backend,
+	     file_system,
+	     NULL,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open reference handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( ewf_test_handle_memory_image_open_handle(
+	     &handle,
+	     io_backend,
+	     file_system,
+	     "ewf_test.idx",
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open handle with index file.",
+		 function );
+
+		goto on_error;
+	}
+	result = ewf_test_handle_memory_image_compare_handles(
+	          reference_handle,
+	          handle,
+	          error );
+
+	if( result == 1 )
+	{
+		result = ewf_test_handle_memory_image_compare_media_data(
+		          handle,
+		          media_data,
+		          media_size,
+		          64 * 1024,
+		          error );
+	}
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to compare handles.",
+		 function );
+
+		goto on_error;
+	}
+	if( ewf_test_handle_memory_image_close_handle(
+	     &handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close handle with index file.",
+		 function );
+
+		goto on_error;
+	}
+	if( ewf_test_handle_memory_image_close_handle(
+	     &reference_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close reference handle.",
+		 function );
+
+		goto on_error;
+	}
+	return( result );
+
+on_error:
+	if( handle != NULL )
+	{
+		libewf_handle_free(
+		 &handle,
+		 NULL );
+	}
+	if( reference_handle != NULL )
+	{
+		libewf_handle_free(
+		 &reference_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Tests the libewf_handle_set_io_backend function with a backend that only has 64-bit read and write callbacks
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_set_io_backend_64bit(
+     void )
+{
+	ewf_test_handle_memory_file_system_t file_system;
+	file_io_backend_t io_backend;
+
+	libcerror_error_t *error = NULL;
+	libewf_handle_t *handle  = NULL;
+	uint8_t *media_data      = NULL;
+	int number_of_reads      = 0;
+	int result               = 0;
+
+	/* Initialize test
+	 */
+	memory_set(
+	 &file_system,
+	 0,
+	 sizeof( ewf_test_handle_memory_file_system_t ) );
+
+	ewf_test_handle_memory_io_backend_initialize(
+	 &io_backend,
+	 &file_system,
+	 1 );
+
+	/* Use a maximum read size that is smaller than a chunk
+	 */
+	io_backend.maximum_read_size = 4096;
+
+	media_data = (uint8_t *) memory_allocate(
+	                          EWF_TEST_HANDLE_MEMORY_MEDIA_SIZE );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "media_data",
+	 media_data );
+
+	ewf_test_handle_memory_media_data_fill(
+	 media_data,
+	 EWF_TEST_HANDLE_MEMORY_MEDIA_SIZE );
+
+	result = ewf_test_handle_memory_image_write(
+	          &io_backend,
+	          media_data,
+	          EWF_TEST_HANDLE_MEMORY_MEDIA_SIZE,
+	          LIBEWF_COMPRESSION_LEVEL_FAST,
+	          0,
+	          0,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_GREATER_THAN_INT(
+	 "file_system.number_of_files",
+	 file_system.number_of_files,
+	 1 );
+
+	/* Test reads that span multiple chunks, which are read as multiple ranges
+	 * by the decompression threads
+	 */
+	result = libewf_handle_initialize(
+	          &handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "handle",
+	 handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_set_io_backend(
+	          handle,
+	          &io_backend,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_set_number_of_decompression_threads(
+	          handle,
+	          4,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	number_of_reads = ewf_test_handle_memory_file_system_get_number_of_reads(
+	                   &file_system );
+
+	result = ewf_test_handle_memory_image_open(
+	          handle,
+	          &file_system,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = ewf_test_handle_memory_image_compare_media_data(
+	          handle,
+	          media_data,
+	          EWF_TEST_HANDLE_MEMORY_MEDIA_SIZE,
+	          256 * 1024,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = ewf_test_handle_memory_file_system_get_number_of_reads(
+	          &file_system );
+
+	EWF_TEST_ASSERT_GREATER_THAN_INT(
+	 "result",
+	 result,
+	 number_of_reads );
+
+	/* Clean up
+	 */
+	result = libewf_handle_close(
+	          handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_free(
+	          &handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "handle",
+	 handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	memory_free(
+	 media_data );
+
+	ewf_test_handle_memory_file_system_clear(
+	 &file_system );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( handle != NULL )
+	{
+		libewf_handle_free(
+		 &handle,
+		 NULL );
+	}
+	if( media_data != NULL )
+	{
+		memory_free(
+		 media_data );
+	}
+	ewf_test_handle_memory_file_system_clear(
+	 &file_system );
+
+	return( 0 );
+}
+
+/* Tests writing an image with the libewf_handle_set_write_buffer_size function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_set_write_buffer_size_write(
+     void )
+{
+	ewf_test_handle_memory_file_system_t buffered_file_system;
+	ewf_test_handle_memory_file_system_t file_system;
+	file_io_backend_t buffered_io_backend;
+	file_io_backend_t io_backend;
+
+	size_t write_buffer_sizes[ 2 ] = {
+		100000,
+		4 * EWF_TEST_HANDLE_MEMORY_SEGMENT_SIZE };
+
+	libcerror_error_t *error = NULL;
+	libewf_handle_t *handle  = NULL;
+	uint8_t *media_data      = NULL;
+	int result               = 0;
+	int test_index           = 0;
+
+	/* Initialize test
+	 */
+	memory_set(
+	 &file_system,
+	 0,
+	 sizeof( ewf_test_handle_memory_file_system_t ) );
+
+	memory_set(
+	 &buffered_file_system,
+	 0,
+	 sizeof( ewf_test_handle_memory_file_system_t ) );
+
+	ewf_test_handle_memory_io_backend_initialize(
+	 &io_backend,
+	 &file_system,
+	 0 );
+
+	ewf_test_handle_memory_io_backend_initialize(
+	 &buffered_io_backend,
+	 &buffered_file_system,
+	 0 );
+
+	media_data = (uint8_t *) memory_allocate(
+	                          EWF_TEST_HANDLE_MEMORY_MEDIA_SIZE );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "media_data",
+	 media_data );
+
+	ewf_test_handle_memory_media_data_fill(
+	 media_data,
+	 EWF_TEST_HANDLE_MEMORY_MEDIA_SIZE );
+
+	result = ewf_test_handle_memory_image_write(
+	          &io_backend,
+	          media_data,
+	          EWF_TEST_HANDLE_MEMORY_MEDIA_SIZE,
+	          LIBEWF_COMPRESSION_LEVEL_FAST,
+	          0,
+	          0,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_GREATER_THAN_INT(
+	 "file_system.number_of_files",
+	 file_system.number_of_files,
+	 2 );
+
+	/* Test that the segment files written with and without a write buffer are identical
+	 * The first write buffer size is not a divisor of the segment size, hence the write buffer
+	 * holds data when the segment file is switched, the second is larger than a segment file
+	 */
+	for( test_index = 0;
+	     test_index < 2;
+	     test_index++ )
+	{
+		result = ewf_test_handle_memory_image_write(
+		          &buffered_io_backend,
+		          media_data,
+		          EWF_TEST_HANDLE_MEMORY_MEDIA_SIZE,
+		          LIBEWF_COMPRESSION_LEVEL_FAST,
+		          0,
+		          0,
+		          write_buffer_sizes[ test_index ],
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		EWF_TEST_ASSERT_LESS_THAN_INT(
+		 "buffered_file_system.number_of_writes",
+		 buffered_file_system.number_of_writes,
+		 file_system.number_of_writes );
+
+		result = ewf_test_handle_memory_file_system_compare(
+		          &file_system,
+		          &buffered_file_system );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		result = ewf_test_handle_memory_image_open_handle(
+		          &handle,
+		          &buffered_io_backend,
+		          &buffered_file_system,
+		          NULL,
+		          0,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = ewf_test_handle_memory_image_compare_media_data(
+		          handle,
+		          media_data,
+		          EWF_TEST_HANDLE_MEMORY_MEDIA_SIZE,
+		          64 * 1024,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = ewf_test_handle_memory_image_close_handle(
+		          &handle,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		ewf_test_handle_memory_file_system_clear(
+		 &buffered_file_system );
+	}
+	/* Clean up
+	 */
+	memory_free(
+	 media_data );
+
+	ewf_test_handle_memory_file_system_clear(
+	 &file_system );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( handle != NULL )
+	{
+		libewf_handle_free(
+		 &handle,
+		 NULL );
+	}
+	if( media_data != NULL )
+	{
+		memory_free(
+		 media_data );
+	}
+	ewf_test_handle_memory_file_system_clear(
+	 &buffered_file_system );
+
+	ewf_test_handle_memory_file_system_clear(
+	 &file_system );
+
+	return( 0 );
+}
+
+/* Tests writing an image with the libewf_handle_set_number_of_compression_threads function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_set_number_of_compression_threads_write(
+     void )
+{
+	ewf_test_handle_memory_file_system_t serial_file_system;
+	ewf_test_handle_memory_file_system_t threaded_file_system;
+	file_io_backend_t serial_io_backend;
+	file_io_backend_t threaded_io_backend;
+
+	libcerror_error_t *error = NULL;
+	libewf_handle_t *handle  = NULL;
+	uint8_t *media_data      = NULL;
+	char *filename           = "ewf_test";
+	size_t data_offset       = 0;
+	size_t write_size        = 0;
+	ssize_t write_count      = 0;
+	int result               = 0;
+	int write_failed         = 0;
+
+	/* Initialize test
+	 */
+	memory_set(
+	 &serial_file_system,
+	 0,
+	 sizeof( ewf_test_handle_memory_file_system_t ) );
+
+	memory_set(
+	 &threaded_file_system,
+	 0,
+	 sizeof( ewf_test_handle_memory_file_system_t ) );
+
+	ewf_test_handle_memory_io_backend_initialize(
+	 &serial_io_backend,
+	 &serial_file_system,
+	 0 );
+
+	ewf_test_handle_memory_io_backend_initialize(
+	 &threaded_io_backend,
+	 &threaded_file_system,
+	 0 );
+
+	media_data = (uint8_t *) memory_allocate(
+	                          EWF_TEST_HANDLE_MEMORY_MEDIA_SIZE );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "media_data",
+	 media_data );
+
+	ewf_test_handle_memory_media_data_fill(
+	 media_data,
+	 EWF_TEST_HANDLE_MEMORY_MEDIA_SIZE );
+
+	/* Test that the segment files written with and without compression threads are identical
+	 */
+	result = ewf_test_handle_memory_image_write(
+	          &serial_io_backend,
+	          media_data,
+	          EWF_TEST_HANDLE_MEMORY_MEDIA_SIZE,
+	          LIBEWF_COMPRESSION_LEVEL_FAST,
+	          LIBEWF_COMPRESS_FLAG_USE_EMPTY_BLOCK_COMPRESSION | LIBEWF_COMPRESS_FLAG_USE_ENTROPY_TEST,
+	          0,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = ewf_test_handle_memory_image_write(
+	          &threaded_io_backend,
+	          media_data,
+	          EWF_TEST_HANDLE_MEMORY_MEDIA_SIZE,
+	          LIBEWF_COMPRESSION_LEVEL_FAST,
+	          LIBEWF_COMPRESS_FLAG_USE_EMPTY_BLOCK_COMPRESSION | LIBEWF_COMPRESS_FLAG_USE_ENTROPY_TEST,
+	          4,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_GREATER_THAN_INT(
+	 "serial_file_system.number_of_files",
+	 serial_file_system.number_of_files,
+	 1 );
+
+	result = ewf_test_handle_memory_file_system_compare(
+	          &serial_file_system,
+	          &threaded_file_system );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	ewf_test_handle_memory_file_system_clear(
+	 &threaded_file_system );
+
+	/* Test that adaptive compression cannot be combined with compression threads
+	 */
+	result = libewf_handle_initialize(
+	          &handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_set_io_backend(
+	          handle,
+	          &threaded_io_backend,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_open(
+	          handle,
+	          &filename,
+	          1,
+	          LIBEWF_OPEN_WRITE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_set_compression_values(
+	          handle,
+	          LIBEWF_COMPRESSION_LEVEL_FAST,
+	          LIBEWF_COMPRESS_FLAG_USE_ADAPTIVE_COMPRESSION,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_set_number_of_compression_threads(
+	          handle,
+	          4,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_set_compression_values(
+	          handle,
+	          LIBEWF_COMPRESSION_LEVEL_FAST,
+	          LIBEWF_COMPRESS_FLAG_USE_ENTROPY_TEST,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_set_number_of_compression_threads(
+	          handle,
+	          4,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_set_compression_values(
+	          handle,
+	          LIBEWF_COMPRESSION_LEVEL_FAST,
+	          LIBEWF_COMPRESS_FLAG_USE_ADAPTIVE_COMPRESSION,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test that a failure to write a chunk packed by the compression threads
+	 * is returned by a subsequent write buffer or write finalize
+	 */
+	result = libewf_handle_set_media_size(
+	          handle,
+	          EWF_TEST_HANDLE_MEMORY_MEDIA_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	threaded_file_system.number_of_writes_before_failure = 24;
+
+	while( data_offset < EWF_TEST_HANDLE_MEMORY_MEDIA_SIZE )
+	{
+		write_size = EWF_TEST_HANDLE_MEMORY_MEDIA_SIZE - data_offset;
+
+		if( write_size > 3751 )
+		{
+			write_size = 3751;
+		}
+		write_count = libewf_handle_write_buffer(
+		               handle,
+		               &( media_data[ data_offset ] ),
+		               write_size,
+		               &error );
+
+		if( write_count == -1 )
+		{
+			write_failed = 1;
+
+			break;
+		}
+		data_offset += write_size;
+	}
+	if( write_failed == 0 )
+	{
+		write_count = libewf_handle_write_finalize(
+		               handle,
+		               &error );
+
+		if( write_count == -1 )
+		{
+			write_failed = 1;
+		}
+	}
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "write_failed",
+	 write_failed,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "threaded_file_system.number_of_writes_before_failure",
+	 threaded_file_system.number_of_writes_before_failure,
+	 0 );
+
+	/* Clean up
+	 */
+	libewf_handle_close(
+	 handle,
+	 NULL );
+
+	result = libewf_handle_free(
+	          &handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "handle",
+	 handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	memory_free(
+	 media_data );
+
+	ewf_test_handle_memory_file_system_clear(
+	 &threaded_file_system );
+
+	ewf_test_handle_memory_file_system_clear(
+	 &serial_file_system );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( handle != NULL )
+	{
+		libewf_handle_free(
+		 &handle,
+		 NULL );
+	}
+	if( media_data != NULL )
+	{
+		memory_free(
+		 media_data );
+	}
+	ewf_test_handle_memory_file_system_clear(
+	 &threaded_file_system );
+
+	ewf_test_handle_memory_file_system_clear(
+	 &serial_file_system );
+
+	return( 0 );
+}
+
+/* Tests opening an image with the libewf_handle_set_number_of_open_threads function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_set_number_of_open_threads_open(
+     void )
+{
+	ewf_test_handle_memory_file_system_t file_system;
+	file_io_backend_t io_backend;
+
+	ewf_test_handle_memory_file_t *segment_file = NULL;
+	libcerror_error_t *error                    = NULL;
+	libewf_handle_t *handle                     = NULL;
+	libewf_handle_t *serial_handle              = NULL;
+	uint8_t *media_data                         = NULL;
+	int result                                  = 0;
+
+	/* Initialize test
+	 */
+	memory_set(
+	 &file_system,
+	 0,
+	 sizeof( ewf_test_handle_memory_file_system_t ) );
+
+	ewf_test_handle_memory_io_backend_initialize(
+	 &io_backend,
+	 &file_system,
+	 0 );
+
+	media_data = (uint8_t *) memory_allocate(
+	                          EWF_TEST_HANDLE_MEMORY_MEDIA_SIZE );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "media_data",
+	 media_data );
+
+	ewf_test_handle_memory_media_data_fill(
+	 media_data,
+	 EWF_TEST_HANDLE_MEMORY_MEDIA_SIZE );
+
+	result = ewf_test_handle_memory_image_write(
+	          &io_backend,
+	          media_data,
+	          EWF_TEST_HANDLE_MEMORY_MEDIA_SIZE,
+	          LIBEWF_COMPRESSION_LEVEL_FAST,
+	          0,
+	          0,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_GREATER_THAN_INT(
+	 "file_system.number_of_files",
+	 file_system.number_of_files,
+	 2 );
+
+	result = ewf_test_handle_memory_image_open_handle(
+	          &serial_handle,
+	          &io_backend,
+	          &file_system,
+	          NULL,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that the segment files read by the open threads give the same result as a serial open
+	 */
+	result = ewf_test_handle_memory_image_open_handle(
+	          &handle,
+	          &io_backend,
+	          &file_system,
+	          NULL,
+	          4,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = ewf_test_handle_memory_image_compare_handles(
+	          serial_handle,
+	          handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = ewf_test_handle_memory_image_compare_media_data(
+	          handle,
+	          media_data,
+	          EWF_TEST_HANDLE_MEMORY_MEDIA_SIZE,
+	          64 * 1024,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = ewf_test_handle_memory_image_close_handle(
+	          &handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that a segment file that cannot be read by an open thread
+	 * is read again by the serial open
+	 */
+	segment_file = ewf_test_handle_memory_file_system_get_file_by_name(
+	                &file_system,
+	                "ewf_test.E03" );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "segment_file",
+	 segment_file );
+
+	/* The file header of the segment file is read, using 2 reads, before the open threads
+	 * are started hence the third read, by an open thread, fails
+	 */
+	segment_file->number_of_reads_before_failure = 3;
+
+	result = ewf_test_handle_memory_image_open_handle(
+	          &handle,
+	          &io_backend,
+	          &file_system,
+	          NULL,
+	          4,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "segment_file->number_of_reads_before_failure",
+	 segment_file->number_of_reads_before_failure,
+	 0 );
+
+	result = ewf_test_handle_memory_image_compare_handles(
+	          serial_handle,
+	          handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = ewf_test_handle_memory_image_compare_media_data(
+	          handle,
+	          media_data,
+	          EWF_TEST_HANDLE_MEMORY_MEDIA_SIZE,
+	          64 * 1024,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Clean up
+	 */
+	result = ewf_test_handle_memory_image_close_handle(
+	          &handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = ewf_test_handle_memory_image_close_handle(
+	          &serial_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	memory_free(
+	 media_data );
+
+	ewf_test_handle_memory_file_system_clear(
+	 &file_system );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( handle != NULL )
+	{
+		libewf_handle_free(
+		 &handle,
+		 NULL );
+	}
+	if( serial_handle != NULL )
+	{
+		libewf_handle_free(
+		 &serial_handle,
+		 NULL );
+	}
+	if( media_data != NULL )
+	{
+		memory_free(
+		 media_data );
+	}
+	ewf_test_handle_memory_file_system_clear(
+	 &file_system );
+
+	return( 0 );
+}
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+typedef struct ewf_test_handle_read_thread_values ewf_test_handle_read_thread_values_t;
+
+struct ewf_test_handle_read_thread_values
+{
+	/* The handle
+	 */
+	libewf_handle_t *handle;
+
+	/* The buffer
+	 */
+	uint8_t *buffer;
+
+	/* The buffer size
+	 */
+	size_t buffer_size;
+
+	/* The offset
+	 */
+	off64_t offset;
+
+	/* The read count
+	 */
+	ssize_t read_count;
+};
+
+/* Callback function of a read thread
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_handle_read_thread_callback(
+     ewf_test_handle_read_thread_values_t *read_thread_values )
+{
+	read_thread_values->read_count = libewf_handle_read_buffer_at_offset(
+	                                  read_thread_values->handle,
+	                                  read_thread_values->buffer,
+	                                  read_thread_values->buffer_size,
+	                                  read_thread_values->offset,
+	                                  NULL );
+
+	if( read_thread_values->read_count < 0 )
+	{
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Tests reading from a handle with the libewf_handle_read_buffer_at_offset function in multiple threads
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_read_buffer_at_offset_threads(
+     void )
+{
+	ewf_test_handle_read_thread_values_t read_thread_values[ EWF_TEST_HANDLE_MEMORY_BARRIER_NUMBER_OF_READS ];
+	libcthreads_thread_t *read_threads[ EWF_TEST_HANDLE_MEMORY_BARRIER_NUMBER_OF_READS ];
+	uint64_t chunk_indexes[ EWF_TEST_HANDLE_MEMORY_BARRIER_NUMBER_OF_READS ];
+	char segment_filename[ 32 ];
+
+	ewf_test_handle_memory_file_system_t file_system;
+	file_io_backend_t io_backend;
+
+	ewf_test_handle_memory_file_t *segment_file = NULL;
+	libcerror_error_t *error                    = NULL;
+	libewf_handle_t *handle                     = NULL;
+	uint8_t *media_data                         = NULL;
+	off64_t chunk_data_offset                   = 0;
+	uint32_t chunk_data_size                    = 0;
+	uint32_t chunk_size                         = 0;
+	uint32_t segment_number                     = 0;
+	uint16_t chunk_range_flags                  = 0;
+	int file_io_pool_entry                      = 0;
+	int read_thread_index                       = 0;
+	int result                                  = 0;
+
+	/* Initialize test
+	 */
+	memory_set(
+	 &file_system,
+	 0,
+	 sizeof( ewf_test_handle_memory_file_system_t ) );
+
+	memory_set(
+	 read_thread_values,
+	 0,
+	 sizeof( ewf_test_handle_read_thread_values_t ) * EWF_TEST_HANDLE_MEMORY_BARRIER_NUMBER_OF_READS );
+
+	memory_set(
+	 read_threads,
+	 0,
+	 sizeof( libcthreads_thread_t * ) * EWF_TEST_HANDLE_MEMORY_BARRIER_NUMBER_OF_READS );
+
+	ewf_test_handle_memory_io_backend_initialize(
+	 &io_backend,
+	 &file_system,
+	 1 );
+
+	media_data = (uint8_t *) memory_allocate(
+	                          EWF_TEST_HANDLE_MEMORY_MEDIA_SIZE );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "media_data",
+	 media_data );
+
+	ewf_test_handle_memory_media_data_fill(
+	 media_data,
+	 EWF_TEST_HANDLE_MEMORY_MEDIA_SIZE );
+
+	result = ewf_test_handle_memory_image_write(
+	          &io_backend,
+	          media_data,
+	          EWF_TEST_HANDLE_MEMORY_MEDIA_SIZE,
+	          LIBEWF_COMPRESSION_LEVEL_FAST,
+	          0,
+	          0,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_mutex_initialize(
+	          &( file_system.barrier_mutex ),
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = ewf_test_handle_memory_image_open_handle(
+	          &handle,
+	          &io_backend,
+	          &file_system,
+	          NULL,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_get_chunk_size(
+	          handle,
+	          &chunk_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The chunks are read from different segment files so that each read has its own barrier
+	 */
+	chunk_indexes[ 0 ] = 0;
+	chunk_indexes[ 1 ] = ( EWF_TEST_HANDLE_MEMORY_MEDIA_SIZE / chunk_size ) - 1;
+
+	for( read_thread_index = 0;
+	     read_thread_index < EWF_TEST_HANDLE_MEMORY_BARRIER_NUMBER_OF_READS;
+	     read_thread_index++ )
+	{
+		/* Retrieving the chunk location also reads the chunk group of the chunk
+		 * so that only the chunk data is read by the read threads
+		 */
+		result = ewf_test_handle_get_chunk_location(
+		          handle,
+		          chunk_indexes[ read_thread_index ],
+		          &segment_number,
+		          &file_io_pool_entry,
+		          &chunk_data_offset,
+		          &chunk_data_size,
+		          &chunk_range_flags,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		/* The segment number of the chunk is the index of the segment file
+		 */
+		narrow_string_snprintf(
+		 segment_filename,
+		 32,
+		 "ewf_test.E%02" PRIu32 "",
+		 segment_number + 1 );
+
+		segment_file = ewf_test_handle_memory_file_system_get_file_by_name(
+		                &file_system,
+		                segment_filename );
+
+		EWF_TEST_ASSERT_IS_NOT_NULL(
+		 "segment_file",
+		 segment_file );
+
+		EWF_TEST_ASSERT_EQUAL_INT64(
+		 "segment_file->barrier_offset",
+		 segment_file->barrier_offset,
+		 (int64_t) 0 );
+
+		segment_file->barrier_offset = (int64_t) chunk_data_offset;
+
+		read_thread_values[ read_thread_index ].handle      = handle;
+		read_thread_values[ read_thread_index ].buffer_size = (size_t) chunk_size;
+		read_thread_values[ read_thread_index ].offset      = (off64_t) ( chunk_indexes[ read_thread_index ] * chunk_size );
+		read_thread_values[ read_thread_index ].read_count  = -1;
+
+		read_thread_values[ read_thread_index ].buffer = (uint8_t *) memory_allocate(
+		                                                              sizeof( uint8_t ) * chunk_size );
+
+		EWF_TEST_ASSERT_IS_NOT_NULL(
+		 "read_thread_values[ read_thread_index ].buffer",
+		 read_thread_values[ read_thread_index ].buffer );
+	}
+	/* Test that the read threads read the chunk data concurrently
+	 * If the chunk data were read while the file IO pool mutex is grabbed
+	 * the first read would wait at the barrier until it times out
+	 */
+	for( read_thread_index = 0;
+	     read_thread_index < EWF_TEST_HANDLE_MEMORY_BARRIER_NUMBER_OF_READS;
+	     read_thread_index++ )
+	{
+		result = libcthreads_thread_create(
+		          &( read_threads[ read_thread_index ] ),
+		          NULL,
+		          (int (*)(void *)) &ewf_test_handle_read_thread_callback,
+		          (void *) &( read_thread_values[ read_thread_index ] ),
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	for( read_thread_index = 0;
+	     read_thread_index < EWF_TEST_HANDLE_MEMORY_BARRIER_NUMBER_OF_READS;
+	     read_thread_index++ )
+	{
+		result = libcthreads_thread_join(
+		          &( read_threads[ read_thread_index ] ),
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "file_system.number_of_barrier_reads",
+	 file_system.number_of_barrier_reads,
+	 EWF_TEST_HANDLE_MEMORY_BARRIER_NUMBER_OF_READS );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "file_system.number_of_passed_barrier_reads",
+	 file_system.number_of_passed_barrier_reads,
+	 EWF_TEST_HANDLE_MEMORY_BARRIER_NUMBER_OF_READS );
+
+	for( read_thread_index = 0;
+	     read_thread_index < EWF_TEST_HANDLE_MEMORY_BARRIER_NUMBER_OF_READS;
+	     read_thread_index++ )
+	{
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_thread_values[ read_thread_index ].read_count",
+		 read_thread_values[ read_thread_index ].read_count,
+		 (ssize_t) chunk_size );
+
+		result = memory_compare(
+		          read_thread_values[ read_thread_index ].buffer,
+		          &( media_data[ read_thread_values[ read_thread_index ].offset ] ),
+		          (size_t) chunk_size );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		memory_free(
+		 read_thread_values[ read_thread_index ].buffer );
+
+		read_thread_values[ read_thread_index ].buffer = NULL;
+	}
+	/* Clean up
+	 */
+	result = ewf_test_handle_memory_image_close_handle(
+	          &handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_mutex_free(
+	          &( file_system.barrier_mutex ),
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	memory_free(
+	 media_data );
+
+	ewf_test_handle_memory_file_system_clear(
+	 &file_system );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	for( read_thread_index = 0;
+	     read_thread_index < EWF_TEST_HANDLE_MEMORY_BARRIER_NUMBER_OF_READS;
+	     read_thread_index++ )
+	{
+		if( read_threads[ read_thread_index ] != NULL )
+		{
+			libcthreads_thread_join(
+			 &( read_threads[ read_thread_index ] ),
+			 NULL );
+		}
+		if( read_thread_values[ read_thread_index ].buffer != NULL )
+		{
+			memory_free(
+			 read_thread_values[ read_thread_index ].buffer );
+		}
+	}
+	if( handle != NULL )
+	{
+		libewf_handle_free(
+		 &handle,
+		 NULL );
+	}
+	if( file_system.barrier_mutex != NULL )
+	{
+		libcthreads_mutex_free(
+		 &( file_system.barrier_mutex ),
+		 NULL );
+	}
+	if( media_data != NULL )
+	{
+		memory_free(
+		 media_data );
+	}
+	ewf_test_handle_memory_file_system_clear(
+	 &file_system );
+
+	return( 0 );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) && defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+/* Tests opening an image with the libewf_handle_set_index_filename function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_set_index_filename_open(
+     void )
+{
+	ewf_test_handle_memory_file_system_t file_system;
+	file_io_backend_t io_backend;
+
+	ewf_test_handle_memory_file_t *index_file = NULL;
+	libcerror_error_t *error                  = NULL;
+	libewf_handle_t *handle                   = NULL;
+	libewf_handle_t *reference_handle         = NULL;
+	uint8_t *index_data                       = NULL;
+	uint8_t *media_data                       = NULL;
+	uint8_t *stale_media_data                 = NULL;
+	size_t index_data_size                    = 0;
+	int number_of_index_reads                 = 0;
+	int number_of_reads                       = 0;
+	int number_of_segment_files               = 0;
+	int result                                = 0;
+
+	/* Initialize test
+	 */
+	memory_set(
+	 &file_system,
+	 0,
+	 sizeof( ewf_test_handle_memory_file_system_t ) );
+
+	ewf_test_handle_memory_io_backend_initialize(
+	 &io_backend,
+	 &file_system,
+	 0 );
+
+	media_data = (uint8_t *) memory_allocate(
+	                          EWF_TEST_HANDLE_MEMORY_MEDIA_SIZE );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "media_data",
+	 media_data );
+
+	ewf_test_handle_memory_media_data_fill(
+	 media_data,
+	 EWF_TEST_HANDLE_MEMORY_MEDIA_SIZE );
+
+	result = ewf_test_handle_memory_image_write(
+	          &io_backend,
+	          media_data,
+	          EWF_TEST_HANDLE_MEMORY_MEDIA_SIZE,
+	          LIBEWF_COMPRESSION_LEVEL_FAST,
+	          0,
+	          0,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	number_of_segment_files = file_system.number_of_files;
+
+	EWF_TEST_ASSERT_GREATER_THAN_INT(
+	 "number_of_segment_files",
+	 number_of_segment_files,
+	 2 );
+
+	number_of_reads = ewf_test_handle_memory_file_system_get_number_of_reads(
+	                   &file_system );
+
+	result = ewf_test_handle_memory_image_open_handle(
+	          &reference_handle,
+	          &io_backend,
+	          &file_system,
+	          NULL,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	number_of_reads = ewf_test_handle_memory_file_system_get_number_of_reads(
+	                   &file_system )
+	                - number_of_reads;
+
+	/* Test an open that creates a missing index file
+	 */
+	result = ewf_test_handle_memory_image_open_handle(
+	          &handle,
+	          &io_backend,
+	          &file_system,
+	          "ewf_test.idx",
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	index_file = ewf_test_handle_memory_file_system_get_file_by_name(
+	              &file_system,
+	              "ewf_test.idx" );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "index_file",
+	 index_file );
+
+	EWF_TEST_ASSERT_NOT_EQUAL_SSIZE(
+	 "index_file->data_size",
+	 (ssize_t) index_file->data_size,
+	 (ssize_t) 0 );
+
+	result = ewf_test_handle_memory_image_compare_handles(
+	          reference_handle,
+	          handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = ewf_test_handle_memory_image_close_handle(
+	          &handle,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -459,19 +4115,35 @@ int ewf_test_handle_clone(
 	 result,
 	 1 );
 
-	EWF_TEST_ASSERT_IS_NOT_NULL(
-	 "source_handle",
-	 source_handle );
-
 	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	/* Test regular cases
+	index_data_size = index_file->data_size;
+
+	index_data = (uint8_t *) memory_allocate(
+	                          index_data_size );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "index_data",
+	 index_data );
+
+	memory_copy(
+	 index_data,
+	 index_file->data,
+	 index_data_size );
+
+	/* Test an open that uses a fresh index file instead of scanning the segment files
 	 */
-	result = libewf_handle_clone(
-	          &destination_handle,
-	          source_handle,
+	number_of_index_reads = ewf_test_handle_memory_file_system_get_number_of_reads(
+	                         &file_system );
+
+	result = ewf_test_handle_memory_image_open_handle(
+	          &handle,
+	          &io_backend,
+	          &file_system,
+	          "ewf_test.idx",
+	          0,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -479,16 +4151,22 @@ int ewf_test_handle_clone(
 	 result,
 	 1 );
 
-	EWF_TEST_ASSERT_IS_NOT_NULL(
-	 "destination_handle",
-	 destination_handle );
-
 	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	result = libewf_handle_free(
-	          &destination_handle,
+	number_of_index_reads = ewf_test_handle_memory_file_system_get_number_of_reads(
+	                         &file_system )
+	                      - number_of_index_reads;
+
+	EWF_TEST_ASSERT_LESS_THAN_INT(
+	 "number_of_index_reads",
+	 number_of_index_reads,
+	 number_of_reads );
+
+	result = ewf_test_handle_memory_image_compare_handles(
+	          reference_handle,
+	          handle,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -496,17 +4174,15 @@ int ewf_test_handle_clone(
 	 result,
 	 1 );
 
-	EWF_TEST_ASSERT_IS_NULL(
-	 "destination_handle",
-	 destination_handle );
-
 	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	result = libewf_handle_clone(
-	          &destination_handle,
-	          NULL,
+	result = ewf_test_handle_memory_image_compare_media_data(
+	          handle,
+	          media_data,
+	          EWF_TEST_HANDLE_MEMORY_MEDIA_SIZE,
+	          64 * 1024,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -515,150 +4191,187 @@ int ewf_test_handle_clone(
 	 1 );
 
 	EWF_TEST_ASSERT_IS_NULL(
-	 "destination_handle",
-	 destination_handle );
+	 "error",
+	 error );
+
+	result = ewf_test_handle_memory_image_close_handle(
+	          &handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
 	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	/* Test error cases
-	 */
-	result = libewf_handle_clone(
-	          NULL,
-	          source_handle,
+	result = ewf_test_handle_memory_image_close_handle(
+	          &reference_handle,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 1 );
 
-	EWF_TEST_ASSERT_IS_NOT_NULL(
+	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	 &error );
+	/* Test an open with a corrupt index file, which is replaced
+	 */
+	index_file = ewf_test_handle_memory_file_system_get_file_by_name(
+	              &file_system,
+	              "ewf_test.idx" );
 
-	destination_handle = (libewf_handle_t *) 0x12345678UL;
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "index_file",
+	 index_file );
 
-	result = libewf_handle_clone(
-	          &destination_handle,
-	          source_handle,
-	          &error );
+	index_file->data[ index_file->data_size - 1 ] ^= 0xff;
 
-	destination_handle = NULL;
+	result = ewf_test_handle_memory_image_compare_index_open(
+	          &io_backend,
+	          &file_system,
+	          media_data,
+	          EWF_TEST_HANDLE_MEMORY_MEDIA_SIZE,
+	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 1 );
 
-	EWF_TEST_ASSERT_IS_NOT_NULL(
+	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	 &error );
+	index_file = ewf_test_handle_memory_file_system_get_file_by_name(
+	              &file_system,
+	              "ewf_test.idx" );
 
-#if defined( HAVE_EWF_TEST_MEMORY )
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "index_file",
+	 index_file );
 
-	for( test_number = 0;
-	     test_number < number_of_malloc_fail_tests;
-	     test_number++ )
-	{
-		/* Test libewf_handle_clone with malloc failing
-		 */
-		ewf_test_malloc_attempts_before_fail = test_number;
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "index_file->data_size",
+	 index_file->data_size,
+	 index_data_size );
 
-		result = libewf_handle_clone(
-		          &destination_handle,
-		          source_handle,
-		          &error );
+	result = memory_compare(
+	          index_file->data,
+	          index_data,
+	          index_data_size );
 
-		if( ewf_test_malloc_attempts_before_fail != -1 )
-		{
-			ewf_test_malloc_attempts_before_fail = -1;
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
 
-			if( destination_handle != NULL )
-			{
-				libewf_handle_free(
-				 &destination_handle,
-				 NULL );
-			}
-		}
-		else
-		{
-			EWF_TEST_ASSERT_EQUAL_INT(
-			 "result",
-			 result,
-			 -1 );
+	/* Test an open with a stale index file of an image with the same media size
+	 * but different segment files
+	 */
+	stale_media_data = (uint8_t *) memory_allocate(
+	                                EWF_TEST_HANDLE_MEMORY_MEDIA_SIZE );
 
-			EWF_TEST_ASSERT_IS_NULL(
-			 "destination_handle",
-			 destination_handle );
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "stale_media_data",
+	 stale_media_data );
+
+	memory_copy(
+	 stale_media_data,
+	 &( media_data[ 32 * 1024 ] ),
+	 EWF_TEST_HANDLE_MEMORY_MEDIA_SIZE - ( 32 * 1024 ) );
+
+	memory_copy(
+	 &( stale_media_data[ EWF_TEST_HANDLE_MEMORY_MEDIA_SIZE - ( 32 * 1024 ) ] ),
+	 media_data,
+	 32 * 1024 );
+
+	ewf_test_handle_memory_file_system_clear(
+	 &file_system );
+
+	result = ewf_test_handle_memory_image_write(
+	          &io_backend,
+	          stale_media_data,
+	          EWF_TEST_HANDLE_MEMORY_MEDIA_SIZE,
+	          LIBEWF_COMPRESSION_LEVEL_FAST,
+	          0,
+	          0,
+	          0,
+	          &error );
 
-			EWF_TEST_ASSERT_IS_NOT_NULL(
-			 "error",
-			 error );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
-			libcerror_error_free(
-			 &error );
-		}
-	}
-#if defined( OPTIMIZATION_DISABLED )
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
-	for( test_number = 0;
-	     test_number < number_of_memcpy_fail_tests;
-	     test_number++ )
-	{
-		/* Test libewf_handle_clone with memcpy failing
-		 */
-		ewf_test_memcpy_attempts_before_fail = test_number;
+	result = ewf_test_handle_memory_file_system_set_file_data(
+	          &file_system,
+	          "ewf_test.idx",
+	          index_data,
+	          index_data_size );
 
-		result = libewf_handle_clone(
-		          &destination_handle,
-		          source_handle,
-		          &error );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
-		if( ewf_test_memcpy_attempts_before_fail != -1 )
-		{
-			ewf_test_memcpy_attempts_before_fail = -1;
+	result = ewf_test_handle_memory_image_compare_index_open(
+	          &io_backend,
+	          &file_system,
+	          stale_media_data,
+	          EWF_TEST_HANDLE_MEMORY_MEDIA_SIZE,
+	          &error );
 
-			if( destination_handle != NULL )
-			{
-				libewf_handle_free(
-				 &destination_handle,
-				 NULL );
-			}
-		}
-		else
-		{
-			EWF_TEST_ASSERT_EQUAL_INT(
-			 "result",
-			 result,
-			 -1 );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
-			EWF_TEST_ASSERT_IS_NULL(
-			 "destination_handle",
-			 destination_handle );
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
-			EWF_TEST_ASSERT_IS_NOT_NULL(
-			 "error",
-			 error );
+	index_file = ewf_test_handle_memory_file_system_get_file_by_name(
+	              &file_system,
+	              "ewf_test.idx" );
 
-			libcerror_error_free(
-			 &error );
-		}
-	}
-#endif /* defined( OPTIMIZATION_DISABLED ) */
-#endif /* defined( HAVE_EWF_TEST_MEMORY ) */
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "index_file",
+	 index_file );
 
-	/* Clean up
+	result = ( index_file->data_size == index_data_size )
+	      && ( memory_compare(
+	            index_file->data,
+	            index_data,
+	            index_data_size ) == 0 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test an open with a stale index file of an image with less segment files
 	 */
-	result = libewf_handle_free(
-	          &source_handle,
+	ewf_test_handle_memory_file_system_clear(
+	 &file_system );
+
+	result = ewf_test_handle_memory_image_write(
+	          &io_backend,
+	          media_data,
+	          ( 1024 * 1024 ) + 512,
+	          LIBEWF_COMPRESSION_LEVEL_FAST,
+	          0,
+	          0,
+	          0,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -667,13 +4380,68 @@ int ewf_test_handle_clone(
 	 1 );
 
 	EWF_TEST_ASSERT_IS_NULL(
-	 "source_handle",
-	 source_handle );
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_LESS_THAN_INT(
+	 "file_system.number_of_files",
+	 file_system.number_of_files,
+	 number_of_segment_files );
+
+	result = ewf_test_handle_memory_file_system_set_file_data(
+	          &file_system,
+	          "ewf_test.idx",
+	          index_data,
+	          index_data_size );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = ewf_test_handle_memory_image_compare_index_open(
+	          &io_backend,
+	          &file_system,
+	          media_data,
+	          ( 1024 * 1024 ) + 512,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
 	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
+	index_file = ewf_test_handle_memory_file_system_get_file_by_name(
+	              &file_system,
+	              "ewf_test.idx" );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "index_file",
+	 index_file );
+
+	EWF_TEST_ASSERT_LESS_THAN_UINT64(
+	 "index_file->data_size",
+	 (uint64_t) index_file->data_size,
+	 (uint64_t) index_data_size );
+
+	/* Clean up
+	 */
+	memory_free(
+	 stale_media_data );
+
+	memory_free(
+	 index_data );
+
+	memory_free(
+	 media_data );
+
+	ewf_test_handle_memory_file_system_clear(
+	 &file_system );
+
 	return( 1 );
 
 on_error:
@@ -682,18 +4450,36 @@ on_error:
 		libcerror_error_free(
 		 &error );
 	}
-	if( destination_handle != NULL )
+	if( handle != NULL )
 	{
 		libewf_handle_free(
-		 &destination_handle,
+		 &handle,
 		 NULL );
 	}
-	if( source_handle != NULL )
+	if( reference_handle != NULL )
 	{
 		libewf_handle_free(
-		 &source_handle,
+		 &reference_handle,
 		 NULL );
 	}
+	if( stale_media_data != NULL )
+	{
+		memory_free(
+		 stale_media_data );
+	}
+	if( index_data != NULL )
+	{
+		memory_free(
+		 index_data );
+	}
+	if( media_data != NULL )
+	{
+		memory_free(
+		 media_data );
+	}
+	ewf_test_handle_memory_file_system_clear(
+	 &file_system );
+
 	return( 0 );
 }
 
@@ -4703,6 +8489,38 @@ int main(
 	 "libewf_handle_clone",
 	 ewf_test_handle_clone );
 
+	EWF_TEST_RUN(
+	 "libewf_handle_set_io_backend",
+	 ewf_test_handle_set_io_backend );
+
+	EWF_TEST_RUN(
+	 "libewf_handle_set_io_backend_64bit",
+	 ewf_test_handle_set_io_backend_64bit );
+
+	EWF_TEST_RUN(
+	 "libewf_handle_set_write_buffer_size_write",
+	 ewf_test_handle_set_write_buffer_size_write );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	EWF_TEST_RUN(
+	 "libewf_handle_set_number_of_compression_threads_write",
+	 ewf_test_handle_set_number_of_compression_threads_write );
+
+	EWF_TEST_RUN(
+	 "libewf_handle_set_number_of_open_threads_open",
+	 ewf_test_handle_set_number_of_open_threads_open );
+#endif
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+	EWF_TEST_RUN(
+	 "libewf_handle_read_buffer_at_offset_threads",
+	 ewf_test_handle_read_buffer_at_offset_threads );
+#endif
+
+	EWF_TEST_RUN(
+	 "libewf_handle_set_index_filename_open",
+	 ewf_test_handle_set_index_filename_open );
+
 #if !defined( __BORLANDC__ ) || ( __BORLANDC__ >= 0x0560 )
 	if( source != NULL )
 	{
@@ -0,0 +1,945 @@
+/*
+ * Library index_file type test program
+ *
+ * Copyright (C) 2006-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_unused.h"
+
+#include "../libewf/ewf_index_file.h"
+#include "../libewf/libewf_index_file.h"
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+/* Sets up a segment record with a single section entry
+ */
+void ewf_test_index_file_set_up_segment_record(
+      uint8_t *record_data,
+      uint32_t segment_number )
+{
+	size_t data_offset = 0;
+
+	for( data_offset = 0;
+	     data_offset < sizeof( ewf_index_file_segment_t ) + sizeof( ewf_index_file_section_entry_t );
+	     data_offset++ )
+	{
+		record_data[ data_offset ] = (uint8_t) ( segment_number + data_offset );
+	}
+	byte_stream_copy_from_uint32_little_endian(
+	 ( (ewf_index_file_segment_t *) record_data )->record_size,
+	 (uint32_t) ( sizeof( ewf_index_file_segment_t ) + sizeof( ewf_index_file_section_entry_t ) ) );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 ( (ewf_index_file_segment_t *) record_data )->segment_number,
+	 segment_number );
+}
+
+/* Tests the libewf_index_file_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_index_file_initialize(
+     void )
+{
+	libcerror_error_t *error        = NULL;
+	libewf_index_file_t *index_file = NULL;
+	int result                      = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_index_file_initialize(
+	          &index_file,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "index_file",
+	 index_file );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_index_file_free(
+	          &index_file,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "index_file",
+	 index_file );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_index_file_initialize(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	index_file = (libewf_index_file_t *) 0x12345678UL;
+
+	result = libewf_index_file_initialize(
+	          &index_file,
+	          &error );
+
+	index_file = NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( index_file != NULL )
+	{
+		libewf_index_file_free(
+		 &index_file,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_index_file_free function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_index_file_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libewf_index_file_free(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_index_file_set_segment_record and libewf_index_file_get_segment_record functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_index_file_segment_record(
+     void )
+{
+	uint8_t record_data[ sizeof( ewf_index_file_segment_t ) + sizeof( ewf_index_file_section_entry_t ) ];
+
+	const uint8_t *stored_record_data = NULL;
+	libcerror_error_t *error          = NULL;
+	libewf_index_file_t *index_file   = NULL;
+	size_t stored_record_data_size    = 0;
+	int result                        = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_index_file_initialize(
+	          &index_file,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "index_file",
+	 index_file );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_index_file_resize(
+	          index_file,
+	          2,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	ewf_test_index_file_set_up_segment_record(
+	 record_data,
+	 2 );
+
+	/* Test regular cases
+	 */
+	result = libewf_index_file_get_segment_record(
+	          index_file,
+	          1,
+	          &stored_record_data,
+	          &stored_record_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_index_file_set_segment_record(
+	          index_file,
+	          1,
+	          record_data,
+	          sizeof( record_data ),
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "index_file->is_modified",
+	 index_file->is_modified,
+	 (uint8_t) 1 );
+
+	result = libewf_index_file_get_segment_record(
+	          index_file,
+	          1,
+	          &stored_record_data,
+	          &stored_record_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "stored_record_data_size",
+	 stored_record_data_size,
+	 sizeof( record_data ) );
+
+	result = memory_compare(
+	          stored_record_data,
+	          record_data,
+	          sizeof( record_data ) );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test removing the record
+	 */
+	result = libewf_index_file_set_segment_record(
+	          index_file,
+	          1,
+	          NULL,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_index_file_get_segment_record(
+	          index_file,
+	          1,
+	          &stored_record_data,
+	          &stored_record_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_index_file_set_segment_record(
+	          NULL,
+	          1,
+	          record_data,
+	          sizeof( record_data ),
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_index_file_set_segment_record(
+	          index_file,
+	          2,
+	          record_data,
+	          sizeof( record_data ),
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_index_file_set_segment_record(
+	          index_file,
+	          1,
+	          record_data,
+	          sizeof( ewf_index_file_segment_t ) - 1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_index_file_get_segment_record(
+	          NULL,
+	          1,
+	          &stored_record_data,
+	          &stored_record_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_index_file_get_segment_record(
+	          index_file,
+	          1,
+	          NULL,
+	          &stored_record_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_index_file_free(
+	          &index_file,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "index_file",
+	 index_file );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( index_file != NULL )
+	{
+		libewf_index_file_free(
+		 &index_file,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_index_file_write_data and libewf_index_file_read_data functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_index_file_write_and_read_data(
+     void )
+{
+	uint8_t record_data[ sizeof( ewf_index_file_segment_t ) + sizeof( ewf_index_file_section_entry_t ) ];
+
+	const uint8_t *stored_record_data = NULL;
+	libcerror_error_t *error          = NULL;
+	libewf_index_file_t *index_file   = NULL;
+	uint8_t *data                     = NULL;
+	size_t data_size                  = 0;
+	size_t stored_record_data_size    = 0;
+	int result                        = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_index_file_initialize(
+	          &index_file,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "index_file",
+	 index_file );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_index_file_resize(
+	          index_file,
+	          3,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	ewf_test_index_file_set_up_segment_record(
+	 record_data,
+	 3 );
+
+	result = libewf_index_file_set_segment_record(
+	          index_file,
+	          2,
+	          record_data,
+	          sizeof( record_data ),
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libewf_index_file_write_data(
+	          index_file,
+	          &data,
+	          &data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "data",
+	 data );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "data_size",
+	 data_size,
+	 sizeof( ewf_index_file_header_t ) + sizeof( record_data ) );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_index_file_free(
+	          &index_file,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_index_file_initialize(
+	          &index_file,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_index_file_read_data(
+	          index_file,
+	          data,
+	          data_size,
+	          3,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "index_file->is_modified",
+	 index_file->is_modified,
+	 (uint8_t) 0 );
+
+	result = libewf_index_file_get_segment_record(
+	          index_file,
+	          2,
+	          &stored_record_data,
+	          &stored_record_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "stored_record_data_size",
+	 stored_record_data_size,
+	 sizeof( record_data ) );
+
+	result = memory_compare(
+	          stored_record_data,
+	          record_data,
+	          sizeof( record_data ) );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = libewf_index_file_get_segment_record(
+	          index_file,
+	          0,
+	          &stored_record_data,
+	          &stored_record_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_index_file_read_data(
+	          NULL,
+	          data,
+	          data_size,
+	          3,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_index_file_read_data(
+	          index_file,
+	          data,
+	          sizeof( ewf_index_file_header_t ) - 1,
+	          3,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test error case where the signature is invalid
+	 */
+	data[ 0 ] ^= 0xff;
+
+	result = libewf_index_file_read_data(
+	          index_file,
+	          data,
+	          data_size,
+	          3,
+	          &error );
+
+	data[ 0 ] ^= 0xff;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test error case where the records data checksum does not match
+	 */
+	data[ data_size - 1 ] ^= 0xff;
+
+	result = libewf_index_file_read_data(
+	          index_file,
+	          data,
+	          data_size,
+	          3,
+	          &error );
+
+	data[ data_size - 1 ] ^= 0xff;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test error case where the header checksum does not match
+	 */
+	data[ 12 ] ^= 0xff;
+
+	result = libewf_index_file_read_data(
+	          index_file,
+	          data,
+	          data_size,
+	          3,
+	          &error );
+
+	data[ 12 ] ^= 0xff;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test error case where a record refers to a segment beyond the number of segments
+	 */
+	result = libewf_index_file_read_data(
+	          index_file,
+	          data,
+	          data_size,
+	          2,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_index_file_write_data(
+	          NULL,
+	          &data,
+	          &data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_index_file_write_data(
+	          index_file,
+	          &data,
+	          &data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	memory_free(
+	 data );
+
+	data = NULL;
+
+	result = libewf_index_file_free(
+	          &index_file,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "index_file",
+	 index_file );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( data != NULL )
+	{
+		memory_free(
+		 data );
+	}
+	if( index_file != NULL )
+	{
+		libewf_index_file_free(
+		 &index_file,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+	EWF_TEST_RUN(
+	 "libewf_index_file_initialize",
+	 ewf_test_index_file_initialize );
+
+	EWF_TEST_RUN(
+	 "libewf_index_file_free",
+	 ewf_test_index_file_free );
+
+	EWF_TEST_RUN(
+	 "libewf_index_file_set_segment_record",
+	 ewf_test_index_file_segment_record );
+
+	EWF_TEST_RUN(
+	 "libewf_index_file_write_data",
+	 ewf_test_index_file_write_and_read_data );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+}
+
@@ -0,0 +1,1247 @@
+/*
+ * Library sub_node_index type test program
+ *
+ * Copyright (C) 2006-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_libcdata.h"
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_unused.h"
+
+#include "../libewf/libewf_lef_file_entry.h"
+#include "../libewf/libewf_serialized_string.h"
+#include "../libewf/libewf_sub_node_index.h"
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+/* Creates a file entry tree with 40 sub nodes named file00 to file39
+ * followed by a sub node named file07 with identifier 100
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_sub_node_index_create_tree(
+     libcdata_tree_node_t **root_node,
+     libcerror_error_t **error )
+{
+	uint8_t name[ 6 ]                       = { 'f', 'i', 'l', 'e', '0', '0' };
+
+	libcdata_tree_node_t *sub_node          = NULL;
+	libewf_lef_file_entry_t *lef_file_entry = NULL;
+	int sub_node_number                     = 0;
+
+	if( libcdata_tree_node_initialize(
+	     root_node,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	if( libewf_lef_file_entry_initialize(
+	     &lef_file_entry,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	if( libcdata_tree_node_set_value(
+	     *root_node,
+	     (intptr_t *) lef_file_entry,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	lef_file_entry = NULL;
+
+	for( sub_node_number = 0;
+	     sub_node_number < 41;
+	     sub_node_number++ )
+	{
+		if( libewf_lef_file_entry_initialize(
+		     &lef_file_entry,
+		     error ) != 1 )
+		{
+			goto on_error;
+		}
+		if( sub_node_number < 40 )
+		{
+			name[ 4 ] = (uint8_t) ( '0' + ( sub_node_number / 10 ) );
+			name[ 5 ] = (uint8_t) ( '0' + ( sub_node_number % 10 ) );
+
+			lef_file_entry->identifier = (uint64_t) sub_node_number;
+		}
+		else
+		{
+			name[ 4 ] = (uint8_t) '0';
+			name[ 5 ] = (uint8_t) '7';
+
+			lef_file_entry->identifier = 100;
+		}
+		if( libewf_serialized_string_read_data(
+		     lef_file_entry->name,
+		     name,
+		     6,
+		     error ) != 1 )
+		{
+			goto on_error;
+		}
+		if( libcdata_tree_node_initialize(
+		     &sub_node,
+		     error ) != 1 )
+		{
+			goto on_error;
+		}
+		if( libcdata_tree_node_set_value(
+		     sub_node,
+		     (intptr_t *) lef_file_entry,
+		     error ) != 1 )
+		{
+			goto on_error;
+		}
+		lef_file_entry = NULL;
+
+		if( libcdata_tree_node_append_node(
+		     *root_node,
+		     sub_node,
+		     error ) != 1 )
+		{
+			goto on_error;
+		}
+		sub_node = NULL;
+	}
+	return( 1 );
+
+on_error:
+	if( sub_node != NULL )
+	{
+		libcdata_tree_node_free(
+		 &sub_node,
+		 (int (*)(intptr_t **, libcerror_error_t **)) &libewf_lef_file_entry_free,
+		 NULL );
+	}
+	if( lef_file_entry != NULL )
+	{
+		libewf_lef_file_entry_free(
+		 &lef_file_entry,
+		 NULL );
+	}
+	if( *root_node != NULL )
+	{
+		libcdata_tree_node_free(
+		 root_node,
+		 (int (*)(intptr_t **, libcerror_error_t **)) &libewf_lef_file_entry_free,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Tests the libewf_sub_node_index_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_sub_node_index_initialize(
+     void )
+{
+	libcerror_error_t *error                = NULL;
+	libewf_sub_node_index_t *sub_node_index = NULL;
+	int result                              = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_sub_node_index_initialize(
+	          &sub_node_index,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "sub_node_index",
+	 sub_node_index );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_sub_node_index_free(
+	          &sub_node_index,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "sub_node_index",
+	 sub_node_index );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_sub_node_index_initialize(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	sub_node_index = (libewf_sub_node_index_t *) 0x12345678UL;
+
+	result = libewf_sub_node_index_initialize(
+	          &sub_node_index,
+	          &error );
+
+	sub_node_index = NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( sub_node_index != NULL )
+	{
+		libewf_sub_node_index_free(
+		 &sub_node_index,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_sub_node_index_free function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_sub_node_index_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libewf_sub_node_index_free(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_sub_node_index_get_utf8_stream_hash, libewf_sub_node_index_get_utf8_string_hash
+ * and libewf_sub_node_index_get_utf16_string_hash functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_sub_node_index_get_hash(
+     void )
+{
+	uint8_t utf8_stream[ 8 ]   = { 0xef, 0xbb, 0xbf, 'T', 'e', 's', 't', 0 };
+	uint8_t utf8_string[ 5 ]   = { 'T', 'e', 's', 't', 0 };
+	uint16_t utf16_string[ 4 ] = { 'T', 'e', 's', 't' };
+
+	libcerror_error_t *error   = NULL;
+	uint32_t hash              = 0;
+	uint32_t stream_hash       = 0;
+	int result                 = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_sub_node_index_get_utf8_stream_hash(
+	          utf8_stream,
+	          8,
+	          &stream_hash,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_sub_node_index_get_utf8_stream_hash(
+	          &( utf8_stream[ 3 ] ),
+	          4,
+	          &hash,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "hash",
+	 hash,
+	 stream_hash );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_sub_node_index_get_utf8_string_hash(
+	          utf8_string,
+	          5,
+	          &hash,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "hash",
+	 hash,
+	 stream_hash );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_sub_node_index_get_utf16_string_hash(
+	          utf16_string,
+	          4,
+	          &hash,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "hash",
+	 hash,
+	 stream_hash );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_sub_node_index_get_utf8_stream_hash(
+	          NULL,
+	          8,
+	          &hash,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_sub_node_index_get_utf8_stream_hash(
+	          utf8_stream,
+	          8,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_sub_node_index_get_utf8_string_hash(
+	          NULL,
+	          5,
+	          &hash,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_sub_node_index_get_utf16_string_hash(
+	          NULL,
+	          4,
+	          &hash,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_sub_node_index_build function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_sub_node_index_build(
+     void )
+{
+	libcdata_tree_node_t *root_node         = NULL;
+	libcerror_error_t *error                = NULL;
+	libewf_sub_node_index_t *sub_node_index = NULL;
+	int result                              = 0;
+
+	/* Initialize test
+	 */
+	result = ewf_test_sub_node_index_create_tree(
+	          &root_node,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "root_node",
+	 root_node );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_sub_node_index_initialize(
+	          &sub_node_index,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "sub_node_index",
+	 sub_node_index );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libewf_sub_node_index_build(
+	          sub_node_index,
+	          root_node,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "sub_node_index->is_built",
+	 sub_node_index->is_built,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "sub_node_index->number_of_slots",
+	 sub_node_index->number_of_slots,
+	 128 );
+
+	/* Test that building a built index is a no-op
+	 */
+	result = libewf_sub_node_index_build(
+	          sub_node_index,
+	          root_node,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_sub_node_index_build(
+	          NULL,
+	          root_node,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_sub_node_index_build(
+	          sub_node_index,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_sub_node_index_free(
+	          &sub_node_index,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "sub_node_index",
+	 sub_node_index );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcdata_tree_node_free(
+	          &root_node,
+	          (int (*)(intptr_t **, libcerror_error_t **)) &libewf_lef_file_entry_free,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "root_node",
+	 root_node );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( sub_node_index != NULL )
+	{
+		libewf_sub_node_index_free(
+		 &sub_node_index,
+		 NULL );
+	}
+	if( root_node != NULL )
+	{
+		libcdata_tree_node_free(
+		 &root_node,
+		 (int (*)(intptr_t **, libcerror_error_t **)) &libewf_lef_file_entry_free,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_sub_node_index_get_sub_node_by_utf8_name function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_sub_node_index_get_sub_node_by_utf8_name(
+     void )
+{
+	uint8_t utf8_name1[ 6 ]                 = { 'f', 'i', 'l', 'e', '0', '7' };
+	uint8_t utf8_name2[ 7 ]                 = { 'f', 'i', 'l', 'e', '3', '9', 0 };
+	uint8_t utf8_name3[ 6 ]                 = { 'f', 'i', 'l', 'e', '4', '0' };
+
+	libcdata_tree_node_t *root_node         = NULL;
+	libcdata_tree_node_t *sub_node          = NULL;
+	libcerror_error_t *error                = NULL;
+	libewf_lef_file_entry_t *lef_file_entry = NULL;
+	libewf_sub_node_index_t *sub_node_index = NULL;
+	int result                              = 0;
+
+	/* Initialize test
+	 */
+	result = ewf_test_sub_node_index_create_tree(
+	          &root_node,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "root_node",
+	 root_node );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_sub_node_index_initialize(
+	          &sub_node_index,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "sub_node_index",
+	 sub_node_index );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libewf_sub_node_index_get_sub_node_by_utf8_name(
+	          sub_node_index,
+	          root_node,
+	          utf8_name1,
+	          6,
+	          &sub_node,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "sub_node",
+	 sub_node );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcdata_tree_node_get_value(
+	          sub_node,
+	          (intptr_t **) &lef_file_entry,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "lef_file_entry",
+	 lef_file_entry );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that the first sub node with the name is returned
+	 */
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "lef_file_entry->identifier",
+	 lef_file_entry->identifier,
+	 (uint64_t) 7 );
+
+	result = libewf_sub_node_index_get_sub_node_by_utf8_name(
+	          sub_node_index,
+	          root_node,
+	          utf8_name2,
+	          7,
+	          &sub_node,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "sub_node",
+	 sub_node );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcdata_tree_node_get_value(
+	          sub_node,
+	          (intptr_t **) &lef_file_entry,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "lef_file_entry",
+	 lef_file_entry );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "lef_file_entry->identifier",
+	 lef_file_entry->identifier,
+	 (uint64_t) 39 );
+
+	result = libewf_sub_node_index_get_sub_node_by_utf8_name(
+	          sub_node_index,
+	          root_node,
+	          utf8_name3,
+	          6,
+	          &sub_node,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "sub_node",
+	 sub_node );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_sub_node_index_get_sub_node_by_utf8_name(
+	          NULL,
+	          root_node,
+	          utf8_name1,
+	          6,
+	          &sub_node,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_sub_node_index_get_sub_node_by_utf8_name(
+	          sub_node_index,
+	          root_node,
+	          NULL,
+	          6,
+	          &sub_node,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_sub_node_index_get_sub_node_by_utf8_name(
+	          sub_node_index,
+	          root_node,
+	          utf8_name1,
+	          6,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_sub_node_index_free(
+	          &sub_node_index,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "sub_node_index",
+	 sub_node_index );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcdata_tree_node_free(
+	          &root_node,
+	          (int (*)(intptr_t **, libcerror_error_t **)) &libewf_lef_file_entry_free,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "root_node",
+	 root_node );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( sub_node_index != NULL )
+	{
+		libewf_sub_node_index_free(
+		 &sub_node_index,
+		 NULL );
+	}
+	if( root_node != NULL )
+	{
+		libcdata_tree_node_free(
+		 &root_node,
+		 (int (*)(intptr_t **, libcerror_error_t **)) &libewf_lef_file_entry_free,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_sub_node_index_get_sub_node_by_utf16_name function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_sub_node_index_get_sub_node_by_utf16_name(
+     void )
+{
+	uint16_t utf16_name1[ 6 ]               = { 'f', 'i', 'l', 'e', '0', '7' };
+	uint16_t utf16_name2[ 6 ]               = { 'f', 'i', 'l', 'e', '4', '0' };
+
+	libcdata_tree_node_t *root_node         = NULL;
+	libcdata_tree_node_t *sub_node          = NULL;
+	libcerror_error_t *error                = NULL;
+	libewf_lef_file_entry_t *lef_file_entry = NULL;
+	libewf_sub_node_index_t *sub_node_index = NULL;
+	int result                              = 0;
+
+	/* Initialize test
+	 */
+	result = ewf_test_sub_node_index_create_tree(
+	          &root_node,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "root_node",
+	 root_node );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_sub_node_index_initialize(
+	          &sub_node_index,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "sub_node_index",
+	 sub_node_index );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libewf_sub_node_index_get_sub_node_by_utf16_name(
+	          sub_node_index,
+	          root_node,
+	          utf16_name1,
+	          6,
+	          &sub_node,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "sub_node",
+	 sub_node );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcdata_tree_node_get_value(
+	          sub_node,
+	          (intptr_t **) &lef_file_entry,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "lef_file_entry",
+	 lef_file_entry );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "lef_file_entry->identifier",
+	 lef_file_entry->identifier,
+	 (uint64_t) 7 );
+
+	result = libewf_sub_node_index_get_sub_node_by_utf16_name(
+	          sub_node_index,
+	          root_node,
+	          utf16_name2,
+	          6,
+	          &sub_node,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "sub_node",
+	 sub_node );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_sub_node_index_get_sub_node_by_utf16_name(
+	          NULL,
+	          root_node,
+	          utf16_name1,
+	          6,
+	          &sub_node,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_sub_node_index_get_sub_node_by_utf16_name(
+	          sub_node_index,
+	          root_node,
+	          NULL,
+	          6,
+	          &sub_node,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_sub_node_index_get_sub_node_by_utf16_name(
+	          sub_node_index,
+	          root_node,
+	          utf16_name1,
+	          6,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_sub_node_index_free(
+	          &sub_node_index,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "sub_node_index",
+	 sub_node_index );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcdata_tree_node_free(
+	          &root_node,
+	          (int (*)(intptr_t **, libcerror_error_t **)) &libewf_lef_file_entry_free,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "root_node",
+	 root_node );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( sub_node_index != NULL )
+	{
+		libewf_sub_node_index_free(
+		 &sub_node_index,
+		 NULL );
+	}
+	if( root_node != NULL )
+	{
+		libcdata_tree_node_free(
+		 &root_node,
+		 (int (*)(intptr_t **, libcerror_error_t **)) &libewf_lef_file_entry_free,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+	EWF_TEST_RUN(
+	 "libewf_sub_node_index_initialize",
+	 ewf_test_sub_node_index_initialize );
+
+	EWF_TEST_RUN(
+	 "libewf_sub_node_index_free",
+	 ewf_test_sub_node_index_free );
+
+	EWF_TEST_RUN(
+	 "libewf_sub_node_index_get_hash",
+	 ewf_test_sub_node_index_get_hash );
+
+	EWF_TEST_RUN(
+	 "libewf_sub_node_index_build",
+	 ewf_test_sub_node_index_build );
+
+	EWF_TEST_RUN(
+	 "libewf_sub_node_index_get_sub_node_by_utf8_name",
+	 ewf_test_sub_node_index_get_sub_node_by_utf8_name );
+
+	EWF_TEST_RUN(
+	 "libewf_sub_node_index_get_sub_node_by_utf16_name",
+	 ewf_test_sub_node_index_get_sub_node_by_utf16_name );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+}
+
@@ -0,0 +1,720 @@
+/*
+ * Tools digest_hash_threads functions test program
+ *
+ * Copyright (C) 2006-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_memory.h"
+#include "ewf_test_unused.h"
+
+#include "../ewftools/digest_hash_threads.h"
+#include "../ewftools/ewftools_libhmac.h"
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Tests the digest_hash_threads_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_digest_hash_threads_initialize(
+     void )
+{
+	libcerror_error_t *error                   = NULL;
+	digest_hash_threads_t *digest_hash_threads = NULL;
+	libhmac_md5_context_t *md5_context         = NULL;
+	int result                                 = 0;
+
+	result = libhmac_md5_initialize(
+	          &md5_context,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "md5_context",
+	 md5_context );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = digest_hash_threads_initialize(
+	          &digest_hash_threads,
+	          md5_context,
+	          NULL,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "digest_hash_threads",
+	 digest_hash_threads );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "digest_hash_threads->number_of_thread_pools",
+	 digest_hash_threads->number_of_thread_pools,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = digest_hash_threads_free(
+	          &digest_hash_threads,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "digest_hash_threads",
+	 digest_hash_threads );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = digest_hash_threads_initialize(
+	          NULL,
+	          md5_context,
+	          NULL,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	digest_hash_threads = (digest_hash_threads_t *) 0x12345678UL;
+
+	result = digest_hash_threads_initialize(
+	          &digest_hash_threads,
+	          md5_context,
+	          NULL,
+	          NULL,
+	          &error );
+
+	digest_hash_threads = NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+
+	/* Test digest_hash_threads_initialize with malloc failing
+	 */
+	ewf_test_malloc_attempts_before_fail = 0;
+
+	result = digest_hash_threads_initialize(
+	          &digest_hash_threads,
+	          md5_context,
+	          NULL,
+	          NULL,
+	          &error );
+
+	if( ewf_test_malloc_attempts_before_fail != -1 )
+	{
+		ewf_test_malloc_attempts_before_fail = -1;
+
+		if( digest_hash_threads != NULL )
+		{
+			digest_hash_threads_free(
+			 &digest_hash_threads,
+			 NULL );
+		}
+	}
+	else
+	{
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "digest_hash_threads",
+		 digest_hash_threads );
+
+		EWF_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+	}
+	/* Test digest_hash_threads_initialize with memset failing
+	 */
+	ewf_test_memset_attempts_before_fail = 0;
+
+	result = digest_hash_threads_initialize(
+	          &digest_hash_threads,
+	          md5_context,
+	          NULL,
+	          NULL,
+	          &error );
+
+	if( ewf_test_memset_attempts_before_fail != -1 )
+	{
+		ewf_test_memset_attempts_before_fail = -1;
+
+		if( digest_hash_threads != NULL )
+		{
+			digest_hash_threads_free(
+			 &digest_hash_threads,
+			 NULL );
+		}
+	}
+	else
+	{
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "digest_hash_threads",
+		 digest_hash_threads );
+
+		EWF_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+	}
+#endif /* defined( HAVE_EWF_TEST_MEMORY ) */
+
+	/* Clean up
+	 */
+	result = libhmac_md5_free(
+	          &md5_context,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( digest_hash_threads != NULL )
+	{
+		digest_hash_threads_free(
+		 &digest_hash_threads,
+		 NULL );
+	}
+	if( md5_context != NULL )
+	{
+		libhmac_md5_free(
+		 &md5_context,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the digest_hash_threads_free function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_digest_hash_threads_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = digest_hash_threads_free(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the digest_hash_threads_update function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_digest_hash_threads_update(
+     void )
+{
+	uint8_t buffer[ 4096 ];
+	uint8_t expected_md5_hash[ LIBHMAC_MD5_HASH_SIZE ];
+	uint8_t expected_sha1_hash[ LIBHMAC_SHA1_HASH_SIZE ];
+	uint8_t expected_sha256_hash[ LIBHMAC_SHA256_HASH_SIZE ];
+	uint8_t md5_hash[ LIBHMAC_MD5_HASH_SIZE ];
+	uint8_t sha1_hash[ LIBHMAC_SHA1_HASH_SIZE ];
+	uint8_t sha256_hash[ LIBHMAC_SHA256_HASH_SIZE ];
+
+	libcerror_error_t *error                   = NULL;
+	digest_hash_threads_t *digest_hash_threads = NULL;
+	libhmac_md5_context_t *md5_context         = NULL;
+	libhmac_sha1_context_t *sha1_context       = NULL;
+	libhmac_sha256_context_t *sha256_context   = NULL;
+	size_t buffer_offset                       = 0;
+	size_t buffer_size                         = 0;
+	int iteration                              = 0;
+	int result                                 = 0;
+
+	for( buffer_offset = 0;
+	     buffer_offset < 4096;
+	     buffer_offset++ )
+	{
+		buffer[ buffer_offset ] = (uint8_t) ( ( buffer_offset * 7 ) + ( buffer_offset >> 8 ) );
+	}
+	/* Calculate the expected digest hashes of the data
+	 */
+	result = libhmac_md5_calculate(
+	          buffer,
+	          4096,
+	          expected_md5_hash,
+	          LIBHMAC_MD5_HASH_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libhmac_sha1_calculate(
+	          buffer,
+	          4096,
+	          expected_sha1_hash,
+	          LIBHMAC_SHA1_HASH_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libhmac_sha256_calculate(
+	          buffer,
+	          4096,
+	          expected_sha256_hash,
+	          LIBHMAC_SHA256_HASH_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Initialize test
+	 */
+	result = libhmac_md5_initialize(
+	          &md5_context,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libhmac_sha1_initialize(
+	          &sha1_context,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libhmac_sha256_initialize(
+	          &sha256_context,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = digest_hash_threads_initialize(
+	          &digest_hash_threads,
+	          md5_context,
+	          sha1_context,
+	          sha256_context,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "digest_hash_threads",
+	 digest_hash_threads );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 * Provide the data in more blocks than there are buffers to test buffer reuse
+	 */
+	for( buffer_offset = 0;
+	     buffer_offset < 4096;
+	     buffer_offset += buffer_size )
+	{
+		buffer_size = 1 + ( iteration % 61 );
+
+		if( buffer_size > ( 4096 - buffer_offset ) )
+		{
+			buffer_size = 4096 - buffer_offset;
+		}
+		result = digest_hash_threads_update(
+		          digest_hash_threads,
+		          &( buffer[ buffer_offset ] ),
+		          buffer_size,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		iteration++;
+	}
+	/* Test error cases
+	 */
+	result = digest_hash_threads_update(
+	          NULL,
+	          buffer,
+	          4096,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = digest_hash_threads_update(
+	          digest_hash_threads,
+	          NULL,
+	          4096,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = digest_hash_threads_update(
+	          digest_hash_threads,
+	          buffer,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Wait for the digest hash threads to finish
+	 */
+	result = digest_hash_threads_free(
+	          &digest_hash_threads,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "digest_hash_threads",
+	 digest_hash_threads );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Compare the digest hashes
+	 */
+	result = libhmac_md5_finalize(
+	          md5_context,
+	          md5_hash,
+	          LIBHMAC_MD5_HASH_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = memory_compare(
+	          md5_hash,
+	          expected_md5_hash,
+	          LIBHMAC_MD5_HASH_SIZE );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = libhmac_sha1_finalize(
+	          sha1_context,
+	          sha1_hash,
+	          LIBHMAC_SHA1_HASH_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = memory_compare(
+	          sha1_hash,
+	          expected_sha1_hash,
+	          LIBHMAC_SHA1_HASH_SIZE );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = libhmac_sha256_finalize(
+	          sha256_context,
+	          sha256_hash,
+	          LIBHMAC_SHA256_HASH_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = memory_compare(
+	          sha256_hash,
+	          expected_sha256_hash,
+	          LIBHMAC_SHA256_HASH_SIZE );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Clean up
+	 */
+	result = libhmac_sha256_free(
+	          &sha256_context,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libhmac_sha1_free(
+	          &sha1_context,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libhmac_md5_free(
+	          &md5_context,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( digest_hash_threads != NULL )
+	{
+		digest_hash_threads_free(
+		 &digest_hash_threads,
+		 NULL );
+	}
+	if( sha256_context != NULL )
+	{
+		libhmac_sha256_free(
+		 &sha256_context,
+		 NULL );
+	}
+	if( sha1_context != NULL )
+	{
+		libhmac_sha1_free(
+		 &sha1_context,
+		 NULL );
+	}
+	if( md5_context != NULL )
+	{
+		libhmac_md5_free(
+		 &md5_context,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+	EWF_TEST_RUN(
+	 "digest_hash_threads_initialize",
+	 ewf_test_tools_digest_hash_threads_initialize );
+
+	EWF_TEST_RUN(
+	 "digest_hash_threads_free",
+	 ewf_test_tools_digest_hash_threads_free );
+
+	EWF_TEST_RUN(
+	 "digest_hash_threads_update",
+	 ewf_test_tools_digest_hash_threads_update );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+on_error:
+	return( EXIT_FAILURE );
+#endif
+}
+
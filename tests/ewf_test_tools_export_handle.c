@@ -532,7 +532,7 @@ int main(
 
 	/* TODO add tests for export_handle_output_storage_media_buffer_callback */
 
-	/* TODO add tests for export_handle_empty_output_list */
+	/* TODO add tests for export_handle_empty_output_ring */
 
 #endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
 
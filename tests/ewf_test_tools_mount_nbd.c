@@ -0,0 +1,1053 @@
+/*
+ * Tools mount_nbd functions test program
+ *
+ * Copyright (C) 2006-2021, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#if defined( HAVE_SYS_SOCKET_H )
+#include <sys/socket.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_memory.h"
+#include "ewf_test_unused.h"
+
+#include "../ewftools/mount_nbd.h"
+
+#if defined( HAVE_SYS_SOCKET_H ) && defined( HAVE_SYS_UN_H )
+
+/* Tests the mount_nbd_server_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_mount_nbd_server_initialize(
+     void )
+{
+	libcerror_error_t *error        = NULL;
+	mount_nbd_server_t *nbd_server  = NULL;
+	int result                      = 0;
+
+	/* Test error cases
+	 */
+	result = mount_nbd_server_initialize(
+	          NULL,
+	          (libewf_handle_t *) 0x12345678UL,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	nbd_server = (mount_nbd_server_t *) 0x12345678UL;
+
+	result = mount_nbd_server_initialize(
+	          &nbd_server,
+	          (libewf_handle_t *) 0x12345678UL,
+	          0,
+	          &error );
+
+	nbd_server = NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = mount_nbd_server_initialize(
+	          &nbd_server,
+	          NULL,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = mount_nbd_server_initialize(
+	          &nbd_server,
+	          (libewf_handle_t *) 0x12345678UL,
+	          -1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the mount_nbd_server_free function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_mount_nbd_server_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = mount_nbd_server_free(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the mount_nbd_read_data and mount_nbd_write_data functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_mount_nbd_read_write_data(
+     void )
+{
+	uint8_t read_data[ 16 ];
+	uint8_t write_data[ 16 ] = {
+		0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f };
+
+	libcerror_error_t *error    = NULL;
+	int socket_descriptors[ 2 ] = { -1, -1 };
+	int result                  = 0;
+
+	result = socketpair(
+	          AF_UNIX,
+	          SOCK_STREAM,
+	          0,
+	          socket_descriptors );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test regular cases
+	 */
+	result = mount_nbd_write_data(
+	          socket_descriptors[ 0 ],
+	          write_data,
+	          16,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = mount_nbd_read_data(
+	          socket_descriptors[ 1 ],
+	          read_data,
+	          16,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          read_data,
+	          write_data,
+	          16 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = mount_nbd_read_data(
+	          socket_descriptors[ 1 ],
+	          NULL,
+	          16,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = mount_nbd_write_data(
+	          socket_descriptors[ 0 ],
+	          NULL,
+	          16,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test reading from a connection closed by the other end
+	 */
+	close(
+	 socket_descriptors[ 0 ] );
+
+	socket_descriptors[ 0 ] = -1;
+
+	result = mount_nbd_read_data(
+	          socket_descriptors[ 1 ],
+	          read_data,
+	          16,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	close(
+	 socket_descriptors[ 1 ] );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( socket_descriptors[ 0 ] != -1 )
+	{
+		close(
+		 socket_descriptors[ 0 ] );
+	}
+	if( socket_descriptors[ 1 ] != -1 )
+	{
+		close(
+		 socket_descriptors[ 1 ] );
+	}
+	return( 0 );
+}
+
+/* Tests the mount_nbd_connection_handshake function
+ * The client side of the handshake is written upfront, hence the server side
+ * can run on the same thread
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_mount_nbd_connection_handshake(
+     void )
+{
+	uint8_t client_data[ 4 + 16 + 16 + 8 ];
+	uint8_t reply_data[ 40 ];
+
+	mount_nbd_connection_t nbd_connection;
+	mount_nbd_server_t nbd_server;
+
+	libcerror_error_t *error    = NULL;
+	uint64_t value_64bit        = 0;
+	uint32_t value_32bit        = 0;
+	uint16_t transmission_flags = 0;
+	uint16_t value_16bit        = 0;
+	int socket_descriptors[ 2 ] = { -1, -1 };
+	int result                  = 0;
+
+	result = socketpair(
+	          AF_UNIX,
+	          SOCK_STREAM,
+	          0,
+	          socket_descriptors );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	memory_set(
+	 &nbd_server,
+	 0,
+	 sizeof( mount_nbd_server_t ) );
+
+	nbd_server.media_size                   = 4096;
+	nbd_server.socket_descriptor            = -1;
+	nbd_server.connection_socket_descriptor = -1;
+
+	memory_set(
+	 &nbd_connection,
+	 0,
+	 sizeof( mount_nbd_connection_t ) );
+
+	nbd_connection.server            = &nbd_server;
+	nbd_connection.socket_descriptor = socket_descriptors[ 1 ];
+
+	/* The client flags, a structured reply option and a go option
+	 * that requests the block size info
+	 */
+	byte_stream_copy_from_uint32_big_endian(
+	 &( client_data[ 0 ] ),
+	 MOUNT_NBD_CLIENT_FLAG_FIXED_NEWSTYLE | MOUNT_NBD_CLIENT_FLAG_NO_ZEROES );
+
+	byte_stream_copy_from_uint64_big_endian(
+	 &( client_data[ 4 ] ),
+	 MOUNT_NBD_OPTION_MAGIC );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( client_data[ 12 ] ),
+	 MOUNT_NBD_OPTION_STRUCTURED_REPLY );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( client_data[ 16 ] ),
+	 0 );
+
+	byte_stream_copy_from_uint64_big_endian(
+	 &( client_data[ 20 ] ),
+	 MOUNT_NBD_OPTION_MAGIC );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( client_data[ 28 ] ),
+	 MOUNT_NBD_OPTION_GO );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( client_data[ 32 ] ),
+	 8 );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( client_data[ 36 ] ),
+	 0 );
+
+	byte_stream_copy_from_uint16_big_endian(
+	 &( client_data[ 40 ] ),
+	 1 );
+
+	byte_stream_copy_from_uint16_big_endian(
+	 &( client_data[ 42 ] ),
+	 MOUNT_NBD_INFO_BLOCK_SIZE );
+
+	result = mount_nbd_write_data(
+	          socket_descriptors[ 0 ],
+	          client_data,
+	          4 + 16 + 16 + 8,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* Test regular cases
+	 */
+	result = mount_nbd_connection_handshake(
+	          &nbd_connection,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "nbd_connection.structured_replies",
+	 nbd_connection.structured_replies,
+	 1 );
+
+	/* Check the server handshake
+	 */
+	result = mount_nbd_read_data(
+	          socket_descriptors[ 0 ],
+	          reply_data,
+	          18,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	byte_stream_copy_to_uint64_big_endian(
+	 &( reply_data[ 0 ] ),
+	 value_64bit );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "magic",
+	 value_64bit,
+	 (uint64_t) MOUNT_NBD_MAGIC );
+
+	/* Check the structured reply option acknowledgement
+	 */
+	result = mount_nbd_read_data(
+	          socket_descriptors[ 0 ],
+	          reply_data,
+	          20,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	byte_stream_copy_to_uint32_big_endian(
+	 &( reply_data[ 12 ] ),
+	 value_32bit );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "reply_type",
+	 value_32bit,
+	 (uint32_t) MOUNT_NBD_OPTION_REPLY_ACK );
+
+	/* Check the export info
+	 */
+	result = mount_nbd_read_data(
+	          socket_descriptors[ 0 ],
+	          reply_data,
+	          20 + 12,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	byte_stream_copy_to_uint32_big_endian(
+	 &( reply_data[ 12 ] ),
+	 value_32bit );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "reply_type",
+	 value_32bit,
+	 (uint32_t) MOUNT_NBD_OPTION_REPLY_INFO );
+
+	byte_stream_copy_to_uint64_big_endian(
+	 &( reply_data[ 22 ] ),
+	 value_64bit );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "media_size",
+	 value_64bit,
+	 (uint64_t) 4096 );
+
+	byte_stream_copy_to_uint16_big_endian(
+	 &( reply_data[ 30 ] ),
+	 value_16bit );
+
+	transmission_flags = value_16bit & MOUNT_NBD_TRANSMISSION_FLAG_READ_ONLY;
+
+	EWF_TEST_ASSERT_EQUAL_UINT16(
+	 "transmission_flags",
+	 transmission_flags,
+	 (uint16_t) MOUNT_NBD_TRANSMISSION_FLAG_READ_ONLY );
+
+	/* Check the block size info
+	 */
+	result = mount_nbd_read_data(
+	          socket_descriptors[ 0 ],
+	          reply_data,
+	          20 + 14,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	byte_stream_copy_to_uint16_big_endian(
+	 &( reply_data[ 20 ] ),
+	 value_16bit );
+
+	EWF_TEST_ASSERT_EQUAL_UINT16(
+	 "info_type",
+	 value_16bit,
+	 (uint16_t) MOUNT_NBD_INFO_BLOCK_SIZE );
+
+	byte_stream_copy_to_uint32_big_endian(
+	 &( reply_data[ 30 ] ),
+	 value_32bit );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "maximum_block_size",
+	 value_32bit,
+	 (uint32_t) MOUNT_NBD_MAXIMUM_REQUEST_SIZE );
+
+	/* Check the go option acknowledgement
+	 */
+	result = mount_nbd_read_data(
+	          socket_descriptors[ 0 ],
+	          reply_data,
+	          20,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	byte_stream_copy_to_uint32_big_endian(
+	 &( reply_data[ 12 ] ),
+	 value_32bit );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "reply_type",
+	 value_32bit,
+	 (uint32_t) MOUNT_NBD_OPTION_REPLY_ACK );
+
+	/* Test error cases
+	 */
+	result = mount_nbd_connection_handshake(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test a client that does not support the fixed newstyle handshake
+	 */
+	byte_stream_copy_from_uint32_big_endian(
+	 &( client_data[ 0 ] ),
+	 0 );
+
+	result = mount_nbd_write_data(
+	          socket_descriptors[ 0 ],
+	          client_data,
+	          4,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = mount_nbd_connection_handshake(
+	          &nbd_connection,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	close(
+	 socket_descriptors[ 0 ] );
+	close(
+	 socket_descriptors[ 1 ] );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( socket_descriptors[ 0 ] != -1 )
+	{
+		close(
+		 socket_descriptors[ 0 ] );
+	}
+	if( socket_descriptors[ 1 ] != -1 )
+	{
+		close(
+		 socket_descriptors[ 1 ] );
+	}
+	return( 0 );
+}
+
+/* Tests the mount_nbd_connection_transmission function
+ * Only requests that are answered without reading from the EWF handle are tested
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_mount_nbd_connection_transmission(
+     void )
+{
+	uint8_t client_data[ ( 4 * MOUNT_NBD_REQUEST_HEADER_SIZE ) + 16 ];
+	uint8_t reply_data[ MOUNT_NBD_STRUCTURED_REPLY_HEADER_SIZE + 6 ];
+
+	mount_nbd_connection_t nbd_connection;
+	mount_nbd_server_t nbd_server;
+
+	libcerror_error_t *error    = NULL;
+	uint8_t *request_data       = NULL;
+	uint64_t value_64bit        = 0;
+	uint32_t value_32bit        = 0;
+	uint16_t value_16bit        = 0;
+	int socket_descriptors[ 2 ] = { -1, -1 };
+	int result                  = 0;
+
+	result = socketpair(
+	          AF_UNIX,
+	          SOCK_STREAM,
+	          0,
+	          socket_descriptors );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	memory_set(
+	 &nbd_server,
+	 0,
+	 sizeof( mount_nbd_server_t ) );
+
+	nbd_server.media_size                   = 4096;
+	nbd_server.socket_descriptor            = -1;
+	nbd_server.connection_socket_descriptor = -1;
+
+	memory_set(
+	 &nbd_connection,
+	 0,
+	 sizeof( mount_nbd_connection_t ) );
+
+	nbd_connection.server             = &nbd_server;
+	nbd_connection.socket_descriptor  = socket_descriptors[ 1 ];
+	nbd_connection.structured_replies = 1;
+
+	memory_set(
+	 client_data,
+	 0,
+	 ( 4 * MOUNT_NBD_REQUEST_HEADER_SIZE ) + 16 );
+
+	/* A write request with payload, a read request beyond the media size,
+	 * a flush request and a disconnect request
+	 */
+	request_data = client_data;
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( request_data[ 0 ] ),
+	 MOUNT_NBD_REQUEST_MAGIC );
+
+	byte_stream_copy_from_uint16_big_endian(
+	 &( request_data[ 6 ] ),
+	 MOUNT_NBD_COMMAND_WRITE );
+
+	byte_stream_copy_from_uint64_big_endian(
+	 &( request_data[ 8 ] ),
+	 (uint64_t) 1 );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( request_data[ 24 ] ),
+	 16 );
+
+	request_data += MOUNT_NBD_REQUEST_HEADER_SIZE + 16;
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( request_data[ 0 ] ),
+	 MOUNT_NBD_REQUEST_MAGIC );
+
+	byte_stream_copy_from_uint16_big_endian(
+	 &( request_data[ 6 ] ),
+	 MOUNT_NBD_COMMAND_READ );
+
+	byte_stream_copy_from_uint64_big_endian(
+	 &( request_data[ 8 ] ),
+	 (uint64_t) 2 );
+
+	byte_stream_copy_from_uint64_big_endian(
+	 &( request_data[ 16 ] ),
+	 (uint64_t) 4096 );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( request_data[ 24 ] ),
+	 512 );
+
+	request_data += MOUNT_NBD_REQUEST_HEADER_SIZE;
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( request_data[ 0 ] ),
+	 MOUNT_NBD_REQUEST_MAGIC );
+
+	byte_stream_copy_from_uint16_big_endian(
+	 &( request_data[ 6 ] ),
+	 MOUNT_NBD_COMMAND_FLUSH );
+
+	byte_stream_copy_from_uint64_big_endian(
+	 &( request_data[ 8 ] ),
+	 (uint64_t) 3 );
+
+	request_data += MOUNT_NBD_REQUEST_HEADER_SIZE;
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( request_data[ 0 ] ),
+	 MOUNT_NBD_REQUEST_MAGIC );
+
+	byte_stream_copy_from_uint16_big_endian(
+	 &( request_data[ 6 ] ),
+	 MOUNT_NBD_COMMAND_DISCONNECT );
+
+	result = mount_nbd_write_data(
+	          socket_descriptors[ 0 ],
+	          client_data,
+	          ( 4 * MOUNT_NBD_REQUEST_HEADER_SIZE ) + 16,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* Test regular cases
+	 */
+	result = mount_nbd_connection_transmission(
+	          &nbd_connection,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Check the write request was refused
+	 */
+	result = mount_nbd_read_data(
+	          socket_descriptors[ 0 ],
+	          reply_data,
+	          MOUNT_NBD_STRUCTURED_REPLY_HEADER_SIZE + 6,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	byte_stream_copy_to_uint16_big_endian(
+	 &( reply_data[ 6 ] ),
+	 value_16bit );
+
+	EWF_TEST_ASSERT_EQUAL_UINT16(
+	 "reply_type",
+	 value_16bit,
+	 (uint16_t) MOUNT_NBD_REPLY_TYPE_ERROR );
+
+	byte_stream_copy_to_uint64_big_endian(
+	 &( reply_data[ 8 ] ),
+	 value_64bit );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "cookie",
+	 value_64bit,
+	 (uint64_t) 1 );
+
+	byte_stream_copy_to_uint32_big_endian(
+	 &( reply_data[ 20 ] ),
+	 value_32bit );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "error_value",
+	 value_32bit,
+	 (uint32_t) MOUNT_NBD_ERROR_EPERM );
+
+	/* Check the read request beyond the media size was refused
+	 */
+	result = mount_nbd_read_data(
+	          socket_descriptors[ 0 ],
+	          reply_data,
+	          MOUNT_NBD_STRUCTURED_REPLY_HEADER_SIZE + 6,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	byte_stream_copy_to_uint64_big_endian(
+	 &( reply_data[ 8 ] ),
+	 value_64bit );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "cookie",
+	 value_64bit,
+	 (uint64_t) 2 );
+
+	byte_stream_copy_to_uint32_big_endian(
+	 &( reply_data[ 20 ] ),
+	 value_32bit );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "error_value",
+	 value_32bit,
+	 (uint32_t) MOUNT_NBD_ERROR_EINVAL );
+
+	/* Check the flush request succeeded
+	 */
+	result = mount_nbd_read_data(
+	          socket_descriptors[ 0 ],
+	          reply_data,
+	          MOUNT_NBD_STRUCTURED_REPLY_HEADER_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	byte_stream_copy_to_uint16_big_endian(
+	 &( reply_data[ 6 ] ),
+	 value_16bit );
+
+	EWF_TEST_ASSERT_EQUAL_UINT16(
+	 "reply_type",
+	 value_16bit,
+	 (uint16_t) MOUNT_NBD_REPLY_TYPE_NONE );
+
+	byte_stream_copy_to_uint64_big_endian(
+	 &( reply_data[ 8 ] ),
+	 value_64bit );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "cookie",
+	 value_64bit,
+	 (uint64_t) 3 );
+
+	/* Test error cases
+	 */
+	result = mount_nbd_connection_transmission(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test a request with an invalid magic
+	 */
+	memory_set(
+	 client_data,
+	 0,
+	 MOUNT_NBD_REQUEST_HEADER_SIZE );
+
+	result = mount_nbd_write_data(
+	          socket_descriptors[ 0 ],
+	          client_data,
+	          MOUNT_NBD_REQUEST_HEADER_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = mount_nbd_connection_transmission(
+	          &nbd_connection,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	close(
+	 socket_descriptors[ 0 ] );
+	close(
+	 socket_descriptors[ 1 ] );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( socket_descriptors[ 0 ] != -1 )
+	{
+		close(
+		 socket_descriptors[ 0 ] );
+	}
+	if( socket_descriptors[ 1 ] != -1 )
+	{
+		close(
+		 socket_descriptors[ 1 ] );
+	}
+	return( 0 );
+}
+
+#endif /* defined( HAVE_SYS_SOCKET_H ) && defined( HAVE_SYS_UN_H ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( HAVE_SYS_SOCKET_H ) && defined( HAVE_SYS_UN_H )
+
+	EWF_TEST_RUN(
+	 "mount_nbd_server_initialize",
+	 ewf_test_tools_mount_nbd_server_initialize );
+
+	EWF_TEST_RUN(
+	 "mount_nbd_server_free",
+	 ewf_test_tools_mount_nbd_server_free );
+
+	EWF_TEST_RUN(
+	 "mount_nbd_read_data",
+	 ewf_test_tools_mount_nbd_read_write_data );
+
+	EWF_TEST_RUN(
+	 "mount_nbd_connection_handshake",
+	 ewf_test_tools_mount_nbd_connection_handshake );
+
+	EWF_TEST_RUN(
+	 "mount_nbd_connection_transmission",
+	 ewf_test_tools_mount_nbd_connection_transmission );
+
+#endif /* defined( HAVE_SYS_SOCKET_H ) && defined( HAVE_SYS_UN_H ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( HAVE_SYS_SOCKET_H ) && defined( HAVE_SYS_UN_H )
+on_error:
+	return( EXIT_FAILURE );
+#endif
+}
+